@@ -0,0 +1,209 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnDictionaryString.h>
+#include <Common/typeid_cast.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace DB
+{
+ColumnDictionaryString::ColumnDictionaryString(const ColumnPtr & dictionary_, const ColumnPtr & indexes_)
+    : dictionary(dictionary_)
+    , indexes(indexes_)
+{
+    RUNTIME_CHECK_MSG(
+        typeid_cast<const ColumnString *>(dictionary.get()) != nullptr,
+        "The dictionary of {} must be a ColumnString, but got {}",
+        getName(),
+        dictionary->getName());
+    RUNTIME_CHECK_MSG(
+        typeid_cast<const ColumnIndexes *>(indexes.get()) != nullptr,
+        "The indexes of {} must be a ColumnUInt32, but got {}",
+        getName(),
+        indexes->getName());
+}
+
+ColumnPtr ColumnDictionaryString::materialize() const
+{
+    const auto & dict_chars = getDictionary().getChars();
+    const auto & dict_offsets = getDictionary().getOffsets();
+    const auto & index_data = getIndexes();
+    const size_t rows = index_data.size();
+
+    auto res = ColumnString::create();
+    auto & res_offsets = res->getOffsets();
+    auto & res_chars = res->getChars();
+    res_offsets.resize(rows);
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto index = index_data[i];
+        total_bytes += dict_offsets[index] - dict_offsets[index - 1];
+        res_offsets[i] = total_bytes;
+    }
+    res_chars.resize(total_bytes);
+    size_t pos = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto index = index_data[i];
+        const size_t offset = dict_offsets[index - 1];
+        const size_t size = dict_offsets[index] - offset;
+        memcpy(&res_chars[pos], &dict_chars[offset], size);
+        pos += size;
+    }
+    return res;
+}
+
+MutableColumnPtr ColumnDictionaryString::cloneResized(size_t new_size) const
+{
+    // The new rows can not be represented by the dictionary, so the column is materialized.
+    if (new_size > size())
+        return materialize()->cloneResized(new_size);
+    return ColumnDictionaryString::create(dictionary, indexes->cloneResized(new_size));
+}
+
+const ColumnDictionaryString::ColumnIndexes::Container & ColumnDictionaryString::sameDictionary(
+    const IColumn & src) const
+{
+    const auto * src_dict = typeid_cast<const ColumnDictionaryString *>(&src);
+    if (unlikely(src_dict == nullptr || src_dict->dictionary.get() != dictionary.get()))
+        throw Exception(
+            ErrorCodes::NOT_IMPLEMENTED,
+            "Inserting from {} into {} with a different dictionary is not supported",
+            src.getName(),
+            getName());
+    return src_dict->getIndexes();
+}
+
+int ColumnDictionaryString::compareAt(size_t n, size_t m, const IColumn & rhs, int nan_direction_hint) const
+{
+    if (const auto * rhs_dict = typeid_cast<const ColumnDictionaryString *>(&rhs))
+        return dictionary->compareAt(indexAt(n), rhs_dict->indexAt(m), *rhs_dict->dictionary, nan_direction_hint);
+    return dictionary->compareAt(indexAt(n), m, rhs, nan_direction_hint);
+}
+
+int ColumnDictionaryString::compareAt(
+    size_t n,
+    size_t m,
+    const IColumn & rhs,
+    int nan_direction_hint,
+    const TiDB::ITiDBCollator & collator) const
+{
+    if (const auto * rhs_dict = typeid_cast<const ColumnDictionaryString *>(&rhs))
+        return dictionary
+            ->compareAt(indexAt(n), rhs_dict->indexAt(m), *rhs_dict->dictionary, nan_direction_hint, collator);
+    return dictionary->compareAt(indexAt(n), m, rhs, nan_direction_hint, collator);
+}
+
+void ColumnDictionaryString::getPermutationByDictionary(
+    const Permutation & dictionary_perm,
+    bool reverse,
+    size_t limit,
+    Permutation & res) const
+{
+    // The rank of each string of the dictionary, then the rows are sorted by integers instead of strings.
+    PaddedPODArray<UInt32> ranks(dictionary_perm.size());
+    for (size_t i = 0; i < dictionary_perm.size(); ++i)
+        ranks[dictionary_perm[i]] = i;
+
+    const auto & index_data = getIndexes();
+    const size_t rows = index_data.size();
+    res.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+        res[i] = i;
+
+    auto less = [&](size_t lhs, size_t rhs) {
+        return reverse ? ranks[index_data[lhs]] > ranks[index_data[rhs]]
+                       : ranks[index_data[lhs]] < ranks[index_data[rhs]];
+    };
+    if (limit && limit < rows)
+        std::partial_sort(res.begin(), res.begin() + limit, res.end(), less);
+    else
+        std::sort(res.begin(), res.end(), less);
+}
+
+void ColumnDictionaryString::getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res)
+    const
+{
+    Permutation dictionary_perm;
+    dictionary->getPermutation(false, 0, nan_direction_hint, dictionary_perm);
+    getPermutationByDictionary(dictionary_perm, reverse, limit, res);
+}
+
+void ColumnDictionaryString::getPermutation(
+    const TiDB::ITiDBCollator & collator,
+    bool reverse,
+    size_t limit,
+    int nan_direction_hint,
+    Permutation & res) const
+{
+    Permutation dictionary_perm;
+    dictionary->getPermutation(collator, false, 0, nan_direction_hint, dictionary_perm);
+    getPermutationByDictionary(dictionary_perm, reverse, limit, res);
+}
+
+MutableColumns ColumnDictionaryString::scatter(ColumnIndex num_columns, const Selector & selector) const
+{
+    auto scattered = indexes->scatter(num_columns, selector);
+    MutableColumns res(num_columns);
+    for (size_t i = 0; i < num_columns; ++i)
+        res[i] = ColumnDictionaryString::create(dictionary, std::move(scattered[i]));
+    return res;
+}
+
+MutableColumns ColumnDictionaryString::scatter(
+    ColumnIndex num_columns,
+    const Selector & selector,
+    const BlockSelective & selective) const
+{
+    auto scattered = indexes->scatter(num_columns, selector, selective);
+    MutableColumns res(num_columns);
+    for (size_t i = 0; i < num_columns; ++i)
+        res[i] = ColumnDictionaryString::create(dictionary, std::move(scattered[i]));
+    return res;
+}
+
+ColumnPtr ColumnDictionaryString::gatherByIndexes(const IColumn & values) const
+{
+    RUNTIME_CHECK_MSG(
+        values.size() == dictionary->size(),
+        "The size of values ({}) doesn't match the size of dictionary ({})",
+        values.size(),
+        dictionary->size());
+
+    const auto & index_data = getIndexes();
+    const size_t rows = index_data.size();
+    // Most of the functions evaluated on the dictionary are predicates, so UInt8 is gathered directly.
+    if (const auto * values_uint8 = typeid_cast<const ColumnUInt8 *>(&values))
+    {
+        const auto & values_data = values_uint8->getData();
+        auto res = ColumnUInt8::create(rows);
+        auto & res_data = res->getData();
+        for (size_t i = 0; i < rows; ++i)
+            res_data[i] = values_data[index_data[i]];
+        return res;
+    }
+    if (values.isColumnConst())
+        return values.cloneResized(rows);
+
+    auto res = values.cloneEmpty();
+    res->reserve(rows);
+    for (size_t i = 0; i < rows; ++i)
+        res->insertFrom(values, index_data[i]);
+    return res;
+}
+
+} // namespace DB
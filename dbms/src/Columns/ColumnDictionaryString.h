@@ -0,0 +1,386 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <Columns/IColumn.h>
+#include <Common/Exception.h>
+
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int NOT_IMPLEMENTED;
+}
+
+/** ColumnDictionaryString is a String column encoded by a dictionary: the distinct strings are stored once in
+  *  `dictionary` (a ColumnString), and each row is an index into it. The dictionary is shared by the columns
+  *  derived from it (filter, permute, cut...), so they only touch the indexes.
+  * It is produced by the DMFile reader from dictionary-encoded packs. The operators which are aware of it
+  *  (comparison functions, IN, aggregation by a single string key) work on the dictionary and the indexes,
+  *  the others see a ColumnString, since `convertToFullColumnIfConst` materializes it.
+  * Only the rows of the same dictionary can be inserted into it.
+  */
+class ColumnDictionaryString final : public COWPtrHelper<IColumn, ColumnDictionaryString>
+{
+private:
+    friend class COWPtrHelper<IColumn, ColumnDictionaryString>;
+
+    ColumnPtr dictionary;
+    ColumnPtr indexes;
+
+    ColumnDictionaryString(const ColumnPtr & dictionary_, const ColumnPtr & indexes_);
+    ColumnDictionaryString(const ColumnDictionaryString & src) = default;
+
+public:
+    using IndexType = UInt32;
+    using ColumnIndexes = ColumnVector<IndexType>;
+
+    /// Return a ColumnString with the value of each row.
+    ColumnPtr materialize() const;
+
+    ColumnPtr convertToFullColumnIfConst() const override { return materialize(); }
+
+    std::string getName() const override { return "DictionaryString"; }
+
+    const char * getFamilyName() const override { return "DictionaryString"; }
+
+    MutableColumnPtr cloneResized(size_t new_size) const override;
+
+    size_t size() const override { return indexes->size(); }
+
+    Field operator[](size_t n) const override { return (*dictionary)[indexAt(n)]; }
+
+    void get(size_t n, Field & res) const override { dictionary->get(indexAt(n), res); }
+
+    StringRef getDataAt(size_t n) const override { return dictionary->getDataAt(indexAt(n)); }
+
+    StringRef getDataAtWithTerminatingZero(size_t n) const override
+    {
+        return dictionary->getDataAtWithTerminatingZero(indexAt(n));
+    }
+
+    ColumnPtr cut(size_t start, size_t length) const override
+    {
+        return ColumnDictionaryString::create(dictionary, indexes->cut(start, length));
+    }
+
+    void insertRangeFrom(const IColumn & src, size_t start, size_t length) override
+    {
+        const auto & src_indexes = sameDictionary(src);
+        getIndexesData().insert(src_indexes.begin() + start, src_indexes.begin() + start + length);
+    }
+
+    void insertFrom(const IColumn & src, size_t n) override { getIndexesData().push_back(sameDictionary(src)[n]); }
+
+    void insertManyFrom(const IColumn & src, size_t position, size_t length) override
+    {
+        getIndexesData().resize_fill(size() + length, sameDictionary(src)[position]);
+    }
+
+    void insertSelectiveRangeFrom(const IColumn & src, const Offsets & selective_offsets, size_t start, size_t length)
+        override
+    {
+        const auto & src_indexes = sameDictionary(src);
+        auto & data = getIndexesData();
+        data.reserve(data.size() + length);
+        for (size_t i = start; i < start + length; ++i)
+            data.push_back(src_indexes[selective_offsets[i]]);
+    }
+
+    void insert(const Field &) override
+    {
+        throw Exception("Method insert is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void insertData(const char *, size_t) override
+    {
+        throw Exception("Method insertData is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void insertDefault() override
+    {
+        throw Exception("Method insertDefault is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void insertManyDefaults(size_t) override
+    {
+        throw Exception("Method insertManyDefaults is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void popBack(size_t n) override { indexes->assumeMutableRef().popBack(n); }
+
+    StringRef serializeValueIntoArena(
+        size_t n,
+        Arena & arena,
+        char const *& begin,
+        const TiDB::TiDBCollatorPtr & collator,
+        String & sort_key_container) const override
+    {
+        return dictionary->serializeValueIntoArena(indexAt(n), arena, begin, collator, sort_key_container);
+    }
+
+    const char * deserializeAndInsertFromArena(const char *, const TiDB::TiDBCollatorPtr &) override
+    {
+        throw Exception(
+            "Method deserializeAndInsertFromArena is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    size_t serializeByteSize() const override
+    {
+        throw Exception("Method serializeByteSize is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void countSerializeByteSize(PaddedPODArray<size_t> & /* byte_size */) const override
+    {
+        throw Exception("Method countSerializeByteSize is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+    void countSerializeByteSizeForCmp(
+        PaddedPODArray<size_t> & /* byte_size */,
+        const NullMap * /*nullmap*/,
+        const TiDB::TiDBCollatorPtr & /* collator */) const override
+    {
+        throw Exception(
+            "Method countSerializeByteSizeForCmp is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void countSerializeByteSizeForColumnArray(
+        PaddedPODArray<size_t> & /* byte_size */,
+        const IColumn::Offsets & /* array_offsets */) const override
+    {
+        throw Exception(
+            "Method countSerializeByteSizeForColumnArray is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+    void countSerializeByteSizeForCmpColumnArray(
+        PaddedPODArray<size_t> & /* byte_size */,
+        const IColumn::Offsets & /* array_offsets */,
+        const NullMap * /*nullmap*/,
+        const TiDB::TiDBCollatorPtr & /* collator */) const override
+    {
+        throw Exception(
+            "Method countSerializeByteSizeForCmpColumnArray is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void serializeToPos(
+        PaddedPODArray<char *> & /* pos */,
+        size_t /* start */,
+        size_t /* length */,
+        bool /* has_null */) const override
+    {
+        throw Exception("Method serializeToPos is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+    void serializeToPosForCmp(
+        PaddedPODArray<char *> & /* pos */,
+        size_t /* start */,
+        size_t /* length */,
+        bool /* has_null */,
+        const NullMap * /* nullmap */,
+        const TiDB::TiDBCollatorPtr & /* collator */,
+        String * /* sort_key_container */) const override
+    {
+        throw Exception("Method serializeToPosForCmp is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void serializeToPosForColumnArray(
+        PaddedPODArray<char *> & /* pos */,
+        size_t /* start */,
+        size_t /* length */,
+        bool /* has_null */,
+        const IColumn::Offsets & /* array_offsets */) const override
+    {
+        throw Exception(
+            "Method serializeToPosForColumnArray is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+    void serializeToPosForCmpColumnArray(
+        PaddedPODArray<char *> & /* pos */,
+        size_t /* start */,
+        size_t /* length */,
+        bool /* has_null */,
+        const NullMap * /* nullmap */,
+        const IColumn::Offsets & /* array_offsets */,
+        const TiDB::TiDBCollatorPtr & /* collator */,
+        String * /* sort_key_container */) const override
+    {
+        throw Exception(
+            "Method serializeToPosForCmpColumnArray is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void deserializeAndInsertFromPos(PaddedPODArray<char *> & /* pos */, bool /* use_nt_align_buffer */) override
+    {
+        throw Exception(
+            "Method deserializeAndInsertFromPos is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void deserializeAndInsertFromPosForColumnArray(
+        PaddedPODArray<char *> & /* pos */,
+        const IColumn::Offsets & /* array_offsets */,
+        bool /* use_nt_align_buffer */) override
+    {
+        throw Exception(
+            "Method deserializeAndInsertFromPosForColumnArray is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void flushNTAlignBuffer() override
+    {
+        throw Exception("Method flushNTAlignBuffer is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void deserializeAndAdvancePos(PaddedPODArray<char *> & /* pos */) const override
+    {
+        throw Exception(
+            "Method deserializeAndAdvancePos is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void deserializeAndAdvancePosForColumnArray(
+        PaddedPODArray<char *> & /* pos */,
+        const IColumn::Offsets & /* array_offsets */) const override
+    {
+        throw Exception(
+            "Method deserializeAndAdvancePosForColumnArray is not supported for " + getName(),
+            ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void updateHashWithValue(
+        size_t n,
+        SipHash & hash,
+        const TiDB::TiDBCollatorPtr & collator,
+        String & sort_key_container) const override
+    {
+        dictionary->updateHashWithValue(indexAt(n), hash, collator, sort_key_container);
+    }
+
+    void updateHashWithValues(
+        IColumn::HashValues & hash_values,
+        const TiDB::TiDBCollatorPtr & collator,
+        String & sort_key_container) const override
+    {
+        for (size_t i = 0, s = size(); i < s; ++i)
+            dictionary->updateHashWithValue(indexAt(i), hash_values[i], collator, sort_key_container);
+    }
+
+    void updateWeakHash32(WeakHash32 & hash, const TiDB::TiDBCollatorPtr & collator, String & sort_key_container)
+        const override
+    {
+        materialize()->updateWeakHash32(hash, collator, sort_key_container);
+    }
+    void updateWeakHash32(
+        WeakHash32 & hash,
+        const TiDB::TiDBCollatorPtr & collator,
+        String & sort_key_container,
+        const BlockSelective & selective) const override
+    {
+        materialize()->updateWeakHash32(hash, collator, sort_key_container, selective);
+    }
+
+    ColumnPtr filter(const Filter & filt, ssize_t result_size_hint) const override
+    {
+        return ColumnDictionaryString::create(dictionary, indexes->filter(filt, result_size_hint));
+    }
+    ColumnPtr replicateRange(size_t start_row, size_t end_row, const IColumn::Offsets & offsets) const override
+    {
+        return ColumnDictionaryString::create(dictionary, indexes->replicateRange(start_row, end_row, offsets));
+    }
+    ColumnPtr permute(const Permutation & perm, size_t limit) const override
+    {
+        return ColumnDictionaryString::create(dictionary, indexes->permute(perm, limit));
+    }
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
+    void getPermutation(
+        const TiDB::ITiDBCollator & collator,
+        bool reverse,
+        size_t limit,
+        int nan_direction_hint,
+        Permutation & res) const override;
+
+    size_t byteSize() const override { return dictionary->byteSize() + indexes->byteSize(); }
+
+    size_t byteSize(size_t offset, size_t limit) const override { return indexes->byteSize(offset, limit); }
+
+    size_t allocatedBytes() const override { return dictionary->allocatedBytes() + indexes->allocatedBytes(); }
+
+    int compareAt(size_t n, size_t m, const IColumn & rhs, int nan_direction_hint) const override;
+    int compareAt(size_t n, size_t m, const IColumn & rhs, int nan_direction_hint, const TiDB::ITiDBCollator & collator)
+        const override;
+
+    MutableColumns scatter(ColumnIndex num_columns, const Selector & selector) const override;
+    MutableColumns scatter(ColumnIndex num_columns, const Selector & selector, const BlockSelective & selective)
+        const override;
+
+    void scatterTo(ScatterColumns & columns, const Selector & selector) const override
+    {
+        materialize()->scatterTo(columns, selector);
+    }
+    void scatterTo(ScatterColumns & columns, const Selector & selector, const BlockSelective & selective)
+        const override
+    {
+        materialize()->scatterTo(columns, selector, selective);
+    }
+
+    void gather(ColumnGathererStream &) override
+    {
+        throw Exception("Cannot gather into dictionary column " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
+    void getExtremes(Field & min, Field & max) const override { materialize()->getExtremes(min, max); }
+
+    void reserve(size_t n) override { getIndexesData().reserve(n); }
+
+    void forEachSubcolumn(ColumnCallback callback) override
+    {
+        callback(dictionary);
+        callback(indexes);
+    }
+
+    /// Not part of the common interface.
+
+    const ColumnString & getDictionary() const { return static_cast<const ColumnString &>(*dictionary); }
+    const ColumnPtr & getDictionaryPtr() const { return dictionary; }
+    const ColumnIndexes::Container & getIndexes() const
+    {
+        return static_cast<const ColumnIndexes &>(*indexes).getData();
+    }
+
+    IndexType indexAt(size_t n) const { return getIndexes()[n]; }
+
+    /// `values` has a row for each string of the dictionary, e.g. the result of a function evaluated on the
+    /// dictionary. Return the column with the value of each row of this column.
+    ColumnPtr gatherByIndexes(const IColumn & values) const;
+
+private:
+    ColumnIndexes::Container & getIndexesData()
+    {
+        return static_cast<ColumnIndexes &>(indexes->assumeMutableRef()).getData();
+    }
+
+    /// Return the indexes of `src`, which must be a ColumnDictionaryString sharing the dictionary of this column.
+    const ColumnIndexes::Container & sameDictionary(const IColumn & src) const;
+
+    /// Sort the rows by the positions of their strings in `dictionary_perm`, the sorted dictionary.
+    void getPermutationByDictionary(const Permutation & dictionary_perm, bool reverse, size_t limit, Permutation & res)
+        const;
+};
+
+} // namespace DB
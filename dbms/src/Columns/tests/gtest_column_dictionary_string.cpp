@@ -0,0 +1,141 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnDictionaryString.h>
+#include <Common/Exception.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB
+{
+namespace tests
+{
+class TestColumnDictionaryString : public FunctionTest
+{
+public:
+    static ColumnPtr createDictionaryColumn(const std::vector<String> & dictionary, const std::vector<UInt32> & indexes)
+    {
+        auto dictionary_column = ColumnString::create();
+        for (const auto & s : dictionary)
+            dictionary_column->insertData(s.data(), s.size());
+        auto indexes_column = ColumnDictionaryString::ColumnIndexes::create();
+        for (auto index : indexes)
+            indexes_column->insert(index);
+        return ColumnDictionaryString::create(std::move(dictionary_column), std::move(indexes_column));
+    }
+
+    static ColumnPtr materialize(const ColumnPtr & column) { return column->convertToFullColumnIfConst(); }
+};
+
+TEST_F(TestColumnDictionaryString, Materialize)
+try
+{
+    auto column = createDictionaryColumn({"b", "", "abc"}, {2, 0, 0, 1, 2});
+    ASSERT_EQ(column->size(), 5);
+    ASSERT_EQ(column->getDataAt(0).toString(), "abc");
+    ASSERT_EQ((*column)[1].get<String>(), "b");
+    ASSERT_COLUMN_EQ(createColumn<String>({"abc", "b", "b", "", "abc"}).column, materialize(column));
+
+    // Cut, filter and permute keep the dictionary.
+    auto cut = column->cut(1, 3);
+    ASSERT_TRUE(typeid_cast<const ColumnDictionaryString *>(cut.get()));
+    ASSERT_COLUMN_EQ(createColumn<String>({"b", "b", ""}).column, materialize(cut));
+
+    IColumn::Filter filter{1, 0, 1, 1, 0};
+    auto filtered = column->filter(filter, -1);
+    ASSERT_TRUE(typeid_cast<const ColumnDictionaryString *>(filtered.get()));
+    ASSERT_COLUMN_EQ(createColumn<String>({"abc", "b", ""}).column, materialize(filtered));
+
+    IColumn::Permutation perm{4, 3, 2, 1, 0};
+    auto permuted = column->permute(perm, 0);
+    ASSERT_COLUMN_EQ(createColumn<String>({"abc", "", "b", "b", "abc"}).column, materialize(permuted));
+}
+CATCH
+
+TEST_F(TestColumnDictionaryString, Insert)
+try
+{
+    auto column = createDictionaryColumn({"x", "y"}, {0, 1, 1, 0});
+    auto res = column->cloneEmpty();
+    res->insertRangeFrom(*column, 1, 2);
+    res->insertFrom(*column, 0);
+    res->insertManyFrom(*column, 1, 2);
+    ASSERT_COLUMN_EQ(createColumn<String>({"y", "y", "x", "y", "y"}).column, materialize(std::move(res)));
+
+    // The rows of another dictionary can not be inserted.
+    auto other = createDictionaryColumn({"x", "y"}, {0});
+    auto res2 = column->cloneEmpty();
+    ASSERT_THROW(res2->insertFrom(*other, 0), Exception);
+    ASSERT_THROW(res2->insertFrom(*createColumn<String>({"x"}).column, 0), Exception);
+}
+CATCH
+
+TEST_F(TestColumnDictionaryString, CompareAndSort)
+try
+{
+    auto column = createDictionaryColumn({"b", "c", "a"}, {0, 1, 2, 0, 2});
+    auto full = materialize(column);
+    for (size_t i = 0; i < column->size(); ++i)
+    {
+        for (size_t j = 0; j < column->size(); ++j)
+        {
+            ASSERT_EQ(column->compareAt(i, j, *column, 1), full->compareAt(i, j, *full, 1));
+            ASSERT_EQ(column->compareAt(i, j, *full, 1), full->compareAt(i, j, *full, 1));
+        }
+    }
+
+    for (bool reverse : {false, true})
+    {
+        IColumn::Permutation perm;
+        column->getPermutation(reverse, 0, 1, perm);
+        auto sorted = materialize(column->permute(perm, 0));
+        if (reverse)
+            ASSERT_COLUMN_EQ(createColumn<String>({"c", "b", "b", "a", "a"}).column, sorted);
+        else
+            ASSERT_COLUMN_EQ(createColumn<String>({"a", "a", "b", "b", "c"}).column, sorted);
+    }
+}
+CATCH
+
+TEST_F(TestColumnDictionaryString, ExecuteFunction)
+try
+{
+    auto column = createDictionaryColumn({"b", "c", "a"}, {0, 1, 2, 0, 2});
+    auto type = std::make_shared<DataTypeString>();
+
+    // `equals` is executed on the dictionary and gathered by the indexes.
+    ASSERT_COLUMN_EQ(
+        createColumn<UInt8>({1, 0, 0, 1, 0}),
+        executeFunction(
+            "equals",
+            {{column, type, "col"}, createConstColumn<String>(5, "b")},
+            nullptr,
+            /*raw_function_test=*/true));
+    ASSERT_COLUMN_EQ(
+        createConstColumn<Nullable<UInt8>>(5, {}),
+        executeFunction(
+            "equals",
+            {{column, type, "col"}, createConstColumn<Nullable<String>>(5, {})},
+            nullptr,
+            /*raw_function_test=*/true));
+
+    // Other functions are executed on the materialized column.
+    ASSERT_COLUMN_EQ(
+        createColumn<String>({"B", "C", "A", "B", "A"}),
+        executeFunction("upperUTF8", {{column, type, "col"}}, nullptr, /*raw_function_test=*/true));
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
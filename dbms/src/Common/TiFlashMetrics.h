@@ -338,6 +338,12 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_wait_in_group, {{"type", "wait_in_group"}}, ExpBuckets{0.00005, 1.8, 26}),                                             \
       F(type_wal, {{"type", "wal"}}, ExpBuckets{0.00005, 1.8, 26}),                                                                 \
       F(type_commit, {{"type", "commit"}}, ExpBuckets{0.00005, 1.8, 26}))                                                           \
+    M(tiflash_storage_page_restore_duration_seconds,                                                                                \
+      "The duration of restoring the page directory from WAL",                                                                      \
+      Histogram,                                                                                                                    \
+      F(type_read_wal, {{"type", "read_wal"}}, ExpBuckets{0.01, 2, 20}),                                                            \
+      F(type_apply, {{"type", "apply"}}, ExpBuckets{0.01, 2, 20}),                                                                  \
+      F(type_total, {{"type", "total"}}, ExpBuckets{0.01, 2, 20}))                                                                  \
     M(tiflash_storage_logical_throughput_bytes,                                                                                     \
       "The logical throughput of read tasks of storage in bytes",                                                                   \
       Histogram,                                                                                                                    \
@@ -472,7 +478,9 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_apply_snapshot_write, {"type", "apply_snapshot_write"}),                                                               \
       F(type_large_txn_lock_put, {"type", "large_txn_lock_put"}),                                                                   \
       F(type_large_txn_lock_del, {"type", "large_txn_lock_del"}),                                                                   \
-      F(type_ingest_sst, {"type", "ingest_sst"}))                                                                                   \
+      F(type_ingest_sst, {"type", "ingest_sst"}),                                                                                   \
+      F(type_default_spill, {"type", "default_spill"}),                                                                             \
+      F(type_spilled_read, {"type", "spilled_read"}))                                                                               \
     M(tiflash_raft_apply_write_command_duration_seconds,                                                                            \
       "Bucketed histogram of applying write command Raft logs",                                                                     \
       Histogram,                                                                                                                    \
@@ -581,6 +589,14 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       Gauge,                                                                                                                        \
       F(type_region, {{"type", "region"}}),                                                                                         \
       F(type_fully_decoded_lockcf, {{"type", "fully_decoded_lockcf"}}))                                                             \
+    M(tiflash_raft_region_data_arena_bytes,                                                                                         \
+      "Bytes of the memory held by the arenas of region data",                                                                      \
+      Gauge,                                                                                                                        \
+      F(type_allocated, {{"type", "allocated"}}))                                                                                   \
+    M(tiflash_raft_spilled_bytes,                                                                                                   \
+      "Bytes of the uncommitted data spilled from region memory to local files",                                                    \
+      Gauge,                                                                                                                        \
+      F(type_default_cf, {{"type", "default_cf"}}))                                                                                 \
     /* required by DBaaS */                                                                                                         \
     M(tiflash_server_info,                                                                                                          \
       "Indicate the tiflash server info, and the value is the start timestamp (s).",                                                \
@@ -755,7 +771,9 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_io_pending_tasks_count, {"type", "io_pending_tasks_count"}),                                                           \
       F(type_io_executing_tasks_count, {"type", "io_executing_tasks_count"}),                                                       \
       F(type_cpu_task_thread_pool_size, {"type", "cpu_task_thread_pool_size"}),                                                     \
-      F(type_io_task_thread_pool_size, {"type", "io_task_thread_pool_size"}))                                                       \
+      F(type_io_task_thread_pool_size, {"type", "io_task_thread_pool_size"}),                                                       \
+      F(type_cpu_cross_numa_steal_count, {"type", "cpu_cross_numa_steal_count"}),                                                   \
+      F(type_io_cross_numa_steal_count, {"type", "io_cross_numa_steal_count"}))                                                     \
     M(tiflash_pipeline_wait_on_notify_tasks,                                                                                        \
       "waiting on notify pipeline task count",                                                                                      \
       Gauge,                                                                                                                        \
@@ -944,6 +962,10 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_runlength, {"type", "runlength"}),                                                                                     \
       F(type_for, {"type", "for"}),                                                                                                 \
       F(type_delta_for, {"type", "delta_for"}),                                                                                     \
+      F(type_decimal_for, {"type", "decimal_for"}),                                                                                 \
+      F(type_xor, {"type", "xor"}),                                                                                                 \
+      F(type_dictionary, {"type", "dictionary"}),                                                                                   \
+      F(type_fsst, {"type", "fsst"}),                                                                                               \
       F(type_lz4, {"type", "lz4"}))                                                                                                 \
     M(tiflash_storage_pack_compression_bytes,                                                                                       \
       "The uncompression/compression bytes of lz4 and lightweight",                                                                 \
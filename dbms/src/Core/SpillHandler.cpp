@@ -18,6 +18,7 @@
 #include <DataStreams/IBlockInputStream.h>
 #include <IO/FileProvider/EncryptionPath.h>
 #include <IO/FileProvider/WriteBufferFromWritableFileBuilder.h>
+#include <IO/IOThreadPools.h>
 
 namespace DB
 {
@@ -44,7 +45,9 @@ SpillHandler::SpillWriter::SpillWriter(
         /*existing_memory=*/nullptr,
         /*alignment=*/0,
         SpillLimiter::instance))
-    , compressed_buf(file_buf)
+    , async_buf(SpillIOPool::isInitialized() ? std::make_unique<AsynchronousWriteBuffer>(file_buf, SpillIOPool::get())
+                                             : nullptr)
+    , compressed_buf(async_buf ? static_cast<WriteBuffer &>(*async_buf) : file_buf)
 {
     if (!append_write)
         writeVarUInt(spill_version, compressed_buf);
@@ -56,6 +59,8 @@ SpillDetails SpillHandler::SpillWriter::finishWrite()
 {
     out->flush();
     compressed_buf.next();
+    if (async_buf)
+        async_buf->sync();
     file_buf.next();
     out->writeSuffix();
     return {written_rows, compressed_buf.count(), file_buf.count()};
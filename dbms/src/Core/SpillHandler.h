@@ -16,6 +16,7 @@
 
 #include <Core/Spiller.h>
 #include <DataStreams/NativeBlockOutputStream.h>
+#include <IO/Buffer/AsynchronousWriteBuffer.h>
 #include <IO/Buffer/WriteBufferFromWritableFile.h>
 #include <IO/Compression/CompressedWriteBuffer.h>
 #include <IO/VarInt.h>
@@ -53,6 +54,9 @@ private:
 
     private:
         WriteBufferFromWritableFile file_buf;
+        /// Not null if the spill io thread pool is available. Then the blocks are serialized and compressed by
+        /// the caller while the previous compressed data is written to file_buf in the spill io thread pool.
+        std::unique_ptr<AsynchronousWriteBuffer> async_buf;
         CompressedWriteBuffer<> compressed_buf;
         std::unique_ptr<IBlockOutputStream> out;
         size_t written_rows = 0;
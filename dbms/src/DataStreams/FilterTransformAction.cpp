@@ -85,6 +85,21 @@ bool FilterTransformAction::transform(Block & block, FilterPtr & res_filter, boo
         return true;
     }
 
+    // No row passes the filter, the columns of the block may be not read, so the expression is not executed.
+    if (!block.getRSResult().isUse())
+    {
+        auto filter_column = header.safeGetByPosition(filter_column_position).cloneEmpty();
+        filter_column.column = filter_column.type->createColumnConst(block.rows(), static_cast<UInt64>(0));
+        block.insert(filter_column_position, std::move(filter_column));
+        if (!return_filter)
+            return false;
+        auto filter_and_holder = ColumnUInt8::create(block.rows(), 0);
+        filter = &filter_and_holder->getData();
+        filter_holder = std::move(filter_and_holder);
+        res_filter = filter;
+        return true;
+    }
+
     expression->execute(block);
 
     if (constant_filter_description.always_true)
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnDictionaryString.h>
+#include <Common/typeid_cast.h>
 #include <DataStreams/MockTableScanBlockInputStream.h>
 
 namespace DB
@@ -38,6 +40,14 @@ MockTableScanBlockInputStream::MockTableScanBlockInputStream(
 
 ColumnPtr MockTableScanBlockInputStream::makeColumn(ColumnWithTypeAndName elem) const
 {
+    // Keep the dictionary encoded columns as they are, so that the tests can cover the operators reading dictionaries.
+    if (typeid_cast<const ColumnDictionaryString *>(elem.column.get()))
+    {
+        if (output_index >= rows)
+            return elem.column->cloneEmpty();
+        return elem.column->cut(output_index, std::min(max_block_size, rows - output_index));
+    }
+
     auto column = elem.type->createColumn();
     size_t row_count = 0;
     for (size_t i = output_index; (i < rows) & (row_count < max_block_size); ++i)
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include <Common/FailPoint.h>
+#include <Common/MemoryTrackerSetter.h>
 #include <DataStreams/SpilledFilesInputStream.h>
+#include <IO/IOThreadPools.h>
 
 namespace DB
 {
@@ -45,7 +47,36 @@ SpilledFilesInputStream::SpilledFilesInputStream(
         max_supported_spill_version);
 }
 
+SpilledFilesInputStream::~SpilledFilesInputStream()
+{
+    // The prefetching task refers to this stream.
+    if (prefetched_block.valid())
+        prefetched_block.wait();
+}
+
 Block SpilledFilesInputStream::readImpl()
+{
+    if (!SpillIOPool::isInitialized())
+        return readAndFillConstants();
+
+    Block ret = prefetched_block.valid() ? prefetched_block.get() : readAndFillConstants();
+    if (ret)
+        prefetchNextBlock();
+    return ret;
+}
+
+void SpilledFilesInputStream::prefetchNextBlock()
+{
+    assert(!prefetched_block.valid());
+    auto task = std::make_shared<std::packaged_task<Block()>>([this, mem_tracker = current_memory_tracker] {
+        MemoryTrackerSetter setter(true, mem_tracker);
+        return readAndFillConstants();
+    });
+    prefetched_block = task->get_future();
+    SpillIOPool::get().scheduleOrThrowOnError([task] { (*task)(); });
+}
+
+Block SpilledFilesInputStream::readAndFillConstants()
 {
     auto ret = readInternal();
     if likely (ret)
@@ -21,6 +21,8 @@
 #include <IO/FileProvider/EncryptionPath.h>
 #include <IO/FileProvider/ReadBufferFromRandomAccessFileBuilder.h>
 
+#include <future>
+
 namespace DB
 {
 struct SpilledFileInfo
@@ -42,6 +44,7 @@ public:
         const std::vector<size_t> & const_column_indexes,
         const FileProviderPtr & file_provider,
         Int64 max_supported_spill_version);
+    ~SpilledFilesInputStream() override;
     Block getHeader() const override;
     String getName() const override;
 
@@ -49,6 +52,10 @@ protected:
     Block readImpl() override;
     Block readInternal();
 
+private:
+    Block readAndFillConstants();
+    void prefetchNextBlock();
+
 private:
     struct SpilledFileStream
     {
@@ -88,6 +95,9 @@ private:
     FileProviderPtr file_provider;
     Int64 max_supported_spill_version;
     std::unique_ptr<SpilledFileStream> current_file_stream;
+    /// The next block read ahead in the spill io thread pool, so the reading of the disk is overlapped with the
+    /// processing of the current block.
+    std::future<Block> prefetched_block;
 };
 
 } // namespace DB
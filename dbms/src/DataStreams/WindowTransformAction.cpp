@@ -229,6 +229,7 @@ WindowTransformAction::WindowTransformAction(
     , window_description(window_description_)
     , first_processed(true)
 {
+    this->input_header = input_header;
     output_header = input_header;
     for (const auto & add_column : window_description_.add_columns)
     {
@@ -243,10 +244,18 @@ WindowTransformAction::WindowTransformAction(
     if (window_description_.frame.end_type == WindowFrame::BoundaryType::Unbounded)
         assert(!window_description_.frame.end_preceding);
 
-    // When size of frame is equal to the partition, we can set this var to true
-    support_batch_calculate = window_description_.frame.begin_type == WindowFrame::BoundaryType::Unbounded
-        && window_description_.frame.end_type == WindowFrame::BoundaryType::Unbounded && !aggregation_workspaces.empty()
-        && window_workspaces.empty();
+    support_batch_calculate = supportBatchCalculate(window_description_);
+}
+
+bool WindowTransformAction::supportBatchCalculate(const WindowDescription & window_description)
+{
+    // When size of frame is equal to the partition, all rows in same partition share one result
+    if (window_description.frame.begin_type != WindowFrame::BoundaryType::Unbounded
+        || window_description.frame.end_type != WindowFrame::BoundaryType::Unbounded)
+        return false;
+    const auto & descs = window_description.window_functions_descriptions;
+    return !descs.empty()
+        && std::all_of(descs.begin(), descs.end(), [](const auto & desc) { return desc.window_function == nullptr; });
 }
 
 void WindowTransformAction::cleanUp()
@@ -1361,7 +1370,14 @@ Block WindowTransformAction::tryGetOutputBlock()
     {
         const auto i = next_output_block_number - first_block_number;
         auto & block = window_blocks[i];
-        auto columns = block.input_columns;
+        if (block.spilled && block.input_columns.empty())
+            return {};
+        Columns columns;
+        if (block.spilled)
+            // The restored input columns are not used by the calculation any more.
+            columns = std::move(block.input_columns);
+        else
+            columns = block.input_columns;
         for (auto & res : block.output_columns)
         {
             columns.push_back(ColumnPtr(std::move(res)));
@@ -1423,6 +1439,65 @@ void WindowTransformAction::appendBlock(Block & current_block)
     }
 
     window_block.input_columns = current_block.getColumns();
+    if (support_batch_calculate && blocksEnd().block > next_spill_block_number)
+        unspilled_input_bytes += current_block.estimateBytesForSpill();
+}
+
+Blocks WindowTransformAction::spillBlocks()
+{
+    assert(support_batch_calculate);
+    // All the buffered rows must be scanned by `advancePartitionEnd` to make sure that
+    // they belong to current partition.
+    if (partition_ended || partition_end != blocksEnd() || next_spill_block_number >= partition_end.block)
+        return {};
+
+    // All rows in the partition share one result, so the rows can be added to the aggregation
+    // states before the partition ends. `updateAggregationState` will skip these rows.
+    for (auto & ws : aggregation_workspaces)
+    {
+        if (pre_aggregated_end == partition_start)
+            ws.aggregate_function->reset(ws.aggregate_function_state.data());
+        addAggregationState(ws, pre_aggregated_end, partition_end);
+        // The cached argument columns are going to be released.
+        ws.cached_block_number = std::numeric_limits<UInt64>::max();
+    }
+    pre_aggregated_end = partition_end;
+
+    // The block of partition_start is kept, it is used by `isDifferentFromPrevPartition`.
+    Blocks blocks;
+    for (auto block_number = next_spill_block_number; block_number < partition_end.block; ++block_number)
+    {
+        auto & window_block = blockAt(block_number);
+        assert(!window_block.spilled);
+        blocks.push_back(input_header.cloneWithColumns(std::move(window_block.input_columns)));
+        window_block.input_columns.clear();
+        window_block.spilled = true;
+    }
+    spilled_block_num += blocks.size();
+    next_spill_block_number = partition_end.block;
+    unspilled_input_bytes = 0;
+    return blocks;
+}
+
+bool WindowTransformAction::needRestore() const
+{
+    if (next_output_block_number >= first_not_ready_row.block)
+        return false;
+    const auto & block = blockAt(next_output_block_number);
+    return block.spilled && block.input_columns.empty();
+}
+
+void WindowTransformAction::restoreBlock(Block && block)
+{
+    assert(needRestore());
+    auto & window_block = blockAt(next_output_block_number);
+    RUNTIME_CHECK_MSG(
+        block.rows() == window_block.rows,
+        "Unexpected rows of the restored window block, rows={}, expected={}",
+        block.rows(),
+        window_block.rows);
+    window_block.input_columns = block.getColumns();
+    --spilled_block_num;
 }
 
 bool WindowTransformAction::checkIfNeedDecrease()
@@ -1486,6 +1561,12 @@ void WindowTransformAction::updateAggregationState()
         {
             if (append_add)
                 start = prev_frame_end;
+            else if (partition_start < pre_aggregated_end)
+            {
+                // The states already contain the rows added by `spillBlocks`.
+                assert(support_batch_calculate && frame_start == partition_start);
+                start = pre_aggregated_end;
+            }
             else
                 ws.aggregate_function->reset(ws.aggregate_function_state.data());
         }
@@ -1634,6 +1715,9 @@ void WindowTransformAction::tryCalculate()
         peer_group_start_row_number = 1;
         peer_group_number = 1;
         is_range_null_frame_initialized = false;
+        pre_aggregated_end = partition_start;
+        next_spill_block_number = std::max(partition_start.block + 1, blocksEnd().block);
+        unspilled_input_bytes = 0;
     }
 }
 
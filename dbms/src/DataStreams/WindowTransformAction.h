@@ -39,6 +39,22 @@ public:
 
     void cleanUp();
 
+    // Whether all rows in same partition share one result, which is true when the frame is the whole
+    // partition and there are only aggregation functions.
+    static bool supportBatchCalculate(const WindowDescription & window_description);
+
+    // The blocks can only be spilled in the batch calculation. The rows of the unfinished partition are
+    // added to the aggregation states in advance, so the input columns are not needed until output.
+    bool supportSpill() const { return support_batch_calculate; }
+    // The bytes of the input columns that can be spilled by `spillBlocks`.
+    size_t revocableBytes() const { return partition_ended ? 0 : unspilled_input_bytes; }
+    // Take out the input columns of the blocks which only contain the rows of current partition.
+    Blocks spillBlocks();
+    // The next block to output is spilled, it must be restored by `restoreBlock` first.
+    bool needRestore() const;
+    void restoreBlock(Block && block);
+    bool hasSpilledBlocks() const { return spilled_block_num > 0; }
+
     void advancePartitionEnd();
     bool isDifferentFromPrevPartition(UInt64 current_partition_row);
 
@@ -238,6 +254,7 @@ public:
 
     bool input_is_finished = false;
 
+    Block input_header;
     Block output_header;
 
     WindowDescription window_description;
@@ -324,6 +341,16 @@ public:
     // When all rows in same partition share one result, we set this var to true
     bool support_batch_calculate = false;
 
+    // The aggregation states already contain the rows in [partition_start, pre_aggregated_end)
+    // of current partition, which are added by `spillBlocks`.
+    RowNumber pre_aggregated_end;
+    // The blocks before `next_spill_block_number` are not spillable.
+    UInt64 next_spill_block_number = 1;
+    // The bytes of the input columns of the blocks from `next_spill_block_number`.
+    size_t unspilled_input_bytes = 0;
+    // The number of spilled blocks which are not restored yet.
+    size_t spilled_block_num = 0;
+
     std::unique_ptr<Arena> arena;
 };
 } // namespace DB
@@ -34,6 +34,7 @@ struct DAGProperties
     UInt64 server_id = 1;
     UInt64 local_query_id = 1;
     Int64 task_id = 1;
+    Int64 mpp_version = 0;
 
     Int32 mpp_timeout = 60;
 };
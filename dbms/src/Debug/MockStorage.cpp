@@ -262,9 +262,11 @@ void MockStorage::buildExecFromDeltaMerge(
     bool keep_order,
     const FilterConditions * filter_conditions,
     std::vector<int> runtime_filter_ids,
-    int rf_max_wait_time_ms)
+    int rf_max_wait_time_ms,
+    bool read_string_dictionary)
 {
     auto [storage, column_names, query_info] = prepareForRead(context, table_id, keep_order);
+    query_info.read_string_dictionary = read_string_dictionary;
     if (filter_conditions && filter_conditions->hasValue())
     {
         auto analyzer = std::make_unique<DAGExpressionAnalyzer>(names_and_types_map_for_delta_merge[table_id], context);
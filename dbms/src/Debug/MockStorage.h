@@ -115,7 +115,8 @@ public:
         bool keep_order = false,
         const FilterConditions * filter_conditions = nullptr,
         std::vector<int> runtime_filter_ids = std::vector<int>(),
-        int rf_max_wait_time_ms = 0);
+        int rf_max_wait_time_ms = 0,
+        bool read_string_dictionary = false);
 
     bool tableExistsForDeltaMerge(Int64 table_id);
 
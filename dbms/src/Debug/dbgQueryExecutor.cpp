@@ -35,6 +35,7 @@ void fillTaskMetaWithDAGProperties(mpp::TaskMeta & meta, const DAGProperties & p
     meta.set_query_ts(properties.query_ts);
     meta.set_local_query_id(properties.local_query_id);
     meta.set_server_id(properties.server_id);
+    meta.set_mpp_version(properties.mpp_version);
 }
 
 void setTipbRegionInfo(
@@ -85,6 +85,41 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1Impl(ReadBuff
     return res;
 }
 
+std::optional<Block> CHBlockChunkDecodeAndSquash::squash(const Block & block)
+{
+    CodecUtils::checkColumnSize("CHBlockChunkDecodeAndSquash", codec.header.columns(), block.columns());
+    for (size_t i = 0; i < block.columns(); ++i)
+        CodecUtils::checkDataTypeName(
+            "CHBlockChunkDecodeAndSquash",
+            i,
+            codec.header.getByPosition(i).type->getName(),
+            block.getByPosition(i).type->getName());
+
+    std::optional<Block> res;
+    if (!block.rows())
+        return res;
+
+    if (!accumulated_block)
+    {
+        // The columns are shared with the sender, they are copied only when they need to be squashed.
+        accumulated_block.emplace(codec.header.cloneWithColumns(block.getColumns()));
+    }
+    else
+    {
+        auto mutable_columns = accumulated_block->mutateColumns();
+        for (size_t i = 0; i < mutable_columns.size(); ++i)
+            mutable_columns[i]->insertRangeFrom(*block.getByPosition(i).column, 0, block.rows());
+        accumulated_block->setColumns(std::move(mutable_columns));
+    }
+
+    if (accumulated_block->rows() >= rows_limit)
+    {
+        /// Return accumulated data and reset accumulated_block
+        res.swap(accumulated_block);
+    }
+    return res;
+}
+
 std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquash(const String & str)
 {
     auto block = doDecodeAndSquash(str);
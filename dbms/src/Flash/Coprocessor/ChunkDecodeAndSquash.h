@@ -28,6 +28,8 @@ public:
     ~CHBlockChunkDecodeAndSquash() = default;
     std::optional<Block> decodeAndSquash(const String &);
     std::optional<Block> decodeAndSquashV1(std::string_view);
+    /// Squash the block passed from local tunnel without serialization.
+    std::optional<Block> squash(const Block & block);
     std::optional<Block> flush();
 
 private:
@@ -14,6 +14,7 @@
 
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/TiDBTableScan.h>
+#include <Storages/MutableSupport.h>
 
 
 namespace DB
@@ -160,6 +161,33 @@ TiDBTableScan::TiDBTableScan(
         physical_table_ids.push_back(logical_table_id);
     }
 }
+std::vector<ColumnID> TiDBTableScan::getHandleColumnIDs() const
+{
+    if (is_partition_table_scan)
+        return {};
+    const auto & tbl_scan = table_scan->tbl_scan();
+    std::vector<ColumnID> handle_column_ids;
+    if (tbl_scan.primary_column_ids_size() > 0)
+    {
+        // The rows are only sorted by the prefix of a column with prefix index, so the columns after it are
+        // not in order.
+        const auto & prefix_column_ids = tbl_scan.primary_prefix_column_ids();
+        for (auto id : tbl_scan.primary_column_ids())
+        {
+            if (std::find(prefix_column_ids.begin(), prefix_column_ids.end(), id) != prefix_column_ids.end())
+                break;
+            handle_column_ids.push_back(id);
+        }
+        return handle_column_ids;
+    }
+    for (const auto & column : tbl_scan.columns())
+    {
+        if (column.pk_handle() || column.column_id() == MutSup::extra_handle_id)
+            return {column.column_id()};
+    }
+    return {};
+}
+
 void TiDBTableScan::constructTableScanForRemoteRead(tipb::TableScan * tipb_table_scan, TableID table_id) const
 {
     if (is_partition_table_scan)
@@ -36,9 +36,17 @@ public:
     const std::vector<Int64> & getPhysicalTableIDs() const { return physical_table_ids; }
     const String & getTableScanExecutorID() const { return executor_id; }
     bool keepOrder() const { return keep_order; }
+    /// The ids of the columns the rows are sorted by in the storage, i.e. the int handle column or the leading
+    /// columns of the clustered index. Return empty if unknown.
+    std::vector<ColumnID> getHandleColumnIDs() const;
 
     bool isFastScan() const { return is_fast_scan; }
 
+    /// Whether the String columns can be read as ColumnDictionaryString, only set by the planner when
+    /// the parent operators of the table scan can handle ColumnDictionaryString.
+    bool readStringDictionary() const { return read_string_dictionary; }
+    void setReadStringDictionary(bool read_string_dictionary_) { read_string_dictionary = read_string_dictionary_; }
+
     const tipb::Executor * getTableScanPB() const { return table_scan; }
     const std::vector<Int32> & getRuntimeFilterIDs() const { return runtime_filter_ids; }
     int getMaxWaitTimeMs() const { return max_wait_time_ms; }
@@ -77,6 +85,7 @@ private:
 
     bool keep_order;
     bool is_fast_scan;
+    bool read_string_dictionary = false;
     std::vector<Int32> runtime_filter_ids;
     int max_wait_time_ms;
 };
@@ -168,5 +168,61 @@ try
 }
 CATCH
 
+TEST_F(TestChunkDecodeAndSquash, testSquashLocalBlock)
+try
+{
+    const size_t rows_limit = 1024;
+    std::vector<Block> blocks;
+    for (size_t rows : {100, 2000, 0, 300, 500, 700})
+        blocks.emplace_back(prepareBlock(rows));
+
+    Block header = prepareBlock(0);
+    for (size_t i = 0; i < header.columns(); ++i)
+        header.getByPosition(i).name = fmt::format("exchange_receiver_{}", i);
+
+    // Mix the encoded chunks and the blocks passed from local tunnel
+    std::vector<Block> squashed_blocks;
+    CHBlockChunkDecodeAndSquash decoder(header, rows_limit);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        std::optional<Block> result;
+        if (i % 2 == 0)
+        {
+            result = decoder.squash(blocks[i]);
+        }
+        else
+        {
+            auto codec = CHBlockChunkCodecV1{blocks[i], GetMPPDataPacketVersion(GetMppVersion())};
+            result = decoder.decodeAndSquashV1(codec.encode(blocks[i], CompressionMethod::LZ4));
+        }
+        if (result)
+        {
+            ASSERT_EQ(result->getNames(), header.getNames());
+            squashed_blocks.push_back(std::move(*result));
+        }
+    }
+    auto last_block = decoder.flush();
+    if (last_block)
+        squashed_blocks.push_back(std::move(*last_block));
+    // 100 + 2000, 0 + 300 + 500 + 700
+    ASSERT_EQ(squashed_blocks.size(), 2);
+
+    // The blocks passed to squash are not modified
+    ASSERT_EQ(blocks[0].rows(), 100);
+
+    Block reference_block = squashBlocks(blocks);
+    Block squashed_block = squashBlocks(squashed_blocks);
+    for (size_t i = 0; i < squashed_block.columns(); ++i)
+        squashed_block.getByPosition(i).name = reference_block.getByPosition(i).name;
+    ASSERT_BLOCK_EQ(reference_block, squashed_block);
+
+    // The columns of a large enough block are passed through without copy
+    auto large_block = prepareBlock(rows_limit);
+    auto result = decoder.squash(large_block);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result->getByPosition(0).column.get(), large_block.getByPosition(0).column.get());
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
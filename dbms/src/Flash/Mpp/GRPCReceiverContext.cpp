@@ -203,7 +203,11 @@ struct LocalExchangePacketReader : public ExchangePacketReader
         TrackedMppDataPacketPtr tmp_packet = local_tunnel_sender->readForLocal();
         bool success = tmp_packet != nullptr;
         if (success)
+        {
+            // Read by the receiver thread, which will release the local blocks.
+            tmp_packet->switchLocalBlocksMemTracker(current_memory_tracker);
             packet = tmp_packet;
+        }
         return success;
     }
 
@@ -27,18 +27,26 @@ struct LocalRequestHandler
         std::function<void()> && notify_close_,
         std::function<void()> && add_local_conn_num_,
         const std::string & req_info_,
-        ReceivedMessageQueue * msg_queue_)
+        ReceivedMessageQueue * msg_queue_,
+        MemoryTracker * memory_tracker_)
         : notify_write_done(std::move(notify_write_done_))
         , notify_close(std::move(notify_close_))
         , add_local_conn_num(std::move(add_local_conn_num_))
         , req_info(req_info_)
         , msg_queue(msg_queue_)
+        , memory_tracker(memory_tracker_)
     {}
 
     template <bool is_force>
     bool write(size_t source_index, const TrackedMppDataPacketPtr & tracked_packet)
     {
-        return msg_queue->pushPacket<is_force>(source_index, req_info, tracked_packet, ReceiverMode::Local);
+        // The local blocks will be released by the receiver, see `TrackedMppDataPacket::switchLocalBlocksMemTracker`.
+        tracked_packet->switchLocalBlocksMemTracker(memory_tracker);
+        if (msg_queue->pushPacket<is_force>(source_index, req_info, tracked_packet, ReceiverMode::Local))
+            return true;
+        // The packet is dropped by the sender.
+        tracked_packet->switchLocalBlocksMemTracker(current_memory_tracker);
+        return false;
     }
 
     bool isWritable() const { return msg_queue->isWritable(); }
@@ -68,6 +76,8 @@ struct LocalRequestHandler
     std::function<void()> add_local_conn_num;
     const std::string req_info;
     ReceivedMessageQueue * msg_queue;
+    // The memory tracker of the receiver.
+    MemoryTracker * memory_tracker;
     UInt64 waiting_task_time = 0;
     Stopwatch watch;
 };
@@ -176,7 +176,7 @@ void MPPTunnel::write(TrackedMppDataPacketPtr && data)
 
     FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_tunnel_write_failpoint);
 
-    auto pushed_data_size = data->getPacket().ByteSizeLong();
+    auto pushed_data_size = data->byteSize();
     if (tunnel_sender->push(std::move(data)))
     {
         updateMetric(data_size_in_queue, pushed_data_size, mode);
@@ -195,7 +195,7 @@ void MPPTunnel::forceWrite(TrackedMppDataPacketPtr && data)
 
     FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_tunnel_write_failpoint);
 
-    auto pushed_data_size = data->getPacket().ByteSizeLong();
+    auto pushed_data_size = data->byteSize();
     if (tunnel_sender->forcePush(std::move(data)))
     {
         updateMetric(data_size_in_queue, pushed_data_size, mode);
@@ -518,7 +518,7 @@ std::shared_ptr<DB::TrackedMppDataPacket> LocalTunnelSenderV1::readForLocal()
     auto result = send_queue.pop(res);
     if (result == MPMCQueueResult::OK)
     {
-        MPPTunnelMetric::subDataSizeMetric(*data_size_in_queue, res->getPacket().ByteSizeLong());
+        MPPTunnelMetric::subDataSizeMetric(*data_size_in_queue, res->byteSize());
         return res;
     }
     else if (result == MPMCQueueResult::CANCELLED)
@@ -238,10 +238,12 @@ static void broadcastOrPassThroughWriteV0(
 MPPTunnelSetWriterBase::MPPTunnelSetWriterBase(
     const MPPTunnelSetPtr & mpp_tunnel_set_,
     const std::vector<tipb::FieldType> & result_field_types_,
-    const String & req_id)
+    const String & req_id,
+    bool pass_block_to_local_tunnel_)
     : mpp_tunnel_set(mpp_tunnel_set_)
     , result_field_types(result_field_types_)
     , log(Logger::get(req_id))
+    , pass_block_to_local_tunnel(pass_block_to_local_tunnel_)
 {
     RUNTIME_CHECK(mpp_tunnel_set->getPartitionNum() > 0);
 }
@@ -386,6 +388,8 @@ void MPPTunnelSetWriterBase::partitionWrite(
     assert(version > MPPDataPacketV0);
 
     bool is_local = mpp_tunnel_set->isLocal(partition_id);
+    if (is_local && pass_block_to_local_tunnel)
+        return localPartitionWrite(header, std::move(part_columns), partition_id, version);
     compression_method = is_local ? CompressionMethod::NONE : compression_method;
 
     size_t original_size = 0;
@@ -419,6 +423,15 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
             partition_id);
 
     bool is_local = mpp_tunnel_set->isLocal(partition_id);
+    if (is_local && pass_block_to_local_tunnel)
+        return localFineGrainedShuffleWrite(
+            header,
+            scattered,
+            bucket_idx,
+            fine_grained_shuffle_stream_count,
+            num_columns,
+            partition_id,
+            version);
     compression_method = is_local ? CompressionMethod::NONE : compression_method;
 
     size_t original_size = 0;
@@ -464,6 +477,58 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
         mpp_tunnel_set->isLocal(partition_id));
 }
 
+void MPPTunnelSetWriterBase::localPartitionWrite(
+    const Block & header,
+    std::vector<MutableColumns> && part_columns,
+    int16_t partition_id,
+    MPPDataPacketVersion version)
+{
+    auto tracked_packet = std::make_shared<TrackedMppDataPacket>(version);
+    for (auto & columns : part_columns)
+    {
+        auto block = header.cloneWithColumns(std::move(columns));
+        if (block.rows())
+            tracked_packet->addLocalBlock(std::move(block), 0);
+    }
+
+    auto packet_bytes = tracked_packet->byteSize();
+    writeToTunnel(std::move(tracked_packet), partition_id);
+    updatePartitionWriterMetrics(CompressionMethod::NONE, packet_bytes, packet_bytes, true);
+}
+
+void MPPTunnelSetWriterBase::localFineGrainedShuffleWrite(
+    const Block & header,
+    std::vector<IColumn::ScatterColumns> & scattered,
+    size_t bucket_idx,
+    UInt64 fine_grained_shuffle_stream_count,
+    size_t num_columns,
+    int16_t partition_id,
+    MPPDataPacketVersion version)
+{
+    auto tracked_packet = std::make_shared<TrackedMppDataPacket>(version);
+    for (uint64_t stream_idx = 0; stream_idx < fine_grained_shuffle_stream_count; ++stream_idx)
+    {
+        if (num_columns == 0 || scattered[0][bucket_idx + stream_idx]->empty())
+            continue;
+
+        // The scattered columns are handed over to the receiver, leave empty ones for the following writes.
+        MutableColumns columns;
+        columns.reserve(num_columns);
+        for (size_t col_id = 0; col_id < num_columns; ++col_id)
+        {
+            auto & column = scattered[col_id][bucket_idx + stream_idx];
+            auto empty_column = column->cloneEmpty();
+            columns.emplace_back(std::move(column));
+            column = std::move(empty_column);
+        }
+        tracked_packet->addLocalBlock(header.cloneWithColumns(std::move(columns)), stream_idx);
+    }
+
+    auto packet_bytes = tracked_packet->byteSize();
+    writeToTunnel(std::move(tracked_packet), partition_id);
+    updatePartitionWriterMetrics(CompressionMethod::NONE, packet_bytes, packet_bytes, true);
+}
+
 void SyncMPPTunnelSetWriter::writeToTunnel(TrackedMppDataPacketPtr && data, size_t index)
 {
     mpp_tunnel_set->write(std::move(data), index);
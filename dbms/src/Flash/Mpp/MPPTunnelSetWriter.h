@@ -25,7 +25,8 @@ public:
     MPPTunnelSetWriterBase(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id);
+        const String & req_id,
+        bool pass_block_to_local_tunnel_ = false);
 
     virtual ~MPPTunnelSetWriterBase() = default;
 
@@ -75,10 +76,29 @@ protected:
     virtual void writeToTunnel(TrackedMppDataPacketPtr && data, size_t index) = 0;
     virtual void writeToTunnel(tipb::SelectResponse & response, size_t index) = 0;
 
+private:
+    // Pass the blocks to a local tunnel without serialization and compression.
+    void localPartitionWrite(
+        const Block & header,
+        std::vector<MutableColumns> && part_columns,
+        int16_t partition_id,
+        MPPDataPacketVersion version);
+    void localFineGrainedShuffleWrite(
+        const Block & header,
+        std::vector<IColumn::ScatterColumns> & scattered,
+        size_t bucket_idx,
+        UInt64 fine_grained_shuffle_stream_count,
+        size_t num_columns,
+        int16_t partition_id,
+        MPPDataPacketVersion version);
+
 protected:
     MPPTunnelSetPtr mpp_tunnel_set;
     std::vector<tipb::FieldType> result_field_types;
     const LoggerPtr log;
+    // The receiver of a local tunnel is in the same process, so the blocks can be passed to it directly.
+    // Only the hash partition and fine grained shuffle writing with data codec version > V0 support it.
+    const bool pass_block_to_local_tunnel;
 };
 
 class SyncMPPTunnelSetWriter : public MPPTunnelSetWriterBase
@@ -87,8 +107,9 @@ public:
     SyncMPPTunnelSetWriter(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id)
-        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id)
+        const String & req_id,
+        bool pass_block_to_local_tunnel_ = false)
+        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id, pass_block_to_local_tunnel_)
     {}
 
     // For sync writer, `waitForWritable` will not be called, so an exception is thrown here.
@@ -106,8 +127,9 @@ public:
     AsyncMPPTunnelSetWriter(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id)
-        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id)
+        const String & req_id,
+        bool pass_block_to_local_tunnel_ = false)
+        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id, pass_block_to_local_tunnel_)
     {}
 
     WaitResult waitForWritable() const override { return mpp_tunnel_set->waitForWritable(); }
@@ -23,6 +23,14 @@ const std::vector<const String *> & ReceivedMessage::getChunks(size_t stream_id)
     else
         return chunks;
 }
+
+const std::vector<const Block *> & ReceivedMessage::getLocalBlocks(size_t stream_id) const
+{
+    if (fine_grained_consumer_size > 0)
+        return fine_grained_local_blocks[stream_id];
+    else
+        return local_blocks;
+}
 // Constructor that move chunks.
 ReceivedMessage::ReceivedMessage(
     size_t source_index_,
@@ -41,6 +49,10 @@ ReceivedMessage::ReceivedMessage(
     , remaining_consumers(fine_grained_consumer_size_)
     , fine_grained_consumer_size(fine_grained_consumer_size_)
 {
+    local_blocks.reserve(packet->local_blocks.size());
+    for (const auto & block : packet->local_blocks)
+        local_blocks.push_back(&block);
+
     if (fine_grained_consumer_size > 0)
     {
         fine_grained_chunks.resize(fine_grained_consumer_size);
@@ -67,10 +79,18 @@ ReceivedMessage::ReceivedMessage(
                 fine_grained_chunks[stream_id].push_back(&packet->packet.chunks(i));
             }
         }
+
+        fine_grained_local_blocks.resize(fine_grained_consumer_size);
+        RUNTIME_CHECK(packet->local_blocks.size() == packet->local_block_stream_ids.size());
+        for (size_t i = 0; i < packet->local_blocks.size(); ++i)
+        {
+            UInt64 stream_id = packet->local_block_stream_ids[i] % fine_grained_consumer_size;
+            fine_grained_local_blocks[stream_id].push_back(&packet->local_blocks[i]);
+        }
     }
 }
 bool ReceivedMessage::containUsefulMessage() const
 {
-    return error_ptr != nullptr || resp_ptr != nullptr || !chunks.empty();
+    return error_ptr != nullptr || resp_ptr != nullptr || !chunks.empty() || !local_blocks.empty();
 }
 } // namespace DB
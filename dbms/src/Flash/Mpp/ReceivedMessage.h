@@ -34,6 +34,9 @@ class ReceivedMessage
     std::vector<const String *> chunks;
     /// used for fine grained shuffle, remaining_consumers will be nullptr for non fine grained shuffle
     std::vector<std::vector<const String *>> fine_grained_chunks;
+    /// the blocks passed from local tunnel directly, see `TrackedMppDataPacket::addLocalBlock`
+    std::vector<const Block *> local_blocks;
+    std::vector<std::vector<const Block *>> fine_grained_local_blocks;
     std::atomic<size_t> remaining_consumers;
     size_t fine_grained_consumer_size;
     std::atomic<bool> packet_size_recorded{false}; // used to flag if fined grained shuffle packet size is recorded
@@ -55,7 +58,9 @@ public:
     const String * getRespPtr(size_t stream_id) const { return stream_id == 0 ? resp_ptr : nullptr; }
     std::atomic<size_t> & getRemainingConsumers() { return remaining_consumers; }
     const std::vector<const String *> & getChunks(size_t stream_id) const;
+    const std::vector<const Block *> & getLocalBlocks(size_t stream_id) const;
     const mpp::MPPDataPacket & getPacket() const { return packet->packet; }
+    size_t byteSize() const { return packet->byteSize(); }
     std::atomic<bool> & getPacketSizeRecorded() { return packet_size_recorded; }
     bool containUsefulMessage() const;
 };
@@ -95,7 +95,7 @@ ReceivedMessageQueue::ReceivedMessageQueue(
     , grpc_recv_queue(
           log_,
           queue_limits,
-          [](const ReceivedMessagePtr & message) { return message->getPacket().ByteSizeLong(); },
+          [](const ReceivedMessagePtr & message) { return message->byteSize(); },
           /// use pushcallback to make sure that the order of messages in msg_channels_for_fine_grained_shuffle is exactly the same as it in msg_channel,
           /// because pop from msg_channel rely on this assumption. An alternative is to make msg_channel a set/map of messages for fine grained shuffle, but
           /// it need many more changes
@@ -149,7 +149,7 @@ MPMCQueueResult ReceivedMessageQueue::pop(size_t stream_id, ReceivedMessagePtr &
 #else
                 grpc_recv_queue.tryDequeue();
 #endif
-                ExchangeReceiverMetric::subDataSizeMetric(*data_size_in_queue, recv_msg->getPacket().ByteSizeLong());
+                ExchangeReceiverMetric::subDataSizeMetric(*data_size_in_queue, recv_msg->byteSize());
             }
         }
         else
@@ -170,7 +170,7 @@ MPMCQueueResult ReceivedMessageQueue::pop(size_t stream_id, ReceivedMessagePtr &
 
         if (res == MPMCQueueResult::OK)
         {
-            ExchangeReceiverMetric::subDataSizeMetric(*data_size_in_queue, recv_msg->getPacket().ByteSizeLong());
+            ExchangeReceiverMetric::subDataSizeMetric(*data_size_in_queue, recv_msg->byteSize());
         }
         else
         {
@@ -202,7 +202,7 @@ bool ReceivedMessageQueue::pushPacket(
         success = grpc_recv_queue.push(std::move(received_message)) == MPMCQueueResult::OK;
 
     if (success)
-        ExchangeReceiverMetric::addDataSizeMetric(*data_size_in_queue, tracked_packet->getPacket().ByteSizeLong());
+        ExchangeReceiverMetric::addDataSizeMetric(*data_size_in_queue, tracked_packet->byteSize());
 
     injectFailPointReceiverPushFail(success, mode);
     return success;
@@ -222,7 +222,7 @@ MPMCQueueResult ReceivedMessageQueue::pushAsyncGRPCPacket(
 
     auto res = grpc_recv_queue.pushWithTag(std::move(received_message), new_tag);
     if likely (res == MPMCQueueResult::OK || res == MPMCQueueResult::FULL)
-        ExchangeReceiverMetric::addDataSizeMetric(*data_size_in_queue, tracked_packet->getPacket().ByteSizeLong());
+        ExchangeReceiverMetric::addDataSizeMetric(*data_size_in_queue, tracked_packet->byteSize());
 
     return res;
 }
@@ -25,6 +25,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 #include <Common/MemoryTracker.h>
+#include <Core/Block.h>
 #include <grpcpp/server_context.h>
 #include <kvproto/mpp.pb.h>
 #include <kvproto/tikvpb.grpc.pb.h>
@@ -132,6 +133,36 @@ struct TrackedMppDataPacket
         packet.add_chunks(std::move(value));
     }
 
+    // Used by local tunnels to pass blocks to the receiver without serialization and compression.
+    // The memory of the columns is charged to the tracker of the sender thread which allocated them,
+    // see `switchLocalBlocksMemTracker`. Trackers are charged by the capacity of the columns, so
+    // `allocatedBytes` instead of `bytes` is used.
+    void addLocalBlock(Block && block, UInt64 stream_id)
+    {
+        if (local_blocks.empty())
+            local_blocks_mem_tracker = current_memory_tracker;
+        local_blocks_bytes += block.allocatedBytes();
+        local_blocks.push_back(std::move(block));
+        local_block_stream_ids.push_back(stream_id);
+    }
+
+    // The columns of the local blocks are allocated by the sender but released by the receiver, and both
+    // of them update the tracker of the current thread. So the memory of the local blocks is moved from
+    // the sender's tracker to the receiver's tracker explicitly when the packet is pushed to the receiver.
+    void switchLocalBlocksMemTracker(MemoryTracker * new_memory_tracker)
+    {
+        if (local_blocks_bytes == 0 || new_memory_tracker == local_blocks_mem_tracker)
+            return;
+        if (new_memory_tracker)
+            new_memory_tracker->alloc(local_blocks_bytes);
+        if (local_blocks_mem_tracker)
+            local_blocks_mem_tracker->free(local_blocks_bytes);
+        local_blocks_mem_tracker = new_memory_tracker;
+    }
+
+    // The size of the data carried by this packet, used for the limit and metrics of queues.
+    size_t byteSize() const { return packet.ByteSizeLong() + local_blocks_bytes; }
+
     void serializeByResponse(const tipb::SelectResponse & response)
     {
         mem_tracker_wrapper.alloc(response.ByteSizeLong());
@@ -188,14 +219,25 @@ struct TrackedMppDataPacket
 
     std::shared_ptr<DB::TrackedMppDataPacket> copy() const
     {
-        return std::make_shared<TrackedMppDataPacket>(
+        auto res = std::make_shared<TrackedMppDataPacket>(
             packet,
             mem_tracker_wrapper.size,
             mem_tracker_wrapper.memory_tracker);
+        res->local_blocks = local_blocks;
+        res->local_block_stream_ids = local_block_stream_ids;
+        res->local_blocks_bytes = local_blocks_bytes;
+        res->local_blocks_mem_tracker = local_blocks_mem_tracker;
+        return res;
     }
 
     MemTrackerWrapper mem_tracker_wrapper;
     mpp::MPPDataPacket packet;
+    // local_block_stream_ids[i] is the fine grained shuffle stream id of local_blocks[i].
+    Blocks local_blocks;
+    std::vector<UInt64> local_block_stream_ids;
+    size_t local_blocks_bytes = 0;
+    // The tracker which the memory of `local_blocks` is charged to.
+    MemoryTracker * local_blocks_mem_tracker = nullptr;
     bool need_recompute = false;
     String error_message;
 };
@@ -16,6 +16,7 @@
 #include <Common/Logger.h>
 #include <Common/LooseBoundedMPMCQueue.h>
 #include <Common/MemoryTracker.h>
+#include <DataTypes/DataTypesNumber.h>
 #include <Flash/EstablishCall.h>
 #include <Flash/Mpp/GRPCReceiverContext.h>
 #include <Flash/Mpp/MPPTunnel.h>
@@ -195,7 +196,8 @@ public:
                 [this]() { this->connectionLocalDone(); },
                 []() {},
                 "",
-                &received_message_queue);
+                &received_message_queue,
+                nullptr);
             tunnel->connectLocalV2(0, local_request_handler, true);
         }
     }
@@ -657,7 +659,13 @@ try
     setTunnelFinished(tunnels[0]);
     ReceivedMessageQueue received_message_queue(1, Logger::get(), nullptr, false, 0);
 
-    LocalRequestHandler local_req_handler([](bool, const String &) {}, []() {}, []() {}, "", &received_message_queue);
+    LocalRequestHandler local_req_handler(
+        [](bool, const String &) {},
+        []() {},
+        []() {},
+        "",
+        &received_message_queue,
+        nullptr);
     tunnels[0]->connectLocalV2(0, local_req_handler, false);
     GTEST_FAIL();
 }
@@ -674,7 +682,7 @@ try
     auto [receiver, tunnels] = prepareLocal(1);
     GTEST_ASSERT_EQ(getTunnelConnectedFlag(tunnels[0]), true);
     ReceivedMessageQueue queue(1, Logger::get(), nullptr, false, 0);
-    LocalRequestHandler local_req_handler([](bool, const String &) {}, []() {}, []() {}, "", &queue);
+    LocalRequestHandler local_req_handler([](bool, const String &) {}, []() {}, []() {}, "", &queue, nullptr);
     tunnels[0]->connectLocalV2(0, local_req_handler, false);
     GTEST_FAIL();
 }
@@ -685,6 +693,53 @@ catch (Exception & e)
         "Check status == TunnelStatus::Unconnected failed: MPPTunnel 0000_0001 has connected or finished: Connected");
 }
 
+TEST_F(TestMPPTunnel, LocalBlocksMemTracker)
+try
+{
+    // Submit the memory of the columns to the trackers at once.
+    CurrentMemoryTracker::disableThreshold();
+    auto sender_mem_tracker = MemoryTracker::create();
+    auto receiver_mem_tracker = MemoryTracker::create();
+    ReceivedMessageQueue queue(1, Logger::get(), nullptr, false, 0);
+    LocalRequestHandler local_req_handler(
+        [](bool, const String &) {},
+        []() {},
+        []() {},
+        "",
+        &queue,
+        receiver_mem_tracker.get());
+
+    current_memory_tracker = sender_mem_tracker.get();
+    auto packet = std::make_shared<TrackedMppDataPacket>(MPPDataPacketV1);
+    {
+        // The capacity of the column is larger than its size, like the scattered columns.
+        auto column = ColumnUInt64::create();
+        column->reserve(1024);
+        for (UInt64 i = 0; i < 10; ++i)
+            column->insert(i);
+        Block block{ColumnWithTypeAndName(std::move(column), std::make_shared<DataTypeUInt64>(), "a")};
+        ASSERT_GT(block.allocatedBytes(), block.bytes());
+        packet->addLocalBlock(std::move(block), 0);
+    }
+    ASSERT_GT(sender_mem_tracker->get(), 0);
+    ASSERT_TRUE(local_req_handler.write<false>(0, packet));
+    packet.reset();
+    ASSERT_EQ(sender_mem_tracker->get(), 0);
+    ASSERT_GT(receiver_mem_tracker->get(), 0);
+
+    // The local blocks are released by the receiver.
+    current_memory_tracker = receiver_mem_tracker.get();
+    {
+        ReceivedMessagePtr recv_msg;
+        ASSERT_TRUE(queue.pop<false>(0, recv_msg) == MPMCQueueResult::OK);
+        ASSERT_EQ(recv_msg->getLocalBlocks(0).size(), 1);
+    }
+    current_memory_tracker = nullptr;
+    ASSERT_EQ(sender_mem_tracker->get(), 0);
+    ASSERT_EQ(receiver_mem_tracker->get(), 0);
+}
+CATCH
+
 TEST_F(TestMPPTunnel, LocalCloseBeforeConnect)
 try
 {
@@ -16,6 +16,7 @@
 #include <Common/Logger.h>
 #include <Common/LooseBoundedMPMCQueue.h>
 #include <Common/MemoryTracker.h>
+#include <DataTypes/DataTypesNumber.h>
 #include <Flash/Mpp/GRPCReceiverContext.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <gtest/gtest.h>
@@ -39,6 +40,13 @@ TrackedMppDataPacketPtr newDataPacket(const String & data)
     data_packet_ptr->getPacket().set_data(data);
     return data_packet_ptr;
 }
+
+Block newBlock(UInt64 value)
+{
+    auto column = ColumnUInt64::create();
+    column->insert(value);
+    return Block{ColumnWithTypeAndName(std::move(column), std::make_shared<DataTypeUInt64>(), "a")};
+}
 } // namespace
 
 class TestReceivedMessageQueue : public testing::Test
@@ -204,5 +212,52 @@ try
 }
 CATCH
 
+TEST_F(TestReceivedMessageQueue, LocalBlocks)
+try
+{
+    const size_t fine_grained_stream_size = 4;
+    for (bool fine_grained : {false, true})
+    {
+        std::atomic<Int64> data_size_in_queue{0};
+        ReceivedMessageQueue queue(10, log, &data_size_in_queue, fine_grained, fine_grained_stream_size);
+
+        auto packet = std::make_shared<TrackedMppDataPacket>(MPPDataPacketV1);
+        for (UInt64 i = 0; i < 6; ++i)
+            packet->addLocalBlock(newBlock(i), i);
+        const auto * first_column = packet->local_blocks[0].getByPosition(0).column.get();
+        ASSERT_GT(packet->byteSize(), 0);
+        ASSERT_TRUE(queue.pushPacket<false>(0, "mock", packet, ReceiverMode::Local));
+        ASSERT_EQ(data_size_in_queue.load(), packet->byteSize());
+
+        if (fine_grained)
+        {
+            for (size_t k = 0; k < fine_grained_stream_size; ++k)
+            {
+                ReceivedMessagePtr recv_msg;
+                ASSERT_TRUE(queue.pop<false>(k, recv_msg) == MPMCQueueResult::OK);
+                const auto & blocks = recv_msg->getLocalBlocks(k);
+                // stream k receives the blocks with stream id k and k + fine_grained_stream_size
+                ASSERT_EQ(blocks.size(), k < 2 ? 2 : 1);
+                for (size_t j = 0; j < blocks.size(); ++j)
+                {
+                    const auto & column = blocks[j]->getByPosition(0).column;
+                    ASSERT_EQ(column->getUInt(0), k + j * fine_grained_stream_size);
+                }
+            }
+        }
+        else
+        {
+            ReceivedMessagePtr recv_msg;
+            ASSERT_TRUE(queue.pop<false>(0, recv_msg) == MPMCQueueResult::OK);
+            const auto & blocks = recv_msg->getLocalBlocks(0);
+            ASSERT_EQ(blocks.size(), 6);
+            // The columns are passed without copy
+            ASSERT_EQ(blocks[0]->getByPosition(0).column.get(), first_column);
+        }
+        ASSERT_EQ(data_size_in_queue.load(), 0);
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
@@ -49,6 +49,27 @@ void UnitQueue::take(TaskPtr & task)
     assert(task);
 }
 
+void UnitQueue::take(TaskPtr & task, Int32 numa_node)
+{
+    assert(!task);
+    assert(!empty());
+    if (numa_node >= 0)
+    {
+        // Only look ahead a few tasks, so that the tasks are still roughly taken in FIFO order.
+        size_t i = 0;
+        for (auto it = task_queue.begin(); it != task_queue.end() && i < NUMA_LOOKAHEAD; ++it, ++i)
+        {
+            if ((*it)->numa_node == numa_node)
+            {
+                task = std::move(*it);
+                task_queue.erase(it);
+                return;
+            }
+        }
+    }
+    take(task);
+}
+
 bool UnitQueue::empty() const
 {
     return task_queue.empty();
@@ -165,50 +186,110 @@ void MultiLevelFeedbackQueue<TimeGetter>::submit(std::vector<TaskPtr> & tasks)
 }
 
 template <typename TimeGetter>
-bool MultiLevelFeedbackQueue<TimeGetter>::take(TaskPtr & task)
+int MultiLevelFeedbackQueue<TimeGetter>::selectQueueWithoutLock() const
 {
-    assert(!task);
+    // -1 means no candidates; else has candidate.
+    int queue_idx = -1;
+    double target_accu_time_microsecond = 0;
+    // Find the queue with the smallest execution time.
+    for (size_t i = 0; i < QUEUE_SIZE; ++i)
     {
-        // -1 means no candidates; else has candidate.
-        int queue_idx = -1;
-        double target_accu_time_microsecond = 0;
-        std::unique_lock lock(mu);
-        while (true)
+        // we just search for queue has element
+        const auto & cur_queue = level_queues[i];
+        if (!cur_queue->empty())
         {
-            // Remaining tasks will be drained in destructor.
-            if (unlikely(is_finished))
-                return false;
-
-            if (popTask(cancel_task_queue, task))
-                return true;
-
-            // Find the queue with the smallest execution time.
-            for (size_t i = 0; i < QUEUE_SIZE; ++i)
+            double local_target_time_microsecond = cur_queue->normalizedTimeMicrosecond();
+            if (queue_idx < 0 || local_target_time_microsecond < target_accu_time_microsecond)
             {
-                // we just search for queue has element
-                const auto & cur_queue = level_queues[i];
-                if (!cur_queue->empty())
-                {
-                    double local_target_time_microsecond = cur_queue->normalizedTimeMicrosecond();
-                    if (queue_idx < 0 || local_target_time_microsecond < target_accu_time_microsecond)
-                    {
-                        target_accu_time_microsecond = local_target_time_microsecond;
-                        queue_idx = i;
-                    }
-                }
+                target_accu_time_microsecond = local_target_time_microsecond;
+                queue_idx = i;
             }
-
-            if (queue_idx >= 0)
-                break;
-            cv.wait(lock);
         }
-        level_queues[queue_idx]->take(task);
     }
+    return queue_idx;
+}
+
+template <typename TimeGetter>
+bool MultiLevelFeedbackQueue<TimeGetter>::tryTakeWithoutLock(TaskPtr & task, Int32 numa_node)
+{
+    assert(!task);
+    if (popTask(cancel_task_queue, task))
+        return true;
 
+    int queue_idx = selectQueueWithoutLock();
+    if (queue_idx < 0)
+        return false;
+    level_queues[queue_idx]->take(task, numa_node);
     assert(task);
     return true;
 }
 
+template <typename TimeGetter>
+bool MultiLevelFeedbackQueue<TimeGetter>::take(TaskPtr & task)
+{
+    assert(!task);
+    std::unique_lock lock(mu);
+    while (true)
+    {
+        // Remaining tasks will be drained in destructor.
+        if (unlikely(is_finished))
+            return false;
+
+        if (tryTakeWithoutLock(task, -1))
+            return true;
+
+        cv.wait(lock);
+    }
+}
+
+template <typename TimeGetter>
+bool MultiLevelFeedbackQueue<TimeGetter>::takeBatch(std::vector<TaskPtr> & tasks, size_t max_size, Int32 numa_node)
+{
+    assert(max_size > 0);
+    std::unique_lock lock(mu);
+    while (true)
+    {
+        // Remaining tasks will be drained in destructor.
+        if (unlikely(is_finished))
+            return false;
+
+        TaskPtr task;
+        if (tryTakeWithoutLock(task, numa_node))
+        {
+            tasks.push_back(std::move(task));
+            break;
+        }
+
+        if (taker_wake_ups.tryConsume())
+            return true;
+
+        ++taker_wake_ups.waiting;
+        cv.wait(lock);
+        --taker_wake_ups.waiting;
+    }
+    // The accumulated time of the unit queues is only updated after the tasks are executed,
+    // so the tasks are selected as if `take` was called for `max_size` times.
+    for (size_t i = 1; i < max_size; ++i)
+    {
+        TaskPtr task;
+        if (!tryTakeWithoutLock(task, numa_node))
+            break;
+        tasks.push_back(std::move(task));
+    }
+    return true;
+}
+
+template <typename TimeGetter>
+void MultiLevelFeedbackQueue<TimeGetter>::wakeUpOneTaker()
+{
+    {
+        std::lock_guard lock(mu);
+        if (!taker_wake_ups.add())
+            return;
+    }
+    cv.notify_one();
+}
+
 template <typename TimeGetter>
 void MultiLevelFeedbackQueue<TimeGetter>::drainTaskQueueWithoutLock()
 {
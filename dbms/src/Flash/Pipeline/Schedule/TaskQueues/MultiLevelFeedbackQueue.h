@@ -80,6 +80,10 @@ public:
 
     void take(TaskPtr & task);
 
+    // Take the first task preferring `numa_node` among the first `NUMA_LOOKAHEAD` tasks,
+    // or the first task if not found.
+    void take(TaskPtr & task, Int32 numa_node);
+
     bool empty() const;
 
     double normalizedTimeMicrosecond();
@@ -89,6 +93,8 @@ public:
     std::atomic_uint64_t accu_consume_time_microsecond{0};
 
     std::list<TaskPtr> task_queue;
+
+    static constexpr size_t NUMA_LOOKAHEAD = 16;
 };
 using UnitQueuePtr = std::unique_ptr<UnitQueue>;
 
@@ -106,6 +112,10 @@ public:
 
     bool take(TaskPtr & task) override;
 
+    bool takeBatch(std::vector<TaskPtr> & tasks, size_t max_size, Int32 numa_node) override;
+
+    void wakeUpOneTaker() override;
+
     void updateStatistics(const TaskPtr & task, ExecTaskStatus, UInt64 inc_ns) override;
 
     bool empty() const override;
@@ -131,12 +141,18 @@ private:
 
     void submitTaskWithoutLock(TaskPtr && task);
 
+    // Return the index of the unit queue to take task from, -1 if all unit queues are empty.
+    int selectQueueWithoutLock() const;
+
+    bool tryTakeWithoutLock(TaskPtr & task, Int32 numa_node);
+
     void drainTaskQueueWithoutLock();
 
 private:
     mutable std::mutex mu;
     std::condition_variable cv;
     std::atomic_bool is_finished = false;
+    TakerWakeUps taker_wake_ups;
 
     // From high priority to low priority.
     // The higher the priority of the queue,
@@ -85,7 +85,11 @@ void ResourceControlQueue<NestedTaskQueueType>::submitWithoutLock(TaskPtr && tas
 }
 
 template <typename NestedTaskQueueType>
-bool ResourceControlQueue<NestedTaskQueueType>::take(TaskPtr & task)
+template <typename TakeFromGroup>
+bool ResourceControlQueue<NestedTaskQueueType>::takeImpl(
+    TaskPtr & task,
+    TakeFromGroup && take_from_group,
+    bool can_be_woken_up)
 {
     assert(!task);
     bool is_error_task = false;
@@ -134,19 +138,76 @@ bool ResourceControlQueue<NestedTaskQueueType>::take(TaskPtr & task)
             // Should not take any task from nested task queue for this situation.
             if (!ru_exhausted)
             {
-                mustTakeTask(group_info.task_queue, task);
+                take_from_group(group_info.task_queue, task);
+                assert(task);
                 return true;
             }
             wait_dura = LocalAdmissionController::global_instance->estWaitDuraMS(group_info.name);
         }
 
         assert(!task);
+        if (can_be_woken_up && taker_wake_ups.tryConsume())
+            return true;
+
         // Wakeup when:
         // 1. finish() is called.
         // 2. refill_token_callback is called by LAC.
         // 3. token refilled in trickle mode.
+        // 4. wakeUpOneTaker() is called.
+        ++taker_wake_ups.waiting;
         cv.wait_for(lock, std::chrono::milliseconds(wait_dura));
+        --taker_wake_ups.waiting;
+    }
+}
+
+template <typename NestedTaskQueueType>
+bool ResourceControlQueue<NestedTaskQueueType>::take(TaskPtr & task)
+{
+    return takeImpl(
+        task,
+        [](const NestedTaskQueuePtr & task_queue, TaskPtr & group_task) { mustTakeTask(task_queue, group_task); },
+        /*can_be_woken_up*/ false);
+}
+
+template <typename NestedTaskQueueType>
+bool ResourceControlQueue<NestedTaskQueueType>::takeBatch(
+    std::vector<TaskPtr> & tasks,
+    size_t max_size,
+    Int32 numa_node)
+{
+    assert(max_size > 0);
+    // The batch is taken from the resource group with the highest priority only,
+    // because the priorities are only refreshed once for each take.
+    std::vector<TaskPtr> group_tasks;
+    TaskPtr task;
+    bool taken = takeImpl(
+        task,
+        [&](const NestedTaskQueuePtr & task_queue, TaskPtr & group_task) {
+            assert(!task_queue->empty());
+            RUNTIME_CHECK(task_queue->takeBatch(group_tasks, max_size, numa_node));
+            group_task = std::move(group_tasks.front());
+        },
+        /*can_be_woken_up*/ true);
+    if (!taken)
+        return false;
+    // Woken up by `wakeUpOneTaker`.
+    if (!task)
+        return true;
+    tasks.push_back(std::move(task));
+    for (size_t i = 1; i < group_tasks.size(); ++i)
+        tasks.push_back(std::move(group_tasks[i]));
+    return true;
+}
+
+template <typename NestedTaskQueueType>
+void ResourceControlQueue<NestedTaskQueueType>::wakeUpOneTaker()
+{
+    {
+        std::lock_guard lock(mu);
+        if (!taker_wake_ups.add())
+            return;
     }
+    cv.notify_one();
 }
 
 template <typename NestedTaskQueueType>
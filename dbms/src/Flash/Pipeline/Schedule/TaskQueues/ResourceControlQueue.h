@@ -45,6 +45,10 @@ public:
 
     bool take(TaskPtr & task) override;
 
+    bool takeBatch(std::vector<TaskPtr> & tasks, size_t max_size, Int32 numa_node) override;
+
+    void wakeUpOneTaker() override;
+
     void updateStatistics(const TaskPtr & task, ExecTaskStatus exec_task_status, UInt64 inc_value) override;
 
     bool empty() const override;
@@ -90,10 +94,17 @@ private:
     void mustEraseResourceGroupInfoWithoutLock(const String & name);
     static void mustTakeTask(const NestedTaskQueuePtr & task_queue, TaskPtr & task);
 
+    // Wait for a task like `take`. When the resource group with the highest priority is scheduled,
+    // `take_from_group(task_queue, task)` is called to take tasks from its nested task queue.
+    // If `can_be_woken_up`, return true without any task when woken up by `wakeUpOneTaker`.
+    template <typename TakeFromGroup>
+    bool takeImpl(TaskPtr & task, TakeFromGroup && take_from_group, bool can_be_woken_up);
+
     mutable std::mutex mu;
     std::condition_variable cv;
 
     bool is_finished = false;
+    TakerWakeUps taker_wake_ups;
 
     std::priority_queue<ResourceGroupInfo> resource_group_infos;
     ResourceGroupTaskQueue resource_group_task_queues;
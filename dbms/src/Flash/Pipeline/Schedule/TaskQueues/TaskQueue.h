@@ -34,6 +34,26 @@ public:
     // Will return false if finished and all remaining tasks should be drained in destructor.
     virtual bool take(TaskPtr & task) = 0;
 
+    // Take at most `max_size` tasks and append them to `tasks`. Block like `take` until one task is taken at least,
+    // or return true without any task if woken up by `wakeUpOneTaker`.
+    // The tasks are taken in the same order as calling `take` repeatedly, but may acquire the lock only once.
+    // If `numa_node` >= 0, the tasks preferring this numa node may be taken before the others of the same priority.
+    // Will return false if finished.
+    virtual bool takeBatch(std::vector<TaskPtr> & tasks, size_t max_size, Int32 /*numa_node*/)
+    {
+        assert(max_size > 0);
+        TaskPtr task;
+        if (!take(task))
+            return false;
+        tasks.push_back(std::move(task));
+        return true;
+    }
+
+    // Make one thread waiting in `takeBatch`, or the next one going to wait, return without any task,
+    // so that it can look for tasks elsewhere, e.g. the local queues of other threads.
+    // The queues not supporting it just keep waiting for the submitted tasks.
+    virtual void wakeUpOneTaker() {}
+
     // Update the execution metrics of the task taken from the queue.
     // Used to adjust the priority of tasks within a queue.
     virtual void updateStatistics(const TaskPtr & task, ExecTaskStatus exec_task_status, UInt64 inc_ns) = 0;
@@ -51,6 +71,31 @@ protected:
 };
 using TaskQueuePtr = std::unique_ptr<TaskQueue>;
 
+// The wake-ups of the threads waiting in `takeBatch`, protected by the mutex of the task queue.
+struct TakerWakeUps
+{
+    size_t waiting = 0;
+    size_t pending = 0;
+
+    // Return false if there are enough pending wake-ups for the waiting threads already.
+    bool add()
+    {
+        // Allow one more for the thread going to wait.
+        if (pending > waiting)
+            return false;
+        ++pending;
+        return true;
+    }
+
+    bool tryConsume()
+    {
+        if (pending == 0)
+            return false;
+        --pending;
+        return true;
+    }
+};
+
 template <typename Queue>
 bool popTask(Queue & queue, TaskPtr & task)
 {
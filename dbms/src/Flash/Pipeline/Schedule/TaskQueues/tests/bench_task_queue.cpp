@@ -112,5 +112,77 @@ BENCHMARK_REGISTER_F(ResourceContorlQueue, Basic)
     ->Args({10, 1, 1, 10000, 2}) // 10000 * 1 * 2 / 10 = 2s
     ->Args({10, 15, 15, 1000, 2}) // 1000 * 15 * 2 / 10 = 3s
     ->Args({10, 200, 200, 1000, 2}); // 1000 * 200 * 2 / 10 = 40s
+
+// A task that finishes after a short computation, so the throughput is bounded by the scheduling cost.
+class ShortCPUTask : public Task
+{
+public:
+    explicit ShortCPUTask(PipelineExecutorContext & exec_context)
+        : Task(exec_context)
+    {}
+
+    ExecTaskStatus executeImpl() override
+    {
+        UInt64 sum = 0;
+        for (UInt64 i = 0; i < task_work_size; ++i)
+            benchmark::DoNotOptimize(sum += i);
+        return ExecTaskStatus::FINISHED;
+    }
+
+    UInt64 task_work_size = 0;
+};
+
+class WorkStealingBench : public benchmark::Fixture
+{
+};
+
+BENCHMARK_DEFINE_F(WorkStealingBench, ShortTasks)
+(benchmark::State & state)
+try
+{
+    const size_t pool_size = state.range(0);
+    const size_t local_queue_size = state.range(1);
+    const int task_num = state.range(2);
+    const UInt64 task_work_size = state.range(3);
+
+    TaskSchedulerConfig config{
+        {pool_size, TaskQueueType::DEFAULT, local_queue_size},
+        {pool_size, TaskQueueType::DEFAULT, local_queue_size},
+    };
+    TaskScheduler task_scheduler(config);
+    for (auto _ : state)
+    {
+        PipelineExecutorContext exec_context;
+
+        std::vector<TaskPtr> tasks;
+        tasks.resize(task_num);
+        for (int i = 0; i < task_num; ++i)
+        {
+            auto task = std::make_unique<ShortCPUTask>(exec_context);
+            task->task_work_size = task_work_size;
+            tasks[i] = std::move(task);
+        }
+
+        task_scheduler.submit(tasks);
+
+        exec_context.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * task_num);
+}
+CATCH
+// Compare the throughput of the shared task queue (local_queue_size = 0) and the local queues with
+// work stealing under different number of threads.
+BENCHMARK_REGISTER_F(WorkStealingBench, ShortTasks)
+    ->Args({1, 0, 100000, 1000})
+    ->Args({1, 16, 100000, 1000})
+    ->Args({4, 0, 100000, 1000})
+    ->Args({4, 16, 100000, 1000})
+    ->Args({16, 0, 100000, 1000})
+    ->Args({16, 16, 100000, 1000})
+    ->Args({64, 0, 100000, 1000})
+    ->Args({64, 16, 100000, 1000})
+    ->Args({128, 0, 100000, 1000})
+    ->Args({128, 16, 100000, 1000})
+    ->UseRealTime();
 } // namespace tests
 } // namespace DB
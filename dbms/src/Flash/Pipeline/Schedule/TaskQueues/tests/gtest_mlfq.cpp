@@ -282,4 +282,130 @@ try
 }
 CATCH
 
+TEST_F(TestMLFQTaskQueue, takeBatch)
+try
+{
+    PipelineExecutorContext context1("id1", "", nullptr);
+    // To avoid the active ref count being returned to 0 in advance.
+    context1.incActiveRefCount();
+    SCOPE_EXIT({ context1.decActiveRefCount(); });
+
+    PipelineExecutorContext context2("id2", "", nullptr);
+    // To avoid the active ref count being returned to 0 in advance.
+    context2.incActiveRefCount();
+    SCOPE_EXIT({ context2.decActiveRefCount(); });
+
+    CPUMultiLevelFeedbackQueue queue;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        queue.submit(std::make_unique<PlainTask>(context1));
+        queue.submit(std::make_unique<PlainTask>(context2));
+    }
+    // The cancelled tasks are taken first.
+    queue.cancel("id2", "");
+    std::vector<TaskPtr> tasks;
+    ASSERT_TRUE(queue.takeBatch(tasks, 15, -1));
+    ASSERT_EQ(tasks.size(), 15);
+    for (size_t i = 0; i < 10; ++i)
+        ASSERT_EQ(tasks[i]->getQueryId(), "id2");
+    for (size_t i = 10; i < 15; ++i)
+        ASSERT_EQ(tasks[i]->getQueryId(), "id1");
+    FINALIZE_TASKS(tasks);
+    tasks.clear();
+
+    // Take the remaining tasks.
+    ASSERT_TRUE(queue.takeBatch(tasks, 15, -1));
+    ASSERT_EQ(tasks.size(), 5);
+    FINALIZE_TASKS(tasks);
+    tasks.clear();
+    ASSERT_TRUE(queue.empty());
+
+    queue.finish();
+    ASSERT_FALSE(queue.takeBatch(tasks, 15, -1));
+    ASSERT_TRUE(tasks.empty());
+}
+CATCH
+
+TEST_F(TestMLFQTaskQueue, takeBatchWithNUMANode)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    CPUMultiLevelFeedbackQueue queue;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto task = std::make_unique<PlainTask>(context);
+        task->numa_node = i % 2;
+        queue.submit(std::move(task));
+    }
+    // The tasks of the numa node are taken first.
+    std::vector<TaskPtr> tasks;
+    ASSERT_TRUE(queue.takeBatch(tasks, 3, 1));
+    ASSERT_EQ(tasks.size(), 3);
+    for (const auto & task : tasks)
+        ASSERT_EQ(task->numa_node, 1);
+    FINALIZE_TASKS(tasks);
+    tasks.clear();
+
+    // Take the tasks of other nodes if there are no tasks of the numa node.
+    ASSERT_TRUE(queue.takeBatch(tasks, 5, 1));
+    ASSERT_EQ(tasks.size(), 5);
+    ASSERT_EQ(tasks[0]->numa_node, 1);
+    ASSERT_EQ(tasks[1]->numa_node, 1);
+    for (size_t i = 2; i < 5; ++i)
+        ASSERT_EQ(tasks[i]->numa_node, 0);
+    FINALIZE_TASKS(tasks);
+    tasks.clear();
+
+    // No preference.
+    ASSERT_TRUE(queue.takeBatch(tasks, 5, -1));
+    ASSERT_EQ(tasks.size(), 2);
+    FINALIZE_TASKS(tasks);
+    ASSERT_TRUE(queue.empty());
+}
+CATCH
+
+TEST_F(TestMLFQTaskQueue, wakeUpOneTaker)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    CPUMultiLevelFeedbackQueue queue;
+    std::vector<TaskPtr> tasks;
+
+    // The thread going to wait is woken up too.
+    queue.wakeUpOneTaker();
+    ASSERT_TRUE(queue.takeBatch(tasks, 5, -1));
+    ASSERT_TRUE(tasks.empty());
+
+    // Wake up the waiting thread.
+    auto thread_manager = newThreadManager();
+    thread_manager->schedule(false, "take", [&]() {
+        std::vector<TaskPtr> taken_tasks;
+        ASSERT_TRUE(queue.takeBatch(taken_tasks, 5, -1));
+        ASSERT_TRUE(taken_tasks.empty());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.wakeUpOneTaker();
+    thread_manager->wait();
+
+    // The pending wake-ups are bounded by the waiting threads.
+    queue.wakeUpOneTaker();
+    queue.wakeUpOneTaker();
+    ASSERT_TRUE(queue.takeBatch(tasks, 5, -1));
+    ASSERT_TRUE(tasks.empty());
+    queue.submit(std::make_unique<PlainTask>(context));
+    ASSERT_TRUE(queue.takeBatch(tasks, 5, -1));
+    ASSERT_EQ(tasks.size(), 1);
+    FINALIZE_TASKS(tasks);
+    ASSERT_TRUE(queue.empty());
+}
+CATCH
+
 } // namespace DB::tests
@@ -64,6 +64,10 @@ void TaskScheduler::submit(std::vector<TaskPtr> & tasks)
     if (unlikely(tasks.empty()))
         return;
 
+    // The tasks submitted together are usually from the same pipeline, so assign numa nodes before
+    // they are dispatched to different thread pools.
+    cpu_task_thread_pool.assignNUMANodes(tasks);
+
     std::vector<TaskPtr> cpu_tasks;
     std::vector<TaskPtr> io_tasks;
     std::list<TaskPtr> await_tasks;
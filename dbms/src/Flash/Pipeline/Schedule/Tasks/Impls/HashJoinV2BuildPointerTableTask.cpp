@@ -18,6 +18,11 @@ namespace DB
 {
 ExecTaskStatus HashJoinV2BuildPointerTableTask::executeImpl()
 {
+    if (join_ptr->insertOneBuildBlockKeptInMemory(index))
+        return ExecTaskStatus::RUNNING;
+    /// Wait for the other tasks to insert their blocks rather than polling on the cpu pool.
+    if (!join_ptr->isBuildBlocksKeptInMemoryInsertedForPipeline())
+        return ExecTaskStatus::WAIT_FOR_NOTIFY;
     if (!join_ptr->buildPointerTable(index))
         return ExecTaskStatus::RUNNING;
     return ExecTaskStatus::FINISHED;
@@ -145,6 +145,10 @@ public:
     // level of multi-level feedback queue.
     size_t mlfq_level{0};
 
+    // The numa node the task prefers to run on, -1 means no preference.
+    // Assigned by the cpu task thread pool if it is numa-aware.
+    Int32 numa_node{-1};
+
 private:
     PipelineExecutorContext & exec_context;
 
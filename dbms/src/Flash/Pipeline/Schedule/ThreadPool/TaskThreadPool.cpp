@@ -22,9 +22,11 @@
 #include <Flash/Pipeline/Schedule/Tasks/TaskTimer.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPool.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolImpl.h>
+#include <Storages/DeltaMerge/ReadThread/CPU.h>
 #include <common/likely.h>
 #include <common/logger_useful.h>
 
+#include <algorithm>
 #include <ext/scope_guard.h>
 
 namespace DB
@@ -32,9 +34,34 @@ namespace DB
 template <typename Impl>
 TaskThreadPool<Impl>::TaskThreadPool(TaskScheduler & scheduler_, const ThreadPoolConfig & config)
     : task_queue(Impl::newTaskQueue(config.queue_type))
+    , local_queue_size(config.local_queue_size)
+    , pool_size(config.pool_size)
     , scheduler(scheduler_)
 {
     RUNTIME_CHECK(config.pool_size > 0);
+    if (config.numa_aware)
+    {
+#ifdef DBMS_PUBLIC_GTEST
+        if (config.mock_numa_nodes > 0)
+            numa_node_cpus.resize(config.mock_numa_nodes);
+        else
+#endif
+            numa_node_cpus = DM::getNumaNodes(logger);
+        if (numa_node_cpus.size() > 1)
+        {
+            thread_numa_nodes.reserve(config.pool_size);
+            for (size_t i = 0; i < config.pool_size; ++i)
+                thread_numa_nodes.push_back(i * numa_node_cpus.size() / config.pool_size);
+            threads_per_numa_node = (config.pool_size + numa_node_cpus.size() - 1) / numa_node_cpus.size();
+        }
+        LOG_INFO(logger, "numa_nodes={} thread_numa_nodes={}", numa_node_cpus.size(), thread_numa_nodes);
+    }
+    if (local_queue_size > 0)
+    {
+        local_queues.reserve(config.pool_size);
+        for (size_t i = 0; i < config.pool_size; ++i)
+            local_queues.push_back(std::make_unique<LocalTaskQueue>());
+    }
     threads.reserve(config.pool_size);
     for (size_t i = 0; i < config.pool_size; ++i)
         threads.emplace_back(&TaskThreadPool::loop, this, i);
@@ -60,6 +87,8 @@ void TaskThreadPool<Impl>::loop(size_t thread_no)
     try
     {
         CPUAffinityManager::getInstance().bindSelfQueryThread();
+        if (auto numa_node = getNUMANode(thread_no); numa_node >= 0)
+            DM::setCPUAffinity(numa_node_cpus[numa_node], logger);
         doLoop(thread_no);
     }
     CATCH_AND_TERMINATE(logger)
@@ -78,9 +107,12 @@ void TaskThreadPool<Impl>::doLoop(size_t thread_no)
     LOG_INFO(thread_logger, "start loop");
 
     TaskPtr task;
-    while (likely(task_queue->take(task)))
+    const auto numa_node = getNUMANode(thread_no);
+    while (likely(takeTask(thread_no, task)))
     {
         metrics.decPendingTask();
+        if (unlikely(task->numa_node != numa_node) && numa_node >= 0 && task->numa_node >= 0)
+            metrics.incCrossNUMASteal();
         handleTask(task);
         assert(!task);
     }
@@ -88,6 +120,104 @@ void TaskThreadPool<Impl>::doLoop(size_t thread_no)
     LOG_INFO(thread_logger, "loop finished");
 }
 
+template <typename Impl>
+bool TaskThreadPool<Impl>::takeTask(size_t thread_no, TaskPtr & task)
+{
+    const auto numa_node = getNUMANode(thread_no);
+    if (local_queues.empty())
+    {
+        if (numa_node < 0)
+            return task_queue->take(task);
+        std::vector<TaskPtr> tasks;
+        if (!task_queue->takeBatch(tasks, 1, numa_node))
+            return false;
+        task = std::move(tasks.front());
+        return true;
+    }
+
+    assert(!task);
+    auto & local_queue = *local_queues[thread_no];
+    std::vector<TaskPtr> tasks;
+    while (true)
+    {
+        {
+            std::lock_guard lock(local_queue.mu);
+            if (popTask(local_queue.tasks, task))
+                return true;
+        }
+        if (stealTask(thread_no, task))
+            return true;
+
+        // Leave enough tasks in `task_queue` for the other threads.
+        const auto batch_size = std::clamp<Int64>(
+            global_pending_tasks.load(std::memory_order_relaxed) / static_cast<Int64>(pool_size),
+            1,
+            local_queue_size);
+        tasks.reserve(batch_size);
+        // The remaining tasks in local queues have been taken before, since a thread only takes from
+        // `task_queue` when its local queue is empty. So just return when `task_queue` is finished.
+        if (!task_queue->takeBatch(tasks, batch_size, numa_node))
+            return false;
+        // Woken up by `pushToLocalQueue` of another thread, try to steal again.
+        if (!tasks.empty())
+            break;
+    }
+    global_pending_tasks.fetch_sub(tasks.size(), std::memory_order_relaxed);
+
+    task = std::move(tasks.front());
+    pushToLocalQueue(thread_no, tasks);
+    return true;
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::pushToLocalQueue(size_t thread_no, std::vector<TaskPtr> & tasks)
+{
+    if (tasks.size() <= 1)
+        return;
+    {
+        auto & local_queue = *local_queues[thread_no];
+        std::lock_guard lock(local_queue.mu);
+        for (size_t i = 1; i < tasks.size(); ++i)
+            local_queue.tasks.push_back(std::move(tasks[i]));
+    }
+    // The tasks can be stolen now, but the idle threads are waiting on `task_queue` and
+    // won't check the local queues until they are woken up.
+    task_queue->wakeUpOneTaker();
+}
+
+template <typename Impl>
+bool TaskThreadPool<Impl>::stealTask(size_t thread_no, TaskPtr & task)
+{
+    assert(!task);
+    std::vector<TaskPtr> stolen_tasks;
+    auto try_steal = [&](bool same_numa_node) {
+        for (size_t i = 1; i < pool_size; ++i)
+        {
+            const size_t victim_no = (thread_no + i) % pool_size;
+            if (same_numa_node != (getNUMANode(victim_no) == getNUMANode(thread_no)))
+                continue;
+            auto & victim = *local_queues[victim_no];
+            std::lock_guard lock(victim.mu);
+            if (victim.tasks.empty())
+                continue;
+            // Steal the later half, the owner keeps running the earlier tasks.
+            const size_t steal_size = (victim.tasks.size() + 1) / 2;
+            auto steal_begin = victim.tasks.end() - steal_size;
+            stolen_tasks.assign(std::make_move_iterator(steal_begin), std::make_move_iterator(victim.tasks.end()));
+            victim.tasks.erase(steal_begin, victim.tasks.end());
+            return true;
+        }
+        return false;
+    };
+    // Steal from the threads of the same numa node first.
+    if (!try_steal(true) && (thread_numa_nodes.empty() || !try_steal(false)))
+        return false;
+
+    task = std::move(stolen_tasks.front());
+    pushToLocalQueue(thread_no, stolen_tasks);
+    return true;
+}
+
 template <typename Impl>
 void TaskThreadPool<Impl>::handleTask(TaskPtr & task)
 {
@@ -140,17 +270,45 @@ void TaskThreadPool<Impl>::handleTask(TaskPtr & task)
     }
 }
 
+template <typename Impl>
+void TaskThreadPool<Impl>::assignNUMANodes(std::vector<TaskPtr> & tasks)
+{
+    if (thread_numa_nodes.empty())
+        return;
+    // The tasks may have been assigned by `TaskScheduler::submit` already, don't move to the next
+    // numa node for them, otherwise the pipelines always start on the same numa node.
+    if (std::none_of(tasks.begin(), tasks.end(), [](const TaskPtr & task) { return task->numa_node < 0; }))
+        return;
+    const size_t start_node = next_numa_node.fetch_add(1, std::memory_order_relaxed);
+    size_t i = 0;
+    for (auto & task : tasks)
+    {
+        if (task->numa_node < 0)
+        {
+            task->numa_node = (start_node + i / threads_per_numa_node) % numa_node_cpus.size();
+            ++i;
+        }
+    }
+}
+
 template <typename Impl>
 void TaskThreadPool<Impl>::submit(TaskPtr && task)
 {
+    if (unlikely(!thread_numa_nodes.empty() && task->numa_node < 0))
+        task->numa_node = next_numa_node.fetch_add(1, std::memory_order_relaxed) % numa_node_cpus.size();
     metrics.incPendingTask(1);
+    if (!local_queues.empty())
+        global_pending_tasks.fetch_add(1, std::memory_order_relaxed);
     task_queue->submit(std::move(task));
 }
 
 template <typename Impl>
 void TaskThreadPool<Impl>::submit(std::vector<TaskPtr> & tasks)
 {
+    assignNUMANodes(tasks);
     metrics.incPendingTask(tasks.size());
+    if (!local_queues.empty())
+        global_pending_tasks.fetch_add(tasks.size(), std::memory_order_relaxed);
     task_queue->submit(tasks);
 }
 
@@ -20,7 +20,10 @@
 #include <Flash/Pipeline/Schedule/Tasks/Task.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolMetrics.h>
 
+#include <atomic>
+#include <deque>
 #include <magic_enum.hpp>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -40,12 +43,33 @@ struct ThreadPoolConfig
         , queue_type(queue_type_)
     {}
 
+    ThreadPoolConfig(size_t pool_size_, TaskQueueType queue_type_, size_t local_queue_size_, bool numa_aware_ = false)
+        : pool_size(pool_size_)
+        , queue_type(queue_type_)
+        , local_queue_size(local_queue_size_)
+        , numa_aware(numa_aware_)
+    {}
+
     size_t pool_size;
     TaskQueueType queue_type = TaskQueueType::DEFAULT;
+    // The max number of tasks taken from the task queue at once by a thread. 0 means disabling the local queues.
+    size_t local_queue_size = 0;
+    // Partition the threads to numa nodes and keep the tasks on their numa nodes where possible.
+    bool numa_aware = false;
+#ifdef DBMS_PUBLIC_GTEST
+    // The number of mock numa nodes used instead of the real ones if > 0.
+    // The threads are partitioned to the mock numa nodes but not bound to any cpus.
+    size_t mock_numa_nodes = 0;
+#endif
 
     String toString() const
     {
-        return fmt::format("[pool_size: {}, queue_type: {}]", pool_size, magic_enum::enum_name(queue_type));
+        return fmt::format(
+            "[pool_size: {}, queue_type: {}, local_queue_size: {}, numa_aware: {}]",
+            pool_size,
+            magic_enum::enum_name(queue_type),
+            local_queue_size,
+            numa_aware);
     }
 };
 
@@ -67,15 +91,60 @@ public:
 
     void cancel(const String & query_id, const String & resource_group_name);
 
+    // Assign numa nodes to the tasks of a pipeline if the pool is numa-aware.
+    // The tasks are assigned to one node as long as they don't exceed the threads of the node.
+    void assignNUMANodes(std::vector<TaskPtr> & tasks);
+
 private:
     void loop(size_t thread_no);
     void doLoop(size_t thread_no);
 
+    // Return false if the task queue is finished.
+    bool takeTask(size_t thread_no, TaskPtr & task);
+    bool stealTask(size_t thread_no, TaskPtr & task);
+    // Push `tasks` except the first one to the local queue of the thread and wake up an idle thread to steal them.
+    void pushToLocalQueue(size_t thread_no, std::vector<TaskPtr> & tasks);
+
+    Int32 getNUMANode(size_t thread_no) const
+    {
+        return thread_numa_nodes.empty() ? -1 : thread_numa_nodes[thread_no];
+    }
+
     void handleTask(TaskPtr & task);
 
 private:
     TaskQueuePtr task_queue;
 
+    /// When `local_queue_size` > 0, each thread takes a batch of tasks from `task_queue` under one
+    /// lock, runs the first one and buffers the others in its local queue. An idle thread steals
+    /// half of the tasks from the local queue of another thread before it waits on `task_queue`, and
+    /// is woken up to steal again once some tasks are pushed to a local queue.
+    /// The scheduling policy, e.g. the MLFQ level and the resource group priority, is still decided
+    /// by `task_queue`, because the yielded tasks are always submitted back to `task_queue`.
+    struct LocalTaskQueue
+    {
+        std::mutex mu;
+        std::deque<TaskPtr> tasks;
+    };
+    std::vector<std::unique_ptr<LocalTaskQueue>> local_queues;
+    const size_t local_queue_size;
+    const size_t pool_size;
+    // The number of tasks in `task_queue`, used to limit the batch size so that a thread doesn't
+    // buffer the tasks while the other threads are idle. Only maintained if local queues are enabled.
+    std::atomic<Int64> global_pending_tasks{0};
+
+    /// When `numa_aware` and there are multiple numa nodes, the threads are evenly partitioned to the
+    /// numa nodes and bound to the cpus of their nodes. A task gets a numa node when it is submitted
+    /// at first, and the threads of the node take it before other tasks of the same priority. Other
+    /// threads take it only if they are idle, which is counted as a cross numa steal.
+    /// Linux places a page on the numa node of the thread touching it first, so the memory allocated
+    /// by a task, e.g. the `Arena` and the hash table of aggregation, is also kept on its node.
+    std::vector<std::vector<int>> numa_node_cpus;
+    // The numa node of each thread. Empty if not numa-aware.
+    std::vector<Int32> thread_numa_nodes;
+    size_t threads_per_numa_node = 0;
+    std::atomic<size_t> next_numa_node{0};
+
     LoggerPtr logger = Logger::get(Impl::NAME);
 
     TaskScheduler & scheduler;
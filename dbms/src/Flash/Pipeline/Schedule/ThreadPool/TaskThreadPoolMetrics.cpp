@@ -126,6 +126,12 @@ void TaskThreadPoolMetrics<is_cpu>::decThreadCnt()
     DEC_METRIC(task_thread_pool_size, 1);
 }
 
+template <bool is_cpu>
+void TaskThreadPoolMetrics<is_cpu>::incCrossNUMASteal()
+{
+    INC_METRIC(cross_numa_steal_count, 1);
+}
+
 template class TaskThreadPoolMetrics<true>;
 template class TaskThreadPoolMetrics<false>;
 
@@ -41,6 +41,9 @@ public:
     void incThreadCnt();
 
     void decThreadCnt();
+
+    // A task is executed by a thread on another numa node than the one it prefers.
+    void incCrossNUMASteal();
 };
 
 } // namespace DB
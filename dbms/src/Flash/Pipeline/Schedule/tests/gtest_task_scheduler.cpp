@@ -43,6 +43,25 @@ private:
     int loop_count = 5;
 };
 
+class NUMANodeRecordTask : public Task
+{
+public:
+    NUMANodeRecordTask(PipelineExecutorContext & exec_context_, Int32 & recorded_numa_node_)
+        : Task(exec_context_)
+        , recorded_numa_node(recorded_numa_node_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() noexcept override
+    {
+        recorded_numa_node = numa_node;
+        return ExecTaskStatus::FINISHED;
+    }
+
+private:
+    Int32 & recorded_numa_node;
+};
+
 class SimpleWaitingTask : public Task
 {
 public:
@@ -180,10 +199,17 @@ class TaskSchedulerTestRunner : public ::testing::Test
 public:
     static constexpr size_t thread_num = 5;
 
-    static void submitAndWait(std::vector<TaskPtr> & tasks, PipelineExecutorContext & exec_context)
+    static void submitAndWait(
+        std::vector<TaskPtr> & tasks,
+        PipelineExecutorContext & exec_context,
+        size_t local_queue_size = 0,
+        bool numa_aware = false)
     {
         DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
-        TaskSchedulerConfig config{thread_num, thread_num};
+        TaskSchedulerConfig config{
+            {thread_num, TaskQueueType::DEFAULT, local_queue_size, numa_aware},
+            {thread_num, TaskQueueType::DEFAULT, local_queue_size},
+        };
         TaskScheduler task_scheduler{config};
         task_scheduler.submit(tasks);
         std::chrono::seconds timeout(15);
@@ -219,6 +245,84 @@ try
 }
 CATCH
 
+TEST_F(TaskSchedulerTestRunner, workStealing)
+try
+{
+    for (size_t local_queue_size : {1, 4, 16})
+    {
+        for (size_t task_num = 1; task_num < 100; ++task_num)
+        {
+            PipelineExecutorContext exec_context;
+            std::vector<TaskPtr> tasks;
+            for (size_t i = 0; i < task_num; ++i)
+            {
+                if (i % 2)
+                    tasks.push_back(std::make_unique<SimpleTask>(exec_context));
+                else
+                    tasks.push_back(std::make_unique<SimpleWaitingTask>(exec_context));
+            }
+            submitAndWait(tasks, exec_context, local_queue_size);
+        }
+    }
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, numaAware)
+try
+{
+    for (size_t local_queue_size : {0, 4})
+    {
+        for (size_t task_num = 1; task_num < 100; ++task_num)
+        {
+            PipelineExecutorContext exec_context;
+            std::vector<TaskPtr> tasks;
+            for (size_t i = 0; i < task_num; ++i)
+                tasks.push_back(std::make_unique<SimpleWaitingTask>(exec_context));
+            submitAndWait(tasks, exec_context, local_queue_size, /*numa_aware*/ true);
+        }
+    }
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, numaNodeAssignment)
+try
+{
+    PipelineExecutorContext exec_context;
+    DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
+    // 4 threads on 2 numa nodes, 2 threads per numa node.
+    ThreadPoolConfig cpu_config{4, TaskQueueType::DEFAULT, 0, /*numa_aware*/ true};
+    cpu_config.mock_numa_nodes = 2;
+    TaskSchedulerConfig config{cpu_config, {thread_num}};
+    TaskScheduler task_scheduler{config};
+
+    constexpr size_t pipeline_num = 6;
+    constexpr size_t tasks_per_pipeline = 2;
+    std::vector<std::vector<Int32>> numa_nodes(pipeline_num, std::vector<Int32>(tasks_per_pipeline, -1));
+    std::vector<std::vector<TaskPtr>> pipelines(pipeline_num);
+    for (size_t i = 0; i < pipeline_num; ++i)
+    {
+        for (size_t j = 0; j < tasks_per_pipeline; ++j)
+            pipelines[i].push_back(std::make_unique<NUMANodeRecordTask>(exec_context, numa_nodes[i][j]));
+    }
+    for (auto & tasks : pipelines)
+        task_scheduler.submit(tasks);
+    exec_context.waitFor(std::chrono::seconds(15));
+
+    // The tasks of a pipeline are on one numa node, and the pipelines are spread across the numa nodes in turn.
+    for (size_t i = 0; i < pipeline_num; ++i)
+    {
+        for (size_t j = 0; j < tasks_per_pipeline; ++j)
+        {
+            ASSERT_GE(numa_nodes[i][j], 0);
+            ASSERT_LT(numa_nodes[i][j], 2);
+            ASSERT_EQ(numa_nodes[i][j], numa_nodes[i][0]);
+        }
+        if (i > 0)
+            ASSERT_NE(numa_nodes[i][0], numa_nodes[i - 1][0]) << "pipeline " << i;
+    }
+}
+CATCH
+
 TEST_F(TaskSchedulerTestRunner, testMemoryTrace)
 try
 {
@@ -15,6 +15,7 @@
 #include <Common/TiFlashMetrics.h>
 #include <Debug/MockStorage.h>
 #include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/FineGrainedShuffle.h>
 #include <Flash/Pipeline/Pipeline.h>
 #include <Flash/Pipeline/PipelineBuilder.h>
@@ -63,6 +64,67 @@ bool pushDownSelection(
     }
     return false;
 }
+
+/// For `row_number() over (partition by ... order by ...) <= K`, only the first K rows of each partition
+/// are needed, so the window sort can keep the top K rows of each partition instead of sorting all rows.
+void pushDownRowNumberLimit(const PhysicalPlanNodePtr & plan, const tipb::Selection & selection)
+{
+    if (plan->tp() != PlanType::Window || plan->children(0)->tp() != PlanType::WindowSort)
+        return;
+    auto physical_window = std::static_pointer_cast<PhysicalWindow>(plan);
+    const auto & window_description = physical_window->getWindowDescription();
+    const auto & functions = window_description.window_functions_descriptions;
+    if (functions.size() != 1 || functions[0].window_function == nullptr
+        || functions[0].window_function->getName() != "row_number")
+        return;
+    // The result of the only window function is the last column of window.
+    const auto & schema = physical_window->getSchema();
+    const auto & row_number_name = schema.back().name;
+
+    std::optional<Int64> limit;
+    for (const auto & condition : selection.conditions())
+    {
+        if (!isScalarFunctionExpr(condition) || condition.children_size() != 2)
+            continue;
+        // `row_number <= K`, `row_number < K`, `K >= row_number` and `K > row_number`.
+        bool column_first = true;
+        switch (condition.sig())
+        {
+        case tipb::ScalarFuncSig::LEInt:
+        case tipb::ScalarFuncSig::LTInt:
+            break;
+        case tipb::ScalarFuncSig::GEInt:
+        case tipb::ScalarFuncSig::GTInt:
+            column_first = false;
+            break;
+        default:
+            continue;
+        }
+        const auto & column_expr = condition.children(column_first ? 0 : 1);
+        const auto & literal_expr = condition.children(column_first ? 1 : 0);
+        if (!isColumnExpr(column_expr) || !isLiteralExpr(literal_expr)
+            || getColumnNameForColumnExpr(column_expr, schema) != row_number_name)
+            continue;
+        Field value = decodeLiteral(literal_expr);
+        Int64 k;
+        if (value.getType() == Field::Types::Int64)
+            k = value.get<Int64>();
+        else if (value.getType() == Field::Types::UInt64)
+            k = static_cast<Int64>(std::min<UInt64>(value.get<UInt64>(), std::numeric_limits<Int64>::max()));
+        else
+            continue;
+        if (condition.sig() == tipb::ScalarFuncSig::LTInt || condition.sig() == tipb::ScalarFuncSig::GTInt)
+            --k;
+        limit = limit ? std::min(*limit, k) : k;
+    }
+    // A large limit keeps most of the rows, then the sort which supports spilling is better.
+    static constexpr Int64 max_partition_limit = 10000;
+    if (!limit || *limit <= 0 || *limit > max_partition_limit)
+        return;
+
+    auto physical_window_sort = std::static_pointer_cast<PhysicalWindowSort>(plan->children(0));
+    physical_window_sort->setPartitionLimit(window_description.partition_by, *limit);
+}
 } // namespace
 
 void PhysicalPlan::build(const tipb::DAGRequest * dag_request)
@@ -113,7 +175,10 @@ void PhysicalPlan::build(const tipb::Executor * executor)
         if (pushDownSelection(context, child, executor_id, executor->selection()))
             pushBack(child);
         else
+        {
+            pushDownRowNumberLimit(child, executor->selection());
             pushBack(PhysicalFilter::build(context, executor_id, log, executor->selection(), child));
+        }
         break;
     }
     case tipb::ExecType::TypeStreamAgg:
@@ -212,9 +277,11 @@ void PhysicalPlan::build(const tipb::Executor * executor)
 
         auto fine_grained_shuffle = FineGrainedShuffle(executor);
         auto & settings = context.getSettingsRef();
+        /// Hash join v2 does not support spilling with fine grained shuffle yet.
+        bool is_fine_grained_shuffle_with_spill = fine_grained_shuffle.enabled()
+            && (settings.max_bytes_before_external_join > 0 || context.getDAGContext()->isInAutoSpillMode());
         if (settings.enable_hash_join_v2 && context.getDAGContext()->getExecutionMode() == ExecutionMode::Pipeline
-            && !fine_grained_shuffle.enabled() && PhysicalJoinV2::isSupported(executor->join())
-            && settings.max_bytes_before_external_join == 0 && !context.getDAGContext()->isInAutoSpillMode())
+            && !is_fine_grained_shuffle_with_spill && PhysicalJoinV2::isSupported(executor->join()))
         {
             pushBack(
                 PhysicalJoinV2::build(context, executor_id, log, executor->join(), fine_grained_shuffle, left, right));
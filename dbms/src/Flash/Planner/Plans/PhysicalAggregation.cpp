@@ -19,9 +19,11 @@
 #include <DataStreams/AutoPassThroughAggregatingBlockInputStream.h>
 #include <DataStreams/ParallelAggregatingBlockInputStream.h>
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
+#include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Pipeline/PipelineBuilder.h>
 #include <Flash/Planner/FinalizeHelper.h>
@@ -29,12 +31,71 @@
 #include <Flash/Planner/Plans/PhysicalAggregation.h>
 #include <Flash/Planner/Plans/PhysicalAggregationBuild.h>
 #include <Flash/Planner/Plans/PhysicalAggregationConvergent.h>
+#include <Flash/Planner/Plans/PhysicalMockTableScan.h>
+#include <Flash/Planner/Plans/PhysicalTableScan.h>
 #include <Interpreters/Context.h>
 #include <Operators/AutoPassThroughAggregateTransform.h>
 #include <Operators/LocalAggregateTransform.h>
+#include <Operators/OrderedAggregateTransformOp.h>
 
 namespace DB
 {
+namespace
+{
+/// Whether the rows of a group are adjacent in the output of each source of the child, that is the child is
+/// a table scan keeping the order of the handle, and the group by keys are a prefix of the handle.
+bool isGroupByKeysOrdered(const tipb::Aggregation & aggregation, const PhysicalPlanNodePtr & child)
+{
+    // Filter doesn't change the order and the schema of its child.
+    auto node = child;
+    while (node->tp() == PlanType::Filter)
+        node = node->children(0);
+    const TiDBTableScan * tidb_table_scan = nullptr;
+    if (node->tp() == PlanType::TableScan)
+        tidb_table_scan = &std::static_pointer_cast<PhysicalTableScan>(node)->getTiDBTableScan();
+    else if (unlikely(node->tp() == PlanType::MockTableScan))
+        tidb_table_scan = &std::static_pointer_cast<PhysicalMockTableScan>(node)->getTiDBTableScan();
+    else
+        return false;
+    const auto & table_scan = *tidb_table_scan;
+    if (!table_scan.keepOrder() || table_scan.isFastScan())
+        return false;
+
+    std::unordered_set<ColumnID> key_column_ids;
+    for (const auto & expr : aggregation.group_by())
+    {
+        if (!isColumnExpr(expr))
+            return false;
+        auto column_index = decodeDAGInt64(expr.val());
+        if (column_index < 0 || column_index >= table_scan.getColumnSize())
+            return false;
+        key_column_ids.insert(table_scan.getColumns()[column_index].id);
+    }
+    const auto handle_column_ids = table_scan.getHandleColumnIDs();
+    if (key_column_ids.empty() || key_column_ids.size() > handle_column_ids.size())
+        return false;
+    for (size_t i = 0; i < key_column_ids.size(); ++i)
+    {
+        if (!key_column_ids.contains(handle_column_ids[i]))
+            return false;
+    }
+    return true;
+}
+
+/// Let the table scan under the aggregation read the String columns as ColumnDictionaryString, which can be
+/// handled by the filters and the expressions between them and the hash aggregation.
+void tryReadStringDictionary(const PhysicalPlanNodePtr & child)
+{
+    auto node = child;
+    while (node->tp() == PlanType::Filter)
+        node = node->children(0);
+    if (node->tp() == PlanType::TableScan)
+        std::static_pointer_cast<PhysicalTableScan>(node)->setReadStringDictionary(true);
+    else if (unlikely(node->tp() == PlanType::MockTableScan))
+        std::static_pointer_cast<PhysicalMockTableScan>(node)->setReadStringDictionary(true);
+}
+} // namespace
+
 PhysicalPlanNodePtr PhysicalAggregation::build(
     const Context & context,
     const String & executor_id,
@@ -97,6 +158,19 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
         auto_pass_through_switcher.mode = ::tipb::TiFlashPreAggMode::ForcePreAgg;
     }
 
+    // The final aggregation must see all rows of a group at once, but a partial aggregation can output
+    // a group more than once, so the rows of a group read by different sources don't break it.
+    const bool use_ordered_agg = context.getSettingsRef().enable_ordered_aggregation && !aggregation_keys.empty()
+        && !AggregationInterpreterHelper::isFinalAgg(aggregation) && !fine_grained_shuffle.enabled()
+        && isGroupByKeysOrdered(aggregation, child);
+    if (use_ordered_agg)
+        LOG_DEBUG(log, "use ordered aggregation because the group by keys are a prefix of the handle");
+
+    // The ordered aggregation and the auto pass through aggregation copy the rows of the keys directly.
+    if (context.getSettingsRef().dt_enable_read_string_dictionary && !use_ordered_agg
+        && !auto_pass_through_switcher.enabled())
+        tryReadStringDictionary(child);
+
     auto physical_agg = std::make_shared<PhysicalAggregation>(
         executor_id,
         schema,
@@ -110,6 +184,7 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
         collators,
         AggregationInterpreterHelper::isFinalAgg(aggregation),
         auto_pass_through_switcher,
+        use_ordered_agg,
         aggregate_descriptions,
         expr_after_agg_actions);
     return physical_agg;
@@ -262,15 +337,15 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
     Context & context,
     size_t /*concurrency*/)
 {
-    // When got here, one of fine_grained_shuffle and auto_pass_through must be true.
+    // When got here, one of fine_grained_shuffle, auto_pass_through and ordered agg must be true.
     // Because for non fine grained shuffle, AggregateBuild and AggregateConvergent will be used to build aggregation.
-    // Also auto pass through hashagg use PhysicalAggregation to build. But they cannot be true at the same time.
-    RUNTIME_CHECK(fine_grained_shuffle.enabled() != auto_pass_through_switcher.enabled());
+    // Also auto pass through hashagg use PhysicalAggregation to build. But fine_grained_shuffle and auto_pass_through
+    // cannot be true at the same time. Ordered agg is preferred to auto pass through hashagg.
+    RUNTIME_CHECK(use_ordered_agg || fine_grained_shuffle.enabled() != auto_pass_through_switcher.enabled());
 
-    // Auto pass through hashagg doesn't handle empty_result_for_aggregation_by_empty_set.
+    // Auto pass through hashagg and ordered agg don't handle empty_result_for_aggregation_by_empty_set.
     // Also tidb shouldn't generate this kind plan because all data is aggregated into one row if keys_size == 0.
-    RUNTIME_CHECK(
-        fine_grained_shuffle.enabled() || (auto_pass_through_switcher.enabled() && !aggregation_keys.empty()));
+    RUNTIME_CHECK(fine_grained_shuffle.enabled() || !aggregation_keys.empty());
 
     executeExpression(exec_context, group_builder, before_agg_actions, log);
 
@@ -301,7 +376,14 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
         aggregate_descriptions,
         is_final_agg,
         spill_config);
-    if (fine_grained_shuffle.enabled())
+    if (use_ordered_agg)
+    {
+        group_builder.transform([&](auto & builder) {
+            builder.appendTransformOp(
+                std::make_unique<OrderedAggregateTransformOp>(exec_context, log->identifier(), params));
+        });
+    }
+    else if (fine_grained_shuffle.enabled())
     {
         group_builder.transform([&](auto & builder) {
             builder.appendTransformOp(std::make_unique<LocalAggregateTransform>(
@@ -361,7 +443,7 @@ void PhysicalAggregation::buildPipeline(
     auto aggregate_context = std::make_shared<AggregateContext>(log->identifier());
     // fine_grained_shuffle and auto_pass_through cannot be ture at the same time.
     RUNTIME_CHECK(!(fine_grained_shuffle.enabled() && auto_pass_through_switcher.enabled()));
-    if (fine_grained_shuffle.enabled() || auto_pass_through_switcher.enabled())
+    if (fine_grained_shuffle.enabled() || auto_pass_through_switcher.enabled() || use_ordered_agg)
     {
         // For fine grained shuffle, Aggregate wouldn't be broken.
         child->buildPipeline(builder, context, exec_context);
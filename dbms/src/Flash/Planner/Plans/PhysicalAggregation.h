@@ -46,6 +46,7 @@ public:
         const std::unordered_map<String, TiDB::TiDBCollatorPtr> & aggregation_collators_,
         bool is_final_agg_,
         AutoPassThroughSwitcher auto_pass_through_switcher_,
+        bool use_ordered_agg_,
         const AggregateDescriptions & aggregate_descriptions_,
         const ExpressionActionsPtr & expr_after_agg_)
         : PhysicalUnary(executor_id_, PlanType::Aggregation, schema_, fine_grained_shuffle_, req_id, child_)
@@ -56,6 +57,7 @@ public:
         , aggregation_collators(aggregation_collators_)
         , is_final_agg(is_final_agg_)
         , auto_pass_through_switcher(auto_pass_through_switcher_)
+        , use_ordered_agg(use_ordered_agg_)
         , aggregate_descriptions(aggregate_descriptions_)
         , expr_after_agg(expr_after_agg_)
     {}
@@ -83,6 +85,8 @@ private:
     std::unordered_map<String, TiDB::TiDBCollatorPtr> aggregation_collators;
     const bool is_final_agg;
     const AutoPassThroughSwitcher auto_pass_through_switcher;
+    // Aggregate the adjacent rows of the same group without hash table, only for pipeline model.
+    const bool use_ordered_agg;
     AggregateDescriptions aggregate_descriptions;
     ExpressionActionsPtr expr_after_agg;
 };
@@ -91,6 +91,7 @@ void PhysicalExchangeSender::buildBlockInputStreamImpl(DAGPipeline & pipeline, C
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().local_tunnel_pass_block,
             log->identifier());
         stream
             = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
@@ -126,6 +127,7 @@ void PhysicalExchangeSender::buildPipelineExecGroupImpl(
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().local_tunnel_pass_block,
             log->identifier(),
             /*is_async=*/true);
         builder.setSinkOp(
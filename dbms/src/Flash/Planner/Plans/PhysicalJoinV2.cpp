@@ -113,7 +113,26 @@ PhysicalPlanNodePtr PhysicalJoinV2::build(
         original_build_key_names,
         join_non_equal_conditions);
 
+    const Settings & settings = context.getSettingsRef();
     auto join_req_id = fmt::format("{}_{}", log->identifier(), executor_id);
+    SpillConfig build_spill_config(
+        context.getTemporaryPath(),
+        fmt::format("{}_0_build", join_req_id),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider(),
+        settings.max_threads,
+        settings.max_block_size);
+    SpillConfig probe_spill_config(
+        context.getTemporaryPath(),
+        fmt::format("{}_0_probe", join_req_id),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider(),
+        settings.max_threads,
+        settings.max_block_size);
 
     HashJoinPtr join_ptr = std::make_shared<HashJoin>(
         probe_key_names,
@@ -123,8 +142,19 @@ PhysicalPlanNodePtr PhysicalJoinV2::build(
         join_output_schema,
         tiflash_join.join_key_collators,
         join_non_equal_conditions,
-        context.getSettingsRef(),
-        match_helper_name);
+        HashJoinSettings(settings),
+        match_helper_name,
+        fine_grained_shuffle.enabled() ? fine_grained_shuffle.stream_count : 0,
+        settings.max_bytes_before_external_join,
+        build_spill_config,
+        probe_spill_config,
+        [&](const OperatorSpillContextPtr & operator_spill_context) {
+            if (context.getDAGContext() != nullptr)
+            {
+                context.getDAGContext()->registerOperatorSpillContext(operator_spill_context);
+            }
+        },
+        context.getDAGContext() != nullptr ? context.getDAGContext()->getAutoSpillTrigger() : nullptr);
 
     recordJoinExecuteInfo(dag_context, executor_id, build_plan->execId(), join_ptr);
 
@@ -210,6 +240,7 @@ bool PhysicalJoinV2::isSupported(const tipb::Join & join)
     {
     case Inner:
     case LeftOuter:
+    case RightOuter:
         if (!tiflash_join.getBuildJoinKeys().empty())
             return true;
         break;
@@ -217,13 +248,11 @@ bool PhysicalJoinV2::isSupported(const tipb::Join & join)
     case Anti:
     case LeftOuterSemi:
     case LeftOuterAnti:
-        if (!tiflash_join.getBuildJoinKeys().empty() && join.other_conditions_size() == 0
-            && join.other_eq_conditions_from_in_size() == 0)
+    case RightSemi:
+    case RightAnti:
+        if (!tiflash_join.getBuildJoinKeys().empty() && join.other_eq_conditions_from_in_size() == 0)
             return true;
         break;
-    //case RightOuter:
-    //case RightSemi:
-    //case RightAnti:
     default:
     }
     return false;
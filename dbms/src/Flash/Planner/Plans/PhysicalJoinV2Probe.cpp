@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Flash/Coprocessor/InterpreterUtils.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
 #include <Flash/Planner/Plans/PhysicalJoinV2Probe.h>
 #include <Interpreters/Context.h>
@@ -36,6 +37,7 @@ void PhysicalJoinV2Probe::buildPipelineExecGroupImpl(
         builder.appendTransformOp(
             std::make_unique<HashJoinV2ProbeTransformOp>(exec_context, log->identifier(), join_ptr, probe_index++));
     });
+    exec_context.addOneTimeFuture(join_ptr->wait_probe_finished_future);
     join_ptr.reset();
 }
 } // namespace DB
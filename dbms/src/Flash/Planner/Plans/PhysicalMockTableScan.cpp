@@ -96,15 +96,14 @@ PhysicalMockTableScan::PhysicalMockTableScan(
     const String & req_id,
     const Block & sample_block_,
     const BlockInputStreams & mock_streams_,
-    Int64 table_id_,
-    bool keep_order_,
-    const std::vector<Int32> & runtime_filter_ids)
+    const TiDBTableScan & tidb_table_scan_)
     : PhysicalLeaf(executor_id_, PlanType::MockTableScan, schema_, FineGrainedShuffle{}, req_id)
     , sample_block(sample_block_)
     , mock_streams(mock_streams_)
-    , table_id(table_id_)
-    , keep_order(keep_order_)
-    , runtime_filter_ids(runtime_filter_ids)
+    , tidb_table_scan(tidb_table_scan_)
+    , table_id(tidb_table_scan.getLogicalTableID())
+    , keep_order(tidb_table_scan.keepOrder())
+    , runtime_filter_ids(tidb_table_scan.getRuntimeFilterIDs())
 {}
 
 PhysicalPlanNodePtr PhysicalMockTableScan::build(
@@ -121,9 +120,7 @@ PhysicalPlanNodePtr PhysicalMockTableScan::build(
         log->identifier(),
         Block(schema),
         mock_streams,
-        table_scan.getLogicalTableID(),
-        table_scan.keepOrder(),
-        table_scan.getRuntimeFilterIDs());
+        table_scan);
     return physical_mock_table_scan;
 }
 
@@ -154,7 +151,8 @@ void PhysicalMockTableScan::buildPipelineExecGroupImpl(
             keep_order,
             &filter_conditions,
             runtime_filter_ids,
-            rf_max_wait_time_ms);
+            rf_max_wait_time_ms,
+            tidb_table_scan.readStringDictionary());
         for (size_t i = 0; i < group_builder.concurrency(); ++i)
         {
             if (auto * source_op = dynamic_cast<UnorderedSourceOp *>(group_builder.getCurBuilder(i).source_op.get()))
@@ -43,9 +43,7 @@ public:
         const String & req_id,
         const Block & sample_block_,
         const BlockInputStreams & mock_streams_,
-        Int64 table_id_,
-        bool keep_order_,
-        const std::vector<Int32> & runtime_filter_ids_);
+        const TiDBTableScan & tidb_table_scan_);
 
     void finalizeImpl(const Names & parent_require) override;
 
@@ -60,6 +58,13 @@ public:
 
     const String & getFilterConditionsId() const;
 
+    const TiDBTableScan & getTiDBTableScan() const { return tidb_table_scan; }
+
+    void setReadStringDictionary(bool read_string_dictionary)
+    {
+        tidb_table_scan.setReadStringDictionary(read_string_dictionary);
+    }
+
 private:
     void buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & /*context*/, size_t /*max_streams*/) override;
 
@@ -79,6 +84,8 @@ private:
 
     BlockInputStreams mock_streams;
 
+    TiDBTableScan tidb_table_scan;
+
     const Int64 table_id;
 
     const bool keep_order;
@@ -48,6 +48,13 @@ public:
 
     const String & getFilterConditionsId() const;
 
+    const TiDBTableScan & getTiDBTableScan() const { return tidb_table_scan; }
+
+    void setReadStringDictionary(bool read_string_dictionary)
+    {
+        tidb_table_scan.setReadStringDictionary(read_string_dictionary);
+    }
+
     void buildPipeline(PipelineBuilder & builder, Context & context, PipelineExecutorContext & exec_context) override;
 
 private:
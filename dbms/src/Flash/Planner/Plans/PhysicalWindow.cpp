@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <Common/Logger.h>
+#include <Common/ThresholdUtils.h>
+#include <Core/FineGrainedOperatorSpillContext.h>
 #include <DataStreams/WindowBlockInputStream.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
@@ -105,21 +107,43 @@ void PhysicalWindow::buildPipelineExecGroupImpl(
     executeExpression(exec_context, group_builder, window_description.before_window, log);
     window_description.fillArgColumnNumbers();
 
+    const Settings & settings = context.getSettingsRef();
     if (!fine_grained_shuffle.enabled())
-        executeUnion(exec_context, group_builder, context.getSettingsRef().max_buffered_bytes_in_executor, log);
-
+        executeUnion(exec_context, group_builder, settings.max_buffered_bytes_in_executor, log);
+
+    size_t max_bytes_before_external_window
+        = getAverageThreshold(settings.max_bytes_before_external_window, group_builder.concurrency());
+    std::shared_ptr<FineGrainedOperatorSpillContext> fine_grained_spill_context;
+    if (fine_grained_shuffle.enabled() && context.getDAGContext() != nullptr
+        && context.getDAGContext()->isInAutoSpillMode() && group_builder.concurrency() > 1
+        && WindowTransformAction::supportBatchCalculate(window_description))
+        fine_grained_spill_context = std::make_shared<FineGrainedOperatorSpillContext>("window", log);
+    SpillConfig spill_config{
+        context.getTemporaryPath(),
+        log->identifier(),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider()};
     /// Window function can be multiple threaded when fine grained shuffle is enabled.
     group_builder.transform([&](auto & builder) {
-        builder.appendTransformOp(
-            std::make_unique<WindowTransformOp>(exec_context, log->identifier(), window_description));
+        builder.appendTransformOp(std::make_unique<WindowTransformOp>(
+            exec_context,
+            log->identifier(),
+            window_description,
+            max_bytes_before_external_window,
+            spill_config,
+            fine_grained_spill_context));
     });
+    if (fine_grained_spill_context != nullptr)
+        exec_context.registerOperatorSpillContext(fine_grained_spill_context);
 
     if (!fine_grained_shuffle.enabled() && is_restore_concurrency)
         restoreConcurrency(
             exec_context,
             group_builder,
             concurrency,
-            context.getSettingsRef().max_buffered_bytes_in_executor,
+            settings.max_buffered_bytes_in_executor,
             log);
 
     executeExpression(exec_context, group_builder, window_description.after_window, log);
@@ -47,6 +47,8 @@ public:
 
     const Block & getSampleBlock() const override;
 
+    const WindowDescription & getWindowDescription() const { return window_description; }
+
 private:
     void buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & context, size_t max_streams) override;
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Logger.h>
+#include <DataStreams/SortHelper.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
@@ -22,6 +23,7 @@
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/Plans/PhysicalWindowSort.h>
 #include <Interpreters/Context.h>
+#include <Operators/PartitionTopNTransformOp.h>
 
 namespace DB
 {
@@ -64,12 +66,55 @@ void PhysicalWindowSort::buildPipelineExecGroupImpl(
     Context & context,
     size_t /*concurrency*/)
 {
+    const Settings & settings = context.getSettingsRef();
+    // The partition top-n buffers up to partition_limit rows for every partition and can not spill,
+    // so keep the spillable sort when spill is enabled.
+    const bool is_spill_enabled = settings.max_bytes_before_external_sort > 0
+        || (context.getDAGContext() != nullptr && context.getDAGContext()->isInAutoSpillMode());
+    if (partition_limit > 0 && !is_spill_enabled
+        && !SortHelper::isSortByConstants(group_builder.getCurrentHeader(), order_descr))
+    {
+        auto append_partition_top_n = [&]() {
+            group_builder.transform([&](auto & builder) {
+                builder.appendTransformOp(std::make_unique<PartitionTopNTransformOp>(
+                    exec_context,
+                    log->identifier(),
+                    order_descr,
+                    partition_key_size,
+                    partition_limit,
+                    settings.max_block_size));
+            });
+        };
+        // With fine grained shuffle, the rows of one partition are always in the same stream.
+        append_partition_top_n();
+        if (!fine_grained_shuffle.enabled())
+        {
+            executeUnion(exec_context, group_builder, settings.max_buffered_bytes_in_executor, log);
+            append_partition_top_n();
+        }
+        return;
+    }
+
     if (fine_grained_shuffle.enabled())
         executeLocalSort(exec_context, group_builder, order_descr, {}, true, context, log);
     else
         executeFinalSort(exec_context, group_builder, order_descr, {}, context, log);
 }
 
+bool PhysicalWindowSort::setPartitionLimit(const SortDescription & partition_by, size_t limit)
+{
+    if (partition_by.size() > order_descr.size())
+        return false;
+    for (size_t i = 0; i < partition_by.size(); ++i)
+    {
+        if (partition_by[i].column_name != order_descr[i].column_name)
+            return false;
+    }
+    partition_key_size = partition_by.size();
+    partition_limit = limit;
+    return true;
+}
+
 void PhysicalWindowSort::finalizeImpl(const Names & parent_require)
 {
     Names required_output = parent_require;
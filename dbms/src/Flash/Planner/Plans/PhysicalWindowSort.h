@@ -47,6 +47,11 @@ public:
 
     const Block & getSampleBlock() const override;
 
+    /// Only the first `limit` rows of each partition are needed by the parent window, such as
+    /// `row_number() over (partition by ... order by ...) <= limit`.
+    /// Return false if `partition_by` is not the prefix of `order_descr`.
+    bool setPartitionLimit(const SortDescription & partition_by, size_t limit);
+
 private:
     void buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & context, size_t max_streams) override;
 
@@ -58,5 +63,9 @@ private:
 
 private:
     SortDescription order_descr;
+    // The number of the partition by columns at the beginning of `order_descr`.
+    size_t partition_key_size = 0;
+    // 0 means no limit.
+    size_t partition_limit = 0;
 };
 } // namespace DB
@@ -26,6 +26,7 @@
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Interpreters/Aggregator.h>
 #include <Interpreters/Context.h>
+#include <Interpreters/RadixPartitionedAggregation.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <benchmark/benchmark.h>
 #include <google/protobuf/util/json_util.h>
@@ -33,6 +34,7 @@
 
 #include <random>
 #include <string>
+#include <thread>
 
 namespace DB
 {
@@ -339,5 +341,116 @@ try
 CATCH
 BENCHMARK_REGISTER_F(BenchProbeAggHashMap, basic);
 
+template <typename F>
+void runInThreads(size_t concurrency, F && f)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(concurrency);
+    for (size_t i = 0; i < concurrency; ++i)
+        threads.emplace_back([&, i]() { f(i); });
+    for (auto & thread : threads)
+        thread.join();
+}
+
+// Each thread builds its own hash table, and the hash tables are merged at last.
+BENCHMARK_DEFINE_F(BenchProbeAggHashMap, parallel)(benchmark::State & state)
+try
+{
+    const size_t concurrency = state.range(0);
+    for (const auto & _ : state)
+    {
+        RegisterOperatorSpillContext register_operator_spill_context;
+        auto aggregator = std::make_shared<Aggregator>(
+            *params,
+            "BenchProbeAggHashMap",
+            concurrency,
+            register_operator_spill_context,
+            /*is_auto_pass_through=*/false,
+            params->use_magic_hash);
+        ManyAggregatedDataVariants many_data;
+        for (size_t i = 0; i < concurrency; ++i)
+            many_data.push_back(std::make_shared<AggregatedDataVariants>());
+
+        Stopwatch build_side_watch;
+        runInThreads(concurrency, [&](size_t thread_index) {
+            Aggregator::AggProcessInfo agg_process_info(aggregator.get());
+            for (size_t i = thread_index; i < test_blocks.size(); i += concurrency)
+            {
+                agg_process_info.resetBlock(*test_blocks[i]);
+                aggregator->executeOnBlock(agg_process_info, *many_data[thread_index], thread_index);
+            }
+        });
+        build_side_watch.stop();
+
+        Stopwatch probe_side_watch;
+        auto merging_buckets = aggregator->mergeAndConvertToBlocks(many_data, /*final=*/true, concurrency);
+        std::atomic<size_t> total_rows{0};
+        runInThreads(merging_buckets->getConcurrency(), [&](size_t index) {
+            while (auto block = merging_buckets->getData(index))
+                total_rows += block.rows();
+        });
+        probe_side_watch.stop();
+        LOG_DEBUG(
+            log,
+            "build_side_watch: {}, probe_side_watch: {}, res rows: {}",
+            build_side_watch.elapsed(),
+            probe_side_watch.elapsed(),
+            total_rows.load());
+        merging_buckets.reset();
+        many_data.clear();
+    }
+}
+CATCH
+BENCHMARK_REGISTER_F(BenchProbeAggHashMap, parallel)->Arg(1)->Arg(4)->Arg(16);
+
+// The threads scatter the rows into partitions first, then each partition is aggregated by one thread.
+BENCHMARK_DEFINE_F(BenchProbeAggHashMap, radix)(benchmark::State & state)
+try
+{
+    const size_t concurrency = state.range(0);
+    const size_t partition_count = state.range(1);
+    for (const auto & _ : state)
+    {
+        RegisterOperatorSpillContext register_operator_spill_context;
+        auto aggregator = std::make_shared<Aggregator>(
+            *params,
+            "BenchProbeAggHashMap",
+            concurrency,
+            register_operator_spill_context,
+            /*is_auto_pass_through=*/false,
+            params->use_magic_hash);
+        RadixPartitionedAggregation radix_aggregation(*aggregator, concurrency, partition_count);
+
+        Stopwatch build_side_watch;
+        runInThreads(concurrency, [&](size_t thread_index) {
+            for (size_t i = thread_index; i < test_blocks.size(); i += concurrency)
+                radix_aggregation.scatter(thread_index, *test_blocks[i]);
+        });
+        radix_aggregation.finishScatter();
+        build_side_watch.stop();
+
+        Stopwatch probe_side_watch;
+        std::atomic<size_t> total_rows{0};
+        runInThreads(radix_aggregation.getConcurrency(), [&](size_t index) {
+            while (auto block = radix_aggregation.read(index))
+                total_rows += block.rows();
+        });
+        probe_side_watch.stop();
+        LOG_DEBUG(
+            log,
+            "build_side_watch: {}, probe_side_watch: {}, res rows: {}",
+            build_side_watch.elapsed(),
+            probe_side_watch.elapsed(),
+            total_rows.load());
+    }
+}
+CATCH
+BENCHMARK_REGISTER_F(BenchProbeAggHashMap, radix)
+    ->Args({1, 64})
+    ->Args({4, 64})
+    ->Args({16, 64})
+    ->Args({16, 256})
+    ->Args({16, 1024});
+
 } // namespace tests
 } // namespace DB
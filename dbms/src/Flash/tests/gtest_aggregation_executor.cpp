@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnDictionaryString.h>
 #include <Core/BlockUtils.h>
 #include <Interpreters/Context.h>
 #include <TestUtils/ColumnGenerator.h>
@@ -226,6 +227,54 @@ public:
 
             context.addMockTable("test_db", "agg_table_with_special_key", table_column_infos, table_column_data);
         }
+
+        // For OrderedAggregation, the rows are sorted by the int handle `id` and the common handle `(c1, c2)`.
+        context.addMockTable(
+            {"test_db", "ordered_agg_table"},
+            {{"id", TiDB::TP::TypeLongLong, false},
+             {"c1", TiDB::TP::TypeString, false},
+             {"c2", TiDB::TP::TypeLongLong, false},
+             {"value", TiDB::TP::TypeLongLong}},
+            {toVec<Int64>("id", {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}),
+             toVec<String>("c1", {"a", "a", "A", "b", "b", "B", "B", "c", "d", "d", "D", "e"}),
+             toVec<Int64>("c2", {1, 2, 3, 1, 2, 3, 4, 1, 1, 2, 3, 1}),
+             toNullableVec<Int64>("value", {1, {}, 3, 4, 5, {}, 7, 8, 9, 10, 11, {}})});
+
+        // For StringDictionaryKey, the key of `dict_key_table` is a dictionary encoded string column, and
+        // `dict_key_reference_table` has the same data in a plain string column.
+        {
+            const std::vector<String> dictionary{"a", "A", "b", "B", "c", "d", "e", "E", "unused"};
+            const size_t rows = 500;
+            auto dictionary_column = ColumnString::create();
+            for (const auto & s : dictionary)
+                dictionary_column->insertData(s.data(), s.size());
+            auto indexes_column = ColumnDictionaryString::ColumnIndexes::create();
+            std::vector<String> keys;
+            std::vector<std::optional<Int64>> values;
+            for (size_t i = 0; i < rows; ++i)
+            {
+                // the last string of the dictionary is not referenced by any row
+                const UInt32 index = (i * 7 + i / 3) % (dictionary.size() - 1);
+                indexes_column->insert(index);
+                keys.push_back(dictionary[index]);
+                values.push_back(i % 5 == 0 ? std::nullopt : std::optional<Int64>(i));
+            }
+            ColumnWithTypeAndName dictionary_key(
+                ColumnDictionaryString::create(std::move(dictionary_column), std::move(indexes_column)),
+                std::make_shared<DataTypeString>(),
+                "key");
+            const MockColumnInfoVec column_infos{
+                {"key", TiDB::TP::TypeString, false},
+                {"value", TiDB::TP::TypeLongLong}};
+            context.addMockTable(
+                {"test_db", "dict_key_table"},
+                column_infos,
+                {dictionary_key, toNullableVec<Int64>("value", values)});
+            context.addMockTable(
+                {"test_db", "dict_key_reference_table"},
+                column_infos,
+                {toVec<String>("key", keys), toNullableVec<Int64>("value", values)});
+        }
     }
 
     std::shared_ptr<tipb::DAGRequest> buildDAGRequest(
@@ -1349,6 +1398,260 @@ try
 }
 CATCH
 
+TEST_F(AggExecutorTestRunner, RadixPartitionedAggregation)
+try
+{
+    std::vector<size_t> max_block_sizes{1, 8, DEFAULT_BLOCK_SIZE};
+    std::vector<size_t> concurrences{1, 8};
+    std::vector<UInt64> partition_counts{1, 16, 256};
+    std::vector<Int64> collators{TiDB::ITiDBCollator::UTF8MB4_BIN, TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI};
+    std::vector<std::vector<String>> group_by_keys{
+        {"key_64", "key_nullable_int64", "key_string_1"},
+        {"key_string_1"},
+        {"key_8", "key_16", "key_32", "key_64"},
+        {"key_nullable_string", "key_nullable_int64", "key_32"},
+    };
+    for (auto collator_id : collators)
+    {
+        context.setCollation(collator_id);
+        const auto * current_collator = TiDB::ITiDBCollator::getCollator(collator_id);
+        ASSERT_TRUE(current_collator != nullptr);
+        for (const auto & keys : group_by_keys)
+        {
+            MockAstVec key_vec;
+            for (const auto & key : keys)
+                key_vec.push_back(col(key));
+            auto request = context.scan("test_db", "agg_table_with_special_key")
+                               .aggregation({Max(col("value")), Count(col("value"))}, key_vec)
+                               .build(context);
+            /// use the normal parallel aggregation as the reference
+            context.context->setSetting("max_bytes_before_external_group_by", Field(static_cast<UInt64>(0)));
+            context.context->setSetting(
+                "max_block_size",
+                Field(static_cast<UInt64>(tbl_agg_table_with_special_key_unique_rows * 2)));
+            context.context->setSetting("hashagg_radix_partition_count", Field(static_cast<UInt64>(0)));
+            auto reference = executeStreams(request);
+            size_t reference_rows = reference.front().column->size();
+
+            for (auto partition_count : partition_counts)
+            {
+                for (auto block_size : max_block_sizes)
+                {
+                    for (auto concurrency : concurrences)
+                    {
+                        context.context->setSetting("max_block_size", Field(static_cast<UInt64>(block_size)));
+                        context.context->setSetting(
+                            "hashagg_radix_partition_count",
+                            Field(static_cast<UInt64>(partition_count)));
+                        auto blocks = getExecuteStreamsReturnBlocks(request, concurrency);
+                        for (auto & block : blocks)
+                        {
+                            block.checkNumberOfRows();
+                            ASSERT(block.rows() <= block_size);
+                        }
+                        auto result = vstackBlocks(std::move(blocks)).getColumnsWithTypeAndName();
+                        /// the representative of a ci group is not deterministic, only check the number of groups
+                        if (current_collator->isCI())
+                            ASSERT_EQ(result.front().column->size(), reference_rows);
+                        else
+                            ASSERT_TRUE(columnsEqual(reference, result, false));
+                    }
+                }
+            }
+        }
+    }
+    context.context->setSetting("hashagg_radix_partition_count", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
+TEST_F(AggExecutorTestRunner, OrderedAggregation)
+try
+{
+    const size_t id_index = 0, c1_index = 1, c2_index = 2;
+    /// The mock aggregation is a final aggregation and the mock table scan has no handle, so make the aggregation
+    /// partial and set the handle of the table scan in the request.
+    auto build_request = [&](const MockAstVec & keys,
+                             bool keep_order,
+                             const std::vector<size_t> & handle_indexes,
+                             bool is_common_handle,
+                             const std::vector<size_t> & prefix_indexes = {},
+                             bool is_partial = true) {
+        auto request = context.scan("test_db", "ordered_agg_table", keep_order)
+                           .aggregation({Max(col("value")), Count(col("value"))}, keys)
+                           .build(context);
+        auto * agg = request->mutable_root_executor()->mutable_aggregation();
+        if (is_partial)
+        {
+            for (auto & agg_func : *agg->mutable_agg_func())
+                agg_func.set_aggfuncmode(tipb::AggFunctionMode::Partial1Mode);
+        }
+        auto * tbl_scan = agg->mutable_child()->mutable_tbl_scan();
+        for (auto index : handle_indexes)
+        {
+            if (is_common_handle)
+                tbl_scan->add_primary_column_ids(tbl_scan->columns(index).column_id());
+            else
+                tbl_scan->mutable_columns(index)->set_pk_handle(true);
+        }
+        for (auto index : prefix_indexes)
+            tbl_scan->add_primary_prefix_column_ids(tbl_scan->columns(index).column_id());
+        return request;
+    };
+    const String ordered_agg_plan = R"(
+query concurrency: 1
+pipeline#0: MockTableScan|table_scan_0 -> Aggregation|aggregation_1 -> Projection|NonTiDBOperator)";
+    const String hash_agg_plan = R"(
+query concurrency: 1
+pipeline#0: AggregationConvergent|aggregation_1 -> Projection|NonTiDBOperator
+ |- pipeline#1: MockTableScan|table_scan_0 -> AggregationBuild|NonTiDBOperator)";
+
+    context.context->setSetting("enable_ordered_aggregation", Field(static_cast<UInt64>(1)));
+    /// when the ordered aggregation is chosen
+    {
+        // the group by key is the int handle
+        executeInterpreter(ordered_agg_plan, build_request({col("id")}, true, {id_index}, false), 1);
+        // the table scan doesn't keep order
+        executeInterpreter(hash_agg_plan, build_request({col("id")}, false, {id_index}, false), 1);
+        // the group by key is not the handle
+        executeInterpreter(hash_agg_plan, build_request({col("c1")}, true, {id_index}, false), 1);
+        // the group by keys are a prefix of the common handle in any order
+        executeInterpreter(ordered_agg_plan, build_request({col("c1")}, true, {c1_index, c2_index}, true), 1);
+        executeInterpreter(
+            ordered_agg_plan,
+            build_request({col("c2"), col("c1")}, true, {c1_index, c2_index}, true),
+            1);
+        // the group by keys are not a prefix of the common handle
+        executeInterpreter(hash_agg_plan, build_request({col("c2")}, true, {c1_index, c2_index}, true), 1);
+        executeInterpreter(
+            hash_agg_plan,
+            build_request({col("c1"), col("id")}, true, {c1_index, c2_index}, true),
+            1);
+        // the rows are not sorted by the columns after a column with prefix index
+        executeInterpreter(
+            hash_agg_plan,
+            build_request({col("c1"), col("c2")}, true, {c1_index, c2_index}, true, {c2_index}),
+            1);
+        executeInterpreter(
+            ordered_agg_plan,
+            build_request({col("c1")}, true, {c1_index, c2_index}, true, {c2_index}),
+            1);
+        // the final aggregation
+        executeInterpreter(hash_agg_plan, build_request({col("id")}, true, {id_index}, false, {}, false), 1);
+        // the setting is disabled
+        context.context->setSetting("enable_ordered_aggregation", Field(static_cast<UInt64>(0)));
+        executeInterpreter(hash_agg_plan, build_request({col("id")}, true, {id_index}, false), 1);
+    }
+
+    /// the results are the same as the hash aggregation
+    std::vector<size_t> max_block_sizes{1, 3, DEFAULT_BLOCK_SIZE};
+    std::vector<Int64> collators{TiDB::ITiDBCollator::UTF8MB4_BIN, TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI};
+    context.context->setSetting("group_by_collation_sensitive", Field(static_cast<UInt64>(1)));
+    for (auto collator_id : collators)
+    {
+        context.setCollation(collator_id);
+        const auto * current_collator = TiDB::ITiDBCollator::getCollator(collator_id);
+        ASSERT_TRUE(current_collator != nullptr);
+        std::vector<std::shared_ptr<tipb::DAGRequest>> requests{
+            build_request({col("id")}, true, {id_index}, false),
+            build_request({col("c1")}, true, {c1_index, c2_index}, true),
+            build_request({col("c1"), col("c2")}, true, {c1_index, c2_index}, true),
+        };
+        for (const auto & request : requests)
+        {
+            context.context->setSetting("enable_ordered_aggregation", Field(static_cast<UInt64>(0)));
+            context.context->setSetting("max_block_size", Field(static_cast<UInt64>(DEFAULT_BLOCK_SIZE)));
+            auto reference = executeStreams(request, 1);
+            size_t reference_rows = reference.front().column->size();
+
+            context.context->setSetting("enable_ordered_aggregation", Field(static_cast<UInt64>(1)));
+            for (auto block_size : max_block_sizes)
+            {
+                context.context->setSetting("max_block_size", Field(static_cast<UInt64>(block_size)));
+                // The rows of a group are adjacent in the only source, so each group is output once.
+                auto result = executeStreams(request, 1);
+                /// the representative of a ci group is not deterministic, only check the number of groups
+                if (current_collator->isCI())
+                    ASSERT_EQ(result.front().column->size(), reference_rows);
+                else
+                    ASSERT_TRUE(columnsEqual(reference, result, false));
+
+                // A group read by different sources is output more than once, but the counts add up to the same.
+                result = executeStreams(request, 8);
+                ASSERT_GE(result.front().column->size(), reference_rows);
+                UInt64 reference_count = 0, result_count = 0;
+                for (size_t i = 0; i < reference_rows; ++i)
+                    reference_count += reference[1].column->getUInt(i);
+                for (size_t i = 0; i < result[1].column->size(); ++i)
+                    result_count += result[1].column->getUInt(i);
+                ASSERT_EQ(reference_count, result_count);
+            }
+        }
+    }
+    context.context->setSetting("group_by_collation_sensitive", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("enable_ordered_aggregation", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(DEFAULT_BLOCK_SIZE)));
+}
+CATCH
+
+TEST_F(AggExecutorTestRunner, StringDictionaryKey)
+try
+{
+    std::vector<size_t> max_block_sizes{1, 7, DEFAULT_BLOCK_SIZE};
+    std::vector<size_t> concurrences{1, 8};
+    std::vector<UInt64> two_level_thresholds{0, 1};
+    std::vector<Int64> collators{TiDB::ITiDBCollator::UTF8MB4_BIN, TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI};
+    context.context->setSetting("group_by_collation_sensitive", Field(static_cast<UInt64>(1)));
+    for (auto collator_id : collators)
+    {
+        context.setCollation(collator_id);
+        const auto * current_collator = TiDB::ITiDBCollator::getCollator(collator_id);
+        ASSERT_TRUE(current_collator != nullptr);
+        auto build_request = [&](const String & table) {
+            return context.scan("test_db", table)
+                .aggregation({Max(col("value")), Count(col("value"))}, {col("key")})
+                .build(context);
+        };
+        auto request = build_request("dict_key_table");
+        context.context->setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(0)));
+        context.context->setSetting("max_block_size", Field(static_cast<UInt64>(DEFAULT_BLOCK_SIZE)));
+        auto reference = executeStreams(build_request("dict_key_reference_table"), 1);
+        /// the representative of a ci group is not deterministic, only compare the aggregation results
+        if (current_collator->isCI())
+            reference.resize(2);
+        for (auto two_level_threshold : two_level_thresholds)
+        {
+            for (auto block_size : max_block_sizes)
+            {
+                for (auto concurrency : concurrences)
+                {
+                    context.context->setSetting(
+                        "group_by_two_level_threshold",
+                        Field(static_cast<UInt64>(two_level_threshold)));
+                    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(block_size)));
+                    for (auto force_two_level : {true, false})
+                    {
+                        if (force_two_level)
+                            FailPointHelper::enableFailPoint(FailPoints::force_agg_two_level_hash_table_before_merge);
+                        else
+                            FailPointHelper::disableFailPoint(
+                                FailPoints::force_agg_two_level_hash_table_before_merge);
+                        WRAP_FOR_AGG_FAILPOINTS_START
+                        auto result = executeStreams(request, concurrency);
+                        if (current_collator->isCI())
+                            result.resize(2);
+                        ASSERT_TRUE(columnsEqual(reference, result, false));
+                        WRAP_FOR_AGG_FAILPOINTS_END
+                    }
+                }
+            }
+        }
+    }
+    context.context->setSetting("group_by_collation_sensitive", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(DEFAULT_BLOCK_SIZE)));
+}
+CATCH
+
 #undef WRAP_FOR_AGG_FAILPOINTS_START
 #undef WRAP_FOR_AGG_FAILPOINTS_END
 
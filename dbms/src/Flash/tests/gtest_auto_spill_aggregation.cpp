@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnDictionaryString.h>
 #include <Common/FailPoint.h>
 #include <Interpreters/Context.h>
 #include <TestUtils/ColumnGenerator.h>
@@ -154,6 +155,64 @@ try
 }
 CATCH
 
+TEST_F(AutoSpillAggregationTestRunner, TriggerByRandomFailInResizeCallbackWithStringDictionary)
+try
+{
+    DB::MockColumnInfoVec column_infos{{"a", TiDB::TP::TypeString, false}, {"b", TiDB::TP::TypeLongLong}};
+    size_t table_rows = 409600;
+    size_t distinct_keys = 40960;
+    UInt64 max_block_size = 500;
+    size_t original_max_streams = 20;
+    /// the key of `dict_table` is dictionary encoded, `plain_table` has the same data in a string column
+    auto dictionary = ColumnString::create();
+    for (size_t i = 0; i < distinct_keys; ++i)
+    {
+        auto key = fmt::format("key_{}", i);
+        dictionary->insertData(key.data(), key.size());
+    }
+    auto indexes = ColumnDictionaryString::ColumnIndexes::create();
+    for (size_t i = 0; i < table_rows; ++i)
+        indexes->insert(static_cast<UInt64>((i * 7919) % distinct_keys));
+    ColumnWithTypeAndName dict_column(
+        ColumnDictionaryString::create(std::move(dictionary), std::move(indexes)),
+        std::make_shared<DataTypeString>(),
+        "a");
+    ColumnWithTypeAndName plain_column(
+        dict_column.column->convertToFullColumnIfConst(),
+        std::make_shared<DataTypeString>(),
+        "a");
+    ColumnGeneratorOpts opts{table_rows, "Nullable(Int64)", RANDOM, "b"};
+    auto value_column = ColumnGenerator::instance().generate(opts);
+    size_t total_data_size = plain_column.column->byteSize() + value_column.column->byteSize();
+    context.addMockTable("spill_sort_test", "dict_table", column_infos, {dict_column, value_column}, 8);
+    context.addMockTable("spill_sort_test", "plain_table", column_infos, {plain_column, value_column}, 8);
+
+    auto build_request = [&](const String & table) {
+        return context.scan("spill_sort_test", table)
+            .aggregation({Min(col("b")), Max(col("b")), Count(col("b"))}, {col("a")})
+            .build(context);
+    };
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(max_block_size)));
+    /// disable spill
+    context.context->setSetting("max_bytes_before_external_group_by", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("max_memory_usage", Field(static_cast<UInt64>(0)));
+    enablePipeline(false);
+    auto ref_columns = executeStreams(build_request("plain_table"), original_max_streams);
+    auto request = build_request("dict_table");
+    /// enable spill
+    DB::FailPointHelper::enableRandomFailPoint(DB::FailPoints::random_fail_in_resize_callback, 0.5);
+    WRAP_FOR_SPILL_TEST_BEGIN
+    context.context->setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(1)));
+    context.context->setSetting("group_by_two_level_threshold_bytes", Field(static_cast<UInt64>(1)));
+    context.context->setSetting("max_memory_usage", Field(static_cast<UInt64>(total_data_size * 1000)));
+    context.context->setSetting("auto_memory_revoke_trigger_threshold", Field(0.7));
+    /// the aggregation on the dictionary resumes from the row which fails to be inserted into the hash table
+    ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreamsWithMemoryTracker(request, original_max_streams));
+    WRAP_FOR_SPILL_TEST_END
+    DB::FailPointHelper::disableFailPoint(DB::FailPoints::random_fail_in_resize_callback);
+}
+CATCH
+
 #undef WRAP_FOR_SPILL_TEST_BEGIN
 #undef WRAP_FOR_SPILL_TEST_END
 #undef WRAP_FOR_AGG_PARTIAL_BLOCK_START
@@ -0,0 +1,103 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/FailPoint.h>
+#include <Interpreters/Context.h>
+#include <TestUtils/ExecutorTestUtils.h>
+#include <TestUtils/mockExecutor.h>
+
+namespace DB
+{
+namespace FailPoints
+{
+extern const char random_marked_for_auto_spill[];
+} // namespace FailPoints
+namespace tests
+{
+class AutoSpillWindowTestRunner : public DB::tests::ExecutorTest
+{
+public:
+    void initializeContext() override
+    {
+        ExecutorTest::initializeContext();
+        dag_context_ptr->log = Logger::get("AutoSpillWindowTest");
+
+        std::vector<Int64> partition_values, order_values, values;
+        for (size_t i = 0; i < table_rows; ++i)
+        {
+            // A few large partitions.
+            partition_values.push_back(i % 7);
+            order_values.push_back(i);
+            values.push_back((i * 31) % 1000);
+        }
+        context.addMockTable(
+            "spill_window_test",
+            "simple_table",
+            {{"p", TiDB::TP::TypeLongLong}, {"o", TiDB::TP::TypeLongLong}, {"v", TiDB::TP::TypeLongLong}},
+            {toVec<Int64>("p", partition_values), toVec<Int64>("o", order_values), toVec<Int64>("v", values)},
+            8);
+    }
+
+    void executeAndAssert(const std::shared_ptr<tipb::DAGRequest> & request)
+    {
+        context.context->setSetting("max_block_size", Field(static_cast<UInt64>(500)));
+
+        enablePipeline(false);
+        /// disable spill
+        context.context->setSetting("max_bytes_before_external_sort", Field(static_cast<UInt64>(0)));
+        context.context->setSetting("max_bytes_before_external_window", Field(static_cast<UInt64>(0)));
+        context.context->setSetting("max_memory_usage", Field(static_cast<UInt64>(0)));
+        auto ref_columns = executeStreams(request, 1);
+
+        /// enable auto spill
+        enablePipeline(true);
+        context.context->setSetting("max_memory_usage", Field(static_cast<UInt64>(1024ULL * 1024 * 1024)));
+        context.context->setSetting("auto_memory_revoke_trigger_threshold", Field(0.7));
+        DB::FailPointHelper::enableRandomFailPoint(DB::FailPoints::random_marked_for_auto_spill, 0.5);
+        ASSERT_COLUMNS_EQ_R(ref_columns, executeStreamsWithMemoryTracker(request, 1));
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreamsWithMemoryTracker(request, 10));
+        DB::FailPointHelper::disableFailPoint(DB::FailPoints::random_marked_for_auto_spill);
+    }
+
+    static constexpr size_t table_rows = 102400;
+};
+
+TEST_F(AutoSpillWindowTestRunner, WholePartitionAggregation)
+try
+{
+    MockWindowFrame frame;
+    frame.type = tipb::WindowFrameType::Rows;
+    frame.start = mock::MockWindowFrameBound(tipb::WindowBoundType::Preceding, true, 0);
+    frame.end = mock::MockWindowFrameBound(tipb::WindowBoundType::Following, true, 0);
+    auto request = context.scan("spill_window_test", "simple_table")
+                       .sort({{"p", false}, {"o", false}}, true)
+                       .window(Sum(col("v")), {"o", false}, {"p", false}, std::move(frame))
+                       .build(context);
+    executeAndAssert(request);
+}
+CATCH
+
+TEST_F(AutoSpillWindowTestRunner, RowNumber)
+try
+{
+    auto request = context.scan("spill_window_test", "simple_table")
+                       .sort({{"p", false}, {"o", false}}, true)
+                       .window(RowNumber(), {"o", false}, {"p", false}, buildDefaultRowsFrame())
+                       .build(context);
+    executeAndAssert(request);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
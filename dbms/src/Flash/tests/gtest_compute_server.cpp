@@ -17,6 +17,7 @@
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
 #include <Flash/Coprocessor/JoinInterpreterHelper.h>
 #include <Flash/Mpp/MPPTaskId.h>
+#include <Flash/Mpp/MppVersion.h>
 #include <Interpreters/Context.h>
 #include <Operators/AutoPassThroughHashAggContext.h>
 #include <TestUtils/FailPointUtils.h>
@@ -1314,6 +1315,59 @@ try
 }
 CATCH
 
+TEST_F(ComputeServerRunner, runLocalTunnelPassBlockTest)
+try
+{
+    // fine-grained shuffle is enabled.
+    constexpr uint64_t enable = 8;
+    constexpr uint64_t disable = 0;
+    std::vector<std::function<DAGRequestBuilder(uint64_t)>> request_builders{
+        // hash partition exchange
+        [&](uint64_t stream_count) {
+            return context.scan("test_db", "test_table_2")
+                .exchangeSender(tipb::ExchangeType::Hash, {"test_db.test_table_2.s1"}, stream_count)
+                .exchangeReceiver(
+                    "recv",
+                    {{"s1", TiDB::TP::TypeLong}, {"s2", TiDB::TP::TypeString}, {"s3", TiDB::TP::TypeString}},
+                    stream_count)
+                .project({"s1", "s2", "s3"});
+        },
+        // hash agg over a hash partition exchange
+        [&](uint64_t stream_count) {
+            return context.scan("test_db", "test_table_2")
+                .aggregation({Max(col("s3"))}, {col("s1"), col("s2")}, stream_count);
+        },
+    };
+
+    WRAP_FOR_SERVER_TEST_BEGIN
+    for (auto stream_count : {disable, enable})
+    {
+        for (const auto & build_request : request_builders)
+        {
+            context.context->setSetting("local_tunnel_pass_block", Field(static_cast<UInt64>(0)));
+            startServers(3);
+            const auto expected_cols = buildAndExecuteMPPTasks(build_request(stream_count));
+
+            // Blocks are only passed to the local tunnels since MPPDataPacketV1.
+            context.context->setSetting("local_tunnel_pass_block", Field(static_cast<UInt64>(1)));
+            for (UInt64 local_tunnel_version : {1, 2})
+            {
+                context.context->setSetting("local_tunnel_version", Field(local_tunnel_version));
+                startServers(3);
+                auto properties = DB::tests::getDAGPropertiesForTest(serverNum());
+                properties.mpp_version = MppVersion::MppVersionV1;
+                auto tasks = build_request(stream_count).buildMPPTasks(context, properties);
+                const auto actual_cols = executeMPPTasks(tasks, properties);
+                ASSERT_COLUMNS_EQ_UR(expected_cols, actual_cols);
+            }
+        }
+    }
+    WRAP_FOR_SERVER_TEST_END
+    context.context->setSetting("local_tunnel_pass_block", Field(static_cast<UInt64>(0)));
+    context.context->setSetting("local_tunnel_version", Field(static_cast<UInt64>(2)));
+}
+CATCH
+
 TEST_F(ComputeServerRunner, randomFailpointForPipeline)
 try
 {
@@ -14,10 +14,15 @@
 
 #include <Debug/MockStorage.h>
 #include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/StorageDeltaMerge.h>
 #include <TestUtils/ExecutorTestUtils.h>
 #include <TestUtils/InputStreamTestUtils.h>
 #include <TestUtils/mockExecutor.h>
 
+#include <ext/scope_guard.h>
+#include <random>
+
 namespace DB
 {
 namespace tests
@@ -176,6 +181,82 @@ try
 }
 CATCH
 
+TEST_F(ExecutorsWithDMTestRunner, ReadStringDictionary)
+try
+{
+    auto & settings = context.context->getSettingsRef();
+    auto & global_settings = context.context->getGlobalContext().getSettingsRef();
+    const CompressionMethod origin_compression_method = global_settings.dt_compression_method;
+    const UInt64 origin_stable_pack_rows = settings.dt_segment_stable_pack_rows;
+    const UInt64 origin_segment_limit_rows = settings.dt_segment_limit_rows;
+    const UInt64 origin_delta_cache_limit_rows = settings.dt_segment_delta_cache_limit_rows;
+    SCOPE_EXIT({
+        global_settings.dt_compression_method = origin_compression_method;
+        settings.dt_compression_method = origin_compression_method;
+        settings.dt_segment_stable_pack_rows = origin_stable_pack_rows;
+        settings.dt_segment_limit_rows = origin_segment_limit_rows;
+        settings.dt_segment_delta_cache_limit_rows = origin_delta_cache_limit_rows;
+        settings.dt_enable_read_string_dictionary = false;
+        global_settings.dt_enable_lightweight_string_compression = false;
+        settings.dt_enable_lightweight_string_compression = false;
+    });
+    // The stable of one segment is written by the lightweight codec, and the packs are large enough to be
+    // dictionary encoded.
+    global_settings.dt_compression_method = CompressionMethod::Lightweight;
+    settings.dt_compression_method = CompressionMethod::Lightweight;
+    global_settings.dt_enable_lightweight_string_compression = true;
+    settings.dt_enable_lightweight_string_compression = true;
+    settings.dt_segment_stable_pack_rows = DEFAULT_MERGE_BLOCK_SIZE;
+    settings.dt_segment_limit_rows = 1000000;
+    settings.dt_segment_delta_cache_limit_rows = 1000000;
+
+    const size_t rows = 3 * DEFAULT_MERGE_BLOCK_SIZE;
+    const std::vector<String> distinct_values{"apple", "banana", "cherry", "durian"};
+    std::mt19937 gen(0);
+    std::vector<Int64> keys(rows);
+    std::vector<String> values(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        keys[i] = i;
+        values[i] = distinct_values[gen() % distinct_values.size()];
+    }
+    context.addMockDeltaMerge(
+        {"test_db", "dict_table"},
+        {{"key", TiDB::TP::TypeLongLong, false}, {"value", TiDB::TP::TypeString, false}},
+        {toVec<Int64>("key", keys), toVec<String>("value", values)});
+    const auto table_id = context.mockStorage()->getTableInfoForDeltaMerge("test_db.dict_table").id;
+    auto storage = std::get<0>(context.mockStorage()->prepareForRead(*context.context, table_id));
+    storage->getStore()->mergeDeltaAll(*context.context);
+
+    // The table scan is only read as dictionaries in the pipeline mode, because the streams of the mock table scan
+    // are built before the aggregation.
+    enablePipeline(true);
+    std::vector<std::shared_ptr<tipb::DAGRequest>> requests{
+        context.scan("test_db", "dict_table").aggregation({Count(col("key"))}, {col("value")}).build(context),
+        context.scan("test_db", "dict_table")
+            .filter(eq(col("value"), lit(Field(String("banana")))))
+            .aggregation({Count(col("key"))}, {col("value")})
+            .build(context),
+        context.scan("test_db", "dict_table")
+            .filter(
+                in(col("value"),
+                   lit(Field(String("apple"))),
+                   lit(Field(String("durian"))),
+                   lit(Field(String("fig")))))
+            .aggregation({Max(col("key")), Count(col("key"))}, {col("value")})
+            .build(context),
+    };
+    for (const auto & request : requests)
+    {
+        settings.dt_enable_read_string_dictionary = false;
+        auto reference = executeStreams(request, 1);
+        settings.dt_enable_read_string_dictionary = true;
+        for (size_t concurrency : {1, 4})
+            ASSERT_COLUMNS_EQ_UR(reference, executeStreams(request, concurrency));
+    }
+}
+CATCH
+
 #undef WRAP_FOR_DM_TEST_BEGIN
 #undef WRAP_FOR_DM_TEST_END
 
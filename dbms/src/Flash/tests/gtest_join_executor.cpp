@@ -5133,6 +5133,61 @@ CATCH
 #undef WRAP_FOR_JOIN_TEST_BEGIN
 #undef WRAP_FOR_JOIN_TEST_END
 
+TEST_F(JoinExecutorTestRunner, JoinV2WithFineGrainedShuffle)
+try
+{
+    UInt64 max_block_size = 800;
+    size_t original_max_streams = 20;
+    size_t original_max_streams_small = 4;
+    std::vector<String> left_table_names = {"left_table_1_concurrency", "left_table_10_concurrency"};
+    std::vector<size_t> right_exchange_receiver_concurrency = {1, 3, 5, 10};
+    std::vector<tipb::JoinType> join_types
+        = {tipb::JoinType::TypeInnerJoin,
+           tipb::JoinType::TypeLeftOuterJoin,
+           tipb::JoinType::TypeSemiJoin,
+           tipb::JoinType::TypeAntiSemiJoin,
+           tipb::JoinType::TypeLeftOuterSemiJoin,
+           tipb::JoinType::TypeRightOuterJoin};
+
+    enablePipeline(true);
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(max_block_size)));
+    for (const auto join_type : join_types)
+    {
+        for (auto & left_table_name : left_table_names)
+        {
+            for (size_t exchange_concurrency : right_exchange_receiver_concurrency)
+            {
+                auto right_name = fmt::format("right_exchange_receiver_{}_concurrency", exchange_concurrency);
+                auto request = context.scan("outer_join_test", left_table_name)
+                                   .join(
+                                       context.receive(right_name, exchange_concurrency),
+                                       join_type,
+                                       {col("a")},
+                                       {},
+                                       {},
+                                       {},
+                                       {},
+                                       exchange_concurrency)
+                                   .build(context);
+                context.context->setSetting("enable_hash_join_v2", "false");
+                auto ref_columns = executeStreams(request, original_max_streams);
+                context.context->setSetting("enable_hash_join_v2", "true");
+                ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, original_max_streams))
+                    << "join_type = " << magic_enum::enum_name(join_type) << ", left_table_name = " << left_table_name
+                    << ", right_exchange_receiver_concurrency = " << exchange_concurrency;
+                /// The build concurrency is less than the fine grained shuffle stream count.
+                if (original_max_streams_small < exchange_concurrency)
+                    ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, original_max_streams_small))
+                        << "join_type = " << magic_enum::enum_name(join_type)
+                        << ", left_table_name = " << left_table_name
+                        << ", right_exchange_receiver_concurrency = " << exchange_concurrency;
+            }
+        }
+    }
+    context.context->setSetting("enable_hash_join_v2", "false");
+}
+CATCH
+
 #undef WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_BEGIN
 #undef WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_END
 
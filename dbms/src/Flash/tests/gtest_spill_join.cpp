@@ -578,6 +578,49 @@ try
 }
 CATCH
 
+TEST_F(SpillJoinTestRunner, HashJoinV2SpillToDisk)
+try
+{
+    UInt64 max_block_size = 800;
+    size_t original_max_streams = 10;
+    String left_table_name = "left_table_5_concurrency";
+    String right_table_name = "right_table_5_concurrency";
+    /// A tiny threshold makes every partition with data spilled.
+    std::vector<UInt64> max_bytes_before_external_joins = {1, 20000};
+    std::vector<tipb::JoinType> join_types
+        = {tipb::JoinType::TypeInnerJoin,
+           tipb::JoinType::TypeLeftOuterJoin,
+           tipb::JoinType::TypeSemiJoin,
+           tipb::JoinType::TypeAntiSemiJoin,
+           tipb::JoinType::TypeLeftOuterSemiJoin,
+           tipb::JoinType::TypeRightOuterJoin};
+
+    enablePipeline(true);
+    context.context->setSetting("enable_hash_join_v2", "true");
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(max_block_size)));
+    for (const auto join_type : join_types)
+    {
+        auto request = context.scan("outer_join_test", left_table_name)
+                           .join(context.scan("outer_join_test", right_table_name), join_type, {col("a")})
+                           .build(context);
+        context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+        auto ref_columns = executeStreams(request, original_max_streams);
+        for (const auto max_bytes_before_external_join : max_bytes_before_external_joins)
+        {
+            context.context->setSetting(
+                "max_bytes_before_external_join",
+                Field(static_cast<UInt64>(max_bytes_before_external_join)));
+            for (size_t concurrency : {1, 3, 10})
+                ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, concurrency))
+                    << "join_type = " << magic_enum::enum_name(join_type)
+                    << ", max_bytes_before_external_join = " << max_bytes_before_external_join
+                    << ", concurrency = " << concurrency;
+        }
+    }
+    context.context->setSetting("enable_hash_join_v2", "false");
+}
+CATCH
+
 #undef WRAP_FOR_SPILL_TEST_BEGIN
 #undef WRAP_FOR_SPILL_TEST_END
 
@@ -622,6 +622,35 @@ try
 }
 CATCH
 
+TEST_F(WindowExecutorTestRunner, rowNumberLimit)
+try
+{
+    // sql : select * from (select *, row_number() over w1 as rn from test6 window w1 as (partition by partition_int1, partition_int2 order by order_int1,order_int2)) where rn < 3
+    auto expect = createColumns(
+        {toNullableVec<Int64>("partition1", {1, 1, 1, 1, 2, 2, 2, 2}),
+         toNullableVec<Int64>("partition2", {1, 1, 2, 2, 1, 1, 2, 2}),
+         toNullableVec<Int64>("order1", {1, 1, 1, 1, 1, 1, 1, 1}),
+         toNullableVec<Int64>("order2", {1, 2, 1, 2, 1, 2, 1, 2}),
+         toNullableVec<Int64>("row_number", {1, 2, 1, 2, 1, 2, 1, 2})});
+    for (const auto & condition :
+         {lt(col("RowNumber()"), lit(Field(static_cast<Int64>(3)))),
+          gt(lit(Field(static_cast<Int64>(3))), col("RowNumber()"))})
+    {
+        auto request
+            = context.scan("test_db", "test_table_more_cols")
+                  .sort({{"partition1", false}, {"partition2", false}, {"order1", false}, {"order2", false}}, true)
+                  .window(
+                      RowNumber(),
+                      {{"order1", false}, {"order2", false}},
+                      {{"partition1", false}, {"partition2", false}},
+                      buildDefaultRowsFrame())
+                  .filter(condition)
+                  .build(context);
+        executeAndAssertColumnsEqual(request, expect);
+    }
+}
+CATCH
+
 TEST_F(WindowExecutorTestRunner, fineGrainedShuffle)
 try
 {
@@ -627,6 +627,8 @@ public:
 
     bool useDefaultImplementationForNulls() const override { return false; }
 
+    bool useDefaultImplementationForStringDictionary() const override { return true; }
+
     void executeImpl(Block & block, const ColumnNumbers & arguments, size_t result) const override
     {
         const ColumnWithTypeAndName & left_arg = block.getByPosition(arguments[0]);
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnDictionaryString.h>
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnSet.h>
 #include <Common/typeid_cast.h>
 #include <DataTypes/DataTypeNothing.h>
 #include <DataTypes/DataTypeNullable.h>
@@ -22,6 +24,7 @@
 
 #include <ext/collection_cast.h>
 #include <ext/range.h>
+#include <optional>
 
 
 namespace DB
@@ -224,11 +227,84 @@ bool IExecutableFunction::defaultImplementationForNulls(Block & block, const Col
     return false;
 }
 
+bool IExecutableFunction::defaultImplementationForStringDictionary(
+    Block & block,
+    const ColumnNumbers & args,
+    size_t result) const
+{
+    std::optional<size_t> dictionary_arg_num;
+    bool other_arguments_are_constants = true;
+    for (size_t arg_num = 0; arg_num < args.size(); ++arg_num)
+    {
+        const auto * column = block.getByPosition(args[arg_num]).column.get();
+        if (typeid_cast<const ColumnDictionaryString *>(column))
+        {
+            other_arguments_are_constants &= !dictionary_arg_num.has_value();
+            dictionary_arg_num = arg_num;
+        }
+        else if (!column->isColumnConst() && !typeid_cast<const ColumnSet *>(column))
+        {
+            other_arguments_are_constants = false;
+        }
+    }
+    if (!dictionary_arg_num.has_value())
+        return false;
+
+    Block temporary_block;
+    size_t arguments_size = args.size();
+    ColumnNumbers temporary_argument_numbers(arguments_size);
+    for (size_t i = 0; i < arguments_size; ++i)
+        temporary_argument_numbers[i] = i;
+
+    if (!useDefaultImplementationForStringDictionary() || !other_arguments_are_constants)
+    {
+        /// Materialize the dictionary columns in a temporary block, the columns of the caller's block may be
+        /// used by other expressions or operators later.
+        for (size_t arg_num = 0; arg_num < arguments_size; ++arg_num)
+        {
+            const ColumnWithTypeAndName & column = block.getByPosition(args[arg_num]);
+            if (typeid_cast<const ColumnDictionaryString *>(column.column.get()))
+                temporary_block.insert({column.column->convertToFullColumnIfConst(), column.type, column.name});
+            else
+                temporary_block.insert(column);
+        }
+        temporary_block.insert(block.getByPosition(result));
+
+        execute(temporary_block, temporary_argument_numbers, arguments_size);
+
+        block.getByPosition(result).column = temporary_block.getByPosition(arguments_size).column;
+        return true;
+    }
+
+    const auto & dictionary_column
+        = typeid_cast<const ColumnDictionaryString &>(*block.getByPosition(args[*dictionary_arg_num]).column);
+    const size_t dictionary_size = dictionary_column.getDictionary().size();
+
+    for (size_t arg_num = 0; arg_num < arguments_size; ++arg_num)
+    {
+        const ColumnWithTypeAndName & column = block.getByPosition(args[arg_num]);
+        if (arg_num == *dictionary_arg_num)
+            temporary_block.insert({dictionary_column.getDictionaryPtr(), column.type, column.name});
+        else
+            temporary_block.insert({column.column->cloneResized(dictionary_size), column.type, column.name});
+    }
+    temporary_block.insert(block.getByPosition(result));
+
+    execute(temporary_block, temporary_argument_numbers, arguments_size);
+
+    block.getByPosition(result).column
+        = dictionary_column.gatherByIndexes(*temporary_block.getByPosition(arguments_size).column);
+    return true;
+}
+
 void IExecutableFunction::execute(Block & block, const ColumnNumbers & args, size_t result) const
 {
     if (defaultImplementationForConstantArguments(block, args, result))
         return;
 
+    if (defaultImplementationForStringDictionary(block, args, result))
+        return;
+
     if (defaultImplementationForNulls(block, args, result))
         return;
 
@@ -73,6 +73,13 @@ protected:
       */
     virtual bool useDefaultImplementationForConstants() const { return false; }
 
+    /** If one argument is a ColumnDictionaryString and the others are constants,
+      *  the function is executed on the dictionary only, and the result is gathered by the indexes of the rows.
+      * Otherwise the ColumnDictionaryString arguments are materialized in a temporary block before execution.
+      * Only for the functions whose result of a row only depends on the arguments of the row.
+      */
+    virtual bool useDefaultImplementationForStringDictionary() const { return false; }
+
     /** Some arguments could remain constant during this implementation.
       */
     virtual ColumnNumbers getArgumentsThatAreAlwaysConstant() const { return {}; }
@@ -80,6 +87,7 @@ protected:
 private:
     bool defaultImplementationForNulls(Block & block, const ColumnNumbers & args, size_t result) const;
     bool defaultImplementationForConstantArguments(Block & block, const ColumnNumbers & args, size_t result) const;
+    bool defaultImplementationForStringDictionary(Block & block, const ColumnNumbers & args, size_t result) const;
 };
 
 using ExecutableFunctionPtr = std::shared_ptr<IExecutableFunction>;
@@ -267,6 +275,7 @@ public:
     /// Override these functions to change default implementation behavior. See details in IExecutableFunction.
     virtual bool useDefaultImplementationForNulls() const { return true; }
     virtual bool useDefaultImplementationForConstants() const { return false; }
+    virtual bool useDefaultImplementationForStringDictionary() const { return false; }
     virtual ColumnNumbers getArgumentsThatAreAlwaysConstant() const { return {}; }
 
     /// Override these functions to change default implementation behavior. See details in IFunctionBase.
@@ -335,6 +344,10 @@ protected:
     }
     bool useDefaultImplementationForNulls() const final { return function->useDefaultImplementationForNulls(); }
     bool useDefaultImplementationForConstants() const final { return function->useDefaultImplementationForConstants(); }
+    bool useDefaultImplementationForStringDictionary() const final
+    {
+        return function->useDefaultImplementationForStringDictionary();
+    }
     ColumnNumbers getArgumentsThatAreAlwaysConstant() const final
     {
         return function->getArgumentsThatAreAlwaysConstant();
@@ -0,0 +1,308 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/Logger.h>
+#include <IO/BaseFile/IOUring.h>
+#include <common/logger_useful.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+// IORING_OP_READ/WRITE and the probe are added in the kernel headers of 5.6. IORING_REGISTER_PROBE is an enum
+// value, so check IO_URING_OP_SUPPORTED which is defined by the same version instead.
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register) \
+    && defined(IO_URING_OP_SUPPORTED)
+#define TIFLASH_HAS_IO_URING 1
+#endif
+#endif
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int AIO_SUBMIT_ERROR;
+extern const int NOT_IMPLEMENTED;
+} // namespace ErrorCodes
+
+#ifdef TIFLASH_HAS_IO_URING
+namespace
+{
+int ioUringSetup(UInt32 entries, io_uring_params * params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ring_fd, UInt32 to_submit, UInt32 min_complete, UInt32 flags)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ring_fd, UInt32 opcode, void * arg, UInt32 nr_args)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T * offsetPtr(void * base, UInt32 offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+}
+
+// The length of one request is limited to UInt32, split the large request by 1GiB.
+// The remaining part is handled by the caller as a short read/write.
+constexpr size_t MAX_REQUEST_SIZE = 1ULL << 30;
+} // namespace
+
+IOUring::IOUring(UInt32 queue_depth)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = ioUringSetup(queue_depth, &params);
+    if (ring_fd < 0)
+        throwFromErrno("io_uring_setup failed", ErrorCodes::AIO_SUBMIT_ERROR);
+
+    try
+    {
+        sq_entries = params.sq_entries;
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(UInt32);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        // Since kernel 5.4, the submission queue and the completion queue are mapped by one mmap
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap)
+            sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+        auto map_ring = [this](size_t size, off_t offset) {
+            void * ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+            if (ptr == MAP_FAILED)
+                throwFromErrno("mmap io_uring failed", ErrorCodes::AIO_SUBMIT_ERROR);
+            return ptr;
+        };
+        sq_ring = map_ring(sq_ring_size, IORING_OFF_SQ_RING);
+        cq_ring = single_mmap ? sq_ring : map_ring(cq_ring_size, IORING_OFF_CQ_RING);
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = map_ring(sqes_size, IORING_OFF_SQES);
+
+        sq_head = offsetPtr<UInt32>(sq_ring, params.sq_off.head);
+        sq_tail = offsetPtr<UInt32>(sq_ring, params.sq_off.tail);
+        sq_ring_mask = offsetPtr<UInt32>(sq_ring, params.sq_off.ring_mask);
+        sq_array = offsetPtr<UInt32>(sq_ring, params.sq_off.array);
+        cq_head = offsetPtr<UInt32>(cq_ring, params.cq_off.head);
+        cq_tail = offsetPtr<UInt32>(cq_ring, params.cq_off.tail);
+        cq_ring_mask = offsetPtr<UInt32>(cq_ring, params.cq_off.ring_mask);
+        cqes = offsetPtr<void>(cq_ring, params.cq_off.cqes);
+    }
+    catch (...)
+    {
+        destroy();
+        throw;
+    }
+}
+
+void IOUring::destroy()
+{
+    if (sqes != nullptr)
+        ::munmap(sqes, sqes_size);
+    if (cq_ring != nullptr && cq_ring != sq_ring)
+        ::munmap(cq_ring, cq_ring_size);
+    if (sq_ring != nullptr)
+        ::munmap(sq_ring, sq_ring_size);
+    if (ring_fd >= 0)
+        ::close(ring_fd);
+    sqes = cq_ring = sq_ring = nullptr;
+    ring_fd = -1;
+}
+
+bool IOUring::isReadWriteSupported() const
+{
+    // IORING_OP_READ and IORING_OP_WRITE are added in kernel 5.6, as well as IORING_REGISTER_PROBE.
+    // On older kernels io_uring_setup succeeds but the probe fails with EINVAL.
+    constexpr size_t num_probe_ops = IORING_OP_WRITE + 1;
+    const size_t probe_size = sizeof(io_uring_probe) + num_probe_ops * sizeof(io_uring_probe_op);
+    std::vector<char> probe_buf(probe_size, 0);
+    auto * probe = reinterpret_cast<io_uring_probe *>(probe_buf.data());
+    if (ioUringRegister(ring_fd, IORING_REGISTER_PROBE, probe, num_probe_ops) < 0)
+        return false;
+    auto is_op_supported = [probe](UInt32 op) {
+        return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    };
+    return is_op_supported(IORING_OP_READ) && is_op_supported(IORING_OP_WRITE);
+}
+
+void IOUring::submitAndWait(OpType type, Request * requests, size_t num_requests)
+{
+    auto * sqe_array = static_cast<io_uring_sqe *>(sqes);
+    auto * cqe_array = static_cast<io_uring_cqe *>(cqes);
+    const UInt32 sq_mask = *sq_ring_mask;
+    const UInt32 cq_mask = *cq_ring_mask;
+
+    size_t next_to_submit = 0;
+    size_t num_completed = 0;
+    size_t num_inflight = 0;
+    auto reap_completions = [&]() {
+        UInt32 head = *cq_head;
+        const UInt32 cq_tail_now = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != cq_tail_now; ++head)
+        {
+            const auto & cqe = cqe_array[head & cq_mask];
+            requests[cqe.user_data].res = cqe.res;
+            ++num_completed;
+            --num_inflight;
+        }
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+    };
+
+    while (num_completed < num_requests)
+    {
+        // Fill the submission queue as much as possible. The completion queue is twice the
+        // size of the submission queue, so it never overflows.
+        UInt32 tail = *sq_tail;
+        while (next_to_submit < num_requests && num_inflight < sq_entries)
+        {
+            auto & req = requests[next_to_submit];
+            const UInt32 index = tail & sq_mask;
+            auto & sqe = sqe_array[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = type == OpType::Read ? IORING_OP_READ : IORING_OP_WRITE;
+            sqe.fd = req.fd;
+            sqe.addr = reinterpret_cast<UInt64>(req.buf);
+            sqe.len = static_cast<UInt32>(std::min(req.size, MAX_REQUEST_SIZE));
+            sqe.off = req.offset;
+            sqe.user_data = next_to_submit;
+            sq_array[index] = index;
+            ++tail;
+            ++next_to_submit;
+            ++num_inflight;
+        }
+        // Publish the new entries to the kernel
+        __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+        // Submit the entries not consumed by the kernel yet, and wait for at least one completion
+        const UInt32 to_submit = tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+        if (ioUringEnter(ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS) < 0)
+        {
+            // Interrupted or lack of resources, reap the completed ones and retry
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                const int saved_errno = errno;
+                // The requests consumed by the kernel are still writing into the buffers of the caller,
+                // wait for them before throwing. The ones not consumed yet are withdrawn from the
+                // submission queue, so that they are not submitted by the next call.
+                const UInt32 sq_head_now = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+                num_inflight -= tail - sq_head_now;
+                __atomic_store_n(sq_tail, sq_head_now, __ATOMIC_RELEASE);
+                reap_completions();
+                while (num_inflight > 0)
+                {
+                    if (ioUringEnter(ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR
+                        && errno != EAGAIN && errno != EBUSY)
+                    {
+                        LOG_ERROR(
+                            Logger::get(),
+                            "Wait for io_uring completions failed, {} requests are still in flight",
+                            num_inflight);
+                        break;
+                    }
+                    reap_completions();
+                }
+                throwFromErrno("io_uring_enter failed", ErrorCodes::AIO_SUBMIT_ERROR, saved_errno);
+            }
+        }
+
+        reap_completions();
+    }
+}
+
+bool IOUring::isSupported()
+{
+    static const bool supported = [] {
+        try
+        {
+            IOUring ring(1);
+            if (!ring.isReadWriteSupported())
+            {
+                LOG_INFO(Logger::get(), "io_uring is not available, read/write ops are not supported by the kernel");
+                return false;
+            }
+            return true;
+        }
+        catch (...)
+        {
+            LOG_INFO(Logger::get(), "io_uring is not available, {}", getCurrentExceptionMessage(false));
+            return false;
+        }
+    }();
+    return supported;
+}
+
+IOUring * IOUring::getThreadLocal()
+{
+    thread_local std::unique_ptr<IOUring> ring;
+    thread_local bool failed = false;
+    if (ring != nullptr)
+        return ring.get();
+    if (failed || !isSupported())
+        return nullptr;
+    try
+    {
+        ring = std::make_unique<IOUring>();
+    }
+    catch (...)
+    {
+        // e.g. exceed the limit of locked memory on old kernels
+        tryLogCurrentException(Logger::get(), "Create io_uring failed");
+        failed = true;
+    }
+    return ring.get();
+}
+
+#else
+
+IOUring::IOUring(UInt32 /*queue_depth*/)
+{
+    throw Exception(ErrorCodes::NOT_IMPLEMENTED, "io_uring is not supported on this platform");
+}
+
+void IOUring::destroy() {}
+
+void IOUring::submitAndWait(OpType /*type*/, Request * /*requests*/, size_t /*num_requests*/)
+{
+    throw Exception(ErrorCodes::NOT_IMPLEMENTED, "io_uring is not supported on this platform");
+}
+
+bool IOUring::isSupported()
+{
+    return false;
+}
+
+IOUring * IOUring::getThreadLocal()
+{
+    return nullptr;
+}
+
+#endif
+
+IOUring::~IOUring()
+{
+    destroy();
+}
+
+} // namespace DB
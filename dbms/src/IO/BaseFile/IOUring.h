@@ -0,0 +1,100 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/nocopyable.h>
+#include <common/types.h>
+
+#include <sys/types.h>
+
+namespace DB
+{
+/**
+ * A minimal io_uring instance for submitting a batch of positional reads or writes
+ * with one system call and waiting for all of them, so that the queue depth of the
+ * device can be used by a single thread.
+ *
+ * It talks to the kernel by the raw system calls, so liburing is not required.
+ * An instance must only be used by one thread, use `getThreadLocal` to get the one
+ * of the current thread.
+ */
+class IOUring
+{
+public:
+    struct Request
+    {
+        int fd = -1;
+        char * buf = nullptr;
+        size_t size = 0;
+        off_t offset = 0;
+        // The number of bytes transferred, or -errno if failed. Set by `submitAndWait`.
+        // Note that it could be less than `size`, the caller should handle the remaining part.
+        ssize_t res = 0;
+    };
+
+    enum class OpType
+    {
+        Read,
+        Write,
+    };
+
+    static constexpr UInt32 DEFAULT_QUEUE_DEPTH = 64;
+
+    // Throw an exception if io_uring is not available
+    explicit IOUring(UInt32 queue_depth = DEFAULT_QUEUE_DEPTH);
+
+    ~IOUring();
+
+    DISALLOW_COPY_AND_MOVE(IOUring);
+
+    // Submit all `requests` and wait until all of them are completed. If there are more
+    // requests than the queue depth, a new request is submitted once an old one is completed.
+    void submitAndWait(OpType type, Request * requests, size_t num_requests);
+
+    // Whether io_uring and its read/write ops (kernel 5.6+) are available on this platform and
+    // kernel. It could be disabled by the kernel config or by seccomp in containers.
+    static bool isSupported();
+
+    // The instance of the current thread, created on the first call.
+    // Return nullptr if io_uring is not available.
+    static IOUring * getThreadLocal();
+
+private:
+    void destroy();
+
+    // Probe whether the kernel supports IORING_OP_READ and IORING_OP_WRITE.
+    bool isReadWriteSupported() const;
+
+    int ring_fd = -1;
+    UInt32 sq_entries = 0;
+
+    void * sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    void * cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    void * sqes = nullptr;
+    size_t sqes_size = 0;
+
+    UInt32 * sq_tail = nullptr;
+    UInt32 * sq_head = nullptr;
+    const UInt32 * sq_ring_mask = nullptr;
+    UInt32 * sq_array = nullptr;
+    UInt32 * cq_head = nullptr;
+    const UInt32 * cq_tail = nullptr;
+    const UInt32 * cq_ring_mask = nullptr;
+    void * cqes = nullptr;
+};
+
+} // namespace DB
@@ -43,6 +43,8 @@ public:
 
     int getFd() const override { return fd; }
 
+    int getFdForRawIO() const override { return (write_limiter == nullptr && read_limiter == nullptr) ? fd : -1; }
+
     bool isClosed() const override { return fd == -1; }
 
     int fsync() override;
@@ -38,6 +38,10 @@ public:
 
     virtual int getFd() const = 0;
 
+    // Return the fd if the data can be read or written through the fd directly without this object,
+    // e.g. by io_uring. Return -1 if the file transforms the data (like encryption) or limits the rate.
+    virtual int getFdForRawIO() const { return -1; }
+
     virtual bool isClosed() const = 0;
 
     virtual void close() = 0;
@@ -0,0 +1,90 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Debug/TiFlashTestEnv.h>
+#include <IO/BaseFile/IOUring.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <ext/scope_guard.h>
+#include <vector>
+
+namespace DB::tests
+{
+TEST(IOUringTest, ReadWrite)
+{
+    auto * ring = IOUring::getThreadLocal();
+    if (ring == nullptr)
+    {
+        ASSERT_FALSE(IOUring::isSupported());
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    const auto path = TiFlashTestEnv::getTemporaryPath("IOUringTest");
+    TiFlashTestEnv::tryRemovePath(path, /*recreate*/ true);
+    const int fd = ::open((path + "/data").c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    SCOPE_EXIT({ ::close(fd); });
+
+    String content(1024 * 1024, '\0');
+    for (size_t i = 0; i < content.size(); ++i)
+        content[i] = static_cast<char>(i * 7 + i / 13);
+
+    // More requests than the queue depth
+    std::vector<IOUring::Request> requests;
+    constexpr size_t chunk_size = 1000;
+    for (size_t offset = 0; offset < content.size(); offset += chunk_size)
+    {
+        requests.emplace_back(IOUring::Request{
+            .fd = fd,
+            .buf = content.data() + offset,
+            .size = std::min(chunk_size, content.size() - offset),
+            .offset = static_cast<off_t>(offset)});
+    }
+    ring->submitAndWait(IOUring::OpType::Write, requests.data(), requests.size());
+    for (const auto & req : requests)
+        ASSERT_EQ(req.res, static_cast<ssize_t>(req.size));
+
+    // Read random ranges
+    String result(content.size(), '\0');
+    requests.clear();
+    for (size_t i = 0; i < 500; ++i)
+    {
+        const size_t offset = (i * 7919) % (content.size() - chunk_size);
+        requests.emplace_back(IOUring::Request{
+            .fd = fd,
+            .buf = result.data() + offset,
+            .size = chunk_size,
+            .offset = static_cast<off_t>(offset)});
+    }
+    ring->submitAndWait(IOUring::OpType::Read, requests.data(), requests.size());
+    for (const auto & req : requests)
+    {
+        ASSERT_EQ(req.res, static_cast<ssize_t>(req.size));
+        ASSERT_EQ(memcmp(req.buf, content.data() + req.offset, req.size), 0) << req.offset;
+    }
+
+    // Short read at the end of file, and the error of each request is returned separately
+    IOUring::Request error_requests[2] = {
+        {.fd = fd, .buf = result.data(), .size = 100, .offset = static_cast<off_t>(content.size() - 10)},
+        {.fd = -1, .buf = result.data(), .size = 100, .offset = 0},
+    };
+    ring->submitAndWait(IOUring::OpType::Read, error_requests, 2);
+    ASSERT_EQ(error_requests[0].res, 10);
+    ASSERT_EQ(error_requests[1].res, -EBADF);
+}
+
+} // namespace DB::tests
@@ -14,78 +14,84 @@
 
 #pragma once
 
+#include <Common/MemoryTrackerSetter.h>
+#include <Common/UniThreadPool.h>
+#include <Core/Defines.h>
 #include <IO/Buffer/WriteBuffer.h>
-#include <common/ThreadPool.h>
-#include <math.h>
 
+#include <future>
+#include <memory>
 #include <vector>
 
 
 namespace DB
 {
 /** Writes data asynchronously using double buffering.
+  * The caller fills one buffer while the other one is written to `out` by a task of `pool`,
+  * so at most one write is in flight. `out` must not be used by the caller until `sync()` returns.
+  * The exception thrown by the asynchronous write is rethrown by the following `next()` or `sync()`.
   */
 class AsynchronousWriteBuffer : public WriteBuffer
 {
 private:
     WriteBuffer & out; /// The main buffer, responsible for writing data.
-    std::vector<char> memory; /// A piece of memory for duplicating the buffer.
-    legacy::ThreadPool pool; /// For asynchronous data writing.
-    bool started; /// Has an asynchronous data write started?
+    ThreadPool & pool; /// For asynchronous data writing.
+    std::vector<char> memory; /// The buffer being filled by the caller.
+    std::vector<char> writing_memory; /// The buffer being written to `out` asynchronously.
+    std::future<void> pending_write;
 
-    /// Swap the main and duplicate buffers.
-    void swapBuffers()
+    void waitForPendingWrite()
     {
-        buffer().swap(out.buffer());
-        std::swap(position(), out.position());
+        if (pending_write.valid())
+            pending_write.get();
     }
 
     void nextImpl() override
     {
-        if (!offset())
-            return;
+        waitForPendingWrite();
 
-        if (started)
-            pool.wait();
-        else
-            started = true;
-
-        swapBuffers();
+        size_t bytes_to_write = offset();
+        memory.swap(writing_memory);
+        set(memory.data(), memory.size());
 
-        /// The data will be written in separate stream.
-        pool.schedule([this] { thread(); });
+        /// The data will be written in the thread pool.
+        auto task = std::make_shared<std::packaged_task<void()>>(
+            [this, bytes_to_write, mem_tracker = current_memory_tracker] {
+                MemoryTrackerSetter setter(true, mem_tracker);
+                out.write(writing_memory.data(), bytes_to_write);
+                out.next();
+            });
+        auto future = task->get_future();
+        /// Wait until there is room in the queue of the pool rather than fail the spill when the pool is busy.
+        pool.scheduleOrThrowOnError([task] { (*task)(); });
+        pending_write = std::move(future);
     }
 
 public:
-    explicit AsynchronousWriteBuffer(WriteBuffer & out_)
+    AsynchronousWriteBuffer(WriteBuffer & out_, ThreadPool & pool_, size_t buf_size = DBMS_DEFAULT_BUFFER_SIZE)
         : WriteBuffer(nullptr, 0)
         , out(out_)
-        , memory(out.buffer().size())
-        , pool(1)
-        , started(false)
+        , pool(pool_)
+        , memory(buf_size)
+        , writing_memory(buf_size)
     {
         /// Data is written to the duplicate buffer.
         set(memory.data(), memory.size());
     }
 
-    ~AsynchronousWriteBuffer() override
+    /// Write all the data to `out` and wait for it.
+    void sync()
     {
-        try
-        {
-            if (started)
-                pool.wait();
-
-            swapBuffers();
-            out.next();
-        }
-        catch (...)
-        {
-            tryLogCurrentException(__PRETTY_FUNCTION__);
-        }
+        next();
+        waitForPendingWrite();
     }
 
-    /// That is executed in a separate thread
-    void thread() { out.next(); }
+    ~AsynchronousWriteBuffer() override
+    {
+        /// The pending write refers to `writing_memory`, so it must be finished before the buffers are released.
+        if (pending_write.valid())
+            pending_write.wait();
+    }
 };
 
 } // namespace DB
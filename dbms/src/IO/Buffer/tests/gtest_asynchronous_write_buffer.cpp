@@ -0,0 +1,103 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <IO/Buffer/AsynchronousWriteBuffer.h>
+#include <IO/Buffer/BufferWithOwnMemory.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <IO/IOThreadPools.h>
+#include <IO/WriteHelpers.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int CANNOT_WRITE_TO_FILE_DESCRIPTOR;
+} // namespace ErrorCodes
+
+namespace tests
+{
+
+TEST(AsynchronousWriteBuffer, Write)
+{
+    for (size_t buf_size : {1, 7, 4096})
+    {
+        std::string expect;
+        WriteBufferFromOwnString out;
+        {
+            AsynchronousWriteBuffer buffer(out, SpillIOPool::get(), buf_size);
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                char c = 'a' + i % 26;
+                expect.push_back(c);
+                buffer.write(c);
+            }
+            buffer.sync();
+            EXPECT_EQ(buffer.count(), expect.size());
+        }
+        EXPECT_EQ(out.str(), expect);
+    }
+}
+
+TEST(AsynchronousWriteBuffer, FullPool)
+{
+    // Only one write can be scheduled at a time, the others wait for room in the pool.
+    ThreadPool pool(/*max_threads*/ 1, /*max_free_threads*/ 1, /*queue_size*/ 1);
+    constexpr size_t num_buffers = 4;
+    std::vector<WriteBufferFromOwnString> outs(num_buffers);
+    std::vector<std::unique_ptr<AsynchronousWriteBuffer>> buffers;
+    for (auto & out : outs)
+        buffers.emplace_back(std::make_unique<AsynchronousWriteBuffer>(out, pool, 1));
+    std::string expect;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        char c = 'a' + i % 26;
+        expect.push_back(c);
+        for (auto & buffer : buffers)
+            buffer->write(c);
+    }
+    for (size_t i = 0; i < num_buffers; ++i)
+    {
+        buffers[i]->sync();
+        EXPECT_EQ(outs[i].str(), expect);
+    }
+}
+
+TEST(AsynchronousWriteBuffer, Exception)
+{
+    class FailedWriteBuffer : public BufferWithOwnMemory<WriteBuffer>
+    {
+    public:
+        FailedWriteBuffer()
+            : BufferWithOwnMemory<WriteBuffer>(16)
+        {}
+
+    private:
+        void nextImpl() override { throw Exception("write failed", ErrorCodes::CANNOT_WRITE_TO_FILE_DESCRIPTOR); }
+    };
+
+    FailedWriteBuffer out;
+    AsynchronousWriteBuffer buffer(out, SpillIOPool::get(), 16);
+    // The exception of the asynchronous write is thrown by the following sync.
+    writeString(std::string(20, 'a'), buffer);
+    ASSERT_THROW(buffer.sync(), Exception);
+}
+
+} // namespace tests
+} // namespace DB
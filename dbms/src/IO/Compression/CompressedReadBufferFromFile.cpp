@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/PODArray.h>
 #include <IO/Compression/CompressedReadBufferFromFile.h>
+#include <IO/Compression/CompressionCodecLightweight.h>
 
 namespace DB
 {
@@ -82,6 +84,121 @@ void CompressedReadBufferFromFileImpl<has_legacy_checksum>::seek(
     }
 }
 
+template <bool has_legacy_checksum>
+bool CompressedReadBufferFromFileImpl<has_legacy_checksum>::readStringDictionary(
+    size_t offset_in_compressed_file,
+    size_t offset_in_decompressed_block,
+    size_t rows,
+    const StringDictionaryCallback & callback)
+{
+    /// The blocks are not decompressed into working_buffer, so drop it.
+    bytes += offset();
+    working_buffer.resize(0);
+    pos = working_buffer.begin();
+    size_compressed = 0;
+    file_in.seek(offset_in_compressed_file);
+
+    constexpr UInt8 header_size = ICompressionCodec::getHeaderSize();
+    Compression::StringDictionary dict;
+    size_t skip_bytes = offset_in_decompressed_block;
+    while (rows > 0)
+    {
+        size_t size_decompressed = 0;
+        size_t size_compressed_without_checksum = 0;
+        if (!this->readCompressedData(size_decompressed, size_compressed_without_checksum))
+            return false;
+        if (ICompressionCodec::readMethod(this->compressed_buffer)
+                != static_cast<UInt8>(CompressionMethodByte::Lightweight)
+            || !CompressionCodecLightweight::tryDecodeStringDictionary(
+                this->compressed_buffer + header_size,
+                size_compressed_without_checksum - header_size,
+                dict))
+            return false;
+
+        /// Every token except the last one is a string followed by '\0' in this block,
+        /// and the last one is empty if the block ends with a whole string.
+        const size_t whole_tokens = dict.indexes.size() - 1;
+        /// Skip the strings before the position of the first block.
+        size_t begin = 0;
+        for (; skip_bytes > 0 && begin < whole_tokens; ++begin)
+        {
+            const size_t token_bytes = dict.tokens[dict.indexes[begin]].size + 1;
+            if (token_bytes > skip_bytes)
+                return false;
+            skip_bytes -= token_bytes;
+        }
+        if (skip_bytes > 0)
+            return false;
+
+        const size_t count = std::min(rows, whole_tokens - begin);
+        if (count > 0)
+            callback(dict, dict.indexes.data() + begin, count);
+        rows -= count;
+        if (rows > 0 && dict.tokens[dict.indexes.back()].size != 0)
+            return false;
+    }
+    return true;
+}
+
+template <bool has_legacy_checksum>
+bool CompressedReadBufferFromFileImpl<has_legacy_checksum>::readIntegerFilter(
+    size_t offset_in_compressed_file,
+    size_t offset_in_decompressed_block,
+    size_t rows,
+    const Compression::IntegerPredicate & predicate,
+    UInt8 * filter)
+{
+    /// The blocks are not decompressed into working_buffer, so drop it.
+    bytes += offset();
+    working_buffer.resize(0);
+    pos = working_buffer.begin();
+    size_compressed = 0;
+    file_in.seek(offset_in_compressed_file);
+
+    if (offset_in_decompressed_block % predicate.value_size != 0)
+        return false;
+
+    constexpr UInt8 header_size = ICompressionCodec::getHeaderSize();
+    PaddedPODArray<UInt8> block_filter;
+    size_t skip_rows = offset_in_decompressed_block / predicate.value_size;
+    while (rows > 0)
+    {
+        size_t size_decompressed = 0;
+        size_t size_compressed_without_checksum = 0;
+        if (!this->readCompressedData(size_decompressed, size_compressed_without_checksum))
+            return false;
+        if (ICompressionCodec::readMethod(this->compressed_buffer)
+            != static_cast<UInt8>(CompressionMethodByte::Lightweight))
+            return false;
+
+        /// The results are written to `filter` directly if the whole block is read.
+        const size_t block_rows = size_decompressed / predicate.value_size;
+        if (skip_rows >= block_rows)
+            return false;
+        const size_t count = std::min(rows, block_rows - skip_rows);
+        UInt8 * block_filter_data = filter;
+        if (count != block_rows)
+        {
+            block_filter.resize(block_rows);
+            block_filter_data = block_filter.data();
+        }
+        if (!CompressionCodecLightweight::tryFilterInteger(
+                this->compressed_buffer + header_size,
+                size_compressed_without_checksum - header_size,
+                size_decompressed,
+                predicate,
+                block_filter_data))
+            return false;
+        if (block_filter_data != filter)
+            memcpy(filter, block_filter_data + skip_rows, count);
+
+        filter += count;
+        rows -= count;
+        skip_rows = 0;
+    }
+    return true;
+}
+
 template <bool has_legacy_checksum>
 size_t CompressedReadBufferFromFileImpl<has_legacy_checksum>::readBig(char * to, size_t n)
 {
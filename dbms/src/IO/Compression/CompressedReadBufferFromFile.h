@@ -16,6 +16,9 @@
 
 #include <IO/Buffer/ReadBufferFromFileBase.h>
 #include <IO/Compression/CompressedReadBufferBase.h>
+#include <IO/Compression/EncodingUtil.h>
+
+#include <functional>
 
 namespace DB
 {
@@ -31,6 +34,37 @@ struct CompressedSeekableReaderBuffer : public BufferWithOwnMemory<ReadBuffer>
 
     virtual void seek(size_t offset_in_compressed_file, size_t offset_in_decompressed_block) = 0;
 
+    /// Called for each block with the tokens of the block and the indexes of the strings read from it.
+    using StringDictionaryCallback
+        = std::function<void(const Compression::StringDictionary & dict, const UInt32 * indexes, size_t count)>;
+
+    /// Read `rows` strings, each of which is terminated by '\0', from the position like `seek` without joining
+    /// them, if the blocks are encoded by the dictionary mode of the lightweight codec.
+    /// Return false if a block is not dictionary encoded or a string crosses the end of a block, then the strings
+    /// must be read as usual. In any case, the buffer must be seeked before the next read.
+    virtual bool readStringDictionary(
+        size_t /*offset_in_compressed_file*/,
+        size_t /*offset_in_decompressed_block*/,
+        size_t /*rows*/,
+        const StringDictionaryCallback & /*callback*/)
+    {
+        return false;
+    }
+
+    /// Evaluate `predicate` on `rows` integers from the position like `seek` and write the results to `filter`,
+    /// without decompressing the blocks, if they are encoded by the constant, run-length or FOR mode of the
+    /// lightweight codec. Return false if a block is encoded otherwise, then the predicate must be evaluated on
+    /// the decompressed integers. In any case, the buffer must be seeked before the next read.
+    virtual bool readIntegerFilter(
+        size_t /*offset_in_compressed_file*/,
+        size_t /*offset_in_decompressed_block*/,
+        size_t /*rows*/,
+        const Compression::IntegerPredicate & /*predicate*/,
+        UInt8 * /*filter*/)
+    {
+        return false;
+    }
+
     CompressedSeekableReaderBuffer()
         : BufferWithOwnMemory<ReadBuffer>(0)
     {}
@@ -47,6 +81,19 @@ public:
 
     void seek(size_t offset_in_compressed_file, size_t offset_in_decompressed_block) override;
 
+    bool readStringDictionary(
+        size_t offset_in_compressed_file,
+        size_t offset_in_decompressed_block,
+        size_t rows,
+        const StringDictionaryCallback & callback) override;
+
+    bool readIntegerFilter(
+        size_t offset_in_compressed_file,
+        size_t offset_in_decompressed_block,
+        size_t rows,
+        const Compression::IntegerPredicate & predicate,
+        UInt8 * filter) override;
+
     size_t readBig(char * to, size_t n) override;
 
     void setProfileCallback(const ReadBufferFromFileBase::ProfileCallback & profile_callback_, clockid_t clock_type_)
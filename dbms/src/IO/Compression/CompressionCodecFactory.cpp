@@ -175,14 +175,17 @@ CompressionCodecPtr CompressionCodecFactory::create(const CompressionSetting & s
 
     if constexpr (IS_COMPRESS)
     {
-        // If method_byte is Lightweight, use LZ4 codec for non-integral types
+        // If method_byte is Lightweight, use LZ4 codec for the types other than integer, floating-point and string
         // If method_byte is DeltaFOR/RunLength/FOR, since we do not support use these methods independently,
         // there must be another codec to compress data. Use that compress codec directly.
         if (!isInteger(setting.data_type))
         {
             if (setting.method_byte == CompressionMethodByte::Lightweight)
             {
-                // Use LZ4 codec for non-integral types
+                // Lightweight codec has its own modes for floating-point and string types
+                if (isFloatingPoint(setting.data_type) || setting.data_type == CompressionDataType::String)
+                    return std::make_unique<CompressionCodecLightweight>(setting.data_type, setting.level);
+                // Use LZ4 codec for other types
                 // TODO: maybe we can use zstd?
                 auto method = CompressionMethod::LZ4;
                 CompressionSetting setting(method, CompressionSetting::getDefaultLevel(method));
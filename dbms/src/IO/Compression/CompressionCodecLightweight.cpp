@@ -32,6 +32,8 @@ extern const int CANNOT_DECOMPRESS;
 
 CompressionCodecLightweight::CompressionCodecLightweight(CompressionDataType data_type_, int level_)
     : ctx(level_)
+    , float_ctx(level_)
+    , string_ctx(level_)
     , data_type(data_type_)
 {}
 
@@ -61,8 +63,11 @@ UInt32 CompressionCodecLightweight::doCompressData(const char * source, UInt32 s
     case CompressionDataType::Int64:
         return 1 + compressDataForInteger<UInt64>(source, source_size, dest);
     case CompressionDataType::Float32:
+        return 1 + compressDataForFloat<Float32>(source, source_size, dest);
     case CompressionDataType::Float64:
+        return 1 + compressDataForFloat<Float64>(source, source_size, dest);
     case CompressionDataType::String:
+        return 1 + compressDataForString(source, source_size, dest);
     case CompressionDataType::Unknown:
         return 1 + compressDataForNonInteger(source, source_size, dest);
     default:
@@ -111,8 +116,14 @@ void CompressionCodecLightweight::doDecompressData(
         decompressDataForInteger<UInt64>(&source[1], source_size_no_header, dest, uncompressed_size);
         break;
     case CompressionDataType::Float32:
+        decompressDataForFloat<Float32>(&source[1], source_size_no_header, dest, uncompressed_size);
+        break;
     case CompressionDataType::Float64:
+        decompressDataForFloat<Float64>(&source[1], source_size_no_header, dest, uncompressed_size);
+        break;
     case CompressionDataType::String:
+        decompressDataForString(&source[1], source_size_no_header, dest, uncompressed_size);
+        break;
     case CompressionDataType::Unknown:
         decompressDataForNonInteger(&source[1], source_size_no_header, dest, uncompressed_size);
         break;
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <IO/Compression/EncodingUtil.h>
 #include <IO/Compression/ICompressionCodec.h>
 
 #include <span>
@@ -25,7 +26,9 @@ namespace DB
 /**
  * @brief Lightweight compression codec
  * For integer data, it supports constant, constant delta, run-length, frame of reference, delta frame of reference, and LZ4.
- * For non-integer data, it supports LZ4.
+ * For floating-point data, it supports constant, decimal frame of reference, XOR, and LZ4.
+ * For string data, it supports dictionary, FSST, and LZ4.
+ * For other data, it supports LZ4.
  * The codec selects the best mode for each block of data.
  *
  * Note that this codec instance contains `ctx` for choosing the best compression
@@ -42,6 +45,22 @@ public:
 
     bool isCompression() const override { return true; }
 
+    /// Return whether `source`, the compressed data of a block without the header of ICompressionCodec, is strings
+    /// encoded by the dictionary mode. If so, `dict` is set to the tokens and the indexes, which refer to `source`,
+    /// so the strings can be used without being joined, see `Compression::dictionaryDecodingToTokens`.
+    static bool tryDecodeStringDictionary(const char * source, UInt32 source_size, Compression::StringDictionary & dict);
+
+    /// Return whether `source`, the compressed data of a block without the header of ICompressionCodec, is integers
+    /// of `predicate.value_size` bytes encoded by the constant, run-length or FOR mode. If so, `predicate` is
+    /// evaluated on the encoded integers without decoding them, and the results of the `decompressed_size /
+    /// predicate.value_size` integers are written to `filter`, see `Compression::constantFilter` and so on.
+    static bool tryFilterInteger(
+        const char * source,
+        UInt32 source_size,
+        UInt32 decompressed_size,
+        const Compression::IntegerPredicate & predicate,
+        UInt8 * filter);
+
 protected:
     UInt32 doCompressData(const char * source, UInt32 source_size, char * dest) const override;
     void doDecompressData(const char * source, UInt32 source_size, char * dest, UInt32 uncompressed_size)
@@ -130,6 +149,108 @@ private:
     template <std::integral T>
     void decompressDataForInteger(const char * source, UInt32 source_size, char * dest, UInt32 output_size) const;
 
+    template <std::integral T>
+    static bool filterDataForInteger(
+        const char * source,
+        UInt32 source_size,
+        const Compression::IntegerPredicate & predicate,
+        UInt8 * filter,
+        UInt32 count);
+
+    /// Floating-point data
+
+    enum class FloatMode : UInt8
+    {
+        Invalid = 0,
+        Constant = 1, // all values are the same
+        DecimalFOR = 2, // values have a few fraction digits, scale them to integers and then FOR encoding
+        XOR = 3, // XOR with the previous value and store the meaningful bits, good for slowly changing values
+        LZ4 = 4, // the above modes are not suitable, use LZ4 instead
+    };
+
+    template <std::floating_point T>
+    using FloatConstantState = T;
+
+    template <std::floating_point T>
+    struct DecimalFORState
+    {
+        std::vector<typename Compression::DecimalEncodingTraits<T>::UIntType> scaled_values;
+        UInt8 exponent;
+        typename Compression::DecimalEncodingTraits<T>::UIntType min_value;
+        UInt8 bit_width;
+    };
+
+    template <std::floating_point T>
+    using FloatState = std::variant<FloatConstantState<T>, DecimalFORState<T>>;
+
+    class FloatCompressContext
+    {
+    public:
+        explicit FloatCompressContext(int round_count_)
+            : round_count(std::max(1, round_count_))
+        {}
+
+        template <std::floating_point T>
+        void analyze(std::span<const T> & values, FloatState<T> & state);
+
+        void update(size_t uncompressed_size, size_t compressed_size);
+
+        FloatMode mode = FloatMode::LZ4;
+
+    private:
+        // Every round_count blocks as a round. Like IntegerCompressContext, if LZ4 is used once in a round,
+        // do not analyze anymore in this round.
+        const int round_count;
+        int compress_count = 0;
+        bool used_lz4 = false;
+        bool used_decimal_for = false;
+    };
+
+    template <std::floating_point T>
+    size_t compressDataForFloat(const char * source, UInt32 source_size, char * dest) const;
+
+    template <std::floating_point T>
+    void decompressDataForFloat(const char * source, UInt32 source_size, char * dest, UInt32 output_size) const;
+
+    /// String data
+
+    enum class StringMode : UInt8
+    {
+        Invalid = 0,
+        Dictionary = 1, // the distinct strings and the index of each string, good for low-cardinality strings
+        FSST = 2, // replace the frequent substrings by 1-byte codes, good for high-cardinality strings
+        LZ4 = 3, // the above modes are not suitable, use LZ4 instead
+    };
+
+    using StringState = std::variant<Compression::StringDictionary, Compression::FSSTSymbolTable>;
+
+    class StringCompressContext
+    {
+    public:
+        explicit StringCompressContext(int round_count_)
+            : round_count(std::max(1, round_count_))
+        {}
+
+        void analyze(const char * source, UInt32 source_size, StringState & state);
+
+        void update(size_t uncompressed_size, size_t compressed_size);
+
+        StringMode mode = StringMode::LZ4;
+
+    private:
+        // Every round_count blocks as a round. Like IntegerCompressContext, if LZ4 is used once in a round,
+        // do not analyze anymore in this round. And the dictionary is only tried at the beginning of a round
+        // or if it is used in this round, since building it needs to hash all the strings.
+        const int round_count;
+        int compress_count = 0;
+        bool used_lz4 = false;
+        bool used_dictionary = false;
+    };
+
+    size_t compressDataForString(const char * source, UInt32 source_size, char * dest) const;
+
+    void decompressDataForString(const char * source, UInt32 source_size, char * dest, UInt32 output_size) const;
+
     /// Non-integer data
 
     static size_t compressDataForNonInteger(const char * source, UInt32 source_size, char * dest);
@@ -137,6 +258,8 @@ private:
 
 private:
     mutable IntegerCompressContext ctx;
+    mutable FloatCompressContext float_ctx;
+    mutable StringCompressContext string_ctx;
     const CompressionDataType data_type;
 };
 
@@ -348,6 +348,61 @@ void CompressionCodecLightweight::decompressDataForInteger(
     }
 }
 
+template <std::integral T>
+bool CompressionCodecLightweight::filterDataForInteger(
+    const char * source,
+    UInt32 source_size,
+    const Compression::IntegerPredicate & predicate,
+    UInt8 * filter,
+    UInt32 count)
+{
+    auto mode = static_cast<IntegerMode>(unalignedLoad<UInt8>(source));
+    source += sizeof(UInt8);
+    source_size -= sizeof(UInt8);
+    switch (mode)
+    {
+    case IntegerMode::Constant:
+        Compression::constantFilter<T>(source, source_size, predicate, filter, count);
+        return true;
+    case IntegerMode::RunLength:
+        Compression::runLengthFilter<T>(source, source_size, predicate, filter, count);
+        return true;
+    case IntegerMode::FOR:
+        Compression::FORFilter<T>(source, source_size, predicate, filter, count);
+        return true;
+    default:
+        // The other modes can not be evaluated without decoding.
+        return false;
+    }
+}
+
+bool CompressionCodecLightweight::tryFilterInteger(
+    const char * source,
+    UInt32 source_size,
+    UInt32 decompressed_size,
+    const Compression::IntegerPredicate & predicate,
+    UInt8 * filter)
+{
+    // [data type, mode, payload], see `doCompressData` and `compressDataForInteger`.
+    if (source_size < 2 || static_cast<UInt8>(source[0]) != predicate.value_size
+        || decompressed_size % predicate.value_size != 0)
+        return false;
+    const UInt32 count = decompressed_size / predicate.value_size;
+    switch (static_cast<CompressionDataType>(source[0]))
+    {
+    case CompressionDataType::Int8:
+        return filterDataForInteger<UInt8>(source + 1, source_size - 1, predicate, filter, count);
+    case CompressionDataType::Int16:
+        return filterDataForInteger<UInt16>(source + 1, source_size - 1, predicate, filter, count);
+    case CompressionDataType::Int32:
+        return filterDataForInteger<UInt32>(source + 1, source_size - 1, predicate, filter, count);
+    case CompressionDataType::Int64:
+        return filterDataForInteger<UInt64>(source + 1, source_size - 1, predicate, filter, count);
+    default:
+        return false;
+    }
+}
+
 template size_t CompressionCodecLightweight::compressDataForInteger<UInt8>(
     const char * source,
     UInt32 source_size,
@@ -13,10 +13,14 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/TiFlashMetrics.h>
 #include <IO/Compression/CompressionCodecLightweight.h>
 #include <IO/Compression/CompressionSettings.h>
+#include <IO/Compression/EncodingUtil.h>
 #include <lz4.h>
 
+#include <bit>
+
 namespace DB
 {
 
@@ -26,6 +30,250 @@ extern const int CANNOT_COMPRESS;
 extern const int CANNOT_DECOMPRESS;
 } // namespace ErrorCodes
 
+void CompressionCodecLightweight::FloatCompressContext::update(size_t uncompressed_size, size_t compressed_size)
+{
+    if (mode == FloatMode::LZ4)
+    {
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lz4_uncompressed_bytes).Increment(uncompressed_size);
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lz4_compressed_bytes).Increment(compressed_size);
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_lz4).Increment();
+        used_lz4 = true;
+    }
+    else
+    {
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lightweight_uncompressed_bytes)
+            .Increment(uncompressed_size);
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lightweight_compressed_bytes)
+            .Increment(compressed_size);
+    }
+    switch (mode)
+    {
+    case FloatMode::Constant:
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_constant).Increment();
+        break;
+    case FloatMode::DecimalFOR:
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_decimal_for).Increment();
+        used_decimal_for = true;
+        break;
+    case FloatMode::XOR:
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_xor).Increment();
+        break;
+    default:
+        break;
+    }
+    // Since analyze CONSTANT is extremely fast, so it will not be counted in the round.
+    if (mode != FloatMode::Constant)
+    {
+        ++compress_count;
+        if (compress_count >= round_count)
+        {
+            compress_count = 0;
+            used_lz4 = false;
+            used_decimal_for = false;
+        }
+    }
+}
+
+template <std::floating_point T>
+void CompressionCodecLightweight::FloatCompressContext::analyze(std::span<const T> & values, FloatState<T> & state)
+{
+    using IntType = typename Compression::DecimalEncodingTraits<T>::IntType;
+    using UIntType = typename Compression::DecimalEncodingTraits<T>::UIntType;
+
+    if (values.empty())
+    {
+        mode = FloatMode::Invalid;
+        return;
+    }
+
+    // Every round_count times as a round, analyze at the beginning of each round.
+    // During the round, if once used lz4, do not analyze anymore, and use lz4 directly.
+    if (compress_count != 0 && used_lz4)
+    {
+        mode = FloatMode::LZ4;
+        return;
+    }
+
+    // Check CONSTANT, compare the bits so that NaN and -0.0 are handled correctly.
+    const auto first_value = std::bit_cast<UIntType>(values[0]);
+    if (std::all_of(values.begin() + 1, values.end(), [&](T value) {
+            return std::bit_cast<UIntType>(value) == first_value;
+        }))
+    {
+        state = values[0];
+        mode = FloatMode::Constant;
+        return;
+    }
+
+    // DECIMAL_FOR
+    std::vector<UIntType> scaled_values;
+    UInt8 exponent = 0;
+    UIntType min_value = 0;
+    UInt8 decimal_for_width = sizeof(T) * 8;
+    size_t decimal_for_size = std::numeric_limits<size_t>::max();
+    if (compress_count == 0 || used_decimal_for)
+    {
+        scaled_values.resize(values.size());
+        // Signed and unsigned integers of the same size can alias each other.
+        auto * signed_values = reinterpret_cast<IntType *>(scaled_values.data());
+        if (Compression::decimalScaling<T>(values.data(), values.size(), signed_values, exponent))
+        {
+            auto [min_iter, max_iter] = std::minmax_element(signed_values, signed_values + values.size());
+            min_value = static_cast<UIntType>(*min_iter);
+            decimal_for_width
+                = BitpackingPrimitives::minimumBitWidth<UIntType>(static_cast<UIntType>(*max_iter) - min_value);
+            // exponent, min_value, 1 byte for width, and the rest for compressed data
+            static constexpr auto DECIMAL_FOR_EXTRA_BYTES = sizeof(UInt8) + sizeof(UIntType) + sizeof(UInt8);
+            decimal_for_size
+                = BitpackingPrimitives::getRequiredSize(values.size(), decimal_for_width) + DECIMAL_FOR_EXTRA_BYTES;
+        }
+    }
+
+    // XOR
+    size_t xor_size = Compression::XOREncodedSize<T>(values.data(), values.size());
+
+    // The low bits of floating-point values are nearly random, LZ4 can hardly compress them.
+    size_t estimate_lz_size = values.size() * sizeof(T);
+
+    if (decimal_for_size < xor_size && decimal_for_size < estimate_lz_size)
+    {
+        state = DecimalFORState<T>{std::move(scaled_values), exponent, min_value, decimal_for_width};
+        mode = FloatMode::DecimalFOR;
+    }
+    else if (xor_size < estimate_lz_size)
+    {
+        mode = FloatMode::XOR;
+    }
+    else
+    {
+        mode = FloatMode::LZ4;
+    }
+}
+
+template <std::floating_point T>
+size_t CompressionCodecLightweight::compressDataForFloat(const char * source, UInt32 source_size, char * dest) const
+{
+    using UIntType = typename Compression::DecimalEncodingTraits<T>::UIntType;
+    if unlikely (source_size % sizeof(T) != 0)
+        throw Exception(
+            ErrorCodes::CANNOT_COMPRESS,
+            "Cannot compress with lightweight-float codec, data size {} is not aligned to {}",
+            source_size,
+            sizeof(T));
+
+    // Load values
+    const size_t count = source_size / sizeof(T);
+    std::span<const T> values(reinterpret_cast<const T *>(source), count);
+
+    // Analyze
+    FloatState<T> state;
+    float_ctx.analyze<T>(values, state);
+
+    // Compress
+    unalignedStore<UInt8>(dest, static_cast<UInt8>(float_ctx.mode));
+    dest += sizeof(UInt8);
+    size_t compressed_size = 1;
+    switch (float_ctx.mode)
+    {
+    case FloatMode::Constant:
+    {
+        compressed_size += Compression::constantEncoding(std::bit_cast<UIntType>(std::get<0>(state)), dest);
+        break;
+    }
+    case FloatMode::DecimalFOR:
+    {
+        auto & decimal_for_state = std::get<1>(state);
+        compressed_size += Compression::decimalFOREncoding<T>(
+            decimal_for_state.scaled_values.data(),
+            decimal_for_state.scaled_values.size(),
+            decimal_for_state.exponent,
+            decimal_for_state.min_value,
+            decimal_for_state.bit_width,
+            dest);
+        break;
+    }
+    case FloatMode::XOR:
+    {
+        compressed_size += Compression::XOREncoding<T>(values.data(), values.size(), dest);
+        break;
+    }
+    case FloatMode::LZ4:
+    {
+        compressed_size += compressDataForNonInteger(source, source_size, dest);
+        break;
+    }
+    default:
+        throw Exception(
+            ErrorCodes::CANNOT_COMPRESS,
+            "Cannot compress with lightweight-float codec, unknown mode {}",
+            static_cast<int>(float_ctx.mode));
+    }
+
+    // Update statistics
+    float_ctx.update(source_size, compressed_size);
+
+    return compressed_size;
+}
+
+template <std::floating_point T>
+void CompressionCodecLightweight::decompressDataForFloat(
+    const char * source,
+    UInt32 source_size,
+    char * dest,
+    UInt32 output_size) const
+{
+    using UIntType = typename Compression::DecimalEncodingTraits<T>::UIntType;
+    if unlikely (output_size % sizeof(T) != 0)
+        throw Exception(
+            ErrorCodes::CANNOT_DECOMPRESS,
+            "Cannot decompress lightweight-float codec data. Uncompressed size {} is not aligned to {}",
+            output_size,
+            sizeof(T));
+
+    auto mode = static_cast<FloatMode>(unalignedLoad<UInt8>(source));
+    source += sizeof(UInt8);
+    source_size -= sizeof(UInt8);
+    switch (mode)
+    {
+    case FloatMode::Constant:
+        Compression::constantDecoding<UIntType>(source, source_size, dest, output_size);
+        break;
+    case FloatMode::DecimalFOR:
+        Compression::decimalFORDecoding<T>(source, source_size, dest, output_size);
+        break;
+    case FloatMode::XOR:
+        Compression::XORDecoding<T>(source, source_size, dest, output_size);
+        break;
+    case FloatMode::LZ4:
+        decompressDataForNonInteger(source, source_size, dest, output_size);
+        break;
+    default:
+        throw Exception(
+            ErrorCodes::CANNOT_DECOMPRESS,
+            "Cannot decompress with lightweight-float codec, unknown mode {}",
+            static_cast<int>(mode));
+    }
+}
+
+template size_t CompressionCodecLightweight::compressDataForFloat<Float32>(
+    const char * source,
+    UInt32 source_size,
+    char * dest) const;
+template size_t CompressionCodecLightweight::compressDataForFloat<Float64>(
+    const char * source,
+    UInt32 source_size,
+    char * dest) const;
+template void CompressionCodecLightweight::decompressDataForFloat<Float32>(
+    const char * source,
+    UInt32 source_size,
+    char * dest,
+    UInt32 output_size) const;
+template void CompressionCodecLightweight::decompressDataForFloat<Float64>(
+    const char * source,
+    UInt32 source_size,
+    char * dest,
+    UInt32 output_size) const;
+
 size_t CompressionCodecLightweight::compressDataForNonInteger(const char * source, UInt32 source_size, char * dest)
 {
     auto success = LZ4_compress_fast(
@@ -0,0 +1,241 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/TiFlashMetrics.h>
+#include <IO/Compression/CompressionCodecLightweight.h>
+#include <IO/Compression/CompressionSettings.h>
+#include <IO/Compression/EncodingUtil.h>
+#include <lz4.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+extern const int CANNOT_COMPRESS;
+extern const int CANNOT_DECOMPRESS;
+} // namespace ErrorCodes
+
+namespace
+{
+// Give up the dictionary if there are too many distinct strings.
+constexpr size_t MAX_DICTIONARY_SIZE = 65536;
+
+// The FSST symbol table and the sizes of FSST and LZ4 are estimated from a sample of the data.
+constexpr size_t SAMPLE_CHUNK_SIZE = 512;
+constexpr size_t SAMPLE_CHUNK_COUNT = 32;
+
+String sampleData(const char * source, UInt32 source_size)
+{
+    if (source_size <= SAMPLE_CHUNK_SIZE * SAMPLE_CHUNK_COUNT)
+        return String(source, source_size);
+    String sample;
+    sample.reserve(SAMPLE_CHUNK_SIZE * SAMPLE_CHUNK_COUNT);
+    const size_t step = source_size / SAMPLE_CHUNK_COUNT;
+    for (size_t i = 0; i < SAMPLE_CHUNK_COUNT; ++i)
+        sample.append(source + i * step, SAMPLE_CHUNK_SIZE);
+    return sample;
+}
+} // namespace
+
+void CompressionCodecLightweight::StringCompressContext::update(size_t uncompressed_size, size_t compressed_size)
+{
+    if (mode == StringMode::LZ4)
+    {
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lz4_uncompressed_bytes).Increment(uncompressed_size);
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lz4_compressed_bytes).Increment(compressed_size);
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_lz4).Increment();
+        used_lz4 = true;
+    }
+    else
+    {
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lightweight_uncompressed_bytes)
+            .Increment(uncompressed_size);
+        GET_METRIC(tiflash_storage_pack_compression_bytes, type_lightweight_compressed_bytes)
+            .Increment(compressed_size);
+    }
+    switch (mode)
+    {
+    case StringMode::Dictionary:
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_dictionary).Increment();
+        used_dictionary = true;
+        break;
+    case StringMode::FSST:
+        GET_METRIC(tiflash_storage_pack_compression_algorithm_count, type_fsst).Increment();
+        break;
+    default:
+        break;
+    }
+    ++compress_count;
+    if (compress_count >= round_count)
+    {
+        compress_count = 0;
+        used_lz4 = false;
+        used_dictionary = false;
+    }
+}
+
+void CompressionCodecLightweight::StringCompressContext::analyze(
+    const char * source,
+    UInt32 source_size,
+    StringState & state)
+{
+    if (source_size == 0)
+    {
+        mode = StringMode::Invalid;
+        return;
+    }
+
+    // Every round_count times as a round, analyze at the beginning of each round.
+    // During the round, if once used lz4, do not analyze anymore, and use lz4 directly.
+    if (compress_count != 0 && used_lz4)
+    {
+        mode = StringMode::LZ4;
+        return;
+    }
+
+    // DICTIONARY
+    Compression::StringDictionary dictionary;
+    size_t dictionary_size = std::numeric_limits<size_t>::max();
+    if ((compress_count == 0 || used_dictionary)
+        && Compression::buildStringDictionary(source, source_size, MAX_DICTIONARY_SIZE, dictionary))
+        dictionary_size = Compression::dictionaryEncodedSize(dictionary);
+
+    // FSST and LZ4
+    const auto sample = sampleData(source, source_size);
+    const double scale = static_cast<double>(source_size) / sample.size();
+    auto symbol_table = Compression::FSSTSymbolTable::build(sample.data(), sample.size());
+    const size_t fsst_size = symbol_table.serializedSize()
+        + static_cast<size_t>(symbol_table.encodedSize(sample.data(), sample.size()) * scale);
+    std::vector<char> lz4_buffer(LZ4_COMPRESSBOUND(sample.size()));
+    const auto lz4_sample_size = LZ4_compress_fast(
+        sample.data(),
+        lz4_buffer.data(),
+        sample.size(),
+        lz4_buffer.size(),
+        CompressionSetting::getDefaultLevel(CompressionMethod::LZ4));
+    if (unlikely(lz4_sample_size <= 0))
+        throw Exception("Cannot LZ4_compress_fast", ErrorCodes::CANNOT_COMPRESS);
+    const auto estimate_lz4_size = static_cast<size_t>(lz4_sample_size * scale);
+
+    if (dictionary_size < source_size && dictionary_size <= fsst_size && dictionary_size <= estimate_lz4_size)
+    {
+        state = std::move(dictionary);
+        mode = StringMode::Dictionary;
+    }
+    // Decoding FSST is several times faster than LZ4, so prefer it unless LZ4 is much smaller.
+    else if (fsst_size < source_size && fsst_size * 4 <= estimate_lz4_size * 5)
+    {
+        state = std::move(symbol_table);
+        mode = StringMode::FSST;
+    }
+    else
+    {
+        mode = StringMode::LZ4;
+    }
+}
+
+size_t CompressionCodecLightweight::compressDataForString(const char * source, UInt32 source_size, char * dest) const
+{
+    // Analyze
+    StringState state;
+    string_ctx.analyze(source, source_size, state);
+
+    // Compress
+    unalignedStore<UInt8>(dest, static_cast<UInt8>(string_ctx.mode));
+    dest += sizeof(UInt8);
+    size_t compressed_size = 1;
+    switch (string_ctx.mode)
+    {
+    case StringMode::Dictionary:
+    {
+        compressed_size += Compression::dictionaryEncoding(std::get<0>(state), dest);
+        break;
+    }
+    case StringMode::FSST:
+    {
+        // The size of FSST is estimated by a sample. If the encoded data is not smaller than the source, use LZ4.
+        auto fsst_size = std::get<1>(state).encode(source, source_size, dest, source_size);
+        if (fsst_size != 0)
+        {
+            compressed_size += fsst_size;
+            break;
+        }
+        string_ctx.mode = StringMode::LZ4;
+        unalignedStore<UInt8>(dest - sizeof(UInt8), static_cast<UInt8>(string_ctx.mode));
+        [[fallthrough]];
+    }
+    case StringMode::LZ4:
+    {
+        compressed_size += compressDataForNonInteger(source, source_size, dest);
+        break;
+    }
+    default:
+        throw Exception(
+            ErrorCodes::CANNOT_COMPRESS,
+            "Cannot compress with lightweight-string codec, unknown mode {}",
+            static_cast<int>(string_ctx.mode));
+    }
+
+    // Update statistics
+    string_ctx.update(source_size, compressed_size);
+
+    return compressed_size;
+}
+
+void CompressionCodecLightweight::decompressDataForString(
+    const char * source,
+    UInt32 source_size,
+    char * dest,
+    UInt32 output_size) const
+{
+    auto mode = static_cast<StringMode>(unalignedLoad<UInt8>(source));
+    source += sizeof(UInt8);
+    source_size -= sizeof(UInt8);
+    switch (mode)
+    {
+    case StringMode::Dictionary:
+        Compression::dictionaryDecoding(source, source_size, dest, output_size);
+        break;
+    case StringMode::FSST:
+        Compression::FSSTDecoding(source, source_size, dest, output_size);
+        break;
+    case StringMode::LZ4:
+        decompressDataForNonInteger(source, source_size, dest, output_size);
+        break;
+    default:
+        throw Exception(
+            ErrorCodes::CANNOT_DECOMPRESS,
+            "Cannot decompress with lightweight-string codec, unknown mode {}",
+            static_cast<int>(mode));
+    }
+}
+
+bool CompressionCodecLightweight::tryDecodeStringDictionary(
+    const char * source,
+    UInt32 source_size,
+    Compression::StringDictionary & dict)
+{
+    // [data type, mode, payload], see `doCompressData` and `compressDataForString`.
+    if (source_size < 2 || static_cast<UInt8>(source[0]) != magic_enum::enum_integer(CompressionDataType::String)
+        || static_cast<StringMode>(source[1]) != StringMode::Dictionary)
+        return false;
+    Compression::dictionaryDecodingToTokens(source + 2, source_size - 2, dict);
+    return true;
+}
+
+} // namespace DB
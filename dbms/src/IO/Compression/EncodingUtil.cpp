@@ -12,8 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/HashTable/HashMap.h>
 #include <IO/Compression/EncodingUtil.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+
 #if defined(__AVX2__)
 #include <immintrin.h>
 #endif
@@ -513,6 +521,179 @@ template void runLengthDecoding<UInt16>(const char *, UInt32, char *, UInt32);
 template void runLengthDecoding<UInt32>(const char *, UInt32, char *, UInt32);
 template void runLengthDecoding<UInt64>(const char *, UInt32, char *, UInt32);
 
+/// Predicate evaluation on the encoded integers
+
+namespace
+{
+template <IntegerPredicate::Op op, std::integral C>
+inline UInt8 compareWithConstant(C value, C constant)
+{
+    if constexpr (op == IntegerPredicate::Op::Equal)
+        return value == constant;
+    else if constexpr (op == IntegerPredicate::Op::NotEqual)
+        return value != constant;
+    else if constexpr (op == IntegerPredicate::Op::Less)
+        return value < constant;
+    else if constexpr (op == IntegerPredicate::Op::LessOrEqual)
+        return value <= constant;
+    else if constexpr (op == IntegerPredicate::Op::Greater)
+        return value > constant;
+    else
+        return value >= constant;
+}
+
+// Call `f.template operator()<op, C>()`, where `C` is `T` or the signed type of `T` according to `predicate`.
+template <std::integral T, typename F>
+void dispatchPredicate(const IntegerPredicate & predicate, F && f)
+{
+    auto dispatch_op = [&]<std::integral C>() {
+        switch (predicate.op)
+        {
+        case IntegerPredicate::Op::Equal:
+            return f.template operator()<IntegerPredicate::Op::Equal, C>();
+        case IntegerPredicate::Op::NotEqual:
+            return f.template operator()<IntegerPredicate::Op::NotEqual, C>();
+        case IntegerPredicate::Op::Less:
+            return f.template operator()<IntegerPredicate::Op::Less, C>();
+        case IntegerPredicate::Op::LessOrEqual:
+            return f.template operator()<IntegerPredicate::Op::LessOrEqual, C>();
+        case IntegerPredicate::Op::Greater:
+            return f.template operator()<IntegerPredicate::Op::Greater, C>();
+        case IntegerPredicate::Op::GreaterOrEqual:
+            return f.template operator()<IntegerPredicate::Op::GreaterOrEqual, C>();
+        }
+    };
+    if (predicate.is_signed)
+        dispatch_op.template operator()<std::make_signed_t<T>>();
+    else
+        dispatch_op.template operator()<T>();
+}
+} // namespace
+
+template <std::integral T>
+void constantFilter(
+    const char * src,
+    UInt32 source_size,
+    const IntegerPredicate & predicate,
+    UInt8 * filter,
+    UInt32 count)
+{
+    if (unlikely(source_size < sizeof(T)))
+        throw Exception(
+            ErrorCodes::CANNOT_DECOMPRESS,
+            "Cannot use Constant filter, data size {} is too small",
+            source_size);
+
+    const T value = unalignedLoad<T>(src);
+    dispatchPredicate<T>(predicate, [&]<IntegerPredicate::Op op, std::integral C>() {
+        memset(filter, compareWithConstant<op>(static_cast<C>(value), static_cast<C>(predicate.constant)), count);
+    });
+}
+
+template void constantFilter<UInt8>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void constantFilter<UInt16>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void constantFilter<UInt32>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void constantFilter<UInt64>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+
+template <std::integral T>
+void runLengthFilter(
+    const char * src,
+    UInt32 source_size,
+    const IntegerPredicate & predicate,
+    UInt8 * filter,
+    UInt32 count)
+{
+    if (unlikely(source_size % RunLengthPairLength<T> != 0))
+        throw Exception(
+            ErrorCodes::CANNOT_DECOMPRESS,
+            "Cannot use RunLength filter, data size {} is not aligned to {}",
+            source_size,
+            RunLengthPairLength<T>);
+
+    const auto pair_count = source_size / RunLengthPairLength<T>;
+    const char * count_src = src + pair_count * sizeof(T);
+    const UInt8 * filter_end = filter + count;
+    dispatchPredicate<T>(predicate, [&]<IntegerPredicate::Op op, std::integral C>() {
+        UInt8 * pos = filter;
+        for (UInt32 i = 0; i < pair_count; ++i)
+        {
+            const T value = unalignedLoad<T>(src + i * sizeof(T));
+            const auto run = unalignedLoad<UInt8>(count_src + i);
+            if (unlikely(pos + run > filter_end))
+                throw Exception(
+                    ErrorCodes::CANNOT_DECOMPRESS,
+                    "Cannot use RunLength filter, data is too large, count={} elem_byte={}",
+                    count,
+                    sizeof(T));
+            memset(pos, compareWithConstant<op>(static_cast<C>(value), static_cast<C>(predicate.constant)), run);
+            pos += run;
+        }
+    });
+}
+
+template void runLengthFilter<UInt8>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void runLengthFilter<UInt16>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void runLengthFilter<UInt32>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void runLengthFilter<UInt64>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+
+template <std::integral T>
+void FORFilter(const char * src, UInt32 source_size, const IntegerPredicate & predicate, UInt8 * filter, UInt32 count)
+{
+    if (unlikely(source_size < sizeof(T) + sizeof(UInt8)))
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot use FOR filter, data size {} is too small", source_size);
+
+    const T frame_of_reference = unalignedLoad<T>(src);
+    src += sizeof(T);
+    const auto width = unalignedLoad<UInt8>(src);
+    src += sizeof(UInt8);
+    const auto required_size = source_size - sizeof(T) - sizeof(UInt8);
+    RUNTIME_CHECK(BitpackingPrimitives::getRequiredSize(count, width) == required_size);
+
+    // The values are in [frame_of_reference, max_value], which does not overflow because they are encoded from T.
+    const T max_delta = width >= sizeof(T) * 8 ? std::numeric_limits<T>::max()
+                                               : static_cast<T>((static_cast<UInt64>(1) << width) - 1);
+    const T max_value
+        = frame_of_reference + std::min<T>(max_delta, std::numeric_limits<T>::max() - frame_of_reference);
+
+    dispatchPredicate<T>(predicate, [&]<IntegerPredicate::Op op, std::integral C>() {
+        const auto constant = static_cast<C>(predicate.constant);
+        const auto min_value_c = static_cast<C>(frame_of_reference);
+        const auto max_value_c = static_cast<C>(max_value);
+        // The range is not ordered if it crosses the sign bit when the values are compared as signed integers.
+        const bool is_ordered_range = min_value_c <= max_value_c;
+        // All the values are on the same side of the constant, so the predicate has the same result for them.
+        if (width == 0 || (is_ordered_range && (constant < min_value_c || constant > max_value_c)))
+        {
+            memset(filter, compareWithConstant<op>(min_value_c, constant), count);
+            return;
+        }
+
+        std::vector<T> deltas(BitpackingPrimitives::roundUpToAlgorithmGroupSize(count));
+        BitpackingPrimitives::unPackBuffer<T>(
+            reinterpret_cast<unsigned char *>(deltas.data()),
+            reinterpret_cast<const unsigned char *>(src),
+            count,
+            width);
+        if (is_ordered_range)
+        {
+            // `value op constant` is the same as `delta op (constant - frame_of_reference)` in the range.
+            const T shifted_constant = static_cast<T>(constant) - frame_of_reference;
+            for (UInt32 i = 0; i < count; ++i)
+                filter[i] = compareWithConstant<op>(deltas[i], shifted_constant);
+        }
+        else
+        {
+            for (UInt32 i = 0; i < count; ++i)
+                filter[i] = compareWithConstant<op>(static_cast<C>(frame_of_reference + deltas[i]), constant);
+        }
+    });
+}
+
+template void FORFilter<UInt8>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void FORFilter<UInt16>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void FORFilter<UInt32>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+template void FORFilter<UInt64>(const char *, UInt32, const IntegerPredicate &, UInt8 *, UInt32);
+
 /// ZigZag encoding
 
 template <std::integral T>
@@ -543,4 +724,766 @@ template void zigZagDecoding<UInt16>(const UInt16 *, UInt32, UInt16 *);
 template void zigZagDecoding<UInt32>(const UInt32 *, UInt32, UInt32 *);
 template void zigZagDecoding<UInt64>(const UInt64 *, UInt32, UInt64 *);
 
+/// Decimal + Frame of Reference encoding
+
+namespace
+{
+template <std::floating_point T>
+constexpr auto makePowersOf10()
+{
+    std::array<T, DecimalEncodingTraits<T>::max_exponent + 1> powers{};
+    T power = 1;
+    for (auto & p : powers)
+    {
+        p = power;
+        power *= 10;
+    }
+    return powers;
+}
+
+// 10^exponent can be represented exactly, so the division is correctly rounded.
+template <std::floating_point T>
+constexpr auto POWERS_OF_10 = makePowersOf10<T>();
+
+template <std::floating_point T>
+inline bool tryScale(T value, UInt8 exponent, typename DecimalEncodingTraits<T>::IntType & scaled)
+{
+    using Traits = DecimalEncodingTraits<T>;
+    T scaled_value = value * POWERS_OF_10<T>[exponent];
+    // It is also false for NaN.
+    if (!(std::fabs(scaled_value) <= static_cast<T>(Traits::max_abs_value)))
+        return false;
+    scaled = static_cast<typename Traits::IntType>(std::nearbyint(scaled_value));
+    // Must be the same as the decoding. Comparing the bits to reject -0.0.
+    T decoded = static_cast<T>(scaled) / POWERS_OF_10<T>[exponent];
+    return std::bit_cast<typename Traits::UIntType>(decoded) == std::bit_cast<typename Traits::UIntType>(value);
+}
+
+// Convert the scaled integers stored in `data` to floating-point values in place.
+template <std::floating_point T>
+void scaledIntegersToFloat(char * data, UInt32 count, UInt8 exponent)
+{
+    using IntType = typename DecimalEncodingTraits<T>::IntType;
+    const T divisor = POWERS_OF_10<T>[exponent];
+    UInt32 i = 0;
+#if defined(__AVX2__)
+    if constexpr (std::is_same_v<T, Float32>)
+    {
+        const __m256 divisors = _mm256_set1_ps(divisor);
+        for (; i + 8 <= count; i += 8)
+        {
+            auto * p = data + i * sizeof(T);
+            __m256 values = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+            _mm256_storeu_ps(reinterpret_cast<float *>(p), _mm256_div_ps(values, divisors));
+        }
+    }
+    else
+    {
+        // The absolute values are less than 2^51, so adding them to the bits of 2^52 + 2^51 only changes the
+        // mantissa, and then subtracting 2^52 + 2^51 gets the values as double exactly.
+        const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+        const __m256d divisors = _mm256_set1_pd(divisor);
+        for (; i + 4 <= count; i += 4)
+        {
+            auto * p = data + i * sizeof(T);
+            __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            bits = _mm256_add_epi64(bits, _mm256_castpd_si256(magic));
+            __m256d values = _mm256_sub_pd(_mm256_castsi256_pd(bits), magic);
+            _mm256_storeu_pd(reinterpret_cast<double *>(p), _mm256_div_pd(values, divisors));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        auto * p = data + i * sizeof(T);
+        unalignedStore<T>(p, static_cast<T>(unalignedLoad<IntType>(p)) / divisor);
+    }
+}
+} // namespace
+
+template <std::floating_point T>
+bool decimalScaling(
+    const T * values,
+    UInt32 count,
+    typename DecimalEncodingTraits<T>::IntType * scaled_values,
+    UInt8 & exponent)
+{
+    // If a value can be scaled by some exponent, it can also be scaled by a larger one unless the scaled value is
+    // out of range. So increase the exponent until all values can be scaled.
+    UInt8 e = 0;
+    UInt32 rescale_end = 0;
+    for (UInt32 i = 0; i < count; ++i)
+    {
+        while (!tryScale(values[i], e, scaled_values[i]))
+        {
+            if (++e > DecimalEncodingTraits<T>::max_exponent)
+                return false;
+            rescale_end = i;
+        }
+    }
+    // The values before the exponent is increased last time must be scaled again.
+    for (UInt32 i = 0; i < rescale_end; ++i)
+    {
+        if (!tryScale(values[i], e, scaled_values[i]))
+            return false;
+    }
+    exponent = e;
+    return true;
+}
+
+template bool decimalScaling<Float32>(const Float32 *, UInt32, Int32 *, UInt8 &);
+template bool decimalScaling<Float64>(const Float64 *, UInt32, Int64 *, UInt8 &);
+
+template <std::floating_point T>
+void decimalFORDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size)
+{
+    using Traits = DecimalEncodingTraits<T>;
+    if unlikely (source_size < sizeof(UInt8))
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "decimal FOR encoded data is too short: {}", source_size);
+    auto exponent = unalignedLoad<UInt8>(src);
+    if unlikely (exponent > Traits::max_exponent)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid exponent {} of decimal FOR encoding", exponent);
+    FORDecoding<typename Traits::UIntType>(src + sizeof(UInt8), source_size - sizeof(UInt8), dest, dest_size);
+    scaledIntegersToFloat<T>(dest, dest_size / sizeof(T), exponent);
+}
+
+template void decimalFORDecoding<Float32>(const char *, UInt32, char *, UInt32);
+template void decimalFORDecoding<Float64>(const char *, UInt32, char *, UInt32);
+
+/// XOR encoding
+
+namespace
+{
+// The bits are written from the lowest bit of each byte.
+class BitWriter
+{
+public:
+    explicit BitWriter(char * dest_)
+        : begin(dest_)
+        , dest(dest_)
+    {}
+
+    // Write the lowest `bits` bits of `value`, the other bits of `value` must be 0.
+    void write(UInt64 value, UInt8 bits)
+    {
+        assert(bits == 64 || (value >> bits) == 0);
+        buffer |= value << filled;
+        if (filled + bits >= 64)
+        {
+            unalignedStore<UInt64>(dest, buffer);
+            dest += sizeof(UInt64);
+            UInt8 written = 64 - filled;
+            buffer = written == 64 ? 0 : value >> written;
+            filled = filled + bits - 64;
+        }
+        else
+        {
+            filled += bits;
+        }
+    }
+
+    // Return the written bytes.
+    size_t flush()
+    {
+        size_t bytes = (filled + 7) / 8;
+        memcpy(dest, &buffer, bytes);
+        return dest - begin + bytes;
+    }
+
+private:
+    char * const begin;
+    char * dest;
+    UInt64 buffer = 0;
+    UInt8 filled = 0;
+};
+
+class BitReader
+{
+public:
+    BitReader(const char * src_, size_t size_)
+        : src(src_)
+        , size(size_)
+    {}
+
+    UInt64 read(UInt8 bits)
+    {
+        if (bits <= 32)
+            return readSmall(bits);
+        UInt64 low = readSmall(32);
+        return low | (readSmall(bits - 32) << 32);
+    }
+
+private:
+    UInt64 readSmall(UInt8 bits)
+    {
+        assert(bits <= 32);
+        if unlikely (pos + bits > size * 8)
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "XOR encoded data is too short: {}", size);
+        size_t byte_pos = pos / 8;
+        UInt64 word = 0;
+        memcpy(&word, src + byte_pos, std::min(sizeof(UInt64), size - byte_pos));
+        pos += bits;
+        return (word >> (pos - bits - byte_pos * 8)) & ((1ULL << bits) - 1);
+    }
+
+    const char * src;
+    size_t size;
+    size_t pos = 0;
+};
+
+template <std::floating_point T>
+struct XOREncodingTraits
+{
+    using UIntType = typename DecimalEncodingTraits<T>::UIntType;
+    static constexpr UInt8 value_bits = sizeof(T) * 8;
+    // The number of bits to store the count of leading zeros and the count of meaningful bits.
+    static constexpr UInt8 leading_zeros_bits = sizeof(T) == 8 ? 5 : 4;
+    static constexpr UInt8 max_leading_zeros = (1 << leading_zeros_bits) - 1;
+    static constexpr UInt8 meaningful_bits_bits = sizeof(T) == 8 ? 6 : 5;
+};
+
+// Call `write(value, bits)` for each field of the XOR encoded data.
+template <std::floating_point T, typename Writer>
+void XOREncodingImpl(const T * source, UInt32 count, Writer && write)
+{
+    using Traits = XOREncodingTraits<T>;
+    using TU = typename Traits::UIntType;
+    if unlikely (count == 0)
+        return;
+    TU prev = std::bit_cast<TU>(source[0]);
+    write(prev, Traits::value_bits);
+    // The window of the meaningful bits of the previous XORed value, which can be reused by the following ones.
+    bool has_window = false;
+    UInt8 prev_leading_zeros = 0;
+    UInt8 prev_trailing_zeros = 0;
+    for (UInt32 i = 1; i < count; ++i)
+    {
+        TU value = std::bit_cast<TU>(source[i]);
+        TU xored = value ^ prev;
+        prev = value;
+        if (xored == 0)
+        {
+            write(0, 1);
+            continue;
+        }
+        UInt8 leading_zeros = std::min<UInt8>(std::countl_zero(xored), Traits::max_leading_zeros);
+        UInt8 trailing_zeros = std::countr_zero(xored);
+        if (has_window && leading_zeros >= prev_leading_zeros && trailing_zeros >= prev_trailing_zeros)
+        {
+            // '1', '0', meaningful bits in the previous window
+            write(1, 1);
+            write(0, 1);
+            write(xored >> prev_trailing_zeros, Traits::value_bits - prev_leading_zeros - prev_trailing_zeros);
+        }
+        else
+        {
+            // '1', '1', leading zeros, meaningful bits count - 1, meaningful bits
+            UInt8 meaningful_bits = Traits::value_bits - leading_zeros - trailing_zeros;
+            write(1, 1);
+            write(1, 1);
+            write(leading_zeros, Traits::leading_zeros_bits);
+            write(meaningful_bits - 1, Traits::meaningful_bits_bits);
+            write(xored >> trailing_zeros, meaningful_bits);
+            has_window = true;
+            prev_leading_zeros = leading_zeros;
+            prev_trailing_zeros = trailing_zeros;
+        }
+    }
+}
+} // namespace
+
+template <std::floating_point T>
+size_t XOREncodedSize(const T * source, UInt32 count)
+{
+    size_t bits = 0;
+    XOREncodingImpl(source, count, [&](UInt64, UInt8 n) { bits += n; });
+    return (bits + 7) / 8;
+}
+
+template size_t XOREncodedSize<Float32>(const Float32 *, UInt32);
+template size_t XOREncodedSize<Float64>(const Float64 *, UInt32);
+
+template <std::floating_point T>
+size_t XOREncoding(const T * source, UInt32 count, char * dest)
+{
+    BitWriter writer(dest);
+    XOREncodingImpl(source, count, [&](UInt64 value, UInt8 n) { writer.write(value, n); });
+    return writer.flush();
+}
+
+template size_t XOREncoding<Float32>(const Float32 *, UInt32, char *);
+template size_t XOREncoding<Float64>(const Float64 *, UInt32, char *);
+
+template <std::floating_point T>
+void XORDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size)
+{
+    using Traits = XOREncodingTraits<T>;
+    using TU = typename Traits::UIntType;
+    if unlikely (dest_size % sizeof(T) != 0)
+        throw Exception(
+            ErrorCodes::CANNOT_DECOMPRESS,
+            "uncompressed size {} is not aligned to {}",
+            dest_size,
+            sizeof(T));
+    const UInt32 count = dest_size / sizeof(T);
+    if unlikely (count == 0)
+        return;
+
+    BitReader reader(src, source_size);
+    TU value = reader.read(Traits::value_bits);
+    unalignedStore<TU>(dest, value);
+    bool has_window = false;
+    UInt8 leading_zeros = 0;
+    UInt8 trailing_zeros = 0;
+    for (UInt32 i = 1; i < count; ++i)
+    {
+        if (reader.read(1) != 0)
+        {
+            if (reader.read(1) != 0)
+            {
+                leading_zeros = reader.read(Traits::leading_zeros_bits);
+                UInt8 meaningful_bits = reader.read(Traits::meaningful_bits_bits) + 1;
+                if unlikely (leading_zeros + meaningful_bits > Traits::value_bits)
+                    throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid XOR encoded data");
+                trailing_zeros = Traits::value_bits - leading_zeros - meaningful_bits;
+                has_window = true;
+            }
+            else if unlikely (!has_window)
+            {
+                throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid XOR encoded data");
+            }
+            value ^= static_cast<TU>(reader.read(Traits::value_bits - leading_zeros - trailing_zeros))
+                << trailing_zeros;
+        }
+        unalignedStore<TU>(dest + i * sizeof(T), value);
+    }
+}
+
+template void XORDecoding<Float32>(const char *, UInt32, char *, UInt32);
+template void XORDecoding<Float64>(const char *, UInt32, char *, UInt32);
+
+/// Dictionary encoding
+
+namespace
+{
+struct DictionaryEncodingWidths
+{
+    UInt32 min_token_size;
+    UInt8 token_size_width;
+    UInt8 index_width;
+};
+
+DictionaryEncodingWidths getDictionaryEncodingWidths(const StringDictionary & dict)
+{
+    auto [min_iter, max_iter] = std::minmax_element(
+        dict.tokens.begin(),
+        dict.tokens.end(),
+        [](const StringRef & lhs, const StringRef & rhs) { return lhs.size < rhs.size; });
+    const auto min_token_size = static_cast<UInt32>(min_iter->size);
+    return {
+        .min_token_size = min_token_size,
+        .token_size_width
+        = BitpackingPrimitives::minimumBitWidth<UInt32>(static_cast<UInt32>(max_iter->size) - min_token_size),
+        .index_width = BitpackingPrimitives::minimumBitWidth<UInt32>(dict.tokens.size() - 1),
+    };
+}
+
+// Decode the values encoded by FOREncoding<UInt32>, and move `src` to the end of them.
+std::vector<UInt32> FORDecodingUInt32(const char *& src, const char * src_end, UInt32 count)
+{
+    if unlikely (static_cast<size_t>(src_end - src) < sizeof(UInt32) + sizeof(UInt8))
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+    const auto frame_of_reference = unalignedLoad<UInt32>(src);
+    src += sizeof(UInt32);
+    const auto width = unalignedLoad<UInt8>(src);
+    src += sizeof(UInt8);
+    const auto required_size = BitpackingPrimitives::getRequiredSize(count, width);
+    if unlikely (width > sizeof(UInt32) * 8 || static_cast<size_t>(src_end - src) < required_size)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+    // unPackBuffer writes the values by groups, so the buffer is rounded up to the group size.
+    std::vector<UInt32> values(BitpackingPrimitives::roundUpToAlgorithmGroupSize(count));
+    BitpackingPrimitives::unPackBuffer<UInt32>(
+        reinterpret_cast<unsigned char *>(values.data()),
+        reinterpret_cast<const unsigned char *>(src),
+        count,
+        width);
+    applyFrameOfReference(values.data(), frame_of_reference, count);
+    values.resize(count);
+    src += required_size;
+    return values;
+}
+} // namespace
+
+bool buildStringDictionary(const char * source, UInt32 source_size, size_t max_distinct_count, StringDictionary & dict)
+{
+    dict.tokens.clear();
+    dict.tokens_bytes = 0;
+    dict.indexes.clear();
+
+    HashMapWithSavedHash<StringRef, UInt32, StringRefHash> token_to_index;
+    const char * pos = source;
+    const char * end = source + source_size;
+    while (true)
+    {
+        const auto * token_end = static_cast<const char *>(memchr(pos, '\0', end - pos));
+        if (token_end == nullptr)
+            token_end = end;
+        StringRef token(pos, token_end - pos);
+        decltype(token_to_index)::LookupResult it;
+        bool inserted;
+        token_to_index.emplace(token, it, inserted);
+        if (inserted)
+        {
+            if (dict.tokens.size() >= max_distinct_count)
+                return false;
+            it->getMapped() = dict.tokens.size();
+            dict.tokens.push_back(token);
+            dict.tokens_bytes += token.size;
+        }
+        dict.indexes.push_back(it->getMapped());
+        // The data ends with '\0' in most cases, then the last token is empty.
+        if (token_end == end)
+            break;
+        pos = token_end + 1;
+    }
+    return true;
+}
+
+size_t dictionaryEncodedSize(const StringDictionary & dict)
+{
+    const auto widths = getDictionaryEncodingWidths(dict);
+    static constexpr auto FOR_EXTRA_BYTES = sizeof(UInt32) + sizeof(UInt8);
+    return sizeof(UInt32) * 2 + FOR_EXTRA_BYTES
+        + BitpackingPrimitives::getRequiredSize(dict.tokens.size(), widths.token_size_width) + dict.tokens_bytes
+        + FOR_EXTRA_BYTES + BitpackingPrimitives::getRequiredSize(dict.indexes.size(), widths.index_width);
+}
+
+size_t dictionaryEncoding(StringDictionary & dict, char * dest)
+{
+    assert(!dict.tokens.empty() && !dict.indexes.empty());
+
+    const auto widths = getDictionaryEncodingWidths(dict);
+    char * start = dest;
+    unalignedStore<UInt32>(dest, dict.tokens.size());
+    dest += sizeof(UInt32);
+    unalignedStore<UInt32>(dest, dict.indexes.size());
+    dest += sizeof(UInt32);
+    std::vector<UInt32> token_sizes(dict.tokens.size());
+    for (size_t i = 0; i < dict.tokens.size(); ++i)
+        token_sizes[i] = dict.tokens[i].size;
+    dest += FOREncoding<UInt32>(
+        token_sizes.data(),
+        token_sizes.size(),
+        widths.min_token_size,
+        widths.token_size_width,
+        dest);
+    for (const auto & token : dict.tokens)
+    {
+        memcpy(dest, token.data, token.size);
+        dest += token.size;
+    }
+    dest += FOREncoding<UInt32>(dict.indexes.data(), dict.indexes.size(), 0, widths.index_width, dest);
+    return dest - start;
+}
+
+void dictionaryDecodingToTokens(const char * src, UInt32 source_size, StringDictionary & dict)
+{
+    const char * src_end = src + source_size;
+    if unlikely (source_size < sizeof(UInt32) * 2)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+    const auto distinct_count = unalignedLoad<UInt32>(src);
+    src += sizeof(UInt32);
+    const auto token_count = unalignedLoad<UInt32>(src);
+    src += sizeof(UInt32);
+    if unlikely (distinct_count == 0 || distinct_count > token_count)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+
+    const auto token_sizes = FORDecodingUInt32(src, src_end, distinct_count);
+    dict.tokens.resize(distinct_count);
+    dict.tokens_bytes = 0;
+    for (size_t i = 0; i < distinct_count; ++i)
+    {
+        dict.tokens[i] = StringRef(src + dict.tokens_bytes, token_sizes[i]);
+        dict.tokens_bytes += token_sizes[i];
+    }
+    if unlikely (static_cast<size_t>(src_end - src) < dict.tokens_bytes)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+    src += dict.tokens_bytes;
+
+    dict.indexes = FORDecodingUInt32(src, src_end, token_count);
+    if unlikely (src != src_end)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+    for (const auto index : dict.indexes)
+    {
+        if unlikely (index >= distinct_count)
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+    }
+}
+
+void dictionaryDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size)
+{
+    StringDictionary dict;
+    dictionaryDecodingToTokens(src, source_size, dict);
+    // Every token except the last one is followed by a '\0'.
+    if unlikely (dict.indexes.size() - 1 > dest_size)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+
+    // Copy the tokens to a padded buffer, so that the short tokens can be copied by fixed-size loads and stores.
+    static constexpr size_t SHORT_TOKEN_SIZE = 16;
+    std::vector<char> tokens(dict.tokens_bytes + SHORT_TOKEN_SIZE);
+    std::vector<size_t> token_offsets(dict.tokens.size());
+    if (!dict.tokens.empty())
+        memcpy(tokens.data(), dict.tokens[0].data, dict.tokens_bytes);
+    for (size_t i = 1; i < dict.tokens.size(); ++i)
+        token_offsets[i] = token_offsets[i - 1] + dict.tokens[i - 1].size;
+
+    char * out = dest;
+    char * dest_end = dest + dest_size;
+    const size_t token_count = dict.indexes.size();
+    for (size_t i = 0; i < token_count; ++i)
+    {
+        const auto index = dict.indexes[i];
+        const size_t size = dict.tokens[index].size;
+        const char * token = tokens.data() + token_offsets[index];
+        if (likely(size <= SHORT_TOKEN_SIZE && static_cast<size_t>(dest_end - out) >= SHORT_TOKEN_SIZE))
+            memcpy(out, token, SHORT_TOKEN_SIZE);
+        else if (likely(static_cast<size_t>(dest_end - out) >= size))
+            memcpy(out, token, size);
+        else
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+        out += size;
+        if (i + 1 < token_count)
+        {
+            if unlikely (out == dest_end)
+                throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+            *out++ = '\0';
+        }
+    }
+    if unlikely (out != dest_end)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid dictionary encoded data");
+}
+
+/// FSST encoding
+
+namespace
+{
+// The symbol table usually converges after 5 rounds, the length of the symbols doubles in each round.
+constexpr size_t FSST_BUILD_ROUNDS = 5;
+
+// Load at most 8 bytes, padded by zeros.
+UInt64 loadSymbolBytes(const char * pos, size_t size)
+{
+    if (size >= sizeof(UInt64))
+        return unalignedLoad<UInt64>(pos);
+    UInt64 value = 0;
+    memcpy(&value, pos, size);
+    return value;
+}
+
+UInt64 symbolMask(size_t length)
+{
+    return length >= sizeof(UInt64) ? ~0ULL : (1ULL << (length * 8)) - 1;
+}
+} // namespace
+
+void FSSTSymbolTable::addSymbol(UInt64 symbol, UInt8 length)
+{
+    assert(symbol_count < max_symbol_count && length > 0 && length <= max_symbol_length);
+    symbols[symbol_count] = symbol & symbolMask(length);
+    lengths[symbol_count] = length;
+    codes_by_first_byte[symbol & 0xFF].push_back(symbol_count);
+    symbols_bytes += length;
+    ++symbol_count;
+}
+
+UInt8 FSSTSymbolTable::findLongestSymbol(const char * pos, const char * end) const
+{
+    const size_t remaining = end - pos;
+    const UInt64 word = loadSymbolBytes(pos, remaining);
+    for (auto code : codes_by_first_byte[static_cast<UInt8>(*pos)])
+    {
+        const auto length = lengths[code];
+        if (length <= remaining && ((word ^ symbols[code]) & symbolMask(length)) == 0)
+            return code;
+    }
+    return escape_code;
+}
+
+template <typename F>
+void FSSTSymbolTable::encodeImpl(const char * source, size_t source_size, F && write_code) const
+{
+    const char * pos = source;
+    const char * end = source + source_size;
+    while (pos < end)
+    {
+        const auto code = findLongestSymbol(pos, end);
+        write_code(code, pos);
+        pos += code == escape_code ? 1 : lengths[code];
+    }
+}
+
+FSSTSymbolTable FSSTSymbolTable::build(const char * sample, size_t sample_size)
+{
+    // The escaped bytes are counted as the pseudo codes 256 + byte.
+    static constexpr UInt32 PSEUDO_CODE_COUNT = 512;
+    static constexpr UInt32 PSEUDO_CODE_BITS = 9;
+
+    FSSTSymbolTable table;
+    for (size_t round = 0; round < FSST_BUILD_ROUNDS; ++round)
+    {
+        std::vector<UInt64> single_counts(PSEUDO_CODE_COUNT);
+        std::unordered_map<UInt32, UInt64> pair_counts;
+        Int64 prev_code = -1;
+        table.encodeImpl(sample, sample_size, [&](UInt8 code, const char * pos) {
+            const UInt32 pseudo_code = code == escape_code ? 256 + static_cast<UInt8>(*pos) : code;
+            ++single_counts[pseudo_code];
+            if (prev_code >= 0)
+                ++pair_counts[(static_cast<UInt32>(prev_code) << PSEUDO_CODE_BITS) | pseudo_code];
+            prev_code = pseudo_code;
+        });
+
+        auto get_symbol = [&](UInt32 pseudo_code) -> std::pair<UInt64, UInt8> {
+            if (pseudo_code >= 256)
+                return {pseudo_code - 256, 1};
+            return {table.symbols[pseudo_code], table.lengths[pseudo_code]};
+        };
+        // The gain of a candidate is the number of bytes it covers.
+        std::map<std::pair<UInt64, UInt8>, UInt64> candidates;
+        for (UInt32 pseudo_code = 0; pseudo_code < PSEUDO_CODE_COUNT; ++pseudo_code)
+        {
+            if (single_counts[pseudo_code] == 0)
+                continue;
+            const auto symbol = get_symbol(pseudo_code);
+            candidates[symbol] += single_counts[pseudo_code] * symbol.second;
+        }
+        for (const auto & [pair, count] : pair_counts)
+        {
+            const auto [first_symbol, first_length] = get_symbol(pair >> PSEUDO_CODE_BITS);
+            if (first_length == max_symbol_length)
+                continue;
+            const auto [second_symbol, second_length] = get_symbol(pair & (PSEUDO_CODE_COUNT - 1));
+            const auto length = static_cast<UInt8>(std::min<size_t>(first_length + second_length, max_symbol_length));
+            const UInt64 symbol = (first_symbol | (second_symbol << (first_length * 8))) & symbolMask(length);
+            candidates[{symbol, length}] += count * length;
+        }
+
+        std::vector<std::pair<UInt64, std::pair<UInt64, UInt8>>> sorted_candidates;
+        sorted_candidates.reserve(candidates.size());
+        for (const auto & [symbol, gain] : candidates)
+            sorted_candidates.emplace_back(gain, symbol);
+        const auto selected_count = std::min(sorted_candidates.size(), max_symbol_count);
+        std::partial_sort(
+            sorted_candidates.begin(),
+            sorted_candidates.begin() + selected_count,
+            sorted_candidates.end(),
+            std::greater<>());
+
+        table = FSSTSymbolTable{};
+        for (size_t i = 0; i < selected_count; ++i)
+            table.addSymbol(sorted_candidates[i].second.first, sorted_candidates[i].second.second);
+        for (auto & codes : table.codes_by_first_byte)
+            std::stable_sort(codes.begin(), codes.end(), [&](UInt8 lhs, UInt8 rhs) {
+                return table.lengths[lhs] > table.lengths[rhs];
+            });
+    }
+    return table;
+}
+
+size_t FSSTSymbolTable::encodedSize(const char * source, size_t source_size) const
+{
+    size_t size = 0;
+    encodeImpl(source, source_size, [&](UInt8 code, const char *) { size += code == escape_code ? 2 : 1; });
+    return size;
+}
+
+size_t FSSTSymbolTable::encode(const char * source, UInt32 source_size, char * dest, size_t dest_capacity) const
+{
+    if (dest_capacity < serializedSize())
+        return 0;
+    char * start = dest;
+    char * dest_end = dest + dest_capacity;
+    unalignedStore<UInt8>(dest, symbol_count);
+    dest += sizeof(UInt8);
+    memcpy(dest, lengths.data(), symbol_count);
+    dest += symbol_count;
+    for (size_t code = 0; code < symbol_count; ++code)
+    {
+        memcpy(dest, &symbols[code], lengths[code]);
+        dest += lengths[code];
+    }
+
+    const char * pos = source;
+    const char * end = source + source_size;
+    while (pos < end)
+    {
+        if unlikely (dest_end - dest < 2)
+            return 0;
+        const auto code = findLongestSymbol(pos, end);
+        *dest++ = static_cast<char>(code);
+        if (code == escape_code)
+        {
+            *dest++ = *pos;
+            pos += 1;
+        }
+        else
+        {
+            pos += lengths[code];
+        }
+    }
+    return dest - start;
+}
+
+void FSSTDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size)
+{
+    const char * src_end = src + source_size;
+    if unlikely (source_size < sizeof(UInt8))
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid FSST encoded data");
+    const size_t symbol_count = unalignedLoad<UInt8>(src);
+    src += sizeof(UInt8);
+    if unlikely (symbol_count > FSSTSymbolTable::max_symbol_count || static_cast<size_t>(src_end - src) < symbol_count)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid FSST encoded data");
+    std::array<UInt8, FSSTSymbolTable::max_symbol_count> lengths{};
+    std::array<UInt64, FSSTSymbolTable::max_symbol_count> symbols{};
+    memcpy(lengths.data(), src, symbol_count);
+    src += symbol_count;
+    for (size_t code = 0; code < symbol_count; ++code)
+    {
+        const size_t length = lengths[code];
+        if unlikely (
+            length == 0 || length > FSSTSymbolTable::max_symbol_length || static_cast<size_t>(src_end - src) < length)
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid FSST encoded data");
+        memcpy(&symbols[code], src, length);
+        src += length;
+    }
+
+    char * out = dest;
+    char * dest_end = dest + dest_size;
+    while (src < src_end)
+    {
+        const auto code = static_cast<UInt8>(*src++);
+        if (likely(code < symbol_count))
+        {
+            const size_t length = lengths[code];
+            // Store all the 8 bytes of the symbol, the extra bytes will be overwritten by the following symbols.
+            if (likely(static_cast<size_t>(dest_end - out) >= sizeof(UInt64)))
+                unalignedStore<UInt64>(out, symbols[code]);
+            else if (static_cast<size_t>(dest_end - out) >= length)
+                memcpy(out, &symbols[code], length);
+            else
+                throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid FSST encoded data");
+            out += length;
+        }
+        else if (code == FSSTSymbolTable::escape_code && src < src_end && out < dest_end)
+        {
+            *out++ = *src++;
+        }
+        else
+        {
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid FSST encoded data");
+        }
+    }
+    if unlikely (out != dest_end)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "invalid FSST encoded data");
+}
+
 } // namespace DB::Compression
@@ -16,9 +16,11 @@
 
 #include <Common/BitpackingPrimitives.h>
 #include <Common/Exception.h>
+#include <common/StringRef.h>
 #include <common/types.h>
 #include <common/unaligned.h>
 
+#include <array>
 #include <cstring>
 #include <vector>
 
@@ -148,6 +150,55 @@ void FORDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_
     applyFrameOfReference(reinterpret_cast<T *>(dest), frame_of_reference, count);
 }
 
+/// Predicate evaluation on the encoded integers
+
+// A comparison `value op constant`, which is evaluated on the encoded integers without decoding them.
+struct IntegerPredicate
+{
+    enum class Op : UInt8
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual,
+    };
+
+    Op op;
+    // Whether the integers are compared as signed integers.
+    bool is_signed;
+    // The number of bytes of the integers, the same as the `CompressionDataType` of them.
+    UInt8 value_size;
+    // The constant, only the lower `value_size` bytes of it are compared with the integers.
+    UInt64 constant;
+};
+
+// Set `filter[i]` to 1 if the i-th of the `count` integers satisfies `predicate`, otherwise 0.
+// The integers are encoded by `constantEncoding`, `runLengthEncoding` and `FOREncoding` respectively.
+// For the run-length encoding, the predicate is evaluated once per run. For the FOR encoding, the
+// predicate is evaluated on the packed values against the constant shifted by the frame of reference,
+// and the whole block is filled at once if the constant is out of the range of the block.
+
+template <std::integral T>
+void constantFilter(
+    const char * src,
+    UInt32 source_size,
+    const IntegerPredicate & predicate,
+    UInt8 * filter,
+    UInt32 count);
+
+template <std::integral T>
+void runLengthFilter(
+    const char * src,
+    UInt32 source_size,
+    const IntegerPredicate & predicate,
+    UInt8 * filter,
+    UInt32 count);
+
+template <std::integral T>
+void FORFilter(const char * src, UInt32 source_size, const IntegerPredicate & predicate, UInt8 * filter, UInt32 count);
+
 /// ZigZag encoding
 
 template <std::integral T>
@@ -205,4 +256,149 @@ void ordinaryDeltaFORDecoding(const char * src, UInt32 source_size, char * dest,
 template <std::integral T>
 void deltaFORDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size);
 
+/// Decimal + Frame of Reference encoding for floating-point values
+
+template <std::floating_point T>
+struct DecimalEncodingTraits;
+
+template <>
+struct DecimalEncodingTraits<Float32>
+{
+    using IntType = Int32;
+    using UIntType = UInt32;
+    static constexpr UInt8 max_exponent = 10;
+    // All the integers in [-2^24, 2^24] can be represented by Float32 exactly.
+    static constexpr IntType max_abs_value = 1 << 24;
+};
+
+template <>
+struct DecimalEncodingTraits<Float64>
+{
+    using IntType = Int64;
+    using UIntType = UInt64;
+    static constexpr UInt8 max_exponent = 18;
+    // Less than 2^51, so that the integers can be converted to Float64 by AVX2, which has no such instruction.
+    static constexpr IntType max_abs_value = (1LL << 51) - 1;
+};
+
+// Scale the values to integers by multiplying 10^exponent, the smallest exponent that all the values can be
+// converted back exactly is chosen.
+// Return false if there is no such exponent, e.g. the values contain NaN, infinity, -0.0 or too many fraction digits.
+template <std::floating_point T>
+bool decimalScaling(
+    const T * values,
+    UInt32 count,
+    typename DecimalEncodingTraits<T>::IntType * scaled_values,
+    UInt8 & exponent);
+
+// After decimal FOR encoding, the values stored in `dest` are:
+// [exponent, FOR encoded scaled values]
+template <std::floating_point T>
+size_t decimalFOREncoding(
+    typename DecimalEncodingTraits<T>::UIntType * scaled_values,
+    UInt32 count,
+    UInt8 exponent,
+    typename DecimalEncodingTraits<T>::UIntType frame_of_reference,
+    UInt8 width,
+    char * dest)
+{
+    unalignedStore<UInt8>(dest, exponent);
+    dest += sizeof(UInt8);
+    return sizeof(UInt8) + FOREncoding(scaled_values, count, frame_of_reference, width, dest);
+}
+
+template <std::floating_point T>
+void decimalFORDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size);
+
+/// XOR encoding, each value is XORed with the previous one and only the meaningful bits are stored.
+/// It is the encoding of Gorilla, which is suitable for the slowly changing time series.
+
+// Return the size of the XOR encoded data.
+template <std::floating_point T>
+size_t XOREncodedSize(const T * source, UInt32 count);
+
+template <std::floating_point T>
+size_t XOREncoding(const T * source, UInt32 count, char * dest);
+
+template <std::floating_point T>
+void XORDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size);
+
+/// Dictionary encoding for strings.
+/// The data is split into tokens by '\0', which terminates every string in the chars of ColumnString. So the data
+/// is encoded losslessly even if it is not the chars of strings, or a block begins or ends in the middle of a string.
+
+struct StringDictionary
+{
+    // The distinct tokens, in the order of the first appearance.
+    std::vector<StringRef> tokens;
+    // The total size of the distinct tokens.
+    size_t tokens_bytes = 0;
+    // The position in `tokens` of every token of the data.
+    std::vector<UInt32> indexes;
+};
+
+// Return false if the data has more than `max_distinct_count` distinct tokens.
+// The tokens of `dict` refer to `source`, so `source` must outlive `dict`.
+bool buildStringDictionary(const char * source, UInt32 source_size, size_t max_distinct_count, StringDictionary & dict);
+
+size_t dictionaryEncodedSize(const StringDictionary & dict);
+
+// After dictionary encoding, the values stored in `dest` are:
+// [distinct count, token count, FOR encoded sizes of the distinct tokens, distinct tokens, FOR encoded indexes]
+size_t dictionaryEncoding(StringDictionary & dict, char * dest);
+
+void dictionaryDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size);
+
+// Decode the distinct tokens and the indexes without joining the tokens, so the tokens of `dict` refer to `src`.
+// The i-th token of the data is `dict.tokens[dict.indexes[i]]`.
+void dictionaryDecodingToTokens(const char * src, UInt32 source_size, StringDictionary & dict);
+
+/// FSST (Fast Static Symbol Table) encoding for strings.
+/// The frequent substrings of at most 8 bytes are replaced by the 1-byte codes of a symbol table, which is built
+/// from a sample of the data, and the other bytes are escaped. Decoding is a table lookup and an 8-byte store
+/// per code, which is much faster than LZ4, and the compression ratio is good for the high-cardinality strings
+/// which the dictionary encoding can not handle, such as urls, emails and names.
+
+class FSSTSymbolTable
+{
+public:
+    static constexpr size_t max_symbol_count = 255;
+    static constexpr size_t max_symbol_length = 8;
+    static constexpr UInt8 escape_code = 255;
+
+    // Build the symbol table with the FSST algorithm: compress the sample with the current table, then choose the
+    // symbols and the concatenation of adjacent symbols that cover the most bytes as the next table, repeatedly.
+    static FSSTSymbolTable build(const char * sample, size_t sample_size);
+
+    // The size of the serialized table.
+    size_t serializedSize() const { return sizeof(UInt8) + symbol_count + symbols_bytes; }
+
+    // Return the size of the codes of the encoded data, not including the table.
+    size_t encodedSize(const char * source, size_t source_size) const;
+
+    // After FSST encoding, the values stored in `dest` are:
+    // [symbol count, symbol lengths, symbols, codes]
+    // Return 0 if the encoded data is larger than `dest_capacity`.
+    size_t encode(const char * source, UInt32 source_size, char * dest, size_t dest_capacity) const;
+
+private:
+    void addSymbol(UInt64 symbol, UInt8 length);
+
+    // Return the code of the longest symbol which is a prefix of [pos, end), or escape_code if there is none.
+    UInt8 findLongestSymbol(const char * pos, const char * end) const;
+
+    template <typename F>
+    void encodeImpl(const char * source, size_t source_size, F && write_code) const;
+
+    size_t symbol_count = 0;
+    size_t symbols_bytes = 0;
+    // The bytes of the symbols in little endian, padded by zeros.
+    std::array<UInt64, max_symbol_count> symbols{};
+    std::array<UInt8, max_symbol_count> lengths{};
+    // The codes of the symbols starting with each byte, longer symbols first.
+    std::array<std::vector<UInt8>, 256> codes_by_first_byte;
+};
+
+void FSSTDecoding(const char * src, UInt32 source_size, char * dest, UInt32 dest_size);
+
 } // namespace DB::Compression
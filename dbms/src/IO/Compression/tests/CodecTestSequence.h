@@ -72,6 +72,17 @@ DataTypePtr makeDataType()
     return nullptr;
 }
 
+template <typename T>
+UInt8 typeByte()
+{
+    if constexpr (std::is_same_v<T, Float32>)
+        return magic_enum::enum_integer(CompressionDataType::Float32);
+    else if constexpr (std::is_same_v<T, Float64>)
+        return magic_enum::enum_integer(CompressionDataType::Float64);
+    else
+        return sizeof(T);
+}
+
 struct CodecTestSequence
 {
     std::string name;
@@ -156,7 +167,7 @@ CodecTestSequence makeSeq(Args &&... args)
         (fmt::format("{} values of {}", std::size(vals), type_name<T>())),
         std::move(data),
         makeDataType<T>(),
-        sizeof(T)};
+        typeByte<T>()};
 }
 
 template <typename T, typename Generator>
@@ -178,7 +189,27 @@ CodecTestSequence generateSeq(Generator gen, const char * gen_name, int Begin =
         (fmt::format("{} values of {} from {}", (End - Begin), type_name<T>(), gen_name)),
         std::move(data),
         makeDataType<T>(),
-        sizeof(T)};
+        typeByte<T>()};
+}
+
+// Serialize the strings like the chars of ColumnString, each string is terminated by '\0'.
+// The data is compared byte by byte, so the data type is UInt8.
+template <typename Generator>
+CodecTestSequence generateStringSeq(Generator gen, const char * gen_name, size_t Begin = 0, size_t End = 10000)
+{
+    std::vector<char> data;
+    for (auto i = Begin; i < End; ++i)
+    {
+        const String v = gen(i);
+        data.insert(data.end(), v.begin(), v.end());
+        data.push_back('\0');
+    }
+
+    return CodecTestSequence{
+        (fmt::format("{} strings from {}", (End - Begin), gen_name)),
+        std::move(data),
+        makeDataType<UInt8>(),
+        magic_enum::enum_integer(CompressionDataType::String)};
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -200,6 +231,17 @@ auto SequentialGenerator = [](auto stride = 1) {
     };
 };
 
+// Decimals with `scale` fraction digits, like the floating-point values parsed from text.
+auto DecimalGenerator = [](int scale = 2) {
+    return [=](auto i) {
+        using ValueType = decltype(i);
+        ValueType divisor = 1;
+        for (int j = 0; j < scale; ++j)
+            divisor *= 10;
+        return static_cast<ValueType>(static_cast<Int64>(i) * 37 % 100000) / divisor;
+    };
+};
+
 template <typename T>
 using uniform_distribution = typename std::conditional_t<
     std::is_floating_point_v<T>,
@@ -274,6 +316,31 @@ auto MinMaxGenerator = []() {
     };
 };
 
+// A few distinct strings, like the names of cities or the status of orders.
+auto LowCardinalityStringGenerator = []() {
+    return [](size_t i) -> String {
+        static const std::vector<String> values{"Beijing", "Shanghai", "Guangzhou", "Shenzhen", "Hangzhou", ""};
+        return values[i * 7 % values.size()];
+    };
+};
+
+// Distinct strings sharing a lot of substrings, like urls.
+auto UrlStringGenerator = []() {
+    return [](size_t i) -> String {
+        return fmt::format("https://www.pingcap.com/blog/{}/page?id={}", i * 7919 % 100003, i);
+    };
+};
+
+// Random bytes, including '\0'.
+auto RandomStringGenerator = []() {
+    return [random_engine = std::default_random_engine(0)](size_t i) mutable -> String {
+        String value(i % 32, '\0');
+        for (auto & c : value)
+            c = static_cast<char>(random_engine());
+        return value;
+    };
+};
+
 template <typename T>
 struct RepeatGenerator
 {
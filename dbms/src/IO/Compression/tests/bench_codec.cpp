@@ -39,7 +39,7 @@ static void singleWrite(benchmark::State & state, Args &&... args)
         auto file = std::make_shared<DB::PosixWritableFile>(file_name, true, -1, 0755);
         auto write_buffer = std::make_shared<DB::WriteBufferFromWritableFile>(file);
         CompressionSetting setting(method_byte);
-        setting.data_type = magic_enum::enum_cast<CompressionDataType>(sizeof(T)).value();
+        setting.data_type = magic_enum::enum_cast<CompressionDataType>(tests::typeByte<T>()).value();
         CompressedWriteBuffer<> compressed(*write_buffer, CompressionSettings(setting));
         compressed.write(sequence.serialized_data.data(), sequence.serialized_data.size());
         compressed.next();
@@ -60,7 +60,7 @@ static void singleRead(benchmark::State & state, Args &&... args)
         auto file = std::make_shared<DB::PosixWritableFile>(file_name, true, -1, 0755);
         auto write_buffer = std::make_shared<DB::WriteBufferFromWritableFile>(file);
         CompressionSetting setting(method_byte);
-        setting.data_type = magic_enum::enum_cast<CompressionDataType>(sizeof(T)).value();
+        setting.data_type = magic_enum::enum_cast<CompressionDataType>(tests::typeByte<T>()).value();
         CompressedWriteBuffer<> compressed(*write_buffer, CompressionSettings(setting));
         compressed.write(sequence.serialized_data.data(), sequence.serialized_data.size());
         compressed.next();
@@ -161,6 +161,18 @@ static void singleRead(benchmark::State & state, Args &&... args)
 BENCH_SINGLE_WRITE(CodecSingleWrite)
 BENCH_SINGLE_READ(CodecSingleRead)
 
+#define BENCH_SINGLE_FLOAT(name)                                                                                       \
+    BENCH_SINGLE_WRITE_GENERATOR_TYPE(name##WriteDecimalFloat32, tests::DecimalGenerator(2), Float32)                  \
+    BENCH_SINGLE_WRITE_GENERATOR_TYPE(name##WriteDecimalFloat64, tests::DecimalGenerator(2), Float64)                  \
+    BENCH_SINGLE_WRITE_GENERATOR_TYPE(name##WriteMonotonicFloat64, tests::MonotonicGenerator<Float64>(), Float64)      \
+    BENCH_SINGLE_WRITE_GENERATOR_TYPE(name##WriteRandomFloat64, tests::RandomGenerator<Float64>(0, 0, 1), Float64)     \
+    BENCH_SINGLE_READ_GENERATOR_TYPE(name##ReadDecimalFloat32, tests::DecimalGenerator(2), Float32)                    \
+    BENCH_SINGLE_READ_GENERATOR_TYPE(name##ReadDecimalFloat64, tests::DecimalGenerator(2), Float64)                    \
+    BENCH_SINGLE_READ_GENERATOR_TYPE(name##ReadMonotonicFloat64, tests::MonotonicGenerator<Float64>(), Float64)        \
+    BENCH_SINGLE_READ_GENERATOR_TYPE(name##ReadRandomFloat64, tests::RandomGenerator<Float64>(0, 0, 1), Float64)
+
+BENCH_SINGLE_FLOAT(CodecSingleFloat)
+
 #define WRITE_SEQUENCE(generator)                                                           \
     {                                                                                       \
         auto sequence = tests::generateSeq<T>(generator, "", 0, 8192);                      \
@@ -177,7 +189,7 @@ static void multipleWrite(benchmark::State & state)
         auto file = std::make_shared<DB::PosixWritableFile>(file_name, true, -1, 0755);
         auto write_buffer = std::make_shared<DB::WriteBufferFromWritableFile>(file);
         CompressionSetting setting(method_byte);
-        setting.data_type = magic_enum::enum_cast<CompressionDataType>(sizeof(T)).value();
+        setting.data_type = magic_enum::enum_cast<CompressionDataType>(tests::typeByte<T>()).value();
         CompressedWriteBuffer<> compressed(*write_buffer, CompressionSettings(setting));
 
         WRITE_SEQUENCE(tests::SameValueGenerator(128)); // Constant
@@ -204,7 +216,7 @@ static void multipleRead(benchmark::State & state)
         auto file = std::make_shared<DB::PosixWritableFile>(file_name, true, -1, 0755);
         auto write_buffer = std::make_shared<DB::WriteBufferFromWritableFile>(file);
         CompressionSetting setting(method_byte);
-        setting.data_type = magic_enum::enum_cast<CompressionDataType>(sizeof(T)).value();
+        setting.data_type = magic_enum::enum_cast<CompressionDataType>(tests::typeByte<T>()).value();
         CompressedWriteBuffer<> compressed(*write_buffer, CompressionSettings(setting));
 
         WRITE_SEQUENCE(tests::SameValueGenerator(128));
@@ -252,6 +252,10 @@ const auto IntegerCodecsToTest = ::testing::Values(
 #endif
 );
 
+const auto FloatCodecsToTest = ::testing::Values(CompressionMethodByte::Lightweight);
+
+const auto StringCodecsToTest = ::testing::Values(CompressionMethodByte::Lightweight);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // test cases
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -401,6 +405,51 @@ INSTANTIATE_TEST_CASE_P(
             generateSeq<UInt32>(G(RepeatGenerator<UInt32>(0))),
             generateSeq<UInt64>(G(RepeatGenerator<UInt64>(0))))));
 
+INSTANTIATE_TEST_CASE_P(
+    SmallFloatSequences,
+    MultipleSequencesCodecTest,
+    ::testing::Combine(
+        FloatCodecsToTest,
+        ::testing::Values(
+            generatePyramidOfSequences<Float32>(42, G(DecimalGenerator(2))),
+            generatePyramidOfSequences<Float64>(42, G(DecimalGenerator(2))),
+            generatePyramidOfSequences<Float32>(42, G(MonotonicGenerator<Float32>())),
+            generatePyramidOfSequences<Float64>(42, G(MonotonicGenerator<Float64>())))));
+
+INSTANTIATE_TEST_CASE_P(
+    Float,
+    CodecTest,
+    ::testing::Combine(
+        FloatCodecsToTest,
+        ::testing::Values(
+            generateSeq<Float32>(G(SameValueGenerator(1.5))),
+            generateSeq<Float64>(G(SameValueGenerator(1.5))),
+            generateSeq<Float32>(G(DecimalGenerator(2))),
+            generateSeq<Float64>(G(DecimalGenerator(2))),
+            generateSeq<Float64>(G(DecimalGenerator(6))),
+            generateSeq<Float32>(G(SequentialGenerator(0.1))),
+            generateSeq<Float64>(G(SequentialGenerator(0.1))),
+            generateSeq<Float32>(G(MonotonicGenerator<Float32>())),
+            generateSeq<Float64>(G(MonotonicGenerator<Float64>())),
+            generateSeq<Float32>(G(RandomGenerator<Float32>(0, 0, 1))),
+            generateSeq<Float64>(G(RandomGenerator<Float64>(0, 0, 1))),
+            generateSeq<Float32>(G(MinMaxGenerator())),
+            generateSeq<Float64>(G(MinMaxGenerator())))));
+
+INSTANTIATE_TEST_CASE_P(
+    String,
+    CodecTest,
+    ::testing::Combine(
+        StringCodecsToTest,
+        ::testing::Values(
+            generateStringSeq(G(LowCardinalityStringGenerator())),
+            generateStringSeq(G(UrlStringGenerator())),
+            generateStringSeq(G(RandomStringGenerator())),
+            generateStringSeq(G(LowCardinalityStringGenerator()), 0, 1),
+            generateStringSeq(G(UrlStringGenerator()), 0, 1),
+            generateStringSeq(G(UrlStringGenerator()), 0, 100000),
+            generateStringSeq(G(LowCardinalityStringGenerator())) + generateStringSeq(G(UrlStringGenerator())))));
+
 // INSTANTIATE_TEST_CASE_P(
 //     RandomishInt,
 //     CodecTest,
@@ -0,0 +1,229 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/BitpackingPrimitives.h>
+#include <Common/PODArray.h>
+#include <IO/Compression/CompressionCodecFactory.h>
+#include <IO/Compression/CompressionCodecLightweight.h>
+#include <IO/Compression/CompressionSettings.h>
+#include <IO/Compression/EncodingUtil.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <magic_enum.hpp>
+#include <random>
+
+
+namespace DB::tests
+{
+namespace
+{
+using Op = Compression::IntegerPredicate::Op;
+
+constexpr std::array ALL_OPS
+    = {Op::Equal, Op::NotEqual, Op::Less, Op::LessOrEqual, Op::Greater, Op::GreaterOrEqual};
+
+template <typename T>
+UInt8 naiveCompare(Op op, T value, T constant)
+{
+    switch (op)
+    {
+    case Op::Equal:
+        return value == constant;
+    case Op::NotEqual:
+        return value != constant;
+    case Op::Less:
+        return value < constant;
+    case Op::LessOrEqual:
+        return value <= constant;
+    case Op::Greater:
+        return value > constant;
+    case Op::GreaterOrEqual:
+        return value >= constant;
+    }
+    return 0;
+}
+
+template <typename T>
+Compression::IntegerPredicate makePredicate(Op op, T constant)
+{
+    return Compression::IntegerPredicate{
+        .op = op,
+        .is_signed = std::is_signed_v<T>,
+        .value_size = sizeof(T),
+        .constant = static_cast<UInt64>(static_cast<Int64>(constant)),
+    };
+}
+
+// The constants around the boundaries of `values` and of `T`.
+template <typename T>
+std::vector<T> constantsToTest(const std::vector<T> & values)
+{
+    const auto [min_iter, max_iter] = std::minmax_element(values.begin(), values.end());
+    std::vector<T> constants{
+        std::numeric_limits<T>::min(),
+        std::numeric_limits<T>::max(),
+        0,
+        *min_iter,
+        *max_iter,
+        values[values.size() / 2],
+    };
+    if (*min_iter != std::numeric_limits<T>::min())
+        constants.push_back(*min_iter - 1);
+    if (*max_iter != std::numeric_limits<T>::max())
+        constants.push_back(*max_iter + 1);
+    return constants;
+}
+
+// Check the filter evaluated by `filter_func` on the data encoded by `encode_func` for all the ops and constants.
+template <typename T, typename EncodeFunc, typename FilterFunc>
+void checkFilter(const std::vector<T> & values, EncodeFunc && encode_func, FilterFunc && filter_func)
+{
+    using U = std::make_unsigned_t<T>;
+    std::vector<U> unsigned_values(values.begin(), values.end());
+    PODArray<char> encoded(unsigned_values.size() * sizeof(U) * 2 + 64);
+    const auto encoded_size = encode_func(unsigned_values, encoded.data());
+
+    for (const auto constant : constantsToTest(values))
+    {
+        for (const auto op : ALL_OPS)
+        {
+            PaddedPODArray<UInt8> filter(values.size(), 2);
+            filter_func(encoded.data(), encoded_size, makePredicate(op, constant), filter.data(), values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+                ASSERT_EQ(filter[i], naiveCompare(op, values[i], constant)) << fmt::format(
+                    "i={} value={} constant={} op={}",
+                    i,
+                    +values[i],
+                    +constant,
+                    magic_enum::enum_name(op));
+        }
+    }
+}
+
+template <typename T>
+void checkAllFilters(const std::vector<T> & values)
+{
+    using U = std::make_unsigned_t<T>;
+    if (std::all_of(values.begin(), values.end(), [&](T v) { return v == values.front(); }))
+    {
+        checkFilter(
+            values,
+            [](std::vector<U> & source, char * dest) { return Compression::constantEncoding<U>(source.front(), dest); },
+            Compression::constantFilter<U>);
+    }
+
+    checkFilter(
+        values,
+        [](std::vector<U> & source, char * dest) {
+            return Compression::runLengthEncoding<U>(source.data(), source.size(), dest);
+        },
+        Compression::runLengthFilter<U>);
+
+    checkFilter(
+        values,
+        [](std::vector<U> & source, char * dest) {
+            const auto [min_iter, max_iter] = std::minmax_element(source.begin(), source.end());
+            const U frame_of_reference = *min_iter;
+            const auto width = BitpackingPrimitives::minimumBitWidth<U>(*max_iter - frame_of_reference);
+            return Compression::FOREncoding<U>(source.data(), source.size(), frame_of_reference, width, dest);
+        },
+        Compression::FORFilter<U>);
+}
+
+template <typename T>
+std::vector<T> randomValues(size_t count, T min_value, T max_value, size_t run_length = 1)
+{
+    std::mt19937_64 rng(count);
+    std::uniform_int_distribution<Int64> dist(min_value, max_value);
+    std::vector<T> values;
+    values.reserve(count);
+    while (values.size() < count)
+        values.resize(std::min(count, values.size() + run_length), static_cast<T>(dist(rng)));
+    return values;
+}
+} // namespace
+
+TEST(CodecLightweightFilterTest, EncodedIntegers)
+try
+{
+    // Constant
+    checkAllFilters<Int32>(std::vector<Int32>(100, -5));
+    checkAllFilters<UInt64>(std::vector<UInt64>(7, 42));
+    // Ranges within the positive or negative values
+    checkAllFilters<Int8>(randomValues<Int8>(100, 10, 20, 3));
+    checkAllFilters<Int16>(randomValues<Int16>(1000, -300, -100));
+    checkAllFilters<UInt32>(randomValues<UInt32>(333, 1000, 100000, 5));
+    checkAllFilters<Int64>(randomValues<Int64>(500, 1LL << 40, (1LL << 40) + 1000));
+    // Ranges crossing zero, which are not ordered as unsigned integers
+    checkAllFilters<Int8>(randomValues<Int8>(77, -128, 127));
+    checkAllFilters<Int32>(randomValues<Int32>(1000, -50, 50, 2));
+    checkAllFilters<Int64>(randomValues<Int64>(300, std::numeric_limits<Int64>::min(), 1));
+    // Ranges crossing the sign bit
+    checkAllFilters<UInt16>(randomValues<UInt16>(200, 30000, 40000, 4));
+    checkAllFilters<UInt64>({0, std::numeric_limits<UInt64>::max(), 1, std::numeric_limits<UInt64>::max() - 1});
+    // Long runs
+    checkAllFilters<Int64>(randomValues<Int64>(2000, -3, 3, 300));
+}
+CATCH
+
+TEST(CodecLightweightFilterTest, CompressedBlock)
+try
+{
+    CompressionSetting setting(CompressionMethodByte::Lightweight);
+    setting.data_type = CompressionDataType::Int32;
+    auto codec = CompressionCodecFactory::create(setting);
+    const auto header_size = ICompressionCodec::getHeaderSize();
+
+    for (const auto & values : {
+             std::vector<Int32>(1000, 7),
+             randomValues<Int32>(1000, -10, 10, 50),
+             randomValues<Int32>(1000, 100, 1000),
+             randomValues<Int32>(1000, -1000000, 1000000),
+         })
+    {
+        const UInt32 source_size = values.size() * sizeof(Int32);
+        PODArray<char> compressed(codec->getCompressedReserveSize(source_size));
+        const auto compressed_size
+            = codec->compress(reinterpret_cast<const char *>(values.data()), source_size, compressed.data());
+        for (const auto op : ALL_OPS)
+        {
+            const auto predicate = makePredicate<Int32>(op, 10);
+            PaddedPODArray<UInt8> filter(values.size());
+            // The block is not filtered if it is not encoded by the supported modes, it is fine.
+            if (!CompressionCodecLightweight::tryFilterInteger(
+                    compressed.data() + header_size,
+                    compressed_size - header_size,
+                    source_size,
+                    predicate,
+                    filter.data()))
+                continue;
+            for (size_t i = 0; i < values.size(); ++i)
+                ASSERT_EQ(filter[i], naiveCompare<Int32>(op, values[i], 10));
+        }
+
+        // The predicate on the integers of another size is not evaluated.
+        auto predicate = makePredicate<Int64>(Op::Equal, 10);
+        PaddedPODArray<UInt8> filter(values.size());
+        ASSERT_FALSE(CompressionCodecLightweight::tryFilterInteger(
+            compressed.data() + header_size,
+            compressed_size - header_size,
+            source_size,
+            predicate,
+            filter.data()));
+    }
+}
+CATCH
+
+} // namespace DB::tests
@@ -43,6 +43,8 @@ public:
         return *instance;
     }
 
+    static bool isInitialized() { return instance != nullptr; }
+
     static void shutdown() noexcept { instance.reset(); }
 };
 
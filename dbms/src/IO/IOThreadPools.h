@@ -46,6 +46,9 @@ struct BuildReadTaskForWNTableTrait
 struct BuildReadTaskTrait
 {
 };
+struct SpillIOTrait
+{
+};
 
 // FutureContainer will wait for all futures finished automatically.
 class FutureContainer
@@ -111,4 +114,7 @@ using WNEstablishDisaggTaskPool = IOThreadPool<IOPoolHelper::WNEstablishDisaggTa
 using BuildReadTaskForWNPool = IOThreadPool<IOPoolHelper::BuildReadTaskForWNTrait>;
 using BuildReadTaskForWNTablePool = IOThreadPool<IOPoolHelper::BuildReadTaskForWNTableTrait>;
 using BuildReadTaskPool = IOThreadPool<IOPoolHelper::BuildReadTaskTrait>;
+
+// Writing spilled data and reading it back ahead of the consumer, so that the cpu threads are not blocked by disk.
+using SpillIOPool = IOThreadPool<IOPoolHelper::SpillIOTrait>;
 } // namespace DB
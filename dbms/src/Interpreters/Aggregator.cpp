@@ -673,6 +673,85 @@ void Aggregator::executeImplInner(
     }
 }
 
+template <typename Method>
+void NO_INLINE Aggregator::executeImplForStringDictionary(
+    Method & method,
+    AggregatedDataVariants & result,
+    AggProcessInfo & agg_process_info,
+    TiDB::TiDBCollators & collators) const
+{
+    const auto & dictionary_key = *agg_process_info.string_dictionary_key;
+    const ColumnRawPtrs dictionary_columns{&dictionary_key.getDictionary()};
+    typename Method::State state(dictionary_columns, key_sizes, collators);
+    std::vector<std::string> sort_key_containers;
+    sort_key_containers.resize(params.keys_size, "");
+    auto * aggregates_pool = result.aggregates_pool;
+
+    // The places are not kept between calls, because the hash table may be spilled and reset after
+    // a ResizeException.
+    std::vector<AggregateDataPtr> dictionary_places(dictionary_key.getDictionary().size(), nullptr);
+    const auto & index_data = dictionary_key.getIndexes();
+    const size_t start = agg_process_info.start_row;
+    size_t rows = agg_process_info.end_row - start;
+    fiu_do_on(FailPoints::force_agg_on_partial_block, {
+        if (rows > 0 && start == 0)
+            rows = std::max(rows / 2, 1);
+    });
+    std::unique_ptr<AggregateDataPtr[]> places(new AggregateDataPtr[rows]);
+
+    size_t i = start;
+    for (; i < start + rows; ++i)
+    {
+        auto & place = dictionary_places[index_data[i]];
+        if (place == nullptr)
+        {
+            auto emplace_result_holder = emplaceOrFindKey</*only_lookup=*/false>(
+                method,
+                state,
+                index_data[i],
+                *aggregates_pool,
+                sort_key_containers);
+            if unlikely (!emplace_result_holder.has_value())
+            {
+                LOG_INFO(log, "HashTable resize throw ResizeException since the data is already marked for spill");
+                break;
+            }
+
+            auto & emplace_result = emplace_result_holder.value();
+            if (params.aggregates_size == 0)
+            {
+                // It's ok to use fake address, because no one use agg data if there is no agg func.
+                place = reinterpret_cast<AggregateDataPtr>(0x1);
+                emplace_result.setMapped(place);
+            }
+            else if (emplace_result.isInserted())
+            {
+                // exception-safety - if the states can not be created, then destructors will not be called.
+                emplace_result.setMapped(nullptr);
+                place = aggregates_pool->alignedAlloc(total_size_of_aggregate_states, align_aggregate_states);
+                createAggregateStates(place);
+                emplace_result.setMapped(place);
+            }
+            else
+            {
+                place = emplace_result.getMapped();
+            }
+        }
+        places[i - start] = place;
+    }
+
+    if (params.aggregates_size > 0)
+    {
+        for (AggregateFunctionInstruction * inst = agg_process_info.aggregate_functions_instructions.data(); inst->that;
+             ++inst)
+        {
+            inst->batch_that
+                ->addBatch(start, i - start, places.get(), inst->state_offset, inst->batch_arguments, aggregates_pool);
+        }
+    }
+    agg_process_info.start_row = i;
+}
+
 template <bool only_lookup, typename Method, typename KeyHolderType>
 std::optional<typename Method::template EmplaceOrFindKeyResult<only_lookup>::ResultType> Aggregator::emplaceOrFindKey(
     Method & method,
@@ -1088,7 +1167,7 @@ void Aggregator::prepareAggregateInstructions(
     }
 }
 
-void Aggregator::AggProcessInfo::prepareForAgg()
+void Aggregator::AggProcessInfo::prepareForAgg(bool keep_string_dictionary)
 {
     if (prepare_for_agg_done)
         return;
@@ -1106,6 +1185,12 @@ void Aggregator::AggProcessInfo::prepareForAgg()
     for (size_t i = 0; i < aggregator->params.keys_size; ++i)
     {
         key_columns[i] = input_columns.at(aggregator->params.keys[i]).get();
+        if (keep_string_dictionary && aggregator->params.keys_size == 1)
+        {
+            string_dictionary_key = typeid_cast<const ColumnDictionaryString *>(key_columns[i]);
+            if (string_dictionary_key)
+                continue;
+        }
         if (ColumnPtr converted = key_columns[i]->convertToFullColumnIfConst())
         {
             /// Remember the columns we will work with
@@ -1166,7 +1251,11 @@ bool Aggregator::executeOnBlockImpl(
         LOG_TRACE(log, "Aggregation method: `{}`", result.getMethodName());
     }
 
-    agg_process_info.prepareForAgg();
+    /// The string dictionary is only handled by the key_string methods, see `executeImplForStringDictionary`.
+    agg_process_info.prepareForAgg(
+        !collect_hit_rate && !only_lookup
+        && (result.type == AggregatedDataVariants::Type::key_string
+            || result.type == AggregatedDataVariants::Type::key_string_two_level));
 
     if (is_cancelled())
         return true;
@@ -1187,6 +1276,21 @@ bool Aggregator::executeOnBlockImpl(
     {
         executeWithoutKeyImpl(result.without_key, agg_process_info, result.aggregates_pool);
     }
+    else if (agg_process_info.string_dictionary_key != nullptr)
+    {
+        if (result.type == AggregatedDataVariants::Type::key_string)
+            executeImplForStringDictionary(
+                *ToAggregationMethodPtr(key_string, result.aggregation_method_impl),
+                result,
+                agg_process_info,
+                params.collators);
+        else
+            executeImplForStringDictionary(
+                *ToAggregationMethodPtr(key_string_two_level, result.aggregation_method_impl),
+                result,
+                agg_process_info,
+                params.collators);
+    }
     else
     {
 #define M(NAME, IS_TWO_LEVEL)                                              \
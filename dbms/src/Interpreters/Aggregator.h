@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Columns/ColumnAggregateFunction.h>
+#include <Columns/ColumnDictionaryString.h>
 #include <Columns/ColumnFixedString.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
@@ -984,6 +985,8 @@ public:
         Columns materialized_columns;
         Columns input_columns;
         ColumnRawPtrs key_columns;
+        /// Set if the only key is a string dictionary, then the keys are looked up once per string of the dictionary.
+        const ColumnDictionaryString * string_dictionary_key = nullptr;
         AggregateColumns aggregate_columns;
         AggregateFunctionInstructions aggregate_functions_instructions;
         Aggregator * aggregator;
@@ -992,7 +995,7 @@ public:
         size_t hit_row_cnt = 0;
         std::vector<UInt64> not_found_rows;
 
-        void prepareForAgg();
+        void prepareForAgg(bool keep_string_dictionary = false);
         bool allBlockDataHandled() const
         {
             assert(start_row <= end_row);
@@ -1005,6 +1008,7 @@ public:
             start_row = 0;
             end_row = 0;
             materialized_columns.clear();
+            string_dictionary_key = nullptr;
             prepare_for_agg_done = false;
 
             hit_row_cnt = 0;
@@ -1129,6 +1133,15 @@ protected:
         AggProcessInfo & agg_process_info,
         TiDB::TiDBCollators & collators) const;
 
+    /// Process one data block whose only key is a string dictionary, the key of every string of the
+    /// dictionary is emplaced into the hash table at most once.
+    template <typename Method>
+    void executeImplForStringDictionary(
+        Method & method,
+        AggregatedDataVariants & result,
+        AggProcessInfo & agg_process_info,
+        TiDB::TiDBCollators & collators) const;
+
     template <
         bool collect_hit_rate,
         bool only_lookup,
@@ -206,6 +206,14 @@ void AsynchronousMetrics::update()
         }
     }
 
+    {
+        if (auto bloom_filter_cache = context.getBloomFilterIndexCache())
+        {
+            set("BloomFilterIndexCacheBytes", bloom_filter_cache->weight());
+            set("BloomFilterIndexFiles", bloom_filter_cache->count());
+        }
+    }
+
     {
         if (auto rn_mvcc_index_cache = context.getSharedContextDisagg()->rn_mvcc_index_cache)
         {
@@ -53,6 +53,7 @@
 #include <Storages/DeltaMerge/ColumnFile/ColumnFileSchema.h>
 #include <Storages/DeltaMerge/DeltaIndex/DeltaIndexManager.h>
 #include <Storages/DeltaMerge/File/ColumnCacheLongTerm.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/LocalIndexCache.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 #include <Storages/DeltaMerge/LocalIndexerScheduler.h>
@@ -146,6 +147,7 @@ struct ContextShared
     mutable DBGInvoker dbg_invoker; /// Execute inner functions, debug only.
     mutable MarkCachePtr mark_cache; /// Cache of marks in compressed files.
     mutable DM::MinMaxIndexCachePtr minmax_index_cache; /// Cache of minmax index in compressed files.
+    mutable DM::BloomFilterIndexCachePtr bloom_filter_index_cache; /// Cache of bloom filter index in compressed files.
     mutable DM::LocalIndexCachePtr
         light_local_index_cache; // Cache of local index reader which memory usage is small < 1MB.
     mutable DM::LocalIndexCachePtr
@@ -1224,6 +1226,29 @@ void Context::dropMinMaxIndexCache() const
         shared->minmax_index_cache->reset();
 }
 
+void Context::setBloomFilterIndexCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->bloom_filter_index_cache)
+        throw Exception("Bloom filter index cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->bloom_filter_index_cache = std::make_shared<DM::BloomFilterIndexCache>(cache_size_in_bytes);
+}
+
+DM::BloomFilterIndexCachePtr Context::getBloomFilterIndexCache() const
+{
+    auto lock = getLock();
+    return shared->bloom_filter_index_cache;
+}
+
+void Context::dropBloomFilterIndexCache() const
+{
+    auto lock = getLock();
+    if (shared->bloom_filter_index_cache)
+        shared->bloom_filter_index_cache->reset();
+}
+
 void Context::setLocalIndexCache(size_t light_local_index_cache, size_t heavy_cache_entities)
 {
     auto lock = getLock();
@@ -108,6 +108,7 @@ enum class PageStorageRunMode : UInt8;
 namespace DM
 {
 class MinMaxIndexCache;
+class BloomFilterIndexCache;
 class LocalIndexCache;
 class ColumnCacheLongTerm;
 class DeltaIndexManager;
@@ -395,6 +396,10 @@ public:
     std::shared_ptr<DM::MinMaxIndexCache> getMinMaxIndexCache() const;
     void dropMinMaxIndexCache() const;
 
+    void setBloomFilterIndexCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::BloomFilterIndexCache> getBloomFilterIndexCache() const;
+    void dropBloomFilterIndexCache() const;
+
     void setLocalIndexCache(size_t light_local_index_cache, size_t heavy_cache_entities);
     std::shared_ptr<DM::LocalIndexCache> getLightLocalIndexCache() const;
     std::shared_ptr<DM::LocalIndexCache> getHeavyLocalIndexCache() const;
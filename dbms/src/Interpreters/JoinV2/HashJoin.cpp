@@ -13,12 +13,16 @@
 // limitations under the License.
 
 #include <Columns/ColumnUtils.h>
+#include <Columns/countBytesInFilter.h>
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
 #include <Common/Stopwatch.h>
+#include <Core/AutoSpillTrigger.h>
 #include <Core/ColumnsWithTypeAndName.h>
 #include <DataStreams/materializeBlock.h>
 #include <DataTypes/DataTypeNullable.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
+#include <Flash/Pipeline/Schedule/Tasks/OneTimeNotifyFuture.h>
 #include <Interpreters/JoinUtils.h>
 #include <Interpreters/JoinV2/HashJoin.h>
 #include <Interpreters/JoinV2/HashJoinProbe.h>
@@ -120,26 +124,51 @@ HashJoin::HashJoin(
     const NamesAndTypes & output_columns_,
     const TiDB::TiDBCollators & collators_,
     const JoinNonEqualConditions & non_equal_conditions_,
-    const Settings & settings_,
-    const String & match_helper_name_)
-    : kind(kind_)
+    const HashJoinSettings & settings_,
+    const String & match_helper_name_,
+    size_t fine_grained_shuffle_count_,
+    UInt64 max_bytes_before_external_join_,
+    const SpillConfig & build_spill_config_,
+    const SpillConfig & probe_spill_config_,
+    const RegisterOperatorSpillContext & register_operator_spill_context_,
+    AutoSpillTrigger * auto_spill_trigger_,
+    size_t restore_round_)
+    : wait_probe_finished_future(std::make_shared<OneTimeNotifyFuture>(NotifyType::WAIT_ON_JOIN_PROBE_FINISH))
+    , wait_build_blocks_inserted_future(std::make_shared<OneTimeNotifyFuture>(NotifyType::WAIT_ON_JOIN_BUILD_FINISH))
+    , kind(kind_)
     , join_req_id(req_id)
     , key_names_left(key_names_left_)
     , key_names_right(key_names_right_)
+    , original_key_names_left(key_names_left_)
     , collators(collators_)
     , non_equal_conditions(non_equal_conditions_)
     , settings(settings_)
     , match_helper_name(match_helper_name_)
-    , log(Logger::get(join_req_id))
+    , fine_grained_shuffle_count(fine_grained_shuffle_count_)
+    , log(Logger::get(restore_round_ == 0 ? join_req_id : fmt::format("{}_round_{}", join_req_id, restore_round_)))
     , has_other_condition(non_equal_conditions.other_cond_expr != nullptr)
     , output_columns(output_columns_)
+    , hash_join_spill_context(std::make_shared<HashJoinSpillContext>(
+          build_spill_config_,
+          probe_spill_config_,
+          max_bytes_before_external_join_,
+          log))
+    , register_operator_spill_context(register_operator_spill_context_)
+    , auto_spill_trigger(auto_spill_trigger_)
+    , restore_round(restore_round_)
 {
     RUNTIME_ASSERT(key_names_left.size() == key_names_right.size());
     output_block = Block(output_columns);
+    /// The restored partition is built and probed in memory, it will not be spilled again.
+    /// The hash tables of fine grained shuffle are not partitioned by the spill hash, so spill is disabled too.
+    if (restore_round > 0 || isEnableFineGrainedShuffle())
+        hash_join_spill_context->disableSpill();
 }
 
 void HashJoin::initRowLayoutAndHashJoinMethod()
 {
+    row_layout.has_matched_flag = needScanHashMapAfterProbe(kind);
+
     size_t keys_size = key_names_right.size();
     if (keys_size == 0)
     {
@@ -300,6 +329,7 @@ void HashJoin::initBuild(const Block & sample_block, size_t build_concurrency_)
     RUNTIME_CHECK_MSG(isFinalize(), "join should be finalized first");
 
     right_sample_block = materializeBlock(sample_block);
+    build_sample_block = right_sample_block;
 
     /// In case of LEFT and FULL joins, convert joined columns to Nullable.
     if (isLeftOuterJoin(kind) || kind == ASTTableJoin::Kind::Full)
@@ -319,8 +349,32 @@ void HashJoin::initBuild(const Block & sample_block, size_t build_concurrency_)
     build_workers_data.resize(build_concurrency);
     for (size_t i = 0; i < build_concurrency; ++i)
         build_workers_data[i].key_getter = createHashJoinKeyGetter(method, collators);
-    for (size_t i = 0; i < JOIN_BUILD_PARTITION_COUNT + 1; ++i)
-        multi_row_containers.emplace_back(std::make_unique<MultipleRowContainer>());
+    size_t hash_table_count = isEnableFineGrainedShuffle() ? build_concurrency : 1;
+    multi_row_containers.resize(hash_table_count);
+    for (auto & containers : multi_row_containers)
+    {
+        for (size_t i = 0; i < JOIN_BUILD_PARTITION_COUNT + 1; ++i)
+            containers.emplace_back(std::make_unique<MultipleRowContainer>());
+    }
+    for (size_t i = 0; i < hash_table_count; ++i)
+        pointer_tables.emplace_back(std::make_unique<HashJoinPointerTable>());
+
+    hash_join_spill_context->init(JOIN_SPILL_PARTITION_COUNT);
+    if (hash_join_spill_context->supportSpill() && method == HashJoinKeyMethod::Cross)
+    {
+        /// todo support spill for cross join
+        hash_join_spill_context->disableSpill();
+        LOG_WARNING(log, "Join does not support spill, reason: cross join spill is not supported");
+    }
+    if (register_operator_spill_context != nullptr)
+        register_operator_spill_context(hash_join_spill_context);
+    if (hash_join_spill_context->isSpillEnabled())
+    {
+        hash_join_spill_context->buildBuildSpiller(build_sample_block);
+        for (size_t i = 0; i < JOIN_SPILL_PARTITION_COUNT; ++i)
+            spill_partitions.emplace_back(std::make_unique<HashJoinSpillPartition>());
+        build_side_marked_spilled_data.resize(build_concurrency);
+    }
 
     build_initialized = true;
 }
@@ -332,6 +386,7 @@ void HashJoin::initProbe(const Block & sample_block, size_t probe_concurrency_)
     RUNTIME_CHECK_MSG(isFinalize(), "join should be finalized first");
 
     left_sample_block = materializeBlock(sample_block);
+    probe_sample_block = left_sample_block;
 
     /// In case of RIGHT and FULL joins, convert left columns to Nullable.
     if (getFullness(kind))
@@ -415,6 +470,12 @@ void HashJoin::initProbe(const Block & sample_block, size_t probe_concurrency_)
     active_probe_worker = probe_concurrency;
     probe_workers_data.resize(probe_concurrency);
 
+    if (hash_join_spill_context->isSpillEnabled())
+    {
+        hash_join_spill_context->buildProbeSpiller(probe_sample_block);
+        probe_side_marked_spilled_data.resize(probe_concurrency);
+    }
+
     probe_initialized = true;
 }
 
@@ -433,7 +494,7 @@ bool HashJoin::finishOneBuildRow(size_t stream_index)
     if (active_build_worker.fetch_sub(1) == 1)
     {
         FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_mpp_hash_build);
-        workAfterBuildRowFinish();
+        workAfterBuildRowFinish(stream_index);
         return true;
     }
     return false;
@@ -455,12 +516,13 @@ bool HashJoin::finishOneProbe(size_t stream_index)
     if (active_probe_worker.fetch_sub(1) == 1)
     {
         FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_mpp_hash_probe);
+        workAfterProbeFinish(stream_index);
         return true;
     }
     return false;
 }
 
-void HashJoin::workAfterBuildRowFinish()
+void HashJoin::workAfterBuildRowFinish(size_t stream_index)
 {
     size_t all_build_row_count = 0;
     for (size_t i = 0; i < build_concurrency; ++i)
@@ -470,13 +532,37 @@ void HashJoin::workAfterBuildRowFinish()
     for (size_t i = 0; i < build_concurrency; ++i)
         enable_tagged_pointer &= build_workers_data[i].enable_tagged_pointer;
 
-    pointer_table.init(
-        method,
-        all_build_row_count,
-        getHashValueByteSize(method),
-        settings.probe_enable_prefetch_threshold,
-        enable_tagged_pointer,
-        false);
+    if (isEnableSpill())
+    {
+        finishBuildSpill(stream_index);
+        /// The buffered blocks of the in-memory partitions are converted to rows before building the pointer table,
+        /// the tagged pointer is decided in `buildPointerTable` once the rows are inserted.
+        for (const auto & block : build_blocks_to_insert)
+            all_build_row_count += block.rows();
+    }
+
+    if (isEnableFineGrainedShuffle())
+    {
+        /// Each build stream owns a hash table, so the pointer table is initialized with the rows of its own stream.
+        for (size_t i = 0; i < build_concurrency; ++i)
+            pointer_tables[i]->init(
+                method,
+                build_workers_data[i].row_count,
+                getHashValueByteSize(method),
+                settings.probe_enable_prefetch_threshold,
+                settings.enable_tagged_pointer && build_workers_data[i].enable_tagged_pointer,
+                false);
+    }
+    else
+    {
+        pointer_tables[0]->init(
+            method,
+            all_build_row_count,
+            getHashValueByteSize(method),
+            settings.probe_enable_prefetch_threshold,
+            enable_tagged_pointer,
+            false);
+    }
 
     /// Conservative threshold: trigger late materialization when lm_row_size average >= 16 bytes.
     constexpr size_t trigger_lm_row_size_threshold = 16;
@@ -498,20 +584,50 @@ void HashJoin::workAfterBuildRowFinish()
     fiu_do_on(FailPoints::force_join_v2_probe_enable_lm, { late_materialization = true; });
     fiu_do_on(FailPoints::force_join_v2_probe_disable_lm, { late_materialization = false; });
 
-    join_probe_helper = std::make_unique<JoinProbeHelper>(this, late_materialization);
+    size_t all_pointer_table_size = 0;
+    for (const auto & pointer_table : pointer_tables)
+    {
+        join_probe_helpers.emplace_back(std::make_unique<JoinProbeHelper>(this, *pointer_table, late_materialization));
+        all_pointer_table_size += pointer_table->getPointerTableSize();
+    }
+    if (needScanBuildSideAfterProbe())
+        join_scan_build_side_helper = std::make_unique<JoinScanBuildSideHelper>(this);
 
     LOG_INFO(
         log,
-        "finish build row and allocate pointer table, rows {}, pointer table size {}, enable (prefetch {}, tagged "
-        "pointer {}, lm {}(avg size {}))",
+        "finish build row and allocate pointer table, rows {}, pointer table count {}, size {}, enable (prefetch {}, "
+        "tagged pointer {}, lm {}(avg size {}))",
         all_build_row_count,
-        pointer_table.getPointerTableSize(),
-        pointer_table.enableProbePrefetch(),
-        pointer_table.enableTaggedPointer(),
+        pointer_tables.size(),
+        all_pointer_table_size,
+        pointer_tables[0]->enableProbePrefetch(),
+        pointer_tables[0]->enableTaggedPointer(),
         late_materialization,
         avg_lm_row_size);
 }
 
+void HashJoin::workAfterProbeFinish(size_t stream_index)
+{
+    profile_info->is_spill_enabled = isEnableSpill();
+    profile_info->is_spilled = isSpilled();
+    if (!isEnableSpill())
+        return;
+
+    /// Flush the cached blocks of the spilled partitions.
+    for (size_t i = 0; i < JOIN_SPILL_PARTITION_COUNT; ++i)
+    {
+        if (!hash_join_spill_context->isPartitionSpilled(i))
+            continue;
+        Blocks blocks_to_spill;
+        {
+            std::unique_lock partition_lock(spill_partitions[i]->mu);
+            blocks_to_spill = spill_partitions[i]->trySpillProbeBlocks();
+        }
+        markProbeSideSpillData(i, std::move(blocks_to_spill), stream_index);
+    }
+    hash_join_spill_context->finishSpillableStage();
+}
+
 void HashJoin::buildRowFromBlock(const Block & b, size_t stream_index)
 {
     RUNTIME_ASSERT(stream_index < build_concurrency);
@@ -520,6 +636,17 @@ void HashJoin::buildRowFromBlock(const Block & b, size_t stream_index)
     if unlikely (b.rows() == 0)
         return;
 
+    if (isEnableSpill())
+    {
+        bufferBuildBlockForSpill(b, stream_index);
+        return;
+    }
+
+    insertBlockToRowContainersForBuild(b, stream_index);
+}
+
+void HashJoin::insertBlockToRowContainersForBuild(const Block & b, size_t stream_index)
+{
     Stopwatch watch;
 
     Block block = b;
@@ -553,25 +680,80 @@ void HashJoin::buildRowFromBlock(const Block & b, size_t stream_index)
 
     assertBlocksHaveEqualStructure(block, right_sample_block_pruned, "Join Build");
 
+    if (needRecordNotInsertRows(kind) && null_map != nullptr)
+    {
+        /// The rows that are not inserted are output after probe.
+        size_t not_inserted_rows = countBytesInFilter(*null_map);
+        if (not_inserted_rows > 0)
+        {
+            Block not_inserted_block = block.cloneEmpty();
+            size_t columns = block.columns();
+            for (size_t i = 0; i < columns; ++i)
+                not_inserted_block.getByPosition(i).column
+                    = block.getByPosition(i).column->filter(*null_map, not_inserted_rows);
+            std::unique_lock lock(not_inserted_blocks_mu);
+            not_inserted_blocks.push_back(std::move(not_inserted_block));
+        }
+    }
+
     bool check_lm_row_size = has_other_condition
         && row_layout.other_column_count_for_other_condition < row_layout.other_column_indexes.size();
     insertBlockToRowContainers(
         method,
-        needRecordNotInsertRows(kind),
         block,
         rows,
         key_columns,
         null_map,
         row_layout,
-        multi_row_containers,
+        multi_row_containers[getHashTableIndex(stream_index)],
         build_workers_data[stream_index],
         check_lm_row_size);
 
     build_workers_data[stream_index].build_time += watch.elapsedMilliseconds();
 }
 
+bool HashJoin::insertOneBuildBlockKeptInMemory(size_t stream_index)
+{
+    if (!isEnableSpill())
+        return false;
+    /// Convert the buffered blocks of the in-memory partitions to rows before building the pointer table,
+    /// one block at a time so that the task can be scheduled fairly.
+    size_t index = build_blocks_to_insert_index.fetch_add(1);
+    if (index >= build_blocks_to_insert.size())
+        return false;
+    insertBlockToRowContainersForBuild(build_blocks_to_insert[index], stream_index);
+    build_blocks_to_insert[index].clear();
+    if (build_blocks_inserted_count.fetch_add(1, std::memory_order_acq_rel) + 1 == build_blocks_to_insert.size())
+        wait_build_blocks_inserted_future->finish();
+    return true;
+}
+
+bool HashJoin::isBuildBlocksKeptInMemoryInsertedForPipeline() const
+{
+    if (build_blocks_inserted_count.load(std::memory_order_acquire) < build_blocks_to_insert.size())
+    {
+        setNotifyFuture(wait_build_blocks_inserted_future.get());
+        return false;
+    }
+    return true;
+}
+
 bool HashJoin::buildPointerTable(size_t stream_index)
 {
+    if (isEnableSpill())
+    {
+        RUNTIME_CHECK(build_blocks_inserted_count.load(std::memory_order_acquire) == build_blocks_to_insert.size());
+        /// Check whether all the rows can use tagged pointers.
+        std::call_once(decide_tagged_pointer_flag, [&] {
+            bool enable_tagged_pointer = settings.enable_tagged_pointer;
+            for (size_t i = 0; i < build_concurrency; ++i)
+                enable_tagged_pointer &= build_workers_data[i].enable_tagged_pointer;
+            pointer_tables[getHashTableIndex(stream_index)]->setEnableTaggedPointer(enable_tagged_pointer);
+        });
+    }
+
+    auto & pointer_table = *pointer_tables[getHashTableIndex(stream_index)];
+    auto & containers = multi_row_containers[getHashTableIndex(stream_index)];
     bool is_end;
     switch (method)
     {
@@ -581,12 +763,12 @@ bool HashJoin::buildPointerTable(size_t stream_index)
         if constexpr (KeyGetterType##METHOD::Type::joinKeyCompareHashFirst())              \
             is_end = pointer_table.build<KeyGetterType##METHOD::HashValueType>(            \
                 build_workers_data[stream_index],                                          \
-                multi_row_containers,                                                      \
+                containers,                                                                \
                 settings.max_block_size);                                                  \
         else                                                                               \
             is_end = pointer_table.build<void>(                                            \
                 build_workers_data[stream_index],                                          \
-                multi_row_containers,                                                      \
+                containers,                                                                \
                 settings.max_block_size);                                                  \
         break;
         APPLY_FOR_HASH_JOIN_VARIANTS(M)
@@ -611,6 +793,353 @@ bool HashJoin::buildPointerTable(size_t stream_index)
     return is_end;
 }
 
+Blocks HashJoin::dispatchBlockForSpill(const Names & key_names, const Block & block) const
+{
+    size_t rows = block.rows();
+    Columns materialized_columns;
+    ColumnRawPtrs key_columns = extractAndMaterializeKeyColumns(block, materialized_columns, key_names);
+    std::vector<String> sort_key_containers(key_columns.size());
+    WeakHash32 hash(0);
+    computeDispatchHash(rows, key_columns, collators, sort_key_containers, restore_round, hash);
+
+    const auto & hash_data = hash.getData();
+    IColumn::Selector selector(rows);
+    for (size_t i = 0; i < rows; ++i)
+        selector[i] = hash_data[i] & (JOIN_SPILL_PARTITION_COUNT - 1);
+
+    Blocks result(JOIN_SPILL_PARTITION_COUNT);
+    for (auto & partition_block : result)
+        partition_block = block.cloneEmpty();
+    size_t columns = block.columns();
+    for (size_t i = 0; i < columns; ++i)
+    {
+        auto dispatched_columns = block.getByPosition(i).column->scatter(JOIN_SPILL_PARTITION_COUNT, selector);
+        for (size_t part = 0; part < JOIN_SPILL_PARTITION_COUNT; ++part)
+            result[part].getByPosition(i).column = std::move(dispatched_columns[part]);
+    }
+    return result;
+}
+
+void HashJoin::bufferBuildBlockForSpill(const Block & b, size_t stream_index)
+{
+    Stopwatch watch;
+    auto & wd = build_workers_data[stream_index];
+
+    Block block = materializeBlock(b);
+    if (has_other_condition
+        && row_layout.other_column_count_for_other_condition < row_layout.other_column_indexes.size())
+    {
+        /// Collect the statistics of late materialization before the blocks are dispatched.
+        wd.lm_row_count += block.rows();
+        for (size_t i = row_layout.other_column_count_for_other_condition; i < row_layout.other_column_indexes.size();
+             ++i)
+        {
+            const auto & name = right_sample_block_pruned.getByPosition(row_layout.other_column_indexes[i].first).name;
+            wd.lm_row_size += block.getByName(name).column->serializeByteSize();
+        }
+    }
+
+    Blocks dispatched_blocks = dispatchBlockForSpill(key_names_right, block);
+    for (size_t i = 0; i < JOIN_SPILL_PARTITION_COUNT; ++i)
+    {
+        if (dispatched_blocks[i].rows() == 0)
+            continue;
+        auto & partition = *spill_partitions[i];
+        std::unique_lock partition_lock(partition.mu);
+        partition.build_bytes += dispatched_blocks[i].bytes();
+        partition.build_blocks.push_back(std::move(dispatched_blocks[i]));
+        checkAndMarkPartitionSpilledIfNeededInternal(partition, i, stream_index);
+    }
+    if (auto_spill_trigger != nullptr)
+        auto_spill_trigger->triggerAutoSpill();
+    if (!hash_join_spill_context->isInAutoSpillMode())
+        spillMostMemoryUsedPartitionIfNeeded(stream_index);
+
+    wd.build_time += watch.elapsedMilliseconds();
+}
+
+void HashJoin::checkAndMarkPartitionSpilledIfNeededInternal(
+    HashJoinSpillPartition & partition,
+    size_t partition_index,
+    size_t stream_index)
+{
+    if (hash_join_spill_context->updatePartitionRevocableMemory(partition_index, partition.build_bytes))
+    {
+        hash_join_spill_context->markPartitionSpilled(partition_index);
+        markBuildSideSpillData(partition_index, partition.trySpillBuildBlocks(), stream_index);
+    }
+}
+
+void HashJoin::checkAndMarkPartitionSpilledIfNeeded(size_t stream_index)
+{
+    if (!isEnableSpill())
+        return;
+    for (size_t i = 0; i < JOIN_SPILL_PARTITION_COUNT; ++i)
+    {
+        if (!hash_join_spill_context->isPartitionMarkedForAutoSpill(i))
+            continue;
+        auto & partition = *spill_partitions[i];
+        std::unique_lock partition_lock(partition.mu, std::try_to_lock);
+        /// If someone already holds the lock, it will check the spill.
+        if (partition_lock.owns_lock())
+            checkAndMarkPartitionSpilledIfNeededInternal(partition, i, stream_index);
+    }
+}
+
+void HashJoin::spillMostMemoryUsedPartitionIfNeeded(size_t stream_index)
+{
+    std::unique_lock lock(spill_mu);
+    for (const auto partition_index : hash_join_spill_context->getPartitionsToSpill())
+    {
+        LOG_INFO(log, "Join with restore round: {}, will spill partition: {}.", restore_round, partition_index);
+        auto & partition = *spill_partitions[partition_index];
+        std::unique_lock partition_lock(partition.mu);
+        hash_join_spill_context->markPartitionSpilled(partition_index);
+        markBuildSideSpillData(partition_index, partition.trySpillBuildBlocks(), stream_index);
+    }
+}
+
+void HashJoin::markBuildSideSpillData(size_t partition_index, Blocks && blocks, size_t stream_index)
+{
+    if (!blocks.empty())
+        build_side_marked_spilled_data[stream_index].emplace_back(partition_index, std::move(blocks));
+}
+
+void HashJoin::markProbeSideSpillData(size_t partition_index, Blocks && blocks, size_t stream_index)
+{
+    if (!blocks.empty())
+        probe_side_marked_spilled_data[stream_index].emplace_back(partition_index, std::move(blocks));
+}
+
+bool HashJoin::hasBuildSideMarkedSpillData(size_t stream_index) const
+{
+    if (!isEnableSpill())
+        return false;
+    return !build_side_marked_spilled_data[stream_index].empty();
+}
+
+void HashJoin::flushBuildSideMarkedSpillData(size_t stream_index)
+{
+    auto & data = build_side_marked_spilled_data[stream_index];
+    for (auto & [partition_index, blocks] : data)
+    {
+        hash_join_spill_context->getBuildSpiller()->spillBlocks(std::move(blocks), partition_index);
+        hash_join_spill_context->finishOneSpill(partition_index);
+    }
+    data.clear();
+}
+
+void HashJoin::finalizeBuild()
+{
+    if (hash_join_spill_context->getBuildSpiller())
+        hash_join_spill_context->getBuildSpiller()->finishSpill();
+}
+
+void HashJoin::finishBuildSpill(size_t stream_index)
+{
+    hash_join_spill_context->finishBuild();
+    for (size_t i = 0; i < JOIN_SPILL_PARTITION_COUNT; ++i)
+    {
+        auto & partition = *spill_partitions[i];
+        std::unique_lock partition_lock(partition.mu);
+        /// The partition marked for auto spill is also spilled because the memory is not enough to build it.
+        if (hash_join_spill_context->isPartitionSpilled(i) || hash_join_spill_context->isPartitionMarkedForAutoSpill(i))
+        {
+            hash_join_spill_context->markPartitionSpilled(i);
+            markBuildSideSpillData(i, partition.trySpillBuildBlocks(), stream_index);
+            remaining_partitions_to_restore.push_back(i);
+        }
+        else
+        {
+            for (auto & block : partition.trySpillBuildBlocks())
+                build_blocks_to_insert.push_back(std::move(block));
+            hash_join_spill_context->updatePartitionRevocableMemory(i, 0);
+        }
+    }
+    LOG_INFO(
+        log,
+        "finish build spill, {} partitions are spilled, {} blocks are kept in memory",
+        remaining_partitions_to_restore.size(),
+        build_blocks_to_insert.size());
+}
+
+void HashJoin::dispatchProbeBlock(const Block & block, JoinProbeBlocks & probe_blocks, size_t stream_index)
+{
+    if (isEnableFineGrainedShuffle())
+    {
+        dispatchProbeBlockByFineGrainedShuffle(block, probe_blocks);
+        return;
+    }
+
+    Blocks dispatched_blocks = dispatchBlockForSpill(key_names_left, materializeBlock(block));
+    for (size_t i = 0; i < JOIN_SPILL_PARTITION_COUNT; ++i)
+    {
+        if (dispatched_blocks[i].rows() == 0)
+            continue;
+        if (!hash_join_spill_context->isPartitionSpilled(i))
+        {
+            probe_blocks.push_back({std::move(dispatched_blocks[i]), 0});
+            continue;
+        }
+        auto & partition = *spill_partitions[i];
+        std::unique_lock partition_lock(partition.mu);
+        partition.probe_bytes += dispatched_blocks[i].bytes();
+        partition.probe_blocks.push_back(std::move(dispatched_blocks[i]));
+        if (hash_join_spill_context->updatePartitionRevocableMemory(i, partition.probe_bytes))
+            markProbeSideSpillData(i, partition.trySpillProbeBlocks(), stream_index);
+    }
+    if (auto_spill_trigger != nullptr)
+        auto_spill_trigger->triggerAutoSpill();
+}
+
+void HashJoin::dispatchProbeBlockByFineGrainedShuffle(const Block & block, JoinProbeBlocks & probe_blocks) const
+{
+    /// The build side of stream i only contains the rows of fine grained shuffle partition i, so the probe rows
+    /// must be dispatched with the same hash as the exchange sender to find the matched hash table.
+    Block materialized_block = materializeBlock(block);
+    size_t rows = materialized_block.rows();
+    Columns materialized_columns;
+    ColumnRawPtrs key_columns
+        = extractAndMaterializeKeyColumns(materialized_block, materialized_columns, original_key_names_left);
+    std::vector<String> sort_key_containers(key_columns.size());
+    WeakHash32 hash(0);
+    computeDispatchHash(rows, key_columns, collators, sort_key_containers, 0, hash);
+
+    size_t hash_table_count = pointer_tables.size();
+    const auto & hash_data = hash.getData();
+    IColumn::Selector selector(rows);
+    if (fine_grained_shuffle_count != hash_table_count)
+    {
+        for (size_t i = 0; i < rows; ++i)
+            selector[i] = (hash_data[i] % fine_grained_shuffle_count) % hash_table_count;
+    }
+    else if ((hash_table_count & (hash_table_count - 1)) == 0)
+    {
+        for (size_t i = 0; i < rows; ++i)
+            selector[i] = hash_data[i] & (hash_table_count - 1);
+    }
+    else
+    {
+        for (size_t i = 0; i < rows; ++i)
+            selector[i] = hash_data[i] % hash_table_count;
+    }
+
+    Blocks dispatched_blocks(hash_table_count);
+    for (auto & dispatched_block : dispatched_blocks)
+        dispatched_block = materialized_block.cloneEmpty();
+    size_t columns = materialized_block.columns();
+    for (size_t i = 0; i < columns; ++i)
+    {
+        auto dispatched_columns = materialized_block.getByPosition(i).column->scatter(hash_table_count, selector);
+        for (size_t j = 0; j < hash_table_count; ++j)
+            dispatched_blocks[j].getByPosition(i).column = std::move(dispatched_columns[j]);
+    }
+    for (size_t i = 0; i < hash_table_count; ++i)
+    {
+        if (dispatched_blocks[i].rows() > 0)
+            probe_blocks.push_back({std::move(dispatched_blocks[i]), i});
+    }
+}
+
+bool HashJoin::hasProbeSideMarkedSpillData(size_t stream_index) const
+{
+    if (!isEnableSpill())
+        return false;
+    return !probe_side_marked_spilled_data[stream_index].empty();
+}
+
+void HashJoin::flushProbeSideMarkedSpillData(size_t stream_index)
+{
+    auto & data = probe_side_marked_spilled_data[stream_index];
+    for (auto & [partition_index, blocks] : data)
+    {
+        hash_join_spill_context->getProbeSpiller()->spillBlocks(std::move(blocks), partition_index);
+        hash_join_spill_context->finishOneSpill(partition_index);
+    }
+    data.clear();
+}
+
+void HashJoin::finalizeProbe()
+{
+    if (hash_join_spill_context->getProbeSpiller())
+        hash_join_spill_context->getProbeSpiller()->finishSpill();
+    probe_finished = true;
+    wait_probe_finished_future->finish();
+}
+
+bool HashJoin::isProbeFinishedForPipeline() const
+{
+    if (!probe_finished)
+    {
+        setNotifyFuture(wait_probe_finished_future.get());
+        return false;
+    }
+    return true;
+}
+
+HashJoinPtr HashJoin::createRestoreJoin() const
+{
+    auto ret = std::make_shared<HashJoin>(
+        key_names_left,
+        key_names_right,
+        kind,
+        join_req_id,
+        output_columns,
+        collators,
+        non_equal_conditions,
+        settings,
+        match_helper_name,
+        /// The restored partition is dispatched by the spill hash, it is not related to fine grained shuffle.
+        0,
+        /// The restore join does not spill again
+        0,
+        hash_join_spill_context->createBuildSpillConfig(fmt::format("{}_{}_build", join_req_id, restore_round + 1)),
+        hash_join_spill_context->createProbeSpillConfig(fmt::format("{}_{}_probe", join_req_id, restore_round + 1)),
+        nullptr,
+        nullptr,
+        restore_round + 1);
+    /// Init output names after finalize, the restored join doesn't need to finalize.
+    ret->output_columns_after_finalize = output_columns_after_finalize;
+    ret->output_block_after_finalize = output_block_after_finalize;
+    ret->output_column_names_set_after_finalize = output_column_names_set_after_finalize;
+    ret->output_columns_names_set_for_other_condition_after_finalize
+        = output_columns_names_set_for_other_condition_after_finalize;
+    ret->required_columns = required_columns;
+    ret->required_columns_names_set_for_other_condition = required_columns_names_set_for_other_condition;
+    ret->finalized = true;
+    return ret;
+}
+
+std::optional<HashJoinRestoreInfo> HashJoin::getOneRestoreInfo()
+{
+    size_t partition_index;
+    {
+        std::unique_lock lock(spill_mu);
+        if (remaining_partitions_to_restore.empty())
+            return {};
+        partition_index = remaining_partitions_to_restore.front();
+        remaining_partitions_to_restore.pop_front();
+    }
+    RUNTIME_CHECK_MSG(
+        hash_join_spill_context->isPartitionSpilled(partition_index),
+        "should not restore unspilled partition.");
+    LOG_INFO(
+        log,
+        "Begin restore data from disk for hash join, partition {}, restore round {}.",
+        partition_index,
+        restore_round);
+
+    auto build_streams = hash_join_spill_context->getBuildSpiller()->restoreBlocks(partition_index, 1, true);
+    RUNTIME_CHECK(build_streams.size() == 1);
+    auto probe_streams = hash_join_spill_context->getProbeSpiller()->restoreBlocks(partition_index, 1, true);
+    RUNTIME_CHECK(probe_streams.size() == 1);
+
+    auto restore_join = createRestoreJoin();
+    restore_join->initBuild(build_sample_block, 1);
+    restore_join->initProbe(probe_sample_block, 1);
+    return HashJoinRestoreInfo{restore_join, partition_index, build_streams[0], probe_streams[0]};
+}
+
 Block HashJoin::probeBlock(JoinProbeContext & ctx, size_t stream_index)
 {
     RUNTIME_ASSERT(stream_index < probe_concurrency);
@@ -636,12 +1165,22 @@ Block HashJoin::probeBlock(JoinProbeContext & ctx, size_t stream_index)
     FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_join_prob_failpoint);
 
     auto & wd = probe_workers_data[stream_index];
-    Block res = join_probe_helper->probe(ctx, wd);
+    RUNTIME_ASSERT(ctx.hash_table_index < join_probe_helpers.size());
+    Block res = join_probe_helpers[ctx.hash_table_index]->probe(ctx, wd);
     if (ctx.isAllFinished())
         wd.probe_handle_rows += ctx.rows;
     return res;
 }
 
+Block HashJoin::scanBuildSideAfterProbe(size_t stream_index)
+{
+    RUNTIME_ASSERT(stream_index < probe_concurrency);
+    RUNTIME_CHECK_MSG(probe_finished, "Logical error: Join probe is not finished");
+    RUNTIME_CHECK(join_scan_build_side_helper != nullptr);
+
+    return join_scan_build_side_helper->scan(probe_workers_data[stream_index]);
+}
+
 Block HashJoin::probeLastResultBlock(size_t stream_index)
 {
     auto & wd = probe_workers_data[stream_index];
@@ -17,19 +17,43 @@
 #include <Common/Arena.h>
 #include <Common/Logger.h>
 #include <Core/Block.h>
+#include <Core/OperatorSpillContext.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/JoinInterpreterHelper.h>
 #include <Interpreters/ExpressionActions.h>
+#include <Interpreters/HashJoinSpillContext.h>
+#include <Interpreters/JoinUtils.h>
 #include <Interpreters/JoinV2/HashJoinBuild.h>
 #include <Interpreters/JoinV2/HashJoinKey.h>
 #include <Interpreters/JoinV2/HashJoinPointerTable.h>
 #include <Interpreters/JoinV2/HashJoinProbe.h>
 #include <Interpreters/JoinV2/HashJoinRowLayout.h>
 #include <Interpreters/JoinV2/HashJoinSettings.h>
+#include <Interpreters/JoinV2/HashJoinSpill.h>
+
+#include <deque>
+#include <mutex>
+#include <optional>
 
 
 namespace DB
 {
+class AutoSpillTrigger;
+class OneTimeNotifyFuture;
+using OneTimeNotifyFuturePtr = std::shared_ptr<OneTimeNotifyFuture>;
+
+class HashJoin;
+using HashJoinPtr = std::shared_ptr<HashJoin>;
+
+/// A spilled partition and the join used to restore it.
+/// The restore join is built and probed by exactly one probe worker.
+struct HashJoinRestoreInfo
+{
+    HashJoinPtr join;
+    size_t partition_index;
+    BlockInputStreamPtr build_stream;
+    BlockInputStreamPtr probe_stream;
+};
 
 class HashJoin
 {
@@ -42,8 +66,15 @@ public:
         const NamesAndTypes & output_columns_,
         const TiDB::TiDBCollators & collators_,
         const JoinNonEqualConditions & non_equal_conditions_,
-        const Settings & settings,
-        const String & match_helper_name_);
+        const HashJoinSettings & settings_,
+        const String & match_helper_name_,
+        size_t fine_grained_shuffle_count_,
+        UInt64 max_bytes_before_external_join_,
+        const SpillConfig & build_spill_config_,
+        const SpillConfig & probe_spill_config_,
+        const RegisterOperatorSpillContext & register_operator_spill_context_,
+        AutoSpillTrigger * auto_spill_trigger_,
+        size_t restore_round_ = 0);
 
     void initBuild(const Block & sample_block, size_t build_concurrency_ = 1);
 
@@ -55,11 +86,22 @@ public:
     bool finishOneProbe(size_t stream_index);
 
     void buildRowFromBlock(const Block & block, size_t stream_index);
+    /// Insert one of the build blocks kept in memory after spill into the row containers.
+    /// Return false if there is no block left to insert.
+    bool insertOneBuildBlockKeptInMemory(size_t stream_index);
+    /// Return false and set the notify future if the build blocks kept in memory are still being inserted by other streams.
+    bool isBuildBlocksKeptInMemoryInsertedForPipeline() const;
+    /// Must be called after all the build blocks kept in memory are inserted.
     bool buildPointerTable(size_t stream_index);
 
     Block probeBlock(JoinProbeContext & ctx, size_t stream_index);
     Block probeLastResultBlock(size_t stream_index);
 
+    /// Right outer/semi/anti join need to scan the build side after all the probe workers finish.
+    bool needScanBuildSideAfterProbe() const { return needScanHashMapAfterProbe(kind); }
+    /// Return an empty block if all the rows are scanned.
+    Block scanBuildSideAfterProbe(size_t stream_index);
+
     void removeUselessColumn(Block & block) const;
     /// Block's schema must be all_sample_block_pruned.
     Block removeUselessColumnForOutput(const Block & block) const;
@@ -75,13 +117,65 @@ public:
 
     const JoinProfileInfoPtr & getProfileInfo() const { return profile_info; }
 
+    bool isEnableFineGrainedShuffle() const { return fine_grained_shuffle_count > 0; }
+    /// Return true if the probe blocks must be dispatched by `dispatchProbeBlock` before probing.
+    bool needDispatchProbeBlock() const { return isEnableFineGrainedShuffle() || isSpilled(); }
+
+    /// Spill
+    bool isEnableSpill() const { return hash_join_spill_context->isSpillEnabled(); }
+    bool isSpilled() const { return hash_join_spill_context->isSpilled(); }
+    const HashJoinSpillContextPtr & getHashJoinSpillContext() const { return hash_join_spill_context; }
+
+    void checkAndMarkPartitionSpilledIfNeeded(size_t stream_index);
+    bool hasBuildSideMarkedSpillData(size_t stream_index) const;
+    void flushBuildSideMarkedSpillData(size_t stream_index);
+    /// Must be called by the last build row worker after its marked spill data is flushed.
+    void finalizeBuild();
+
+    /// Dispatch the probe block by the fine grained shuffle partition or the spill partition.
+    /// The blocks to probe are appended to `probe_blocks` with the index of the hash table they should be probed with.
+    /// Blocks of the spilled partitions are buffered or marked for spill.
+    void dispatchProbeBlock(const Block & block, JoinProbeBlocks & probe_blocks, size_t stream_index);
+    bool hasProbeSideMarkedSpillData(size_t stream_index) const;
+    void flushProbeSideMarkedSpillData(size_t stream_index);
+    /// Must be called by the last probe worker after its marked spill data is flushed.
+    void finalizeProbe();
+    bool isProbeFinishedForPipeline() const;
+
+    std::optional<HashJoinRestoreInfo> getOneRestoreInfo();
+
+    OneTimeNotifyFuturePtr wait_probe_finished_future;
+    /// Finished once all the build blocks kept in memory are inserted.
+    OneTimeNotifyFuturePtr wait_build_blocks_inserted_future;
+
 private:
     void initRowLayoutAndHashJoinMethod();
 
-    void workAfterBuildRowFinish();
+    void workAfterBuildRowFinish(size_t stream_index);
+    void workAfterProbeFinish(size_t stream_index);
+
+    void insertBlockToRowContainersForBuild(const Block & block, size_t stream_index);
+
+    /// There is one hash table per build stream if fine grained shuffle is enabled, otherwise only one.
+    size_t getHashTableIndex(size_t stream_index) const { return isEnableFineGrainedShuffle() ? stream_index : 0; }
+    void dispatchProbeBlockByFineGrainedShuffle(const Block & block, JoinProbeBlocks & probe_blocks) const;
+
+    /// Spill
+    Blocks dispatchBlockForSpill(const Names & key_names, const Block & block) const;
+    void bufferBuildBlockForSpill(const Block & block, size_t stream_index);
+    void checkAndMarkPartitionSpilledIfNeededInternal(
+        HashJoinSpillPartition & partition,
+        size_t partition_index,
+        size_t stream_index);
+    void spillMostMemoryUsedPartitionIfNeeded(size_t stream_index);
+    void markBuildSideSpillData(size_t partition_index, Blocks && blocks, size_t stream_index);
+    void markProbeSideSpillData(size_t partition_index, Blocks && blocks, size_t stream_index);
+    void finishBuildSpill(size_t stream_index);
+    HashJoinPtr createRestoreJoin() const;
 
 private:
     friend JoinProbeHelper;
+    friend JoinScanBuildSideHelper;
 
     static const DataTypePtr match_helper_type;
 
@@ -92,6 +186,9 @@ private:
     Names key_names_left;
     /// Names of key columns (columns for equi-JOIN) in "right" table (in the order they appear in USING clause).
     Names key_names_right;
+    /// key_names_left is reordered when initializing the row layout, but the fine grained shuffle
+    /// partition must be computed with the keys in the original order.
+    const Names original_key_names_left;
 
     /// collators for the join key
     const TiDB::TiDBCollators collators;
@@ -103,6 +200,8 @@ private:
     // only use for left outer semi joins.
     const String match_helper_name;
 
+    const size_t fine_grained_shuffle_count;
+
     const LoggerPtr log;
 
     const bool has_other_condition;
@@ -136,28 +235,59 @@ private:
     NameSet required_columns_names_set_for_other_condition;
     bool finalized = false;
 
-    /// Row containers
-    std::vector<std::unique_ptr<MultipleRowContainer>> multi_row_containers;
+    /// Row containers of each hash table
+    std::vector<std::vector<std::unique_ptr<MultipleRowContainer>>> multi_row_containers;
 
     /// Build row phase
     size_t build_concurrency = 0;
     std::vector<JoinBuildWorkerData> build_workers_data;
     std::atomic<size_t> active_build_worker = 0;
 
-    HashJoinPointerTable pointer_table;
+    std::vector<std::unique_ptr<HashJoinPointerTable>> pointer_tables;
 
     /// Probe phase
     size_t probe_concurrency = 0;
     std::vector<JoinProbeWorkerData> probe_workers_data;
     std::atomic<size_t> active_probe_worker = 0;
-    std::unique_ptr<JoinProbeHelper> join_probe_helper;
+    std::vector<std::unique_ptr<JoinProbeHelper>> join_probe_helpers;
+
+    /// Scan build side phase
+    std::unique_ptr<JoinScanBuildSideHelper> join_scan_build_side_helper;
+    std::mutex not_inserted_blocks_mu;
+    /// The build rows that are not inserted into the hash table, i.e. the rows with null keys
+    /// or filtered by the build filter. Right outer/anti join output them when scanning the build side.
+    Blocks not_inserted_blocks;
 
     const JoinProfileInfoPtr profile_info = std::make_shared<JoinProfileInfo>();
 
     /// For other condition
     BoolVec left_required_flag_for_other_condition;
-};
 
-using HashJoinPtr = std::shared_ptr<HashJoin>;
+    /// Spill
+    const HashJoinSpillContextPtr hash_join_spill_context;
+    const RegisterOperatorSpillContext register_operator_spill_context;
+    AutoSpillTrigger * const auto_spill_trigger;
+    const size_t restore_round;
+
+    /// The original input headers, used to init the restore joins.
+    Block build_sample_block;
+    Block probe_sample_block;
+
+    HashJoinSpillPartitions spill_partitions;
+    /// <partition index, blocks> marked to spill by each worker.
+    using MarkedSpillData = std::vector<std::pair<size_t, Blocks>>;
+    std::vector<MarkedSpillData> build_side_marked_spilled_data;
+    std::vector<MarkedSpillData> probe_side_marked_spilled_data;
+
+    std::mutex spill_mu;
+    /// Build blocks of the partitions that are not spilled, they are converted to rows before building the pointer table.
+    Blocks build_blocks_to_insert;
+    std::atomic<size_t> build_blocks_to_insert_index = 0;
+    std::atomic<size_t> build_blocks_inserted_count = 0;
+    /// The tagged pointer is decided once all the rows of `build_blocks_to_insert` are inserted.
+    std::once_flag decide_tagged_pointer_flag;
+    std::deque<size_t> remaining_partitions_to_restore;
+    std::atomic<bool> probe_finished = false;
+};
 
 } // namespace DB
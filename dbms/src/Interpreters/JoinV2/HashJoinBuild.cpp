@@ -23,7 +23,7 @@ extern const int UNKNOWN_SET_DATA_VARIANT;
 } // namespace ErrorCodes
 
 
-template <typename KeyGetter, bool has_null_map, bool need_record_null_rows>
+template <typename KeyGetter, bool has_null_map>
 void NO_INLINE insertBlockToRowContainersTypeImpl(
     Block & block,
     size_t rows,
@@ -72,25 +72,17 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             block.getByPosition(index).column->countSerializeByteSize(wd.row_sizes);
     }
 
+    const size_t matched_flag_size = row_layout.has_matched_flag ? ROW_MATCHED_FLAG_SIZE : 0;
     for (size_t i = 0; i < rows; ++i)
     {
+        /// The rows with null keys are recorded by the caller if they are needed after probe.
         if (has_null_map && (*null_map)[i])
-        {
-            if constexpr (need_record_null_rows)
-            {
-                //TODO
-                //wd.row_sizes[i] += sizeof(RowPtr);
-                //wd.row_sizes[i] = alignRowSize(wd.row_sizes[i]);
-                //wd.partition_row_sizes[part_count - 1] += wd.row_sizes[i];
-                //++wd.partition_row_count[part_count - 1];
-            }
             continue;
-        }
         const auto & key = key_getter.getJoinKeyWithBuffer(i);
         wd.hashes[i] = static_cast<HashValueType>(Hash()(key));
         size_t part_num = getJoinBuildPartitionNum<HashValueType>(wd.hashes[i]);
 
-        size_t ptr_and_key_size = sizeof(RowPtr) + key_getter.getJoinKeyByteSize(key);
+        size_t ptr_and_key_size = matched_flag_size + sizeof(RowPtr) + key_getter.getJoinKeyByteSize(key);
         if constexpr (KeyGetterType::joinKeyCompareHashFirst())
         {
             ptr_and_key_size += sizeof(HashValueType);
@@ -133,6 +125,7 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
         {
             auto & container = partition_column_row[i];
             container.data.resize(wd.partition_row_sizes[i], CPU_CACHE_LINE_SIZE);
+            container.matched_flag_size = matched_flag_size;
             wd.enable_tagged_pointer &= isRowPtrTagZero(container.data.data());
             wd.enable_tagged_pointer &= isRowPtrTagZero(container.data.data() + wd.partition_row_sizes[i]);
             RUNTIME_CHECK((reinterpret_cast<uintptr_t>(container.data.data()) & (CPU_CACHE_LINE_SIZE - 1)) == 0);
@@ -163,14 +156,7 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
         {
             if (has_null_map && (*null_map)[j])
             {
-                if constexpr (need_record_null_rows)
-                {
-                    //TODO
-                }
-                else
-                {
-                    wd.row_ptrs.push_back(nullptr);
-                }
+                wd.row_ptrs.push_back(nullptr);
                 continue;
             }
             size_t part_num = getJoinBuildPartitionNum<HashValueType>(wd.hashes[j]);
@@ -181,6 +167,11 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             wd.partition_row_sizes[part_num] += wd.row_sizes[j];
             partition_column_row[part_num].offsets.push_back(wd.partition_row_sizes[part_num]);
 
+            if (matched_flag_size > 0)
+            {
+                memset(ptr, 0, matched_flag_size);
+                ptr += matched_flag_size;
+            }
             unalignedStore<RowPtr>(ptr, nullptr);
             ptr += sizeof(RowPtr);
 
@@ -199,7 +190,7 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
         }
         for (const auto & [index, _] : row_layout.other_column_indexes)
         {
-            if constexpr (has_null_map && !need_record_null_rows)
+            if constexpr (has_null_map)
                 block.getByPosition(index).column->serializeToPos(wd.row_ptrs, start, end - start, true);
             else
                 block.getByPosition(index).column->serializeToPos(wd.row_ptrs, start, end - start, false);
@@ -215,7 +206,6 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
 
 template <typename KeyGetter>
 void insertBlockToRowContainersType(
-    bool need_record_null_rows,
     Block & block,
     size_t rows,
     const ColumnRawPtrs & key_columns,
@@ -225,38 +215,30 @@ void insertBlockToRowContainersType(
     JoinBuildWorkerData & worker_data,
     bool check_lm_row_size)
 {
-#define CALL(has_null_map, need_record_null_rows)                                       \
-    insertBlockToRowContainersTypeImpl<KeyGetter, has_null_map, need_record_null_rows>( \
-        block,                                                                          \
-        rows,                                                                           \
-        key_columns,                                                                    \
-        null_map,                                                                       \
-        row_layout,                                                                     \
-        multi_row_containers,                                                           \
-        worker_data,                                                                    \
+#define CALL(has_null_map)                                       \
+    insertBlockToRowContainersTypeImpl<KeyGetter, has_null_map>( \
+        block,                                                   \
+        rows,                                                    \
+        key_columns,                                             \
+        null_map,                                                \
+        row_layout,                                              \
+        multi_row_containers,                                    \
+        worker_data,                                             \
         check_lm_row_size);
 
     if (null_map)
     {
-        if (need_record_null_rows)
-        {
-            CALL(true, true);
-        }
-        else
-        {
-            CALL(true, false);
-        }
+        CALL(true);
     }
     else
     {
-        CALL(false, false);
+        CALL(false);
     }
 #undef CALL
 }
 
 void insertBlockToRowContainers(
     HashJoinKeyMethod method,
-    bool need_record_null_rows,
     Block & block,
     size_t rows,
     const ColumnRawPtrs & key_columns,
@@ -272,7 +254,6 @@ void insertBlockToRowContainers(
     case HashJoinKeyMethod::METHOD:                                                        \
         using KeyGetterType##METHOD = HashJoinKeyGetterForType<HashJoinKeyMethod::METHOD>; \
         insertBlockToRowContainersType<KeyGetterType##METHOD>(                             \
-            need_record_null_rows,                                                         \
             block,                                                                         \
             rows,                                                                          \
             key_columns,                                                                   \
@@ -75,7 +75,6 @@ struct alignas(CPU_CACHE_LINE_SIZE) JoinBuildWorkerData
 
 void insertBlockToRowContainers(
     HashJoinKeyMethod method,
-    bool need_record_null_rows,
     Block & block,
     size_t rows,
     const ColumnRawPtrs & key_columns,
@@ -57,6 +57,8 @@ public:
 
     bool enableProbePrefetch() const { return enable_probe_prefetch; }
     bool enableTaggedPointer() const { return enable_tagged_pointer; }
+    /// Must be called before `build`.
+    void setEnableTaggedPointer(bool enable_tagged_pointer_) { enable_tagged_pointer = enable_tagged_pointer_; }
 
     RowPtr getHeadPointer(UInt64 hash) const
     {
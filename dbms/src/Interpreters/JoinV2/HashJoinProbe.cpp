@@ -45,15 +45,16 @@ bool JoinProbeContext::isProbeFinished() const
 bool JoinProbeContext::isAllFinished() const
 {
     return isProbeFinished()
-        // For left outer with other conditions
+        // For left outer/(left outer) (anti) semi join with other conditions
         && rows_not_matched.empty();
 }
 
-void JoinProbeContext::resetBlock(Block & block_)
+void JoinProbeContext::resetBlock(Block & block_, size_t hash_table_index_)
 {
     block = block_;
     orignal_block = block_;
     rows = block.rows();
+    hash_table_index = hash_table_index_;
     current_row_idx = 0;
     current_build_row_ptr = nullptr;
     current_row_is_matched = false;
@@ -112,7 +113,7 @@ void JoinProbeContext::prepareForHashProbe(
 
     assertBlocksHaveEqualStructure(block, sample_block_pruned, "Join Probe");
 
-    if (kind == LeftOuter && has_other_condition)
+    if ((kind == LeftOuter || isSemiFamily(kind) || isLeftOuterSemiFamily(kind)) && has_other_condition)
     {
         rows_not_matched.clear();
         rows_not_matched.resize_fill(rows, 1);
@@ -415,10 +416,126 @@ struct JoinProbeAdder<LeftOuterAnti, false, false>
     static void flush(JoinProbeHelper &, JoinProbeWorkerData &, MutableColumns &) {}
 };
 
-JoinProbeHelper::JoinProbeHelper(const HashJoin * join, bool late_materialization)
+/// (Left outer) (anti) semi join with other conditions need all the matched rows to evaluate the other conditions.
+template <bool late_materialization>
+struct JoinProbeAdder<Semi, true, late_materialization> : public JoinProbeAdder<Inner, true, late_materialization>
+{
+};
+
+template <bool late_materialization>
+struct JoinProbeAdder<Anti, true, late_materialization> : public JoinProbeAdder<Inner, true, late_materialization>
+{
+};
+
+template <bool late_materialization>
+struct JoinProbeAdder<LeftOuterSemi, true, late_materialization>
+    : public JoinProbeAdder<Inner, true, late_materialization>
+{
+};
+
+template <bool late_materialization>
+struct JoinProbeAdder<LeftOuterAnti, true, late_materialization>
+    : public JoinProbeAdder<Inner, true, late_materialization>
+{
+};
+
+template <bool has_other_condition, bool late_materialization>
+struct JoinProbeAdder<RightOuter, has_other_condition, late_materialization>
+{
+    static constexpr bool need_matched = true;
+    static constexpr bool need_not_matched = false;
+    static constexpr bool break_on_first_match = false;
+
+    static bool ALWAYS_INLINE addMatched(
+        JoinProbeHelper & helper,
+        JoinProbeContext &,
+        JoinProbeWorkerData & wd,
+        MutableColumns & added_columns,
+        size_t idx,
+        size_t & current_offset,
+        RowPtr row_ptr,
+        size_t ptr_offset)
+    {
+        /// The build row is flagged after the other conditions are evaluated.
+        if constexpr (has_other_condition)
+            wd.selective_build_row_ptrs.push_back(row_ptr);
+        else
+            setRowMatched(row_ptr);
+        ++current_offset;
+        wd.selective_offsets.push_back(idx);
+        helper.insertRowToBatch<late_materialization>(wd, added_columns, row_ptr + ptr_offset);
+        return current_offset >= helper.settings.max_block_size;
+    }
+
+    static bool ALWAYS_INLINE
+    addNotMatched(JoinProbeHelper &, JoinProbeContext &, JoinProbeWorkerData &, size_t, size_t &)
+    {
+        return false;
+    }
+
+    static void flush(JoinProbeHelper & helper, JoinProbeWorkerData & wd, MutableColumns & added_columns)
+    {
+        helper.flushInsertBatch<late_materialization, true>(wd, added_columns);
+        helper.fillNullMapWithZero<late_materialization>(added_columns);
+    }
+};
+
+/// Right semi/anti join without other conditions only flag the matched build rows, the result is
+/// generated when scanning the build side after probe.
+template <>
+struct JoinProbeAdder<RightSemi, false, false>
+{
+    static constexpr bool need_matched = true;
+    static constexpr bool need_not_matched = false;
+    static constexpr bool break_on_first_match = false;
+
+    static bool ALWAYS_INLINE addMatched(
+        JoinProbeHelper &,
+        JoinProbeContext &,
+        JoinProbeWorkerData &,
+        MutableColumns &,
+        size_t,
+        size_t &,
+        RowPtr row_ptr,
+        size_t)
+    {
+        setRowMatched(row_ptr);
+        return false;
+    }
+
+    static bool ALWAYS_INLINE
+    addNotMatched(JoinProbeHelper &, JoinProbeContext &, JoinProbeWorkerData &, size_t, size_t &)
+    {
+        return false;
+    }
+
+    static void flush(JoinProbeHelper &, JoinProbeWorkerData &, MutableColumns &) {}
+};
+
+template <>
+struct JoinProbeAdder<RightAnti, false, false> : public JoinProbeAdder<RightSemi, false, false>
+{
+};
+
+template <bool late_materialization>
+struct JoinProbeAdder<RightSemi, true, late_materialization>
+    : public JoinProbeAdder<RightOuter, true, late_materialization>
+{
+};
+
+template <bool late_materialization>
+struct JoinProbeAdder<RightAnti, true, late_materialization>
+    : public JoinProbeAdder<RightOuter, true, late_materialization>
+{
+};
+
+JoinProbeHelper::JoinProbeHelper(
+    const HashJoin * join,
+    const HashJoinPointerTable & pointer_table,
+    bool late_materialization)
     : JoinProbeHelperUtil(join->settings, join->row_layout)
     , join(join)
-    , pointer_table(join->pointer_table)
+    , pointer_table(pointer_table)
 {
 #define CALL3(KeyGetter, JoinType, has_other_condition, late_materialization, tagged_pointer)                       \
     {                                                                                                               \
@@ -454,19 +571,24 @@ JoinProbeHelper::JoinProbeHelper(const HashJoin * join, bool late_materializatio
 #define CALL(KeyGetter)                                                                                    \
     {                                                                                                      \
         auto kind = join->kind;                                                                            \
-        bool has_other_condition = join->has_other_condition;                                              \
         if (kind == Inner)                                                                                 \
             CALL1(KeyGetter, Inner)                                                                        \
         else if (kind == LeftOuter)                                                                        \
             CALL1(KeyGetter, LeftOuter)                                                                    \
-        else if (kind == Semi && !has_other_condition)                                                     \
-            CALL2(KeyGetter, Semi, false, false)                                                           \
-        else if (kind == Anti && !has_other_condition)                                                     \
-            CALL2(KeyGetter, Anti, false, false)                                                           \
-        else if (kind == LeftOuterSemi && !has_other_condition)                                            \
-            CALL2(KeyGetter, LeftOuterSemi, false, false)                                                  \
-        else if (kind == LeftOuterAnti && !has_other_condition)                                            \
-            CALL2(KeyGetter, LeftOuterAnti, false, false)                                                  \
+        else if (kind == Semi)                                                                             \
+            CALL1(KeyGetter, Semi)                                                                         \
+        else if (kind == Anti)                                                                             \
+            CALL1(KeyGetter, Anti)                                                                         \
+        else if (kind == LeftOuterSemi)                                                                    \
+            CALL1(KeyGetter, LeftOuterSemi)                                                                \
+        else if (kind == LeftOuterAnti)                                                                    \
+            CALL1(KeyGetter, LeftOuterAnti)                                                                \
+        else if (kind == RightOuter)                                                                       \
+            CALL1(KeyGetter, RightOuter)                                                                   \
+        else if (kind == RightSemi)                                                                        \
+            CALL1(KeyGetter, RightSemi)                                                                    \
+        else if (kind == RightAnti)                                                                        \
+            CALL1(KeyGetter, RightAnti)                                                                    \
         else                                                                                               \
             throw Exception(                                                                               \
                 fmt::format("Logical error: unknown combination of JOIN {}", magic_enum::enum_name(kind)), \
@@ -515,6 +637,12 @@ Block JoinProbeHelper::probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & w
         if (ctx.isProbeFinished())
             return fillNotMatchedRowsForLeftOuter(ctx, wd);
     }
+    if constexpr (
+        (kind == Semi || kind == Anti || kind == LeftOuterSemi || kind == LeftOuterAnti) && has_other_condition)
+    {
+        if (ctx.isProbeFinished())
+            return genResultBlockForSemi(ctx, wd);
+    }
     if constexpr (kind == LeftOuterSemi || kind == LeftOuterAnti)
     {
         // Sanity check
@@ -535,6 +663,11 @@ Block JoinProbeHelper::probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & w
         wd.row_ptrs_for_lm.clear();
         wd.row_ptrs_for_lm.reserve(settings.max_block_size);
     }
+    if constexpr ((kind == RightOuter || kind == RightSemi || kind == RightAnti) && has_other_condition)
+    {
+        wd.selective_build_row_ptrs.clear();
+        wd.selective_build_row_ptrs.reserve(settings.max_block_size);
+    }
 
     size_t left_columns = join->left_sample_block_pruned.columns();
     size_t right_columns = join->right_sample_block_pruned.columns();
@@ -574,17 +707,14 @@ Block JoinProbeHelper::probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & w
     for (size_t i = 0; i < right_columns; ++i)
         wd.result_block.safeGetByPosition(left_columns + i).column = std::move(added_columns[i]);
 
-    if constexpr (kind == Inner || kind == LeftOuter || kind == Semi || kind == Anti)
-    {
-        if (wd.selective_offsets.empty())
-            return join->output_block_after_finalize;
-    }
-
-    if constexpr (kind == LeftOuterSemi || kind == LeftOuterAnti)
+    if constexpr ((kind == LeftOuterSemi || kind == LeftOuterAnti) && !has_other_condition)
     {
         return genResultBlockForLeftOuterSemi(ctx);
     }
 
+    if (wd.selective_offsets.empty())
+        return join->output_block_after_finalize;
+
     if constexpr (has_other_condition)
     {
         // Always using late materialization for left side columns
@@ -1039,7 +1169,18 @@ Block JoinProbeHelper::handleOtherConditions(
     mergeNullAndFilterResult(exec_block, wd.filter, non_equal_conditions.other_cond_name, false);
     exec_block.clear();
 
-    if (kind == LeftOuter)
+    SCOPE_EXIT({
+        RUNTIME_CHECK(wd.result_block.columns() == left_columns + right_columns);
+        /// Clear the data in result_block.
+        for (size_t i = 0; i < left_columns + right_columns; ++i)
+        {
+            auto column = wd.result_block.getByPosition(i).column->assumeMutable();
+            column->popBack(column->size());
+            wd.result_block.getByPosition(i).column = std::move(column);
+        }
+    });
+
+    if (kind == LeftOuter || isSemiFamily(kind) || isLeftOuterSemiFamily(kind))
     {
         RUNTIME_CHECK(wd.selective_offsets.size() == rows);
         RUNTIME_CHECK(wd.filter.size() == rows);
@@ -1050,6 +1191,24 @@ Block JoinProbeHelper::handleOtherConditions(
             ctx.rows_not_matched[idx] &= !is_matched;
         }
     }
+    else if (isRightOuterJoin(kind) || isRightSemiFamily(kind))
+    {
+        RUNTIME_CHECK(wd.selective_build_row_ptrs.size() == rows);
+        RUNTIME_CHECK(wd.filter.size() == rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if (wd.filter[i])
+                setRowMatched(wd.selective_build_row_ptrs[i]);
+        }
+    }
+
+    if (isSemiFamily(kind) || isLeftOuterSemiFamily(kind) || isRightSemiFamily(kind))
+    {
+        /// The joined rows are only used to evaluate the other conditions.
+        if (!isRightSemiFamily(kind) && ctx.isProbeFinished())
+            return genResultBlockForSemi(ctx, wd);
+        return output_block_after_finalize;
+    }
 
     join->initOutputBlock(wd.result_block_for_other_condition);
 
@@ -1212,17 +1371,6 @@ Block JoinProbeHelper::handleOtherConditions(
         }
     };
 
-    SCOPE_EXIT({
-        RUNTIME_CHECK(wd.result_block.columns() == left_columns + right_columns);
-        /// Clear the data in result_block.
-        for (size_t i = 0; i < left_columns + right_columns; ++i)
-        {
-            auto column = wd.result_block.getByPosition(i).column->assumeMutable();
-            column->popBack(column->size());
-            wd.result_block.getByPosition(i).column = std::move(column);
-        }
-    });
-
     size_t length = std::min(result_size, remaining_insert_size);
     fill_matched(0, length);
     if (result_size >= remaining_insert_size)
@@ -1339,7 +1487,6 @@ Block JoinProbeHelper::fillNotMatchedRowsForLeftOuter(JoinProbeContext & ctx, Jo
 Block JoinProbeHelper::genResultBlockForLeftOuterSemi(JoinProbeContext & ctx)
 {
     RUNTIME_CHECK(join->kind == LeftOuterSemi || join->kind == LeftOuterAnti);
-    RUNTIME_CHECK(!join->has_other_condition);
     RUNTIME_CHECK(ctx.isProbeFinished());
 
     Block res_block = join->output_block_after_finalize.cloneEmpty();
@@ -1363,4 +1510,205 @@ Block JoinProbeHelper::genResultBlockForLeftOuterSemi(JoinProbeContext & ctx)
     return res_block;
 }
 
+Block JoinProbeHelper::genResultBlockForSemi(JoinProbeContext & ctx, JoinProbeWorkerData & wd)
+{
+    RUNTIME_CHECK(isSemiFamily(join->kind) || isLeftOuterSemiFamily(join->kind));
+    RUNTIME_CHECK(join->has_other_condition);
+    RUNTIME_CHECK(ctx.isProbeFinished());
+    RUNTIME_CHECK(ctx.rows_not_matched.size() == ctx.rows);
+
+    /// JoinProbeContext::isAllFinished checks if the result has been generated by verifying whether
+    /// rows_not_matched is empty.
+    SCOPE_EXIT({ ctx.rows_not_matched.clear(); });
+
+    if (join->kind == LeftOuterSemi || join->kind == LeftOuterAnti)
+    {
+        RUNTIME_CHECK(ctx.left_semi_match_res.size() == ctx.rows);
+        /// The result is never NULL because the rows that the other conditions return NULL are treated as not matched.
+        bool is_semi = join->kind == LeftOuterSemi;
+        for (size_t i = 0; i < ctx.rows; ++i)
+            ctx.left_semi_match_res[i] = is_semi ^ static_cast<bool>(ctx.rows_not_matched[i]);
+        return genResultBlockForLeftOuterSemi(ctx);
+    }
+
+    bool is_semi = join->kind == Semi;
+    wd.filter.resize(ctx.rows);
+    for (size_t i = 0; i < ctx.rows; ++i)
+        wd.filter[i] = is_semi ^ static_cast<bool>(ctx.rows_not_matched[i]);
+    size_t result_size = countBytesInFilter(wd.filter);
+    if (result_size == 0)
+        return join->output_block_after_finalize;
+
+    Block res_block = join->output_block_after_finalize.cloneEmpty();
+    size_t columns = res_block.columns();
+    for (size_t i = 0; i < columns; ++i)
+    {
+        auto & des_column = res_block.getByPosition(i);
+        des_column.column = ctx.block.getByName(des_column.name).column->filter(wd.filter, result_size);
+    }
+    return res_block;
+}
+
+JoinScanBuildSideHelper::JoinScanBuildSideHelper(HashJoin * join)
+    : JoinProbeHelperUtil(join->settings, join->row_layout)
+    , join(join)
+{
+    RUNTIME_CHECK(row_layout.has_matched_flag);
+    /// The key getter is only used to deserialize the keys in the rows, so it is reset with the empty key columns.
+    ColumnRawPtrs key_columns
+        = extractAndMaterializeKeyColumns(join->right_sample_block, materialized_key_columns, join->key_names_right);
+    ColumnPtr null_map_holder;
+    ConstNullMapPtr null_map{};
+    extractNestedColumnsAndNullMap(key_columns, null_map_holder, null_map);
+    build_key_getter = createHashJoinKeyGetter(join->method, join->collators);
+    resetHashJoinKeyGetter(join->method, build_key_getter, key_columns, row_layout);
+
+    switch (join->method)
+    {
+#define M(METHOD)                                                                          \
+    case HashJoinKeyMethod::METHOD:                                                        \
+        using KeyGetterType##METHOD = HashJoinKeyGetterForType<HashJoinKeyMethod::METHOD>; \
+        if (join->kind == RightSemi)                                                       \
+            func_ptr = &JoinScanBuildSideHelper::scanImpl<KeyGetterType##METHOD, true>;    \
+        else                                                                               \
+            func_ptr = &JoinScanBuildSideHelper::scanImpl<KeyGetterType##METHOD, false>;   \
+        break;
+        APPLY_FOR_HASH_JOIN_VARIANTS(M)
+#undef M
+
+    default:
+        throw Exception(
+            fmt::format("Unknown JOIN keys variant {}.", magic_enum::enum_name(join->method)),
+            ErrorCodes::UNKNOWN_SET_DATA_VARIANT);
+    }
+}
+
+Block JoinScanBuildSideHelper::scan(JoinProbeWorkerData & wd)
+{
+    return (this->*func_ptr)(wd);
+}
+
+RowContainer * JoinScanBuildSideHelper::getNextContainer(JoinProbeWorkerData & wd)
+{
+    const auto & multi_row_containers = join->multi_row_containers;
+    size_t container_count = multi_row_containers.size() * JOIN_BUILD_PARTITION_COUNT;
+    for (; wd.scan_container_index < container_count; ++wd.scan_container_index)
+    {
+        size_t hash_table_index = wd.scan_container_index / JOIN_BUILD_PARTITION_COUNT;
+        size_t partition_index = wd.scan_container_index % JOIN_BUILD_PARTITION_COUNT;
+        auto * container = multi_row_containers[hash_table_index][partition_index]->getScanNext();
+        if (container != nullptr)
+            return container;
+    }
+    return nullptr;
+}
+
+template <typename KeyGetter, bool need_matched>
+Block JoinScanBuildSideHelper::scanImpl(JoinProbeWorkerData & wd)
+{
+    using KeyGetterType = typename KeyGetter::Type;
+    using HashValueType = typename KeyGetter::HashValueType;
+
+    const auto & output_block_after_finalize = join->output_block_after_finalize;
+    const auto & output_column_indexes = join->output_column_indexes;
+    size_t left_columns = join->left_sample_block_pruned.columns();
+    size_t right_columns = join->right_sample_block_pruned.columns();
+
+    if constexpr (!need_matched)
+    {
+        /// The rows that are not inserted into the hash table are never matched.
+        Block not_inserted_block;
+        {
+            std::unique_lock lock(join->not_inserted_blocks_mu);
+            auto & not_inserted_blocks = join->not_inserted_blocks;
+            if (!not_inserted_blocks.empty())
+            {
+                not_inserted_block = std::move(not_inserted_blocks.back());
+                not_inserted_blocks.pop_back();
+            }
+        }
+        if (not_inserted_block)
+        {
+            size_t rows = not_inserted_block.rows();
+            Block res_block = output_block_after_finalize.cloneEmpty();
+            for (size_t i = 0; i < left_columns; ++i)
+            {
+                auto output_index = output_column_indexes.at(i);
+                if (output_index < 0)
+                    continue;
+                res_block.getByPosition(output_index).column->assumeMutable()->insertManyDefaults(rows);
+            }
+            for (size_t i = 0; i < right_columns; ++i)
+            {
+                auto output_index = output_column_indexes.at(left_columns + i);
+                if (output_index < 0)
+                    continue;
+                res_block.getByPosition(output_index).column = not_inserted_block.getByPosition(i).column;
+            }
+            return res_block;
+        }
+    }
+
+    auto & key_getter = *static_cast<KeyGetterType *>(build_key_getter.get());
+    size_t key_offset = sizeof(RowPtr);
+    if constexpr (KeyGetterType::joinKeyCompareHashFirst())
+    {
+        key_offset += sizeof(HashValueType);
+    }
+
+    MutableColumns added_columns(right_columns);
+    for (size_t i = 0; i < right_columns; ++i)
+    {
+        added_columns[i] = join->right_sample_block_pruned.getByPosition(i).column->cloneEmpty();
+        added_columns[i]->reserveAlign(settings.max_block_size, FULL_VECTOR_SIZE_AVX2);
+    }
+
+    wd.insert_batch.clear();
+    wd.insert_batch.reserve(settings.probe_insert_batch_size);
+    size_t scan_rows = 0;
+    while (scan_rows < settings.max_block_size)
+    {
+        if (wd.scan_container == nullptr || wd.scan_row_index >= wd.scan_container->size())
+        {
+            wd.scan_container = getNextContainer(wd);
+            wd.scan_row_index = 0;
+            if (wd.scan_container == nullptr)
+                break;
+        }
+        auto * container = wd.scan_container;
+        size_t size = container->size();
+        for (; wd.scan_row_index < size && scan_rows < settings.max_block_size; ++wd.scan_row_index)
+        {
+            RowPtr row_ptr = container->getRowPtr(wd.scan_row_index);
+            if (isRowMatched(row_ptr) != need_matched)
+                continue;
+            const auto & key = key_getter.deserializeJoinKey(row_ptr + key_offset);
+            insertRowToBatch<false>(wd, added_columns, row_ptr + key_offset + key_getter.getRequiredKeyOffset(key));
+            ++scan_rows;
+        }
+    }
+    flushInsertBatch<false, true>(wd, added_columns);
+    fillNullMapWithZero<false>(added_columns);
+
+    if (scan_rows == 0)
+        return {};
+
+    Block res_block = output_block_after_finalize.cloneEmpty();
+    for (size_t i = 0; i < left_columns; ++i)
+    {
+        auto output_index = output_column_indexes.at(i);
+        if (output_index < 0)
+            continue;
+        res_block.getByPosition(output_index).column->assumeMutable()->insertManyDefaults(scan_rows);
+    }
+    for (size_t i = 0; i < right_columns; ++i)
+    {
+        auto output_index = output_column_indexes.at(left_columns + i);
+        if (output_index < 0)
+            continue;
+        res_block.getByPosition(output_index).column = std::move(added_columns[i]);
+    }
+    return res_block;
+}
+
 } // namespace DB
@@ -26,16 +26,28 @@
 #include <Parsers/ASTTablesInSelectQuery.h>
 #include <absl/base/optimization.h>
 
+#include <deque>
+
 
 namespace DB
 {
 
+/// A block to probe and the index of the hash table it is probed with.
+struct JoinProbeBlock
+{
+    Block block;
+    size_t hash_table_index = 0;
+};
+using JoinProbeBlocks = std::deque<JoinProbeBlock>;
+
 struct JoinProbeContext
 {
     Block block;
     /// original_block ensures that the reference counts for the key columns are never zero.
     Block orignal_block;
     size_t rows = 0;
+    /// The index of the hash table that the current block is probed with.
+    size_t hash_table_index = 0;
     size_t current_row_idx = 0;
     RowPtr current_build_row_ptr = nullptr;
     /// For left outer/(left outer) (anti) semi join without other conditions.
@@ -63,7 +75,7 @@ struct JoinProbeContext
 
     bool isProbeFinished() const;
     bool isAllFinished() const;
-    void resetBlock(Block & block_);
+    void resetBlock(Block & block_, size_t hash_table_index_ = 0);
 
     void prepareForHashProbe(
         HashJoinKeyMethod method,
@@ -92,6 +104,13 @@ struct alignas(CPU_CACHE_LINE_SIZE) JoinProbeWorkerData
     /// For late materialization
     RowPtrs row_ptrs_for_lm;
     RowPtrs filter_row_ptrs_for_lm;
+    /// For right outer/semi/anti join with other conditions, the matched build rows are flagged after the filter.
+    RowPtrs selective_build_row_ptrs;
+
+    /// For scanning the build side after probe
+    RowContainer * scan_container = nullptr;
+    size_t scan_container_index = 0;
+    size_t scan_row_index = 0;
 
     /// Schema: HashJoin::all_sample_block_pruned
     Block result_block;
@@ -167,7 +186,7 @@ class HashJoin;
 class JoinProbeHelper : public JoinProbeHelperUtil
 {
 public:
-    JoinProbeHelper(const HashJoin * join, bool late_materialization);
+    JoinProbeHelper(const HashJoin * join, const HashJoinPointerTable & pointer_table, bool late_materialization);
 
     Block probe(JoinProbeContext & ctx, JoinProbeWorkerData & wd);
 
@@ -191,6 +210,9 @@ private:
 
     Block genResultBlockForLeftOuterSemi(JoinProbeContext & ctx);
 
+    /// For (left outer) (anti) semi join with other conditions.
+    Block genResultBlockForSemi(JoinProbeContext & ctx, JoinProbeWorkerData & wd);
+
 private:
     template <ASTTableJoin::Kind kind, bool has_other_condition, bool late_materialization>
     friend struct JoinProbeAdder;
@@ -202,4 +224,29 @@ private:
     const HashJoinPointerTable & pointer_table;
 };
 
+/// Scan the build side after all the probe workers finish for right outer/semi/anti join.
+/// The row containers are shared by all the probe workers, each worker scans a whole container at a time.
+class JoinScanBuildSideHelper : public JoinProbeHelperUtil
+{
+public:
+    explicit JoinScanBuildSideHelper(HashJoin * join);
+
+    Block scan(JoinProbeWorkerData & wd);
+
+private:
+    template <typename KeyGetter, bool need_matched>
+    Block scanImpl(JoinProbeWorkerData & wd);
+
+    /// Return the next container to scan, nullptr if all the containers are scanned.
+    RowContainer * getNextContainer(JoinProbeWorkerData & wd);
+
+private:
+    using FuncType = Block (JoinScanBuildSideHelper::*)(JoinProbeWorkerData &);
+    FuncType func_ptr = nullptr;
+    HashJoin * join;
+    /// Only used to deserialize the join keys of the build rows.
+    Columns materialized_key_columns;
+    std::unique_ptr<void, std::function<void(void *)>> build_key_getter;
+};
+
 } // namespace DB
@@ -18,6 +18,8 @@
 #include <Storages/KVStore/Utils.h>
 #include <common/unaligned.h>
 
+#include <atomic>
+#include <deque>
 #include <vector>
 
 namespace DB
@@ -25,9 +27,10 @@ namespace DB
 
 /// Row Layout
 /// 1. if required hash value comparison:
-///    <Next Pointer> <Hash Value> <Other Join Keys> <Raw Required Join Keys> <Other Required Columns>
+///    [<Matched Flag>] <Next Pointer> <Hash Value> <Other Join Keys> <Raw Required Join Keys> <Other Required Columns>
 /// 2. if not required hash value comparison:
-///    <Next Pointer> <Other Join Keys> <Raw Required Join Keys> <Other Required Columns>
+///    [<Matched Flag>] <Next Pointer> <Other Join Keys> <Raw Required Join Keys> <Other Required Columns>
+/// The row pointer always points to the next pointer, so the matched flag is placed before it.
 struct HashJoinRowLayout
 {
     /// The raw join key column are the same as the original data.
@@ -41,12 +44,17 @@ struct HashJoinRowLayout
 
     size_t key_column_fixed_size = 0;
     size_t other_column_fixed_size = 0;
+
+    /// Only the join kinds that scan the build rows after probe(right outer/semi/anti) need the matched flag.
+    bool has_matched_flag = false;
 };
 
 using RowPtr = char *;
 using RowPtrs = PaddedPODArray<RowPtr>;
 
 constexpr size_t ROW_ALIGN = 4;
+/// Keep the next pointer aligned.
+constexpr size_t ROW_MATCHED_FLAG_SIZE = ROW_ALIGN;
 
 constexpr size_t ROW_PTR_TAG_BITS = 16;
 constexpr size_t ROW_PTR_TAG_MASK = (1 << ROW_PTR_TAG_BITS) - 1;
@@ -83,22 +91,41 @@ inline bool containOtherTag(RowPtr ptr, UInt16 other_tag)
     return (tag | other_tag) == tag;
 }
 
+inline bool isRowMatched(RowPtr ptr)
+{
+    return reinterpret_cast<std::atomic<UInt8> *>(ptr - ROW_MATCHED_FLAG_SIZE)->load(std::memory_order_relaxed);
+}
+
+/// The flag may be set by several probe workers concurrently.
+inline void setRowMatched(RowPtr ptr)
+{
+    auto * flag = reinterpret_cast<std::atomic<UInt8> *>(ptr - ROW_MATCHED_FLAG_SIZE);
+    /// Avoid writing to the cache line again if the row has been matched.
+    if (!flag->load(std::memory_order_relaxed))
+        flag->store(1, std::memory_order_relaxed);
+}
+
 struct RowContainer
 {
     PaddedPODArray<char> data;
     PaddedPODArray<size_t> offsets;
     PaddedPODArray<UInt64> hashes;
+    /// ROW_MATCHED_FLAG_SIZE if HashJoinRowLayout::has_matched_flag is true, otherwise 0.
+    size_t matched_flag_size = 0;
 
     size_t size() const { return offsets.size(); }
 
-    RowPtr getRowPtr(ssize_t row) { return &data[offsets[row - 1]]; }
+    /// Return the pointer to the next pointer of the row.
+    RowPtr getRowPtr(ssize_t row) { return &data[offsets[row - 1]] + matched_flag_size; }
     UInt64 getHash(ssize_t row) { return hashes[row]; }
 };
 
 struct alignas(CPU_CACHE_LINE_SIZE) MultipleRowContainer
 {
     std::mutex mu;
-    std::vector<RowContainer> column_rows;
+    /// Use deque so that the pointers returned by getNext/getScanNext stay valid while other
+    /// threads are still inserting, e.g. converting buffered blocks when spill is enabled.
+    std::deque<RowContainer> column_rows;
     size_t all_row_count = 0;
 
     size_t build_table_index = 0;
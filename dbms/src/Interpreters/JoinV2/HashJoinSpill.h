@@ -0,0 +1,63 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/PODArray.h>
+#include <Core/Block.h>
+
+#include <mutex>
+
+namespace DB
+{
+/// The number of partitions used when hash join v2 spills.
+/// Both sides are dispatched by the hash of the join key, so a spilled partition can be restored
+/// and joined independently of the others.
+constexpr size_t JOIN_SPILL_PARTITION_COUNT = 16;
+static_assert((JOIN_SPILL_PARTITION_COUNT & (JOIN_SPILL_PARTITION_COUNT - 1)) == 0);
+
+/// Partition-level data of hash join v2 when spill is enabled.
+/// Build blocks are buffered here until the build stage finishes. Then the blocks of partitions
+/// that are not spilled are converted to rows, and the others are written to disk.
+/// Probe blocks are only buffered for spilled partitions.
+struct alignas(CPU_CACHE_LINE_SIZE) HashJoinSpillPartition
+{
+    std::mutex mu;
+
+    Blocks build_blocks;
+    size_t build_bytes = 0;
+
+    Blocks probe_blocks;
+    size_t probe_bytes = 0;
+
+    Blocks trySpillBuildBlocks()
+    {
+        Blocks ret;
+        ret.swap(build_blocks);
+        build_bytes = 0;
+        return ret;
+    }
+
+    Blocks trySpillProbeBlocks()
+    {
+        Blocks ret;
+        ret.swap(probe_blocks);
+        probe_bytes = 0;
+        return ret;
+    }
+};
+
+using HashJoinSpillPartitions = std::vector<std::unique_ptr<HashJoinSpillPartition>>;
+
+} // namespace DB
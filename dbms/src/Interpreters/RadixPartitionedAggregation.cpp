@@ -0,0 +1,174 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/WeakHash.h>
+#include <Interpreters/RadixPartitionedAggregation.h>
+
+namespace DB
+{
+RadixPartitionedAggregation::RadixPartitionedAggregation(
+    Aggregator & aggregator_,
+    size_t build_concurrency,
+    size_t partition_count_)
+    : aggregator(aggregator_)
+    , params(aggregator.getParams())
+    , partition_count(partition_count_)
+{
+    RUNTIME_CHECK(partition_count > 0 && params.keys_size > 0, partition_count, params.keys_size);
+    RUNTIME_CHECK(build_concurrency > 0);
+    scatter_data.reserve(build_concurrency);
+    for (size_t i = 0; i < build_concurrency; ++i)
+    {
+        auto data = std::make_unique<ScatterData>();
+        data->blocks.resize(partition_count);
+        data->sort_key_containers.resize(params.keys_size);
+        scatter_data.push_back(std::move(data));
+    }
+    size_t concurrency = std::min(build_concurrency, partition_count);
+    readers.reserve(concurrency);
+    for (size_t i = 0; i < concurrency; ++i)
+        readers.push_back(std::make_unique<Reader>());
+}
+
+void RadixPartitionedAggregation::scatter(size_t task_index, const Block & block)
+{
+    const size_t rows = block.rows();
+    if (rows == 0)
+        return;
+    auto & data = *scatter_data[task_index];
+
+    Columns columns;
+    columns.reserve(block.columns());
+    for (const auto & column : block)
+    {
+        ColumnPtr converted = column.column->convertToFullColumnIfConst();
+        columns.push_back(converted ? converted : column.column);
+    }
+
+    WeakHash32 hash(rows);
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        TiDB::TiDBCollatorPtr collator = params.collators.empty() ? nullptr : params.collators[i];
+        columns[params.keys[i]]->updateWeakHash32(hash, collator, data.sort_key_containers[i]);
+    }
+    // Partition by the most significant bits of the hash, while the hash tables use the least significant
+    // bits of their hash values.
+    const auto & hash_data = hash.getData();
+    data.selector.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+        data.selector[i] = (static_cast<UInt64>(hash_data[i]) * partition_count) >> 32u;
+
+    if (data.columns.empty())
+    {
+        data.columns.resize(columns.size());
+        for (size_t col_index = 0; col_index < columns.size(); ++col_index)
+        {
+            data.columns[col_index].reserve(partition_count);
+            for (size_t partition = 0; partition < partition_count; ++partition)
+                data.columns[col_index].push_back(columns[col_index]->cloneEmpty());
+        }
+    }
+    for (size_t col_index = 0; col_index < columns.size(); ++col_index)
+        columns[col_index]->scatterTo(data.columns[col_index], data.selector);
+
+    for (size_t partition = 0; partition < partition_count; ++partition)
+    {
+        if (data.columns[0][partition]->size() >= params.max_block_size)
+            flushPartition(task_index, partition);
+    }
+}
+
+void RadixPartitionedAggregation::flushPartition(size_t task_index, size_t partition)
+{
+    auto & data = *scatter_data[task_index];
+    MutableColumns columns;
+    columns.reserve(data.columns.size());
+    for (auto & scatter_columns : data.columns)
+    {
+        auto & column = scatter_columns[partition];
+        auto empty_column = column->cloneEmpty();
+        columns.push_back(std::move(column));
+        column = std::move(empty_column);
+    }
+    data.blocks[partition].push_back(params.src_header.cloneWithColumns(std::move(columns)));
+}
+
+void RadixPartitionedAggregation::finishScatter()
+{
+    partitions.resize(partition_count);
+    for (size_t task_index = 0; task_index < scatter_data.size(); ++task_index)
+    {
+        auto & data = *scatter_data[task_index];
+        if (data.columns.empty())
+            continue;
+        for (size_t partition = 0; partition < partition_count; ++partition)
+        {
+            if (!data.columns[0][partition]->empty())
+                flushPartition(task_index, partition);
+            auto & blocks = data.blocks[partition];
+            partitions[partition].insert(
+                partitions[partition].end(),
+                std::make_move_iterator(blocks.begin()),
+                std::make_move_iterator(blocks.end()));
+        }
+    }
+    scatter_data.clear();
+}
+
+AggregatedDataVariantsPtr RadixPartitionedAggregation::aggregatePartition(size_t index, size_t partition)
+{
+    auto data = std::make_shared<AggregatedDataVariants>();
+    Aggregator::AggProcessInfo agg_process_info(&aggregator);
+    for (auto & block : partitions[partition])
+    {
+        agg_process_info.resetBlock(block);
+        while (!agg_process_info.allBlockDataHandled())
+        {
+            if unlikely (aggregator.isCancelled())
+                return data;
+            aggregator.executeOnBlock(agg_process_info, *data, index);
+        }
+        block.clear();
+    }
+    Blocks{}.swap(partitions[partition]);
+    return data;
+}
+
+Block RadixPartitionedAggregation::read(size_t index)
+{
+    assert(index < readers.size());
+    auto & reader = *readers[index];
+    while (true)
+    {
+        if (reader.merging_buckets)
+        {
+            if (auto block = reader.merging_buckets->getData(0); block)
+                return block;
+            reader.merging_buckets.reset();
+            reader.data.reset();
+        }
+
+        auto partition = next_partition.fetch_add(1);
+        if (partition >= partition_count)
+            return {};
+        reader.data = aggregatePartition(index, partition);
+        if unlikely (aggregator.isCancelled())
+            return {};
+        // Only one hash table for a partition, so it is converted to blocks without merging.
+        ManyAggregatedDataVariants many_data{reader.data};
+        reader.merging_buckets = aggregator.mergeAndConvertToBlocks(many_data, /*final=*/true, /*max_threads=*/1);
+    }
+}
+
+} // namespace DB
@@ -0,0 +1,92 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Interpreters/Aggregator.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace DB
+{
+/** Radix partitioned parallel aggregation.
+  *
+  * The normal parallel aggregation builds one hash table per thread and merges them at last. For a group by
+  *  with many distinct keys, every key is inserted into a large hash table twice, and both hash tables are
+  *  far bigger than the cache.
+  * Here the build threads only scatter the source rows into partitions by the hash of the group by keys.
+  *  Since the rows of one key are always in the same partition, each partition can be aggregated by exactly
+  *  one thread and converted to blocks directly, without any merge step, and the hash table of a partition
+  *  is `partition_count` times smaller than the one of the whole data.
+  *
+  * All source rows are kept in memory until their partition is aggregated, so it is only used when
+  *  the aggregation has keys and can not spill.
+  */
+class RadixPartitionedAggregation : private boost::noncopyable
+{
+public:
+    RadixPartitionedAggregation(Aggregator & aggregator_, size_t build_concurrency, size_t partition_count_);
+
+    /// Scatter the rows of `block` into partitions. Called by the build thread `task_index`.
+    void scatter(size_t task_index, const Block & block);
+
+    /// Called after all build threads finish scattering.
+    void finishScatter();
+
+    size_t getConcurrency() const { return readers.size(); }
+
+    /// Aggregate the partitions one by one and return the result blocks. Each call of `read` takes a partition
+    /// which is not aggregated yet when the previous one is drained. Return an empty block after all partitions
+    /// are read.
+    Block read(size_t index);
+
+    size_t getPartitionCount() const { return partition_count; }
+
+private:
+    void flushPartition(size_t task_index, size_t partition);
+
+    AggregatedDataVariantsPtr aggregatePartition(size_t index, size_t partition);
+
+    Aggregator & aggregator;
+    const Aggregator::Params & params;
+    const size_t partition_count;
+
+    struct ScatterData
+    {
+        /// columns[col_index][partition], the rows not yet cut into blocks.
+        std::vector<IColumn::ScatterColumns> columns;
+        /// blocks[partition]
+        std::vector<Blocks> blocks;
+        std::vector<String> sort_key_containers;
+        IColumn::Selector selector;
+    };
+    // use unique_ptr to avoid false sharing.
+    std::vector<std::unique_ptr<ScatterData>> scatter_data;
+
+    /// The blocks of each partition from all build threads.
+    std::vector<Blocks> partitions;
+    std::atomic<size_t> next_partition{0};
+
+    struct Reader
+    {
+        AggregatedDataVariantsPtr data;
+        MergingBucketsPtr merging_buckets;
+    };
+    std::vector<std::unique_ptr<Reader>> readers;
+};
+
+using RadixPartitionedAggregationPtr = std::unique_ptr<RadixPartitionedAggregation>;
+} // namespace DB
@@ -182,6 +182,9 @@ struct Settings
     M(SettingUInt64, dt_merged_file_max_size, 16 * 1024 * 1024, "Small files are merged into one or more files not larger than dt_merged_file_max_size")                                                                                \
     M(SettingDouble, dt_page_gc_threshold, 0.5, "Max valid rate of deciding to do a GC in PageStorage")                                                                                                                                 \
     M(SettingDouble, dt_page_gc_threshold_raft_data, 0.05, "Max valid rate of deciding to do a GC for BlobFile storing PageData in PageStorage")                                                                                        \
+    M(SettingUInt64, dt_page_directory_shards, 1, "Number of shards of the in-memory page directory of PageStorage, 1 for no sharding. Only take effect when restoring.")                                                               \
+    M(SettingUInt64, dt_page_restore_threads, 1, "Number of threads for reading the WAL and rebuilding the page directory when restoring PageStorage, 1 for single thread.")                                                            \
+    M(SettingBool, dt_page_read_use_io_uring, false, "Read the pages of a batch at once by io_uring in PageStorage. Fall back to pread if io_uring is not available.")                                                                  \
     M(SettingInt64, enable_version_chain, 0, "Enable version chain or not: 0 - disable, 1 - enabled. "                                                                                                                                  \
                                              "More details are in the comments of `enum class VersionChainMode`."                                                                                                                       \
                                              "Modifying this configuration requires a restart to reset the in-memory state.")                                                                                                           \
@@ -228,6 +231,12 @@ struct Settings
     M(SettingUInt64, dt_max_sharing_column_bytes_for_all, 2048 * Constant::MB, "Memory limitation for data sharing of all requests, include those sharing blocks in block queue. 0 means disable data sharing")                         \
     M(SettingUInt64, dt_max_sharing_column_count, 5, "Deprecated")                                                                                                                                                                      \
     M(SettingBool, dt_enable_bitmap_filter, true, "Use bitmap filter to read data or not")                                                                                                                                              \
+    M(SettingBool, dt_enable_bloom_filter_index, false, "Whether to write a bloom filter index for each pack of the integer and string columns in DTFile")                                                                              \
+    M(SettingBool, dt_enable_inverted_index_v2, false, "Whether to write the integer inverted indexes in the compact V2 format, which can not be read by the versions before it")                                                       \
+    M(SettingBool, dt_enable_lightweight_float_compression, false, "Whether to compress the floating-point columns in DTFile by the float modes of Lightweight compression, which can not be read by the versions before it")           \
+    M(SettingBool, dt_enable_lightweight_string_compression, false, "Whether to compress the string columns in DTFile by the string modes of Lightweight compression, which can not be read by the versions before it")                 \
+    M(SettingBool, dt_enable_read_string_dictionary, false, "Whether to read the dictionary encoded string columns as dictionaries for the filters and aggregations on them")                                                           \
+    M(SettingBool, dt_enable_encoded_filter, false, "Whether to evaluate the pushed down comparisons between integer columns and constants on the encoded packs in late materialization")                                               \
     M(SettingDouble, dt_read_thread_count_scale, 2.0, "Number of read thread = number of logical cpu cores * dt_read_thread_count_scale.  Only has meaning at server startup.")                                                         \
     M(SettingDouble, io_thread_count_scale, 5.0, "Number of thread of IOThreadPool = number of logical cpu cores * io_thread_count_scale.  Only has meaning at server startup.")                                                        \
     M(SettingUInt64, init_thread_count_scale, 100, "Number of thread = number of logical cpu cores * init_thread_count_scale. It just works for thread pool for initStores and loadMetadata. Only has meaning at server startup.")      \
@@ -246,6 +255,7 @@ struct Settings
     M(SettingUInt64, dt_write_page_cache_limit_size, 2 * 1024 * 1024, "Limit size per write batch when compute node writing to PageStorage cache")                                                                                      \
     M(SettingDouble, dt_filecache_max_downloading_count_scale, 1.0, "Max downloading task count of FileCache = io thread count * dt_filecache_max_downloading_count_scale.")                                                            \
     M(SettingUInt64, dt_filecache_min_age_seconds, 1800, "Files of the same priority can only be evicted from files that were not accessed within `dt_filecache_min_age_seconds` seconds.")                                             \
+    M(SettingUInt64, dt_filecache_chunk_size, 0, "Large data files of FileCache are downloaded and cached by chunks of this size when they are read. 0 means caching the whole file.")                                                  \
     M(SettingBool, dt_enable_fetch_memtableset, true, "Whether fetching delta cache in FetchDisaggPages")                                                                                                                               \
     M(SettingUInt64, dt_fetch_pages_packet_limit_size, 512 * 1024, "Response packet bytes limit of FetchDisaggPages, 0 means one page per packet")                                                                                      \
     M(SettingDouble, dt_fetch_page_concurrency_scale, 4.0, "Concurrency of fetching pages of one query equals to num_streams * dt_fetch_page_concurrency_scale.")                                                                       \
@@ -312,6 +322,7 @@ struct Settings
     M(SettingUInt64, async_cqs, 1, "grpc async cqs")                                                                                                                                                                                    \
     M(SettingUInt64, preallocated_request_count_per_poller, 20, "grpc preallocated_request_count_per_poller")                                                                                                                           \
     M(SettingUInt64, max_bytes_before_external_join, 0, "max bytes used by join before spill, 0 as the default value, 0 means no limit")                                                                                                \
+    M(SettingUInt64, max_bytes_before_external_window, 0, "max bytes used by window before spill, 0 as the default value, 0 means no limit")                                                                                            \
     M(SettingInt64, join_restore_concurrency, 0, "join restore concurrency, negative value means restore join serially, 0 means TiFlash choose restore concurrency automatically, 0 as the default value")                              \
     M(SettingUInt64, max_cached_data_bytes_in_spiller, 1024ULL * 1024 * 20, "Max cached data bytes in spiller before spilling, 20 MB as the default value, 0 means no limit")                                                           \
     M(SettingUInt64, max_spilled_rows_per_file, 200000, "Max spilled data rows per spill file, 200000 as the default value, 0 means no limit.")                                                                                         \
@@ -322,7 +333,10 @@ struct Settings
     M(SettingUInt64, pipeline_io_task_thread_pool_size, 0, "The size of io task thread pool. 0 means using number_of_logical_cpu_cores.")                                                                                               \
     M(SettingTaskQueueType, pipeline_cpu_task_thread_pool_queue_type, TaskQueueType::DEFAULT, "The task queue of cpu task thread pool")                                                                                                 \
     M(SettingTaskQueueType, pipeline_io_task_thread_pool_queue_type, TaskQueueType::DEFAULT, "The task queue of io task thread pool")                                                                                                   \
+    M(SettingUInt64, pipeline_cpu_task_thread_pool_local_queue_size, 0, "Max tasks a cpu task thread takes at once into its local queue for work stealing, 0 means disabled.")                                                          \
+    M(SettingBool, pipeline_cpu_task_thread_pool_numa_aware, false, "Partition cpu task threads to numa nodes and keep tasks on their numa nodes where possible.")                                                                      \
     M(SettingUInt64, local_tunnel_version, 2, "1: not refined, 2: refined")                                                                                                                                                             \
+    M(SettingBool, local_tunnel_pass_block, false, "Pass blocks to the receivers of local tunnels directly without serialization and compression.")                                                                                     \
     M(SettingBool, force_push_down_all_filters_to_scan, false, "Push down all filters to scan, only used for test")                                                                                                                     \
     M(SettingUInt64, async_recv_version, 2, "1: reactor mode, 2: no additional threads")                                                                                                                                                \
     M(SettingUInt64, recv_queue_size, 0, "size of ExchangeReceiver queue, 0 means the size is set to data_source_mpp_task_num * 50")                                                                                                    \
@@ -340,7 +354,9 @@ struct Settings
     M(SettingUInt64, join_v2_probe_prefetch_step, 16, "hash join v2 probe prefetch length")                                                                                                                                             \
     M(SettingUInt64, join_v2_probe_insert_batch_size, 128, "hash join v2 probe insert batch size")                                                                                                                                      \
     M(SettingBool, join_v2_enable_tagged_pointer, true, "hash join v2 enable tagged pointer") \
-    M(SettingBool, hashagg_use_magic_hash, false, "whether to use magic hash for hashagg")
+    M(SettingBool, hashagg_use_magic_hash, false, "whether to use magic hash for hashagg") \
+    M(SettingUInt64, hashagg_radix_partition_count, 0, "the number of partitions the source rows are scattered into before being aggregated in parallel, 0 means disabled") \
+    M(SettingBool, enable_ordered_aggregation, false, "aggregate the adjacent rows of the same group without hash table for the partial aggregation when the group by keys are a prefix of the handle")
 
 
 // clang-format on
@@ -25,8 +25,9 @@ extern const char random_marked_for_auto_spill[];
 SortSpillContext::SortSpillContext(
     const SpillConfig & spill_config_,
     UInt64 operator_spill_threshold_,
-    const LoggerPtr & log)
-    : OperatorSpillContext(operator_spill_threshold_, "sort", log)
+    const LoggerPtr & log,
+    const String & op_name_)
+    : OperatorSpillContext(operator_spill_threshold_, op_name_, log)
     , spill_config(spill_config_)
 {}
 
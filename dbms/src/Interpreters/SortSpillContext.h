@@ -29,7 +29,11 @@ private:
     SpillerPtr spiller;
 
 public:
-    SortSpillContext(const SpillConfig & spill_config_, UInt64 operator_spill_threshold_, const LoggerPtr & log);
+    SortSpillContext(
+        const SpillConfig & spill_config_,
+        UInt64 operator_spill_threshold_,
+        const LoggerPtr & log,
+        const String & op_name_ = "sort");
     void buildSpiller(const Block & input_schema);
     SpillerPtr & getSpiller() { return spiller; }
     void finishOneSpill();
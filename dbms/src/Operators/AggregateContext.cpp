@@ -20,7 +20,8 @@ void AggregateContext::initBuild(
     const Aggregator::Params & params,
     size_t max_threads_,
     CancellationHook && hook,
-    const RegisterOperatorSpillContext & register_operator_spill_context)
+    const RegisterOperatorSpillContext & register_operator_spill_context,
+    size_t radix_partition_count)
 {
     assert(status.load() == AggStatus::init);
     is_cancelled = std::move(hook);
@@ -43,6 +44,17 @@ void AggregateContext::initBuild(
         threads_data.emplace_back(std::make_unique<ThreadData>(aggregator.get()));
         many_data.emplace_back(std::make_shared<AggregatedDataVariants>());
     }
+    if (radix_partition_count > 0)
+    {
+        // All source rows are kept in memory until the convergent stage, so it can't work with spill.
+        if (keys_size == 0)
+            LOG_DEBUG(log, "Radix partitioned aggregation is disabled because there is no group by key");
+        else if (getAggSpillContext()->isSpillEnabled())
+            LOG_DEBUG(log, "Radix partitioned aggregation is disabled because spill is enabled");
+        else
+            radix_aggregation
+                = std::make_unique<RadixPartitionedAggregation>(*aggregator, max_threads, radix_partition_count);
+    }
     status = AggStatus::build;
     build_watch.emplace();
     LOG_TRACE(log, "Aggregate Context inited");
@@ -80,6 +92,13 @@ bool AggregateContext::hasLocalDataToBuild(size_t task_index)
 void AggregateContext::buildOnBlock(size_t task_index, const Block & block)
 {
     assert(status.load() == AggStatus::build);
+    if (radix_aggregation)
+    {
+        radix_aggregation->scatter(task_index, block);
+        threads_data[task_index]->src_bytes += block.bytes();
+        threads_data[task_index]->src_rows += block.rows();
+        return;
+    }
     auto & agg_process_info = threads_data[task_index]->agg_process_info;
     agg_process_info.resetBlock(block);
     buildOnLocalData(task_index);
@@ -184,6 +203,18 @@ void AggregateContext::initConvergent()
 
     initConvergentPrefix();
 
+    if (radix_aggregation)
+    {
+        radix_aggregation->finishScatter();
+        status = AggStatus::convergent;
+        LOG_DEBUG(
+            log,
+            "Scattered into {} partitions, aggregated by {} threads",
+            radix_aggregation->getPartitionCount(),
+            radix_aggregation->getConcurrency());
+        return;
+    }
+
     merging_buckets = aggregator->mergeAndConvertToBlocks(many_data, true, max_threads);
     status = AggStatus::convergent;
     RUNTIME_CHECK(!merging_buckets || merging_buckets->getConcurrency() > 0);
@@ -192,6 +223,8 @@ void AggregateContext::initConvergent()
 size_t AggregateContext::getConvergentConcurrency()
 {
     assert(status.load() == AggStatus::convergent);
+    if (radix_aggregation)
+        return radix_aggregation->getConcurrency();
     return merging_buckets ? merging_buckets->getConcurrency() : 1;
 }
 
@@ -210,6 +243,8 @@ Block AggregateContext::getSourceHeader() const
 Block AggregateContext::readForConvergent(size_t index)
 {
     assert(status.load() == AggStatus::convergent);
+    if (radix_aggregation)
+        return radix_aggregation->read(index);
     if unlikely (!merging_buckets)
         return {};
     return merging_buckets->getData(index);
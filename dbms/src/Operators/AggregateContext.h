@@ -17,6 +17,7 @@
 #include <Common/Logger.h>
 #include <Common/Stopwatch.h>
 #include <Interpreters/Aggregator.h>
+#include <Interpreters/RadixPartitionedAggregation.h>
 #include <Operators/LocalAggregateRestorer.h>
 #include <Operators/SharedAggregateRestorer.h>
 
@@ -45,7 +46,8 @@ public:
         const Aggregator::Params & params,
         size_t max_threads_,
         CancellationHook && hook,
-        const RegisterOperatorSpillContext & register_operator_spill_context);
+        const RegisterOperatorSpillContext & register_operator_spill_context,
+        size_t radix_partition_count = 0);
 
     size_t getBuildConcurrency() const { return max_threads; }
 
@@ -118,6 +120,8 @@ private:
 
     MergingBucketsPtr merging_buckets;
     ManyAggregatedDataVariants many_data;
+    // Not null if the source rows are scattered into partitions instead of being aggregated by each build thread.
+    RadixPartitionedAggregationPtr radix_aggregation;
     // use unique_ptr to avoid false sharing.
     std::vector<std::unique_ptr<ThreadData>> threads_data;
     size_t max_threads{};
@@ -21,12 +21,37 @@ OperatorStatus HashJoinV2BuildRowSink::writeImpl(Block && block)
     if unlikely (!block)
     {
         is_finish_status = true;
-        join_ptr->finishOneBuildRow(op_index);
+        if (join_ptr->finishOneBuildRow(op_index))
+        {
+            if (join_ptr->hasBuildSideMarkedSpillData(op_index))
+                return OperatorStatus::IO_OUT;
+            join_ptr->finalizeBuild();
+        }
         return OperatorStatus::FINISHED;
     }
     join_ptr->buildRowFromBlock(block, op_index);
     block.clear();
-    return OperatorStatus::NEED_INPUT;
+    return join_ptr->hasBuildSideMarkedSpillData(op_index) ? OperatorStatus::IO_OUT : OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus HashJoinV2BuildRowSink::prepareImpl()
+{
+    join_ptr->checkAndMarkPartitionSpilledIfNeeded(op_index);
+    return join_ptr->hasBuildSideMarkedSpillData(op_index) ? OperatorStatus::IO_OUT : OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus HashJoinV2BuildRowSink::executeIOImpl()
+{
+    join_ptr->flushBuildSideMarkedSpillData(op_index);
+    if (is_finish_status)
+    {
+        join_ptr->finalizeBuild();
+        return OperatorStatus::FINISHED;
+    }
+    else
+    {
+        return OperatorStatus::NEED_INPUT;
+    }
 }
 
 } // namespace DB
@@ -12,12 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
 #include <Operators/HashJoinV2ProbeTransformOp.h>
 #include <Operators/Operator.h>
 
+#include <magic_enum.hpp>
+
 namespace DB
 {
+#define BREAK                                \
+    assert(!current_notify_future);          \
+    if unlikely (exec_context.isCancelled()) \
+        return OperatorStatus::CANCELLED;    \
+    break
 
 HashJoinV2ProbeTransformOp::HashJoinV2ProbeTransformOp(
     PipelineExecutorContext & exec_context_,
@@ -48,42 +57,226 @@ void HashJoinV2ProbeTransformOp::operateSuffixImpl()
         scan_hash_map_rows);
 }
 
+HashJoinV2ProbeTransformOp::ProbeStatus HashJoinV2ProbeTransformOp::finishOneProbe()
+{
+    auto next_status = join_ptr->isSpilled() || join_ptr->needScanBuildSideAfterProbe() ? ProbeStatus::WAIT_PROBE_FINISH
+                                                                                         : ProbeStatus::FINISHED;
+    if (join_ptr->finishOneProbe(op_index))
+    {
+        if (join_ptr->hasProbeSideMarkedSpillData(op_index))
+            return ProbeStatus::PROBE_FINAL_SPILL;
+        join_ptr->finalizeProbe();
+    }
+    return next_status;
+}
+
 OperatorStatus HashJoinV2ProbeTransformOp::onOutput(Block & block)
 {
-    assert(!probe_context.isAllFinished());
-    block = join_ptr->probeBlock(probe_context, op_index);
-    size_t rows = block.rows();
-    joined_rows += rows;
-    return OperatorStatus::HAS_OUTPUT;
+    while (true)
+    {
+        switch (status)
+        {
+        case ProbeStatus::PROBE:
+            if (!probe_context.isAllFinished())
+            {
+                block = join_ptr->probeBlock(probe_context, op_index);
+                joined_rows += block.rows();
+                return OperatorStatus::HAS_OUTPUT;
+            }
+            if (!probe_blocks.empty())
+            {
+                auto & probe_block = probe_blocks.front();
+                probe_context.resetBlock(probe_block.block, probe_block.hash_table_index);
+                probe_blocks.pop_front();
+                BREAK;
+            }
+            if (!probe_context.input_is_finished)
+                return OperatorStatus::NEED_INPUT;
+            switchStatus(finishOneProbe());
+            block = join_ptr->probeLastResultBlock(op_index);
+            if (block.rows() > 0)
+                return OperatorStatus::HAS_OUTPUT;
+            BREAK;
+        case ProbeStatus::PROBE_FINAL_SPILL:
+            return OperatorStatus::IO_OUT;
+        case ProbeStatus::WAIT_PROBE_FINISH:
+            if (join_ptr->isProbeFinishedForPipeline())
+            {
+                switchStatus(
+                    join_ptr->needScanBuildSideAfterProbe() ? ProbeStatus::SCAN_BUILD_SIDE
+                                                            : ProbeStatus::GET_RESTORE_JOIN);
+                BREAK;
+            }
+            return OperatorStatus::WAIT_FOR_NOTIFY;
+        case ProbeStatus::SCAN_BUILD_SIDE:
+            block = join_ptr->scanBuildSideAfterProbe(op_index);
+            if (block.rows() > 0)
+            {
+                scan_hash_map_rows += block.rows();
+                return OperatorStatus::HAS_OUTPUT;
+            }
+            switchStatus(ProbeStatus::GET_RESTORE_JOIN);
+            BREAK;
+        case ProbeStatus::GET_RESTORE_JOIN:
+            restore_info = join_ptr->getOneRestoreInfo();
+            if (restore_info)
+            {
+                restore_stream_finished = false;
+                restore_info->build_stream->readPrefix();
+                switchStatus(ProbeStatus::RESTORE_BUILD);
+            }
+            else
+            {
+                switchStatus(ProbeStatus::FINISHED);
+            }
+            BREAK;
+        case ProbeStatus::RESTORE_BUILD:
+        {
+            auto & restore_join = restore_info->join;
+            if (restored_block)
+            {
+                restore_join->buildRowFromBlock(restored_block, 0);
+                restored_block = {};
+            }
+            if (!restore_stream_finished)
+                return OperatorStatus::IO_IN;
+            restore_info->build_stream->readSuffix();
+            restore_join->finishOneBuildRow(0);
+            restore_join->finalizeBuild();
+            switchStatus(ProbeStatus::RESTORE_BUILD_POINTER_TABLE);
+            BREAK;
+        }
+        case ProbeStatus::RESTORE_BUILD_POINTER_TABLE:
+            /// The restore join is built by this stream only, so no need to wait for other streams to insert the blocks.
+            if (restore_info->join->insertOneBuildBlockKeptInMemory(0) || !restore_info->join->buildPointerTable(0))
+            {
+                /// Build the pointer table step by step, wait between steps to give up the cpu.
+                return OperatorStatus::WAITING;
+            }
+            restore_stream_finished = false;
+            restore_info->probe_stream->readPrefix();
+            switchStatus(ProbeStatus::RESTORE_PROBE);
+            BREAK;
+        case ProbeStatus::RESTORE_PROBE:
+        {
+            auto & restore_join = restore_info->join;
+            if (!probe_context.isAllFinished())
+            {
+                block = restore_join->probeBlock(probe_context, 0);
+                joined_rows += block.rows();
+                return OperatorStatus::HAS_OUTPUT;
+            }
+            if (restored_block)
+            {
+                if (restored_block.rows() > 0)
+                    probe_context.resetBlock(restored_block);
+                restored_block = {};
+                BREAK;
+            }
+            if (!restore_stream_finished)
+                return OperatorStatus::IO_IN;
+            restore_info->probe_stream->readSuffix();
+            restore_join->finishOneProbe(0);
+            restore_join->finalizeProbe();
+            block = restore_join->probeLastResultBlock(0);
+            if (restore_join->needScanBuildSideAfterProbe())
+            {
+                switchStatus(ProbeStatus::RESTORE_SCAN_BUILD_SIDE);
+            }
+            else
+            {
+                restore_info.reset();
+                switchStatus(ProbeStatus::GET_RESTORE_JOIN);
+            }
+            if (block.rows() > 0)
+                return OperatorStatus::HAS_OUTPUT;
+            BREAK;
+        }
+        case ProbeStatus::RESTORE_SCAN_BUILD_SIDE:
+            block = restore_info->join->scanBuildSideAfterProbe(0);
+            if (block.rows() > 0)
+            {
+                scan_hash_map_rows += block.rows();
+                return OperatorStatus::HAS_OUTPUT;
+            }
+            restore_info.reset();
+            switchStatus(ProbeStatus::GET_RESTORE_JOIN);
+            BREAK;
+        case ProbeStatus::FINISHED:
+            block = {};
+            return OperatorStatus::HAS_OUTPUT;
+        }
+    }
 }
 
 OperatorStatus HashJoinV2ProbeTransformOp::transformImpl(Block & block)
 {
-    assert(probe_context.isAllFinished());
+    assert(status == ProbeStatus::PROBE);
+    assert(probe_context.isAllFinished() && probe_blocks.empty());
     if unlikely (!block)
     {
-        join_ptr->finishOneProbe(op_index);
         probe_context.input_is_finished = true;
-        block = join_ptr->probeLastResultBlock(op_index);
-        return OperatorStatus::HAS_OUTPUT;
+        return onOutput(block);
     }
     if (block.rows() == 0)
         return OperatorStatus::NEED_INPUT;
+    if (join_ptr->needDispatchProbeBlock())
+    {
+        /// The probe block is dispatched to the hash table of its fine grained shuffle partition, or to the spill
+        /// partitions. The blocks of the spilled partitions are probed after restoring.
+        join_ptr->dispatchProbeBlock(block, probe_blocks, op_index);
+        block = {};
+        if (join_ptr->hasProbeSideMarkedSpillData(op_index))
+            return OperatorStatus::IO_OUT;
+        return onOutput(block);
+    }
     probe_context.resetBlock(block);
     return onOutput(block);
 }
 
 OperatorStatus HashJoinV2ProbeTransformOp::tryOutputImpl(Block & block)
 {
-    if unlikely (probe_context.input_is_finished)
+    return onOutput(block);
+}
+
+OperatorStatus HashJoinV2ProbeTransformOp::executeIOImpl()
+{
+    switch (status)
     {
-        block = {};
+    case ProbeStatus::PROBE:
+        join_ptr->flushProbeSideMarkedSpillData(op_index);
+        return OperatorStatus::NEED_INPUT;
+    case ProbeStatus::PROBE_FINAL_SPILL:
+        join_ptr->flushProbeSideMarkedSpillData(op_index);
+        join_ptr->finalizeProbe();
+        switchStatus(ProbeStatus::WAIT_PROBE_FINISH);
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::RESTORE_BUILD:
+        restored_block = restore_info->build_stream->read();
+        restore_stream_finished = !restored_block;
         return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::RESTORE_PROBE:
+        restored_block = restore_info->probe_stream->read();
+        restore_stream_finished = !restored_block;
+        return OperatorStatus::HAS_OUTPUT;
+    default:
+        throw Exception(fmt::format("Unexpected status: {}", magic_enum::enum_name(status)));
     }
-    if (probe_context.isAllFinished())
-        return OperatorStatus::NEED_INPUT;
-    return onOutput(block);
 }
 
+OperatorStatus HashJoinV2ProbeTransformOp::awaitImpl()
+{
+    /// Only used to yield between the steps of building the pointer table of the restore join,
+    /// it is always ready to run the next step.
+    RUNTIME_CHECK(status == ProbeStatus::RESTORE_BUILD_POINTER_TABLE, magic_enum::enum_name(status));
+    return OperatorStatus::HAS_OUTPUT;
+}
 
+#undef BREAK
+
+void HashJoinV2ProbeTransformOp::switchStatus(ProbeStatus to)
+{
+    LOG_TRACE(log, fmt::format("{} -> {}", magic_enum::enum_name(status), magic_enum::enum_name(to)));
+    status = to;
+}
 } // namespace DB
@@ -12,12 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #pragma once
 
 #include <Interpreters/JoinV2/HashJoin.h>
 #include <Interpreters/JoinV2/HashJoinProbe.h>
 #include <Operators/Operator.h>
 
+#include <deque>
+
 namespace DB
 {
 class HashJoinV2ProbeTransformOp : public TransformOp
@@ -36,6 +39,10 @@ protected:
 
     OperatorStatus tryOutputImpl(Block & block) override;
 
+    OperatorStatus executeIOImpl() override;
+
+    OperatorStatus awaitImpl() override;
+
     void transformHeaderImpl(Block & header_) override;
 
     void operateSuffixImpl() override;
@@ -43,11 +50,74 @@ protected:
 private:
     OperatorStatus onOutput(Block & block);
 
+    /*
+     *   spill not enabled or not spilled, no need to scan the build side:
+     *                                 PROBE
+     *                                   |
+     *                                   ▼
+     *                               FINISHED
+     *
+     *   spilled or need to scan the build side after probe (right outer/semi/anti join):
+     *                                 PROBE
+     *                                   |
+     *                                   ▼
+     *                          PROBE_FINAL_SPILL (only for the last probe worker and spilled)
+     *                                   |
+     *                                   ▼
+     *                          WAIT_PROBE_FINISH
+     *                                   |
+     *                                   ▼
+     *                           SCAN_BUILD_SIDE (only for the join that needs to scan the build side)
+     *                                   |
+     *                                   ▼
+     *          |-------------->  GET_RESTORE_JOIN
+     *          |                        |
+     *          |                 ---------------
+     *          |                 |             | no restored join
+     *          |                 ▼             ▼
+     *          |           RESTORE_BUILD    FINISHED
+     *          |                 |
+     *          |                 ▼
+     *          |     RESTORE_BUILD_POINTER_TABLE
+     *          |                 |
+     *          |                 ▼
+     *          |           RESTORE_PROBE
+     *          |                 |
+     *          |                 ▼
+     *          |------ RESTORE_SCAN_BUILD_SIDE (only for the join that needs to scan the build side)
+     */
+    enum class ProbeStatus
+    {
+        PROBE, /// probe data
+        PROBE_FINAL_SPILL, /// final spill for probe data
+        WAIT_PROBE_FINISH, /// wait probe finish
+        SCAN_BUILD_SIDE, /// output the build rows for right outer/semi/anti join
+        GET_RESTORE_JOIN, /// try to get restore join
+        RESTORE_BUILD, /// build for restore join
+        RESTORE_BUILD_POINTER_TABLE, /// build the pointer table for restore join
+        RESTORE_PROBE, /// probe for restore join
+        RESTORE_SCAN_BUILD_SIDE, /// output the build rows of restore join for right outer/semi/anti join
+        FINISHED, /// the final state
+    };
+    void switchStatus(ProbeStatus to);
+
+    /// Return the next status after all the input blocks are probed.
+    ProbeStatus finishOneProbe();
+
 private:
     HashJoinPtr join_ptr;
     size_t op_index;
 
     JoinProbeContext probe_context;
+    /// Probe blocks of the partitions that are kept in memory when the join is spilled.
+    JoinProbeBlocks probe_blocks;
+
+    ProbeStatus status{ProbeStatus::PROBE};
+
+    /// For restore
+    std::optional<HashJoinRestoreInfo> restore_info;
+    Block restored_block;
+    bool restore_stream_finished = false;
 
     size_t joined_rows = 0;
     size_t scan_hash_map_rows = 0;
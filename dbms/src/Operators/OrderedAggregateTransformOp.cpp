@@ -0,0 +1,255 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Operators/OrderedAggregateTransformOp.h>
+
+#include <ext/scope_guard.h>
+
+namespace DB
+{
+namespace
+{
+// The arena is recreated between groups once it grows larger than this, so the memory of the aggregate
+// functions allocating in the arena, e.g. group_concat, is bounded by the size of a group.
+constexpr size_t max_arena_bytes = 1024 * 1024;
+} // namespace
+
+OrderedAggregateTransformOp::OrderedAggregateTransformOp(
+    PipelineExecutorContext & exec_context_,
+    const String & req_id,
+    const Aggregator::Params & params_)
+    : TransformOp(exec_context_, req_id)
+    , params(params_)
+    , header(params.getHeader(/*final=*/true))
+    , arena(std::make_shared<Arena>())
+{
+    RUNTIME_CHECK(params.keys_size > 0);
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        const auto & key_name = params.src_header.getByPosition(params.keys[i]).name;
+        // Same as Aggregator, the keys referred by an aggregate function are not output.
+        if (params.key_ref_agg_func.find(key_name) == params.key_ref_agg_func.end())
+            output_key_indexes.push_back(i);
+    }
+    RUNTIME_CHECK(header.columns() == output_key_indexes.size() + params.aggregates_size);
+
+    offsets_of_aggregate_states.resize(params.aggregates_size);
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+    {
+        const auto & function = params.aggregates[i].function;
+        total_size_of_aggregate_states
+            = (total_size_of_aggregate_states + function->alignOfData() - 1) / function->alignOfData()
+            * function->alignOfData();
+        offsets_of_aggregate_states[i] = total_size_of_aggregate_states;
+        total_size_of_aggregate_states += function->sizeOfData();
+        align_aggregate_states = std::max(align_aggregate_states, function->alignOfData());
+    }
+
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        current_key_columns.push_back(params.src_header.getByPosition(params.keys[i]).type->createColumn());
+        current_key_column_ptrs.push_back(current_key_columns.back().get());
+    }
+    result_columns = header.cloneEmptyColumns();
+}
+
+OrderedAggregateTransformOp::~OrderedAggregateTransformOp()
+{
+    if (has_current_group)
+        destroyStates();
+    LOG_DEBUG(log, "Ordered aggregated {} rows to {} rows", src_rows, result_rows);
+}
+
+void OrderedAggregateTransformOp::createStates()
+{
+    if (!place)
+        place = arena->alignedAlloc(total_size_of_aggregate_states, align_aggregate_states);
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+    {
+        try
+        {
+            params.aggregates[i].function->create(place + offsets_of_aggregate_states[i]);
+        }
+        catch (...)
+        {
+            for (size_t j = 0; j < i; ++j)
+                params.aggregates[j].function->destroy(place + offsets_of_aggregate_states[j]);
+            throw;
+        }
+    }
+}
+
+void OrderedAggregateTransformOp::destroyStates() noexcept
+{
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+        params.aggregates[i].function->destroy(place + offsets_of_aggregate_states[i]);
+}
+
+bool OrderedAggregateTransformOp::isSameKey(
+    const ColumnRawPtrs & key_columns,
+    size_t row,
+    const ColumnRawPtrs & other_key_columns,
+    size_t other_row) const
+{
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        const auto * collator = params.collators.empty() ? nullptr : params.collators[i];
+        int res = collator
+            ? key_columns[i]->compareAt(row, other_row, *other_key_columns[i], /*nan_direction_hint=*/1, *collator)
+            : key_columns[i]->compareAt(row, other_row, *other_key_columns[i], /*nan_direction_hint=*/1);
+        if (res != 0)
+            return false;
+    }
+    return true;
+}
+
+void OrderedAggregateTransformOp::startGroup(const ColumnRawPtrs & key_columns, size_t row)
+{
+    assert(!has_current_group);
+    if (arena->size() > max_arena_bytes)
+    {
+        arena = std::make_shared<Arena>();
+        place = nullptr;
+    }
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        current_key_columns[i]->popBack(current_key_columns[i]->size());
+        current_key_columns[i]->insertFrom(*key_columns[i], row);
+    }
+    createStates();
+    has_current_group = true;
+}
+
+void OrderedAggregateTransformOp::finishGroup()
+{
+    assert(has_current_group);
+    has_current_group = false;
+    SCOPE_EXIT({ destroyStates(); });
+
+    size_t col_index = 0;
+    for (auto key_index : output_key_indexes)
+        result_columns[col_index++]->insertFrom(*current_key_columns[key_index], 0);
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+        params.aggregates[i].function->insertResultInto(
+            place + offsets_of_aggregate_states[i],
+            *result_columns[col_index++],
+            arena.get());
+
+    if (result_columns[0]->size() >= params.max_block_size)
+        flushResult();
+}
+
+void OrderedAggregateTransformOp::flushResult()
+{
+    if (result_columns[0]->empty())
+        return;
+    result_rows += result_columns[0]->size();
+    output_blocks.push_back(header.cloneWithColumns(std::move(result_columns)));
+    result_columns = header.cloneEmptyColumns();
+}
+
+void OrderedAggregateTransformOp::aggregateBlock(const Block & block)
+{
+    const size_t rows = block.rows();
+    if (rows == 0)
+        return;
+    src_rows += rows;
+
+    Columns materialized_columns;
+    auto materialize = [&](size_t position) {
+        const IColumn * column = block.getByPosition(position).column.get();
+        if (ColumnPtr converted = column->convertToFullColumnIfConst())
+        {
+            materialized_columns.push_back(converted);
+            column = materialized_columns.back().get();
+        }
+        return column;
+    };
+    ColumnRawPtrs key_columns(params.keys_size);
+    for (size_t i = 0; i < params.keys_size; ++i)
+        key_columns[i] = materialize(params.keys[i]);
+    std::vector<std::vector<const IColumn *>> aggregate_columns(params.aggregates_size);
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+    {
+        for (auto argument : params.aggregates[i].arguments)
+            aggregate_columns[i].push_back(materialize(argument));
+    }
+    auto add_rows = [&](size_t start, size_t end) {
+        for (size_t i = 0; i < params.aggregates_size; ++i)
+            params.aggregates[i].function->addBatchSinglePlace(
+                start,
+                end - start,
+                place + offsets_of_aggregate_states[i],
+                aggregate_columns[i].data(),
+                arena.get());
+    };
+
+    if (has_current_group && !isSameKey(key_columns, 0, current_key_column_ptrs, 0))
+        finishGroup();
+
+    if (!has_current_group)
+        startGroup(key_columns, 0);
+
+    size_t run_start = 0;
+    for (size_t row = 1; row < rows; ++row)
+    {
+        if (isSameKey(key_columns, row, key_columns, row - 1))
+            continue;
+        add_rows(run_start, row);
+        finishGroup();
+        startGroup(key_columns, row);
+        run_start = row;
+    }
+    add_rows(run_start, rows);
+}
+
+OperatorStatus OrderedAggregateTransformOp::transformImpl(Block & block)
+{
+    if unlikely (!block)
+    {
+        input_finished = true;
+        if (has_current_group)
+            finishGroup();
+        flushResult();
+    }
+    else
+    {
+        aggregateBlock(block);
+        block = {};
+    }
+    return tryOutputImpl(block);
+}
+
+OperatorStatus OrderedAggregateTransformOp::tryOutputImpl(Block & block)
+{
+    if (!output_blocks.empty())
+    {
+        block = std::move(output_blocks.front());
+        output_blocks.pop_front();
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    if (input_finished)
+    {
+        block = {};
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    return OperatorStatus::NEED_INPUT;
+}
+
+void OrderedAggregateTransformOp::transformHeaderImpl(Block & header_)
+{
+    header_ = header;
+}
+} // namespace DB
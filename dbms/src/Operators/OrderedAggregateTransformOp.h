@@ -0,0 +1,94 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Arena.h>
+#include <Interpreters/Aggregator.h>
+#include <Operators/Operator.h>
+
+namespace DB
+{
+/// Aggregate the adjacent rows with the same group by keys without a hash table.
+///
+/// It is used for the partial aggregation whose child is a table scan keeping the order of the handle, and the
+/// group by keys are a prefix of the handle, so the rows of a group are adjacent in the output of a source.
+/// The result of a group is output as soon as a different key is met, so only the aggregate states of one group
+/// are kept in memory.
+/// If the rows of a group are not adjacent, e.g. they are read by different sources, the group is output more
+/// than once. It is fine because the final aggregation merges them.
+class OrderedAggregateTransformOp : public TransformOp
+{
+public:
+    OrderedAggregateTransformOp(
+        PipelineExecutorContext & exec_context_,
+        const String & req_id,
+        const Aggregator::Params & params_);
+
+    ~OrderedAggregateTransformOp() override;
+
+    String getName() const override { return "OrderedAggregateTransformOp"; }
+
+protected:
+    OperatorStatus transformImpl(Block & block) override;
+
+    OperatorStatus tryOutputImpl(Block & block) override;
+
+    void transformHeaderImpl(Block & header_) override;
+
+private:
+    void aggregateBlock(const Block & block);
+
+    bool isSameKey(
+        const ColumnRawPtrs & key_columns,
+        size_t row,
+        const ColumnRawPtrs & other_key_columns,
+        size_t other_row) const;
+
+    void startGroup(const ColumnRawPtrs & key_columns, size_t row);
+
+    void finishGroup();
+
+    void createStates();
+
+    void destroyStates() noexcept;
+
+    void flushResult();
+
+private:
+    const Aggregator::Params params;
+    const Block header;
+
+    // The positions in `params.keys` of the keys output to `header`.
+    std::vector<size_t> output_key_indexes;
+
+    std::vector<size_t> offsets_of_aggregate_states;
+    size_t total_size_of_aggregate_states = 0;
+    size_t align_aggregate_states = 1;
+
+    // The keys and aggregate states of the current group.
+    bool has_current_group = false;
+    MutableColumns current_key_columns;
+    ColumnRawPtrs current_key_column_ptrs;
+    ArenaPtr arena;
+    AggregateDataPtr place = nullptr;
+
+    MutableColumns result_columns;
+    BlocksList output_blocks;
+    bool input_finished = false;
+
+    size_t src_rows = 0;
+    size_t result_rows = 0;
+};
+} // namespace DB
@@ -0,0 +1,126 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/SortHelper.h>
+#include <Interpreters/sortBlock.h>
+#include <Operators/PartitionTopNTransformOp.h>
+
+#include <unordered_set>
+
+namespace DB
+{
+void PartitionTopNTransformOp::operatePrefixImpl()
+{
+    std::unordered_set<String> partition_columns;
+    for (size_t i = 0; i < partition_key_size; ++i)
+        partition_columns.insert(order_desc[i].column_name);
+    // The constant columns are removed from the sort description, so are the constant partition keys.
+    SortHelper::removeConstantsFromSortDescription(header, order_desc);
+    partition_key_size = std::count_if(order_desc.begin(), order_desc.end(), [&](const auto & desc) {
+        return partition_columns.count(desc.column_name) > 0;
+    });
+}
+
+bool PartitionTopNTransformOp::isSamePartition(const ColumnRawPtrs & partition_columns, size_t lhs, size_t rhs) const
+{
+    for (size_t i = 0; i < partition_key_size; ++i)
+    {
+        const auto & desc = order_desc[i];
+        const int res = desc.collator
+            ? partition_columns[i]->compareAt(lhs, rhs, *partition_columns[i], desc.nulls_direction, *desc.collator)
+            : partition_columns[i]->compareAt(lhs, rhs, *partition_columns[i], desc.nulls_direction);
+        if (res != 0)
+            return false;
+    }
+    return true;
+}
+
+void PartitionTopNTransformOp::compact()
+{
+    if (buffered_blocks.empty())
+        return;
+    if (top_rows)
+        buffered_blocks.push_back(std::move(top_rows));
+    Block block = vstackBlocks(std::move(buffered_blocks));
+    buffered_blocks.clear();
+    buffered_rows = 0;
+
+    sortBlock(block, order_desc);
+
+    ColumnRawPtrs partition_columns;
+    partition_columns.reserve(partition_key_size);
+    for (size_t i = 0; i < partition_key_size; ++i)
+        partition_columns.push_back(block.getByName(order_desc[i].column_name).column.get());
+
+    const size_t rows = block.rows();
+    IColumn::Filter filter(rows);
+    size_t rows_in_partition = 0;
+    size_t result_rows = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        if (i > 0 && !isSamePartition(partition_columns, i - 1, i))
+            rows_in_partition = 0;
+        filter[i] = rows_in_partition < limit;
+        ++rows_in_partition;
+        result_rows += filter[i];
+    }
+    if (result_rows < rows)
+    {
+        for (auto & column : block)
+            column.column = column.column->filter(filter, result_rows);
+    }
+    top_rows = std::move(block);
+}
+
+OperatorStatus PartitionTopNTransformOp::transformImpl(Block & block)
+{
+    if unlikely (!block)
+    {
+        compact();
+        input_finished = true;
+        return tryOutputImpl(block);
+    }
+
+    SortHelper::removeConstantsFromBlock(block);
+    buffered_rows += block.rows();
+    buffered_blocks.push_back(std::move(block));
+    // Compact when the buffered rows are more than the kept rows, so that the cost of sorting the kept rows
+    // again is amortized to the buffered rows, and the memory is about twice of the kept rows at most.
+    if (buffered_rows >= std::max(top_rows.rows(), max_block_size))
+        compact();
+    return OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus PartitionTopNTransformOp::tryOutputImpl(Block & block)
+{
+    if (!input_finished)
+        return OperatorStatus::NEED_INPUT;
+
+    const size_t rows = top_rows.rows();
+    if (output_offset >= rows)
+    {
+        block = {};
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    const size_t length = std::min(max_block_size, rows - output_offset);
+    Columns columns;
+    columns.reserve(top_rows.columns());
+    for (const auto & column : top_rows)
+        columns.push_back(column.column->cut(output_offset, length));
+    output_offset += length;
+    block = top_rows.cloneWithColumns(std::move(columns));
+    SortHelper::enrichBlockWithConstants(block, header);
+    return OperatorStatus::HAS_OUTPUT;
+}
+} // namespace DB
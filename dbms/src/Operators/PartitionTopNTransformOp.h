@@ -0,0 +1,76 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/SortDescription.h>
+#include <Operators/Operator.h>
+
+namespace DB
+{
+/// Keep the first `limit` rows of each partition in the order of `order_desc`, and output them sorted by `order_desc`.
+/// The first `partition_key_size` columns of `order_desc` are the partition keys.
+/// It is used for `row_number() over (partition by ... order by ...) <= limit`, so that only O(partitions * limit)
+/// rows are kept instead of sorting the whole input.
+class PartitionTopNTransformOp : public TransformOp
+{
+public:
+    PartitionTopNTransformOp(
+        PipelineExecutorContext & exec_context_,
+        const String & req_id_,
+        const SortDescription & order_desc_,
+        size_t partition_key_size_,
+        size_t limit_,
+        size_t max_block_size_)
+        : TransformOp(exec_context_, req_id_)
+        , order_desc(order_desc_)
+        , partition_key_size(partition_key_size_)
+        , limit(limit_)
+        , max_block_size(max_block_size_)
+    {
+        RUNTIME_CHECK(limit > 0 && partition_key_size <= order_desc.size());
+    }
+
+    String getName() const override { return "PartitionTopNTransformOp"; }
+
+protected:
+    void operatePrefixImpl() override;
+
+    OperatorStatus transformImpl(Block & block) override;
+    OperatorStatus tryOutputImpl(Block & block) override;
+
+    void transformHeaderImpl(Block & /*header_*/) override {}
+
+private:
+    // Merge the buffered blocks into `top_rows`, and truncate each partition to `limit` rows.
+    void compact();
+
+    bool isSamePartition(const ColumnRawPtrs & partition_columns, size_t lhs, size_t rhs) const;
+
+private:
+    SortDescription order_desc;
+    size_t partition_key_size;
+    size_t limit;
+    size_t max_block_size;
+
+    // Sorted by `order_desc`, and there are at most `limit` rows for each partition.
+    // The constant columns are removed like MergeSortTransformOp.
+    Block top_rows;
+    Blocks buffered_blocks;
+    size_t buffered_rows = 0;
+
+    bool input_finished = false;
+    size_t output_offset = 0;
+};
+} // namespace DB
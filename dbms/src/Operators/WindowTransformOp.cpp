@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <DataStreams/ConcatBlockInputStream.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
 #include <Operators/WindowTransformOp.h>
 
 namespace DB
@@ -19,22 +21,56 @@ namespace DB
 WindowTransformOp::WindowTransformOp(
     PipelineExecutorContext & exec_context_,
     const String & req_id_,
-    const WindowDescription & window_description_)
+    const WindowDescription & window_description_,
+    size_t max_bytes_before_external_window,
+    const SpillConfig & spill_config,
+    const std::shared_ptr<FineGrainedOperatorSpillContext> & fine_grained_operator_spill_context)
     : TransformOp(exec_context_, req_id_)
     , window_description(window_description_)
-{}
+{
+    if (WindowTransformAction::supportBatchCalculate(window_description))
+    {
+        spill_context
+            = std::make_shared<SortSpillContext>(spill_config, max_bytes_before_external_window, log, "window");
+        if (fine_grained_operator_spill_context != nullptr)
+            fine_grained_operator_spill_context->addOperatorSpillContext(spill_context);
+        else
+            exec_context.registerOperatorSpillContext(spill_context);
+    }
+}
 
 void WindowTransformOp::transformHeaderImpl(Block & header_)
 {
     assert(!action);
     action = std::make_unique<WindowTransformAction>(header_, window_description, log->identifier());
+    // The restored blocks with only constant columns can not keep the rows of the spilled blocks.
+    if (spill_context
+        && std::none_of(header_.begin(), header_.end(), [](const auto & col) {
+               return !col.column || !col.column->isColumnConst();
+           }))
+        spill_context->disableSpill();
     header_ = action->output_header;
 }
 
+void WindowTransformOp::operatePrefixImpl()
+{
+    if (spill_context && spill_context->isSpillEnabled())
+    {
+        assert(action->supportSpill());
+        spill_header = action->input_header;
+        spill_context->buildSpiller(spill_header);
+    }
+}
+
 void WindowTransformOp::operateSuffixImpl()
 {
     if likely (action)
         action->cleanUp();
+    if unlikely (restore_stream)
+    {
+        restore_stream->readSuffix();
+        restore_stream.reset();
+    }
 }
 
 OperatorStatus WindowTransformOp::transformImpl(Block & block)
@@ -44,24 +80,80 @@ OperatorStatus WindowTransformOp::transformImpl(Block & block)
     if unlikely (!block)
     {
         action->input_is_finished = true;
-        block = action->tryGetOutputBlock();
-        return OperatorStatus::HAS_OUTPUT;
+        if (spill_context)
+            spill_context->finishSpillableStage();
     }
     else
     {
         action->appendBlock(block);
-        block = action->tryGetOutputBlock();
-        return block ? OperatorStatus::HAS_OUTPUT : OperatorStatus::NEED_INPUT;
     }
+    return tryOutputImpl(block);
 }
 
 OperatorStatus WindowTransformOp::tryOutputImpl(Block & block)
 {
     assert(action);
     block = action->tryGetOutputBlock();
+    if (block)
+        return OperatorStatus::HAS_OUTPUT;
+    if unlikely (action->needRestore())
+        return OperatorStatus::IO_IN;
     if unlikely (action->input_is_finished)
         return OperatorStatus::HAS_OUTPUT;
-    else
-        return block ? OperatorStatus::HAS_OUTPUT : OperatorStatus::NEED_INPUT;
+    return trySpill();
+}
+
+OperatorStatus WindowTransformOp::trySpill()
+{
+    if (!spill_context || !spill_context->updateRevocableMemory(action->revocableBytes()))
+        return OperatorStatus::NEED_INPUT;
+
+    assert(blocks_to_spill.empty());
+    blocks_to_spill = action->spillBlocks();
+    if (blocks_to_spill.empty())
+    {
+        // Nothing can be spilled now, such as the buffered rows are not scanned yet.
+        spill_context->finishOneSpill();
+        return OperatorStatus::NEED_INPUT;
+    }
+    spill_context->markSpilled();
+    return OperatorStatus::IO_OUT;
+}
+
+OperatorStatus WindowTransformOp::executeIOImpl()
+{
+    return blocks_to_spill.empty() ? restore() : spill();
+}
+
+OperatorStatus WindowTransformOp::spill()
+{
+    spill_context->getSpiller()->spillBlocks(std::move(blocks_to_spill), /*partition_id=*/0);
+    blocks_to_spill.clear();
+    spill_context->finishOneSpill();
+    return OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus WindowTransformOp::restore()
+{
+    assert(action->needRestore());
+    if (!restore_stream)
+    {
+        LOG_DEBUG(log, "Begin restore the spilled blocks of window partition.");
+        auto & spiller = spill_context->getSpiller();
+        spiller->finishSpill();
+        // Each spilled file is restored by one stream in the order of spilling, and the blocks are not merged.
+        restore_stream = std::make_shared<ConcatBlockInputStream>(spiller->restoreBlocks(0, 0), log->identifier());
+        restore_stream->readPrefix();
+    }
+
+    action->restoreBlock(restore_stream->read());
+    if (!action->hasSpilledBlocks())
+    {
+        restore_stream->readSuffix();
+        restore_stream.reset();
+        // The spiller can not be spilled again after restore, so build a new one for the next partition.
+        spill_context->buildSpiller(spill_header);
+    }
+    return OperatorStatus::HAS_OUTPUT;
 }
 } // namespace DB
@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <Core/FineGrainedOperatorSpillContext.h>
+#include <Core/Spiller.h>
 #include <DataStreams/WindowBlockInputStream.h>
+#include <Interpreters/SortSpillContext.h>
 #include <Operators/Operator.h>
 
 namespace DB
@@ -25,20 +28,42 @@ public:
     WindowTransformOp(
         PipelineExecutorContext & exec_context_,
         const String & req_id_,
-        const WindowDescription & window_description_);
+        const WindowDescription & window_description_,
+        size_t max_bytes_before_external_window,
+        const SpillConfig & spill_config,
+        const std::shared_ptr<FineGrainedOperatorSpillContext> & fine_grained_operator_spill_context);
 
     String getName() const override { return "WindowTransformOp"; }
 
 protected:
+    void operatePrefixImpl() override;
     void operateSuffixImpl() override;
 
     OperatorStatus transformImpl(Block & block) override;
     OperatorStatus tryOutputImpl(Block & block) override;
 
+    OperatorStatus executeIOImpl() override;
+
     void transformHeaderImpl(Block & header_) override;
 
+private:
+    OperatorStatus trySpill();
+
+    OperatorStatus spill();
+    OperatorStatus restore();
+
 private:
     WindowDescription window_description;
     std::unique_ptr<WindowTransformAction> action;
+
+    // Only the whole partition aggregation buffers the partition, see `WindowTransformAction::spillBlocks`.
+    // The blocks of one partition are spilled by one spiller, and restored in order when they are output,
+    // then a new spiller is built for the next partition.
+    SortSpillContextPtr spill_context;
+    Block spill_header;
+    // Used for spill, `spiller->spillBlocks` is executed in `executeIO`.
+    Blocks blocks_to_spill;
+    // Used for restore, `restore_stream->read` is executed in `executeIO`.
+    BlockInputStreamPtr restore_stream;
 };
 } // namespace DB
@@ -0,0 +1,128 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/registerAggregateFunctions.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Debug/TiFlashTestEnv.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Interpreters/Context.h>
+#include <Operators/OrderedAggregateTransformOp.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+namespace DB
+{
+namespace tests
+{
+class TestOrderedAggregate : public ::testing::Test
+{
+public:
+    void SetUp() override { ::DB::registerAggregateFunctions(); }
+};
+
+TEST_F(TestOrderedAggregate, basic)
+try
+{
+    // select key, sum(value), count(value) from t group by key;
+    auto context = TiFlashTestEnv::getContext();
+    auto data_type_int64 = std::make_shared<DataTypeInt64>();
+    Block src_header{{data_type_int64, "key"}, {data_type_int64, "value"}};
+    AggregateDescriptions agg_descs{
+        {.function = AggregateFunctionFactory::instance().get(*context, "sum", {data_type_int64}, {}, 0, false),
+         .parameters = {},
+         .arguments = {1},
+         .argument_names = {"value"},
+         .column_name = "sum(value)"},
+        {.function = AggregateFunctionFactory::instance().get(*context, "count", {data_type_int64}, {}, 0, false),
+         .parameters = {},
+         .arguments = {1},
+         .argument_names = {"value"},
+         .column_name = "count(value)"},
+    };
+
+    for (size_t max_block_size : {1, 2, 100})
+    {
+        SpillConfig spill_config(context->getTemporaryPath(), "test", 0, 0, 0, context->getFileProvider());
+        Aggregator::Params params(
+            src_header,
+            {0},
+            {},
+            {},
+            agg_descs,
+            0,
+            0,
+            0,
+            false,
+            spill_config,
+            max_block_size,
+            false);
+        PipelineExecutorContext exec_context;
+        OrderedAggregateTransformOp op(exec_context, "test", params);
+        Block header = src_header;
+        op.transformHeader(header);
+
+        // The rows of key 2 and key 4 are in more than one block, and key 1 is not adjacent.
+        Blocks input{
+            Block{createColumn<Int64>({1, 1, 2}, "key"), createColumn<Int64>({1, 2, 3}, "value")},
+            Block{createColumn<Int64>({2, 2, 3, 4}, "key"), createColumn<Int64>({4, 5, 6, 7}, "value")},
+            Block{
+                createColumn<Int64>(InferredDataVector<Int64>{}, "key"),
+                createColumn<Int64>(InferredDataVector<Int64>{}, "value")},
+            Block{createColumn<Int64>({4, 1}, "key"), createColumn<Int64>({8, 9}, "value")},
+        };
+        Blocks output;
+        auto collect = [&](OperatorStatus status, Block & block) {
+            if (status == OperatorStatus::HAS_OUTPUT && block)
+            {
+                ASSERT_LE(block.rows(), max_block_size);
+                output.push_back(std::move(block));
+            }
+            block = {};
+        };
+        for (auto & block : input)
+        {
+            Block res;
+            while (true)
+            {
+                auto status = op.tryOutput(res);
+                if (status != OperatorStatus::HAS_OUTPUT)
+                    break;
+                collect(status, res);
+            }
+            res = block;
+            collect(op.transform(res), res);
+        }
+        Block res;
+        auto status = op.transform(res);
+        while (status == OperatorStatus::HAS_OUTPUT && res)
+        {
+            collect(status, res);
+            status = op.tryOutput(res);
+        }
+        ASSERT_EQ(status, OperatorStatus::HAS_OUTPUT);
+
+        ASSERT_COLUMNS_EQ_R(
+            ColumnsWithTypeAndName(
+                {createColumn<Int64>({1, 2, 3, 4, 1}, "key"),
+                 createColumn<Int64>({3, 12, 6, 15, 9}, "sum(value)"),
+                 createColumn<UInt64>({2, 3, 1, 2, 1}, "count(value)")}),
+            vstackBlocks(std::move(output)).getColumnsWithTypeAndName());
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
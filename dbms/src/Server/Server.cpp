@@ -283,6 +283,11 @@ void initThreadPool(DisaggregatedMode disaggregated_mode)
             /*queue_size*/ default_num_threads * 2);
     }
 
+    SpillIOPool::initialize(
+        /*max_threads*/ default_num_threads,
+        /*max_free_threads*/ default_num_threads / 2,
+        /*queue_size*/ default_num_threads * 2);
+
     if (disaggregated_mode == DisaggregatedMode::Storage)
     {
         WNEstablishDisaggTaskPool::initialize(
@@ -337,6 +342,12 @@ void adjustThreadPoolSize(const Settings & settings, size_t logical_cores)
         RNWritePageCachePool::instance->setMaxFreeThreads(max_io_thread_count / 2);
         RNWritePageCachePool::instance->setQueueSize(max_io_thread_count * 2);
     }
+    if (SpillIOPool::instance)
+    {
+        SpillIOPool::instance->setMaxThreads(max_io_thread_count);
+        SpillIOPool::instance->setMaxFreeThreads(max_io_thread_count / 2);
+        SpillIOPool::instance->setQueueSize(max_io_thread_count * 2);
+    }
 
     size_t max_cpu_thread_count = std::ceil(settings.cpu_thread_count_scale * logical_cores);
     if (WNEstablishDisaggTaskPool::instance)
@@ -929,6 +940,11 @@ try
     if (minmax_index_cache_size)
         global_context->setMinMaxIndexCache(minmax_index_cache_size);
 
+    /// Size of cache for bloom filter index, used by DeltaMerge engine.
+    size_t bloom_filter_index_cache_size = config().getUInt64("bloom_filter_index_cache_size", mark_cache_size);
+    if (bloom_filter_index_cache_size)
+        global_context->setBloomFilterIndexCache(bloom_filter_index_cache_size);
+
     /// The vector index cache by number instead of bytes. Because it use `mmap` and let the operator system decide the memory usage.
     size_t light_local_index_cache_entities = config().getUInt64("light_local_index_cache_entities", 10000);
     size_t heavy_local_index_cache_entities = config().getUInt64("heavy_local_index_cache_entities", 500);
@@ -1194,7 +1210,9 @@ try
             };
             TaskSchedulerConfig config{
                 {get_pool_size(settings.pipeline_cpu_task_thread_pool_size),
-                 settings.pipeline_cpu_task_thread_pool_queue_type},
+                 settings.pipeline_cpu_task_thread_pool_queue_type,
+                 settings.pipeline_cpu_task_thread_pool_local_queue_size,
+                 settings.pipeline_cpu_task_thread_pool_numa_aware},
                 {get_pool_size(settings.pipeline_io_task_thread_pool_size),
                  settings.pipeline_io_task_thread_pool_queue_type},
             };
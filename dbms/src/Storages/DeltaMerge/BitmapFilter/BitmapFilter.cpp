@@ -15,21 +15,93 @@
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 
+#include <array>
+#include <bit>
+
 namespace DB::DM
 {
 
+namespace
+{
+using Word = BitmapFilter::Word;
+constexpr UInt32 BITS_PER_WORD = BitmapFilter::BITS_PER_WORD;
+
+static_assert(std::endian::native == std::endian::little, "BYTE_TO_BOOLS assumes little endian");
+
+// BYTE_TO_BOOLS[b] is 8 bytes of 0/1 which are the 8 bits of b, the lowest bit comes first.
+constexpr std::array<UInt64, 256> BYTE_TO_BOOLS = [] {
+    std::array<UInt64, 256> table{};
+    for (UInt32 b = 0; b < 256; ++b)
+    {
+        for (UInt32 i = 0; i < 8; ++i)
+            table[b] |= static_cast<UInt64>((b >> i) & 1) << (i * 8);
+    }
+    return table;
+}();
+
+// The lowest n bits are 1, n in [0, 64].
+ALWAYS_INLINE inline Word lowBits(UInt32 n)
+{
+    return n >= BITS_PER_WORD ? ~static_cast<Word>(0) : (static_cast<Word>(1) << n) - 1;
+}
+
+// Return bits [pos, pos+len) as the lowest bits of a word, len in [1, 64].
+ALWAYS_INLINE inline Word extractBits(const Word * words, size_t pos, UInt32 len)
+{
+    const size_t idx = pos / BITS_PER_WORD;
+    const UInt32 off = pos % BITS_PER_WORD;
+    Word w = words[idx] >> off;
+    if (off != 0 && off + len > BITS_PER_WORD)
+        w |= words[idx + 1] << (BITS_PER_WORD - off);
+    return w & lowBits(len);
+}
+
+// Expand the lowest `len` bits of `w` to `out[0, len)`, one byte per bit.
+ALWAYS_INLINE inline void expandBits(Word w, UInt8 * out, UInt32 len)
+{
+    if (w == 0)
+    {
+        memset(out, 0, len);
+        return;
+    }
+    if (w == lowBits(len))
+    {
+        memset(out, 1, len);
+        return;
+    }
+    UInt32 i = 0;
+    for (; i + 8 <= len; i += 8)
+        memcpy(out + i, &BYTE_TO_BOOLS[(w >> i) & 0xFF], 8);
+    for (; i < len; ++i)
+        out[i] = (w >> i) & 1;
+}
+} // namespace
+
 BitmapFilter::BitmapFilter(UInt32 size_, bool default_value)
-    : filter(size_, static_cast<UInt8>(default_value))
+    : words(wordCount(size_), default_value ? ~static_cast<Word>(0) : 0)
+    , bitmap_size(size_)
     , all_match(default_value)
-{}
+{
+    clearTailBits();
+}
 
 BitmapFilter::BitmapFilter(std::initializer_list<UInt8> init)
-    : filter(init)
+    : words(wordCount(init.size()), 0)
+    , bitmap_size(init.size())
     , all_match(false)
 {
+    size_t i = 0;
+    for (auto v : init)
+        (*this)[i++] = v;
     runOptimize();
 }
 
+void BitmapFilter::clearTailBits()
+{
+    if (const UInt32 tail = bitmap_size % BITS_PER_WORD; tail != 0)
+        words.back() &= lowBits(tail);
+}
+
 void BitmapFilter::set(BlockInputStreamPtr & stream)
 {
     stream->readPrefix();
@@ -60,7 +132,7 @@ void BitmapFilter::set(std::span<const UInt32> row_ids, const FilterPtr & f)
     {
         for (auto row_id : row_ids)
         {
-            filter[row_id] = true;
+            words[row_id / BITS_PER_WORD] |= static_cast<Word>(1) << (row_id % BITS_PER_WORD);
         }
     }
     else
@@ -68,108 +140,184 @@ void BitmapFilter::set(std::span<const UInt32> row_ids, const FilterPtr & f)
         RUNTIME_CHECK(row_ids.size() == f->size(), row_ids.size(), f->size());
         for (UInt32 i = 0; i < row_ids.size(); ++i)
         {
-            filter[row_ids[i]] = (*f)[i];
+            (*this)[row_ids[i]] = (*f)[i];
         }
     }
 }
 
 void BitmapFilter::set(UInt32 start, UInt32 limit, bool value)
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    std::fill_n(filter.begin() + start, limit, static_cast<UInt8>(value));
+    RUNTIME_CHECK(start + limit <= bitmap_size, start, limit, bitmap_size);
+    const size_t end = start + limit;
+    for (size_t pos = start; pos < end;)
+    {
+        const UInt32 off = pos % BITS_PER_WORD;
+        const UInt32 len = std::min<size_t>(BITS_PER_WORD - off, end - pos);
+        const Word mask = lowBits(len) << off;
+        auto & w = words[pos / BITS_PER_WORD];
+        w = value ? (w | mask) : (w & ~mask);
+        pos += len;
+    }
 }
 
 bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    auto begin = filter.cbegin() + start;
-    auto end = filter.cbegin() + start + limit;
-    if (all_match || std::find(begin, end, static_cast<UInt8>(false)) == end)
+    RUNTIME_CHECK(start + limit <= bitmap_size, start, limit, bitmap_size);
+    if (all_match || !anyBitEquals(start, limit, false))
     {
         return true;
     }
     else
     {
-        std::copy(begin, end, f.begin());
+        getRaw(f.data(), start, limit);
         return false;
     }
 }
 
+void BitmapFilter::getRaw(UInt8 * f, UInt32 start, UInt32 limit) const
+{
+    RUNTIME_CHECK(start + limit <= bitmap_size, start, limit, bitmap_size);
+    UInt32 i = 0;
+    for (; i + BITS_PER_WORD <= limit; i += BITS_PER_WORD)
+        expandBits(extractBits(words.data(), start + i, BITS_PER_WORD), f + i, BITS_PER_WORD);
+    if (i < limit)
+        expandBits(extractBits(words.data(), start + i, limit - i), f + i, limit - i);
+}
+
 void BitmapFilter::rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size() && f.size() == limit);
-    auto begin = filter.cbegin() + start;
-    if (!all_match)
+    RUNTIME_CHECK(start + limit <= bitmap_size && f.size() == limit);
+    if (all_match)
+        return;
+    auto * out = f.data();
+    for (UInt32 i = 0; i < limit; i += BITS_PER_WORD)
     {
-        std::transform(f.begin(), f.end(), begin, f.begin(), [](const auto a, const auto b) { return a && b; });
+        const UInt32 len = std::min(BITS_PER_WORD, limit - i);
+        const Word w = extractBits(words.data(), start + i, len);
+        if (w == lowBits(len))
+            continue;
+        if (w == 0)
+        {
+            memset(out + i, 0, len);
+            continue;
+        }
+        UInt32 j = 0;
+        for (; j + 8 <= len; j += 8)
+        {
+            // Turn each 0/1 byte into 0x00/0xFF, so that a non-zero byte in `f` is kept as it is.
+            const UInt64 mask = BYTE_TO_BOOLS[(w >> j) & 0xFF] * 0xFF;
+            UInt64 v;
+            memcpy(&v, out + i + j, 8);
+            v &= mask;
+            memcpy(out + i + j, &v, 8);
+        }
+        for (; j < len; ++j)
+            out[i + j] = out[i + j] && ((w >> j) & 1);
     }
 }
 
 void BitmapFilter::logicalOr(const BitmapFilter & other)
 {
-    RUNTIME_CHECK(filter.size() == other.filter.size());
+    RUNTIME_CHECK(bitmap_size == other.bitmap_size);
     if (all_match)
     {
         return;
     }
     if (other.all_match)
     {
-        filter.assign(filter.size(), static_cast<UInt8>(true));
+        words.assign(words.size(), ~static_cast<Word>(0));
+        clearTailBits();
         all_match = true;
         return;
     }
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    auto * dst = words.data();
+    const auto * src = other.words.data();
+    for (size_t i = 0; i < words.size(); ++i)
     {
-        filter[i] = filter[i] || other.filter[i];
+        dst[i] |= src[i];
     }
-    all_match = all_match || other.all_match;
 }
 
 void BitmapFilter::logicalAnd(const BitmapFilter & other)
 {
-    RUNTIME_CHECK(filter.size() == other.filter.size());
+    RUNTIME_CHECK(bitmap_size == other.bitmap_size);
     if (other.all_match)
         return;
     if (all_match)
     {
-        std::copy(other.filter.cbegin(), other.filter.cend(), filter.begin());
+        words.assign(other.words);
         all_match = other.all_match;
         return;
     }
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    auto * dst = words.data();
+    const auto * src = other.words.data();
+    for (size_t i = 0; i < words.size(); ++i)
     {
-        filter[i] = filter[i] && other.filter[i];
+        dst[i] &= src[i];
     }
-    all_match = all_match && other.all_match;
 }
 
 void BitmapFilter::append(const BitmapFilter & other)
 {
-    filter.insert(filter.end(), other.filter.cbegin(), other.filter.cend());
+    const size_t base = bitmap_size / BITS_PER_WORD;
+    const UInt32 shift = bitmap_size % BITS_PER_WORD;
+    bitmap_size += other.bitmap_size;
+    // The tail bits are 0, so the new words can be filled by OR.
+    words.resize_fill(wordCount(bitmap_size), 0);
+    const auto * src = other.words.data();
+    if (shift == 0)
+    {
+        memcpy(words.data() + base, src, other.words.size() * sizeof(Word));
+    }
+    else
+    {
+        for (size_t i = 0; i < other.words.size(); ++i)
+        {
+            words[base + i] |= src[i] << shift;
+            if (base + i + 1 < words.size())
+                words[base + i + 1] |= src[i] >> (BITS_PER_WORD - shift);
+        }
+    }
     all_match = all_match && other.all_match;
 }
 
+bool BitmapFilter::anyBitEquals(size_t start, size_t limit, bool value) const
+{
+    const size_t end = start + limit;
+    for (size_t pos = start; pos < end;)
+    {
+        const UInt32 off = pos % BITS_PER_WORD;
+        const UInt32 len = std::min<size_t>(BITS_PER_WORD - off, end - pos);
+        const Word mask = lowBits(len);
+        const Word w = (words[pos / BITS_PER_WORD] >> off) & mask;
+        if (value ? w != 0 : w != mask)
+            return true;
+        pos += len;
+    }
+    return false;
+}
+
 bool BitmapFilter::isAllNotMatch(size_t start, size_t limit) const
 {
     if (all_match)
     {
         return false;
     }
-    assert(start + limit <= filter.size());
-    return std::all_of(filter.cbegin() + start, filter.cbegin() + start + limit, [](const auto a) { return !a; });
+    assert(start + limit <= bitmap_size);
+    return !anyBitEquals(start, limit, true);
 }
 
 void BitmapFilter::runOptimize()
 {
-    all_match = std::find(filter.begin(), filter.end(), static_cast<UInt8>(false)) == filter.end();
+    all_match = !anyBitEquals(0, bitmap_size, false);
 }
 
 String BitmapFilter::toDebugString() const
 {
-    String s(filter.size(), '1');
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    String s(bitmap_size, '1');
+    for (UInt32 i = 0; i < bitmap_size; ++i)
     {
-        if (!filter[i])
+        if (!get(i))
         {
             s[i] = '0';
         }
@@ -179,6 +327,9 @@ String BitmapFilter::toDebugString() const
 
 size_t BitmapFilter::count() const
 {
-    return std::count(filter.cbegin(), filter.cend(), static_cast<UInt8>(true));
+    size_t n = 0;
+    for (auto w : words)
+        n += std::popcount(w);
+    return n;
 }
 } // namespace DB::DM
@@ -22,9 +22,39 @@
 namespace DB::DM
 {
 
+// BitmapFilter stores one bit per row, the bits are packed into 64-bit words.
+// The bits after `size()` in the last word are always 0, so that the word-wise
+// operations such as `count` and `operator==` don't need to handle the tail.
 class BitmapFilter
 {
 public:
+    using Word = UInt64;
+    static constexpr UInt32 BITS_PER_WORD = sizeof(Word) * 8;
+
+    // A proxy to access a single bit, returned by the non-const `operator[]`.
+    class BitReference
+    {
+    public:
+        BitReference(Word & word_, UInt32 bit_)
+            : word(word_)
+            , mask(static_cast<Word>(1) << bit_)
+        {}
+
+        ALWAYS_INLINE operator bool() const { return (word & mask) != 0; } // NOLINT(google-explicit-constructor)
+
+        ALWAYS_INLINE BitReference & operator=(bool value)
+        {
+            word = value ? (word | mask) : (word & ~mask);
+            return *this;
+        }
+
+        ALWAYS_INLINE BitReference & operator=(const BitReference & other) { return *this = static_cast<bool>(other); }
+
+    private:
+        Word & word;
+        Word mask;
+    };
+
     BitmapFilter(UInt32 size_, bool default_value);
     BitmapFilter(std::initializer_list<UInt8> init);
 
@@ -37,7 +67,9 @@ public:
     // If return true, all data is match and do not fill the filter.
     bool get(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
     // Caller should ensure n in [0, size).
-    inline bool get(UInt32 n) const { return filter[n]; }
+    inline bool get(UInt32 n) const { return (words[n / BITS_PER_WORD] >> (n % BITS_PER_WORD)) & 1; }
+    // Expand filter[start, start+limit) to f[0, limit), one byte per row.
+    void getRaw(UInt8 * f, UInt32 start, UInt32 limit) const;
     // filter[start, start+limit) & f -> f
     void rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
 
@@ -56,16 +88,30 @@ public:
 
     String toDebugString() const;
     size_t count() const;
-    inline size_t size() const { return filter.size(); }
+    inline size_t size() const { return bitmap_size; }
+    // The memory used by the bits.
+    inline size_t bytes() const { return words.allocated_bytes(); }
 
-    ALWAYS_INLINE auto & operator[](size_t n) { return filter[n]; }
+    ALWAYS_INLINE BitReference operator[](size_t n)
+    {
+        return BitReference(words[n / BITS_PER_WORD], static_cast<UInt32>(n % BITS_PER_WORD));
+    }
+    ALWAYS_INLINE bool operator[](size_t n) const { return get(n); }
 
-    bool operator==(const BitmapFilter & other) const { return filter == other.filter && all_match == other.all_match; }
-
-    friend class BitmapFilterView;
+    bool operator==(const BitmapFilter & other) const
+    {
+        return bitmap_size == other.bitmap_size && words == other.words && all_match == other.all_match;
+    }
 
 private:
-    IColumn::Filter filter;
+    static size_t wordCount(size_t size) { return (size + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+    // Clear the bits after `bitmap_size` in the last word.
+    void clearTailBits();
+    // Whether any bit in [start, start+limit) equals to `value`.
+    bool anyBitEquals(size_t start, size_t limit, bool value) const;
+
+    PaddedPODArray<Word> words;
+    size_t bitmap_size;
     bool all_match;
 };
 
@@ -55,9 +55,9 @@ public:
     IColumn::Filter getRawSubFilter(UInt32 offset, UInt32 size) const
     {
         RUNTIME_CHECK(offset + size <= filter_size, offset, size, filter_size);
-        return IColumn::Filter{
-            filter->filter.data() + filter_offset + offset,
-            filter->filter.data() + filter_offset + offset + size};
+        IColumn::Filter f(size);
+        filter->getRaw(f.data(), filter_offset + offset, size);
+        return f;
     }
 
     // Caller should ensure n in [0, size).
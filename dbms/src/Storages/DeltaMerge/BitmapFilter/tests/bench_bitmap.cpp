@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Core/Defines.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <benchmark/benchmark.h>
 
 #include <random>
@@ -155,6 +156,133 @@ static void bitmapGetRangeUInt8(benchmark::State & state)
     bitmapGetRange<UInt8>(state);
 }
 
+static void bitmapAndBitmapFilter(benchmark::State & state)
+{
+    DM::BitmapFilter a(TEST_BITMAP_SIZE, false);
+    DM::BitmapFilter b(TEST_BITMAP_SIZE, false);
+    for (auto _ : state)
+    {
+        DM::BitmapFilter c = a;
+        c.logicalAnd(b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+static void bitmapSetRowIDBitmapFilter(benchmark::State & state)
+{
+    constexpr size_t rowid_count = 45678;
+    auto row_ids = genRandomRowIDs(rowid_count, TEST_BITMAP_SIZE);
+    for (auto _ : state)
+    {
+        DM::BitmapFilter filter(TEST_BITMAP_SIZE, false);
+        filter.set(row_ids, nullptr);
+        benchmark::DoNotOptimize(filter);
+    }
+}
+
+DM::BitmapFilter buildBitmapFilterByRanges(const std::vector<std::pair<size_t, size_t>> & ranges, size_t bitmap_size)
+{
+    DM::BitmapFilter filter(bitmap_size, false);
+    for (auto [start, limit] : ranges)
+    {
+        filter.set(start, limit);
+    }
+    return filter;
+}
+
+static void bitmapSetRangeBitmapFilter(benchmark::State & state)
+{
+    const std::vector<std::pair<size_t, size_t>> set_ranges = {
+        {0, 8192},
+        {8192 * 2, 8192},
+        {8192 * 5, 8192},
+    };
+    for (auto _ : state)
+    {
+        auto filter = buildBitmapFilterByRanges(set_ranges, TEST_BITMAP_SIZE);
+        benchmark::DoNotOptimize(filter);
+    }
+}
+
+static void bitmapGetRangeBitmapFilter(benchmark::State & state)
+{
+    const std::vector<std::pair<size_t, size_t>> set_ranges = {
+        {0, 8192},
+        {8192 * 2, 8192},
+        {8192 * 5, 8192},
+    };
+    auto filter = buildBitmapFilterByRanges(set_ranges, TEST_BITMAP_SIZE);
+
+    const std::vector<std::pair<size_t, size_t>> get_ranges = {
+        {1234, 8192},
+        {8192 * 2 + 1234, 8192},
+        {8192 * 5 + 1234, 8192},
+    };
+    IColumn::Filter f(8192);
+    for (auto _ : state)
+    {
+        for (auto [start, limit] : get_ranges)
+        {
+            filter.get(f, start, limit);
+        }
+        benchmark::DoNotOptimize(f);
+    }
+}
+
+// Sparse rows, such as the result of the inverted index or vector index.
+static void bitmapGetRangeSparseBitmapFilter(benchmark::State & state)
+{
+    constexpr size_t rowid_count = 100;
+    auto row_ids = genRandomRowIDs(rowid_count, TEST_BITMAP_SIZE);
+    DM::BitmapFilter filter(TEST_BITMAP_SIZE, false);
+    filter.set(row_ids, nullptr);
+    IColumn::Filter f(8192);
+    for (auto _ : state)
+    {
+        for (size_t start = 0; start < TEST_BITMAP_SIZE; start += 8192)
+        {
+            if (!filter.isAllNotMatch(start, 8192))
+                filter.get(f, start, 8192);
+        }
+        benchmark::DoNotOptimize(f);
+    }
+}
+
+template <typename T>
+void bitmapCountStd(benchmark::State & state)
+{
+    constexpr size_t rowid_count = 45678;
+    auto row_ids = genRandomRowIDs(rowid_count, TEST_BITMAP_SIZE);
+    std::vector<T> v(TEST_BITMAP_SIZE, static_cast<T>(0));
+    for (auto id : row_ids)
+    {
+        v[id] = static_cast<T>(1);
+    }
+    for (auto _ : state)
+    {
+        auto n = std::count(v.begin(), v.end(), static_cast<T>(1));
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+static void bitmapCountUInt8(benchmark::State & state)
+{
+    bitmapCountStd<UInt8>(state);
+}
+
+static void bitmapCountBitmapFilter(benchmark::State & state)
+{
+    constexpr size_t rowid_count = 45678;
+    auto row_ids = genRandomRowIDs(rowid_count, TEST_BITMAP_SIZE);
+    DM::BitmapFilter filter(TEST_BITMAP_SIZE, false);
+    filter.set(row_ids, nullptr);
+    for (auto _ : state)
+    {
+        auto n = filter.count();
+        benchmark::DoNotOptimize(n);
+    }
+}
+
 BENCHMARK(bitmapAndBool);
 BENCHMARK(bitmapAndUInt8);
 BENCHMARK(bitmapSetRowIDBool);
@@ -163,4 +291,11 @@ BENCHMARK(bitmapSetRangeBool);
 BENCHMARK(bitmapSetRangeUInt8);
 BENCHMARK(bitmapGetRangeBool);
 BENCHMARK(bitmapGetRangeUInt8);
+BENCHMARK(bitmapAndBitmapFilter);
+BENCHMARK(bitmapSetRowIDBitmapFilter);
+BENCHMARK(bitmapSetRangeBitmapFilter);
+BENCHMARK(bitmapGetRangeBitmapFilter);
+BENCHMARK(bitmapGetRangeSparseBitmapFilter);
+BENCHMARK(bitmapCountUInt8);
+BENCHMARK(bitmapCountBitmapFilter);
 } // namespace DB::bench
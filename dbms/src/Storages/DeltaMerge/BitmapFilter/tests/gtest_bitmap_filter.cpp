@@ -0,0 +1,155 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilterView.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB::DM::tests
+{
+
+namespace
+{
+// Build a BitmapFilter and the expected bytes with random bits.
+std::pair<BitmapFilter, std::vector<UInt8>> genRandomFilter(UInt32 size, UInt32 seed)
+{
+    std::mt19937 gen(seed);
+    BitmapFilter filter(size, false);
+    std::vector<UInt8> expected(size);
+    for (UInt32 i = 0; i < size; ++i)
+    {
+        expected[i] = gen() % 2;
+        filter[i] = expected[i];
+    }
+    return {std::move(filter), std::move(expected)};
+}
+} // namespace
+
+TEST(BitmapFilterTest, SetAndGet)
+{
+    BitmapFilter filter(200, false);
+    ASSERT_EQ(filter.size(), 200);
+    ASSERT_EQ(filter.count(), 0);
+    ASSERT_FALSE(filter.isAllMatch());
+
+    filter.set(3, 130);
+    ASSERT_EQ(filter.count(), 130);
+    ASSERT_FALSE(filter.get(2));
+    ASSERT_TRUE(filter.get(3));
+    ASSERT_TRUE(filter.get(132));
+    ASSERT_FALSE(filter.get(133));
+
+    filter.set(60, 10, false);
+    ASSERT_EQ(filter.count(), 120);
+    ASSERT_TRUE(filter.isAllNotMatch(60, 10));
+    ASSERT_FALSE(filter.isAllNotMatch(59, 10));
+
+    filter[199] = true;
+    ASSERT_TRUE(filter[199]);
+    filter[199] = filter[0];
+    ASSERT_FALSE(filter[199]);
+
+    BitmapFilter all(200, true);
+    ASSERT_EQ(all.count(), 200);
+    ASSERT_TRUE(all.isAllMatch());
+}
+
+TEST(BitmapFilterTest, GetRange)
+{
+    auto [filter, expected] = genRandomFilter(1000, 1);
+    for (auto [start, limit] : std::vector<std::pair<UInt32, UInt32>>{{0, 1000}, {1, 63}, {7, 200}, {64, 64}, {999, 1}})
+    {
+        IColumn::Filter f(limit);
+        // All rows in the range match, `f` is not filled.
+        if (filter.get(f, start, limit))
+            std::fill(f.begin(), f.end(), 1);
+        for (UInt32 i = 0; i < limit; ++i)
+            ASSERT_EQ(f[i], expected[start + i]) << start << " " << i;
+
+        IColumn::Filter g(limit, 1);
+        g[0] = 0;
+        filter.rangeAnd(g, start, limit);
+        ASSERT_EQ(g[0], 0);
+        for (UInt32 i = 1; i < limit; ++i)
+            ASSERT_EQ(g[i], expected[start + i]) << start << " " << i;
+    }
+
+    auto view = BitmapFilterView(std::make_shared<BitmapFilter>(filter), 10, 500);
+    auto raw = view.getRawSubFilter(5, 300);
+    for (UInt32 i = 0; i < 300; ++i)
+        ASSERT_EQ(raw[i], expected[15 + i]);
+
+    BitmapFilter all(100, true);
+    IColumn::Filter f(50);
+    ASSERT_TRUE(all.get(f, 3, 50));
+}
+
+TEST(BitmapFilterTest, LogicalOp)
+{
+    auto [a, expected_a] = genRandomFilter(300, 2);
+    auto [b, expected_b] = genRandomFilter(300, 3);
+    auto c = a;
+    c.logicalAnd(b);
+    auto d = a;
+    d.logicalOr(b);
+    for (UInt32 i = 0; i < 300; ++i)
+    {
+        ASSERT_EQ(c.get(i), expected_a[i] && expected_b[i]);
+        ASSERT_EQ(d.get(i), expected_a[i] || expected_b[i]);
+    }
+
+    auto e = a;
+    e.logicalOr(BitmapFilter(300, true));
+    ASSERT_TRUE(e.isAllMatch());
+    ASSERT_EQ(e.count(), 300);
+    ASSERT_EQ(e, BitmapFilter(300, true));
+}
+
+TEST(BitmapFilterTest, Append)
+{
+    for (UInt32 size : {0, 1, 63, 64, 65, 130})
+    {
+        auto [a, expected_a] = genRandomFilter(size, size);
+        auto [b, expected_b] = genRandomFilter(100, size + 1);
+        a.append(b);
+        ASSERT_EQ(a.size(), size + 100);
+        ASSERT_EQ(
+            a.count(),
+            static_cast<size_t>(
+                std::count(expected_a.begin(), expected_a.end(), 1)
+                + std::count(expected_b.begin(), expected_b.end(), 1)));
+        for (UInt32 i = 0; i < size; ++i)
+            ASSERT_EQ(a.get(i), expected_a[i]);
+        for (UInt32 i = 0; i < 100; ++i)
+            ASSERT_EQ(a.get(size + i), expected_b[i]);
+    }
+}
+
+TEST(BitmapFilterTest, RunOptimize)
+{
+    BitmapFilter filter{1, 1, 1};
+    ASSERT_TRUE(filter.isAllMatch());
+    ASSERT_EQ(filter.toDebugString(), "111");
+
+    BitmapFilter filter2{1, 0, 1};
+    ASSERT_FALSE(filter2.isAllMatch());
+    ASSERT_EQ(filter2.toDebugString(), "101");
+    filter2[1] = 1;
+    filter2.runOptimize();
+    ASSERT_TRUE(filter2.isAllMatch());
+}
+
+} // namespace DB::DM::tests
@@ -124,7 +124,7 @@ ColumnFileTinyPtr ColumnFileTinyLocalIndexWriter::buildIndexForFile(
             file->getDataPageId());
 
         for (auto & index : indexes)
-            index.index_writer = LocalIndexWriter::createInMemory(index.info);
+            index.index_writer = LocalIndexWriter::createInMemory(index.info, options.enable_inverted_index_v2);
 
         read_columns->push_back(*cd_iter);
     }
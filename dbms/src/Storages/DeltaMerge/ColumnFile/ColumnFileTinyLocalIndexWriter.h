@@ -52,6 +52,8 @@ public:
         const IColumnFileDataProviderPtr data_provider;
         const LocalIndexInfosPtr index_infos;
         WriteBatches & wbs; // Write index and modify meta in the same batch.
+        // Whether to write the integer inverted indexes in V2 format.
+        const bool enable_inverted_index_v2 = false;
     };
 
     explicit ColumnFileTinyLocalIndexWriter(const Options & options)
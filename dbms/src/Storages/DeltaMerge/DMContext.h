@@ -100,6 +100,10 @@ struct DMContext : private boost::noncopyable
     const bool enable_relevant_place;
     const bool enable_skippable_place;
 
+    // Read the String columns output to the query as ColumnDictionaryString, only set when the operators
+    // consuming the table scan can handle it, see `dt_enable_read_string_dictionary`.
+    bool read_string_dictionary = false;
+
     String tracing_id;
 
     const ScanContextPtr scan_context;
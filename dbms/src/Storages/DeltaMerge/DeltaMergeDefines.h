@@ -22,6 +22,7 @@
 #include <Storages/DeltaMerge/ColumnDefine_fwd.h>
 #include <Storages/KVStore/Types.h>
 #include <Storages/MutableSupport.h>
+#include <TiDB/Schema/TiDB_fwd.h>
 
 #include <limits>
 #include <memory>
@@ -108,6 +109,8 @@ struct Attr
     String col_name;
     ColId col_id;
     DataTypePtr type;
+    // Only set for string column, the collator to compare the values with.
+    TiDB::TiDBCollatorPtr collator = nullptr;
 };
 using Attrs = std::vector<Attr>;
 } // namespace DB::DM
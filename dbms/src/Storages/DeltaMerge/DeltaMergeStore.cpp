@@ -1273,10 +1273,12 @@ BlockInputStreams DeltaMergeStore::read(
     size_t expected_block_size,
     const SegmentIdSet & read_segments,
     size_t extra_table_id_index,
-    ScanContextPtr scan_context)
+    ScanContextPtr scan_context,
+    bool read_string_dictionary)
 {
     // Use the id from MPP/Coprocessor level as tracing_id
     auto dm_context = newDMContext(db_context, db_settings, tracing_id, scan_context);
+    dm_context->read_string_dictionary = read_string_dictionary;
 
     // If keep order is required, disable read thread.
     auto enable_read_thread = db_context.getSettingsRef().dt_enable_read_thread && !keep_order;
@@ -1384,10 +1386,12 @@ void DeltaMergeStore::read(
     size_t expected_block_size,
     const SegmentIdSet & read_segments,
     size_t extra_table_id_index,
-    ScanContextPtr scan_context)
+    ScanContextPtr scan_context,
+    bool read_string_dictionary)
 {
     // Use the id from MPP/Coprocessor level as tracing_id
     auto dm_context = newDMContext(db_context, db_settings, tracing_id, scan_context);
+    dm_context->read_string_dictionary = read_string_dictionary;
 
     // If keep order is required, disable read thread.
     auto enable_read_thread = db_context.getSettingsRef().dt_enable_read_thread && !keep_order;
@@ -469,7 +469,8 @@ public:
         size_t expected_block_size = DEFAULT_BLOCK_SIZE,
         const SegmentIdSet & read_segments = {},
         size_t extra_table_id_index = MutSup::invalid_col_id,
-        ScanContextPtr scan_context = nullptr);
+        ScanContextPtr scan_context = nullptr,
+        bool read_string_dictionary = false);
 
 
     /// Read rows in two modes:
@@ -494,7 +495,8 @@ public:
         size_t expected_block_size = DEFAULT_BLOCK_SIZE,
         const SegmentIdSet & read_segments = {},
         size_t extra_table_id_index = MutSup::invalid_col_id,
-        ScanContextPtr scan_context = nullptr);
+        ScanContextPtr scan_context = nullptr,
+        bool read_string_dictionary = false);
 
     Remote::DisaggPhysicalTableReadSnapshotPtr writeNodeBuildRemoteReadSnapshot(
         const Context & db_context,
@@ -1047,6 +1047,7 @@ void DeltaMergeStore::segmentEnsureDeltaLocalIndex(
         .data_provider = persisted_files_snap->getDataProvider(),
         .index_infos = index_info,
         .wbs = wbs,
+        .enable_inverted_index_v2 = dm_context.global_context.getSettingsRef().dt_enable_inverted_index_v2,
     });
 
     ColumnFileTinys new_tiny_files;
@@ -41,6 +41,7 @@ struct ColumnStat
     size_t index_bytes = 0;
     size_t sizes_bytes = 0; // Array sizes or String sizes, depends on the data type of this column
     size_t sizes_mark_bytes = 0;
+    size_t bloom_filter_bytes = 0;
 
     std::vector<dtpb::DMFileIndexInfo> indexes{};
 
@@ -63,6 +64,7 @@ struct ColumnStat
         stat.set_index_bytes(index_bytes);
         stat.set_sizes_bytes(sizes_bytes);
         stat.set_sizes_mark_bytes(sizes_mark_bytes);
+        stat.set_bloom_filter_bytes(bloom_filter_bytes);
 
         for (const auto & idx : indexes)
         {
@@ -91,6 +93,7 @@ struct ColumnStat
         index_bytes = proto.index_bytes();
         sizes_bytes = proto.sizes_bytes();
         sizes_mark_bytes = proto.sizes_mark_bytes();
+        bloom_filter_bytes = proto.bloom_filter_bytes();
 
         // Backward compatibility: There is a `vector_index` field.
         if unlikely (proto.has_deprecated_vector_index())
@@ -197,6 +197,11 @@ String DMFile::colMarkCacheKey(const FileNameBase & file_name_base) const
     return colMarkPath(file_name_base);
 }
 
+String DMFile::colBloomFilterCacheKey(const FileNameBase & file_name_base) const
+{
+    return subFilePath(colBloomFilterFileName(file_name_base));
+}
+
 bool DMFile::isColIndexExist(const ColId & col_id) const
 {
     if (useMetaV2())
@@ -210,6 +215,14 @@ bool DMFile::isColIndexExist(const ColId & col_id) const
     }
 }
 
+bool DMFile::isColBloomFilterExist(const ColId & col_id) const
+{
+    if (!useMetaV2())
+        return false;
+    auto itr = meta->column_stats.find(col_id);
+    return itr != meta->column_stats.end() && itr->second.bloom_filter_bytes > 0;
+}
+
 size_t DMFile::colIndexSize(ColId id) const
 {
     if (useMetaV2())
@@ -211,6 +211,8 @@ public:
     UInt32 metaVersion() const { return meta->metaVersion(); }
 
     bool isColIndexExist(const ColId & col_id) const;
+    // The bloom filter index is only written to the merged file, see `DMFileWriter::Options::enable_bloom_filter`.
+    bool isColBloomFilterExist(const ColId & col_id) const;
 
 private:
     DMFile(
@@ -294,6 +296,7 @@ private:
 
     String colIndexCacheKey(const FileNameBase & file_name_base) const;
     String colMarkCacheKey(const FileNameBase & file_name_base) const;
+    String colBloomFilterCacheKey(const FileNameBase & file_name_base) const;
 
     String encryptionBasePath() const;
     EncryptionPath encryptionDataPath(const FileNameBase & file_name_base) const;
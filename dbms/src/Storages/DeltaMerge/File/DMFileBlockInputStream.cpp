@@ -39,6 +39,7 @@ DMFileBlockInputStreamBuilder::DMFileBlockInputStreamBuilder(const Context & con
     setCaches(
         global_context.getMarkCache(),
         global_context.getMinMaxIndexCache(),
+        global_context.getBloomFilterIndexCache(),
         global_context.getColumnCacheLongTerm());
     // init from settings
     setFromSettings(context.getSettingsRef());
@@ -85,7 +86,8 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::buildNoLocalIndex(
             rowkey_ranges,
             EMPTY_RS_OPERATOR,
             read_packs,
-            tracing_id);
+            tracing_id,
+            bloom_filter_cache);
     }
 
     DMFileReader reader(
@@ -109,6 +111,9 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::buildNoLocalIndex(
         max_sharing_column_bytes_for_all,
         scan_context,
         read_tag);
+    reader.setReadStringDictionary(read_string_dictionary);
+    if (encoded_filter)
+        reader.setEncodedFilter(encoded_filter);
 
     return std::make_shared<DMFileBlockInputStream>(std::move(reader), max_sharing_column_bytes_for_all > 0);
 }
@@ -205,7 +210,8 @@ SkippableBlockInputStreamPtr DMFileBlockInputStreamBuilder::buildForVectorIndex(
             rowkey_ranges,
             EMPTY_RS_OPERATOR,
             read_packs,
-            tracing_id);
+            tracing_id,
+            bloom_filter_cache);
     }
 
     DMFileReader rest_columns_reader(
@@ -290,7 +296,8 @@ SkippableBlockInputStreamPtr DMFileBlockInputStreamBuilder::buildForFullTextInde
             rowkey_ranges,
             EMPTY_RS_OPERATOR,
             read_packs,
-            tracing_id);
+            tracing_id,
+            bloom_filter_cache);
     }
 
     DMFileReader rest_columns_reader(
@@ -177,6 +177,20 @@ public:
         return *this;
     }
 
+    // Read the non-nullable String columns as ColumnDictionaryString when the packs are dictionary encoded.
+    DMFileBlockInputStreamBuilder & enableStringDictionary(bool read_string_dictionary_)
+    {
+        read_string_dictionary = read_string_dictionary_;
+        return *this;
+    }
+
+    // Evaluate the comparisons on the encoded packs before reading the columns, see `EncodedFilter`.
+    DMFileBlockInputStreamBuilder & setEncodedFilter(const EncodedFilterPtr & encoded_filter_)
+    {
+        encoded_filter = encoded_filter_;
+        return *this;
+    }
+
     /**
      * @note To really enable the long term cache, you also need to ensure
      * ColumnCacheLongTerm is initialized in the global context.
@@ -216,10 +230,12 @@ private:
     DMFileBlockInputStreamBuilder & setCaches(
         const MarkCachePtr & mark_cache_,
         const MinMaxIndexCachePtr & index_cache_,
+        const BloomFilterIndexCachePtr & bloom_filter_cache_,
         const ColumnCacheLongTermPtr & column_cache_long_term_)
     {
         mark_cache = mark_cache_;
         index_cache = index_cache_;
+        bloom_filter_cache = bloom_filter_cache_;
         column_cache_long_term = column_cache_long_term_;
         return *this;
     }
@@ -237,6 +253,7 @@ private:
     IdSetPtr read_packs;
     MarkCachePtr mark_cache;
     MinMaxIndexCachePtr index_cache;
+    BloomFilterIndexCachePtr bloom_filter_cache;
     // column cache
     bool enable_column_cache = false;
     ColumnCachePtr column_cache;
@@ -247,6 +264,8 @@ private:
     size_t max_sharing_column_bytes_for_all = 0;
     String tracing_id;
     ReadTag read_tag = ReadTag::Internal;
+    bool read_string_dictionary = false;
+    EncodedFilterPtr encoded_filter;
 
     DMFilePackFilterResultPtr pack_filter;
 
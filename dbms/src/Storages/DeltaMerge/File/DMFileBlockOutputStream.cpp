@@ -31,7 +31,10 @@ DMFileBlockOutputStream::DMFileBlockOutputStream(
                 context.getSettingsRef().dt_compression_method,
                 context.getSettingsRef().dt_compression_level),
             context.getSettingsRef().min_compress_block_size,
-            context.getSettingsRef().max_compress_block_size})
+            context.getSettingsRef().max_compress_block_size,
+            context.getSettingsRef().dt_enable_bloom_filter_index,
+            context.getSettingsRef().dt_enable_lightweight_float_compression,
+            context.getSettingsRef().dt_enable_lightweight_string_compression})
 {}
 
 } // namespace DB::DM
\ No newline at end of file
@@ -157,7 +157,10 @@ size_t DMFileLocalIndexWriter::buildIndexForFile(const DMFilePtr & dm_file_mutab
                 index.info.column_id,
                 index.info.index_id);
 
-            index.index_writer = LocalIndexWriter::createOnDisk(index.index_file_path, index.info);
+            index.index_writer = LocalIndexWriter::createOnDisk(
+                index.index_file_path,
+                index.info,
+                options.dm_context.global_context.getSettingsRef().dt_enable_inverted_index_v2);
         }
         read_columns.push_back(*cd_iter);
     }
@@ -26,6 +26,52 @@
 namespace DB::DM
 {
 
+std::pair<std::unique_ptr<ReadBufferFromFileBase>, size_t> DMFilePackFilter::readMergedSubFile(
+    const DMFile & dmfile,
+    const FileProviderPtr & file_provider,
+    const String & fname,
+    const String & debug_path,
+    const ReadLimiterPtr & read_limiter)
+{
+    const auto * dmfile_meta = typeid_cast<const DMFileMetaV2 *>(dmfile.meta.get());
+    assert(dmfile_meta != nullptr);
+    auto info = dmfile_meta->merged_sub_file_infos.find(fname);
+    if (info == dmfile_meta->merged_sub_file_infos.end())
+    {
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Unknown index file {}", debug_path);
+    }
+
+    auto file_path = dmfile.meta->mergedPath(info->second.number);
+    auto encryp_path = dmfile_meta->encryptionMergedPath(info->second.number);
+    auto offset = info->second.offset;
+    auto data_size = info->second.size;
+
+    auto buffer = ReadBufferFromRandomAccessFileBuilder::build(
+        file_provider,
+        file_path,
+        encryp_path,
+        dmfile.getConfiguration()->getChecksumFrameLength(),
+        read_limiter);
+    buffer.seek(offset);
+
+    String raw_data;
+    raw_data.resize(data_size);
+
+    buffer.read(reinterpret_cast<char *>(raw_data.data()), data_size);
+
+    auto buf = ChecksumReadBufferBuilder::build(
+        std::move(raw_data),
+        debug_path,
+        dmfile.getConfiguration()->getChecksumFrameLength(),
+        dmfile.getConfiguration()->getChecksumAlgorithm(),
+        dmfile.getConfiguration()->getChecksumFrameLength());
+
+    auto header_size = dmfile.getConfiguration()->getChecksumHeaderLength();
+    auto frame_total_size = dmfile.getConfiguration()->getChecksumFrameLength() + header_size;
+    auto frame_count = data_size / frame_total_size + (data_size % frame_total_size != 0);
+    return {std::move(buf), data_size - header_size * frame_count};
+}
+
 DMFilePackFilter::MatchDetails DMFilePackFilter::loadValidRowsAndBytes(
     const DMContext & dm_context,
     const DMFilePtr & dmfile,
@@ -129,6 +175,7 @@ DMFilePackFilterResultPtr DMFilePackFilter::load()
         for (const auto & id : ids)
         {
             tryLoadIndex(result.param, id);
+            tryLoadBloomFilter(result.param, id);
         }
 
         const auto check_results = filter->roughCheck(0, pack_count, result.param);
@@ -230,47 +277,13 @@ std::pair<DataTypePtr, MinMaxIndexPtr> DMFilePackFilter::loadIndex(
         }
         else if (dmfile.useMetaV2()) // v3
         {
-            const auto * dmfile_meta = typeid_cast<const DMFileMetaV2 *>(dmfile.meta.get());
-            assert(dmfile_meta != nullptr);
-            auto info = dmfile_meta->merged_sub_file_infos.find(colIndexFileName(file_name_base));
-            if (info == dmfile_meta->merged_sub_file_infos.end())
-            {
-                throw Exception(
-                    ErrorCodes::LOGICAL_ERROR,
-                    "Unknown index file {}",
-                    dmfile.colIndexPath(file_name_base));
-            }
-
-            auto file_path = dmfile.meta->mergedPath(info->second.number);
-            auto encryp_path = dmfile_meta->encryptionMergedPath(info->second.number);
-            auto offset = info->second.offset;
-            auto data_size = info->second.size;
-
-            auto buffer = ReadBufferFromRandomAccessFileBuilder::build(
+            auto [buf, content_size] = readMergedSubFile(
+                dmfile,
                 file_provider,
-                file_path,
-                encryp_path,
-                dmfile.getConfiguration()->getChecksumFrameLength(),
-                read_limiter);
-            buffer.seek(offset);
-
-            String raw_data;
-            raw_data.resize(data_size);
-
-            buffer.read(reinterpret_cast<char *>(raw_data.data()), data_size);
-
-            auto buf = ChecksumReadBufferBuilder::build(
-                std::move(raw_data),
+                colIndexFileName(file_name_base),
                 dmfile.colIndexPath(file_name_base), // just for debug
-                dmfile.getConfiguration()->getChecksumFrameLength(),
-                dmfile.getConfiguration()->getChecksumAlgorithm(),
-                dmfile.getConfiguration()->getChecksumFrameLength());
-
-            auto header_size = dmfile.getConfiguration()->getChecksumHeaderLength();
-            auto frame_total_size = dmfile.getConfiguration()->getChecksumFrameLength() + header_size;
-            auto frame_count = index_file_size / frame_total_size + (index_file_size % frame_total_size != 0);
-
-            return MinMaxIndex::read(*type, *buf, index_file_size - header_size * frame_count);
+                read_limiter);
+            return MinMaxIndex::read(*type, *buf, content_size);
         }
         else
         { // v2
@@ -316,6 +329,60 @@ void DMFilePackFilter::tryLoadIndex(RSCheckParam & param, ColId col_id)
     loadIndex(param.indexes, dmfile, file_provider, index_cache, set_cache_if_miss, col_id, read_limiter, scan_context);
 }
 
+BloomFilterIndexPtr DMFilePackFilter::loadBloomFilter(
+    const DMFile & dmfile,
+    const FileProviderPtr & file_provider,
+    const BloomFilterIndexCachePtr & bloom_filter_cache,
+    bool set_cache_if_miss,
+    ColId col_id,
+    const ReadLimiterPtr & read_limiter,
+    const ScanContextPtr & scan_context)
+{
+    const auto file_name_base = DMFile::getFileNameBase(col_id);
+    auto load = [&]() {
+        auto fname = colBloomFilterFileName(file_name_base);
+        auto guard = S3::S3RandomAccessFile::setReadFileInfo({
+            .size = dmfile.getReadFileSize(col_id, fname),
+            .scan_context = scan_context,
+        });
+        auto [buf, content_size]
+            = readMergedSubFile(dmfile, file_provider, fname, dmfile.colBloomFilterCacheKey(file_name_base), read_limiter);
+        return BloomFilterIndex::read(*buf, content_size);
+    };
+    BloomFilterIndexPtr bloom_filter;
+    if (bloom_filter_cache && set_cache_if_miss)
+    {
+        bloom_filter = bloom_filter_cache->getOrSet(dmfile.colBloomFilterCacheKey(file_name_base), load);
+    }
+    else
+    {
+        if (bloom_filter_cache)
+            bloom_filter = bloom_filter_cache->get(dmfile.colBloomFilterCacheKey(file_name_base));
+        if (bloom_filter == nullptr)
+            bloom_filter = load();
+    }
+    return bloom_filter;
+}
+
+void DMFilePackFilter::tryLoadBloomFilter(RSCheckParam & param, ColId col_id)
+{
+    if (param.bloom_filters.contains(col_id))
+        return;
+
+    if (!dmfile->isColBloomFilterExist(col_id))
+        return;
+
+    auto bloom_filter = loadBloomFilter(
+        *dmfile,
+        file_provider,
+        bloom_filter_cache,
+        set_cache_if_miss,
+        col_id,
+        read_limiter,
+        scan_context);
+    param.bloom_filters.emplace(col_id, ColumnBloomFilter{dmfile->getColumnStat(col_id).type, bloom_filter});
+}
+
 std::pair<std::vector<DMFilePackFilter::Range>, DMFilePackFilterResults> DMFilePackFilter::getSkippedRangeAndFilter(
     const DMContext & dm_context,
     const DMFiles & dmfiles,
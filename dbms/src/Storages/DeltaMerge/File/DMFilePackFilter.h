@@ -65,6 +65,7 @@ public:
         DMFilePackFilter pack_filter(
             dmfile,
             dm_context.global_context.getMinMaxIndexCache(),
+            dm_context.global_context.getBloomFilterIndexCache(),
             set_cache_if_miss,
             rowkey_ranges,
             filter,
@@ -86,11 +87,13 @@ public:
         const RowKeyRanges & rowkey_ranges,
         const RSOperatorPtr & filter,
         const IdSetPtr & read_packs,
-        const String & tracing_id)
+        const String & tracing_id,
+        const BloomFilterIndexCachePtr & bloom_filter_cache_ = nullptr)
     {
         DMFilePackFilter pack_filter(
             dmfile,
             index_cache_,
+            bloom_filter_cache_,
             set_cache_if_miss,
             rowkey_ranges,
             filter,
@@ -163,6 +166,7 @@ private:
     DMFilePackFilter(
         const DMFilePtr & dmfile_,
         const MinMaxIndexCachePtr & index_cache_,
+        const BloomFilterIndexCachePtr & bloom_filter_cache_,
         bool set_cache_if_miss_,
         const RowKeyRanges & rowkey_ranges_, // filter by handle range
         const RSOperatorPtr & filter_, // filter by push down where clause
@@ -173,6 +177,7 @@ private:
         const String & tracing_id)
         : dmfile(dmfile_)
         , index_cache(index_cache_)
+        , bloom_filter_cache(bloom_filter_cache_)
         , set_cache_if_miss(set_cache_if_miss_)
         , rowkey_ranges(rowkey_ranges_)
         , filter(filter_)
@@ -197,10 +202,31 @@ private:
 
     void tryLoadIndex(RSCheckParam & param, ColId col_id);
 
+    // Read the sub file `fname` from the merged file of DMFile v3.
+    // Return the buffer and the size of the content without checksum headers.
+    static std::pair<std::unique_ptr<ReadBufferFromFileBase>, size_t> readMergedSubFile(
+        const DMFile & dmfile,
+        const FileProviderPtr & file_provider,
+        const String & fname,
+        const String & debug_path,
+        const ReadLimiterPtr & read_limiter);
+
+    static BloomFilterIndexPtr loadBloomFilter(
+        const DMFile & dmfile,
+        const FileProviderPtr & file_provider,
+        const BloomFilterIndexCachePtr & bloom_filter_cache,
+        bool set_cache_if_miss,
+        ColId col_id,
+        const ReadLimiterPtr & read_limiter,
+        const ScanContextPtr & scan_context);
+
+    void tryLoadBloomFilter(RSCheckParam & param, ColId col_id);
+
 private:
     DMFilePtr dmfile;
 
     MinMaxIndexCachePtr index_cache;
+    BloomFilterIndexCachePtr bloom_filter_cache;
     bool set_cache_if_miss;
     RowKeyRanges rowkey_ranges;
     RSOperatorPtr filter;
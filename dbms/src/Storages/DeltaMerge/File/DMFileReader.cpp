@@ -12,12 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnDictionaryString.h>
 #include <Columns/countBytesInFilter.h>
+#include <Common/Arena.h>
 #include <Common/Exception.h>
+#include <Common/HashTable/HashMap.h>
 #include <Common/MemoryTracker.h>
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Common/escapeForFileName.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeString.h>
 #include <DataTypes/IDataType.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/File/ColumnCacheLongTerm.h>
@@ -28,6 +33,8 @@
 #include <common/logger_useful.h>
 #include <fmt/format.h>
 
+#include <numeric>
+
 
 namespace DB::ErrorCodes
 {
@@ -207,7 +214,8 @@ Block DMFileReader::readWithFilter(const IColumn::Filter & filter)
             }
             for (size_t i = 0; i < block.columns(); ++i)
             {
-                auto column = block.getByPosition(i).column;
+                // The string dictionary can not be inserted into a plain column, so it is materialized.
+                auto column = block.getByPosition(i).column->convertToFullColumnIfConst();
                 columns[i]->insertSelectiveFrom(*column, offsets);
             }
         }
@@ -215,7 +223,8 @@ Block DMFileReader::readWithFilter(const IColumn::Filter & filter)
         {
             for (size_t i = 0; i < block.columns(); ++i)
             {
-                columns[i]->insertRangeFrom(*block.getByPosition(i).column, 0, passed_count);
+                auto column = block.getByPosition(i).column->convertToFullColumnIfConst();
+                columns[i]->insertRangeFrom(*column, 0, passed_count);
             }
         }
     }
@@ -257,6 +266,26 @@ Block DMFileReader::readImpl(const ReadBlockInfo & read_info)
     const size_t start_row_offset = pack_offset[start_pack_id];
     addScannedRows(read_rows);
 
+    auto block_rs_result = rs_result;
+    if (!encoded_predicates.empty() && !rs_result.allMatch())
+    {
+        const auto encoded_result = evaluateEncodedFilter(start_pack_id, read_rows);
+        if (!encoded_result.isUse())
+        {
+            // No row passes the filter, the columns are not read and the block is filtered out.
+            ColumnsWithTypeAndName columns;
+            columns.reserve(read_columns.size());
+            for (const auto & cd : read_columns)
+                columns.emplace_back(cd.type->createColumnConstWithDefaultValue(read_rows), cd.type, cd.name, cd.id);
+            Block res(std::move(columns));
+            res.setStartOffset(start_row_offset);
+            res.setRSResult(encoded_result);
+            return res;
+        }
+        if (encoded_result.allMatch())
+            block_rs_result = encoded_result;
+    }
+
     /// 2. Find packs can do clean read.
 
     const bool need_read_extra_columns = std::any_of(read_columns.cbegin(), read_columns.cend(), [](const auto & cd) {
@@ -362,10 +391,84 @@ Block DMFileReader::readImpl(const ReadBlockInfo & read_info)
 
     Block res(std::move(columns));
     res.setStartOffset(start_row_offset);
-    res.setRSResult(rs_result);
+    res.setRSResult(block_rs_result);
     return res;
 }
 
+void DMFileReader::setEncodedFilter(const EncodedFilterPtr & encoded_filter)
+{
+    encoded_predicates.clear();
+    encoded_filter_complete = encoded_filter->is_complete;
+    for (const auto & predicate : encoded_filter->predicates)
+    {
+        // The column must be read as the same type as it is on disk, otherwise it is casted after read.
+        const auto iter = std::find_if(read_columns.cbegin(), read_columns.cend(), [&](const auto & cd) {
+            return cd.id == predicate.col_id;
+        });
+        if (iter != read_columns.cend() && dmfile->isColumnExist(predicate.col_id)
+            && dmfile->getColumnStat(predicate.col_id).type->equals(*iter->type))
+            encoded_predicates.push_back(EncodedPredicateState{.predicate = predicate});
+        else
+            encoded_filter_complete = false;
+    }
+}
+
+RSResult DMFileReader::evaluateEncodedFilter(size_t start_pack_id, size_t read_rows)
+{
+    PaddedPODArray<UInt8> filter(read_rows);
+    bool all_match = encoded_filter_complete;
+    for (auto iter = encoded_predicates.begin(); iter != encoded_predicates.end();)
+    {
+        const auto & predicate = iter->predicate;
+        auto & stream = column_streams.at(DMFile::getFileNameBase(predicate.col_id));
+        if (!stream->buf->readIntegerFilter(
+                stream->getOffsetInFile(start_pack_id),
+                stream->getOffsetInDecompressedBlock(start_pack_id),
+                read_rows,
+                predicate.predicate,
+                filter.data()))
+        {
+            LOG_DEBUG(
+                log,
+                "Not evaluate the filter on the encoded packs, column_id={} start_pack_id={}",
+                predicate.col_id,
+                start_pack_id);
+            iter = encoded_predicates.erase(iter);
+            encoded_filter_complete = false;
+            all_match = false;
+            continue;
+        }
+        const auto passed_count = countBytesInFilter(filter);
+        if (passed_count == 0)
+        {
+            iter->continuous_some_blocks = 0;
+            return RSResult::None;
+        }
+        if (passed_count == read_rows)
+        {
+            iter->continuous_some_blocks = 0;
+            ++iter;
+            continue;
+        }
+
+        all_match = false;
+        if (++iter->continuous_some_blocks >= max_encoded_filter_continuous_some_blocks)
+        {
+            LOG_DEBUG(
+                log,
+                "Stop evaluating the filter on the encoded packs, column_id={} start_pack_id={} some_blocks={}",
+                predicate.col_id,
+                start_pack_id,
+                iter->continuous_some_blocks);
+            iter = encoded_predicates.erase(iter);
+            encoded_filter_complete = false;
+            continue;
+        }
+        ++iter;
+    }
+    return all_match ? RSResult::All : RSResult::Some;
+}
+
 ColumnPtr DMFileReader::cleanRead(
     const ColumnDefine & cd,
     size_t rows_count,
@@ -497,6 +600,14 @@ ColumnPtr DMFileReader::readColumn(const ColumnDefine & cd, size_t start_pack_id
     // Not cached
     if (!enable_column_cache || !isCacheableColumn(cd))
     {
+        if (read_string_dictionary && type_on_disk->getName() == DataTypeString::NameV2
+            && typeid_cast<const DataTypeString *>(cd.type.get()) != nullptr
+            && !string_dictionary_failed_columns.contains(cd.id))
+        {
+            if (auto column = readStringDictionaryFromDisk(cd, start_pack_id, read_rows))
+                return column;
+            string_dictionary_failed_columns.insert(cd.id);
+        }
         auto column = readFromDiskOrSharingCache(cd, type_on_disk, start_pack_id, pack_count, read_rows);
         // Cast column's data from DataType in disk to what we need now
         return convertColumnByColumnDefineIfNeed(type_on_disk, std::move(column), cd);
@@ -560,6 +671,70 @@ ColumnPtr DMFileReader::readFromDisk(
     return mutable_col;
 }
 
+ColumnPtr DMFileReader::readStringDictionaryFromDisk(const ColumnDefine & cd, size_t start_pack_id, size_t read_rows)
+{
+    IDataType::SubstreamPath path;
+    auto & chars_stream = column_streams.at(DMFile::getFileNameBase(cd.id, path));
+    path.emplace_back(IDataType::Substream::StringSizes);
+    auto & sizes_stream = column_streams.at(DMFile::getFileNameBase(cd.id, path));
+
+    // The strings are split by '\0' in the dictionary encoded blocks, so a string containing '\0' is split into
+    // several tokens. The total size of the strings is compared with the tokens read to find out this case.
+    PaddedPODArray<ColumnString::Offset> sizes(read_rows);
+    sizes_stream->buf->seek(
+        sizes_stream->getOffsetInFile(start_pack_id),
+        sizes_stream->getOffsetInDecompressedBlock(start_pack_id));
+    const size_t sizes_bytes = sizeof(ColumnString::Offset) * read_rows;
+    if (sizes_stream->buf->readBig(reinterpret_cast<char *>(sizes.data()), sizes_bytes) != sizes_bytes)
+        return nullptr;
+    const size_t expected_chars_bytes = std::accumulate(sizes.begin(), sizes.end(), 0uz);
+
+    auto dictionary = ColumnString::create();
+    auto indexes = ColumnDictionaryString::ColumnIndexes::create();
+    auto & index_data = indexes->getData();
+    index_data.reserve(read_rows);
+    // The dictionaries of the blocks are merged, the keys are copied into the arena because
+    // the chars of `dictionary` may be reallocated.
+    Arena pool;
+    HashMap<StringRef, UInt32, StringRefHash> merged_indexes;
+    constexpr auto unresolved = std::numeric_limits<UInt32>::max();
+    std::vector<UInt32> block_to_merged;
+    size_t chars_bytes = 0;
+    const bool success = chars_stream->buf->readStringDictionary(
+        chars_stream->getOffsetInFile(start_pack_id),
+        chars_stream->getOffsetInDecompressedBlock(start_pack_id),
+        read_rows,
+        [&](const Compression::StringDictionary & dict, const UInt32 * block_indexes, size_t count) {
+            block_to_merged.assign(dict.tokens.size(), unresolved);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto & token = dict.tokens[block_indexes[i]];
+                auto & merged_index = block_to_merged[block_indexes[i]];
+                if (merged_index == unresolved)
+                {
+                    if (auto it = merged_indexes.find(token); it != merged_indexes.end())
+                    {
+                        merged_index = it->getMapped();
+                    }
+                    else
+                    {
+                        merged_index = dictionary->size();
+                        merged_indexes[StringRef{pool.insert(token.data, token.size), token.size}] = merged_index;
+                        dictionary->insertData(token.data, token.size);
+                    }
+                }
+                index_data.push_back(merged_index);
+                chars_bytes += token.size + 1;
+            }
+        });
+    if (!success || index_data.size() != read_rows || chars_bytes != expected_chars_bytes)
+    {
+        LOG_DEBUG(log, "Not read as a string dictionary, column_id={} start_pack_id={}", cd.id, start_pack_id);
+        return nullptr;
+    }
+    return ColumnDictionaryString::create(std::move(dictionary), std::move(indexes));
+}
+
 ColumnPtr DMFileReader::readFromDiskOrSharingCache(
     const ColumnDefine & cd,
     const DataTypePtr & type_on_disk,
@@ -22,6 +22,7 @@
 #include <Storages/DeltaMerge/File/DMFile.h>
 #include <Storages/DeltaMerge/File/DMFilePackFilter.h>
 #include <Storages/DeltaMerge/File/ReadBlockInfo.h>
+#include <Storages/DeltaMerge/Filter/EncodedFilter.h>
 #include <Storages/DeltaMerge/Filter/RSOperator_fwd.h>
 #include <Storages/DeltaMerge/ReadMode.h>
 #include <Storages/DeltaMerge/ReadThread/DMFileReaderPool.h>
@@ -29,6 +30,8 @@
 #include <Storages/DeltaMerge/ScanContext_fwd.h>
 #include <Storages/MarkCache.h>
 
+#include <unordered_set>
+
 namespace DB::DM
 {
 
@@ -110,6 +113,10 @@ private:
 
     Block readImpl(const ReadBlockInfo & read_info);
 
+    // Evaluate `encoded_predicates` on the encoded packs without decompressing them.
+    // Return None if no row passes them, All if all rows pass the whole pushed down filter, otherwise Some.
+    RSResult evaluateEncodedFilter(size_t start_pack_id, size_t read_rows);
+
     ColumnPtr readExtraColumn(
         const ColumnDefine & cd,
         size_t start_pack_id,
@@ -121,6 +128,9 @@ private:
         const DataTypePtr & type_on_disk,
         size_t start_pack_id,
         size_t read_rows);
+    // Read a String column as a ColumnDictionaryString from the dictionary encoded blocks of the lightweight codec.
+    // Return nullptr if the blocks are not dictionary encoded, then the column should be read by `readFromDisk`.
+    ColumnPtr readStringDictionaryFromDisk(const ColumnDefine & cd, size_t start_pack_id, size_t read_rows);
     ColumnPtr readFromDiskOrSharingCache(
         const ColumnDefine & cd,
         const DataTypePtr & type_on_disk,
@@ -207,9 +217,33 @@ public:
         pk_col_id = pk_col_id_;
     }
 
+    void setReadStringDictionary(bool read_string_dictionary_) { read_string_dictionary = read_string_dictionary_; }
+
+    void setEncodedFilter(const EncodedFilterPtr & encoded_filter);
+
 private:
     ColumnCacheLongTermPtr column_cache_long_term = nullptr;
     ColumnID pk_col_id = 0;
+
+    // Whether to read the non-nullable String columns as ColumnDictionaryString when the packs are dictionary encoded.
+    bool read_string_dictionary = false;
+    // The columns that are not dictionary encoded, they are read by `readFromDisk` directly.
+    std::unordered_set<ColId> string_dictionary_failed_columns;
+
+    struct EncodedPredicateState
+    {
+        EncodedFilter::Predicate predicate;
+        // The number of continuous blocks that only some of the rows pass the predicate.
+        size_t continuous_some_blocks = 0;
+    };
+    // The comparisons evaluated on the encoded packs of the filter columns, see `EncodedFilter`.
+    // A predicate is removed once its column is not encoded by the supported modes, or it can not
+    // filter out or accept the whole block for several blocks in a row, because such blocks are
+    // decoded again by the normal read.
+    std::vector<EncodedPredicateState> encoded_predicates;
+    static constexpr size_t max_encoded_filter_continuous_some_blocks = 4;
+    // Whether `encoded_predicates` are still the whole pushed down filter.
+    bool encoded_filter_complete = false;
 };
 
 } // namespace DB::DM
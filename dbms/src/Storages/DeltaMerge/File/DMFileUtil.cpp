@@ -54,5 +54,9 @@ String colMarkFileName(const FileNameBase & file_name_base)
 {
     return file_name_base + details::MARK_FILE_SUFFIX;
 }
+String colBloomFilterFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::BLOOM_FILTER_FILE_SUFFIX;
+}
 
 } // namespace DB::DM
\ No newline at end of file
@@ -29,6 +29,7 @@ inline constexpr static const char * FOLDER_PREFIX_DROPPED = ".del.dmf_";
 inline constexpr static const char * DATA_FILE_SUFFIX = ".dat";
 inline constexpr static const char * INDEX_FILE_SUFFIX = ".idx";
 inline constexpr static const char * MARK_FILE_SUFFIX = ".mrk";
+inline constexpr static const char * BLOOM_FILTER_FILE_SUFFIX = ".bf";
 
 inline String getNGCPath(const String & prefix)
 {
@@ -50,5 +51,6 @@ using FileNameBase = String;
 String colDataFileName(const FileNameBase & file_name_base);
 String colIndexFileName(const FileNameBase & file_name_base);
 String colMarkFileName(const FileNameBase & file_name_base);
+String colBloomFilterFileName(const FileNameBase & file_name_base);
 
 } // namespace DB::DM
\ No newline at end of file
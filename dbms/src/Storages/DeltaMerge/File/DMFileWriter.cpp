@@ -63,8 +63,11 @@ DMFileWriter::DMFileWriter(
         /// for handle column always generate index
         auto type = removeNullable(cd.type);
         bool do_index = cd.id == MutSup::extra_handle_id || type->isInteger() || type->isDateOrDateTime();
+        // The hidden columns such as handle, version and tag are not filtered by `=` or `IN`, skip them.
+        bool do_bloom_filter = options.enable_bloom_filter && dmfile->useMetaV2() && cd.id >= 0
+            && BloomFilterIndex::isSupportedType(*cd.type);
 
-        addStreams(cd.id, cd.type, do_index);
+        addStreams(cd.id, cd.type, do_index, do_bloom_filter);
         dmfile->meta->getColumnStats().emplace(
             cd.id,
             ColumnStat{
@@ -109,7 +112,7 @@ DMFileWriter::WriteBufferFromFileBasePtr DMFileWriter::createMetaFile()
     }
 }
 
-void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
+void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index, bool do_bloom_filter)
 {
     auto callback = [&](const IDataType::SubstreamPath & substream_path) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream_path);
@@ -123,7 +126,10 @@ void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
             options.max_compress_block_size,
             file_provider,
             write_limiter,
-            do_index && substream_can_index);
+            do_index && substream_can_index,
+            do_bloom_filter && substream_can_index,
+            options.enable_lightweight_float,
+            options.enable_lightweight_string);
         column_streams.emplace(stream_name, std::move(stream));
     };
     type->enumerateStreams(callback, {});
@@ -211,6 +217,8 @@ void DMFileWriter::writeColumn(
                     column,
                     (col_id == MutSup::extra_handle_id || col_id == MutSup::delmark_col_id) ? nullptr : del_mark);
             }
+            if (stream->bloom_filter)
+                stream->bloom_filter->addPack(column, del_mark);
 
             /// There could already be enough data to compress into the new block.
             if (stream->compressed_buf->offset() >= options.min_compress_block_size)
@@ -337,6 +345,33 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
                 buffer->next();
             }
 
+            // write bloom filter into merged_file_writer
+            if (stream->bloom_filter && !is_empty_file)
+            {
+                dmfile_meta->checkMergedFile(merged_file, file_provider, write_limiter);
+
+                auto fname = colBloomFilterFileName(stream_name);
+
+                auto buffer = ChecksumWriteBufferBuilder::build(
+                    merged_file.buffer,
+                    dmfile->getConfiguration()->getChecksumAlgorithm(),
+                    dmfile->getConfiguration()->getChecksumFrameLength());
+
+                stream->bloom_filter->write(*buffer);
+
+                col_stat.bloom_filter_bytes = buffer->getMaterializedBytes();
+
+                MergedSubFileInfo info{
+                    fname,
+                    merged_file.file_info.number,
+                    merged_file.file_info.size,
+                    col_stat.bloom_filter_bytes};
+                dmfile_meta->merged_sub_file_infos[fname] = info;
+
+                merged_file.file_info.size += col_stat.bloom_filter_bytes;
+                buffer->next();
+            }
+
             // write mark into merged_file_writer
             if (!is_empty_file)
             {
@@ -22,6 +22,7 @@
 #include <IO/FileProvider/ChecksumWriteBufferBuilder.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
 namespace DB::DM
@@ -53,7 +54,10 @@ public:
             size_t max_compress_block_size,
             FileProviderPtr & file_provider,
             const WriteLimiterPtr & write_limiter_,
-            bool do_index)
+            bool do_index,
+            bool do_bloom_filter,
+            bool enable_lightweight_float,
+            bool enable_lightweight_string)
             : plain_file(ChecksumWriteBufferBuilder::build(
                 dmfile->getConfiguration().has_value(),
                 file_provider,
@@ -67,9 +71,15 @@ public:
                 /*mode*/ 0666,
                 max_compress_block_size))
             , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type) : nullptr)
+            , bloom_filter(do_bloom_filter ? std::make_shared<BloomFilterIndex>() : nullptr)
         {
             assert(compression_settings.settings.size() == 1);
-            auto setting = getCompressionSetting(type, file_base_name, compression_settings.settings[0]);
+            auto setting = getCompressionSetting(
+                type,
+                file_base_name,
+                compression_settings.settings[0],
+                enable_lightweight_float,
+                enable_lightweight_string);
             compressed_buf = CompressedWriteBuffer<>::build(
                 *plain_file,
                 CompressionSettings(setting),
@@ -99,16 +109,34 @@ public:
             return removeNullable(type)->getTypeId() == TypeIndex::String && file_base_name.ends_with(".size");
         }
 
+        static bool isStringChars(const DataTypePtr & type, const String & file_base_name)
+        {
+            return removeNullable(type)->getTypeId() == TypeIndex::String && !file_base_name.ends_with(".size")
+                && !file_base_name.ends_with(".null");
+        }
+
         static CompressionSetting getCompressionSetting(
             const DataTypePtr & type,
             const String & file_base_name,
-            const CompressionSetting & setting)
+            const CompressionSetting & setting,
+            bool enable_lightweight_float,
+            bool enable_lightweight_string)
         {
             // Force use Lightweight compression for string sizes, since the string sizes almost always small.
             // Performance of LZ4 to decompress such integers is not good.
-            return isStringSizes(type, file_base_name)
-                ? CompressionSetting{CompressionMethod::Lightweight, CompressionDataType::Int64}
-                : CompressionSetting::create<>(setting.method, setting.level, *type);
+            if (isStringSizes(type, file_base_name))
+                return CompressionSetting{CompressionMethod::Lightweight, CompressionDataType::Int64};
+            // The chars of Nullable(String) are compressed as String, so that they can use the string modes of
+            // Lightweight compression.
+            auto data_type = isStringChars(type, file_base_name) ? removeNullable(type) : type;
+            auto result = CompressionSetting::create<>(setting.method, setting.level, *data_type);
+            // The float and string modes of Lightweight compression can not be read by the versions before them,
+            // so they are only used when enabled. Otherwise the data is compressed by LZ4 as before.
+            if (!enable_lightweight_float && isFloatingPoint(result.data_type))
+                result.data_type = CompressionDataType::Unknown;
+            if (!enable_lightweight_string && result.data_type == CompressionDataType::String)
+                result.data_type = CompressionDataType::Unknown;
+            return result;
         }
 
         // compressed_buf -> plain_file
@@ -116,6 +144,7 @@ public:
         WriteBufferPtr compressed_buf;
 
         MinMaxIndexPtr minmaxes;
+        BloomFilterIndexPtr bloom_filter;
 
         MarksInCompressedFilePtr marks;
 
@@ -137,16 +166,28 @@ public:
         CompressionSettings compression_settings;
         size_t min_compress_block_size{};
         size_t max_compress_block_size{};
+        // Write a bloom filter index for the integer and string columns, only for DMFile that uses meta v2.
+        bool enable_bloom_filter = false;
+        // Use the float modes of Lightweight compression, see `dt_enable_lightweight_float_compression`.
+        bool enable_lightweight_float = false;
+        // Use the string modes of Lightweight compression, see `dt_enable_lightweight_string_compression`.
+        bool enable_lightweight_string = false;
 
         Options() = default;
 
         Options(
             CompressionSettings compression_settings_,
             size_t min_compress_block_size_,
-            size_t max_compress_block_size_)
+            size_t max_compress_block_size_,
+            bool enable_bloom_filter_ = false,
+            bool enable_lightweight_float_ = false,
+            bool enable_lightweight_string_ = false)
             : compression_settings(compression_settings_)
             , min_compress_block_size(min_compress_block_size_)
             , max_compress_block_size(max_compress_block_size_)
+            , enable_bloom_filter(enable_bloom_filter_)
+            , enable_lightweight_float(enable_lightweight_float_)
+            , enable_lightweight_string(enable_lightweight_string_)
         {}
 
         Options(const Options & from) = default;
@@ -177,7 +218,7 @@ private:
     /// Add streams with specified column id. Since a single column may have more than one Stream,
     /// for example Nullable column has a NullMap column, we would track them with a mapping
     /// FileNameBase -> Stream.
-    void addStreams(ColId col_id, DataTypePtr type, bool do_index);
+    void addStreams(ColId col_id, DataTypePtr type, bool do_index, bool do_bloom_filter);
 
     WriteBufferFromFileBasePtr createMetaFile();
     void finalizeMeta();
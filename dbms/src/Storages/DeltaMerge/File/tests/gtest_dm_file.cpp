@@ -16,6 +16,7 @@
 #include <Core/ColumnWithTypeAndName.h>
 #include <IO/BaseFile/PosixRandomAccessFile.h>
 #include <IO/BaseFile/PosixWritableFile.h>
+#include <IO/Compression/CompressionCodecFactory.h>
 #include <Interpreters/Context.h>
 #include <Poco/DirectoryIterator.h>
 #include <Storages/DeltaMerge/DMContext.h>
@@ -2423,4 +2424,49 @@ INSTANTIATE_TEST_CASE_P(
     testing::Values(DMFileMode::DirectoryLegacy, DMFileMode::DirectoryChecksum, DMFileMode::DirectoryMetaV2),
     paramToString);
 
+TEST(DMFileWriterTest, LightweightFloatCompressionSetting)
+try
+{
+    const CompressionSetting lightweight(CompressionMethod::Lightweight);
+    for (const auto & type : {typeFromString("Float32"), typeFromString("Nullable(Float64)")})
+    {
+        // The float modes are not used by default, the floats are compressed by LZ4 as before.
+        auto setting = DMFileWriter::Stream::getCompressionSetting(type, "1", lightweight, false, false);
+        ASSERT_EQ(setting.method_byte, CompressionMethodByte::Lightweight);
+        ASSERT_EQ(setting.data_type, CompressionDataType::Unknown);
+        auto codec = CompressionCodecFactory::create(setting);
+        ASSERT_EQ(codec->getMethodByte(), static_cast<UInt8>(CompressionMethodByte::LZ4));
+    }
+
+    auto setting = DMFileWriter::Stream::getCompressionSetting(typeFromString("Float32"), "1", lightweight, true, false);
+    ASSERT_EQ(setting.data_type, CompressionDataType::Float32);
+    auto codec = CompressionCodecFactory::create(setting);
+    ASSERT_EQ(codec->getMethodByte(), static_cast<UInt8>(CompressionMethodByte::Lightweight));
+}
+CATCH
+
+TEST(DMFileWriterTest, LightweightStringCompressionSetting)
+try
+{
+    const CompressionSetting lightweight(CompressionMethod::Lightweight);
+    for (const auto & type : {typeFromString("String"), typeFromString("Nullable(String)")})
+    {
+        // The string modes are not used by default, the chars are compressed by LZ4 as before.
+        auto setting = DMFileWriter::Stream::getCompressionSetting(type, "1", lightweight, false, false);
+        ASSERT_EQ(setting.data_type, CompressionDataType::Unknown);
+        auto codec = CompressionCodecFactory::create(setting);
+        ASSERT_EQ(codec->getMethodByte(), static_cast<UInt8>(CompressionMethodByte::LZ4));
+
+        setting = DMFileWriter::Stream::getCompressionSetting(type, "1", lightweight, false, true);
+        ASSERT_EQ(setting.data_type, CompressionDataType::String);
+        codec = CompressionCodecFactory::create(setting);
+        ASSERT_EQ(codec->getMethodByte(), static_cast<UInt8>(CompressionMethodByte::Lightweight));
+
+        // The sizes are always compressed by Lightweight as integers.
+        setting = DMFileWriter::Stream::getCompressionSetting(type, "1.size", lightweight, false, false);
+        ASSERT_EQ(setting.data_type, CompressionDataType::Int64);
+    }
+}
+CATCH
+
 } // namespace DB::DM::tests
@@ -0,0 +1,48 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <IO/Compression/EncodingUtil.h>
+#include <Storages/KVStore/Types.h>
+
+#include <memory>
+#include <vector>
+
+namespace DB::DM
+{
+
+/** The comparisons between non-nullable integer columns and constants in the pushed down filter, which can be
+  * evaluated on the packs encoded by the constant, run-length or FOR mode of the lightweight codec without
+  * decompressing them. DMFileReader of the filter columns of late materialization evaluates them for each block:
+  * 1. If no row passes them, the filter columns of the block are not read, and the block is filtered out.
+  * 2. If all rows pass them and they are the whole pushed down filter, the filter is not executed on the block.
+  */
+struct EncodedFilter
+{
+    struct Predicate
+    {
+        ColumnID col_id;
+        Compression::IntegerPredicate predicate;
+    };
+
+    // The predicates are the conjuncts of the pushed down filter.
+    std::vector<Predicate> predicates;
+    // Whether the pushed down filter is exactly the conjunction of `predicates`.
+    bool is_complete = false;
+};
+
+using EncodedFilterPtr = std::shared_ptr<const EncodedFilter>;
+
+} // namespace DB::DM
@@ -31,12 +31,17 @@ public:
 
     RSResults roughCheck(size_t start_pack, size_t pack_count, const RSCheckParam & param) override
     {
-        return minMaxCheckCmp<RoughCheck::CheckEqual>(start_pack, pack_count, param, attr, value);
+        // The min-max index of string column is not aware of collation.
+        auto results = attr.collator
+            ? RSResults(pack_count, RSResult::Some)
+            : minMaxCheckCmp<RoughCheck::CheckEqual>(start_pack, pack_count, param, attr, value);
+        bloomFilterCheckIn(results, start_pack, param, attr, {value});
+        return results;
     }
 
     ColumnRangePtr buildSets(const google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> & index_infos) override
     {
-        if (auto set = IntegerSet::createValueSet(attr.type, {value}); set)
+        if (auto set = IntegerSet::createValueSet(attr.type, {value}, attr.collator); set)
         {
             auto iter = std::find_if(index_infos.begin(), index_infos.end(), [&](const auto & info) {
                 return info.index_type() == tipb::ColumnarIndexType::TypeInverted
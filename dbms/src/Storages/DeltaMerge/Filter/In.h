@@ -55,14 +55,20 @@ public:
         // So return none directly.
         if (values.empty())
             return RSResults(pack_count, RSResult::None);
-        auto rs_index = getRSIndex(param, attr);
-        return rs_index ? rs_index->minmax->checkIn(start_pack, pack_count, values, rs_index->type)
-                        : RSResults(pack_count, RSResult::Some);
+        auto results = RSResults(pack_count, RSResult::Some);
+        // The min-max index of string column is not aware of collation.
+        if (!attr.collator)
+        {
+            if (auto rs_index = getRSIndex(param, attr); rs_index)
+                results = rs_index->minmax->checkIn(start_pack, pack_count, values, rs_index->type);
+        }
+        bloomFilterCheckIn(results, start_pack, param, attr, values);
+        return results;
     }
 
     ColumnRangePtr buildSets(const google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> & index_infos) override
     {
-        if (auto set = IntegerSet::createValueSet(attr.type, values); set)
+        if (auto set = IntegerSet::createValueSet(attr.type, values, attr.collator); set)
         {
             auto iter = std::find_if(index_infos.begin(), index_infos.end(), [&](const auto & info) {
                 return info.index_type() == tipb::ColumnarIndexType::TypeInverted
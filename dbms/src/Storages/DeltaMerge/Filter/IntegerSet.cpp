@@ -16,6 +16,7 @@
 #include <DataTypes/DataTypeNullable.h>
 #include <Storages/DeltaMerge/Filter/IntegerSet.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/Reader.h>
+#include <TiDB/Collation/Collator.h>
 
 #include <algorithm>
 #include <limits>
@@ -25,11 +26,29 @@
 namespace DB::DM
 {
 
-IntegerSetPtr IntegerSet::createValueSet(const DataTypePtr & type, const Fields & values)
+IntegerSetPtr IntegerSet::createValueSet(
+    const DataTypePtr & type,
+    const Fields & values,
+    TiDB::TiDBCollatorPtr collator)
 {
     auto type_id = removeNullable(type)->getTypeId();
     switch (type_id)
     {
+    case TypeIndex::String:
+    {
+        if (!collator)
+            return nullptr;
+        std::set<String> sort_keys;
+        String sort_key_container;
+        for (const auto & value : values)
+        {
+            if (value.getType() != Field::Types::String)
+                return nullptr;
+            const auto & str = value.get<String>();
+            sort_keys.insert(collator->sortKeyFastPath(str.data(), str.size(), sort_key_container).toString());
+        }
+        return std::make_shared<StringValueSet>(collator->getCollatorId(), std::move(sort_keys));
+    }
     case TypeIndex::UInt8:
         return std::make_shared<ValueSet<UInt8>>(values);
     case TypeIndex::UInt16:
@@ -608,6 +627,138 @@ BitmapFilterPtr CompositeSet<T>::search(InvertedIndexReaderPtr inverted_index, s
     return filter;
 }
 
+IntegerSetPtr StringValueSet::intersectWith(const IntegerSetPtr & other)
+{
+    if (other->getType() == SetType::All || other->getType() == SetType::Empty)
+        return other->intersectWith(this->shared_from_this());
+
+    auto rhs = std::dynamic_pointer_cast<StringValueSet>(other);
+    RUNTIME_CHECK(rhs != nullptr);
+    // The sort keys are not comparable under different collators, any of them is a superset of the result.
+    if (rhs->collator_id != collator_id)
+        return this->shared_from_this();
+
+    std::set<String> result;
+    bool result_negated = false;
+    if (!negated && !rhs->negated)
+    {
+        std::set_intersection(
+            sort_keys.begin(),
+            sort_keys.end(),
+            rhs->sort_keys.begin(),
+            rhs->sort_keys.end(),
+            std::inserter(result, result.begin()));
+    }
+    else if (negated && rhs->negated)
+    {
+        // not(A) & not(B) = not(A | B)
+        std::set_union(
+            sort_keys.begin(),
+            sort_keys.end(),
+            rhs->sort_keys.begin(),
+            rhs->sort_keys.end(),
+            std::inserter(result, result.begin()));
+        result_negated = true;
+    }
+    else
+    {
+        // A & not(B) = A - B
+        const auto & pos = negated ? rhs->sort_keys : sort_keys;
+        const auto & neg = negated ? sort_keys : rhs->sort_keys;
+        std::set_difference(
+            pos.begin(),
+            pos.end(),
+            neg.begin(),
+            neg.end(),
+            std::inserter(result, result.begin()));
+    }
+
+    if (!result_negated && result.empty())
+        return EmptySet::instance();
+    return std::make_shared<StringValueSet>(collator_id, std::move(result), result_negated);
+}
+
+IntegerSetPtr StringValueSet::unionWith(const IntegerSetPtr & other)
+{
+    if (other->getType() == SetType::All || other->getType() == SetType::Empty)
+        return other->unionWith(this->shared_from_this());
+
+    auto rhs = std::dynamic_pointer_cast<StringValueSet>(other);
+    RUNTIME_CHECK(rhs != nullptr);
+    // The sort keys are not comparable under different collators.
+    if (rhs->collator_id != collator_id)
+        return AllSet::instance();
+
+    std::set<String> result;
+    bool result_negated = true;
+    if (!negated && !rhs->negated)
+    {
+        std::set_union(
+            sort_keys.begin(),
+            sort_keys.end(),
+            rhs->sort_keys.begin(),
+            rhs->sort_keys.end(),
+            std::inserter(result, result.begin()));
+        result_negated = false;
+    }
+    else if (negated && rhs->negated)
+    {
+        // not(A) | not(B) = not(A & B)
+        std::set_intersection(
+            sort_keys.begin(),
+            sort_keys.end(),
+            rhs->sort_keys.begin(),
+            rhs->sort_keys.end(),
+            std::inserter(result, result.begin()));
+    }
+    else
+    {
+        // A | not(B) = not(B - A)
+        const auto & pos = negated ? rhs->sort_keys : sort_keys;
+        const auto & neg = negated ? sort_keys : rhs->sort_keys;
+        std::set_difference(
+            neg.begin(),
+            neg.end(),
+            pos.begin(),
+            pos.end(),
+            std::inserter(result, result.begin()));
+    }
+
+    // not({}) contains all non-null values, keep it as a StringValueSet because NULLs are not in it.
+    return std::make_shared<StringValueSet>(collator_id, std::move(result), result_negated);
+}
+
+IntegerSetPtr StringValueSet::invert() const
+{
+    return std::make_shared<StringValueSet>(collator_id, std::set<String>(sort_keys), !negated);
+}
+
+BitmapFilterPtr StringValueSet::search(InvertedIndexReaderPtr inverted_index, size_t size)
+{
+    auto reader = std::dynamic_pointer_cast<InvertedIndexStringReader>(inverted_index);
+    RUNTIME_CHECK(reader != nullptr);
+    // The sort keys are not comparable under different collators.
+    if (reader->collatorId() != collator_id)
+        return std::make_shared<BitmapFilter>(size, true);
+
+    auto filter = std::make_shared<BitmapFilter>(size, false);
+    if (negated)
+    {
+        reader->searchNotIn(filter, sort_keys);
+    }
+    else
+    {
+        for (const auto & sort_key : sort_keys)
+            reader->search(filter, sort_key);
+    }
+    return filter;
+}
+
+String StringValueSet::toDebugString()
+{
+    return fmt::format("{}{}", negated ? "NOT " : "", sort_keys);
+}
+
 template class RangeSet<UInt8>;
 template class RangeSet<UInt16>;
 template class RangeSet<UInt32>;
@@ -17,9 +17,11 @@
 #include <Core/Field.h>
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/Reader_fwd.h>
+#include <TiDB/Schema/TiDB_fwd.h>
 #include <common/types.h>
 
 #include <memory>
+#include <set>
 
 namespace DB::DM
 {
@@ -69,7 +71,11 @@ public:
     // Only used in tests.
     virtual String toDebugString() = 0;
 
-    static IntegerSetPtr createValueSet(const DataTypePtr & type, const Fields & values);
+    // `collator` is only used for string type, the values are converted to sort keys under it.
+    static IntegerSetPtr createValueSet(
+        const DataTypePtr & type,
+        const Fields & values,
+        TiDB::TiDBCollatorPtr collator = nullptr);
     static IntegerSetPtr createLessRangeSet(const DataTypePtr & type, const Field & max, bool not_included = true);
     static IntegerSetPtr createGreaterRangeSet(const DataTypePtr & type, const Field & min, bool not_included = true);
 };
@@ -260,4 +266,36 @@ private:
     std::vector<IntegerSetPtr> sets;
 };
 
+// {s1, s2, s3, ...} or its complement, the strings are stored as sort keys under the collator.
+// The complement is kept as it is because the domain of strings can not be enumerated by ranges.
+class StringValueSet final : public IntegerSet
+{
+public:
+    StringValueSet(Int32 collator_id_, std::set<String> && sort_keys_, bool negated_ = false)
+        : collator_id(collator_id_)
+        , sort_keys(std::move(sort_keys_))
+        , negated(negated_)
+    {}
+
+    ~StringValueSet() override = default;
+
+    SetType getType() const override { return SetType::Value; }
+
+    IntegerSetPtr intersectWith(const IntegerSetPtr & other) override;
+
+    IntegerSetPtr unionWith(const IntegerSetPtr & other) override;
+
+    IntegerSetPtr invert() const override;
+
+    // If the index is built with another collator, all rows are returned.
+    BitmapFilterPtr search(InvertedIndexReaderPtr inverted_index, size_t size) override;
+
+    String toDebugString() override;
+
+private:
+    Int32 collator_id;
+    std::set<String> sort_keys;
+    bool negated;
+};
+
 } // namespace DB::DM
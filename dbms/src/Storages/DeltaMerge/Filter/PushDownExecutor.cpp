@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <DataStreams/GeneratedColumnPlaceholderBlockInputStream.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGQueryInfo.h>
 #include <Flash/Coprocessor/DAGUtils.h>
@@ -24,6 +25,141 @@
 
 namespace DB::DM
 {
+namespace
+{
+// Return the predicate if `expr` is a comparison between a non-nullable integer column and an integer literal
+// in the range of the column type, like `a > 1` or `1 < a`.
+std::optional<EncodedFilter::Predicate> parseEncodedPredicate(
+    const tipb::Expr & expr,
+    const TiDB::ColumnInfos & table_scan_column_info,
+    const std::unordered_map<ColumnID, ColumnDefine> & columns_to_read_map)
+{
+    using Op = Compression::IntegerPredicate::Op;
+    static const std::unordered_map<tipb::ScalarFuncSig, Op> sig_to_op{
+        {tipb::ScalarFuncSig::EQInt, Op::Equal},
+        {tipb::ScalarFuncSig::NEInt, Op::NotEqual},
+        {tipb::ScalarFuncSig::LTInt, Op::Less},
+        {tipb::ScalarFuncSig::LEInt, Op::LessOrEqual},
+        {tipb::ScalarFuncSig::GTInt, Op::Greater},
+        {tipb::ScalarFuncSig::GEInt, Op::GreaterOrEqual},
+    };
+    if (!isScalarFunctionExpr(expr) || expr.children_size() != 2)
+        return std::nullopt;
+    auto op_iter = sig_to_op.find(expr.sig());
+    if (op_iter == sig_to_op.end())
+        return std::nullopt;
+
+    auto op = op_iter->second;
+    const auto * column_expr = &expr.children(0);
+    const auto * literal_expr = &expr.children(1);
+    if (isLiteralExpr(*column_expr) && isColumnExpr(*literal_expr))
+    {
+        // `literal op column` is `column reversed_op literal`
+        std::swap(column_expr, literal_expr);
+        switch (op)
+        {
+        case Op::Less:
+            op = Op::Greater;
+            break;
+        case Op::LessOrEqual:
+            op = Op::GreaterOrEqual;
+            break;
+        case Op::Greater:
+            op = Op::Less;
+            break;
+        case Op::GreaterOrEqual:
+            op = Op::LessOrEqual;
+            break;
+        default:
+            break;
+        }
+    }
+    if (!isColumnExpr(*column_expr) || !isLiteralExpr(*literal_expr))
+        return std::nullopt;
+
+    const auto column_index = decodeDAGInt64(column_expr->val());
+    if (column_index < 0 || column_index >= static_cast<Int64>(table_scan_column_info.size()))
+        return std::nullopt;
+    // Only the integer columns stored as is, other columns like enum or time may be casted before the filter.
+    const auto & column_info = table_scan_column_info[column_index];
+    if (column_info.hasGeneratedColumnFlag()
+        || (column_info.tp != TiDB::TypeTiny && column_info.tp != TiDB::TypeShort && column_info.tp != TiDB::TypeInt24
+            && column_info.tp != TiDB::TypeLong && column_info.tp != TiDB::TypeLongLong))
+        return std::nullopt;
+    auto column_iter = columns_to_read_map.find(column_info.id);
+    if (column_iter == columns_to_read_map.end())
+        return std::nullopt;
+    const auto & column = column_iter->second;
+    bool is_signed = false;
+    switch (column.type->getTypeId())
+    {
+    case TypeIndex::Int8:
+    case TypeIndex::Int16:
+    case TypeIndex::Int32:
+    case TypeIndex::Int64:
+        is_signed = true;
+        break;
+    case TypeIndex::UInt8:
+    case TypeIndex::UInt16:
+    case TypeIndex::UInt32:
+    case TypeIndex::UInt64:
+        break;
+    default:
+        return std::nullopt;
+    }
+
+    // If the literal is out of the range of the column type, the result is the same for all the rows,
+    // just leave it to the filter.
+    const Field literal = decodeLiteral(*literal_expr);
+    Int128 value = 0;
+    if (literal.getType() == Field::Types::Int64)
+        value = literal.get<Int64>();
+    else if (literal.getType() == Field::Types::UInt64)
+        value = literal.get<UInt64>();
+    else
+        return std::nullopt;
+    const auto value_size = column.type->getSizeOfValueInMemory();
+    const auto bits = value_size * 8;
+    const Int128 min_value = is_signed ? -(static_cast<Int128>(1) << (bits - 1)) : 0;
+    const Int128 max_value
+        = is_signed ? (static_cast<Int128>(1) << (bits - 1)) - 1 : (static_cast<Int128>(1) << bits) - 1;
+    if (value < min_value || value > max_value)
+        return std::nullopt;
+
+    return EncodedFilter::Predicate{
+        .col_id = column.id,
+        .predicate = Compression::IntegerPredicate{
+            .op = op,
+            .is_signed = is_signed,
+            .value_size = static_cast<UInt8>(value_size),
+            .constant = static_cast<UInt64>(value),
+        },
+    };
+}
+
+// Collect the conjuncts of `expr` that can be evaluated on the encoded packs, return whether all of them can be.
+bool collectEncodedPredicates(
+    const tipb::Expr & expr,
+    const TiDB::ColumnInfos & table_scan_column_info,
+    const std::unordered_map<ColumnID, ColumnDefine> & columns_to_read_map,
+    std::vector<EncodedFilter::Predicate> & predicates)
+{
+    if (isScalarFunctionExpr(expr) && expr.sig() == tipb::ScalarFuncSig::LogicalAnd)
+    {
+        bool is_complete = true;
+        for (const auto & child : expr.children())
+            is_complete &= collectEncodedPredicates(child, table_scan_column_info, columns_to_read_map, predicates);
+        return is_complete;
+    }
+    if (auto predicate = parseEncodedPredicate(expr, table_scan_column_info, columns_to_read_map); predicate)
+    {
+        predicates.push_back(*predicate);
+        return true;
+    }
+    return false;
+}
+} // namespace
+
 PushDownExecutorPtr PushDownExecutor::build(
     const RSOperatorPtr & rs_operator,
     const ANNQueryInfoPtr & ann_query_info,
@@ -135,6 +271,26 @@ PushDownExecutorPtr PushDownExecutor::build(
         = analyzer->buildPushDownFilter(pushed_down_filters, true);
     LOG_DEBUG(tracing_logger, "Push down filter: {}", before_where->dumpActions());
 
+    // build the comparisons evaluated on the encoded packs
+    EncodedFilterPtr encoded_filter = nullptr;
+    if (context.getSettingsRef().dt_enable_encoded_filter)
+    {
+        auto filter = std::make_shared<EncodedFilter>();
+        filter->is_complete = true;
+        for (const auto & expr : pushed_down_filters)
+            filter->is_complete
+                &= collectEncodedPredicates(expr, table_scan_column_info, columns_to_read_map, filter->predicates);
+        if (!filter->predicates.empty())
+        {
+            LOG_DEBUG(
+                tracing_logger,
+                "Encoded filter: {} predicates, is_complete={}",
+                filter->predicates.size(),
+                filter->is_complete);
+            encoded_filter = std::move(filter);
+        }
+    }
+
     // record current column defines
     auto columns_after_cast = std::make_shared<ColumnDefines>();
     if (extra_cast != nullptr)
@@ -167,7 +323,8 @@ PushDownExecutorPtr PushDownExecutor::build(
         filter_column_name,
         extra_cast,
         columns_after_cast,
-        column_range);
+        column_range,
+        encoded_filter);
 }
 
 PushDownExecutorPtr PushDownExecutor::build(
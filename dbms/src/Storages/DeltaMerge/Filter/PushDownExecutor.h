@@ -16,6 +16,7 @@
 
 #include <Flash/Coprocessor/TiDBTableScan.h>
 #include <Interpreters/ExpressionActions.h>
+#include <Storages/DeltaMerge/Filter/EncodedFilter.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/Index/FullTextIndex/Reader_fwd.h>
 #include <Storages/DeltaMerge/Index/VectorIndex/Reader_fwd.h>
@@ -45,7 +46,8 @@ public:
         const String filter_column_name_,
         const ExpressionActionsPtr & extra_cast_,
         const ColumnDefinesPtr & columns_after_cast_,
-        const ColumnRangePtr & column_range_)
+        const ColumnRangePtr & column_range_,
+        const EncodedFilterPtr & encoded_filter_ = nullptr)
         : rs_operator(rs_operator_)
         , before_where(beofre_where_)
         , project_after_where(project_after_where_)
@@ -56,6 +58,7 @@ public:
         , ann_query_info(ann_query_info_)
         , fts_query_info(fts_query_info_)
         , column_range(column_range_)
+        , encoded_filter(encoded_filter_)
     {}
 
     explicit PushDownExecutor(
@@ -120,6 +123,8 @@ public:
     const FTSQueryInfoPtr fts_query_info;
     // The column_range contains the column values of the pushed down filters
     const ColumnRangePtr column_range;
+    // The comparisons in the pushed down filters that can be evaluated on the encoded packs
+    const EncodedFilterPtr encoded_filter;
 };
 
 } // namespace DB::DM
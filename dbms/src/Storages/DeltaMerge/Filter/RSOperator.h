@@ -37,6 +37,7 @@ inline static const RSOperatorPtr EMPTY_RS_OPERATOR{};
 struct RSCheckParam
 {
     ColumnIndexes indexes;
+    ColumnBloomFilters bloom_filters;
 };
 
 class RSOperator
@@ -148,6 +149,19 @@ RSResults minMaxCheckCmp(
                     : RSResults(pack_count, RSResult::Some);
 }
 
+// Set the packs that contain none of `values` to None according to the bloom filter index.
+inline void bloomFilterCheckIn(
+    RSResults & results,
+    size_t start_pack,
+    const RSCheckParam & param,
+    const Attr & attr,
+    const Fields & values)
+{
+    auto it = param.bloom_filters.find(attr.col_id);
+    if (it != param.bloom_filters.end() && it->second.type->equals(*attr.type))
+        it->second.bloom_filter->checkIn(results, start_pack, values, it->second.type, attr.collator);
+}
+
 // logical
 RSOperatorPtr createNot(const RSOperatorPtr & op);
 RSOperatorPtr createOr(const RSOperators & children);
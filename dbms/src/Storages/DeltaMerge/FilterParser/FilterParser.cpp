@@ -18,6 +18,7 @@
 #include <Flash/Coprocessor/DAGUtils.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/FilterParser/FilterParser.h>
+#include <TiDB/Collation/Collator.h>
 #include <TiDB/Schema/TiDB.h>
 #include <common/logger_useful.h>
 
@@ -80,6 +81,12 @@ inline bool isRoughSetFilterSupportType(const Int32 field_type)
     return false;
 }
 
+// String types which can be filtered by the inverted index, the values are compared by collation.
+inline bool isStringFilterSupportType(const Int32 field_type)
+{
+    return field_type == TiDB::TypeVarchar || field_type == TiDB::TypeVarString || field_type == TiDB::TypeString;
+}
+
 ColumnID getColumnIDForColumnExpr(const tipb::Expr & expr, const TiDB::ColumnInfos & scan_column_infos)
 {
     assert(isColumnExpr(expr));
@@ -158,7 +165,10 @@ inline RSOperatorPtr parseTiCompareExpr( //
                     tipb::ScalarFuncSig_Name(expr.sig())));
 
             auto field_type = child.field_type().tp();
-            if (!isRoughSetFilterSupportType(field_type))
+            // String column can only be filtered by the inverted index with equal and in.
+            const bool is_string_column = isStringFilterSupportType(field_type)
+                && (filter_type == FilterParser::RSFilterType::Equal || filter_type == FilterParser::RSFilterType::In);
+            if (!isRoughSetFilterSupportType(field_type) && !is_string_column)
                 return createUnsupported(fmt::format(
                     "ColumnRef with field type is not supported, sig={} field_type={}",
                     tipb::ScalarFuncSig_Name(expr.sig()),
@@ -166,6 +176,12 @@ inline RSOperatorPtr parseTiCompareExpr( //
 
             auto col_id = getColumnIDForColumnExpr(child, scan_column_infos);
             attr = id_to_attr.at(col_id);
+            if (is_string_column)
+            {
+                attr.collator = getCollatorFromExpr(expr);
+                if (!attr.collator)
+                    attr.collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::BINARY);
+            }
         }
         else if (isLiteralExpr(child))
         {
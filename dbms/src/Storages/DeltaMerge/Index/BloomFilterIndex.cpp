@@ -0,0 +1,355 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Common/Exception.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <TiDB/Collation/Collator.h>
+#include <city.h>
+
+namespace DB::ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace DB::ErrorCodes
+
+namespace DB::DM
+{
+
+namespace
+{
+constexpr UInt8 BLOOM_FILTER_FORMAT_VERSION = 1;
+
+using Word = BloomFilterIndex::Word;
+constexpr size_t WORDS_PER_BLOCK = BloomFilterIndex::WORDS_PER_BLOCK;
+
+// The salts of the split block Bloom filter in Parquet, one for each word of a block.
+constexpr std::array<UInt32, WORDS_PER_BLOCK> SALT{
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U,
+};
+
+// Integers are hashed as 64-bit values, so that a value is hashed the same no matter it
+// comes from the column or from the filter.
+template <typename T>
+ALWAYS_INLINE inline UInt64 hashInt(T v)
+{
+    if constexpr (std::is_signed_v<T>)
+        return intHash64(static_cast<UInt64>(static_cast<Int64>(v)));
+    else
+        return intHash64(static_cast<UInt64>(v));
+}
+
+ALWAYS_INLINE inline UInt64 hashString(StringRef s)
+{
+    // Remove the trailing spaces, so that the hash works for the padding collations.
+    size_t size = s.size;
+    while (size > 0 && s.data[size - 1] == ' ')
+        --size;
+    return CityHash_v1_0_2::CityHash64(s.data, size);
+}
+
+// Call `f` with a function which returns the hash of the i-th row, if `column` is a ColumnVector of any of Ts.
+template <typename... Ts, typename F>
+bool visitIntColumn(const IColumn & column, F && f)
+{
+    auto try_visit = [&]<typename T>() {
+        const auto * c = typeid_cast<const ColumnVector<T> *>(&column);
+        if (c == nullptr)
+            return false;
+        const auto & data = c->getData();
+        f([&](size_t i) { return hashInt(data[i]); });
+        return true;
+    };
+    return (try_visit.template operator()<Ts>() || ...);
+}
+
+TypeIndex nestedTypeId(const IDataType & type)
+{
+    if (type.isNullable())
+        return typeid_cast<const DataTypeNullable &>(type).getNestedType()->getTypeId();
+    return type.getTypeId();
+}
+
+enum class HashState
+{
+    Ok,
+    // No row can be equal to the value, e.g. NULL or a value out of the range of the column type.
+    Absent,
+    // The value can not be checked by the filter, e.g. a float value against an integer column.
+    Unknown,
+};
+
+template <typename T>
+HashState intFieldToHash(const Field & value, UInt64 & hash)
+{
+    if (value.getType() == Field::Types::UInt64)
+    {
+        const auto v = value.get<UInt64>();
+        if (v > static_cast<UInt64>(std::numeric_limits<T>::max()))
+            return HashState::Absent;
+        hash = hashInt(v);
+        return HashState::Ok;
+    }
+    if (value.getType() == Field::Types::Int64)
+    {
+        const auto v = value.get<Int64>();
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max())
+                return HashState::Absent;
+        }
+        else
+        {
+            if (v < 0 || static_cast<UInt64>(v) > std::numeric_limits<T>::max())
+                return HashState::Absent;
+        }
+        hash = hashInt(v);
+        return HashState::Ok;
+    }
+    return HashState::Unknown;
+}
+
+HashState fieldToHash(const Field & value, TypeIndex type_id, UInt64 & hash)
+{
+    if (value.isNull())
+        return HashState::Absent;
+    switch (type_id)
+    {
+    case TypeIndex::UInt8:
+        return intFieldToHash<UInt8>(value, hash);
+    case TypeIndex::UInt16:
+    case TypeIndex::Date:
+        return intFieldToHash<UInt16>(value, hash);
+    case TypeIndex::UInt32:
+    case TypeIndex::DateTime:
+        return intFieldToHash<UInt32>(value, hash);
+    case TypeIndex::UInt64:
+    case TypeIndex::MyDate:
+    case TypeIndex::MyDateTime:
+    case TypeIndex::MyTimeStamp:
+        return intFieldToHash<UInt64>(value, hash);
+    case TypeIndex::Int8:
+        return intFieldToHash<Int8>(value, hash);
+    case TypeIndex::Int16:
+        return intFieldToHash<Int16>(value, hash);
+    case TypeIndex::Int32:
+        return intFieldToHash<Int32>(value, hash);
+    case TypeIndex::Int64:
+    case TypeIndex::MyTime:
+        return intFieldToHash<Int64>(value, hash);
+    case TypeIndex::String:
+        if (value.getType() != Field::Types::String)
+            return HashState::Unknown;
+        hash = hashString(StringRef(value.get<String>()));
+        return HashState::Ok;
+    default:
+        return HashState::Unknown;
+    }
+}
+} // namespace
+
+bool BloomFilterIndex::isSupportedType(const IDataType & type)
+{
+    switch (nestedTypeId(type))
+    {
+    case TypeIndex::UInt8:
+    case TypeIndex::UInt16:
+    case TypeIndex::UInt32:
+    case TypeIndex::UInt64:
+    case TypeIndex::Int8:
+    case TypeIndex::Int16:
+    case TypeIndex::Int32:
+    case TypeIndex::Int64:
+    case TypeIndex::Date:
+    case TypeIndex::DateTime:
+    case TypeIndex::MyDate:
+    case TypeIndex::MyDateTime:
+    case TypeIndex::MyTimeStamp:
+    case TypeIndex::MyTime:
+    case TypeIndex::String:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void BloomFilterIndex::addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark)
+{
+    const IColumn * data_column = &column;
+    const UInt8 * null_mark_data = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        data_column = &nullable_column.getNestedColumn();
+        null_mark_data = nullable_column.getNullMapColumn().getData().data();
+    }
+    const UInt8 * del_mark_data = del_mark ? del_mark->getData().data() : nullptr;
+
+    const size_t size = column.size();
+    std::vector<UInt64> hashes;
+    hashes.reserve(size);
+    bool has_null = false;
+    auto collect = [&](auto && hash_at) {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (del_mark_data && del_mark_data[i])
+                continue;
+            if (null_mark_data && null_mark_data[i])
+            {
+                has_null = true;
+                continue;
+            }
+            hashes.push_back(hash_at(i));
+        }
+    };
+
+    if (const auto * string_column = typeid_cast<const ColumnString *>(data_column); string_column)
+        collect([&](size_t i) { return hashString(string_column->getDataAt(i)); });
+    else if (!visitIntColumn<UInt8, UInt16, UInt32, UInt64, Int8, Int16, Int32, Int64>(*data_column, collect))
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Bloom filter index does not support {}", column.getName());
+
+    insertPack(hashes, has_null);
+}
+
+void BloomFilterIndex::insertPack(std::vector<UInt64> & hashes, bool has_null)
+{
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+
+    // A pack without any value has no block, so that all the checks on it return false.
+    size_t num_blocks = 0;
+    if (!hashes.empty())
+    {
+        num_blocks = (hashes.size() * BITS_PER_VALUE + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+        num_blocks = std::min(num_blocks, MAX_BLOCKS_PER_PACK);
+    }
+
+    const size_t first_block = block_offsets.back();
+    words.resize_fill(words.size() + num_blocks * WORDS_PER_BLOCK, 0);
+    for (auto hash : hashes)
+    {
+        Word * block = words.data() + (first_block + (((hash >> 32) * num_blocks) >> 32)) * WORDS_PER_BLOCK;
+        const auto key = static_cast<UInt32>(hash);
+        for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+            block[i] |= static_cast<Word>(1) << ((key * SALT[i]) >> 27);
+    }
+    has_null_marks.push_back(has_null);
+    block_offsets.push_back(first_block + num_blocks);
+}
+
+bool BloomFilterIndex::mayContain(size_t pack_id, UInt64 hash) const
+{
+    const UInt64 first_block = block_offsets[pack_id];
+    const UInt64 num_blocks = block_offsets[pack_id + 1] - first_block;
+    if (num_blocks == 0)
+        return false;
+    const Word * block = words.data() + (first_block + (((hash >> 32) * num_blocks) >> 32)) * WORDS_PER_BLOCK;
+    const auto key = static_cast<UInt32>(hash);
+    for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+    {
+        if ((block[i] & (static_cast<Word>(1) << ((key * SALT[i]) >> 27))) == 0)
+            return false;
+    }
+    return true;
+}
+
+void BloomFilterIndex::checkIn(
+    RSResults & results,
+    size_t start_pack,
+    const std::vector<Field> & values,
+    const DataTypePtr & type,
+    TiDB::TiDBCollatorPtr collator) const
+{
+    const auto type_id = nestedTypeId(*type);
+    // The hashes of strings are only comparable by the collations that compare strings by bytes.
+    if (type_id == TypeIndex::String && (collator == nullptr || collator->isCI()))
+        return;
+
+    std::vector<UInt64> hashes;
+    hashes.reserve(values.size());
+    for (const auto & value : values)
+    {
+        UInt64 hash;
+        switch (fieldToHash(value, type_id, hash))
+        {
+        case HashState::Ok:
+            hashes.push_back(hash);
+            break;
+        case HashState::Absent:
+            break;
+        case HashState::Unknown:
+            return;
+        }
+    }
+
+    RUNTIME_CHECK(start_pack + results.size() <= packCount(), start_pack, results.size(), packCount());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i].isUse())
+            continue;
+        const size_t pack_id = start_pack + i;
+        if (std::none_of(hashes.begin(), hashes.end(), [&](UInt64 hash) { return mayContain(pack_id, hash); }))
+            results[i] = results[i] && (has_null_marks[pack_id] ? RSResult::NoneNull : RSResult::None);
+    }
+}
+
+void BloomFilterIndex::write(WriteBuffer & buf) const
+{
+    UInt64 size = packCount();
+    writeIntBinary(BLOOM_FILTER_FORMAT_VERSION, buf);
+    writeIntBinary(size, buf);
+    buf.write(reinterpret_cast<const char *>(has_null_marks.data()), sizeof(UInt8) * size);
+    buf.write(reinterpret_cast<const char *>(block_offsets.data()), sizeof(UInt32) * (size + 1));
+    buf.write(reinterpret_cast<const char *>(words.data()), sizeof(Word) * words.size());
+}
+
+BloomFilterIndexPtr BloomFilterIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    const size_t buf_pos = buf.count();
+    UInt8 version = 0;
+    readIntBinary(version, buf);
+    RUNTIME_CHECK_MSG(version == BLOOM_FILTER_FORMAT_VERSION, "Unsupported bloom filter index version {}", version);
+    UInt64 size = 0;
+    readIntBinary(size, buf);
+    PaddedPODArray<UInt8> has_null_marks(size);
+    PaddedPODArray<UInt32> block_offsets(size + 1);
+    buf.readStrict(reinterpret_cast<char *>(has_null_marks.data()), sizeof(UInt8) * size);
+    buf.readStrict(reinterpret_cast<char *>(block_offsets.data()), sizeof(UInt32) * (size + 1));
+    PaddedPODArray<Word> words(block_offsets.back() * WORDS_PER_BLOCK);
+    buf.readStrict(reinterpret_cast<char *>(words.data()), sizeof(Word) * words.size());
+    const size_t bytes_read = buf.count() - buf_pos;
+    RUNTIME_CHECK_MSG(
+        bytes_read == bytes_limit,
+        "Bad file format: expected read bloom filter index size: {} vs. actual: {}",
+        bytes_limit,
+        bytes_read);
+    return std::make_shared<BloomFilterIndex>(
+        std::move(has_null_marks),
+        std::move(block_offsets),
+        std::move(words));
+}
+
+} // namespace DB::DM
@@ -0,0 +1,134 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnsNumber.h>
+#include <Common/LRUCache.h>
+#include <Core/Field.h>
+#include <DataTypes/IDataType.h>
+#include <Storages/DeltaMerge/Index/RSResult.h>
+#include <TiDB/Schema/TiDB_fwd.h>
+
+namespace DB::DM
+{
+class BloomFilterIndex;
+using BloomFilterIndexPtr = std::shared_ptr<BloomFilterIndex>;
+
+// BloomFilterIndex keeps a split block Bloom filter for each pack, so that the packs which
+// do not contain the values of `=` and `IN` can be skipped. It is useful for the columns
+// whose values are not clustered, where the min-max index can hardly skip any pack.
+//
+// Each block is 256 bits (8 words). A value sets one bit in each word of the block selected
+// by its hash, the same as the Parquet Bloom filter, so a probe only touches one cache line.
+// The number of blocks of a pack is decided by the number of distinct values in the pack.
+//
+// Strings are hashed after the trailing spaces are removed, so the filter works for all the
+// collations that compare strings by bytes, with or without padding. It can not be used by
+// the case insensitive collations.
+class BloomFilterIndex
+{
+public:
+    using Word = UInt32;
+    static constexpr size_t WORDS_PER_BLOCK = 8;
+    static constexpr size_t BITS_PER_BLOCK = WORDS_PER_BLOCK * sizeof(Word) * 8;
+    // About 1% false positive rate.
+    static constexpr size_t BITS_PER_VALUE = 10;
+    static constexpr size_t MAX_BLOCKS_PER_PACK = 4096;
+
+    BloomFilterIndex()
+        : block_offsets(1, 0)
+    {}
+
+    BloomFilterIndex(
+        PaddedPODArray<UInt8> && has_null_marks_,
+        PaddedPODArray<UInt32> && block_offsets_,
+        PaddedPODArray<Word> && words_)
+        : has_null_marks(std::move(has_null_marks_))
+        , block_offsets(std::move(block_offsets_))
+        , words(std::move(words_))
+    {}
+
+    // Integers, dates and strings are supported, `type` can be nullable.
+    static bool isSupportedType(const IDataType & type);
+
+    size_t byteSize() const
+    {
+        return sizeof(UInt8) * has_null_marks.size() + sizeof(UInt32) * block_offsets.size()
+            + sizeof(Word) * words.size() + 3 * sizeof(PaddedPODArray<UInt8>);
+    }
+
+    size_t packCount() const { return has_null_marks.size(); }
+
+    void addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark);
+
+    void write(WriteBuffer & buf) const;
+
+    static BloomFilterIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    // `results[i]` is the result of pack `start_pack + i`. The packs that contain none of `values`
+    // are set to None (or NoneNull if the pack has null). Nothing is changed if `values` can not be
+    // checked by the filter, such as a float value against an integer column.
+    // `type` is the type of the column, `collator` is only used for string column.
+    void checkIn(
+        RSResults & results,
+        size_t start_pack,
+        const std::vector<Field> & values,
+        const DataTypePtr & type,
+        TiDB::TiDBCollatorPtr collator) const;
+
+    // Whether pack `pack_id` may contain a value with hash `hash`.
+    bool mayContain(size_t pack_id, UInt64 hash) const;
+
+private:
+    // Append a pack with the hashes of its values, `hashes` is sorted and deduplicated in place.
+    void insertPack(std::vector<UInt64> & hashes, bool has_null);
+
+    PaddedPODArray<UInt8> has_null_marks;
+    // The blocks of pack i are [block_offsets[i], block_offsets[i + 1]).
+    PaddedPODArray<UInt32> block_offsets;
+    PaddedPODArray<Word> words;
+};
+
+struct BloomFilterIndexWeightFunction
+{
+    size_t operator()(const String & key, const BloomFilterIndex & index) const
+    {
+        // The same as MinMaxIndexWeightFunction: index, cells, key, hash table and LRU queue.
+        return index.byteSize() + 32 + key.size() * 2 + sizeof(String) * 2 + 28 + sizeof(std::list<String>);
+    }
+};
+
+class BloomFilterIndexCache
+    : public LRUCache<String, BloomFilterIndex, std::hash<String>, BloomFilterIndexWeightFunction>
+{
+private:
+    using Base = LRUCache<String, BloomFilterIndex, std::hash<String>, BloomFilterIndexWeightFunction>;
+
+public:
+    explicit BloomFilterIndexCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+    {}
+
+    template <typename LoadFunc>
+    MappedPtr getOrSet(const Key & key, LoadFunc && load)
+    {
+        auto result = Base::getOrSet(key, load);
+        return result.first;
+    }
+};
+
+using BloomFilterIndexCachePtr = std::shared_ptr<BloomFilterIndexCache>;
+
+} // namespace DB::DM
@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/BitpackingPrimitives.h>
+#include <IO/Buffer/WriteBufferFromString.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteHelpers.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/CommonUtil.h>
+#include <common/unaligned.h>
 
 
 namespace DB::DM::InvertedIndex
@@ -120,13 +123,229 @@ void Block<T>::searchRange(BitmapFilterPtr & bitmap_filter, ReadBuffer & read_bu
     bitmap_filter->set(row_ids, nullptr);
 }
 
+void serializePosting(const RowIDs & row_ids, WriteBuffer & write_buf)
+{
+    RUNTIME_CHECK(!row_ids.empty());
+    writeIntBinary(static_cast<UInt32>(row_ids.size()), write_buf);
+    writeIntBinary(row_ids.front(), write_buf);
+
+    // Store delta - 1, so that continuous row_ids are encoded with 0 bit.
+    RowIDs deltas(row_ids.size() - 1);
+    RowID max_delta = 0;
+    for (size_t i = 1; i < row_ids.size(); ++i)
+    {
+        deltas[i - 1] = row_ids[i] - row_ids[i - 1] - 1;
+        max_delta = std::max(max_delta, deltas[i - 1]);
+    }
+    UInt8 width = BitpackingPrimitives::minimumBitWidth<RowID>(max_delta);
+    writeIntBinary(width, write_buf);
+    if (width == 0)
+        return;
+
+    std::vector<unsigned char> packed(BitpackingPrimitives::getRequiredSize(deltas.size(), width));
+    BitpackingPrimitives::packBuffer(packed.data(), deltas.data(), deltas.size(), width);
+    write_buf.write(reinterpret_cast<const char *>(packed.data()), packed.size());
+}
+
+void decodePosting(BitmapFilterPtr & bitmap_filter, const char * data)
+{
+    const auto size = unalignedLoad<UInt32>(data);
+    const auto first = unalignedLoad<RowID>(data + sizeof(UInt32));
+    const auto width = unalignedLoad<UInt8>(data + sizeof(UInt32) + sizeof(RowID));
+    if (width == 0)
+    {
+        // All row_ids are continuous.
+        bitmap_filter->set(first, size);
+        return;
+    }
+
+    constexpr size_t header_size = sizeof(UInt32) + sizeof(RowID) + sizeof(UInt8);
+    const auto * packed = reinterpret_cast<const unsigned char *>(data + header_size);
+    constexpr size_t group_size = BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE;
+    RowID row_ids[group_size];
+    row_ids[group_size - 1] = first;
+    (*bitmap_filter)[first] = true;
+    // Decode the deltas group by group and set them to the bitmap_filter.
+    const size_t delta_count = size - 1;
+    for (size_t i = 0; i < delta_count; i += group_size)
+    {
+        RowID prev = row_ids[group_size - 1];
+        BitpackingPrimitives::unPackBlock<RowID>(
+            reinterpret_cast<unsigned char *>(row_ids),
+            packed + (i * width) / 8,
+            width);
+        const size_t n = std::min(group_size, delta_count - i);
+        for (size_t j = 0; j < n; ++j)
+        {
+            prev += row_ids[j] + 1;
+            row_ids[j] = prev;
+        }
+        bitmap_filter->set(std::span<const RowID>(row_ids, n), nullptr);
+        row_ids[group_size - 1] = prev;
+    }
+}
+
+namespace
+{
+// Write the posting offsets and the postings of a V2 block.
+template <typename T>
+void serializePostings(const std::vector<BlockEntry<T>> & entries, WriteBuffer & write_buf)
+{
+    WriteBufferFromOwnString postings;
+    for (const auto & entry : entries)
+    {
+        writeIntBinary(static_cast<UInt32>(postings.count()), write_buf);
+        serializePosting(entry.row_ids, postings);
+    }
+    writeIntBinary(static_cast<UInt32>(postings.count()), write_buf);
+    const auto & postings_data = postings.str();
+    write_buf.write(postings_data.data(), postings_data.size());
+}
+
+// Accessors of a V2 block.
+template <typename T>
+struct CompactBlockView
+{
+    static constexpr bool is_string = std::is_same_v<T, String>;
+    using Value = std::conditional_t<is_string, std::string_view, T>;
+
+    explicit CompactBlockView(std::string_view data)
+        : size(unalignedLoad<UInt32>(data.data()))
+    {
+        const char * pos = data.data() + sizeof(UInt32);
+        if constexpr (is_string)
+        {
+            value_offsets = pos;
+            values = value_offsets + (size + 1) * sizeof(UInt32);
+            offsets = values + valueOffset(size);
+        }
+        else
+        {
+            values = pos;
+            offsets = values + size * sizeof(T);
+        }
+        postings = offsets + (size + 1) * sizeof(UInt32);
+        RUNTIME_CHECK(postings + offset(size) <= data.data() + data.size(), size, data.size());
+    }
+
+    Value value(UInt32 i) const
+    {
+        if constexpr (is_string)
+            return std::string_view(values + valueOffset(i), valueOffset(i + 1) - valueOffset(i));
+        else
+            return unalignedLoad<T>(values + i * sizeof(T));
+    }
+    UInt32 valueOffset(UInt32 i) const { return unalignedLoad<UInt32>(value_offsets + i * sizeof(UInt32)); }
+    UInt32 offset(UInt32 i) const { return unalignedLoad<UInt32>(offsets + i * sizeof(UInt32)); }
+
+    // The first index whose value >= key.
+    UInt32 lowerBound(Value key) const
+    {
+        UInt32 l = 0;
+        UInt32 r = size;
+        while (l < r)
+        {
+            UInt32 mid = l + (r - l) / 2;
+            if (value(mid) < key)
+                l = mid + 1;
+            else
+                r = mid;
+        }
+        return l;
+    }
+
+    void decode(BitmapFilterPtr & bitmap_filter, UInt32 i) const { decodePosting(bitmap_filter, postings + offset(i)); }
+
+    const UInt32 size;
+    const char * value_offsets = nullptr; // only for string
+    const char * values = nullptr;
+    const char * offsets = nullptr;
+    const char * postings = nullptr;
+};
+} // namespace
+
+template <typename T>
+void Block<T>::serializeCompact(WriteBuffer & write_buf) const
+{
+    writeIntBinary(static_cast<UInt32>(entries.size()), write_buf);
+    for (const auto & entry : entries)
+        writeIntBinary(entry.value, write_buf);
+    serializePostings(entries, write_buf);
+}
+
+template <typename T>
+void Block<T>::searchCompact(BitmapFilterPtr & bitmap_filter, std::string_view data, T key)
+{
+    CompactBlockView<T> block(data);
+    auto i = block.lowerBound(key);
+    if (i < block.size && block.value(i) == key)
+        block.decode(bitmap_filter, i);
+}
+
+template <typename T>
+void Block<T>::searchRangeCompact(BitmapFilterPtr & bitmap_filter, std::string_view data, T begin, T end)
+{
+    CompactBlockView<T> block(data);
+    for (auto i = block.lowerBound(begin); i < block.size && block.value(i) <= end; ++i)
+        block.decode(bitmap_filter, i);
+}
+
+void Block<String>::serializeCompact(WriteBuffer & write_buf) const
+{
+    writeIntBinary(static_cast<UInt32>(entries.size()), write_buf);
+    UInt32 value_offset = 0;
+    for (const auto & entry : entries)
+    {
+        writeIntBinary(value_offset, write_buf);
+        value_offset += entry.value.size();
+    }
+    writeIntBinary(value_offset, write_buf);
+    for (const auto & entry : entries)
+        write_buf.write(entry.value.data(), entry.value.size());
+    serializePostings(entries, write_buf);
+}
+
+void Block<String>::searchCompact(BitmapFilterPtr & bitmap_filter, std::string_view data, std::string_view key)
+{
+    CompactBlockView<String> block(data);
+    auto i = block.lowerBound(key);
+    if (i < block.size && block.value(i) == key)
+        block.decode(bitmap_filter, i);
+}
+
+void Block<String>::searchNotInCompact(
+    BitmapFilterPtr & bitmap_filter,
+    std::string_view data,
+    const std::set<String> & keys)
+{
+    CompactBlockView<String> block(data);
+    // Both the values and the keys are sorted, merge them.
+    auto it = keys.begin();
+    for (UInt32 i = 0; i < block.size; ++i)
+    {
+        auto value = block.value(i);
+        while (it != keys.end() && std::string_view(*it) < value)
+            ++it;
+        if (it == keys.end() || std::string_view(*it) != value)
+            block.decode(bitmap_filter, i);
+    }
+}
+
 template <typename T>
 void MetaEntry<T>::serialize(WriteBuffer & write_buf) const
 {
     writeIntBinary(offset, write_buf);
     writeIntBinary(size, write_buf);
-    writeIntBinary(min, write_buf);
-    writeIntBinary(max, write_buf);
+    if constexpr (std::is_same_v<T, String>)
+    {
+        writeStringBinary(min, write_buf);
+        writeStringBinary(max, write_buf);
+    }
+    else
+    {
+        writeIntBinary(min, write_buf);
+        writeIntBinary(max, write_buf);
+    }
 }
 
 template <typename T>
@@ -134,14 +353,32 @@ void MetaEntry<T>::deserialize(MetaEntry<T> & entry, ReadBuffer & read_buf)
 {
     readIntBinary(entry.offset, read_buf);
     readIntBinary(entry.size, read_buf);
-    readIntBinary(entry.min, read_buf);
-    readIntBinary(entry.max, read_buf);
+    if constexpr (std::is_same_v<T, String>)
+    {
+        readStringBinary(entry.min, read_buf);
+        readStringBinary(entry.max, read_buf);
+    }
+    else
+    {
+        readIntBinary(entry.min, read_buf);
+        readIntBinary(entry.max, read_buf);
+    }
+}
+
+namespace
+{
+// The size of T recorded in Meta, 0 for string.
+template <typename T>
+constexpr UInt8 metaTypeSize()
+{
+    return std::is_same_v<T, String> ? 0 : sizeof(T);
 }
+} // namespace
 
 template <typename T>
 void Meta<T>::serialize(WriteBuffer & write_buf) const
 {
-    writeIntBinary(static_cast<UInt8>(sizeof(T)), write_buf);
+    writeIntBinary(metaTypeSize<T>(), write_buf);
     writeIntBinary(static_cast<UInt32>(entries.size()), write_buf);
     for (const auto & entry : entries)
         entry.serialize(write_buf);
@@ -152,7 +389,7 @@ void Meta<T>::deserialize(Meta<T> & meta, ReadBuffer & read_buf)
 {
     UInt8 type_size;
     readIntBinary(type_size, read_buf);
-    RUNTIME_CHECK(type_size == sizeof(T));
+    RUNTIME_CHECK(type_size == metaTypeSize<T>());
 
     UInt32 size;
     readIntBinary(size, read_buf);
@@ -177,6 +414,7 @@ template struct MetaEntry<Int8>;
 template struct MetaEntry<Int16>;
 template struct MetaEntry<Int32>;
 template struct MetaEntry<Int64>;
+template struct MetaEntry<String>;
 template struct Meta<UInt8>;
 template struct Meta<UInt16>;
 template struct Meta<UInt32>;
@@ -185,5 +423,6 @@ template struct Meta<Int8>;
 template struct Meta<Int16>;
 template struct Meta<Int32>;
 template struct Meta<Int64>;
+template struct Meta<String>;
 
 } // namespace DB::DM::InvertedIndex
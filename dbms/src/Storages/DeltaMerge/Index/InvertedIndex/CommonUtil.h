@@ -19,6 +19,8 @@
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <common/types.h>
 
+#include <set>
+
 namespace DB::DM::InvertedIndex
 {
 
@@ -26,6 +28,7 @@ enum class Version
 {
     Invalid = 0,
     V1 = 1,
+    V2 = 2,
 };
 
 // InvertedIndex file format (V1):
@@ -37,6 +40,25 @@ enum class Version
 // Meta format:
 // | size of T | number of blocks | offset | size | min | max | offset | size | min | max | ... | offset | size | min | max |
 
+// InvertedIndex file format (V2):
+// | VERSION | Block 0 | Block 1 | ... | Block N | Meta | Meta size | Magic flag |
+// Meta format is the same as V1.
+
+// Block format (V2), all fields before postings are fixed size, so that a block can be searched
+// in place without deserializing:
+// | number of values | value | value | ... | value | posting offset | ... | posting offset | posting | ... | posting |
+// There are (number of values + 1) posting offsets, which are relative to the first posting.
+
+// Posting format (V2), row_ids are sorted, the deltas minus 1 are bit-packed by BitpackingPrimitives:
+// | number of row_ids | first row_id | bit width | packed deltas |
+
+// String InvertedIndex file format, only V2 is supported:
+// | VERSION | collator id | Block 0 | Block 1 | ... | Block N | Meta | Meta size | Magic flag |
+// The values are the sort keys of the strings under the collator, so that strings equal under the
+// collation share one posting. The sorted distinct sort keys of a block are its dictionary:
+// | number of values | value offset | ... | value offset | value | ... | value | posting offset | ... | posting offset | posting | ... | posting |
+// There are (number of values + 1) value offsets, which are relative to the first value.
+
 using RowID = UInt32;
 using RowIDs = std::vector<RowID>;
 
@@ -62,8 +84,37 @@ struct Block
 
     static void search(BitmapFilterPtr & bitmap_filter, ReadBuffer & read_buf, T key);
     static void searchRange(BitmapFilterPtr & bitmap_filter, ReadBuffer & read_buf, T begin, T end);
+
+    // V2 format.
+    void serializeCompact(WriteBuffer & write_buf) const;
+    // `data` is a whole V2 block. The matched posting lists are decoded into bitmap_filter directly.
+    static void searchCompact(BitmapFilterPtr & bitmap_filter, std::string_view data, T key);
+    static void searchRangeCompact(BitmapFilterPtr & bitmap_filter, std::string_view data, T begin, T end);
 };
 
+// Block of string InvertedIndex.
+template <>
+struct Block<String>
+{
+    Block() = default;
+
+    std::vector<BlockEntry<String>> entries;
+    void serializeCompact(WriteBuffer & write_buf) const;
+
+    // `data` is a whole block, `key` is a sort key.
+    static void searchCompact(BitmapFilterPtr & bitmap_filter, std::string_view data, std::string_view key);
+    // Set the row_ids of all values that are not in `keys` to 1 in bitmap_filter.
+    static void searchNotInCompact(
+        BitmapFilterPtr & bitmap_filter,
+        std::string_view data,
+        const std::set<String> & keys);
+};
+
+// Encode/decode a posting list of V2 format.
+void serializePosting(const RowIDs & row_ids, WriteBuffer & write_buf);
+// Set all row_ids of the posting list at `data` to 1 in bitmap_filter.
+void decodePosting(BitmapFilterPtr & bitmap_filter, const char * data);
+
 template <typename T>
 struct MetaEntry
 {
@@ -90,10 +141,12 @@ static std::string_view constexpr MagicFlag = "INVE";
 static UInt32 constexpr MagicFlagLength = MagicFlag.size();
 
 // Get the size of the block in bytes.
+// For string, the size of values is not included, it should be added by the caller.
 template <typename T>
 constexpr size_t getBlockSize(UInt32 entry_size, UInt32 row_ids_size)
 {
-    return sizeof(UInt32) + entry_size * (sizeof(T) + sizeof(UInt32)) + row_ids_size * sizeof(RowID);
+    constexpr size_t value_size = std::is_same_v<T, String> ? sizeof(UInt32) : sizeof(T);
+    return sizeof(UInt32) + entry_size * (value_size + sizeof(UInt32)) + row_ids_size * sizeof(RowID);
 }
 
 } // namespace DB::DM::InvertedIndex
@@ -16,95 +16,146 @@
 #include <IO/Buffer/ReadBufferFromMemory.h>
 #include <IO/ReadHelpers.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/Reader.h>
+#include <common/unaligned.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
+#include <ext/scope_guard.h>
 #include <type_traits>
 
 namespace DB::ErrorCodes
 {
 extern const int BAD_ARGUMENTS;
 extern const int ABORTED;
+extern const int CANNOT_OPEN_FILE;
+extern const int CANNOT_ALLOCATE_MEMORY;
 } // namespace DB::ErrorCodes
 
 namespace DB::DM
 {
 
-InvertedIndexReaderPtr InvertedIndexReader::view(const DataTypePtr & type, std::string_view path)
+namespace
+{
+
+template <template <typename> class Reader, typename... Args>
+InvertedIndexReaderPtr createReader(TypeIndex type_id, Args &&... args)
 {
-    auto type_id = removeNullable(type)->getTypeId();
     switch (type_id)
     {
     case TypeIndex::UInt8:
-        return std::make_shared<InvertedIndexFileReader<UInt8>>(path);
+        return std::make_shared<Reader<UInt8>>(std::forward<Args>(args)...);
     case TypeIndex::Int8:
-        return std::make_shared<InvertedIndexFileReader<Int8>>(path);
+        return std::make_shared<Reader<Int8>>(std::forward<Args>(args)...);
     case TypeIndex::UInt16:
-        return std::make_shared<InvertedIndexFileReader<UInt16>>(path);
+        return std::make_shared<Reader<UInt16>>(std::forward<Args>(args)...);
     case TypeIndex::Int16:
-        return std::make_shared<InvertedIndexFileReader<Int16>>(path);
+        return std::make_shared<Reader<Int16>>(std::forward<Args>(args)...);
     case TypeIndex::UInt32:
-        return std::make_shared<InvertedIndexFileReader<UInt32>>(path);
+        return std::make_shared<Reader<UInt32>>(std::forward<Args>(args)...);
     case TypeIndex::Int32:
-        return std::make_shared<InvertedIndexFileReader<Int32>>(path);
+        return std::make_shared<Reader<Int32>>(std::forward<Args>(args)...);
     case TypeIndex::UInt64:
-        return std::make_shared<InvertedIndexFileReader<UInt64>>(path);
+        return std::make_shared<Reader<UInt64>>(std::forward<Args>(args)...);
     case TypeIndex::Int64:
-        return std::make_shared<InvertedIndexFileReader<Int64>>(path);
+        return std::make_shared<Reader<Int64>>(std::forward<Args>(args)...);
     case TypeIndex::Date:
-        return std::make_shared<InvertedIndexFileReader<UInt16>>(path);
+        return std::make_shared<Reader<UInt16>>(std::forward<Args>(args)...);
     case TypeIndex::DateTime:
-        return std::make_shared<InvertedIndexFileReader<UInt32>>(path);
+        return std::make_shared<Reader<UInt32>>(std::forward<Args>(args)...);
     case TypeIndex::Enum8:
-        return std::make_shared<InvertedIndexFileReader<Int8>>(path);
+        return std::make_shared<Reader<Int8>>(std::forward<Args>(args)...);
     case TypeIndex::Enum16:
-        return std::make_shared<InvertedIndexFileReader<Int16>>(path);
+        return std::make_shared<Reader<Int16>>(std::forward<Args>(args)...);
     case TypeIndex::MyDate:
     case TypeIndex::MyDateTime:
     case TypeIndex::MyTimeStamp:
-        return std::make_shared<InvertedIndexFileReader<UInt64>>(path);
+        return std::make_shared<Reader<UInt64>>(std::forward<Args>(args)...);
     case TypeIndex::MyTime:
-        return std::make_shared<InvertedIndexFileReader<Int64>>(path);
+        return std::make_shared<Reader<Int64>>(std::forward<Args>(args)...);
     default:
         throw Exception(ErrorCodes::BAD_ARGUMENTS, "Unsupported type_id: {}", magic_enum::enum_name(type_id));
     }
 }
 
+// Map the whole file at `path` into memory as read only.
+std::string_view mmapFile(const String & path, void *& mapped_addr, size_t & mapped_size)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throwFromErrno(fmt::format("Cannot open file {}", path), ErrorCodes::CANNOT_OPEN_FILE);
+    SCOPE_EXIT({ ::close(fd); });
+
+    mapped_size = Poco::File(path).getSize();
+    mapped_addr = ::mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped_addr == MAP_FAILED)
+    {
+        mapped_addr = nullptr;
+        throwFromErrno(
+            fmt::format("Cannot mmap file {}, size={}", path, mapped_size),
+            ErrorCodes::CANNOT_ALLOCATE_MEMORY);
+    }
+    return std::string_view(static_cast<const char *>(mapped_addr), mapped_size);
+}
+
+} // namespace
+
+InvertedIndexReaderPtr InvertedIndexReader::view(const DataTypePtr & type, std::string_view path)
+{
+    auto type_id = removeNullable(type)->getTypeId();
+    // Map the file once, and read the version from the mapped region.
+    void * mapped_addr = nullptr;
+    size_t mapped_size = 0;
+    auto data = mmapFile(String(path), mapped_addr, mapped_size);
+    // Unmap the region if it is not owned by the reader.
+    SCOPE_EXIT({
+        if (mapped_addr != nullptr)
+            ::munmap(mapped_addr, mapped_size);
+    });
+    InvertedIndexReaderPtr reader;
+    if (type_id == TypeIndex::String)
+    {
+        reader = std::make_shared<InvertedIndexStringReader>(mapped_addr, mapped_size);
+        mapped_addr = nullptr;
+        return reader;
+    }
+    const auto version = static_cast<UInt8>(data[0]);
+    switch (version)
+    {
+    case magic_enum::enum_integer(InvertedIndex::Version::V1):
+        // V1 is read from the file when searching, see InvertedIndexFileReader.
+        return createReader<InvertedIndexFileReader>(type_id, path);
+    case magic_enum::enum_integer(InvertedIndex::Version::V2):
+        reader = createReader<InvertedIndexCompactReader>(type_id, mapped_addr, mapped_size);
+        mapped_addr = nullptr;
+        return reader;
+    default:
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Unsupported inverted index version: {}", version);
+    }
+}
+
 InvertedIndexReaderPtr InvertedIndexReader::view(const DataTypePtr & type, ReadBuffer & buf, size_t index_size)
 {
     auto type_id = removeNullable(type)->getTypeId();
-    switch (type_id)
+    std::vector<char> data(index_size);
+    RUNTIME_CHECK(buf.readBig(data.data(), index_size) == index_size);
+    RUNTIME_CHECK(index_size > 0);
+    if (type_id == TypeIndex::String)
+        return std::make_shared<InvertedIndexStringReader>(std::move(data));
+    switch (static_cast<UInt8>(data[0]))
     {
-    case TypeIndex::UInt8:
-        return std::make_shared<InvertedIndexMemoryReader<UInt8>>(buf, index_size);
-    case TypeIndex::Int8:
-        return std::make_shared<InvertedIndexMemoryReader<Int8>>(buf, index_size);
-    case TypeIndex::UInt16:
-        return std::make_shared<InvertedIndexMemoryReader<UInt16>>(buf, index_size);
-    case TypeIndex::Int16:
-        return std::make_shared<InvertedIndexMemoryReader<Int16>>(buf, index_size);
-    case TypeIndex::UInt32:
-        return std::make_shared<InvertedIndexMemoryReader<UInt32>>(buf, index_size);
-    case TypeIndex::Int32:
-        return std::make_shared<InvertedIndexMemoryReader<Int32>>(buf, index_size);
-    case TypeIndex::UInt64:
-        return std::make_shared<InvertedIndexMemoryReader<UInt64>>(buf, index_size);
-    case TypeIndex::Int64:
-        return std::make_shared<InvertedIndexMemoryReader<Int64>>(buf, index_size);
-    case TypeIndex::Date:
-        return std::make_shared<InvertedIndexMemoryReader<UInt16>>(buf, index_size);
-    case TypeIndex::DateTime:
-        return std::make_shared<InvertedIndexMemoryReader<UInt32>>(buf, index_size);
-    case TypeIndex::Enum8:
-        return std::make_shared<InvertedIndexMemoryReader<Int8>>(buf, index_size);
-    case TypeIndex::Enum16:
-        return std::make_shared<InvertedIndexMemoryReader<Int16>>(buf, index_size);
-    case TypeIndex::MyDate:
-    case TypeIndex::MyDateTime:
-    case TypeIndex::MyTimeStamp:
-        return std::make_shared<InvertedIndexMemoryReader<UInt64>>(buf, index_size);
-    case TypeIndex::MyTime:
-        return std::make_shared<InvertedIndexMemoryReader<Int64>>(buf, index_size);
+    case magic_enum::enum_integer(InvertedIndex::Version::V1):
+    {
+        ReadBufferFromMemory mem_buf(data.data(), index_size);
+        return createReader<InvertedIndexMemoryReader>(type_id, mem_buf, index_size);
+    }
+    case magic_enum::enum_integer(InvertedIndex::Version::V2):
+        return createReader<InvertedIndexCompactReader>(type_id, std::move(data));
     default:
-        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Unsupported type_id: {}", magic_enum::enum_name(type_id));
+        throw Exception(
+            ErrorCodes::BAD_ARGUMENTS,
+            "Unsupported inverted index version: {}",
+            static_cast<UInt8>(data[0]));
     }
 }
 
@@ -315,6 +366,200 @@ void InvertedIndexFileReader<T>::searchRange(BitmapFilterPtr & bitmap_filter, co
     }
 }
 
+template <typename T>
+InvertedIndexCompactReader<T>::InvertedIndexCompactReader(std::string_view path)
+{
+    data = mmapFile(String(path), mapped_addr, mapped_size);
+    loadMeta();
+}
+
+template <typename T>
+InvertedIndexCompactReader<T>::InvertedIndexCompactReader(void * mapped_addr_, size_t mapped_size_)
+    : mapped_addr(mapped_addr_)
+    , mapped_size(mapped_size_)
+    , data(static_cast<const char *>(mapped_addr_), mapped_size_)
+{
+    loadMeta();
+}
+
+template <typename T>
+InvertedIndexCompactReader<T>::InvertedIndexCompactReader(std::vector<char> && buf)
+    : owned_buf(std::move(buf))
+{
+    data = std::string_view(owned_buf.data(), owned_buf.size());
+    loadMeta();
+}
+
+template <typename T>
+InvertedIndexCompactReader<T>::~InvertedIndexCompactReader()
+{
+    if (mapped_addr != nullptr)
+        ::munmap(mapped_addr, mapped_size);
+}
+
+template <typename T>
+void InvertedIndexCompactReader<T>::loadMeta()
+{
+    // 0. check version
+    RUNTIME_CHECK(data.size() > sizeof(UInt8) + sizeof(UInt32) + InvertedIndex::MagicFlagLength, data.size());
+    RUNTIME_CHECK(static_cast<UInt8>(data[0]) == magic_enum::enum_integer(InvertedIndex::Version::V2));
+
+    // 1. check magic flag
+    size_t data_size = data.size() - InvertedIndex::MagicFlagLength;
+    if (data.substr(data_size) != InvertedIndex::MagicFlag)
+        throw Exception(ErrorCodes::ABORTED, "Invalid magic flag");
+
+    // 2. read meta size
+    data_size = data_size - sizeof(UInt32);
+    auto meta_size = unalignedLoad<UInt32>(data.data() + data_size);
+
+    // 3. read meta
+    data_size = data_size - meta_size;
+    ReadBufferFromMemory buffer(data.data() + data_size, meta_size);
+    InvertedIndex::Meta<T>::deserialize(meta, buffer);
+    for (const auto & entry : meta.entries)
+        RUNTIME_CHECK(entry.offset + entry.size <= data_size, entry.offset, entry.size, data_size);
+}
+
+template <typename T>
+void InvertedIndexCompactReader<T>::search(BitmapFilterPtr & bitmap_filter, const Key & key) const
+{
+    // handle wider data type
+    if (isKeyOutOfRange<T>(key))
+        return;
+
+    T real_key = key;
+    // The blocks are sorted and not overlapped, so the first block whose max >= key is the only candidate.
+    auto it = std::lower_bound(
+        meta.entries.begin(),
+        meta.entries.end(),
+        real_key,
+        [](const auto & entry, const auto & k) { return entry.max < k; });
+    if (it == meta.entries.end() || it->min > real_key)
+        return;
+
+    InvertedIndex::Block<T>::searchCompact(bitmap_filter, data.substr(it->offset, it->size), real_key);
+}
+
+template <typename T>
+void InvertedIndexCompactReader<T>::searchRange(BitmapFilterPtr & bitmap_filter, const Key & begin, const Key & end)
+    const
+{
+    // handle wider data type
+    if (isKeyGreaterThanMax<T>(begin) || isKeyLessThanMin<T>(end))
+        return;
+    T real_begin = begin;
+    if (isKeyLessThanMin<T>(begin))
+        real_begin = std::numeric_limits<T>::min();
+    T real_end = end;
+    if (isKeyGreaterThanMax<T>(end))
+        real_end = std::numeric_limits<T>::max();
+
+    // max < begin
+    auto meta_begin = std::lower_bound(
+        meta.entries.begin(),
+        meta.entries.end(),
+        real_begin,
+        [](const auto & entry, const auto & key) { return entry.max < key; });
+    // min > end
+    auto meta_end
+        = std::upper_bound(meta_begin, meta.entries.end(), real_end, [](const auto & key, const auto & entry) {
+              return key < entry.min;
+          });
+
+    for (auto it = meta_begin; it != meta_end; ++it)
+        InvertedIndex::Block<T>::searchRangeCompact(
+            bitmap_filter,
+            data.substr(it->offset, it->size),
+            real_begin,
+            real_end);
+}
+
+InvertedIndexStringReader::InvertedIndexStringReader(std::string_view path)
+{
+    data = mmapFile(String(path), mapped_addr, mapped_size);
+    loadMeta();
+}
+
+InvertedIndexStringReader::InvertedIndexStringReader(void * mapped_addr_, size_t mapped_size_)
+    : mapped_addr(mapped_addr_)
+    , mapped_size(mapped_size_)
+    , data(static_cast<const char *>(mapped_addr_), mapped_size_)
+{
+    loadMeta();
+}
+
+InvertedIndexStringReader::InvertedIndexStringReader(std::vector<char> && buf)
+    : owned_buf(std::move(buf))
+{
+    data = std::string_view(owned_buf.data(), owned_buf.size());
+    loadMeta();
+}
+
+InvertedIndexStringReader::~InvertedIndexStringReader()
+{
+    if (mapped_addr != nullptr)
+        ::munmap(mapped_addr, mapped_size);
+}
+
+void InvertedIndexStringReader::loadMeta()
+{
+    // 0. check version and read collator id
+    constexpr size_t header_size = sizeof(UInt8) + sizeof(Int32);
+    RUNTIME_CHECK(data.size() > header_size + sizeof(UInt32) + InvertedIndex::MagicFlagLength, data.size());
+    RUNTIME_CHECK(static_cast<UInt8>(data[0]) == magic_enum::enum_integer(InvertedIndex::Version::V2));
+    collator_id = unalignedLoad<Int32>(data.data() + sizeof(UInt8));
+
+    // 1. check magic flag
+    size_t data_size = data.size() - InvertedIndex::MagicFlagLength;
+    if (data.substr(data_size) != InvertedIndex::MagicFlag)
+        throw Exception(ErrorCodes::ABORTED, "Invalid magic flag");
+
+    // 2. read meta size
+    data_size = data_size - sizeof(UInt32);
+    auto meta_size = unalignedLoad<UInt32>(data.data() + data_size);
+
+    // 3. read meta
+    data_size = data_size - meta_size;
+    ReadBufferFromMemory buffer(data.data() + data_size, meta_size);
+    InvertedIndex::Meta<String>::deserialize(meta, buffer);
+    for (const auto & entry : meta.entries)
+        RUNTIME_CHECK(entry.offset + entry.size <= data_size, entry.offset, entry.size, data_size);
+}
+
+void InvertedIndexStringReader::search(BitmapFilterPtr &, const Key &) const
+{
+    throw Exception(ErrorCodes::BAD_ARGUMENTS, "Integer key is not supported by string inverted index");
+}
+
+void InvertedIndexStringReader::searchRange(BitmapFilterPtr &, const Key &, const Key &) const
+{
+    throw Exception(ErrorCodes::BAD_ARGUMENTS, "Integer key is not supported by string inverted index");
+}
+
+void InvertedIndexStringReader::search(BitmapFilterPtr & bitmap_filter, std::string_view sort_key) const
+{
+    auto it = std::lower_bound(
+        meta.entries.begin(),
+        meta.entries.end(),
+        sort_key,
+        [](const auto & entry, const auto & k) { return std::string_view(entry.max) < k; });
+    if (it == meta.entries.end() || std::string_view(it->min) > sort_key)
+        return;
+
+    InvertedIndex::Block<String>::searchCompact(bitmap_filter, data.substr(it->offset, it->size), sort_key);
+}
+
+void InvertedIndexStringReader::searchNotIn(BitmapFilterPtr & bitmap_filter, const std::set<String> & sort_keys)
+    const
+{
+    for (const auto & entry : meta.entries)
+        InvertedIndex::Block<String>::searchNotInCompact(
+            bitmap_filter,
+            data.substr(entry.offset, entry.size),
+            sort_keys);
+}
+
 template class InvertedIndexMemoryReader<UInt8>;
 template class InvertedIndexMemoryReader<UInt16>;
 template class InvertedIndexMemoryReader<UInt32>;
@@ -331,5 +576,13 @@ template class InvertedIndexFileReader<Int8>;
 template class InvertedIndexFileReader<Int16>;
 template class InvertedIndexFileReader<Int32>;
 template class InvertedIndexFileReader<Int64>;
+template class InvertedIndexCompactReader<UInt8>;
+template class InvertedIndexCompactReader<UInt16>;
+template class InvertedIndexCompactReader<UInt32>;
+template class InvertedIndexCompactReader<UInt64>;
+template class InvertedIndexCompactReader<Int8>;
+template class InvertedIndexCompactReader<Int16>;
+template class InvertedIndexCompactReader<Int32>;
+template class InvertedIndexCompactReader<Int64>;
 
 } // namespace DB::DM
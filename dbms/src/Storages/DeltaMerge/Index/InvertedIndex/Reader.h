@@ -58,8 +58,9 @@ private:
 public:
     explicit InvertedIndexMemoryReader(std::string_view path)
     {
-        ReadBufferFromFile buf(path.data());
-        load(buf, Poco::File(path.data()).getSize());
+        const String file_path(path);
+        ReadBufferFromFile buf(file_path);
+        load(buf, Poco::File(file_path).getSize());
     }
 
     InvertedIndexMemoryReader(ReadBuffer & buf, size_t index_size) { load(buf, index_size); }
@@ -82,11 +83,11 @@ private:
     void loadMeta(ReadBuffer & buf, size_t index_size);
 
 public:
-    explicit InvertedIndexFileReader(std::string_view path)
-        : path(path)
+    explicit InvertedIndexFileReader(std::string_view path_)
+        : path(path_)
     {
-        ReadBufferFromFile buffer(path.data());
-        loadMeta(buffer, Poco::File(path.data()).getSize());
+        ReadBufferFromFile buffer(path);
+        loadMeta(buffer, Poco::File(path).getSize());
     }
 
     ~InvertedIndexFileReader() override = default;
@@ -102,4 +103,70 @@ private:
     InvertedIndex::Meta<T> meta; // set by loadMeta
 };
 
+/// Read a V2 InvertedIndex file. The file is mmaped (or held in memory when it is read from a buffer),
+/// blocks are binary searched in place and the matched postings are decoded into the bitmap filter directly.
+/// Its performance is close to InvertedIndexMemoryReader while its memory usage is the size of the compact file.
+template <typename T>
+class InvertedIndexCompactReader : public InvertedIndexReader
+{
+private:
+    void loadMeta();
+
+public:
+    explicit InvertedIndexCompactReader(std::string_view path);
+    explicit InvertedIndexCompactReader(std::vector<char> && buf);
+    // The region mapped by mmap is owned and unmapped by the reader once it is constructed.
+    InvertedIndexCompactReader(void * mapped_addr_, size_t mapped_size_);
+
+    ~InvertedIndexCompactReader() override;
+
+    void search(BitmapFilterPtr & bitmap_filter, const Key & key) const override;
+    void searchRange(BitmapFilterPtr & bitmap_filter, const Key & begin, const Key & end) const override;
+
+private:
+    void * mapped_addr = nullptr;
+    size_t mapped_size = 0;
+    std::vector<char> owned_buf;
+    // The whole index file, starts with the version.
+    std::string_view data;
+    InvertedIndex::Meta<T> meta; // set by loadMeta
+};
+
+/// Read a V2 InvertedIndex file built on a string column. The values are the sort keys of the strings
+/// under the collator recorded in the file, so the keys to search must be sort keys under the same collator.
+/// The file is accessed in the same way as InvertedIndexCompactReader.
+class InvertedIndexStringReader : public InvertedIndexReader
+{
+private:
+    void loadMeta();
+
+public:
+    explicit InvertedIndexStringReader(std::string_view path);
+    explicit InvertedIndexStringReader(std::vector<char> && buf);
+    // The region mapped by mmap is owned and unmapped by the reader once it is constructed.
+    InvertedIndexStringReader(void * mapped_addr_, size_t mapped_size_);
+
+    ~InvertedIndexStringReader() override;
+
+    // Integer keys are not supported.
+    void search(BitmapFilterPtr & bitmap_filter, const Key & key) const override;
+    void searchRange(BitmapFilterPtr & bitmap_filter, const Key & begin, const Key & end) const override;
+
+    // All row ids whose sort key equals to `sort_key` will be set to 1 in bitmap_filter.
+    void search(BitmapFilterPtr & bitmap_filter, std::string_view sort_key) const;
+    // All row ids whose sort key is not in `sort_keys` will be set to 1 in bitmap_filter. NULLs are not included.
+    void searchNotIn(BitmapFilterPtr & bitmap_filter, const std::set<String> & sort_keys) const;
+
+    Int32 collatorId() const { return collator_id; }
+
+private:
+    void * mapped_addr = nullptr;
+    size_t mapped_size = 0;
+    std::vector<char> owned_buf;
+    // The whole index file, starts with the version.
+    std::string_view data;
+    Int32 collator_id = 0; // set by loadMeta
+    InvertedIndex::Meta<String> meta; // set by loadMeta
+};
+
 } // namespace DB::DM
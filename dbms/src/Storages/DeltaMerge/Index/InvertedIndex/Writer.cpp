@@ -13,12 +13,14 @@
 // limitations under the License.
 
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Functions/FunctionHelpers.h>
 #include <IO/Buffer/WriteBufferFromFile.h>
 #include <IO/WriteHelpers.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/Writer.h>
+#include <TiDB/Collation/Collator.h>
 
 #include <ext/scope_guard.h>
 
@@ -39,10 +41,10 @@ void InvertedIndexWriterInternal<T>::addBlock(
 {
     // Note: column may be nullable.
     const bool is_nullable = column.isColumnNullable();
-    const auto * col_vector
-        = is_nullable ? checkAndGetNestedColumn<ColumnVector<T>>(&column) : checkAndGetColumn<ColumnVector<T>>(&column);
-    RUNTIME_CHECK_MSG(col_vector, "ColumnVector is expected, get: {}, T: {}", column.getName(), typeid(T).name());
-    const auto & col_data = col_vector->getData();
+    using ColumnType = std::conditional_t<std::is_same_v<T, String>, ColumnString, ColumnVector<T>>;
+    const auto * col_data
+        = is_nullable ? checkAndGetNestedColumn<ColumnType>(&column) : checkAndGetColumn<ColumnType>(&column);
+    RUNTIME_CHECK_MSG(col_data, "Unexpected column, get: {}, T: {}", column.getName(), typeid(T).name());
 
     const auto * null_map = is_nullable ? &(checkAndGetColumn<ColumnNullable>(&column)->getNullMapData()) : nullptr;
     const auto * del_mark_data = del_mark ? &(del_mark->getData()) : nullptr;
@@ -52,7 +54,8 @@ void InvertedIndexWriterInternal<T>::addBlock(
 
     Stopwatch w_proceed_check(CLOCK_MONOTONIC_COARSE);
 
-    for (size_t i = 0; i < col_data.size(); ++i)
+    String sort_key_container;
+    for (size_t i = 0; i < col_data->size(); ++i)
     {
         auto row_offset = added_rows;
         ++added_rows;
@@ -73,7 +76,16 @@ void InvertedIndexWriterInternal<T>::addBlock(
         if (null_map && (*null_map)[i])
             continue;
 
-        index[col_data[i]].push_back(row_offset);
+        if constexpr (std::is_same_v<T, String>)
+        {
+            auto value = col_data->getDataAt(i);
+            auto sort_key = collator->sortKeyFastPath(value.data, value.size, sort_key_container);
+            index[sort_key.toString()].push_back(row_offset);
+        }
+        else
+        {
+            index[col_data->getData()[i]].push_back(row_offset);
+        }
     }
 }
 
@@ -83,31 +95,45 @@ void InvertedIndexWriterInternal<T>::saveToBuffer(WriteBuffer & write_buf) const
     size_t offset = 0;
 
     // 0. write version
-    UInt8 version = magic_enum::enum_integer(InvertedIndex::Version::V1);
-    writeIntBinary(version, write_buf);
+    writeIntBinary(static_cast<UInt8>(magic_enum::enum_integer(version)), write_buf);
     offset += sizeof(UInt8);
+    if constexpr (std::is_same_v<T, String>)
+    {
+        writeIntBinary(static_cast<Int32>(collator->getCollatorId()), write_buf);
+        offset += sizeof(Int32);
+    }
 
     InvertedIndex::Meta<T> meta;
 
     // 1. write data by block
     InvertedIndex::Block<T> block;
     size_t row_ids_size = 0;
+    size_t values_size = 0; // only for string
     auto write_block = [&] {
-        block.serialize(write_buf);
+        if constexpr (std::is_same_v<T, String>)
+            block.serializeCompact(write_buf);
+        else if (version == InvertedIndex::Version::V1)
+            block.serialize(write_buf);
+        else
+            block.serializeCompact(write_buf);
         size_t total_size = write_buf.count();
         meta.entries.emplace_back(offset, total_size - offset, block.entries.front().value, block.entries.back().value);
         block.entries.clear();
         offset = total_size;
         row_ids_size = 0;
+        values_size = 0;
     };
 
     for (const auto & [key, row_ids] : index)
     {
         block.entries.emplace_back(key, row_ids);
         row_ids_size += row_ids.size();
+        if constexpr (std::is_same_v<T, String>)
+            values_size += key.size();
 
         // write block
-        if (InvertedIndex::getBlockSize<T>(block.entries.size(), row_ids_size) >= InvertedIndex::BlockSize)
+        if (InvertedIndex::getBlockSize<T>(block.entries.size(), row_ids_size) + values_size
+            >= InvertedIndex::BlockSize)
             write_block();
     }
     if (!block.entries.empty())
@@ -172,6 +198,7 @@ template class InvertedIndexWriterInternal<Int8>;
 template class InvertedIndexWriterInternal<Int16>;
 template class InvertedIndexWriterInternal<Int32>;
 template class InvertedIndexWriterInternal<Int64>;
+template class InvertedIndexWriterInternal<String>;
 template class InvertedIndexWriterOnDisk<UInt8>;
 template class InvertedIndexWriterOnDisk<UInt16>;
 template class InvertedIndexWriterOnDisk<UInt32>;
@@ -180,6 +207,7 @@ template class InvertedIndexWriterOnDisk<Int8>;
 template class InvertedIndexWriterOnDisk<Int16>;
 template class InvertedIndexWriterOnDisk<Int32>;
 template class InvertedIndexWriterOnDisk<Int64>;
+template class InvertedIndexWriterOnDisk<String>;
 template class InvertedIndexWriterInMemory<UInt8>;
 template class InvertedIndexWriterInMemory<UInt16>;
 template class InvertedIndexWriterInMemory<UInt32>;
@@ -188,46 +216,60 @@ template class InvertedIndexWriterInMemory<Int8>;
 template class InvertedIndexWriterInMemory<Int16>;
 template class InvertedIndexWriterInMemory<Int32>;
 template class InvertedIndexWriterInMemory<Int64>;
+template class InvertedIndexWriterInMemory<String>;
 
 LocalIndexWriterOnDiskPtr createOnDiskInvertedIndexWriter(
     IndexID index_id,
     std::string_view index_file,
-    const TiDB::InvertedIndexDefinitionPtr & definition)
+    const TiDB::InvertedIndexDefinitionPtr & definition,
+    bool enable_v2)
 {
     if (!definition)
         throw Exception(ErrorCodes::BAD_ARGUMENTS, "Invalid index kind or definition");
 
-    if (definition->type_size == sizeof(UInt8) && !definition->is_signed)
+    // The integer index is written in V1 unless V2 is enabled, so that the nodes before V2 can read it.
+    // The string index is only supported by V2.
+    const auto version = enable_v2 ? InvertedIndex::Version::V2 : InvertedIndex::Version::V1;
+
+    if (definition->isString())
+    {
+        return std::make_shared<InvertedIndexWriterOnDisk<String>>(
+            index_id,
+            index_file,
+            InvertedIndex::Version::V2,
+            TiDB::ITiDBCollator::getCollator(definition->collator_id));
+    }
+    else if (definition->type_size == sizeof(UInt8) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<UInt8>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<UInt8>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(Int8) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<Int8>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<Int8>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(UInt16) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<UInt16>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<UInt16>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(Int16) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<Int16>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<Int16>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(UInt32) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<UInt32>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<UInt32>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(Int32) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<Int32>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<Int32>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(UInt64) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<UInt64>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<UInt64>>(index_id, index_file, version);
     }
     else if (definition->type_size == sizeof(Int64) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterOnDisk<Int64>>(index_id, index_file);
+        return std::make_shared<InvertedIndexWriterOnDisk<Int64>>(index_id, index_file, version);
     }
     else
     {
@@ -237,42 +279,54 @@ LocalIndexWriterOnDiskPtr createOnDiskInvertedIndexWriter(
 
 LocalIndexWriterInMemoryPtr createInMemoryInvertedIndexWriter(
     IndexID index_id,
-    const TiDB::InvertedIndexDefinitionPtr & definition)
+    const TiDB::InvertedIndexDefinitionPtr & definition,
+    bool enable_v2)
 {
     if (!definition)
         throw Exception(ErrorCodes::BAD_ARGUMENTS, "Invalid index kind or definition");
 
-    if (definition->type_size == sizeof(UInt8) && !definition->is_signed)
+    // The integer index is written in V1 unless V2 is enabled, so that the nodes before V2 can read it.
+    // The string index is only supported by V2.
+    const auto version = enable_v2 ? InvertedIndex::Version::V2 : InvertedIndex::Version::V1;
+
+    if (definition->isString())
+    {
+        return std::make_shared<InvertedIndexWriterInMemory<String>>(
+            index_id,
+            InvertedIndex::Version::V2,
+            TiDB::ITiDBCollator::getCollator(definition->collator_id));
+    }
+    else if (definition->type_size == sizeof(UInt8) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<UInt8>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<UInt8>>(index_id, version);
     }
     else if (definition->type_size == sizeof(Int8) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<Int8>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<Int8>>(index_id, version);
     }
     else if (definition->type_size == sizeof(UInt16) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<UInt16>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<UInt16>>(index_id, version);
     }
     else if (definition->type_size == sizeof(Int16) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<Int16>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<Int16>>(index_id, version);
     }
     else if (definition->type_size == sizeof(UInt32) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<UInt32>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<UInt32>>(index_id, version);
     }
     else if (definition->type_size == sizeof(Int32) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<Int32>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<Int32>>(index_id, version);
     }
     else if (definition->type_size == sizeof(UInt64) && !definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<UInt64>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<UInt64>>(index_id, version);
     }
     else if (definition->type_size == sizeof(Int64) && definition->is_signed)
     {
-        return std::make_shared<InvertedIndexWriterInMemory<Int64>>(index_id);
+        return std::make_shared<InvertedIndexWriterInMemory<Int64>>(index_id, version);
     }
     else
     {
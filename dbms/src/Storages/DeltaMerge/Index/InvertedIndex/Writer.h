@@ -17,6 +17,7 @@
 #include <Storages/DeltaMerge/Index/InvertedIndex/CommonUtil.h>
 #include <Storages/DeltaMerge/Index/LocalIndexWriter.h>
 #include <TiDB/Schema/InvertedIndex.h>
+#include <TiDB/Schema/TiDB_fwd.h>
 
 namespace DB::DM
 {
@@ -29,6 +30,17 @@ public:
     using RowID = InvertedIndex::RowID;
 
 public:
+    // `collator_` is required for string index, the values are indexed by their sort keys under it.
+    explicit InvertedIndexWriterInternal(
+        InvertedIndex::Version version_,
+        TiDB::TiDBCollatorPtr collator_ = nullptr)
+        : version(version_)
+        , collator(collator_)
+    {
+        RUNTIME_CHECK(version == InvertedIndex::Version::V1 || version == InvertedIndex::Version::V2);
+        if constexpr (std::is_same_v<T, String>)
+            RUNTIME_CHECK(version == InvertedIndex::Version::V2 && collator != nullptr);
+    }
     ~InvertedIndexWriterInternal();
 
     using ProceedCheckFn = LocalIndexWriter::ProceedCheckFn;
@@ -38,6 +50,8 @@ public:
     void saveToBuffer(WriteBuffer & write_buf) const;
 
 public:
+    const InvertedIndex::Version version;
+    const TiDB::TiDBCollatorPtr collator;
     UInt64 added_rows = 0; // Includes nulls and deletes. Used as the index key.
     std::map<Key, std::vector<RowID>> index;
     mutable double total_duration = 0;
@@ -48,9 +62,12 @@ template <typename T>
 class InvertedIndexWriterInMemory : public LocalIndexWriterInMemory
 {
 public:
-    explicit InvertedIndexWriterInMemory(IndexID index_id)
+    explicit InvertedIndexWriterInMemory(
+        IndexID index_id,
+        InvertedIndex::Version version = InvertedIndex::Version::V1,
+        TiDB::TiDBCollatorPtr collator = nullptr)
         : LocalIndexWriterInMemory(index_id)
-        , writer()
+        , writer(version, collator)
     {}
 
     void saveToBuffer(WriteBuffer & write_buf) override;
@@ -73,9 +90,13 @@ template <typename T>
 class InvertedIndexWriterOnDisk : public LocalIndexWriterOnDisk
 {
 public:
-    explicit InvertedIndexWriterOnDisk(IndexID index_id, std::string_view index_file)
+    explicit InvertedIndexWriterOnDisk(
+        IndexID index_id,
+        std::string_view index_file,
+        InvertedIndex::Version version = InvertedIndex::Version::V1,
+        TiDB::TiDBCollatorPtr collator = nullptr)
         : LocalIndexWriterOnDisk(index_id, index_file)
-        , writer()
+        , writer(version, collator)
     {}
 
     void saveToFile() override;
@@ -97,10 +118,12 @@ private:
 LocalIndexWriterOnDiskPtr createOnDiskInvertedIndexWriter(
     IndexID index_id,
     std::string_view index_file,
-    const TiDB::InvertedIndexDefinitionPtr & definition);
+    const TiDB::InvertedIndexDefinitionPtr & definition,
+    bool enable_v2);
 
 LocalIndexWriterInMemoryPtr createInMemoryInvertedIndexWriter(
     IndexID index_id,
-    const TiDB::InvertedIndexDefinitionPtr & definition);
+    const TiDB::InvertedIndexDefinitionPtr & definition,
+    bool enable_v2);
 
 } // namespace DB::DM
@@ -12,8 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Filter/IntegerSet.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/Reader.h>
 #include <Storages/DeltaMerge/Index/InvertedIndex/Writer.h>
+#include <TiDB/Collation/Collator.h>
 #include <TestUtils/FunctionTestUtils.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <gtest/gtest.h>
@@ -45,6 +50,24 @@ public:
         builder.addBlock(*col, del_mark, []() { return true; });
     }
 
+    // All readers that can read the index file of the given version.
+    static std::vector<InvertedIndexReaderPtr> createReaders(InvertedIndex::Version version)
+    {
+        if (version == InvertedIndex::Version::V1)
+            return {
+                std::make_shared<InvertedIndexMemoryReader<T>>(IndexFileName),
+                std::make_shared<InvertedIndexFileReader<T>>(IndexFileName),
+            };
+
+        ReadBufferFromFile buf(IndexFileName);
+        std::vector<char> data(Poco::File(IndexFileName).getSize());
+        buf.readStrict(data.data(), data.size());
+        return {
+            std::make_shared<InvertedIndexCompactReader<T>>(IndexFileName),
+            std::make_shared<InvertedIndexCompactReader<T>>(std::move(data)),
+        };
+    }
+
     class SimpleTestCase
     {
         static void search(const InvertedIndexReaderPtr & viewer)
@@ -80,22 +103,19 @@ public:
     public:
         static void run()
         {
+            for (auto version : {InvertedIndex::Version::V1, InvertedIndex::Version::V2})
             {
-                auto builder = InvertedIndexWriterOnDisk<T>(0, IndexFileName);
-                writeBlock(builder, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, {0, 1, 0, 1, 0, 1, 0, 1, 0, 1});
-                writeBlock(builder, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
-                writeBlock(builder, {1, 2, 2, 2, 3, 3, 3, 4, 4, 4}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
-                builder.finalize();
-            }
-            {
-                auto viewer = std::make_shared<InvertedIndexMemoryReader<T>>(IndexFileName);
-                search(viewer);
-            }
-            {
-                auto viewer = std::make_shared<InvertedIndexFileReader<T>>(IndexFileName);
-                search(viewer);
+                {
+                    auto builder = InvertedIndexWriterOnDisk<T>(0, IndexFileName, version);
+                    writeBlock(builder, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, {0, 1, 0, 1, 0, 1, 0, 1, 0, 1});
+                    writeBlock(builder, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+                    writeBlock(builder, {1, 2, 2, 2, 3, 3, 3, 4, 4, 4}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+                    builder.finalize();
+                }
+                for (const auto & viewer : createReaders(version))
+                    search(viewer);
+                Poco::File(IndexFileName).remove();
             }
-            Poco::File(IndexFileName).remove();
         }
     };
 
@@ -144,6 +164,18 @@ public:
             v_search_range(100, 104, 0);
         }
 
+        static void build(InvertedIndex::Version version)
+        {
+            auto builder = InvertedIndexWriterOnDisk<T>(0, IndexFileName, version);
+            for (UInt32 i = 0; i < block_count; ++i)
+            {
+                DB::tests::InferredDataVector<T> values(block_size, i);
+                DB::tests::InferredDataVector<UInt8> del_marks(block_size, 0);
+                writeBlock(builder, values, del_marks);
+            }
+            builder.finalize();
+        }
+
         static void searchMultiThread(const InvertedIndexReaderPtr & viewer)
         {
             auto v_search = [&viewer](const UInt64 key, const size_t expected_count) {
@@ -200,48 +232,24 @@ public:
     public:
         static void run()
         {
+            for (auto version : {InvertedIndex::Version::V1, InvertedIndex::Version::V2})
             {
-                auto builder = InvertedIndexWriterOnDisk<T>(0, IndexFileName);
-                for (UInt32 i = 0; i < block_count; ++i)
-                {
-                    DB::tests::InferredDataVector<T> values(block_size, i);
-                    DB::tests::InferredDataVector<UInt8> del_marks(block_size, 0);
-                    writeBlock(builder, values, del_marks);
-                }
-                builder.finalize();
-            }
-            {
-                auto viewer = std::make_shared<InvertedIndexMemoryReader<T>>(IndexFileName);
-                search(viewer);
-            }
-            {
-                auto viewer = std::make_shared<InvertedIndexFileReader<T>>(IndexFileName);
-                search(viewer);
+                build(version);
+                for (const auto & viewer : createReaders(version))
+                    search(viewer);
+                Poco::File(IndexFileName).remove();
             }
-            Poco::File(IndexFileName).remove();
         }
 
         static void runMultiThread()
         {
+            for (auto version : {InvertedIndex::Version::V1, InvertedIndex::Version::V2})
             {
-                auto builder = InvertedIndexWriterOnDisk<T>(0, IndexFileName);
-                for (UInt32 i = 0; i < block_count; ++i)
-                {
-                    DB::tests::InferredDataVector<T> values(block_size, i);
-                    DB::tests::InferredDataVector<UInt8> del_marks(block_size, 0);
-                    writeBlock(builder, values, del_marks);
-                }
-                builder.finalize();
+                build(version);
+                for (const auto & viewer : createReaders(version))
+                    searchMultiThread(viewer);
+                Poco::File(IndexFileName).remove();
             }
-            {
-                auto viewer = std::make_shared<InvertedIndexMemoryReader<T>>(IndexFileName);
-                searchMultiThread(viewer);
-            }
-            {
-                auto viewer = std::make_shared<InvertedIndexFileReader<T>>(IndexFileName);
-                searchMultiThread(viewer);
-            }
-            Poco::File(IndexFileName).remove();
         }
     };
 };
@@ -355,4 +363,176 @@ try
 }
 CATCH
 
+TEST(InvertedIndex, ReadTypeLargerThanIndexTypeV2)
+try
+{
+    // Build UInt8 type index
+    {
+        auto builder = InvertedIndexWriterOnDisk<UInt8>(0, IndexFileName, InvertedIndex::Version::V2);
+        InvertedIndexTest<UInt8>::writeBlock(builder, {1, 2, 3, 4, 5, 6, 7, 8, 9, 255}, {0, 1, 0, 1, 0, 1, 0, 1, 0, 0});
+        InvertedIndexTest<UInt8>::writeBlock(builder, {1, 2, 3, 4, 5, 6, 7, 8, 9, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+        InvertedIndexTest<UInt8>::writeBlock(builder, {1, 2, 2, 2, 3, 3, 3, 4, 4, 128}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+        builder.finalize();
+    }
+    auto viewer = std::make_shared<InvertedIndexCompactReader<UInt8>>(IndexFileName);
+    // search key is in the range of UInt8
+    {
+        auto bitmap_filter = std::make_shared<BitmapFilter>(30, false);
+        viewer->search(bitmap_filter, 1);
+        ASSERT_EQ(bitmap_filter->toDebugString(), "100000000010000000001000000000");
+    }
+    {
+        auto bitmap_filter = std::make_shared<BitmapFilter>(30, false);
+        viewer->search(bitmap_filter, 255);
+        ASSERT_EQ(bitmap_filter->toDebugString(), "000000000100000000000000000000");
+    }
+    // search key is larger than UInt8
+    {
+        auto bitmap_filter = std::make_shared<BitmapFilter>(30, false);
+        viewer->search(bitmap_filter, 256);
+        ASSERT_EQ(bitmap_filter->toDebugString(), "000000000000000000000000000000");
+    }
+    {
+        auto bitmap_filter = std::make_shared<BitmapFilter>(30, false);
+        viewer->search(bitmap_filter, 1024);
+        ASSERT_EQ(bitmap_filter->toDebugString(), "000000000000000000000000000000");
+    }
+    Poco::File(IndexFileName).remove();
+}
+CATCH
+
+TEST(InvertedIndex, CompactPosting)
+try
+{
+    std::mt19937 generator;
+    for (UInt32 count : {1, 2, 31, 32, 33, 100, 1000})
+    {
+        for (UInt32 max_gap : {1, 2, 100, 100000})
+        {
+            InvertedIndex::RowIDs row_ids;
+            InvertedIndex::RowID row_id = generator() % 10;
+            for (UInt32 i = 0; i < count; ++i)
+            {
+                row_ids.push_back(row_id);
+                row_id += 1 + generator() % max_gap;
+            }
+
+            WriteBufferFromOwnString buf;
+            InvertedIndex::serializePosting(row_ids, buf);
+            auto bitmap_filter = std::make_shared<BitmapFilter>(row_id, false);
+            InvertedIndex::decodePosting(bitmap_filter, buf.str().data());
+            ASSERT_EQ(bitmap_filter->count(), count);
+            for (auto id : row_ids)
+                ASSERT_TRUE(bitmap_filter->get(id)) << count << " " << max_gap << " " << id;
+        }
+    }
+}
+CATCH
+
+TEST(InvertedIndex, ViewByVersion)
+try
+{
+    auto type = std::make_shared<DataTypeUInt32>();
+    for (auto version : {InvertedIndex::Version::V1, InvertedIndex::Version::V2})
+    {
+        {
+            auto builder = InvertedIndexWriterOnDisk<UInt32>(0, IndexFileName, version);
+            InvertedIndexTest<UInt32>::writeBlock(builder, {1, 2, 3, 1, 2, 3}, {0, 0, 0, 0, 0, 0});
+            builder.finalize();
+        }
+        auto check = [](const InvertedIndexReaderPtr & viewer) {
+            auto bitmap_filter = std::make_shared<BitmapFilter>(6, false);
+            viewer->search(bitmap_filter, 2);
+            ASSERT_EQ(bitmap_filter->toDebugString(), "010010");
+        };
+        check(InvertedIndexReader::view(type, IndexFileName));
+
+        // The path is not null-terminated
+        const String padded_path = fmt::format("{}.padding", IndexFileName);
+        auto viewer = InvertedIndexReader::view(type, std::string_view(padded_path).substr(0, strlen(IndexFileName)));
+        check(viewer);
+        if (version == InvertedIndex::Version::V1)
+            ASSERT_NE(std::dynamic_pointer_cast<InvertedIndexFileReader<UInt32>>(viewer), nullptr);
+        else
+            ASSERT_NE(std::dynamic_pointer_cast<InvertedIndexCompactReader<UInt32>>(viewer), nullptr);
+
+        auto size = Poco::File(IndexFileName).getSize();
+        ReadBufferFromFile buf(IndexFileName);
+        check(InvertedIndexReader::view(type, buf, size));
+        Poco::File(IndexFileName).remove();
+    }
+}
+CATCH
+
+TEST(InvertedIndex, String)
+try
+{
+    const auto * collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI);
+    auto type = std::make_shared<DataTypeString>();
+    // Enough distinct values to have multiple blocks.
+    constexpr size_t rows = 20000;
+    std::vector<String> values;
+    for (size_t i = 0; i < rows; ++i)
+        values.push_back(fmt::format("{}value_{}", i % 2 ? "A" : "a", i % 10000));
+    values[7] = "b  ";
+    values[9] = "B";
+    {
+        auto builder = InvertedIndexWriterOnDisk<String>(0, IndexFileName, InvertedIndex::Version::V2, collator);
+        InvertedIndexTest<String>::writeBlock(builder, values, DB::tests::InferredDataVector<UInt8>(rows, 0));
+        builder.finalize();
+    }
+
+    auto sort_key = [&](const String & s) {
+        String container;
+        return collator->sortKeyFastPath(s.data(), s.size(), container).toString();
+    };
+    auto check = [&](const InvertedIndexReaderPtr & viewer) {
+        auto reader = std::dynamic_pointer_cast<InvertedIndexStringReader>(viewer);
+        ASSERT_NE(reader, nullptr);
+        ASSERT_EQ(reader->collatorId(), collator->getCollatorId());
+
+        // "b  " and "B" are equal under utf8mb4_general_ci.
+        auto bitmap_filter = std::make_shared<BitmapFilter>(rows, false);
+        reader->search(bitmap_filter, sort_key("b"));
+        ASSERT_EQ(bitmap_filter->count(), 2);
+        ASSERT_TRUE(bitmap_filter->get(7));
+        ASSERT_TRUE(bitmap_filter->get(9));
+
+        // Row 12345 and row 2345 share the same value case-insensitively.
+        bitmap_filter = std::make_shared<BitmapFilter>(rows, false);
+        reader->search(bitmap_filter, sort_key("AVALUE_2345"));
+        ASSERT_EQ(bitmap_filter->count(), 2);
+        ASSERT_TRUE(bitmap_filter->get(2345));
+        ASSERT_TRUE(bitmap_filter->get(12345));
+
+        bitmap_filter = std::make_shared<BitmapFilter>(rows, false);
+        reader->search(bitmap_filter, sort_key("not_exist"));
+        ASSERT_EQ(bitmap_filter->count(), 0);
+
+        bitmap_filter = std::make_shared<BitmapFilter>(rows, false);
+        reader->searchNotIn(bitmap_filter, {sort_key("b"), sort_key("avalue_0")});
+        ASSERT_EQ(bitmap_filter->count(), rows - 4);
+        ASSERT_FALSE(bitmap_filter->get(0));
+        ASSERT_FALSE(bitmap_filter->get(10000));
+
+        // Search by the set built from the filter.
+        auto set = IntegerSet::createValueSet(type, {Field(String("B")), Field(String("x"))}, collator);
+        ASSERT_EQ(set->search(viewer, rows)->count(), 2);
+        ASSERT_EQ(set->invert()->search(viewer, rows)->count(), rows - 2);
+        // Another collator, all rows are returned.
+        set = IntegerSet::createValueSet(
+            type,
+            {Field(String("B"))},
+            TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_BIN));
+        ASSERT_TRUE(set->search(viewer, rows)->isAllMatch());
+    };
+    check(InvertedIndexReader::view(type, IndexFileName));
+
+    auto size = Poco::File(IndexFileName).getSize();
+    ReadBufferFromFile buf(IndexFileName);
+    check(InvertedIndexReader::view(type, buf, size));
+    Poco::File(IndexFileName).remove();
+}
+CATCH
+
 } // namespace DB::DM::tests
@@ -16,6 +16,7 @@
 #include <Storages/DeltaMerge/Index/LocalIndexInfo.h>
 #include <Storages/FormatVersion.h>
 #include <Storages/KVStore/Types.h>
+#include <TiDB/Collation/Collator.h>
 #include <TiDB/Schema/TiDB.h>
 #include <fiu.h>
 
@@ -90,6 +91,28 @@ LocalIndexInfosPtr initLocalIndexInfos(const TiDB::TableInfo & table_info, const
 
 namespace
 {
+// The inverted index definition from TiDB only describes integer columns. For a string column,
+// the values are indexed by their sort keys, so the definition carries the collator of the column.
+TiDB::InvertedIndexDefinitionPtr getInvertedIndexDefinition(
+    const TiDB::TableInfo & table_info,
+    ColumnID column_id,
+    const TiDB::InvertedIndexDefinitionPtr & definition)
+{
+    const auto & col = table_info.getColumnInfo(column_id);
+    if (col.tp != TiDB::TypeVarchar && col.tp != TiDB::TypeVarString && col.tp != TiDB::TypeString)
+        return definition;
+
+    const auto * collator
+        = TiDB::ITiDBCollator::getCollator(col.collate.isEmpty() ? "binary" : col.collate.convert<String>());
+    if (!collator)
+        collator = TiDB::ITiDBCollator::getCollator("binary");
+    return std::make_shared<const TiDB::InvertedIndexDefinition>(TiDB::InvertedIndexDefinition{
+        .is_signed = false,
+        .type_size = 0,
+        .collator_id = collator->getCollatorId(),
+    });
+}
+
 LocalIndexInfosChangeset nothingChanged(const std::unordered_map<IndexID, size_t> & original_local_index_id_map)
 {
     std::vector<IndexID> all_indexes;
@@ -185,7 +208,10 @@ LocalIndexInfosChangeset generateLocalIndexInfos(
                 else if (idx.columnarIndexKind() == TiDB::ColumnarIndexKind::FullText)
                     new_index_infos->emplace_back(LocalIndexInfo(idx.id, column_id, idx.full_text_index));
                 else if (idx.columnarIndexKind() == TiDB::ColumnarIndexKind::Inverted)
-                    new_index_infos->emplace_back(LocalIndexInfo(idx.id, column_id, idx.inverted_index));
+                    new_index_infos->emplace_back(LocalIndexInfo(
+                        idx.id,
+                        column_id,
+                        getInvertedIndexDefinition(new_table_info, column_id, idx.inverted_index)));
                 newly_added.emplace_back(idx.id);
                 index_ids_in_new_table.emplace(idx.id);
             }
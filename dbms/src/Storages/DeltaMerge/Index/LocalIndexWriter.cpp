@@ -24,14 +24,19 @@
 namespace DB::DM
 {
 
-LocalIndexWriterInMemoryPtr LocalIndexWriter::createInMemory(const LocalIndexInfo & index_info)
+LocalIndexWriterInMemoryPtr LocalIndexWriter::createInMemory(
+    const LocalIndexInfo & index_info,
+    bool enable_inverted_index_v2)
 {
     switch (index_info.kind)
     {
     case TiDB::ColumnarIndexKind::Vector:
         return std::make_shared<VectorIndexWriterInMemory>(index_info.index_id, index_info.def_vector_index);
     case TiDB::ColumnarIndexKind::Inverted:
-        return createInMemoryInvertedIndexWriter(index_info.index_id, index_info.def_inverted_index);
+        return createInMemoryInvertedIndexWriter(
+            index_info.index_id,
+            index_info.def_inverted_index,
+            enable_inverted_index_v2);
     case TiDB::ColumnarIndexKind::FullText:
         return FullTextIndexWriterInMemory::create(index_info.index_id, index_info.def_fulltext_index);
     default:
@@ -39,14 +44,21 @@ LocalIndexWriterInMemoryPtr LocalIndexWriter::createInMemory(const LocalIndexInf
     }
 }
 
-LocalIndexWriterOnDiskPtr LocalIndexWriter::createOnDisk(std::string_view index_file, const LocalIndexInfo & index_info)
+LocalIndexWriterOnDiskPtr LocalIndexWriter::createOnDisk(
+    std::string_view index_file,
+    const LocalIndexInfo & index_info,
+    bool enable_inverted_index_v2)
 {
     switch (index_info.kind)
     {
     case TiDB::ColumnarIndexKind::Vector:
         return std::make_shared<VectorIndexWriterOnDisk>(index_info.index_id, index_file, index_info.def_vector_index);
     case TiDB::ColumnarIndexKind::Inverted:
-        return createOnDiskInvertedIndexWriter(index_info.index_id, index_file, index_info.def_inverted_index);
+        return createOnDiskInvertedIndexWriter(
+            index_info.index_id,
+            index_file,
+            index_info.def_inverted_index,
+            enable_inverted_index_v2);
     case TiDB::ColumnarIndexKind::FullText:
         return FullTextIndexWriterOnDisk::create(index_info.index_id, index_info.def_fulltext_index, index_file);
     default:
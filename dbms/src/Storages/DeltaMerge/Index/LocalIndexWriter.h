@@ -38,8 +38,15 @@ public:
         : index_id(index_id_)
     {}
 
-    static LocalIndexWriterInMemoryPtr createInMemory(const LocalIndexInfo & index_info);
-    static LocalIndexWriterOnDiskPtr createOnDisk(std::string_view index_file, const LocalIndexInfo & index_info);
+    // The integer inverted indexes are written in V2 format only when `enable_inverted_index_v2` is true,
+    // because the nodes before V2 can not read them.
+    static LocalIndexWriterInMemoryPtr createInMemory(
+        const LocalIndexInfo & index_info,
+        bool enable_inverted_index_v2 = false);
+    static LocalIndexWriterOnDiskPtr createOnDisk(
+        std::string_view index_file,
+        const LocalIndexInfo & index_info,
+        bool enable_inverted_index_v2 = false);
 
     virtual ~LocalIndexWriter() = default;
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
 namespace DB::DM
@@ -31,4 +32,12 @@ struct RSIndex
 
 using ColumnIndexes = std::unordered_map<ColId, RSIndex>;
 
+struct ColumnBloomFilter
+{
+    DataTypePtr type;
+    BloomFilterIndexPtr bloom_filter;
+};
+
+using ColumnBloomFilters = std::unordered_map<ColId, ColumnBloomFilter>;
+
 } // namespace DB::DM
@@ -0,0 +1,172 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeFactory.h>
+#include <IO/Buffer/ReadBufferFromString.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <TiDB/Collation/Collator.h>
+
+namespace DB::DM::tests
+{
+
+namespace
+{
+// Pack 0: [0, 1000), pack 1: [1000, 2000) and a null, pack 2: 5000 which is deleted.
+BloomFilterIndexPtr buildIntIndex()
+{
+    auto index = std::make_shared<BloomFilterIndex>();
+    InferredDataVector<Nullable<Int64>> pack0, pack1;
+    for (Int64 i = 0; i < 1000; ++i)
+    {
+        pack0.emplace_back(i);
+        pack1.emplace_back(i + 1000);
+    }
+    pack1.emplace_back(std::nullopt);
+    index->addPack(*createColumn<Nullable<Int64>>(pack0).column, nullptr);
+    index->addPack(*createColumn<Nullable<Int64>>(pack1).column, nullptr);
+    auto del_mark = createColumn<UInt8>({1}).column;
+    index->addPack(
+        *createColumn<Nullable<Int64>>({5000}).column,
+        static_cast<const ColumnVector<UInt8> *>(del_mark.get()));
+    return index;
+}
+
+RSResults checkIn(const BloomFilterIndex & index, const Fields & values, const String & type = "Nullable(Int64)")
+{
+    RSResults results(index.packCount(), RSResult::Some);
+    index.checkIn(results, 0, values, DataTypeFactory::instance().get(type), nullptr);
+    return results;
+}
+} // namespace
+
+TEST(BloomFilterIndexTest, Integer)
+{
+    auto index = buildIntIndex();
+    ASSERT_EQ(index->packCount(), 3);
+
+    auto results = checkIn(*index, {Field(static_cast<Int64>(500))});
+    ASSERT_EQ(results, RSResults({RSResult::Some, RSResult::NoneNull, RSResult::None}));
+    results = checkIn(*index, {Field(static_cast<UInt64>(1500)), Field(static_cast<Int64>(5000))});
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::Some, RSResult::None}));
+    results = checkIn(*index, {Field(static_cast<Int64>(3)), Field(static_cast<Int64>(1999))});
+    ASSERT_EQ(results, RSResults({RSResult::Some, RSResult::Some, RSResult::None}));
+
+    // NULL never equals to any value.
+    results = checkIn(*index, {Field()});
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::NoneNull, RSResult::None}));
+    // A float value can not be checked by the filter.
+    results = checkIn(*index, {Field(static_cast<Float64>(50000.5))});
+    ASSERT_EQ(results, RSResults(3, RSResult::Some));
+
+    // The packs which are already None are not changed.
+    results = RSResults({RSResult::None, RSResult::AllNull, RSResult::All});
+    index->checkIn(results, 0, {Field(static_cast<Int64>(1000))}, DataTypeFactory::instance().get("Int64"), nullptr);
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::AllNull, RSResult::None}));
+
+    // Check a range of packs.
+    results = RSResults(2, RSResult::Some);
+    index->checkIn(results, 1, {Field(static_cast<Int64>(10))}, DataTypeFactory::instance().get("Int64"), nullptr);
+    ASSERT_EQ(results, RSResults({RSResult::NoneNull, RSResult::None}));
+
+    // The false positive rate should be about 1%.
+    size_t false_positives = 0;
+    for (Int64 v = 10000; v < 20000; ++v)
+        false_positives += checkIn(*index, {Field(v)})[0].isUse();
+    ASSERT_LT(false_positives, 300);
+}
+
+TEST(BloomFilterIndexTest, OutOfRange)
+{
+    BloomFilterIndex index;
+    index.addPack(*createColumn<UInt8>({0, 1, 255}).column, nullptr);
+    ASSERT_EQ(checkIn(index, {Field(static_cast<UInt64>(255))}, "UInt8")[0], RSResult::Some);
+    ASSERT_EQ(checkIn(index, {Field(static_cast<UInt64>(256))}, "UInt8")[0], RSResult::None);
+    ASSERT_EQ(checkIn(index, {Field(static_cast<Int64>(-1))}, "UInt8")[0], RSResult::None);
+
+    BloomFilterIndex signed_index;
+    signed_index.addPack(*createColumn<Int8>({-128, -1, 127}).column, nullptr);
+    ASSERT_EQ(checkIn(signed_index, {Field(static_cast<Int64>(-1))}, "Int8")[0], RSResult::Some);
+    ASSERT_EQ(checkIn(signed_index, {Field(static_cast<UInt64>(127))}, "Int8")[0], RSResult::Some);
+    ASSERT_EQ(checkIn(signed_index, {Field(static_cast<Int64>(-129))}, "Int8")[0], RSResult::None);
+}
+
+TEST(BloomFilterIndexTest, String)
+{
+    BloomFilterIndex index;
+    index.addPack(*createColumn<String>({"abc", "hello world ", ""}).column, nullptr);
+    index.addPack(*createColumn<String>({"xyz"}).column, nullptr);
+    const auto type = DataTypeFactory::instance().get("String");
+    const auto * bin = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_BIN);
+    const auto * ci = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI);
+
+    auto check = [&](const Fields & values, TiDB::TiDBCollatorPtr collator) {
+        RSResults results(index.packCount(), RSResult::Some);
+        index.checkIn(results, 0, values, type, collator);
+        return results;
+    };
+    // The trailing spaces are ignored by the padding collations.
+    ASSERT_EQ(check({Field(String("abc  "))}, bin), RSResults({RSResult::Some, RSResult::None}));
+    ASSERT_EQ(check({Field(String("hello world"))}, bin), RSResults({RSResult::Some, RSResult::None}));
+    ASSERT_EQ(check({Field(String("xyz")), Field(String("abc"))}, bin), RSResults(2, RSResult::Some));
+    ASSERT_EQ(check({Field(String("ABC"))}, bin), RSResults({RSResult::None, RSResult::None}));
+    // Not available for the case insensitive collations.
+    ASSERT_EQ(check({Field(String("ABC"))}, ci), RSResults(2, RSResult::Some));
+    ASSERT_EQ(check({Field(String("ABC"))}, nullptr), RSResults(2, RSResult::Some));
+}
+
+TEST(BloomFilterIndexTest, Serialize)
+{
+    auto index = buildIntIndex();
+    WriteBufferFromOwnString wb;
+    index->write(wb);
+    const auto data = wb.releaseStr();
+
+    ReadBufferFromString rb(data);
+    auto restored = BloomFilterIndex::read(rb, data.size());
+    ASSERT_EQ(restored->packCount(), index->packCount());
+    ASSERT_EQ(restored->byteSize(), index->byteSize());
+    for (Int64 v : {0, 999, 1000, 1999, 5000, 12345})
+        ASSERT_EQ(checkIn(*restored, {Field(v)}), checkIn(*index, {Field(v)})) << v;
+
+    ReadBufferFromString bad_rb(data);
+    ASSERT_THROW(BloomFilterIndex::read(bad_rb, data.size() + 1), Exception);
+}
+
+TEST(BloomFilterIndexTest, RoughCheck)
+{
+    const auto type = DataTypeFactory::instance().get("Nullable(Int64)");
+    const Attr attr{"a", 1, type};
+    RSCheckParam param;
+    param.bloom_filters.emplace(attr.col_id, ColumnBloomFilter{type, buildIntIndex()});
+
+    auto equal = createEqual(attr, Field(static_cast<Int64>(500)));
+    ASSERT_EQ(equal->roughCheck(0, 3, param), RSResults({RSResult::Some, RSResult::NoneNull, RSResult::None}));
+    // The pack with null still needs filtering under `NOT`, because `NOT (NULL = 500)` is NULL.
+    auto not_equal = createNot(equal);
+    ASSERT_EQ(not_equal->roughCheck(0, 3, param), RSResults({RSResult::Some, RSResult::AllNull, RSResult::All}));
+
+    auto in = createIn(attr, {Field(static_cast<Int64>(1)), Field(static_cast<Int64>(7777))});
+    ASSERT_EQ(in->roughCheck(0, 3, param), RSResults({RSResult::Some, RSResult::NoneNull, RSResult::None}));
+
+    // The index is ignored if the column type is changed.
+    const Attr new_attr{"a", 1, DataTypeFactory::instance().get("Nullable(Int32)")};
+    auto new_equal = createEqual(new_attr, Field(static_cast<Int64>(1234)));
+    ASSERT_EQ(new_equal->roughCheck(0, 3, param), RSResults(3, RSResult::Some));
+}
+
+} // namespace DB::DM::tests
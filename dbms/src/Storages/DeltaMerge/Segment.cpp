@@ -3331,13 +3331,21 @@ SkippableBlockInputStreamPtr Segment::getConcatSkippableBlockInputStream(
     const DMFilePackFilterResults & pack_filter_results,
     UInt64 start_ts,
     size_t expected_block_size,
-    ReadTag read_tag)
+    ReadTag read_tag,
+    bool read_string_dictionary,
+    const EncodedFilterPtr & encoded_filter)
 {
     // set `is_fast_scan` to true to try to enable clean read
     auto enable_handle_clean_read = !hasColumn(columns_to_read, MutSup::extra_handle_id);
     constexpr auto is_fast_scan = true;
     auto enable_del_clean_read = !hasColumn(columns_to_read, MutSup::delmark_col_id);
 
+    std::function<void(DMFileBlockInputStreamBuilder &)> additional_builder_opt = nullptr;
+    if (read_string_dictionary || encoded_filter)
+        additional_builder_opt = [read_string_dictionary, encoded_filter](DMFileBlockInputStreamBuilder & builder) {
+            builder.enableStringDictionary(read_string_dictionary).setEncodedFilter(encoded_filter);
+        };
+
     auto stream = segment_snap->stable->getInputStream(
         dm_context,
         columns_to_read,
@@ -3349,7 +3357,8 @@ SkippableBlockInputStreamPtr Segment::getConcatSkippableBlockInputStream(
         pack_filter_results,
         is_fast_scan,
         enable_del_clean_read,
-        /* read_packs */ {});
+        /* read_packs */ {},
+        additional_builder_opt);
 
     auto columns_to_read_ptr = std::make_shared<ColumnDefines>(columns_to_read);
 
@@ -3520,7 +3529,9 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(
         pack_filter_results,
         start_ts,
         expected_block_size,
-        ReadTag::LMFilter);
+        ReadTag::LMFilter,
+        /*read_string_dictionary*/ false,
+        executor->encoded_filter);
 
     if (unlikely(filter_columns->size() == columns_to_read.size()))
     {
@@ -3777,7 +3788,8 @@ BlockInputStreamPtr Segment::getBitmapFilterInputStream(
         pack_filter_results,
         start_ts,
         read_data_block_rows,
-        ReadTag::Query);
+        ReadTag::Query,
+        /*read_string_dictionary*/ dm_context.read_string_dictionary);
     return std::make_shared<BitmapFilterBlockInputStream>(columns_to_read, stream, bitmap_filter);
 }
 
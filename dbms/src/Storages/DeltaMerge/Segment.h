@@ -21,6 +21,7 @@
 #include <Storages/DeltaMerge/DeltaIndex/DeltaIndex.h>
 #include <Storages/DeltaMerge/DeltaIndex/DeltaTree.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/Filter/EncodedFilter.h>
 #include <Storages/DeltaMerge/Filter/RSOperator_fwd.h>
 #include <Storages/DeltaMerge/Index/FullTextIndex/Reader_fwd.h>
 #include <Storages/DeltaMerge/Index/VectorIndex/Reader_fwd.h>
@@ -795,7 +796,9 @@ public:
         const DMFilePackFilterResults & pack_filter_results,
         UInt64 start_ts,
         size_t expected_block_size,
-        ReadTag read_tag);
+        ReadTag read_tag,
+        bool read_string_dictionary = false,
+        const EncodedFilterPtr & encoded_filter = nullptr);
     template <bool is_fast_scan = false>
     BlockInputStreamPtr getBitmapFilterInputStream(
         const DMContext & dm_context,
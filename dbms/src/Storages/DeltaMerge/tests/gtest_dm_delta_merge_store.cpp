@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnDictionaryString.h>
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
 #include <Common/MyTime.h>
@@ -4403,6 +4404,249 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreTest, LMEncodedFilter)
+try
+{
+    auto log = Logger::get(GET_GTEST_FULL_NAME);
+    auto table_column_defines = DMTestEnv::getDefaultColumns();
+    ColumnDefine cd_int(1, "col_int", std::make_shared<DataTypeInt64>());
+    table_column_defines->push_back(cd_int);
+
+    store = reload(table_column_defines);
+
+    // Every pack is compressed into its own lightweight-encoded block
+    constexpr size_t pack_rows = DEFAULT_MERGE_BLOCK_SIZE;
+    auto & global_settings = db_context->getGlobalContext().getSettingsRef();
+    const CompressionMethod origin_compression_method = global_settings.dt_compression_method;
+    global_settings.dt_compression_method = CompressionMethod::Lightweight;
+    SCOPE_EXIT({ global_settings.dt_compression_method = origin_compression_method; });
+    db_context->getSettingsRef().dt_segment_stable_pack_rows = pack_rows;
+
+    // pack 0: two runs of 0 and 200, encoded by RunLength
+    // pack 1: values in [0, 256) including 100, encoded by FOR
+    // pack 2: all 100, encoded by Constant
+    std::vector<Int64> values;
+    for (size_t i = 0; i < pack_rows; ++i)
+        values.push_back(i < pack_rows / 2 ? 0 : 200);
+    for (size_t i = 0; i < pack_rows; ++i)
+        values.push_back((i * 7) % 256);
+    values.resize(3 * pack_rows, 100);
+    auto block = DMTestEnv::prepareSimpleWriteBlock(0, values.size(), false, 1);
+    block.insert(createColumn<Int64>(values, cd_int.name, cd_int.id));
+    store->write(*db_context, db_context->getSettingsRef(), block);
+    store->mergeDeltaAll(*db_context);
+
+    try
+    {
+        DB::registerFunctions();
+    }
+    catch (DB::Exception &)
+    {
+        // Maybe another test has already registered, ignore exception here.
+    }
+
+    const String table_info_json = R"json({
+    "cols":[
+        {"comment":"","default":null,"default_bit":null,"id":1,"name":{"L":"col_int","O":"col_int"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":1,"Flen":20,"Tp":8}}
+    ],
+    "pk_is_handle":false,"index_info":[],"is_common_handle":false,
+    "name":{"L":"t_111","O":"t_111"},"partition":null,
+    "comment":"Mocked.","id":30,"schema_version":-1,"state":0,"tiflash_replica":{"Count":0},"update_timestamp":1636471547239654
+})json";
+
+    auto create_filter = [&](const String & condition, bool enable_encoded_filter) {
+        db_context->getSettingsRef().dt_enable_encoded_filter = enable_encoded_filter;
+        auto filter = generatePushDownExecutor(
+            *db_context,
+            table_info_json,
+            fmt::format("select * from default.t_111 where {}", condition));
+        RUNTIME_CHECK(filter->before_where != nullptr);
+        RUNTIME_CHECK((filter->encoded_filter != nullptr) == enable_encoded_filter);
+        // Drop the rough set filter, so that all the packs are evaluated by the encoded filter.
+        return std::make_shared<PushDownExecutor>(
+            EMPTY_RS_OPERATOR,
+            filter->ann_query_info,
+            filter->fts_query_info,
+            filter->before_where,
+            filter->project_after_where,
+            filter->filter_columns,
+            filter->filter_column_name,
+            filter->extra_cast,
+            filter->columns_after_cast,
+            filter->column_range,
+            filter->encoded_filter);
+    };
+
+    // Return the rows of the blocks that are marked as All, and the values of all the rows.
+    auto read = [&](const PushDownExecutorPtr & executor) {
+        auto in = store->read(
+            *db_context,
+            db_context->getSettingsRef(),
+            store->getTableColumns(),
+            {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+            /* num_streams= */ 1,
+            /* start_ts= */ std::numeric_limits<UInt64>::max(),
+            executor,
+            std::vector<RuntimeFilterPtr>{},
+            0,
+            "",
+            /* keep_order= */ false,
+            /* is_fast_scan= */ false,
+            /* expected_block_size= */ pack_rows)[0];
+        size_t all_match_rows = 0;
+        std::vector<Int64> res;
+        in->readPrefix();
+        while (auto b = in->read())
+        {
+            if (b.getRSResult().allMatch())
+                all_match_rows += b.rows();
+            auto col = b.getByName(cd_int.name).column;
+            if (auto full_col = col->convertToFullColumnIfConst(); full_col)
+                col = full_col;
+            const auto * v = toColumnVectorDataPtr<Int64>(col);
+            RUNTIME_CHECK(v != nullptr);
+            res.insert(res.end(), v->begin(), v->end());
+        }
+        in->readSuffix();
+        return std::make_pair(all_match_rows, res);
+    };
+
+    auto check = [&](const String & condition, auto && pred, size_t expected_all_match_rows) {
+        std::vector<Int64> expected;
+        std::copy_if(values.begin(), values.end(), std::back_inserter(expected), pred);
+
+        LOG_DEBUG(log, "Check condition={}", condition);
+        const auto [all_match_rows, res] = read(create_filter(condition, /*enable_encoded_filter*/ true));
+        ASSERT_EQ(res, expected);
+        ASSERT_EQ(all_match_rows, expected_all_match_rows);
+
+        // The results are the same as evaluating the filter on the decoded packs
+        const auto [normal_all_match_rows, normal_res]
+            = read(create_filter(condition, /*enable_encoded_filter*/ false));
+        ASSERT_EQ(normal_res, expected);
+        ASSERT_EQ(normal_all_match_rows, 0);
+    };
+    SCOPE_EXIT({ db_context->getSettingsRef().dt_enable_encoded_filter = false; });
+
+    // pack 0: None, pack 1: Some, pack 2: All
+    check("col_int = 100", [](Int64 v) { return v == 100; }, pack_rows);
+    // pack 0: All, pack 1: Some, pack 2: None
+    check("col_int != 100", [](Int64 v) { return v != 100; }, pack_rows);
+    // pack 0 and pack 2: None by the first comparison, pack 1: Some
+    check("col_int > 0 and col_int < 100", [](Int64 v) { return v > 0 && v < 100; }, 0);
+    // pack 0: All, pack 1: Some, pack 2: None by the second comparison
+    check("col_int >= 0 and col_int != 100", [](Int64 v) { return v >= 0 && v != 100; }, pack_rows);
+}
+CATCH
+
+TEST_F(DeltaMergeStoreTest, ReadStringDictionary)
+try
+{
+    auto table_column_defines = DMTestEnv::getDefaultColumns();
+    ColumnDefine cd_dict(1, "col_dict", std::make_shared<DataTypeString>());
+    ColumnDefine cd_zero(2, "col_zero", std::make_shared<DataTypeString>());
+    ColumnDefine cd_mixed(3, "col_mixed", std::make_shared<DataTypeString>());
+    table_column_defines->push_back(cd_dict);
+    table_column_defines->push_back(cd_zero);
+    table_column_defines->push_back(cd_mixed);
+
+    store = reload(table_column_defines);
+
+    // Every pack is compressed into its own lightweight-encoded block
+    constexpr size_t pack_rows = DEFAULT_MERGE_BLOCK_SIZE;
+    constexpr size_t pack_count = 3;
+    auto & global_settings = db_context->getGlobalContext().getSettingsRef();
+    const CompressionMethod origin_compression_method = global_settings.dt_compression_method;
+    global_settings.dt_compression_method = CompressionMethod::Lightweight;
+    global_settings.dt_enable_lightweight_string_compression = true;
+    SCOPE_EXIT({
+        global_settings.dt_compression_method = origin_compression_method;
+        global_settings.dt_enable_lightweight_string_compression = false;
+    });
+    db_context->getSettingsRef().dt_segment_stable_pack_rows = pack_rows;
+
+    // col_dict: a few distinct strings in each pack, the packs have different dictionaries
+    // col_zero: a few distinct strings containing '\0', which are split into several tokens by the dictionary
+    // col_mixed: a few distinct strings in pack 0, distinct strings in the other packs which are not dictionary encoded
+    std::mt19937 gen(0);
+    const std::vector<std::vector<String>> pack_values{
+        {"apple", "banana", "cherry", "durian"},
+        {"banana", "cherry", "fig", "grape"},
+        {"apple", "grape", "kiwi", "lemon"}};
+    std::vector<String> dict_values, zero_values, mixed_values;
+    for (size_t pack_id = 0; pack_id < pack_count; ++pack_id)
+    {
+        for (size_t i = 0; i < pack_rows; ++i)
+        {
+            const auto & value = pack_values[pack_id][gen() % pack_values[pack_id].size()];
+            dict_values.push_back(value);
+            zero_values.push_back(value + String(1, '\0') + value);
+            mixed_values.push_back(pack_id == 0 ? value : fmt::format("{}_{}", value, pack_id * pack_rows + i));
+        }
+    }
+    auto block = DMTestEnv::prepareSimpleWriteBlock(0, dict_values.size(), false, 1);
+    block.insert(createColumn<String>(dict_values, cd_dict.name, cd_dict.id));
+    block.insert(createColumn<String>(zero_values, cd_zero.name, cd_zero.id));
+    block.insert(createColumn<String>(mixed_values, cd_mixed.name, cd_mixed.id));
+    store->write(*db_context, db_context->getSettingsRef(), block);
+    store->mergeDeltaAll(*db_context);
+
+    auto in = store->read(
+        *db_context,
+        db_context->getSettingsRef(),
+        {cd_dict, cd_zero, cd_mixed},
+        {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+        /* num_streams= */ 1,
+        /* start_ts= */ std::numeric_limits<UInt64>::max(),
+        EMPTY_FILTER,
+        std::vector<RuntimeFilterPtr>{},
+        0,
+        "",
+        /* keep_order= */ false,
+        /* is_fast_scan= */ false,
+        /* expected_block_size= */ 2 * pack_rows,
+        /* read_segments= */ {},
+        /* extra_table_id_index= */ MutSup::invalid_col_id,
+        /* scan_context= */ nullptr,
+        /* read_string_dictionary= */ true)[0];
+    size_t dict_rows = 0;
+    std::unordered_map<ColId, std::vector<String>> res;
+    in->readPrefix();
+    while (auto b = in->read())
+    {
+        for (const auto & cd : {cd_dict, cd_zero, cd_mixed})
+        {
+            auto col = b.getByName(cd.name).column;
+            const size_t offset = res[cd.id].size();
+            if (const auto * dict_col = typeid_cast<const ColumnDictionaryString *>(col.get()); dict_col)
+            {
+                // col_zero is never read as dictionaries, and col_mixed falls back once a pack after pack 0 is read
+                ASSERT_NE(cd.id, cd_zero.id);
+                if (cd.id == cd_mixed.id)
+                    ASSERT_LE(offset + col->size(), pack_rows);
+                else
+                    dict_rows += col->size();
+                // The dictionaries of the packs are merged, so each distinct string is in the dictionary once
+                std::set<String> distinct_values;
+                for (size_t i = 0; i < col->size(); ++i)
+                    distinct_values.insert(col->getDataAt(i).toString());
+                ASSERT_EQ(dict_col->getDictionary().size(), distinct_values.size());
+                col = col->convertToFullColumnIfConst();
+            }
+            ASSERT_TRUE(typeid_cast<const ColumnString *>(col.get()) != nullptr);
+            for (size_t i = 0; i < col->size(); ++i)
+                res[cd.id].push_back(col->getDataAt(i).toString());
+        }
+    }
+    in->readSuffix();
+    // All the rows of col_dict are read as dictionaries
+    ASSERT_EQ(dict_rows, dict_values.size());
+    ASSERT_EQ(res[cd_dict.id], dict_values);
+    ASSERT_EQ(res[cd_zero.id], zero_values);
+    ASSERT_EQ(res[cd_mixed.id], mixed_values);
+}
+CATCH
+
 TEST_F(DeltaMergeStoreTest, LMAllWithMultiVersionRecords)
 try
 {
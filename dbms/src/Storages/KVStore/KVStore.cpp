@@ -27,6 +27,7 @@
 #include <Storages/KVStore/MultiRaft/Disagg/FastAddPeerContext.h>
 #include <Storages/KVStore/MultiRaft/RegionExecutionResult.h>
 #include <Storages/KVStore/MultiRaft/RegionPersister.h>
+#include <Storages/KVStore/MultiRaft/Spill/RegionSpilledData.h>
 #include <Storages/KVStore/Read/ReadIndexWorker.h>
 #include <Storages/KVStore/Region.h>
 #include <Storages/KVStore/TMTContext.h>
@@ -68,6 +69,9 @@ KVStore::KVStore(Context & context)
     {
         LOG_WARNING(log, "JointThreadInfoJeallocMap is not inited from context");
     }
+    // The spilled data is only valid in memory of the current process, remove the files left by the last run.
+    region_spill_dir = context.getTemporaryPath() + "/region_spill";
+    RegionSpillFile::removeAll(context.getFileProvider(), region_spill_dir);
     fetchProxyConfig(proxy_helper);
 }
 
@@ -194,6 +194,8 @@ public: // Configs
     void reloadConfig(const Poco::Util::AbstractConfiguration & config_file) { config.reloadConfig(config_file, log); }
     const KVStoreConfig & getConfigRef() const { return config; }
     UInt64 getRaftLogEagerGCRows() const { return config.regionEagerGCLogGap(); }
+    // The directory to spill the uncommitted data of Regions
+    const String & getRegionSpillDir() const { return region_spill_dir; }
 
     // debug only
     KVStoreConfig & debugGetConfigMut() { return config; }
@@ -426,6 +428,8 @@ private:
     JointThreadInfoJeallocMapPtr joint_memory_allocation_map;
     size_t maximum_kvstore_memory = 0;
 
+    String region_spill_dir;
+
 #ifdef DBMS_PUBLIC_GTEST
     std::atomic<size_t> debug_memory_limit_warning_count = 0;
 #endif
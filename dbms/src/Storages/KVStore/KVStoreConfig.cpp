@@ -25,6 +25,9 @@ const UInt64 DEFAULT_COMPACT_LOG_BYTES = 32 * 1024 * 1024;
 const UInt64 DEFAULT_COMPACT_LOG_GAP = 200;
 const UInt64 DEFAULT_EAGER_GC_LOG_GAP = 512;
 
+// spilling the uncommitted data of regions is disabled by default
+const UInt64 DEFAULT_REGION_SPILL_THRESHOLD_BYTES = 0;
+
 // default batch-read-index timeout is 10_000ms.
 const uint64_t DEFAULT_BATCH_READ_INDEX_TIMEOUT_MS = 10 * 1000;
 // default wait-index timeout is 5 * 60_000ms.
@@ -39,6 +42,7 @@ KVStoreConfig::KVStoreConfig()
     , region_compact_log_min_bytes(DEFAULT_COMPACT_LOG_BYTES)
     , region_compact_log_gap(DEFAULT_COMPACT_LOG_GAP)
     , region_eager_gc_log_gap(DEFAULT_EAGER_GC_LOG_GAP)
+    , region_spill_threshold_bytes(DEFAULT_REGION_SPILL_THRESHOLD_BYTES)
     , batch_read_index_timeout_ms(DEFAULT_BATCH_READ_INDEX_TIMEOUT_MS)
     , wait_index_timeout_ms(DEFAULT_WAIT_INDEX_TIMEOUT_MS)
     , read_index_worker_tick_ms(DEFAULT_READ_INDEX_WORKER_TICK_MS)
@@ -53,6 +57,7 @@ void KVStoreConfig::reloadConfig(const Poco::Util::AbstractConfiguration & confi
     static constexpr const char * COMPACT_LOG_MIN_BYTES = "flash.compact_log_min_bytes";
     static constexpr const char * COMPACT_LOG_MIN_GAP = "flash.compact_log_min_gap";
     static constexpr const char * EAGER_GC_LOG_GAP = "flash.eager_gc_log_gap";
+    static constexpr const char * REGION_SPILL_THRESHOLD_BYTES = "flash.region_spill_threshold_bytes";
 
     static constexpr const char * BATCH_READ_INDEX_TIMEOUT_MS = "flash.batch_read_index_timeout_ms";
     static constexpr const char * WAIT_INDEX_TIMEOUT_MS = "flash.wait_index_timeout_ms";
@@ -74,6 +79,11 @@ void KVStoreConfig::reloadConfig(const Poco::Util::AbstractConfiguration & confi
             region_compact_log_gap,
             region_eager_gc_log_gap);
     }
+    {
+        region_spill_threshold_bytes
+            = config.getUInt64(REGION_SPILL_THRESHOLD_BYTES, DEFAULT_REGION_SPILL_THRESHOLD_BYTES);
+        LOG_INFO(log, "Region spill threshold, bytes={}", region_spill_threshold_bytes);
+    }
     {
         batch_read_index_timeout_ms
             = config.getUInt64(BATCH_READ_INDEX_TIMEOUT_MS, DEFAULT_BATCH_READ_INDEX_TIMEOUT_MS);
@@ -44,6 +44,14 @@ public: // Flush
     UInt64 regionComactLogGap() const { return region_compact_log_gap.load(std::memory_order_relaxed); }
     UInt64 regionEagerGCLogGap() const { return region_eager_gc_log_gap.load(std::memory_order_relaxed); }
 
+public: // Spill
+    // Spill the uncommitted data of a Region when its in-memory data exceeds this size. "0" means disabled.
+    UInt64 regionSpillThresholdBytes() const { return region_spill_threshold_bytes.load(std::memory_order_relaxed); }
+    void debugSetRegionSpillThreshold(UInt64 bytes)
+    {
+        region_spill_threshold_bytes.store(bytes, std::memory_order_relaxed);
+    }
+
 public: // Raft Read
     UInt64 batchReadIndexTimeout() const { return batch_read_index_timeout_ms.load(std::memory_order_relaxed); }
     // timeout for wait index (ms). "0" means wait infinitely
@@ -68,6 +76,8 @@ private:
     // 0 means eager gc is disabled.
     std::atomic<UInt64> region_eager_gc_log_gap;
 
+    std::atomic<UInt64> region_spill_threshold_bytes;
+
     std::atomic<UInt64> batch_read_index_timeout_ms;
     std::atomic<UInt64> wait_index_timeout_ms;
     std::atomic<UInt64> read_index_worker_tick_ms;
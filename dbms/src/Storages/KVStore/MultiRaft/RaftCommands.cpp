@@ -534,6 +534,12 @@ std::pair<EngineStoreApplyRes, DM::WriteResult> Region::handleWriteRaftCmd(
             }
         }
 
+        // Spill after the committed data is flushed, the remaining default cf is uncommitted.
+        if (default_put_key_count > 0)
+        {
+            maybeSpillUncommittedData(tmt);
+        }
+
         if (!deleting_lock_keys.empty())
         {
             size_t i = 0;
@@ -211,6 +211,12 @@ size_t RegionCFDataBase<Trait>::getSize() const
     return data.size();
 }
 
+template <typename Trait>
+size_t RegionCFDataBase<Trait>::arenaAllocatedBytes() const
+{
+    return data.get_allocator().arenaAllocatedBytes();
+}
+
 template <typename Trait>
 RegionCFDataBase<Trait>::RegionCFDataBase(RegionCFDataBase && region) noexcept
     : data(std::move(region.data))
@@ -86,6 +86,9 @@ struct RegionCFDataBase
 
     size_t getSize() const;
 
+    /// Bytes of the memory held by the arena of the container.
+    size_t arenaAllocatedBytes() const;
+
     RegionCFDataBase() = default;
     RegionCFDataBase(RegionCFDataBase && region) noexcept;
     RegionCFDataBase & operator=(RegionCFDataBase && region) noexcept;
@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <Storages/KVStore/MultiRaft/RegionDataArena.h>
 #include <Storages/KVStore/TiKVHelpers/DecodedLockCFValue.h>
 #include <Storages/KVStore/TiKVHelpers/TiKVRecordFormat.h>
 
 #include <map>
+#include <unordered_map>
 
 namespace DB
 {
@@ -27,7 +29,7 @@ struct RegionWriteCFDataTrait
     using DecodedWriteCFValue = RecordKVFormat::InnerDecodedWriteCFValue;
     using Key = std::pair<RawTiDBPK, Timestamp>;
     using Value = std::tuple<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>, DecodedWriteCFValue>;
-    using Map = std::map<Key, Value>;
+    using Map = std::map<Key, Value, std::less<Key>, RegionDataAllocator<std::pair<const Key, Value>>>;
 
     static std::optional<Map::value_type> genKVPair(TiKVKey && key, const DecodedTiKVKey & raw_key, TiKVValue && value)
     {
@@ -58,7 +60,7 @@ struct RegionDefaultCFDataTrait
 {
     using Key = std::pair<RawTiDBPK, Timestamp>;
     using Value = std::tuple<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>>;
-    using Map = std::map<Key, Value>;
+    using Map = std::map<Key, Value, std::less<Key>, RegionDataAllocator<std::pair<const Key, Value>>>;
 
     static std::optional<Map::value_type> genKVPair(TiKVKey && key, const DecodedTiKVKey & raw_key, TiKVValue && value)
     {
@@ -94,7 +96,12 @@ struct RegionLockCFDataTrait
         std::shared_ptr<const TiKVKey>,
         std::shared_ptr<const TiKVValue>,
         std::shared_ptr<const DecodedLockCFValue>>;
-    using Map = std::unordered_map<Key, Value, Key::Hash>;
+    using Map = std::unordered_map<
+        Key,
+        Value,
+        Key::Hash,
+        std::equal_to<Key>,
+        RegionDataAllocator<std::pair<const Key, Value>>>;
 
     static Map::value_type genKVPair(TiKVKey && key_, TiKVValue && value_)
     {
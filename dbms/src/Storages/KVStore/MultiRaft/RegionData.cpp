@@ -70,6 +70,24 @@ RegionDataMemDiff RegionData::insert(ColumnFamilyType cf, TiKVKey && key, TiKVVa
     }
     case ColumnFamilyType::Default:
     {
+        if unlikely (!spilled_default_cf.empty())
+        {
+            auto raw_key = RecordKVFormat::decodeTiKVKey(key);
+            RegionDefaultCFData::Key spilled_key{RecordKVFormat::getRawTiDBPK(raw_key), RecordKVFormat::getTs(key)};
+            if (auto prev_value = spilled_default_cf.read(spilled_key); prev_value)
+            {
+                // Same as the check in `RegionCFDataBase::insert`
+                if (mode == DupCheck::Deny || *prev_value != value)
+                    throw Exception(
+                        ErrorCodes::LOGICAL_ERROR,
+                        "Found existing spilled key in hex: {} prev_val: {} new_val: {}",
+                        key.toDebugString(),
+                        prev_value->toDebugString(),
+                        value.toDebugString());
+                // Duplicated key is ignored
+                return {};
+            }
+        }
         delta = default_cf.insert(std::move(key), std::move(value), mode);
         break;
     }
@@ -106,6 +124,9 @@ RegionDataMemDiff RegionData::remove(ColumnFamilyType cf, const TiKVKey & key)
         Timestamp ts = RecordKVFormat::getTs(key);
         // removed by gc, may not exist.
         delta = default_cf.remove(RegionDefaultCFData::Key{pk, ts}, true);
+        // Rolled back, the row could be spilled.
+        if (delta.payload == 0 && !spilled_default_cf.empty())
+            removeSpilledDefault(RegionDefaultCFData::Key{pk, ts});
         break;
     }
     case ColumnFamilyType::Lock:
@@ -139,6 +160,10 @@ RegionData::WriteCFIter RegionData::removeDataByWriteIt(const WriteCFIter & writ
             delta.sub(RegionDefaultCFData::calcTotalKVSize(data_it->second));
             map.erase(data_it);
         }
+        else if (!spilled_default_cf.empty())
+        {
+            removeSpilledDefault({pk, decoded_val.prewrite_ts});
+        }
     }
 
     delta.sub(RegionWriteCFData::calcTotalKVSize(write_it->second));
@@ -177,6 +202,8 @@ std::optional<RegionDataReadInfo> RegionData::readDataByWriteIt(
         const auto & map = default_cf.getData();
         if (auto data_it = map.find({pk, decoded_val.prewrite_ts}); data_it != map.end())
             return RegionDataReadInfo{pk, decoded_val.write_type, ts, RegionDefaultCFDataTrait::getTiKVValue(data_it)};
+        else if (auto spilled_value = spilled_default_cf.read({pk, decoded_val.prewrite_ts}); spilled_value)
+            return RegionDataReadInfo{pk, decoded_val.write_type, ts, spilled_value};
         else
         {
             if (!hard_error)
@@ -261,6 +288,7 @@ void RegionData::splitInto(const RegionRange & range, RegionData & new_region_da
     size_changed.add(write_cf.splitInto(range, new_region_data.write_cf));
     // recordMemChange: Remember to track memory here if we have a region-wise metrics later.
     size_changed.add(lock_cf.splitInto(range, new_region_data.lock_cf));
+    size_changed.add(spilled_default_cf.splitInto(range, new_region_data.spilled_default_cf));
     updateMemoryUsage(size_changed);
     new_region_data.updateMemoryUsage(size_changed.negative());
 }
@@ -272,6 +300,7 @@ void RegionData::mergeFrom(const RegionData & ori_region_data)
     size_changed.add(write_cf.mergeFrom(ori_region_data.write_cf));
     // recordMemChange: Remember to track memory here if we have a region-wise metrics later.
     size_changed.add(lock_cf.mergeFrom(ori_region_data.lock_cf));
+    size_changed.add(spilled_default_cf.mergeFrom(ori_region_data.spilled_default_cf));
     updateMemoryUsage(size_changed);
     // `mergeFrom` won't delete from source region. So we don't update it here.
 }
@@ -286,15 +315,50 @@ size_t RegionData::totalSize() const
     return cf_data_size + decoded_data_size;
 }
 
+size_t RegionData::inMemoryDataSize() const
+{
+    return cf_data_size - spilled_default_cf.valueBytes();
+}
+
+size_t RegionData::spillDefaultCF(const FileProviderPtr & file_provider, const String & dir, KeyspaceID keyspace_id)
+{
+    auto spilled_bytes = spilled_default_cf.spill(default_cf.getDataMut(), file_provider, dir, keyspace_id);
+    // The payload is still in this Region, but it no longer consumes memory.
+    recordMemChange(RegionDataMemDiff{-static_cast<Int64>(spilled_bytes), 0});
+    return spilled_bytes;
+}
+
+bool RegionData::removeSpilledDefault(const RegionDefaultCFData::Key & key)
+{
+    auto entry = spilled_default_cf.remove(key);
+    if (!entry)
+        return false;
+    const auto key_size = static_cast<Int64>(entry->key->dataSize());
+    const auto value_size = static_cast<Int64>(entry->value_size);
+    // Only the key is in memory
+    recordMemChange(RegionDataMemDiff{-key_size, 0});
+    updateMemoryUsage(RegionDataMemDiff{-key_size - value_size, 0});
+    return true;
+}
+
+size_t RegionData::arenaAllocatedBytes() const
+{
+    return write_cf.arenaAllocatedBytes() + default_cf.arenaAllocatedBytes() + lock_cf.arenaAllocatedBytes();
+}
+
 void RegionData::assignRegionData(RegionData && rhs)
 {
     auto size = rhs.resetRegionTableCtx();
-    recordMemChange(RegionDataMemDiff{-cf_data_size.load(), -decoded_data_size.load()});
+    recordMemChange(RegionDataMemDiff{
+        -static_cast<Int64>(inMemoryDataSize()),
+        -decoded_data_size.load(),
+    });
     resetMemoryUsage();
 
     default_cf = std::move(rhs.default_cf);
     write_cf = std::move(rhs.write_cf);
     lock_cf = std::move(rhs.lock_cf);
+    spilled_default_cf = std::move(rhs.spilled_default_cf);
     orphan_keys_info = std::move(rhs.orphan_keys_info);
 
     updateMemoryUsage(RegionDataMemDiff{rhs.cf_data_size.load(), rhs.decoded_data_size.load()});
@@ -306,7 +370,11 @@ size_t RegionData::serialize(WriteBuffer & buf) const
 {
     size_t total_size = 0;
 
-    total_size += default_cf.serialize(buf);
+    // The spilled rows are read back and serialized as normal rows of default cf.
+    if (spilled_default_cf.empty())
+        total_size += default_cf.serialize(buf);
+    else
+        total_size += spilled_default_cf.serializeWith(default_cf, buf);
     total_size += write_cf.serialize(buf);
     total_size += lock_cf.serialize(buf);
 
@@ -350,29 +418,40 @@ const RegionLockCFData & RegionData::lockCF() const
     return lock_cf;
 }
 
+const RegionSpilledData & RegionData::spilledDefaultCF() const
+{
+    return spilled_default_cf;
+}
+
 bool RegionData::isEqual(const RegionData & r2) const
 {
     return default_cf == r2.default_cf && write_cf == r2.write_cf && lock_cf == r2.lock_cf
-        && cf_data_size == r2.cf_data_size;
+        && spilled_default_cf == r2.spilled_default_cf && cf_data_size == r2.cf_data_size;
 }
 
 RegionData::RegionData(RegionData && data) noexcept
     : write_cf(std::move(data.write_cf))
     , default_cf(std::move(data.default_cf))
     , lock_cf(std::move(data.lock_cf))
+    , spilled_default_cf(std::move(data.spilled_default_cf))
     , cf_data_size(data.cf_data_size.load())
     , decoded_data_size(data.decoded_data_size.load())
 {}
 
 RegionData::~RegionData()
 {
-    recordMemChange(RegionDataMemDiff{-cf_data_size, 0});
+    recordMemChange(RegionDataMemDiff{-static_cast<Int64>(inMemoryDataSize()), 0});
     updateMemoryUsage(RegionDataMemDiff{-cf_data_size, 0});
 }
 
 String RegionData::summary() const
 {
-    return fmt::format("write:{},lock:{},default:{}", write_cf.getSize(), lock_cf.getSize(), default_cf.getSize());
+    return fmt::format(
+        "write:{},lock:{},default:{},spilled_default:{}",
+        write_cf.getSize(),
+        lock_cf.getSize(),
+        default_cf.getSize(),
+        spilled_default_cf.size());
 }
 
 size_t RegionData::tryCompactionFilter(Timestamp safe_point)
@@ -390,7 +469,8 @@ size_t RegionData::tryCompactionFilter(Timestamp safe_point)
         {
             if (!decoded_val.short_value)
             {
-                if (auto data_it = default_map.find({pk, decoded_val.prewrite_ts}); data_it == default_map.end())
+                if (auto data_it = default_map.find({pk, decoded_val.prewrite_ts});
+                    data_it == default_map.end() && !spilled_default_cf.contains({pk, decoded_val.prewrite_ts}))
                 {
                     // if key-val in write cf can not find matched data in default cf and its commit-ts < gc-safe-point, we can clean it safely.
                     if (ts < safe_point)
@@ -416,7 +496,8 @@ void RegionData::setRegionTableCtx(RegionTableCtxPtr ctx) const
     region_table_ctx = ctx;
     if (region_table_ctx)
     {
-        region_table_ctx->table_size.fetch_add(dataSize());
+        // The spilled values are not counted in `table_size`, see `spillDefaultCF`.
+        region_table_ctx->table_size.fetch_add(inMemoryDataSize());
     }
 }
 
@@ -429,7 +510,7 @@ RegionTableCtxPtr RegionData::resetRegionTableCtx() const
 {
     if (region_table_ctx)
     {
-        region_table_ctx->table_size.fetch_sub(dataSize());
+        region_table_ctx->table_size.fetch_sub(inMemoryDataSize());
     }
     auto prev = region_table_ctx;
     // The region no longer binds to a table.
@@ -18,6 +18,7 @@
 #include <Storages/KVStore/Decode/RegionTable_fwd.h>
 #include <Storages/KVStore/MultiRaft/RegionCFDataBase.h>
 #include <Storages/KVStore/MultiRaft/RegionCFDataTrait.h>
+#include <Storages/KVStore/MultiRaft/Spill/RegionSpilledData.h>
 
 namespace DB
 {
@@ -60,6 +61,13 @@ public:
     // Reflects most of bytes of memory currently occupied by this object.
     // It is `dataSize()` and the decoded data cached.
     size_t totalSize() const;
+    // Bytes of the memory held by the arenas of the containers of all CFs.
+    size_t arenaAllocatedBytes() const;
+    // `dataSize()` without the values spilled to disk.
+    size_t inMemoryDataSize() const;
+
+    // Move the values of default cf into spill files under `dir`. Return the bytes of values spilled.
+    size_t spillDefaultCF(const FileProviderPtr & file_provider, const String & dir, KeyspaceID keyspace_id);
 
     size_t serialize(WriteBuffer & buf) const;
     static void deserialize(ReadBuffer & buf, RegionData & region_data);
@@ -73,6 +81,7 @@ public:
     const RegionWriteCFData & writeCF() const;
     const RegionDefaultCFData & defaultCF() const;
     const RegionLockCFData & lockCF() const;
+    const RegionSpilledData & spilledDefaultCF() const;
 
     RegionData() = default;
     ~RegionData();
@@ -132,6 +141,9 @@ private:
     void updateMemoryUsage(const RegionDataMemDiff &);
     void resetMemoryUsage();
 
+    // Remove a spilled row of default cf, return false if it is not spilled.
+    bool removeSpilledDefault(const RegionDefaultCFData::Key & key);
+
 private:
     friend class Region;
 
@@ -139,9 +151,11 @@ private:
     RegionWriteCFData write_cf;
     RegionDefaultCFData default_cf;
     RegionLockCFData lock_cf;
+    // The rows of default cf whose values are spilled to disk, they are not in `default_cf`.
+    RegionSpilledData spilled_default_cf;
     OrphanKeysInfo orphan_keys_info;
 
-    // Size of 3 cfs, reflects size of real payload flows to KVStore.
+    // Size of 3 cfs, reflects size of real payload flows to KVStore. The spilled data is included.
     std::atomic<Int64> cf_data_size = 0;
     // Size of decoded structures for convenient access, considered as amplification in memory.
     std::atomic<Int64> decoded_data_size = 0;
@@ -0,0 +1,215 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/TiFlashMetrics.h>
+#include <Storages/KVStore/MultiRaft/RegionDataArena.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace DB
+{
+namespace
+{
+size_t roundUpToAlignment(size_t size)
+{
+    return (size + RegionDataArena::node_alignment - 1) / RegionDataArena::node_alignment
+        * RegionDataArena::node_alignment;
+}
+} // namespace
+
+RegionDataArena::~RegionDataArena()
+{
+    for (const auto & chunk : chunks)
+        Allocator::free(chunk.begin, chunk.size);
+    GET_METRIC(tiflash_raft_region_data_arena_bytes, type_allocated).Decrement(allocated_bytes);
+}
+
+RegionDataArena::FreeList * RegionDataArena::getFreeList(size_t size)
+{
+    for (auto & free_list : free_lists)
+    {
+        if (free_list.size == size)
+            return &free_list;
+        if (free_list.size == 0)
+        {
+            free_list.size = size;
+            return &free_list;
+        }
+    }
+    return nullptr;
+}
+
+void * RegionDataArena::alloc(size_t size)
+{
+    size = roundUpToAlignment(size);
+    auto * free_list = size <= max_node_size ? getFreeList(size) : nullptr;
+    if (free_list == nullptr)
+        return Allocator::alloc(size);
+
+    used_bytes += size;
+    if (free_list->head != nullptr)
+    {
+        auto * node = free_list->head;
+        free_list->head = node->next;
+        addUsed(findChunk(node), size);
+        return node;
+    }
+
+    if (static_cast<size_t>(end - pos) < size)
+        addChunk(size);
+    auto * res = pos;
+    pos += size;
+    addUsed(current, size);
+    return res;
+}
+
+void RegionDataArena::free(void * ptr, size_t size)
+{
+    size = roundUpToAlignment(size);
+    auto * free_list = size <= max_node_size ? getFreeList(size) : nullptr;
+    if (free_list == nullptr)
+        return Allocator::free(ptr, size);
+
+    auto * node = static_cast<FreeNode *>(ptr);
+    node->next = free_list->head;
+    free_list->head = node;
+
+    used_bytes -= size;
+    if (used_bytes == 0)
+        return releaseChunks();
+
+    const auto chunk_idx = findChunk(ptr);
+    auto & chunk = chunks[chunk_idx];
+    chunk.used -= size;
+    if (chunk.used == 0 && chunk_idx != current)
+    {
+        empty_chunk_bytes += chunk.size;
+        // Walking the free lists costs about the same as the allocated bytes, so only do it when a
+        // considerable part of them can be returned.
+        if (empty_chunk_bytes >= allocated_bytes / 4)
+            releaseEmptyChunks();
+    }
+}
+
+size_t RegionDataArena::findChunk(const void * ptr) const
+{
+    // The last chunk beginning at or before `ptr`.
+    auto iter = std::upper_bound(
+        chunks.begin(),
+        chunks.end(),
+        static_cast<const char *>(ptr),
+        [](const char * p, const Chunk & chunk) { return std::less<const char *>()(p, chunk.begin); });
+    assert(iter != chunks.begin());
+    return iter - chunks.begin() - 1;
+}
+
+void RegionDataArena::addUsed(size_t chunk_idx, size_t size)
+{
+    auto & chunk = chunks[chunk_idx];
+    if (chunk.used == 0 && chunk_idx != current)
+        empty_chunk_bytes -= chunk.size;
+    chunk.used += size;
+}
+
+void RegionDataArena::addChunk(size_t min_size)
+{
+    size_t chunk_size = chunks.empty() ? initial_chunk_size : std::min(chunks[current].size * 2, max_chunk_size);
+    chunk_size = std::max(chunk_size, min_size);
+    if (!chunks.empty() && chunks[current].used == 0)
+        empty_chunk_bytes += chunks[current].size;
+    // The remaining space of the current chunk is dropped, it is less than one node.
+    Chunk chunk{static_cast<char *>(Allocator::alloc(chunk_size)), chunk_size};
+    auto iter = std::upper_bound(chunks.begin(), chunks.end(), chunk.begin, [](const char * p, const Chunk & c) {
+        return std::less<const char *>()(p, c.begin);
+    });
+    iter = chunks.insert(iter, chunk);
+    current = iter - chunks.begin();
+    pos = chunk.begin;
+    end = pos + chunk_size;
+    allocated_bytes += chunk_size;
+    GET_METRIC(tiflash_raft_region_data_arena_bytes, type_allocated).Increment(chunk_size);
+}
+
+void RegionDataArena::releaseChunks()
+{
+    // All nodes are released. Keep the current chunk for the following writes and return the others,
+    // so that a Region whose data has been flushed doesn't hold the memory of its peak size.
+    size_t released_bytes = 0;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (i == current)
+            continue;
+        Allocator::free(chunks[i].begin, chunks[i].size);
+        released_bytes += chunks[i].size;
+    }
+    if (!chunks.empty())
+    {
+        auto chunk = chunks[current];
+        chunk.used = 0;
+        chunks.assign(1, chunk);
+        current = 0;
+        pos = chunk.begin;
+        end = pos + chunk.size;
+    }
+    for (auto & free_list : free_lists)
+        free_list.head = nullptr;
+
+    allocated_bytes -= released_bytes;
+    empty_chunk_bytes = 0;
+    GET_METRIC(tiflash_raft_region_data_arena_bytes, type_allocated).Decrement(released_bytes);
+}
+
+void RegionDataArena::releaseEmptyChunks()
+{
+    // Some nodes are still in use, e.g. the locks and the uncommitted values, return the chunks
+    // without any node in use. Their free nodes must be dropped from the free lists first.
+    const size_t current_idx = current;
+    auto is_empty = [&](size_t chunk_idx) {
+        return chunks[chunk_idx].used == 0 && chunk_idx != current_idx;
+    };
+    for (auto & free_list : free_lists)
+    {
+        FreeNode ** link = &free_list.head;
+        while (*link != nullptr)
+        {
+            if (is_empty(findChunk(*link)))
+                *link = (*link)->next;
+            else
+                link = &(*link)->next;
+        }
+    }
+
+    size_t released_bytes = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (is_empty(i))
+        {
+            Allocator::free(chunks[i].begin, chunks[i].size);
+            released_bytes += chunks[i].size;
+            continue;
+        }
+        if (i == current_idx)
+            current = kept;
+        chunks[kept++] = chunks[i];
+    }
+    chunks.resize(kept);
+
+    allocated_bytes -= released_bytes;
+    empty_chunk_bytes = 0;
+    GET_METRIC(tiflash_raft_region_data_arena_bytes, type_allocated).Decrement(released_bytes);
+}
+
+} // namespace DB
@@ -0,0 +1,173 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Allocator.h>
+#include <common/types.h>
+
+#include <boost/noncopyable.hpp>
+#include <memory>
+#include <vector>
+
+namespace DB
+{
+/**
+ * A memory pool for the nodes of the containers in one CF of a Region.
+ *
+ * Every raft row costs a node of the map in `RegionCFDataBase`. Allocating them one by one from
+ * the global allocator makes applying raft logs slower and spreads the nodes of a Region all over
+ * the heap. The nodes are carved from large chunks owned by the Region instead, and the released
+ * nodes are kept in free lists of the exact node size for reuse.
+ * Each chunk counts the bytes of its nodes in use. Once the chunks without any node in use make up
+ * a quarter of the arena, e.g. most of the committed data is flushed to the storage while some locks
+ * are still there, they are returned in a batch. All chunks except the current one are returned
+ * directly once all rows are removed.
+ *
+ * Not thread-safe. It shares the same protection with the container it serves, that is, the lock
+ * of the Region.
+ */
+class RegionDataArena
+    : private Allocator<false>
+    , private boost::noncopyable
+{
+public:
+    /// Larger allocations are forwarded to the global allocator.
+    static constexpr size_t max_node_size = 512;
+    static constexpr size_t node_alignment = 16;
+
+    RegionDataArena() = default;
+    ~RegionDataArena();
+
+    void * alloc(size_t size);
+    void free(void * ptr, size_t size);
+
+    /// Bytes of the chunks held by this arena.
+    size_t allocatedBytes() const { return allocated_bytes; }
+    /// Bytes of the nodes in use.
+    size_t usedBytes() const { return used_bytes; }
+
+private:
+    struct FreeNode
+    {
+        FreeNode * next;
+    };
+
+    struct FreeList
+    {
+        size_t size = 0;
+        FreeNode * head = nullptr;
+    };
+
+    struct Chunk
+    {
+        char * begin;
+        size_t size;
+        // Bytes of the nodes in use.
+        size_t used = 0;
+    };
+
+    FreeList * getFreeList(size_t size);
+    // Return the index of the chunk containing `ptr`.
+    size_t findChunk(const void * ptr) const;
+    void addUsed(size_t chunk_idx, size_t size);
+    void addChunk(size_t min_size);
+    void releaseChunks();
+    void releaseEmptyChunks();
+
+    static constexpr size_t initial_chunk_size = 4096;
+    static constexpr size_t max_chunk_size = 256 * 1024;
+
+    /// A container allocates only one or two kinds of nodes, e.g. the node of `std::map`,
+    /// or the node and the cached hash of `std::unordered_map`.
+    static constexpr size_t max_free_lists = 4;
+    FreeList free_lists[max_free_lists];
+
+    // Sorted by address. The nodes are carved from `chunks[current]`.
+    std::vector<Chunk> chunks;
+    size_t current = 0;
+    char * pos = nullptr;
+    char * end = nullptr;
+
+    size_t allocated_bytes = 0;
+    size_t used_bytes = 0;
+    // Bytes of the chunks without any node in use, except the current one.
+    size_t empty_chunk_bytes = 0;
+};
+
+/**
+ * A stateful allocator that allocates single objects from a `RegionDataArena`, and the others,
+ * e.g. the bucket array of `std::unordered_map`, from the global allocator.
+ *
+ * The arena is created lazily on the first allocation, so a default constructed or moved-from
+ * container doesn't cost anything. Each container owns its arena: the copy of a container gets
+ * a new one, and the arena is moved or swapped along with the container.
+ */
+template <typename T>
+class RegionDataAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    static_assert(alignof(T) <= RegionDataArena::node_alignment);
+
+    RegionDataAllocator() noexcept = default;
+
+    template <typename U>
+    RegionDataAllocator(const RegionDataAllocator<U> & other) noexcept // NOLINT(google-explicit-constructor)
+        : arena(other.arena)
+    {}
+
+    T * allocate(size_t n)
+    {
+        if (n != 1)
+            return std::allocator<T>().allocate(n);
+        if (!arena)
+            arena = std::make_shared<RegionDataArena>();
+        return static_cast<T *>(arena->alloc(sizeof(T)));
+    }
+
+    void deallocate(T * p, size_t n)
+    {
+        if (n != 1)
+            return std::allocator<T>().deallocate(p, n);
+        arena->free(p, sizeof(T));
+    }
+
+    RegionDataAllocator select_on_container_copy_construction() const { return {}; }
+
+    size_t arenaAllocatedBytes() const { return arena ? arena->allocatedBytes() : 0; }
+    size_t arenaUsedBytes() const { return arena ? arena->usedBytes() : 0; }
+
+    template <typename U>
+    bool operator==(const RegionDataAllocator<U> & other) const
+    {
+        return arena == other.arena;
+    }
+    template <typename U>
+    bool operator!=(const RegionDataAllocator<U> & other) const
+    {
+        return arena != other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class RegionDataAllocator;
+
+    std::shared_ptr<RegionDataArena> arena;
+};
+
+} // namespace DB
@@ -0,0 +1,290 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/TiFlashMetrics.h>
+#include <IO/BaseFile/WriteReadableFile.h>
+#include <IO/FileProvider/FileProvider.h>
+#include <IO/WriteHelpers.h>
+#include <Poco/File.h>
+#include <Storages/KVStore/MultiRaft/Spill/RegionSpilledData.h>
+#include <Storages/Page/PageUtil.h>
+
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+
+namespace DB
+{
+RegionSpillFile::RegionSpillFile(const FileProviderPtr & file_provider_, const String & dir, KeyspaceID keyspace_id_)
+    : file_provider(file_provider_)
+    , keyspace_id(keyspace_id_)
+{
+    static std::atomic<UInt64> spill_file_seq = 0;
+    Poco::File(dir).createDirectories();
+    path = fmt::format("{}/region_spill_{}", dir, spill_file_seq.fetch_add(1));
+    file = file_provider->newWriteReadableFile(path, EncryptionPath(path, "", keyspace_id));
+}
+
+RegionSpillFile::~RegionSpillFile()
+{
+    try
+    {
+        file->close();
+        file_provider->deleteRegularFile(path, EncryptionPath(path, "", keyspace_id));
+    }
+    catch (...)
+    {
+        tryLogCurrentException(__PRETTY_FUNCTION__);
+    }
+}
+
+UInt64 RegionSpillFile::append(std::string_view data)
+{
+    const auto offset = file_size;
+    PageUtil::writeFile(
+        file,
+        offset,
+        const_cast<char *>(data.data()),
+        data.size(),
+        /*write_limiter*/ nullptr,
+        /*background*/ false,
+        /*truncate_if_failed*/ false);
+    file_size += data.size();
+    return offset;
+}
+
+String RegionSpillFile::read(UInt64 offset, size_t size) const
+{
+    String res(size, '\0');
+    read(offset, res.data(), size);
+    return res;
+}
+
+void RegionSpillFile::read(UInt64 offset, char * to, size_t size) const
+{
+    PageUtil::readFile(file, offset, to, size);
+}
+
+void RegionSpillFile::removeAll(const FileProviderPtr & file_provider, const String & dir)
+{
+    file_provider->deleteDirectory(dir, /*dir_path_as_encryption_path*/ false, /*recursive*/ true);
+}
+
+RegionSpilledData::~RegionSpilledData()
+{
+    updateValueBytes(-static_cast<Int64>(value_bytes));
+}
+
+RegionSpilledData::RegionSpilledData(RegionSpilledData && other) noexcept
+    : data(std::move(other.data))
+    , value_bytes(std::exchange(other.value_bytes, 0))
+    , current_file(std::move(other.current_file))
+{}
+
+RegionSpilledData & RegionSpilledData::operator=(RegionSpilledData && other) noexcept
+{
+    updateValueBytes(-static_cast<Int64>(value_bytes));
+    data = std::move(other.data);
+    value_bytes = std::exchange(other.value_bytes, 0);
+    current_file = std::move(other.current_file);
+    return *this;
+}
+
+void RegionSpilledData::updateValueBytes(Int64 delta)
+{
+    value_bytes += delta;
+    if (delta > 0)
+        GET_METRIC(tiflash_raft_spilled_bytes, type_default_cf).Increment(delta);
+    else if (delta < 0)
+        GET_METRIC(tiflash_raft_spilled_bytes, type_default_cf).Decrement(-delta);
+}
+
+size_t RegionSpilledData::spill(
+    RegionDefaultCFDataTrait::Map & default_cf,
+    const FileProviderPtr & file_provider,
+    const String & dir,
+    KeyspaceID keyspace_id)
+{
+    size_t spilled_bytes = 0;
+    String buffer;
+    std::vector<RegionDefaultCFDataTrait::Map::iterator> batch;
+    auto flush_batch = [&] {
+        if (batch.empty())
+            return;
+        if (!current_file || current_file->size() >= max_spill_file_size)
+            current_file = std::make_shared<RegionSpillFile>(file_provider, dir, keyspace_id);
+        auto offset = current_file->append(buffer);
+        for (const auto & it : batch)
+        {
+            const auto & [key, value] = *it;
+            const auto value_size = std::get<1>(value)->dataSize();
+            auto [_, inserted] = data.emplace(key, Entry{std::get<0>(value), current_file, offset, value_size});
+            RUNTIME_CHECK_MSG(inserted, "Spill duplicated key {}", std::get<0>(value)->toDebugString());
+            offset += value_size;
+            spilled_bytes += value_size;
+            default_cf.erase(it);
+        }
+        updateValueBytes(buffer.size());
+        GET_METRIC(tiflash_raft_process_keys, type_default_spill).Increment(batch.size());
+        buffer.clear();
+        batch.clear();
+    };
+
+    // Write the values in batches, so that the file is written by large IOs, and no more than
+    // one batch of values is copied in memory.
+    // The batched rows are erased by `flush_batch`, so advance the iterator before it.
+    for (auto it = default_cf.begin(); it != default_cf.end();)
+    {
+        auto cur = it++;
+        const auto & value = std::get<1>(cur->second);
+        buffer.append(value->data(), value->dataSize());
+        batch.push_back(cur);
+        if (buffer.size() >= spill_batch_size)
+            flush_batch();
+    }
+    flush_batch();
+    return spilled_bytes;
+}
+
+std::shared_ptr<const TiKVValue> RegionSpilledData::read(const Key & key) const
+{
+    auto it = data.find(key);
+    if (it == data.end())
+        return nullptr;
+    const auto & entry = it->second;
+    GET_METRIC(tiflash_raft_process_keys, type_spilled_read).Increment(1);
+    return std::make_shared<const TiKVValue>(entry.file->read(entry.offset, entry.value_size));
+}
+
+std::optional<RegionSpilledData::Entry> RegionSpilledData::remove(const Key & key)
+{
+    auto it = data.find(key);
+    if (it == data.end())
+        return std::nullopt;
+    auto entry = std::move(it->second);
+    data.erase(it);
+    updateValueBytes(-static_cast<Int64>(entry.value_size));
+    // No more rows need the current file, close and remove it.
+    if (data.empty())
+        current_file = nullptr;
+    return entry;
+}
+
+RegionDataMemDiff RegionSpilledData::splitInto(const RegionRange & range, RegionSpilledData & new_region_data)
+{
+    const auto & [start_key, end_key] = range;
+    RegionDataMemDiff res;
+    for (auto it = data.begin(); it != data.end();)
+    {
+        const auto & entry = it->second;
+        if (start_key.compare(*entry.key) <= 0 && end_key.compare(*entry.key) > 0)
+        {
+            const auto value_size = static_cast<Int64>(entry.value_size);
+            res.sub(RegionDataMemDiff{static_cast<Int64>(entry.key->dataSize()) + value_size, 0});
+            updateValueBytes(-value_size);
+            new_region_data.updateValueBytes(value_size);
+            new_region_data.data.insert(std::move(*it));
+            it = data.erase(it);
+        }
+        else
+            ++it;
+    }
+    if (data.empty())
+        current_file = nullptr;
+    return res;
+}
+
+RegionDataMemDiff RegionSpilledData::mergeFrom(const RegionSpilledData & ori_region_data)
+{
+    RegionDataMemDiff res;
+    for (const auto & [key, entry] : ori_region_data.data)
+    {
+        auto [_, inserted] = data.emplace(key, entry);
+        RUNTIME_CHECK_MSG(inserted, "Merge duplicated spilled key {}", entry.key->toDebugString());
+        const auto value_size = static_cast<Int64>(entry.value_size);
+        res.add(RegionDataMemDiff{static_cast<Int64>(entry.key->dataSize()) + value_size, 0});
+        updateValueBytes(value_size);
+    }
+    return res;
+}
+
+size_t RegionSpilledData::serializeWith(
+    const RegionCFDataBase<RegionDefaultCFDataTrait> & default_cf,
+    WriteBuffer & buf) const
+{
+    size_t total_size = 0;
+    size_t size = default_cf.getSize() + data.size();
+    total_size += writeBinary2(size, buf);
+
+    for (const auto & [key, value] : default_cf.getData())
+    {
+        total_size += std::get<0>(value)->serialize(buf);
+        total_size += std::get<1>(value)->serialize(buf);
+    }
+
+    // The spill files are removed on restart, so the values are persisted rather than their offsets.
+    // Read the values in the order of the files, so that the contiguous values are read by one IO into
+    // a reused buffer, and no more than one batch of values is copied besides `buf`.
+    std::vector<const Entry *> entries;
+    entries.reserve(data.size());
+    for (const auto & [key, entry] : data)
+        entries.push_back(&entry);
+    std::sort(entries.begin(), entries.end(), [](const Entry * lhs, const Entry * rhs) {
+        return std::tie(lhs->file, lhs->offset) < std::tie(rhs->file, rhs->offset);
+    });
+
+    String buffer;
+    for (size_t begin = 0; begin < entries.size();)
+    {
+        const auto & file = entries[begin]->file;
+        const auto batch_offset = entries[begin]->offset;
+        auto batch_end = batch_offset + entries[begin]->value_size;
+        size_t end = begin + 1;
+        for (; end < entries.size() && entries[end]->file == file && entries[end]->offset == batch_end
+             && batch_end - batch_offset < spill_batch_size;
+             ++end)
+            batch_end += entries[end]->value_size;
+
+        buffer.resize(batch_end - batch_offset);
+        file->read(batch_offset, buffer.data(), buffer.size());
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto & entry = *entries[i];
+            total_size += entry.key->serialize(buf);
+            // The same format as `TiKVValue::serialize`
+            total_size += writeBinary2(static_cast<UInt32>(entry.value_size), buf);
+            buf.write(buffer.data() + (entry.offset - batch_offset), entry.value_size);
+            total_size += entry.value_size;
+        }
+        begin = end;
+    }
+    return total_size;
+}
+
+bool RegionSpilledData::operator==(const RegionSpilledData & other) const
+{
+    if (data.size() != other.data.size())
+        return false;
+    for (const auto & [key, entry] : data)
+    {
+        auto it = other.data.find(key);
+        if (it == other.data.end() || *entry.key != *it->second.key
+            || entry.file->read(entry.offset, entry.value_size)
+                != it->second.file->read(it->second.offset, it->second.value_size))
+            return false;
+    }
+    return true;
+}
+
+} // namespace DB
@@ -0,0 +1,128 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <IO/BaseFile/fwd.h>
+#include <IO/FileProvider/FileProvider_fwd.h>
+#include <Storages/KVStore/MultiRaft/RegionCFDataBase.h>
+#include <Storages/KVStore/MultiRaft/RegionCFDataTrait.h>
+#include <Storages/KVStore/Types.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace DB
+{
+class WriteBuffer;
+
+/// A local file holding the values of the rows spilled from a Region. It is written through
+/// the FileProvider, so the data is encrypted as other files if encryption is enabled.
+/// The file is removed once all rows in it are removed from the Region.
+class RegionSpillFile : private boost::noncopyable
+{
+public:
+    RegionSpillFile(const FileProviderPtr & file_provider_, const String & dir, KeyspaceID keyspace_id);
+    ~RegionSpillFile();
+
+    /// Append `data` to the end of the file and return its offset.
+    /// Only the owner Region appends to the file, under the write lock of the Region.
+    UInt64 append(std::string_view data);
+
+    /// It is safe to read concurrently.
+    String read(UInt64 offset, size_t size) const;
+    void read(UInt64 offset, char * to, size_t size) const;
+
+    UInt64 size() const { return file_size; }
+
+    /// Remove the files left by the last run.
+    static void removeAll(const FileProviderPtr & file_provider, const String & dir);
+
+private:
+    FileProviderPtr file_provider;
+    String path;
+    KeyspaceID keyspace_id;
+    WriteReadableFilePtr file;
+    UInt64 file_size = 0;
+};
+
+using RegionSpillFilePtr = std::shared_ptr<RegionSpillFile>;
+
+/// The rows of the default cf spilled from the memory of a Region.
+///
+/// The default cf holds the prewritten values of uncommitted transactions. They can't be flushed
+/// to the storage before committed, so a large transaction keeps all its values in memory.
+/// When the in-memory data of a Region exceeds a threshold, the values are moved into a spill
+/// file and only the keys are kept in memory. A value is read back from the file when its
+/// transaction commits, and the row is dropped when it is committed or rolled back.
+class RegionSpilledData
+{
+public:
+    using Key = RegionDefaultCFDataTrait::Key;
+
+    struct Entry
+    {
+        std::shared_ptr<const TiKVKey> key;
+        RegionSpillFilePtr file;
+        UInt64 offset;
+        UInt64 value_size;
+    };
+    using Map = std::map<Key, Entry>;
+
+    RegionSpilledData() = default;
+    ~RegionSpilledData();
+    RegionSpilledData(RegionSpilledData && other) noexcept;
+    RegionSpilledData & operator=(RegionSpilledData && other) noexcept;
+
+    /// Move all rows of `default_cf` into a spill file under `dir`. Return the bytes of values spilled.
+    size_t spill(
+        RegionDefaultCFDataTrait::Map & default_cf,
+        const FileProviderPtr & file_provider,
+        const String & dir,
+        KeyspaceID keyspace_id);
+
+    bool contains(const Key & key) const { return data.contains(key); }
+    /// Return nullptr if the row is not spilled.
+    std::shared_ptr<const TiKVValue> read(const Key & key) const;
+    std::optional<Entry> remove(const Key & key);
+
+    /// The spill files are shared by the Regions after split or merge.
+    RegionDataMemDiff splitInto(const RegionRange & range, RegionSpilledData & new_region_data);
+    RegionDataMemDiff mergeFrom(const RegionSpilledData & ori_region_data);
+
+    /// Serialize the rows in `default_cf` and the spilled rows in the format of `RegionCFDataBase::serialize`.
+    /// The spilled values are read back in batches of `spill_batch_size`, and written to `buf` one batch at a time.
+    size_t serializeWith(const RegionCFDataBase<RegionDefaultCFDataTrait> & default_cf, WriteBuffer & buf) const;
+
+    bool operator==(const RegionSpilledData & other) const;
+
+    bool empty() const { return data.empty(); }
+    size_t size() const { return data.size(); }
+    /// Bytes of the values in spill files.
+    size_t valueBytes() const { return value_bytes; }
+
+    const Map & getData() const { return data; }
+
+private:
+    void updateValueBytes(Int64 delta);
+
+    static constexpr UInt64 max_spill_file_size = 64 * 1024 * 1024;
+    static constexpr size_t spill_batch_size = 4 * 1024 * 1024;
+
+    Map data;
+    size_t value_bytes = 0;
+    // The file to append to. Other files are only referenced by the entries.
+    RegionSpillFilePtr current_file;
+};
+
+} // namespace DB
@@ -16,6 +16,7 @@
 #include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
+#include <Interpreters/Context.h>
 #include <Storages/DeltaMerge/DeltaMergeInterfaces.h>
 #include <Storages/KVStore/Decode/TiKVRange.h>
 #include <Storages/KVStore/FFI/ProxyFFI.h>
@@ -220,6 +221,8 @@ std::string Region::dataInfo() const
         buff.fmtAppend("lock {} ", lock_size);
     if (default_size)
         buff.fmtAppend("default {} ", default_size);
+    if (auto spilled_size = data.spilledDefaultCF().size(); spilled_size)
+        buff.fmtAppend("spilled_default {} ", spilled_size);
     buff.append("]");
     return buff.toString();
 }
@@ -446,4 +449,32 @@ void Region::resetWarnMemoryLimitByTable() const
     setRegionTableWarned(false);
 }
 
+void Region::maybeSpillUncommittedData(TMTContext & tmt)
+{
+    const auto & kvstore = tmt.getKVStore();
+    const auto threshold = kvstore->getConfigRef().regionSpillThresholdBytes();
+    if (threshold == 0)
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    const auto in_memory_size = data.inMemoryDataSize();
+    // The write cf and lock cf are not spilled. Wait until enough new data comes in, so that
+    // the region won't spill a few rows after each write when they are large.
+    if (in_memory_size < threshold || in_memory_size < in_memory_size_after_spill + threshold / 2)
+        return;
+
+    Stopwatch watch;
+    auto spilled_bytes
+        = data.spillDefaultCF(tmt.getContext().getFileProvider(), kvstore->getRegionSpillDir(), keyspace_id);
+    in_memory_size_after_spill = data.inMemoryDataSize();
+    LOG_INFO(
+        log,
+        "Spill uncommitted data, spilled_bytes={} in_memory_size={} after_spill={} spilled_rows={} cost={:.3f}s",
+        spilled_bytes,
+        in_memory_size,
+        in_memory_size_after_spill,
+        data.spilledDefaultCF().size(),
+        watch.elapsedSeconds());
+}
+
 } // namespace DB
@@ -251,6 +251,8 @@ public: // Stats
     bool setRegionTableWarned(bool desired) const { return data.setRegionTableWarned(desired); }
     void resetWarnMemoryLimitByTable() const;
     void maybeWarnMemoryLimitByTable(TMTContext & tmt, const char * from);
+    // Spill the uncommitted data if the in-memory data of this Region is too large.
+    void maybeSpillUncommittedData(TMTContext & tmt);
 
 public: // Raft Read and Write
     CommittedScanner createCommittedScanner(bool use_lock, bool need_value);
@@ -345,6 +347,8 @@ private:
     mutable std::atomic<size_t> approx_mem_cache_rows{0};
     mutable std::atomic<size_t> approx_mem_cache_bytes{0};
     mutable std::atomic<Timestamp> last_observed_read_tso{0};
+    // The in-memory data size after the last spill. Protected by `mutex`.
+    size_t in_memory_size_after_spill{0};
 };
 
 class RegionRaftCommandDelegate
@@ -0,0 +1,191 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/KVStore/FFI/ColumnFamily.h>
+#include <Storages/KVStore/MultiRaft/RegionData.h>
+#include <Storages/KVStore/MultiRaft/RegionDataArena.h>
+#include <Storages/KVStore/TiKVHelpers/TiKVRecordFormat.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <cstring>
+#include <map>
+
+namespace DB::tests
+{
+TEST(RegionDataArenaTest, AllocAndRelease)
+{
+    RegionDataArena arena;
+    ASSERT_EQ(arena.allocatedBytes(), 0);
+
+    std::vector<void *> nodes;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        auto * ptr = arena.alloc(i % 2 ? 72 : 100);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % RegionDataArena::node_alignment, 0);
+        nodes.push_back(ptr);
+    }
+    ASSERT_EQ(arena.usedBytes(), 5000 * 80 + 5000 * 112);
+    const auto peak_bytes = arena.allocatedBytes();
+    ASSERT_GE(peak_bytes, arena.usedBytes());
+
+    // The released nodes are reused
+    for (size_t i = 0; i < 100; ++i)
+        arena.free(nodes[i], i % 2 ? 72 : 100);
+    for (size_t i = 0; i < 100; ++i)
+        nodes[i] = arena.alloc(i % 2 ? 72 : 100);
+    ASSERT_EQ(arena.allocatedBytes(), peak_bytes);
+
+    // Large allocations are not served by the arena
+    auto * large = arena.alloc(RegionDataArena::max_node_size + 1);
+    arena.free(large, RegionDataArena::max_node_size + 1);
+    ASSERT_EQ(arena.usedBytes(), 5000 * 80 + 5000 * 112);
+
+    // All chunks but the last one are returned after all nodes are released
+    for (size_t i = 0; i < nodes.size(); ++i)
+        arena.free(nodes[i], i % 2 ? 72 : 100);
+    ASSERT_EQ(arena.usedBytes(), 0);
+    ASSERT_LT(arena.allocatedBytes(), peak_bytes);
+    ASSERT_GT(arena.allocatedBytes(), 0);
+}
+
+TEST(RegionDataArenaTest, ReleaseEmptyChunks)
+{
+    RegionDataArena arena;
+    std::vector<void *> nodes;
+    for (size_t i = 0; i < 10000; ++i)
+        nodes.push_back(arena.alloc(72));
+    const auto peak_bytes = arena.allocatedBytes();
+
+    // The first nodes are kept, e.g. the long-lived locks. The chunks without any node in use are
+    // returned although the arena is not empty.
+    const size_t kept = 10;
+    for (size_t i = kept; i < nodes.size(); ++i)
+        arena.free(nodes[i], 72);
+    ASSERT_EQ(arena.usedBytes(), kept * 80);
+    ASSERT_LT(arena.allocatedBytes(), peak_bytes / 2);
+
+    // The arena is still usable, and the free nodes in the returned chunks are not reused
+    for (size_t i = kept; i < nodes.size(); ++i)
+    {
+        nodes[i] = arena.alloc(72);
+        std::memset(nodes[i], 0xFF, 72);
+    }
+    ASSERT_EQ(arena.usedBytes(), nodes.size() * 80);
+    for (size_t i = 0; i < nodes.size(); ++i)
+        arena.free(nodes[i], 72);
+    ASSERT_EQ(arena.usedBytes(), 0);
+    ASSERT_LE(arena.allocatedBytes(), peak_bytes);
+}
+
+TEST(RegionDataArenaTest, Container)
+{
+    using Map = std::map<int, String, std::less<int>, RegionDataAllocator<std::pair<const int, String>>>;
+    Map map;
+    ASSERT_EQ(map.get_allocator().arenaAllocatedBytes(), 0);
+    for (int i = 0; i < 1000; ++i)
+        map.emplace(i, std::to_string(i));
+    ASSERT_GT(map.get_allocator().arenaAllocatedBytes(), 0);
+
+    // The copy owns another arena
+    Map copied = map;
+    ASSERT_TRUE(copied.get_allocator() != map.get_allocator());
+    ASSERT_EQ(copied, map);
+
+    // The arena is moved along with the nodes, and the moved-from map is still usable
+    const auto bytes = map.get_allocator().arenaAllocatedBytes();
+    Map moved = std::move(map);
+    ASSERT_EQ(moved.get_allocator().arenaAllocatedBytes(), bytes);
+    ASSERT_EQ(map.get_allocator().arenaAllocatedBytes(), 0); // NOLINT(bugprone-use-after-move)
+    map.emplace(1, "1");
+    map = std::move(moved);
+    ASSERT_EQ(map, copied);
+    ASSERT_EQ(map.get_allocator().arenaAllocatedBytes(), bytes);
+}
+
+TEST(RegionDataArenaTest, RegionData)
+{
+    const TableID table_id = 100;
+    RegionData data;
+    for (HandleID handle = 0; handle < 1000; ++handle)
+    {
+        data.insert(
+            ColumnFamilyType::Default,
+            RecordKVFormat::genKey(table_id, handle, 5),
+            TiKVValue(fmt::format("value{}", handle)));
+        data.insert(
+            ColumnFamilyType::Write,
+            RecordKVFormat::genKey(table_id, handle, 8),
+            RecordKVFormat::encodeWriteCfValue(RecordKVFormat::CFModifyFlag::PutFlag, 5));
+        data.insert(
+            ColumnFamilyType::Lock,
+            RecordKVFormat::genKey(table_id, handle),
+            RecordKVFormat::encodeLockCfValue(RecordKVFormat::CFModifyFlag::PutFlag, "PK", 3, 20));
+    }
+    const auto peak_bytes = data.arenaAllocatedBytes();
+    ASSERT_GT(peak_bytes, 0);
+
+    // The rows read by others are still valid after they are removed from the region
+    auto read_info = data.readDataByWriteIt(data.writeCF().getData().begin(), true, 1, 1, true);
+    ASSERT_TRUE(read_info.has_value());
+
+    // Flush all committed rows
+    auto & write_map = data.writeCF().getDataMut();
+    for (auto it = write_map.begin(); it != write_map.end();)
+        it = data.removeDataByWriteIt(it);
+    ASSERT_EQ(data.defaultCF().getSize(), 0);
+    ASSERT_LT(data.arenaAllocatedBytes(), peak_bytes);
+    ASSERT_EQ(read_info->value->toString(), "value0");
+
+    // Move to another region data
+    RegionData new_data;
+    const auto bytes = data.arenaAllocatedBytes();
+    new_data.assignRegionData(std::move(data));
+    ASSERT_EQ(new_data.arenaAllocatedBytes(), bytes);
+    ASSERT_EQ(new_data.lockCF().getSize(), 1000);
+}
+
+TEST(RegionDataArenaTest, RegionDataWithRemainingRows)
+{
+    const TableID table_id = 100;
+    const HandleID uncommitted_rows = 10;
+    RegionData data;
+    for (HandleID handle = 0; handle < 10000; ++handle)
+    {
+        data.insert(
+            ColumnFamilyType::Default,
+            RecordKVFormat::genKey(table_id, handle, 5),
+            TiKVValue(fmt::format("value{}", handle)));
+        // The first rows are not committed yet
+        if (handle < uncommitted_rows)
+            continue;
+        data.insert(
+            ColumnFamilyType::Write,
+            RecordKVFormat::genKey(table_id, handle, 8),
+            RecordKVFormat::encodeWriteCfValue(RecordKVFormat::CFModifyFlag::PutFlag, 5));
+    }
+    const auto peak_bytes = data.defaultCF().arenaAllocatedBytes();
+
+    // Flush all committed rows, the memory is returned although the uncommitted values are still there
+    auto & write_map = data.writeCF().getDataMut();
+    for (auto it = write_map.begin(); it != write_map.end();)
+        it = data.removeDataByWriteIt(it);
+    ASSERT_EQ(data.defaultCF().getSize(), uncommitted_rows);
+    ASSERT_LT(data.defaultCF().arenaAllocatedBytes(), peak_bytes / 2);
+    HandleID handle = 0;
+    for (auto it = data.defaultCF().getData().begin(); it != data.defaultCF().getData().end(); ++it, ++handle)
+        ASSERT_EQ(RegionDefaultCFDataTrait::getTiKVValue(it)->toString(), fmt::format("value{}", handle));
+    ASSERT_EQ(handle, uncommitted_rows);
+}
+
+} // namespace DB::tests
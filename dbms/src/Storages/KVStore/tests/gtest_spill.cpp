@@ -12,16 +12,25 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IO/Buffer/ReadBufferFromString.h>
+#include <IO/Buffer/WriteBufferFromString.h>
 #include <Storages/DeltaMerge/tests/DMTestEnv.h>
 #include <Storages/KVStore/Decode/RegionBlockReader.h>
+#include <Storages/KVStore/FFI/ColumnFamily.h>
 #include <Storages/KVStore/KVStore.h>
 #include <Storages/KVStore/MultiRaft/ApplySnapshot.h>
+#include <Storages/KVStore/MultiRaft/RegionData.h>
 #include <Storages/KVStore/MultiRaft/Spill/RegionUncommittedDataList.h>
 #include <Storages/KVStore/tests/region_kvstore_test.h>
 #include <Storages/RegionQueryInfo.h>
 #include <TiDB/Schema/SchemaSyncService.h>
 #include <TiDB/Schema/TiDBSchemaManager.h>
 
+#include <ext/scope_guard.h>
+#include <set>
+
+extern std::shared_ptr<MemoryTracker> root_of_kvstore_mem_trackers;
+
 namespace DB::tests
 {
 class KVStoreSpillTest : public KVStoreTestBase
@@ -142,4 +151,214 @@ try
 }
 CATCH
 
+TEST_F(KVStoreSpillTest, SpillDefaultCF)
+try
+{
+    const auto spill_dir = TiFlashTestEnv::getTemporaryPath("KVStoreSpillTest_SpillDefaultCF");
+    TiFlashTestEnv::tryRemovePath(spill_dir, /*recreate*/ true);
+    const auto file_provider = TiFlashTestEnv::getDefaultFileProvider();
+    const auto mem_before = root_of_kvstore_mem_trackers->get();
+    const auto gen_default_key = [&](HandleID handle) {
+        return RecordKVFormat::genKey(table_id, handle, 5);
+    };
+    const auto gen_value = [](HandleID handle) {
+        return TiKVValue(fmt::format("value{}", handle));
+    };
+
+    {
+        RegionData data;
+        size_t value_bytes = 0;
+        for (HandleID handle = 0; handle < 100; ++handle)
+        {
+            value_bytes += gen_value(handle).dataSize();
+            data.insert(ColumnFamilyType::Default, gen_default_key(handle), gen_value(handle));
+        }
+        const auto data_size = data.dataSize();
+        ASSERT_EQ(data.spillDefaultCF(file_provider, spill_dir, NullspaceID), value_bytes);
+        ASSERT_EQ(data.defaultCF().getSize(), 0);
+        ASSERT_EQ(data.spilledDefaultCF().size(), 100);
+        // The payload is still in the region, but the values are not in memory
+        ASSERT_EQ(data.dataSize(), data_size);
+        ASSERT_EQ(data.inMemoryDataSize(), data_size - value_bytes);
+        ASSERT_EQ(root_of_kvstore_mem_trackers->get() - mem_before, data_size - value_bytes);
+
+        // Duplicated keys are checked against the spilled rows
+        ASSERT_THROW(data.insert(ColumnFamilyType::Default, gen_default_key(0), gen_value(0)), Exception);
+        ASSERT_THROW(
+            data.insert(ColumnFamilyType::Default, gen_default_key(0), gen_value(1), DupCheck::AllowSame),
+            Exception);
+        data.insert(ColumnFamilyType::Default, gen_default_key(0), gen_value(0), DupCheck::AllowSame);
+        ASSERT_EQ(data.defaultCF().getSize(), 0);
+
+        // Commit, the value is read from the spill file
+        data.insert(
+            ColumnFamilyType::Write,
+            RecordKVFormat::genKey(table_id, 1, 8),
+            RecordKVFormat::encodeWriteCfValue(RecordKVFormat::CFModifyFlag::PutFlag, 5));
+        auto write_it = data.writeCF().getDataMut().begin();
+        auto read_info = data.readDataByWriteIt(write_it, true, 1, 1, true);
+        ASSERT_TRUE(read_info.has_value());
+        ASSERT_EQ(read_info->value->toString(), "value1");
+        data.removeDataByWriteIt(write_it);
+        ASSERT_EQ(data.spilledDefaultCF().size(), 99);
+
+        // Rollback
+        data.remove(ColumnFamilyType::Default, gen_default_key(2));
+        ASSERT_EQ(data.spilledDefaultCF().size(), 98);
+        ASSERT_EQ(data.dataSize(), data_size - 2 * (gen_default_key(1).dataSize() + gen_value(1).dataSize()));
+
+        // The spilled rows are persisted as normal rows
+        WriteBufferFromOwnString wb;
+        data.serialize(wb);
+        ReadBufferFromString rb(wb.str());
+        RegionData restored;
+        RegionData::deserialize(rb, restored);
+        ASSERT_EQ(restored.defaultCF().getSize(), 98);
+        ASSERT_EQ(restored.dataSize(), data.dataSize());
+
+        // Split
+        RegionData new_data;
+        data.splitInto(
+            RegionRangeKeys::makeComparableKeys(
+                RecordKVFormat::genKey(table_id, 50),
+                RecordKVFormat::genKey(table_id, 100)),
+            new_data);
+        ASSERT_EQ(data.spilledDefaultCF().size(), 48);
+        ASSERT_EQ(new_data.spilledDefaultCF().size(), 50);
+        ASSERT_EQ(data.dataSize() + new_data.dataSize(), restored.dataSize());
+    }
+    ASSERT_EQ(root_of_kvstore_mem_trackers->get(), mem_before);
+}
+CATCH
+
+TEST_F(KVStoreSpillTest, SpillDefaultCFTableSize)
+try
+{
+    const auto spill_dir = TiFlashTestEnv::getTemporaryPath("KVStoreSpillTest_SpillDefaultCFTableSize");
+    TiFlashTestEnv::tryRemovePath(spill_dir, /*recreate*/ true);
+    const auto file_provider = TiFlashTestEnv::getDefaultFileProvider();
+    auto ctx = createRegionTableCtx();
+    const auto table_size = [&] {
+        return static_cast<size_t>(ctx->table_size.load());
+    };
+
+    RegionData data;
+    data.setRegionTableCtx(ctx);
+    for (HandleID handle = 0; handle < 100; ++handle)
+        data.insert(
+            ColumnFamilyType::Default,
+            RecordKVFormat::genKey(table_id, handle, 5),
+            TiKVValue(fmt::format("value{}", handle)));
+    ASSERT_EQ(table_size(), data.dataSize());
+
+    // Only the keys of the spilled rows are counted
+    ASSERT_GT(data.spillDefaultCF(file_provider, spill_dir, NullspaceID), 0);
+    ASSERT_EQ(table_size(), data.inMemoryDataSize());
+    ASSERT_EQ(data.resetRegionTableCtx(), ctx);
+    ASSERT_EQ(table_size(), 0);
+
+    // Bind again, then remove a spilled row
+    data.setRegionTableCtx(ctx);
+    ASSERT_EQ(table_size(), data.inMemoryDataSize());
+    data.remove(ColumnFamilyType::Default, RecordKVFormat::genKey(table_id, 1, 5));
+    ASSERT_EQ(table_size(), data.inMemoryDataSize());
+
+    // Move the spilled rows to another region data
+    RegionData new_data;
+    new_data.assignRegionData(std::move(data));
+    ASSERT_EQ(table_size(), new_data.inMemoryDataSize());
+    new_data.resetRegionTableCtx();
+    ASSERT_EQ(table_size(), 0);
+}
+CATCH
+
+TEST_F(KVStoreSpillTest, SpillDefaultCFInBatches)
+try
+{
+    const auto spill_dir = TiFlashTestEnv::getTemporaryPath("KVStoreSpillTest_SpillDefaultCFInBatches");
+    TiFlashTestEnv::tryRemovePath(spill_dir, /*recreate*/ true);
+    const auto file_provider = TiFlashTestEnv::getDefaultFileProvider();
+    // The values are written in several batches of 4MiB
+    constexpr size_t num_rows = 30;
+    constexpr size_t value_size = 512 * 1024;
+    const auto gen_value = [](HandleID handle) {
+        return TiKVValue(String(value_size, static_cast<char>('a' + handle % 26)));
+    };
+
+    RegionData data;
+    std::multiset<String> expected_values;
+    for (HandleID handle = 0; handle < static_cast<HandleID>(num_rows); ++handle)
+    {
+        data.insert(ColumnFamilyType::Default, RecordKVFormat::genKey(table_id, handle, 5), gen_value(handle));
+        expected_values.insert(gen_value(handle).toString());
+    }
+    ASSERT_EQ(data.spillDefaultCF(file_provider, spill_dir, NullspaceID), num_rows * value_size);
+    ASSERT_EQ(data.defaultCF().getSize(), 0);
+
+    const auto & spilled = data.spilledDefaultCF();
+    ASSERT_EQ(spilled.size(), num_rows);
+    ASSERT_EQ(spilled.valueBytes(), num_rows * value_size);
+    std::multiset<String> spilled_values;
+    for (const auto & [key, entry] : spilled.getData())
+        spilled_values.insert(spilled.read(key)->toString());
+    ASSERT_EQ(spilled_values, expected_values);
+
+    // Remove a row, and the spilled rows are persisted in several batches
+    data.remove(ColumnFamilyType::Default, RecordKVFormat::genKey(table_id, 10, 5));
+    expected_values.erase(expected_values.find(gen_value(10).toString()));
+    WriteBufferFromOwnString wb;
+    data.serialize(wb);
+    ReadBufferFromString rb(wb.str());
+    RegionData restored;
+    RegionData::deserialize(rb, restored);
+    ASSERT_EQ(restored.defaultCF().getSize(), num_rows - 1);
+    ASSERT_EQ(restored.dataSize(), data.dataSize());
+    std::multiset<String> restored_values;
+    for (const auto & [key, value] : restored.defaultCF().getData())
+        restored_values.insert(std::get<1>(value)->toString());
+    ASSERT_EQ(restored_values, expected_values);
+}
+CATCH
+
+TEST_F(KVStoreSpillTest, SpillUncommittedData)
+try
+{
+    auto & ctx = TiFlashTestEnv::getGlobalContext();
+    auto & tmt = ctx.getTMTContext();
+    KVStore & kvs = getKVS();
+    kvs.debugGetConfigMut().debugSetRegionSpillThreshold(1);
+    SCOPE_EXIT({ kvs.debugGetConfigMut().debugSetRegionSpillThreshold(0); });
+
+    proxy_instance->bootstrapWithRegion(kvs, tmt, 1, std::nullopt);
+    auto region = kvs.getRegion(1);
+    MockRaftStoreProxy::FailCond cond;
+    auto [str_val_write, str_val_default] = proxy_instance->generateTiKVKeyValue(111, 999);
+    {
+        // Prewrite
+        auto str_key = RecordKVFormat::genKey(table_id, 1, 111);
+        auto [index, term] = proxy_instance->rawWrite(
+            1,
+            {str_key},
+            {str_val_default},
+            {WriteCmdType::Put},
+            {ColumnFamilyType::Default});
+        UNUSED(term);
+        proxy_instance->doApply(kvs, tmt, cond, 1, index);
+        ASSERT_EQ(region->dataInfo(), "[spilled_default 1 ]");
+        ASSERT_EQ(region->getData().inMemoryDataSize(), str_key.dataSize());
+    }
+    {
+        // Commit, the spilled value is written to the storage
+        auto str_key = RecordKVFormat::genKey(table_id, 1, 112);
+        auto [index, term]
+            = proxy_instance
+                  ->rawWrite(1, {str_key}, {str_val_write}, {WriteCmdType::Put}, {ColumnFamilyType::Write});
+        UNUSED(term);
+        proxy_instance->doApply(kvs, tmt, cond, 1, index);
+        ASSERT_EQ(region->dataInfo(), "[]");
+        ASSERT_EQ(region->dataSize(), 0);
+    }
+}
+CATCH
+
 } // namespace DB::tests
@@ -101,10 +101,20 @@ struct PageStorageConfig
     SettingDouble blob_heavy_gc_valid_rate = 0.5;
     SettingDouble blob_heavy_gc_valid_rate_raft_data = 0.05;
     SettingUInt64 blob_block_alignment_bytes = 0;
+    // Whether to read the pages of a batch at once by io_uring. Fall back to pread
+    // if io_uring is not available.
+    SettingBool blob_read_use_io_uring = false;
 
     SettingUInt64 wal_roll_size = PAGE_META_ROLL_SIZE;
     SettingUInt64 wal_max_persisted_log_files = MAX_PERSISTED_LOG_FILES;
 
+    // Number of shards of the in-memory page directory, 1 for no sharding.
+    // Only take effect when restoring the PageStorage, it is not reloadable.
+    SettingUInt64 dir_num_shards = 1;
+    // Number of threads for reading the WAL and rebuilding the page directory when
+    // restoring, 1 for restoring in the caller thread. It is not reloadable.
+    SettingUInt64 dir_restore_threads = 1;
+
     void reload(const PageStorageConfig & rhs)
     {
         // Reload is not atomic, but should be good enough
@@ -125,6 +135,7 @@ struct PageStorageConfig
         blob_heavy_gc_valid_rate = rhs.blob_heavy_gc_valid_rate;
         blob_heavy_gc_valid_rate_raft_data = rhs.blob_heavy_gc_valid_rate_raft_data;
         blob_block_alignment_bytes = rhs.blob_block_alignment_bytes;
+        blob_read_use_io_uring = rhs.blob_read_use_io_uring;
 
         wal_roll_size = rhs.wal_roll_size;
         wal_max_persisted_log_files = rhs.wal_max_persisted_log_files;
@@ -155,14 +166,19 @@ struct PageStorageConfig
             "PageStorageConfig {{"
             "blob_file_limit_size: {}, blob_spacemap_type: {}, "
             "blob_heavy_gc_valid_rate: {:.3f}, blob_heavy_gc_valid_rate_raft_data: {:.3f}, "
-            "blob_block_alignment_bytes: {}, wal_roll_size: {}, wal_max_persisted_log_files: {}}}",
+            "blob_block_alignment_bytes: {}, blob_read_use_io_uring: {}, "
+            "wal_roll_size: {}, wal_max_persisted_log_files: {}, "
+            "dir_num_shards: {}, dir_restore_threads: {}}}",
             blob_file_limit_size.get(),
             blob_spacemap_type.get(),
             blob_heavy_gc_valid_rate.get(),
             blob_heavy_gc_valid_rate_raft_data.get(),
             blob_block_alignment_bytes.get(),
+            blob_read_use_io_uring.get(),
             wal_roll_size.get(),
-            wal_max_persisted_log_files.get());
+            wal_max_persisted_log_files.get(),
+            dir_num_shards.get(),
+            dir_restore_threads.get());
     }
 };
 } // namespace DB
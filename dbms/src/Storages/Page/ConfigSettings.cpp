@@ -36,6 +36,9 @@ void mergeConfigFromSettings(const DB::Settings & settings, PageStorageConfig &
 
     // V3 setting which export to global setting
     config.blob_heavy_gc_valid_rate = settings.dt_page_gc_threshold;
+    config.blob_read_use_io_uring = settings.dt_page_read_use_io_uring;
+    config.dir_num_shards = settings.dt_page_directory_shards;
+    config.dir_restore_threads = settings.dt_page_restore_threads;
 }
 
 PageStorageConfig getConfigFromSettings(const DB::Settings & settings)
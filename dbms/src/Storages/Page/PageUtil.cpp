@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IO/BaseFile/IOUring.h>
+#include <IO/BaseFile/WriteReadableFile.h>
 #include <Storages/Page/PageUtil.h>
 
 #include <random>
@@ -46,4 +48,74 @@ std::vector<size_t> getFieldSizes(const std::set<FieldOffsetInsidePage> & field_
     return sizes;
 }
 
+void readFileBatch(const std::vector<FileReadRequest> & requests, const ReadLimiterPtr & read_limiter, bool background)
+{
+    IOUring * ring = requests.size() > 1 ? IOUring::getThreadLocal() : nullptr;
+    fiu_do_on(FailPoints::force_split_io_size_4k, { ring = nullptr; });
+
+    std::vector<IOUring::Request> ring_requests;
+    size_t expected_bytes = 0;
+    if (ring != nullptr)
+    {
+        ring_requests.reserve(requests.size());
+        for (const auto & req : requests)
+        {
+            const int fd = req.file->getFdForRawIO();
+            if (fd < 0)
+            {
+                ring = nullptr;
+                break;
+            }
+            ring_requests.emplace_back(
+                IOUring::Request{.fd = fd, .buf = req.buf, .size = req.size, .offset = req.offset});
+            expected_bytes += req.size;
+        }
+    }
+    if (ring == nullptr)
+    {
+        for (const auto & req : requests)
+            readFile(req.file, req.offset, req.buf, req.size, read_limiter, background);
+        return;
+    }
+
+    if (read_limiter != nullptr)
+        read_limiter->request(expected_bytes);
+    ring->submitAndWait(IOUring::OpType::Read, ring_requests.data(), ring_requests.size());
+
+    size_t bytes_read = 0;
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        const auto & req = requests[i];
+        const auto res = ring_requests[i].res;
+        if (likely(res == static_cast<ssize_t>(req.size)))
+        {
+            bytes_read += req.size;
+            continue;
+        }
+
+        // The op could be rejected by the kernel with EINVAL or EOPNOTSUPP, e.g. by the old kernels
+        // or some file systems, fall back to the normal read for these errors.
+        if (res < 0 && res != -EINTR && res != -EAGAIN && res != -EINVAL && res != -EOPNOTSUPP)
+        {
+            ProfileEvents::increment(ProfileEvents::PSMReadFailed);
+            DB::throwFromErrno(
+                fmt::format("Cannot read from file {}.", req.file->getFileName()),
+                ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR,
+                -res);
+        }
+        // Read the remaining part, it throws if there is no enough data in the file.
+        // The read limiter has been requested for the whole size, and `readFile` counts
+        // the bytes it reads by itself, so only the part done by the ring is counted here.
+        const size_t done = res > 0 ? res : 0;
+        bytes_read += done;
+        readFile(req.file, req.offset + done, req.buf + done, req.size - done, nullptr, background);
+    }
+    ProfileEvents::increment(ProfileEvents::PSMReadIOCalls, ring_requests.size());
+    ProfileEvents::increment(ProfileEvents::PSMReadBytes, bytes_read);
+    if (background)
+    {
+        ProfileEvents::increment(ProfileEvents::PSMBackgroundReadBytes, bytes_read);
+    }
+}
+
 } // namespace DB::PageUtil
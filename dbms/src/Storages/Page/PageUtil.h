@@ -21,6 +21,7 @@
 #include <Common/StringUtils/StringUtils.h>
 #include <Common/TiFlashException.h>
 #include <IO/BaseFile/RateLimiter.h>
+#include <IO/BaseFile/fwd.h>
 #include <IO/Buffer/WriteBufferFromFile.h>
 #include <IO/WriteHelpers.h>
 #include <Poco/File.h>
@@ -296,6 +297,22 @@ void readFile(
             Errors::PageStorage::FileSizeNotMatch);
 }
 
+struct FileReadRequest
+{
+    WriteReadableFilePtr file;
+    char * buf;
+    size_t size;
+    off_t offset;
+};
+
+/// Read all the requests at once by io_uring, so that they are handled by the device concurrently.
+/// Fall back to `readFile` one by one if io_uring is not available or any file can not be read by
+/// its fd directly. The part that is not read by io_uring (e.g. short read) is read by `readFile`.
+void readFileBatch(
+    const std::vector<FileReadRequest> & requests,
+    const ReadLimiterPtr & read_limiter = nullptr,
+    bool background = false);
+
 /// Write and advance sizeof(T) bytes.
 template <typename T>
 inline void put(char *& pos, const T & v)
@@ -29,6 +29,7 @@ struct BlobConfig
     SettingUInt64 block_alignment_bytes = 0;
     SettingDouble heavy_gc_valid_rate = 0.2;
     SettingDouble heavy_gc_valid_rate_raft_data = 0.05;
+    SettingBool read_use_io_uring = false;
 
     String toString()
     {
@@ -37,12 +38,14 @@ struct BlobConfig
             "[file_limit_size={}] [spacemap_type={}] "
             "[block_alignment_bytes={}] "
             "[heavy_gc_valid_rate={}]"
-            "[heavy_gc_valid_rate_raft_data={}]",
+            "[heavy_gc_valid_rate_raft_data={}]"
+            "[read_use_io_uring={}]",
             file_limit_size,
             spacemap_type,
             block_alignment_bytes,
             heavy_gc_valid_rate,
-            heavy_gc_valid_rate_raft_data);
+            heavy_gc_valid_rate_raft_data,
+            read_use_io_uring);
     }
 
     static BlobConfig from(const PageStorageConfig & config)
@@ -54,6 +57,7 @@ struct BlobConfig
         blob_config.heavy_gc_valid_rate = config.blob_heavy_gc_valid_rate;
         blob_config.heavy_gc_valid_rate_raft_data = config.blob_heavy_gc_valid_rate_raft_data;
         blob_config.block_alignment_bytes = config.blob_block_alignment_bytes;
+        blob_config.read_use_io_uring = config.blob_read_use_io_uring;
 
         return blob_config;
     }
@@ -75,6 +75,31 @@ void BlobFile::read(char * buffer, size_t offset, size_t size, const ReadLimiter
     PageUtil::readFile(wrfile, offset, buffer, size, read_limiter, background);
 }
 
+void BlobFile::readBatch(
+    const std::vector<ReadRequest> & requests,
+    const ReadLimiterPtr & read_limiter,
+    bool background)
+{
+    std::vector<PageUtil::FileReadRequest> file_requests;
+    file_requests.reserve(requests.size());
+    for (const auto & req : requests)
+    {
+        if (unlikely(req.blob_file->wrfile->isClosed()))
+        {
+            throw Exception(
+                "Read failed, FD is closed which [path=" + req.blob_file->getPath()
+                    + "], BlobFile should also be closed",
+                ErrorCodes::LOGICAL_ERROR);
+        }
+        file_requests.emplace_back(PageUtil::FileReadRequest{
+            .file = req.blob_file->wrfile,
+            .buf = req.buffer,
+            .size = req.size,
+            .offset = static_cast<off_t>(req.offset)});
+    }
+    PageUtil::readFileBatch(file_requests, read_limiter, background);
+}
+
 void BlobFile::write(char * buffer, size_t offset, size_t size, const WriteLimiterPtr & write_limiter, bool background)
 {
     /**
@@ -24,6 +24,9 @@
 namespace DB::PS::V3
 {
 
+class BlobFile;
+using BlobFilePtr = std::shared_ptr<BlobFile>;
+
 /**
  * BlobFile is a file that stores the data of multiple pages.
  */
@@ -43,6 +46,19 @@ public:
 
     void read(char * buffer, size_t offset, size_t size, const ReadLimiterPtr & read_limiter, bool background = false);
 
+    struct ReadRequest
+    {
+        BlobFilePtr blob_file;
+        char * buffer;
+        size_t offset;
+        size_t size;
+    };
+    // Read the ranges of one or more BlobFiles at once, see `PageUtil::readFileBatch`
+    static void readBatch(
+        const std::vector<ReadRequest> & requests,
+        const ReadLimiterPtr & read_limiter,
+        bool background = false);
+
     void write(
         char * buffer,
         size_t offset,
@@ -66,6 +82,5 @@ private:
     std::mutex file_size_lock;
     BlobFileOffset file_size;
 };
-using BlobFilePtr = std::shared_ptr<BlobFile>;
 
 } // namespace DB::PS::V3
@@ -146,6 +146,7 @@ void BlobStore<Trait>::reloadConfig(const BlobConfig & rhs)
     config.block_alignment_bytes = rhs.block_alignment_bytes;
     config.heavy_gc_valid_rate = rhs.heavy_gc_valid_rate;
     config.heavy_gc_valid_rate_raft_data = rhs.heavy_gc_valid_rate_raft_data;
+    config.read_use_io_uring = rhs.read_use_io_uring;
     auto reload_page_type_config = [this](PageType page_type, const PageTypeConfig & config) {
         auto iter = page_type_and_config.find(page_type);
         if (iter != page_type_and_config.end())
@@ -907,18 +908,32 @@ typename BlobStore<Trait>::PageMap BlobStore<Trait>::read(FieldReadInfos & to_re
     char * shared_data_buf = static_cast<char *>(alloc(buf_size));
     MemHolder shared_mem_holder = createMemHolder(shared_data_buf, [&, buf_size](char * p) { free(p, buf_size); });
 
-    std::set<FieldOffsetInsidePage> fields_offset_in_page;
+    // Read all fields at once, so that they can be handled by the device concurrently
+    std::vector<ReadRequest> requests;
     char * pos = shared_data_buf;
     for (const auto & [page_id_v3, entry, fields] : to_read)
+    {
+        for (const auto field_index : fields)
+        {
+            // TODO: Continuously fields can read by one system call.
+            const auto [beg_offset, end_offset] = entry.getFieldOffsets(field_index);
+            const auto size_to_read = end_offset - beg_offset;
+            requests.emplace_back(ReadRequest{page_id_v3, entry.file_id, entry.offset + beg_offset, pos, size_to_read});
+            pos += size_to_read;
+        }
+    }
+    readBatch(requests, read_limiter);
+
+    std::set<FieldOffsetInsidePage> fields_offset_in_page;
+    pos = shared_data_buf;
+    for (const auto & [page_id_v3, entry, fields] : to_read)
     {
         size_t read_size_this_entry = 0;
         char * write_offset = pos;
         for (const auto field_index : fields)
         {
-            // TODO: Continuously fields can read by one system call.
             const auto [beg_offset, end_offset] = entry.getFieldOffsets(field_index);
             const auto size_to_read = end_offset - beg_offset;
-            read(page_id_v3, entry.file_id, entry.offset + beg_offset, write_offset, size_to_read, read_limiter);
             fields_offset_in_page.emplace(field_index, read_size_this_entry);
 
             if constexpr (BLOBSTORE_CHECKSUM_ON_READ)
@@ -1022,12 +1037,21 @@ typename BlobStore<Trait>::PageMap BlobStore<Trait>::read(
     char * data_buf = static_cast<char *>(alloc(buf_size));
     MemHolder mem_holder = createMemHolder(data_buf, [&, buf_size](char * p) { free(p, buf_size); });
 
+    // Read all pages at once, so that they can be handled by the device concurrently
+    std::vector<ReadRequest> requests;
+    requests.reserve(entries.size());
     char * pos = data_buf;
-    PageMap page_map;
     for (const auto & [page_id_v3, entry] : entries)
     {
-        read(page_id_v3, entry.file_id, entry.offset, pos, entry.size, read_limiter);
+        requests.emplace_back(ReadRequest{page_id_v3, entry.file_id, entry.offset, pos, entry.size});
+        pos += entry.size;
+    }
+    readBatch(requests, read_limiter);
 
+    pos = data_buf;
+    PageMap page_map;
+    for (const auto & [page_id_v3, entry] : entries)
+    {
         if constexpr (BLOBSTORE_CHECKSUM_ON_READ)
         {
             ChecksumClass digest;
@@ -1177,6 +1201,56 @@ void BlobStore<Trait>::read(
     }
 }
 
+template <typename Trait>
+void BlobStore<Trait>::readBatch(const std::vector<ReadRequest> & requests, const ReadLimiterPtr & read_limiter)
+{
+    if (!config.read_use_io_uring || requests.size() <= 1)
+    {
+        for (const auto & req : requests)
+            read(req.page_id, req.blob_id, req.offset, req.buffer, req.size, read_limiter);
+        return;
+    }
+
+    GET_METRIC(tiflash_storage_page_command_count, type_read_blob).Increment(requests.size());
+    std::vector<BlobFile::ReadRequest> blob_requests;
+    blob_requests.reserve(requests.size());
+    BlobFilePtr blob_file;
+    BlobFileId blob_id = INVALID_BLOBFILE_ID;
+    for (const auto & req : requests)
+    {
+        // Reading an empty page should not create a BlobFile if it has already removed
+        if (unlikely(req.size == 0))
+            continue;
+
+        assert(req.buffer != nullptr);
+        // The requests of the same BlobFile are usually adjacent
+        if (blob_file == nullptr || blob_id != req.blob_id)
+        {
+            blob_file = getBlobFile(req.blob_id);
+            blob_id = req.blob_id;
+        }
+        blob_requests.emplace_back(BlobFile::ReadRequest{
+            .blob_file = blob_file,
+            .buffer = req.buffer,
+            .offset = req.offset,
+            .size = req.size});
+    }
+
+    try
+    {
+        BlobFile::readBatch(blob_requests, read_limiter);
+    }
+    catch (DB::Exception & e)
+    {
+        // add debug message
+        e.addMessage(fmt::format(
+            "(error while reading a batch of page data [num_requests={}] [first_page_id={}] [last_page_id={}])",
+            requests.size(),
+            requests.front().page_id,
+            requests.back().page_id));
+        e.rethrow();
+    }
+}
 
 template <typename Trait>
 typename BlobStore<Trait>::PageTypeAndBlobIds BlobStore<Trait>::getGCStats() NO_THREAD_SAFETY_ANALYSIS
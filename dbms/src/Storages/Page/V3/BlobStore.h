@@ -135,6 +135,18 @@ private:
         const ReadLimiterPtr & read_limiter = nullptr,
         bool background = false);
 
+    struct ReadRequest
+    {
+        PageId page_id;
+        BlobFileId blob_id;
+        BlobFileOffset offset;
+        char * buffer;
+        size_t size;
+    };
+    // Read multiple ranges at once. If `read_use_io_uring` is enabled, all of them
+    // are submitted together, otherwise they are read one by one.
+    void readBatch(const std::vector<ReadRequest> & requests, const ReadLimiterPtr & read_limiter = nullptr);
+
     /**
      *  Ask BlobStats to get a span from BlobStat.
      *  We will lock BlobStats until we get a BlobStat that can hold the size.
@@ -1055,9 +1055,14 @@ void VersionedPageEntries<Trait>::collapseTo(const UInt64 seq, const PageId & pa
   *************************/
 
 template <typename Trait>
-PageDirectory<Trait>::PageDirectory(String storage_name, WALStorePtr && wal_, UInt64 max_persisted_log_files_)
+PageDirectory<Trait>::PageDirectory(
+    String storage_name,
+    WALStorePtr && wal_,
+    UInt64 max_persisted_log_files_,
+    size_t num_shards)
     : max_page_id(0)
     , sequence(0)
+    , mvcc_table_directory(num_shards)
     , wal(std::move(wal_))
     , max_persisted_log_files(max_persisted_log_files_)
     , log(Logger::get(storage_name))
@@ -1160,35 +1165,30 @@ typename PageDirectory<Trait>::PageIdAndEntry PageDirectory<Trait>::getByIDImpl(
     bool ok = true;
     while (ok)
     {
-        VersionedPageEntriesPtr iter_v;
+        VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+        if (iter_v == nullptr)
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
-                {
-                    LOG_WARNING(log, "Dump state for invalid page id [page_id={}]", page_id);
-                    for (const auto & [dump_id, dump_entry] : mvcc_table_directory)
-                    {
+                LOG_WARNING(log, "Dump state for invalid page id [page_id={}]", page_id);
+                mvcc_table_directory.traverse(
+                    [this](const PageId & dump_id, const VersionedPageEntriesPtr & dump_entry) {
                         LOG_WARNING(
                             log,
                             "Dumping state [page_id={}] [entry={}]",
                             dump_id,
                             dump_entry == nullptr ? "<null>" : dump_entry->toDebugString());
-                    }
-                    throw Exception(
-                        ErrorCodes::PS_ENTRY_NOT_EXISTS,
-                        "Invalid page id, entry not exist [page_id={}] [resolve_id={}]",
-                        page_id,
-                        id_to_resolve);
-                }
-                else
-                {
-                    return PageIdAndEntry{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
-                }
+                    });
+                throw Exception(
+                    ErrorCodes::PS_ENTRY_NOT_EXISTS,
+                    "Invalid page id, entry not exist [page_id={}] [resolve_id={}]",
+                    page_id,
+                    id_to_resolve);
+            }
+            else
+            {
+                return PageIdAndEntry{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
             }
-            iter_v = iter->second;
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
             = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, &entry_got);
@@ -1251,26 +1251,21 @@ std::pair<typename PageDirectory<Trait>::PageIdAndEntries, typename PageDirector
         bool ok = true;
         while (ok)
         {
-            VersionedPageEntriesPtr iter_v;
+            VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+            if (iter_v == nullptr)
             {
-                std::shared_lock read_lock(table_rw_mutex);
-                auto iter = mvcc_table_directory.find(id_to_resolve);
-                if (iter == mvcc_table_directory.end())
+                if (throw_on_not_exist)
                 {
-                    if (throw_on_not_exist)
-                    {
-                        throw Exception(
-                            ErrorCodes::PS_ENTRY_NOT_EXISTS,
-                            "Invalid page id, entry not exist [page_id={}] [resolve_id={}]",
-                            page_id,
-                            id_to_resolve);
-                    }
-                    else
-                    {
-                        return false;
-                    }
+                    throw Exception(
+                        ErrorCodes::PS_ENTRY_NOT_EXISTS,
+                        "Invalid page id, entry not exist [page_id={}] [resolve_id={}]",
+                        page_id,
+                        id_to_resolve);
+                }
+                else
+                {
+                    return false;
                 }
-                iter_v = iter->second;
             }
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = iter_v->resolveToPageId(
                 ver_to_resolve.sequence,
@@ -1340,26 +1335,21 @@ typename PageDirectory<Trait>::PageId PageDirectory<Trait>::getNormalPageId(
     bool keep_resolve = true;
     while (keep_resolve)
     {
-        VersionedPageEntriesPtr iter_v;
+        VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+        if (iter_v == nullptr)
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
-                {
-                    throw Exception(
-                        ErrorCodes::LOGICAL_ERROR,
-                        "Invalid page id [page_id={}] [resolve_id={}]",
-                        page_id,
-                        id_to_resolve);
-                }
-                else
-                {
-                    return Trait::PageIdTrait::getInvalidID();
-                }
+                throw Exception(
+                    ErrorCodes::LOGICAL_ERROR,
+                    "Invalid page id [page_id={}] [resolve_id={}]",
+                    page_id,
+                    id_to_resolve);
+            }
+            else
+            {
+                return Trait::PageIdTrait::getInvalidID();
             }
-            iter_v = iter->second;
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
             = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, nullptr);
@@ -1403,7 +1393,7 @@ typename PageDirectory<Trait>::PageId PageDirectory<Trait>::getNormalPageId(
 template <typename Trait>
 UInt64 PageDirectory<Trait>::getMaxIdAfterRestart() const
 {
-    std::shared_lock read_lock(table_rw_mutex);
+    // `max_page_id` is only updated when restoring
     return max_page_id;
 }
 
@@ -1413,14 +1403,12 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIds()
     GET_METRIC(tiflash_storage_page_command_count, type_scan).Increment();
     std::set<PageId> page_ids;
 
-    std::shared_lock read_lock(table_rw_mutex);
     const auto seq = sequence.load();
-    for (auto & [page_id, versioned] : mvcc_table_directory)
-    {
+    mvcc_table_directory.traverse([&](const PageId & page_id, const VersionedPageEntriesPtr & versioned) {
         // Only return the page_id that is visible
         if (versioned->isVisible(seq))
             page_ids.insert(page_id);
-    }
+    });
     return page_ids;
 }
 
@@ -1434,14 +1422,18 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIdsWith
     {
         PageIdSet page_ids;
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(prefix); iter != mvcc_table_directory.end(); ++iter)
+        for (size_t i = 0; i < mvcc_table_directory.numShards(); ++i)
         {
-            if (!iter->first.hasPrefix(prefix))
-                break;
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                page_ids.insert(iter->first);
+            const auto & shard = mvcc_table_directory.shard(i);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(prefix); iter != shard.map.end(); ++iter)
+            {
+                if (!iter->first.hasPrefix(prefix))
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                    page_ids.insert(iter->first);
+            }
         }
         return page_ids;
     }
@@ -1462,14 +1454,18 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIdsInRa
     {
         PageIdSet page_ids;
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(start); iter != mvcc_table_directory.end(); ++iter)
+        for (size_t i = 0; i < mvcc_table_directory.numShards(); ++i)
         {
-            if (!end.empty() && iter->first >= end)
-                break;
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                page_ids.insert(iter->first);
+            const auto & shard = mvcc_table_directory.shard(i);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(start); iter != shard.map.end(); ++iter)
+            {
+                if (!end.empty() && iter->first >= end)
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                    page_ids.insert(iter->first);
+            }
         }
         return page_ids;
     }
@@ -1487,14 +1483,25 @@ std::optional<typename PageDirectory<Trait>::PageId> PageDirectory<Trait>::getLo
     if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
     {
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(start); iter != mvcc_table_directory.end(); ++iter)
+        // Page ids are only ordered inside a shard, return the minimum of all shards
+        std::optional<PageId> lower_bound;
+        for (size_t i = 0; i < mvcc_table_directory.numShards(); ++i)
         {
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                return iter->first;
+            const auto & shard = mvcc_table_directory.shard(i);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(start); iter != shard.map.end(); ++iter)
+            {
+                if (lower_bound && iter->first >= *lower_bound)
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                {
+                    lower_bound = iter->first;
+                    break;
+                }
+            }
         }
-        return std::nullopt;
+        return lower_bound;
     }
     else
     {
@@ -1504,7 +1511,7 @@ std::optional<typename PageDirectory<Trait>::PageId> PageDirectory<Trait>::getLo
 
 template <typename Trait>
 void PageDirectory<Trait>::applyRefEditRecord(
-    MVCCMapType & mvcc_table_directory,
+    const FindVersionListFunc & find_version_list,
     const VersionedPageEntriesPtr & version_list,
     const typename PageEntriesEdit::EditRecord & rec,
     const PageVersion & version)
@@ -1541,16 +1548,15 @@ void PageDirectory<Trait>::applyRefEditRecord(
     // not stable.
 
     auto [resolve_success, resolved_id, resolved_ver]
-        = [&mvcc_table_directory, ori_page_id = rec.ori_page_id](
+        = [&find_version_list, ori_page_id = rec.ori_page_id](
               PageId id_to_resolve,
               PageVersion ver_to_resolve) -> std::tuple<bool, PageId, PageVersion> {
         while (true)
         {
-            auto resolve_ver_iter = mvcc_table_directory.find(id_to_resolve);
-            if (resolve_ver_iter == mvcc_table_directory.end())
+            const VersionedPageEntriesPtr resolve_version_list = find_version_list(id_to_resolve);
+            if (resolve_version_list == nullptr)
                 return {false, Trait::PageIdTrait::getInvalidID(), PageVersion(0)};
 
-            const VersionedPageEntriesPtr & resolve_version_list = resolve_ver_iter->second;
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = resolve_version_list->resolveToPageId(
                 ver_to_resolve.sequence,
                 /*ignore_delete=*/id_to_resolve != ori_page_id,
@@ -1592,9 +1598,9 @@ void PageDirectory<Trait>::applyRefEditRecord(
     {
         SYNC_FOR("before_PageDirectory::applyRefEditRecord_incr_ref_count");
         // Add the ref-count of being-ref entry
-        if (auto resolved_iter = mvcc_table_directory.find(resolved_id); resolved_iter != mvcc_table_directory.end())
+        if (auto resolved_version_list = find_version_list(resolved_id); resolved_version_list != nullptr)
         {
-            resolved_iter->second->incrRefCount(resolved_ver, version);
+            resolved_version_list->incrRefCount(resolved_ver, version);
         }
         else
         {
@@ -1734,13 +1740,33 @@ std::unordered_set<String> PageDirectory<Trait>::apply(PageEntriesEdit && edit,
     SYNC_FOR("before_PageDirectory::apply_to_memory");
     std::unordered_set<String> applied_data_files;
     {
-        std::unique_lock table_lock(table_rw_mutex);
+        // Only lock the shards of the page ids in the edit, in ascending order of shard index.
+        // Other shards can be read or cleaned by GC concurrently. It is safe because only the
+        // write group owner locks more than one shard at a time.
+        std::vector<UInt8> shard_locked(mvcc_table_directory.numShards(), 0);
+        for (const auto & r : edit.getRecords())
+            shard_locked[mvcc_table_directory.shardIndex(r.page_id)] = 1;
+        std::vector<std::unique_lock<std::shared_mutex>> table_locks;
+        for (size_t i = 0; i < shard_locked.size(); ++i)
+        {
+            if (shard_locked[i])
+                table_locks.emplace_back(mvcc_table_directory.shard(i).mutex);
+        }
+        const FindVersionListFunc find_version_list = [&](const PageId & page_id) -> VersionedPageEntriesPtr {
+            const auto shard_idx = mvcc_table_directory.shardIndex(page_id);
+            if (!shard_locked[shard_idx])
+                return mvcc_table_directory.find(page_id);
+            const auto & map = mvcc_table_directory.shard(shard_idx).map;
+            auto iter = map.find(page_id);
+            return iter == map.end() ? nullptr : iter->second;
+        };
 
         // create entry version list for page_id.
         for (const auto & r : edit.getRecords())
         {
             // Protected in write_lock
-            auto [iter, created] = mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
+            auto & map = mvcc_table_directory.shardOf(r.page_id).map;
+            auto [iter, created] = map.insert(std::make_pair(r.page_id, nullptr));
             if (created)
             {
                 iter->second = std::make_shared<VersionedPageEntries<Trait>>();
@@ -1769,7 +1795,7 @@ std::unordered_set<String> PageDirectory<Trait>::apply(PageEntriesEdit && edit,
                     version_list->createDelete(r.version);
                     break;
                 case EditRecordType::REF:
-                    applyRefEditRecord(mvcc_table_directory, version_list, r, r.version);
+                    applyRefEditRecord(find_version_list, version_list, r, r.version);
                     break;
                 case EditRecordType::UPSERT:
                 case EditRecordType::VAR_DELETE:
@@ -1825,63 +1851,59 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::updateLocalCach
     }
     wal->apply(Trait::Serializer::serializeTo(edit), write_limiter);
     typename PageDirectory<Trait>::PageEntries ignored_entries;
+    for (const auto & r : edit.getRecords())
     {
-        std::unique_lock table_lock(table_rw_mutex);
-
-        for (const auto & r : edit.getRecords())
+        try
         {
-            try
+            auto id_to_resolve = r.page_id;
+            auto sequence_to_resolve = seq;
+            while (true)
             {
-                auto id_to_resolve = r.page_id;
-                auto sequence_to_resolve = seq;
-                while (true)
+                // The page is visible by `snap_`, so it won't be removed by GC.
+                auto version_list = mvcc_table_directory.find(id_to_resolve);
+                assert(version_list != nullptr);
+                // We need to ignore the "deletes" both when resolve page id and update local cache.
+                // Check `PageDirectory::getByIDImpl` or the unit test
+                // `UniPageStorageRemoteReadTest.WriteReadRefWithRestart` for details.
+                const bool ignore_delete = id_to_resolve != r.page_id;
+                auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
+                    = version_list->resolveToPageId(sequence_to_resolve, ignore_delete, nullptr);
+                if (resolve_state == ResolveResult::TO_NORMAL)
                 {
-                    auto iter = mvcc_table_directory.lower_bound(id_to_resolve);
-                    assert(iter != mvcc_table_directory.end());
-                    auto & version_list = iter->second;
-                    // We need to ignore the "deletes" both when resolve page id and update local cache.
-                    // Check `PageDirectory::getByIDImpl` or the unit test
-                    // `UniPageStorageRemoteReadTest.WriteReadRefWithRestart` for details.
-                    const bool ignore_delete = id_to_resolve != r.page_id;
-                    auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
-                        = version_list->resolveToPageId(sequence_to_resolve, ignore_delete, nullptr);
-                    if (resolve_state == ResolveResult::TO_NORMAL)
+                    if (!version_list->updateLocalCacheForRemotePage(
+                            PageVersion(sequence_to_resolve, 0),
+                            r.entry,
+                            ignore_delete))
                     {
-                        if (!version_list->updateLocalCacheForRemotePage(
-                                PageVersion(sequence_to_resolve, 0),
-                                r.entry,
-                                ignore_delete))
-                        {
-                            // The entry is not valid for updating the version_list.
-                            // Caller should notice these part of "ignored_entries" and release
-                            // the space allocated for these invalid entries.
-                            // For the information persisted in WAL, it should be ignored when
-                            // restoring from disk.
-                            ignored_entries.push_back(r.entry);
-                        }
-                        break;
-                    }
-                    else if (resolve_state == ResolveResult::TO_REF)
-                    {
-                        id_to_resolve = next_id_to_resolve;
-                        sequence_to_resolve = next_ver_to_resolve.sequence;
-                    }
-                    else
-                    {
-                        RUNTIME_CHECK(false);
+                        // The entry is not valid for updating the version_list.
+                        // Caller should notice these part of "ignored_entries" and release
+                        // the space allocated for these invalid entries.
+                        // For the information persisted in WAL, it should be ignored when
+                        // restoring from disk.
+                        ignored_entries.push_back(r.entry);
                     }
+                    break;
+                }
+                else if (resolve_state == ResolveResult::TO_REF)
+                {
+                    id_to_resolve = next_id_to_resolve;
+                    sequence_to_resolve = next_ver_to_resolve.sequence;
+                }
+                else
+                {
+                    RUNTIME_CHECK(false);
                 }
             }
-            catch (DB::Exception & e)
-            {
-                e.addMessage(fmt::format(
-                    " type={}, page_id={}, ver={}, seq={}",
-                    magic_enum::enum_name(r.type),
-                    r.page_id,
-                    r.version,
-                    seq));
-                throw e;
-            }
+        }
+        catch (DB::Exception & e)
+        {
+            e.addMessage(fmt::format(
+                " type={}, page_id={}, ver={}, seq={}",
+                magic_enum::enum_name(r.type),
+                r.page_id,
+                r.version,
+                seq));
+            throw e;
         }
     }
     return ignored_entries;
@@ -1902,33 +1924,23 @@ void PageDirectory<Trait>::gcApply(PageEntriesEdit && migrated_edit, const Write
     // Apply migrate edit to the mvcc map
     for (const auto & record : migrated_edit.getRecords())
     {
-        typename MVCCMapType::const_iterator iter;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(record.page_id);
-            RUNTIME_CHECK_MSG(
-                iter != mvcc_table_directory.end(),
-                "Can't find page while doing gcApply, page_id={}",
-                record.page_id);
-        } // release the read lock on `table_rw_mutex`
+        const auto versioned_entries = mvcc_table_directory.find(record.page_id);
+        RUNTIME_CHECK_MSG(
+            versioned_entries != nullptr,
+            "Can't find page while doing gcApply, page_id={}",
+            record.page_id);
 
         // Append the gc version to version list
-        const auto & versioned_entries = iter->second;
         auto id_to_deref = versioned_entries->createUpsertEntry(record.version, record.entry, /*strict_check*/ true);
         if (id_to_deref != Trait::PageIdTrait::getInvalidID())
         {
             // The ref-page is rewritten into a normal page, we need to decrease the ref-count of original page
-            typename MVCCMapType::const_iterator deref_iter;
-            {
-                std::shared_lock read_lock(table_rw_mutex);
-                deref_iter = mvcc_table_directory.find(id_to_deref);
-                RUNTIME_CHECK_MSG(
-                    deref_iter != mvcc_table_directory.end(),
-                    "Can't find page to deref after gcApply, page_id={}",
-                    id_to_deref);
-            }
-            auto deref_res
-                = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
+            const auto deref_entries = mvcc_table_directory.find(id_to_deref);
+            RUNTIME_CHECK_MSG(
+                deref_entries != nullptr,
+                "Can't find page to deref after gcApply, page_id={}",
+                id_to_deref);
+            auto deref_res = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
             RUNTIME_ASSERT(!deref_res);
         }
     }
@@ -1951,21 +1963,8 @@ std::pair<typename PageDirectory<Trait>::GcEntriesMap, PageSize> PageDirectory<T
     UInt64 total_page_nums = 0;
     std::map<PageId, std::tuple<PageId, PageVersion>> ref_ids_maybe_rewrite;
 
-    {
-        PageId page_id;
-        VersionedPageEntriesPtr version_entries;
-
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.cbegin();
-            if (iter == mvcc_table_directory.end())
-                return {blob_versioned_entries, total_page_size};
-            page_id = iter->first;
-            version_entries = iter->second;
-        }
-
-        while (true)
-        {
+    mvcc_table_directory.traverseUnlocked(
+        [&](const PageId & page_id, const VersionedPageEntriesPtr & version_entries) {
             fiu_do_on(FailPoints::pause_before_full_gc_prepare, {
                 if constexpr (std::is_same_v<Trait, u128::PageDirectoryTrait>)
                 {
@@ -1983,17 +1982,7 @@ std::pair<typename PageDirectory<Trait>::GcEntriesMap, PageSize> PageDirectory<T
             {
                 total_page_nums++;
             }
-
-            {
-                std::shared_lock read_lock(table_rw_mutex);
-                auto iter = mvcc_table_directory.upper_bound(page_id);
-                if (iter == mvcc_table_directory.end())
-                    break;
-                page_id = iter->first;
-                version_entries = iter->second;
-            }
-        }
-    }
+        });
 
     // For the non-deleted ref-ids, we will check whether theirs original entries lay on
     // `blob_id_set`. Rewrite the entries for these ref-ids to be normal pages.
@@ -2003,13 +1992,8 @@ std::pair<typename PageDirectory<Trait>::GcEntriesMap, PageSize> PageDirectory<T
         const auto ori_id = std::get<0>(ori_id_ver);
         const auto ver = std::get<1>(ori_id_ver);
 
-        VersionedPageEntriesPtr version_entries;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto page_iter = mvcc_table_directory.find(ori_id);
-            RUNTIME_CHECK(page_iter != mvcc_table_directory.end(), ref_id, ori_id, ver);
-            version_entries = page_iter->second;
-        }
+        VersionedPageEntriesPtr version_entries = mvcc_table_directory.find(ori_id);
+        RUNTIME_CHECK(version_entries != nullptr, ref_id, ori_id, ver);
         // After storing all data in one PageStorage instance, we will run full gc
         // with external pages. Skip rewriting if it is an external pages.
         if (version_entries->isExternalPage())
@@ -2117,17 +2101,12 @@ size_t PageDirectory<Trait>::copyCheckpointInfoFromEdit(const PageEntriesEdit &
 
         // TODO: Improve from O(nlogn) to O(n).
 
-        VersionedPageEntriesPtr entries;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(rec.page_id);
-            if (iter == mvcc_table_directory.end())
-                // There may be obsolete entries deleted.
-                // For example, if there is a `Put 1` with sequence 10, `Del 1` with sequence 11,
-                // and the snapshot sequence is 12, Page with id 1 may be deleted by the gc process.
-                continue;
-            entries = iter->second;
-        }
+        VersionedPageEntriesPtr entries = mvcc_table_directory.find(rec.page_id);
+        if (entries == nullptr)
+            // There may be obsolete entries deleted.
+            // For example, if there is a `Put 1` with sequence 10, `Del 1` with sequence 11,
+            // and the snapshot sequence is 12, Page with id 1 may be deleted by the gc process.
+            continue;
 
         entries->copyCheckpointInfoFromEdit(rec);
         num_copied += 1;
@@ -2192,47 +2171,51 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     SYNC_FOR("after_PageDirectory::doGC_getLowestSeq");
 
     PageEntriesV3 all_del_entries;
-    typename MVCCMapType::iterator iter;
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return all_del_entries;
-    }
-
     UInt64 invalid_page_nums = 0;
     UInt64 valid_page_nums = 0;
 
     // The page_id that we need to decrease ref count
     // { id_0: <version, num to decrease>, id_1: <...>, ... }
     std::map<PageId, std::pair<PageVersion, Int64>> normal_entries_to_deref;
-    // Iterate all page_id and try to clean up useless var entries
-    while (true)
+    // Iterate all page_id and try to clean up useless var entries, shard by shard
+    for (size_t shard_idx = 0; shard_idx < mvcc_table_directory.numShards(); ++shard_idx)
     {
-        // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
-        // do gc on the version list without lock on `mvcc_table_directory`.
-        const bool all_deleted = iter->second->cleanOutdatedEntries(
-            lowest_seq,
-            &normal_entries_to_deref,
-            options.need_removed_entries ? &all_del_entries : nullptr,
-            options.remote_valid_sizes,
-            iter->second->acquireLock());
+        auto & shard = mvcc_table_directory.shard(shard_idx);
+        typename MVCCMapType::MapType::iterator iter;
+        {
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.begin();
+            if (iter == shard.map.end())
+                continue;
+        }
 
+        while (true)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            if (all_deleted)
-            {
-                iter = mvcc_table_directory.erase(iter);
-                invalid_page_nums++;
-            }
-            else
+            // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
+            // do gc on the version list without lock on `mvcc_table_directory`.
+            const bool all_deleted = iter->second->cleanOutdatedEntries(
+                lowest_seq,
+                &normal_entries_to_deref,
+                options.need_removed_entries ? &all_del_entries : nullptr,
+                options.remote_valid_sizes,
+                iter->second->acquireLock());
+
             {
-                valid_page_nums++;
-                iter++;
-            }
+                std::unique_lock write_lock(shard.mutex);
+                if (all_deleted)
+                {
+                    iter = shard.map.erase(iter);
+                    invalid_page_nums++;
+                }
+                else
+                {
+                    valid_page_nums++;
+                    iter++;
+                }
 
-            if (iter == mvcc_table_directory.end())
-                break;
+                if (iter == shard.map.end())
+                    break;
+            }
         }
     }
 
@@ -2241,11 +2224,12 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     // Iterate all page_id that need to decrease ref count of specified version.
     for (const auto & [page_id, deref_counter] : normal_entries_to_deref)
     {
-        typename MVCCMapType::iterator iter;
+        auto & shard = mvcc_table_directory.shardOf(page_id);
+        typename MVCCMapType::MapType::iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(page_id);
-            if (iter == mvcc_table_directory.end())
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.find(page_id);
+            if (iter == shard.map.end())
                 continue;
         }
 
@@ -2258,8 +2242,8 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
 
         if (all_deleted)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            mvcc_table_directory.erase(iter);
+            std::unique_lock write_lock(shard.mutex);
+            shard.map.erase(iter);
             invalid_page_nums++;
             valid_page_nums--;
         }
@@ -2298,29 +2282,16 @@ typename PageDirectory<Trait>::PageEntriesEdit PageDirectory<Trait>::dumpSnapsho
     }
 
     PageEntriesEdit edit;
-
-    PageId iter_k;
-    VersionedPageEntriesPtr iter_v;
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        auto iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return edit;
-        iter_k = iter->first;
-        iter_v = iter->second;
-    }
-    while (true)
-    {
+    mvcc_table_directory.traverseUnlocked([&](const PageId & iter_k, const VersionedPageEntriesPtr & iter_v) {
         iter_v->collapseTo(snap->sequence, iter_k, edit);
-
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.upper_bound(iter_k);
-            if (iter == mvcc_table_directory.end())
-                break;
-            iter_k = iter->first;
-            iter_v = iter->second;
-        }
+    });
+    if (mvcc_table_directory.numShards() > 1)
+    {
+        // Keep the records ordered by page id as the same as dumping from one shard
+        auto & records = edit.getMutRecords();
+        std::stable_sort(records.begin(), records.end(), [](const auto & lhs, const auto & rhs) {
+            return lhs.page_id < rhs.page_id;
+        });
     }
 
     LOG_INFO(log, "Dumped snapshot to edits, sequence={} edit_size={}", snap->sequence, edit.size());
@@ -2332,13 +2303,17 @@ size_t PageDirectory<Trait>::numPagesWithPrefix(const String & prefix) const
 {
     if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
     {
-        std::shared_lock read_lock(table_rw_mutex);
         size_t num = 0;
-        for (auto iter = mvcc_table_directory.lower_bound(prefix); iter != mvcc_table_directory.end(); ++iter)
+        for (size_t i = 0; i < mvcc_table_directory.numShards(); ++i)
         {
-            if (!iter->first.hasPrefix(prefix))
-                break;
-            num++;
+            const auto & shard = mvcc_table_directory.shard(i);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(prefix); iter != shard.map.end(); ++iter)
+            {
+                if (!iter->first.hasPrefix(prefix))
+                    break;
+                num++;
+            }
         }
         return num;
     }
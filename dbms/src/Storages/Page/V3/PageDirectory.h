@@ -24,6 +24,7 @@
 #include <Storages/Page/V3/MapUtils.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory/ExternalIdsByNamespace.h>
+#include <Storages/Page/V3/PageDirectory/MVCCMapShards.h>
 #include <Storages/Page/V3/PageEntriesEdit.h>
 #include <Storages/Page/V3/PageEntry.h>
 #include <Storages/Page/V3/WAL/serialize.h>
@@ -452,7 +453,8 @@ public:
     explicit PageDirectory(
         String storage_name,
         WALStorePtr && wal,
-        UInt64 max_persisted_log_files_ = MAX_PERSISTED_LOG_FILES);
+        UInt64 max_persisted_log_files_ = MAX_PERSISTED_LOG_FILES,
+        size_t num_shards = 1);
 
     PageDirectorySnapshotPtr createSnapshot(const String & tracing_id = "") const;
 
@@ -545,11 +547,9 @@ public:
     PageEntriesEdit dumpSnapshotToEdit(PageDirectorySnapshotPtr snap = nullptr);
 
     // Approximate number of pages in memory
-    size_t numPages() const
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        return mvcc_table_directory.size();
-    }
+    size_t numPages() const { return mvcc_table_directory.size(); }
+
+    size_t numShards() const { return mvcc_table_directory.numShards(); }
     // Only used in test
     size_t numPagesWithPrefix(const String & prefix) const;
 
@@ -581,14 +581,13 @@ private:
         bool throw_on_not_exist) const;
 
 private:
-    // Only `std::map` is allow for `MVCCMap`. Cause `std::map::insert` ensure that
-    // "No iterators or references are invalidated"
-    // https://en.cppreference.com/w/cpp/container/map/insert
     using VersionedPageEntriesPtr = std::shared_ptr<VersionedPageEntries<Trait>>;
-    using MVCCMapType = std::map<PageId, VersionedPageEntriesPtr>;
+    using MVCCMapType = MVCCMapShards<PageId, VersionedPageEntriesPtr>;
+    // Return the version list of page id, or nullptr if not exist
+    using FindVersionListFunc = std::function<VersionedPageEntriesPtr(const PageId &)>;
 
     static void applyRefEditRecord(
-        MVCCMapType & mvcc_table_directory,
+        const FindVersionListFunc & find_version_list,
         const VersionedPageEntriesPtr & version_list,
         const typename PageEntriesEdit::EditRecord & rec,
         const PageVersion & version);
@@ -637,8 +636,9 @@ private:
     //   2. it becomes the head of the queue, so it continue to finish the write process of the leader;
     std::deque<Writer *> writers;
 
-    // Used to protect mvcc_table_directory between apply threads and read threads
-    mutable std::shared_mutex table_rw_mutex;
+    // Each shard of mvcc_table_directory has its own lock to protect it between
+    // apply threads and read threads. The apply thread only locks the shards touched
+    // by the edit.
     MVCCMapType mvcc_table_directory;
 
     mutable std::mutex snapshots_mutex;
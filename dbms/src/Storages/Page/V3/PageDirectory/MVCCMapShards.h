@@ -0,0 +1,158 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/nocopyable.h>
+#include <common/types.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace DB::PS::V3
+{
+// The in-memory index from page id to its version list used by `PageDirectory`.
+//
+// Pages are distributed into `numShards()` shards by the hash of page id. Each shard is an
+// ordered map protected by its own lock, so that the readers, the writer and the GC thread
+// working on different shards do not contend on one lock. With only one shard, it behaves the
+// same as a single map behind a single lock.
+//
+// Only `std::map` is allowed for a shard. Cause `std::map::insert` ensure that
+// "No iterators or references are invalidated"
+// https://en.cppreference.com/w/cpp/container/map/insert
+//
+// Note that page ids are only ordered inside a shard. Callers that depend on the global
+// order should merge or sort the results of all shards by themselves.
+template <typename PageId, typename Value>
+class MVCCMapShards
+{
+public:
+    using MapType = std::map<PageId, Value>;
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        MapType map;
+    };
+
+    static constexpr size_t MAX_SHARDS = 256;
+
+    explicit MVCCMapShards(size_t num_shards)
+        : shards(std::clamp<size_t>(num_shards, 1, MAX_SHARDS))
+    {}
+
+    DISALLOW_COPY_AND_MOVE(MVCCMapShards);
+
+    size_t numShards() const { return shards.size(); }
+
+    size_t shardIndex(const PageId & page_id) const
+    {
+        if (shards.size() == 1)
+            return 0;
+        return std::hash<PageId>()(page_id) % shards.size();
+    }
+
+    Shard & shard(size_t index) { return shards[index]; }
+    const Shard & shard(size_t index) const { return shards[index]; }
+
+    Shard & shardOf(const PageId & page_id) { return shards[shardIndex(page_id)]; }
+    const Shard & shardOf(const PageId & page_id) const { return shards[shardIndex(page_id)]; }
+
+    // Return the value of `page_id`, or a default constructed value if not exist.
+    // Acquire the read lock of its shard.
+    Value find(const PageId & page_id) const
+    {
+        const auto & s = shardOf(page_id);
+        std::shared_lock read_lock(s.mutex);
+        if (auto iter = s.map.find(page_id); iter != s.map.end())
+            return iter->second;
+        return Value{};
+    }
+
+    // Approximate number of pages
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const auto & s : shards)
+        {
+            std::shared_lock read_lock(s.mutex);
+            total += s.map.size();
+        }
+        return total;
+    }
+
+    // Return a copy of all pages ordered by page id, acquiring the read lock of each shard in turn.
+    // Only for the tools iterating the whole directory.
+    MapType copyAll() const
+    {
+        MapType all;
+        traverse([&](const PageId & page_id, const Value & value) { all.emplace(page_id, value); });
+        return all;
+    }
+
+    // Call `f(page_id, value)` for all pages shard by shard, holding the read lock
+    // of each shard during its iteration.
+    template <typename F>
+    void traverse(F && f) const
+    {
+        for (const auto & s : shards)
+        {
+            std::shared_lock read_lock(s.mutex);
+            for (const auto & [page_id, value] : s.map)
+                f(page_id, value);
+        }
+    }
+
+    // Call `f(page_id, value)` for all pages shard by shard. Unlike `traverse`, the read lock
+    // is only held when seeking the next page, so that `f` can be a heavy operation without
+    // blocking the writer. Pages inserted or removed concurrently may or may not be visited.
+    template <typename F>
+    void traverseUnlocked(F && f) const
+    {
+        for (const auto & s : shards)
+        {
+            PageId page_id;
+            Value value;
+            {
+                std::shared_lock read_lock(s.mutex);
+                auto iter = s.map.begin();
+                if (iter == s.map.end())
+                    continue;
+                page_id = iter->first;
+                value = iter->second;
+            }
+            while (true)
+            {
+                f(page_id, value);
+
+                std::shared_lock read_lock(s.mutex);
+                auto iter = s.map.upper_bound(page_id);
+                if (iter == s.map.end())
+                    break;
+                page_id = iter->first;
+                value = iter->second;
+            }
+        }
+    }
+
+private:
+    std::vector<Shard> shards;
+};
+
+} // namespace DB::PS::V3
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/Stopwatch.h>
+#include <Common/ThreadManager.h>
+#include <Common/TiFlashMetrics.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory.h>
 #include <Storages/Page/V3/PageDirectoryFactory.h>
@@ -23,7 +26,10 @@
 #include <Storages/Page/V3/WALStore.h>
 #include <common/logger_useful.h>
 
+#include <atomic>
+#include <ext/scope_guard.h>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 namespace DB
@@ -34,6 +40,58 @@ extern const int PS_DIR_APPLY_INVALID_STATUS;
 } // namespace ErrorCodes
 namespace PS::V3
 {
+namespace
+{
+// Whether applying the record only touches the version list of its own page
+bool isPageLocalRecord(EditRecordType type)
+{
+    switch (type)
+    {
+    case EditRecordType::REF:
+    case EditRecordType::UPSERT:
+    case EditRecordType::UPDATE_DATA_FROM_REMOTE:
+        return false;
+    default:
+        return true;
+    }
+}
+
+// Run `job(i)` for each i in [0, num_jobs) with at most `num_threads` threads.
+// Rethrow the first exception after all threads finish.
+template <typename Job>
+void runInParallel(size_t num_jobs, size_t num_threads, Job && job)
+{
+    std::atomic<size_t> next_job = 0;
+    std::mutex exception_mutex;
+    std::exception_ptr first_exception;
+    auto thread_manager = newThreadManager();
+    for (size_t i = 0; i < std::min(num_jobs, num_threads); ++i)
+    {
+        thread_manager->schedule(false, "PSRestore", [&] {
+            try
+            {
+                for (size_t job_idx = next_job++; job_idx < num_jobs; job_idx = next_job++)
+                    job(job_idx);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(exception_mutex);
+                if (!first_exception)
+                    first_exception = std::current_exception();
+                // Stop other threads from picking new jobs
+                next_job = num_jobs;
+            }
+        });
+    }
+    thread_manager->wait();
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
+// Apply the pending records in the caller thread if there are only a few of them
+constexpr size_t MIN_RECORDS_TO_APPLY_CONCURRENTLY = 4096;
+} // namespace
+
 template <typename Trait>
 typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trait>::create(
     const String & storage_name,
@@ -51,7 +109,11 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trai
     WALStoreReaderPtr reader,
     WALStorePtr wal)
 {
-    PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(storage_name, std::move(wal));
+    PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(
+        storage_name,
+        std::move(wal),
+        MAX_PERSISTED_LOG_FILES,
+        num_shards);
     loadFromDisk(dir, std::move(reader));
 
     // Reset the `sequence` to the maximum of persisted.
@@ -77,7 +139,11 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trai
     const String & storage_name,
     PageEntriesEdit & edit)
 {
-    PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(std::move(storage_name), nullptr);
+    PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(
+        std::move(storage_name),
+        nullptr,
+        MAX_PERSISTED_LOG_FILES,
+        num_shards);
 
     loadEdit(dir, edit, /*force_apply*/ true);
     // Reset the `sequence` to the maximum of persisted.
@@ -100,7 +166,11 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trai
 {
     auto [wal, reader] = WALStore::create(storage_name, file_provider, delegator, WALConfig());
     (void)reader;
-    PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(storage_name, std::move(wal));
+    PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(
+        storage_name,
+        std::move(wal),
+        MAX_PERSISTED_LOG_FILES,
+        num_shards);
 
     // Allocate mock sequence to run gc
     UInt64 mock_sequence = 0;
@@ -139,8 +209,7 @@ void PageDirectoryFactory<Trait>::restoreBlobStats(const PageDirectoryPtr & dir)
     // the latest entry to `blob_stats`, or we may meet error since
     // some entries may be removed in memory but not get compacted
     // in the log file.
-    for (const auto & [page_id, entries] : dir->mvcc_table_directory)
-    {
+    dir->mvcc_table_directory.traverse([&](const auto & page_id, const auto & entries) {
         // We should restore the entry to `blob_stats` even if it is marked as "deleted",
         // or we will mistakenly reuse the space to write other blobs down into that space.
         // So we need to use `getLastEntry` instead of `getEntry(version)` here.
@@ -148,7 +217,7 @@ void PageDirectoryFactory<Trait>::restoreBlobStats(const PageDirectoryPtr & dir)
         {
             auto [success, details_msg] = blob_stats->restoreByEntry(*entry);
             if (success)
-                continue;
+                return;
 
             // Restore entry to blob_stats fail, if the entry->size == 0,
             // it is acceptable. Just ingore.
@@ -177,7 +246,7 @@ void PageDirectoryFactory<Trait>::restoreBlobStats(const PageDirectoryPtr & dir)
                     *entry);
             }
         }
-    }
+    });
 
     blob_stats->restore();
 }
@@ -187,7 +256,8 @@ void PageDirectoryFactory<Trait>::loadEdit(
     const PageDirectoryPtr & dir,
     const PageEntriesEdit & edit,
     bool force_apply,
-    UInt64 filter_seq)
+    UInt64 filter_seq,
+    PendingRecords * pending_records)
 {
     // Relax some check at the beginning
     bool strict_check = false;
@@ -214,7 +284,18 @@ void PageDirectoryFactory<Trait>::loadEdit(
 
             if (max_applied_ver < r.version)
                 max_applied_ver = r.version;
+            updateMaxIdByRecord(dir, r);
 
+            if (pending_records != nullptr)
+            {
+                if (isPageLocalRecord(r.type))
+                {
+                    pending_records->emplace_back(PendingRecord{&r, strict_check});
+                    continue;
+                }
+                // The record depends on other pages, all records before it must be applied first
+                applyPendingRecords(dir, *pending_records);
+            }
             applyRecord(dir, r, strict_check);
             continue;
         }
@@ -224,17 +305,52 @@ void PageDirectoryFactory<Trait>::loadEdit(
             max_applied_ver = r.version;
         LOG_INFO(Logger::get(), "{}", r);
         if (debug.apply_entries_to_directory)
+        {
+            updateMaxIdByRecord(dir, r);
             applyRecord(dir, r, strict_check);
+        }
     }
 }
 
+template <typename Trait>
+void PageDirectoryFactory<Trait>::applyPendingRecords(
+    const PageDirectoryPtr & dir,
+    PendingRecords & pending_records) const
+{
+    const size_t num_buckets = std::min(restore_threads, dir->mvcc_table_directory.numShards());
+    if (num_buckets <= 1 || pending_records.size() < MIN_RECORDS_TO_APPLY_CONCURRENTLY)
+    {
+        for (const auto & pending : pending_records)
+            applyRecord(dir, *pending.record, pending.strict_check);
+    }
+    else
+    {
+        // Each bucket is made up of whole shards. So the records of one page are applied by one
+        // thread in their original order, and different threads never modify the same shard.
+        std::vector<PendingRecords> buckets(num_buckets);
+        for (const auto & pending : pending_records)
+        {
+            const auto shard_idx = dir->mvcc_table_directory.shardIndex(pending.record->page_id);
+            buckets[shard_idx % num_buckets].emplace_back(pending);
+        }
+        runInParallel(num_buckets, num_buckets, [&](size_t bucket_idx) {
+            for (const auto & pending : buckets[bucket_idx])
+                applyRecord(dir, *pending.record, pending.strict_check, /*concurrent*/ true);
+        });
+    }
+    pending_records.clear();
+}
+
 template <typename Trait>
 void PageDirectoryFactory<Trait>::applyRecord(
     const PageDirectoryPtr & dir,
     const typename PageEntriesEdit::EditRecord & r,
-    bool strict_check)
+    bool strict_check,
+    bool concurrent)
 {
-    auto [iter, created] = dir->mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
+    // No need to lock the shard, a shard is only modified by one thread when restoring
+    auto & map = dir->mvcc_table_directory.shardOf(r.page_id).map;
+    auto [iter, created] = map.insert(std::make_pair(r.page_id, nullptr));
     if (created)
     {
         if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
@@ -247,8 +363,6 @@ void PageDirectoryFactory<Trait>::applyRecord(
         }
     }
 
-    updateMaxIdByRecord(dir, r);
-
     const auto & version_list = iter->second;
     const auto & restored_version = r.version;
     try
@@ -262,7 +376,10 @@ void PageDirectoryFactory<Trait>::applyRecord(
             if (holder)
             {
                 *holder = r.page_id;
-                dir->external_ids_by_ns.addExternalIdUnlock(holder);
+                if (concurrent)
+                    dir->external_ids_by_ns.addExternalId(holder);
+                else
+                    dir->external_ids_by_ns.addExternalIdUnlock(holder);
             }
             break;
         }
@@ -275,7 +392,10 @@ void PageDirectoryFactory<Trait>::applyRecord(
             if (holder)
             {
                 *holder = r.page_id;
-                dir->external_ids_by_ns.addExternalIdUnlock(holder);
+                if (concurrent)
+                    dir->external_ids_by_ns.addExternalId(holder);
+                else
+                    dir->external_ids_by_ns.addExternalIdUnlock(holder);
             }
             break;
         }
@@ -286,10 +406,9 @@ void PageDirectoryFactory<Trait>::applyRecord(
         {
             auto id_to_resolve = r.page_id;
             auto sequence_to_resolve = restored_version.sequence;
-            auto version_list_iter = iter;
+            auto current_version_list = version_list;
             while (true)
             {
-                const auto & current_version_list = version_list_iter->second;
                 // We need to ignore the "deletes" both when resolve page id and update local cache.
                 // Check `PageDirectory::getByIDImpl` or the unit test
                 // `UniPageStorageRemoteReadTest.WriteReadRefWithRestart` for details.
@@ -313,8 +432,8 @@ void PageDirectoryFactory<Trait>::applyRecord(
                 {
                     RUNTIME_CHECK(false);
                 }
-                version_list_iter = dir->mvcc_table_directory.lower_bound(id_to_resolve);
-                assert(version_list_iter != dir->mvcc_table_directory.end());
+                current_version_list = dir->mvcc_table_directory.find(id_to_resolve);
+                assert(current_version_list != nullptr);
             }
             break;
         }
@@ -323,7 +442,11 @@ void PageDirectoryFactory<Trait>::applyRecord(
             version_list->createDelete(restored_version);
             break;
         case EditRecordType::REF:
-            Trait::PageDirectory::applyRefEditRecord(dir->mvcc_table_directory, version_list, r, restored_version);
+            Trait::PageDirectory::applyRefEditRecord(
+                [&dir](const auto & page_id) { return dir->mvcc_table_directory.find(page_id); },
+                version_list,
+                r,
+                restored_version);
             break;
         case EditRecordType::UPSERT:
         {
@@ -331,13 +454,13 @@ void PageDirectoryFactory<Trait>::applyRecord(
             if (Trait::PageIdTrait::getU64ID(id_to_deref) != INVALID_PAGE_U64_ID)
             {
                 // The ref-page is rewritten into a normal page, we need to decrease the ref-count of the original page
-                auto deref_iter = dir->mvcc_table_directory.find(id_to_deref);
+                auto deref_entries = dir->mvcc_table_directory.find(id_to_deref);
                 RUNTIME_CHECK_MSG(
-                    deref_iter != dir->mvcc_table_directory.end(),
+                    deref_entries != nullptr,
                     "Can't find page to deref when applying upsert, page_id={}",
                     id_to_deref);
                 auto deref_res
-                    = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
+                    = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
                 RUNTIME_ASSERT(!deref_res);
             }
             break;
@@ -380,12 +503,24 @@ void PageDirectoryFactory<Trait>::updateMaxIdByRecord(
 template <typename Trait>
 void PageDirectoryFactory<Trait>::loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader)
 {
+    Stopwatch watch;
+    SCOPE_EXIT({
+        GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_total).Observe(watch.elapsedSeconds());
+    });
+
     DataFileIdSet data_file_ids;
     auto checkpoint_snap_seq = reader->getSnapSeqForCheckpoint();
     // make sure the max sequence is larger or equal than the checkpoint sequence
     if (max_applied_ver.sequence < checkpoint_snap_seq)
         max_applied_ver = PageVersion(checkpoint_snap_seq, 0);
 
+    // Keep the debug tool simple, it always restores in the caller thread
+    if (restore_threads > 1 && likely(!debug.dump_entries))
+    {
+        loadFromDiskParallel(dir, *reader, checkpoint_snap_seq);
+        return;
+    }
+
     while (reader->remained())
     {
         auto [from_checkpoint, record] = reader->next();
@@ -419,6 +554,61 @@ void PageDirectoryFactory<Trait>::loadFromDisk(const PageDirectoryPtr & dir, WAL
     }
 }
 
+template <typename Trait>
+void PageDirectoryFactory<Trait>::loadFromDiskParallel(
+    const PageDirectoryPtr & dir,
+    WALStoreReader & reader,
+    UInt64 checkpoint_snap_seq)
+{
+    // The log files are handled batch by batch to bound the memory usage. The files in
+    // one batch are read and decoded concurrently, one thread per file. Then the edits
+    // are loaded in the order of log files, and the page-local records are applied to
+    // different shards concurrently, see `applyPendingRecords`.
+    // Note that the checkpoint file contains only one record, so decoding it can not be
+    // split into multiple threads, but applying it can.
+    const auto files = reader.getFilesToRead();
+    double read_seconds = 0;
+    double apply_seconds = 0;
+    Stopwatch watch;
+    PendingRecords pending_records;
+    for (size_t batch_begin = 0; batch_begin < files.size(); batch_begin += restore_threads)
+    {
+        const size_t batch_size = std::min(restore_threads, files.size() - batch_begin);
+        std::vector<std::vector<PageEntriesEdit>> edits_by_file(batch_size);
+        runInParallel(batch_size, restore_threads, [&](size_t file_idx) {
+            DataFileIdSet data_file_ids;
+            reader.readAllRecords(files[batch_begin + file_idx].second, [&](String && record) {
+                if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
+                    edits_by_file[file_idx].emplace_back(Trait::Serializer::deserializeFrom(record, nullptr));
+                else
+                    edits_by_file[file_idx].emplace_back(Trait::Serializer::deserializeFrom(record, &data_file_ids));
+            });
+        });
+        read_seconds += watch.elapsedSecondsFromLastTime();
+
+        for (size_t file_idx = 0; file_idx < batch_size; ++file_idx)
+        {
+            const bool from_checkpoint = files[batch_begin + file_idx].first;
+            for (const auto & edit : edits_by_file[file_idx])
+                loadEdit(dir, edit, from_checkpoint, checkpoint_snap_seq, &pending_records);
+        }
+        // The pending records refer to the edits of this batch
+        applyPendingRecords(dir, pending_records);
+        apply_seconds += watch.elapsedSecondsFromLastTime();
+    }
+
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_read_wal).Observe(read_seconds);
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_apply).Observe(apply_seconds);
+    LOG_INFO(
+        Logger::get(),
+        "Restore from WAL in parallel, n_files={} restore_threads={} n_shards={} read_cost={:.3f}s apply_cost={:.3f}s",
+        files.size(),
+        restore_threads,
+        dir->mvcc_table_directory.numShards(),
+        read_seconds,
+        apply_seconds);
+}
+
 template class PageDirectoryFactory<u128::FactoryTrait>;
 template class PageDirectoryFactory<universal::FactoryTrait>;
 } // namespace PS::V3
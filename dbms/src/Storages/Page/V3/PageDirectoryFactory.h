@@ -51,6 +51,21 @@ public:
         return *this;
     }
 
+    // The number of shards of the in-memory page directory, see `MVCCMapShards`
+    PageDirectoryFactory<Trait> & setNumShards(size_t num_shards_)
+    {
+        num_shards = num_shards_;
+        return *this;
+    }
+
+    // The number of threads used for reading the WAL files and applying the edits
+    // when restoring. Restore in the caller thread if it is not larger than 1.
+    PageDirectoryFactory<Trait> & setRestoreThreads(size_t restore_threads_)
+    {
+        restore_threads = restore_threads_;
+        return *this;
+    }
+
     PageDirectoryPtr create(
         const String & storage_name,
         FileProviderPtr & file_provider,
@@ -78,18 +93,40 @@ public:
     }
 
 private:
+    // The records that only modify the version list of its own page, which are
+    // buffered and applied to different shards concurrently
+    struct PendingRecord
+    {
+        const typename PageEntriesEdit::EditRecord * record;
+        bool strict_check;
+    };
+    using PendingRecords = std::vector<PendingRecord>;
+
     void loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader);
-    void loadEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit, bool force_apply, UInt64 filter_seq = 0);
+    void loadFromDiskParallel(const PageDirectoryPtr & dir, WALStoreReader & reader, UInt64 checkpoint_snap_seq);
+    void loadEdit(
+        const PageDirectoryPtr & dir,
+        const PageEntriesEdit & edit,
+        bool force_apply,
+        UInt64 filter_seq = 0,
+        PendingRecords * pending_records = nullptr);
+    void applyPendingRecords(const PageDirectoryPtr & dir, PendingRecords & pending_records) const;
+    // `concurrent` means other shards are being applied by other threads at the same time
     static void applyRecord(
         const PageDirectoryPtr & dir,
         const typename PageEntriesEdit::EditRecord & r,
-        bool strict_check);
+        bool strict_check,
+        bool concurrent = false);
     static void updateMaxIdByRecord(const PageDirectoryPtr & dir, const typename PageEntriesEdit::EditRecord & r);
 
     void restoreBlobStats(const PageDirectoryPtr & dir);
 
     BlobStats * blob_stats = nullptr;
 
+    size_t num_shards = 1;
+
+    size_t restore_threads = 1;
+
     // For debug tool
     template <typename T>
     friend class PageStorageControlV3;
@@ -68,8 +68,10 @@ void PageStorageImpl::restore()
     blob_store.registerPaths();
 
     u128::PageDirectoryFactory factory;
-    page_directory
-        = factory.setBlobStore(blob_store).create(storage_name, file_provider, delegator, WALConfig::from(config));
+    page_directory = factory.setBlobStore(blob_store)
+                         .setNumShards(config.dir_num_shards)
+                         .setRestoreThreads(config.dir_restore_threads)
+                         .create(storage_name, file_provider, delegator, WALConfig::from(config));
 }
 
 PageIdU64 PageStorageImpl::getMaxId()
@@ -87,6 +87,8 @@ void UniversalPageStorage::restore()
 
     PS::V3::universal::PageDirectoryFactory factory;
     page_directory = factory.setBlobStore(*blob_store)
+                         .setNumShards(config.dir_num_shards)
+                         .setRestoreThreads(config.dir_restore_threads)
                          .create(storage_name, file_provider, delegator, PS::V3::WALConfig::from(config));
 }
 
@@ -265,6 +265,32 @@ std::pair<bool, std::optional<String>> WALStoreReader::next()
     } while (true);
 }
 
+std::vector<std::pair<bool, LogFilename>> WALStoreReader::getFilesToRead() const
+{
+    std::vector<std::pair<bool, LogFilename>> files;
+    files.reserve(files_to_read.size() + 1);
+    if (checkpoint_file)
+        files.emplace_back(true, *checkpoint_file);
+    for (const auto & filename : files_to_read)
+        files.emplace_back(false, filename);
+    return files;
+}
+
+void WALStoreReader::readAllRecords(const LogFilename & filename, const std::function<void(String &&)> & handler)
+{
+    // Use a standalone reporter, the corruption is thrown as an exception anyway
+    ReportCollector file_reporter;
+    auto log_reader = createLogReader(filename, provider, &file_reporter, recovery_mode, read_limiter, logger);
+    while (true)
+    {
+        auto [ok, record] = log_reader->readRecord();
+        if (!ok)
+            break;
+
+        handler(std::move(record));
+    }
+}
+
 bool WALStoreReader::openNextFile()
 {
     if (checkpoint_reader_created && next_reading_file == files_to_read.end())
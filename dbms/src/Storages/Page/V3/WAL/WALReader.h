@@ -20,6 +20,8 @@
 #include <Storages/Page/V3/LogFile/LogReader.h>
 #include <Storages/Page/V3/WALStore.h>
 
+#include <functional>
+
 namespace DB
 {
 namespace ErrorCodes
@@ -89,6 +91,15 @@ public:
     // std::pair<from_checkpoint, record>
     std::pair<bool, std::optional<String>> next();
 
+    // All log files to be read in order, std::pair<from_checkpoint, filename>.
+    // The checkpoint file comes first if exists.
+    std::vector<std::pair<bool, LogFilename>> getFilesToRead() const;
+
+    // Read all records in `filename` and call `handler` on each of them in order.
+    // It does not move the reading position of `next`, and different files can
+    // be read concurrently.
+    void readAllRecords(const LogFilename & filename, const std::function<void(String &&)> & handler);
+
     void throwIfError() const
     {
         if (reporter.hasError())
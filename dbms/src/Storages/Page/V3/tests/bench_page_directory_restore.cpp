@@ -0,0 +1,99 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Debug/TiFlashTestEnv.h>
+#include <Storages/Page/PageDefinesBase.h>
+#include <Storages/Page/V3/PageDirectory.h>
+#include <Storages/Page/V3/PageDirectoryFactory.h>
+#include <Storages/Page/V3/PageEntriesEdit.h>
+#include <TestUtils/MockDiskDelegator.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+namespace DB::PS::V3::tests
+{
+namespace
+{
+constexpr NamespaceID BENCH_NAMESPACE_ID = 100;
+constexpr size_t BENCH_NUM_SHARDS = 16;
+
+WALConfig getWALConfig()
+{
+    WALConfig config;
+    // Roll the log file frequently to generate many log files
+    config.roll_size = 4 * 1024 * 1024;
+    return config;
+}
+
+u128::PageDirectoryPtr restore(const String & path, size_t restore_threads)
+{
+    auto provider = DB::tests::TiFlashTestEnv::getDefaultFileProvider();
+    PSDiskDelegatorPtr delegator = std::make_shared<DB::tests::MockDiskDelegatorSingle>(path);
+    u128::PageDirectoryFactory factory;
+    return factory.setNumShards(BENCH_NUM_SHARDS)
+        .setRestoreThreads(restore_threads)
+        .create("bench_page_directory_restore", provider, delegator, getWALConfig());
+}
+
+// Write 1M pages with some refs and deletes, then dump a checkpoint in the middle,
+// so that both the checkpoint and the normal log files are restored.
+const String & prepareWAL()
+{
+    static const String path = [] {
+        auto path = DB::tests::TiFlashTestEnv::getTemporaryPath("bench_page_directory_restore");
+        DB::tests::TiFlashTestEnv::tryRemovePath(path, /*recreate*/ true);
+        auto dir = restore(path, 1);
+
+        constexpr PageIdU64 num_pages = 1000000;
+        constexpr PageIdU64 pages_per_edit = 1000;
+        auto write_pages = [&](PageIdU64 begin, PageIdU64 end) {
+            for (PageIdU64 edit_begin = begin; edit_begin < end; edit_begin += pages_per_edit)
+            {
+                u128::PageEntriesEdit edit;
+                for (PageIdU64 i = edit_begin; i < edit_begin + pages_per_edit; ++i)
+                    edit.put(
+                        buildV3Id(BENCH_NAMESPACE_ID, i),
+                        PageEntryV3{.file_id = 1, .size = 100, .offset = i * 100, .checksum = 0x4567});
+                for (PageIdU64 i = edit_begin; i < edit_begin + pages_per_edit; i += 100)
+                    edit.ref(buildV3Id(BENCH_NAMESPACE_ID, num_pages + i), buildV3Id(BENCH_NAMESPACE_ID, i));
+                for (PageIdU64 i = edit_begin; i < edit_begin + pages_per_edit; i += 10)
+                    edit.del(buildV3Id(BENCH_NAMESPACE_ID, i));
+                dir->apply(std::move(edit));
+            }
+        };
+        write_pages(0, num_pages / 2);
+        dir->tryDumpSnapshot(nullptr, true);
+        write_pages(num_pages / 2, num_pages);
+        return path;
+    }();
+    return path;
+}
+
+void RestorePageDirectory(benchmark::State & state)
+try
+{
+    const size_t restore_threads = state.range(0);
+    const auto & path = prepareWAL();
+    for (auto _ : state)
+    {
+        auto dir = restore(path, restore_threads);
+        benchmark::DoNotOptimize(dir);
+    }
+}
+CATCH
+
+BENCHMARK(RestorePageDirectory)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace DB::PS::V3::tests
@@ -14,6 +14,7 @@
 
 #include <Common/FailPoint.h>
 #include <Common/Logger.h>
+#include <IO/BaseFile/IOUring.h>
 #include <IO/BaseFile/RateLimiter.h>
 #include <IO/Buffer/ReadBufferFromMemory.h>
 #include <Poco/Logger.h>
@@ -33,6 +34,11 @@
 
 #include <ext/scope_guard.h>
 
+namespace ProfileEvents
+{
+extern const Event PSMReadBytes;
+} // namespace ProfileEvents
+
 namespace DB::FailPoints
 {
 extern const char exception_after_large_write_exceed[];
@@ -1256,6 +1262,88 @@ try
 }
 CATCH
 
+TEST_F(BlobStoreTest, ReadBatch)
+try
+{
+    const auto file_provider = DB::tests::TiFlashTestEnv::getDefaultFileProvider();
+    constexpr size_t num_batches = 10;
+    constexpr size_t pages_per_batch = 10;
+    constexpr size_t buff_size = 100;
+
+    // Limit the file size so that the pages are written into multiple BlobFiles
+    BlobConfig config_with_small_file_limit_size;
+    config_with_small_file_limit_size.file_limit_size = pages_per_batch * buff_size;
+    auto blob_store = BlobStore(
+        getCurrentTestName(),
+        file_provider,
+        delegator,
+        config_with_small_file_limit_size,
+        page_type_and_config);
+
+    char c_buff[num_batches * pages_per_batch * buff_size];
+    for (size_t i = 0; i < sizeof(c_buff); ++i)
+        c_buff[i] = static_cast<char>(i * 7 + i / 101);
+
+    PageIDAndEntriesV3 entries;
+    BlobStore::FieldReadInfos read_infos;
+    std::set<BlobFileId> blob_ids;
+    for (size_t batch = 0; batch < num_batches; ++batch)
+    {
+        WriteBatch wb;
+        for (size_t i = 0; i < pages_per_batch; ++i)
+        {
+            const PageIdU64 page_id = batch * pages_per_batch + i;
+            ReadBufferPtr buff = std::make_shared<ReadBufferFromMemory>(c_buff + page_id * buff_size, buff_size);
+            wb.putPage(page_id, /* tag */ 0, buff, buff_size, PageFieldSizes{10, 20, 30, 40});
+        }
+        PageEntriesEdit edit = blob_store.write(std::move(wb));
+        for (const auto & record : edit.getRecords())
+        {
+            entries.emplace_back(record.page_id, record.entry);
+            read_infos.emplace_back(record.page_id, record.entry, std::vector<size_t>{1, 3});
+            blob_ids.emplace(record.entry.file_id);
+        }
+    }
+    ASSERT_GT(blob_ids.size(), 1);
+
+    auto check_pages = [&]() {
+        auto page_map = blob_store.read(entries);
+        ASSERT_EQ(page_map.size(), num_batches * pages_per_batch);
+        for (const auto & [page_id, page] : page_map)
+        {
+            ASSERT_EQ(page.data.size(), buff_size);
+            ASSERT_EQ(memcmp(c_buff + page_id * buff_size, page.data.data(), buff_size), 0) << page_id;
+        }
+
+        auto field_page_map = blob_store.read(read_infos);
+        ASSERT_EQ(field_page_map.size(), num_batches * pages_per_batch);
+        for (const auto & [page_id, page] : field_page_map)
+        {
+            ASSERT_EQ(page.fieldSize(), 2);
+            ASSERT_EQ(page.getFieldData(1).size(), 20);
+            ASSERT_EQ(memcmp(c_buff + page_id * buff_size + 10, page.getFieldData(1).data(), 20), 0) << page_id;
+            ASSERT_EQ(page.getFieldData(3).size(), 40);
+            ASSERT_EQ(memcmp(c_buff + page_id * buff_size + 60, page.getFieldData(3).data(), 40), 0) << page_id;
+        }
+    };
+
+    // Read one by one
+    auto read_bytes_before = ProfileEvents::get(ProfileEvents::PSMReadBytes);
+    check_pages();
+    const auto read_bytes_one_by_one = ProfileEvents::get(ProfileEvents::PSMReadBytes) - read_bytes_before;
+    ASSERT_GT(read_bytes_one_by_one, 0);
+
+    // Read by io_uring, fall back to read one by one if io_uring is not available
+    LOG_INFO(Logger::get(), "io_uring supported={}", IOUring::isSupported());
+    config_with_small_file_limit_size.read_use_io_uring = true;
+    blob_store.reloadConfig(config_with_small_file_limit_size);
+    read_bytes_before = ProfileEvents::get(ProfileEvents::PSMReadBytes);
+    check_pages();
+    // The bytes finished by the fallback read should not be counted twice
+    ASSERT_EQ(ProfileEvents::get(ProfileEvents::PSMReadBytes) - read_bytes_before, read_bytes_one_by_one);
+}
+CATCH
+
 TEST_F(BlobStoreTest, LargeWrite)
 try
 {
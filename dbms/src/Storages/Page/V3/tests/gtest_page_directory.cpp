@@ -14,6 +14,7 @@
 
 #include <Common/Exception.h>
 #include <Common/FmtUtils.h>
+#include <Common/Stopwatch.h>
 #include <Common/SyncPoint/Ctl.h>
 #include <Debug/TiFlashTestEnv.h>
 #include <IO/FileProvider/FileProvider.h>
@@ -118,13 +119,18 @@ public:
         dir = restoreFromDisk();
     }
 
-    static u128::PageDirectoryPtr restoreFromDisk()
+    static u128::PageDirectoryPtr restoreFromDisk(
+        size_t num_shards = 1,
+        size_t restore_threads = 1,
+        const WALConfig & config = WALConfig())
     {
         auto path = getTemporaryPath();
         auto provider = DB::tests::TiFlashTestEnv::getDefaultFileProvider();
         PSDiskDelegatorPtr delegator = std::make_shared<DB::tests::MockDiskDelegatorSingle>(path);
         PageDirectoryFactory<u128::FactoryTrait> factory;
-        return factory.create("PageDirectoryTest", provider, delegator, WALConfig());
+        return factory.setNumShards(num_shards)
+            .setRestoreThreads(restore_threads)
+            .create("PageDirectoryTest", provider, delegator, config);
     }
 
 protected:
@@ -3079,6 +3085,168 @@ try
 }
 CATCH
 
+TEST_F(PageDirectoryGCTest, ShardedDirectory)
+try
+{
+    dir = restoreFromDisk(/*num_shards*/ 8);
+    ASSERT_EQ(dir->numShards(), 8);
+
+    constexpr PageIdU64 num_pages = 200;
+    constexpr PageIdU64 ref_id_offset = 1000;
+    auto make_entry = [](PageIdU64 page_id) {
+        return PageEntryV3{.file_id = 1, .size = 10, .padded_size = 0, .tag = 0, .offset = page_id, .checksum = 0x4567};
+    };
+    {
+        PageEntriesEdit edit;
+        for (PageIdU64 i = 0; i < num_pages; ++i)
+            edit.put(buildV3Id(TEST_NAMESPACE_ID, i), make_entry(i));
+        dir->apply(std::move(edit));
+    }
+    for (PageIdU64 i = 0; i < num_pages; i += 3)
+    {
+        // The ref page and the origin page are usually in different shards
+        PageEntriesEdit edit;
+        edit.ref(buildV3Id(TEST_NAMESPACE_ID, ref_id_offset + i), buildV3Id(TEST_NAMESPACE_ID, i));
+        dir->apply(std::move(edit));
+    }
+    {
+        PageEntriesEdit edit;
+        for (PageIdU64 i = 0; i < num_pages / 2; i += 2)
+            edit.del(buildV3Id(TEST_NAMESPACE_ID, i));
+        dir->apply(std::move(edit));
+    }
+
+    auto check_entries = [&](const u128::PageDirectoryPtr & d) {
+        auto snap = d->createSnapshot();
+        for (PageIdU64 i = 0; i < num_pages; ++i)
+        {
+            if (i < num_pages / 2 && i % 2 == 0)
+                EXPECT_ENTRY_NOT_EXIST(d, i, snap);
+            else
+                EXPECT_SAME_ENTRY(make_entry(i), getEntry(d, i, snap));
+            if (i % 3 == 0)
+            {
+                EXPECT_SAME_ENTRY(make_entry(i), getEntry(d, ref_id_offset + i, snap));
+                EXPECT_EQ(getNormalPageIdU64(d, ref_id_offset + i, snap), i);
+            }
+        }
+        EXPECT_EQ(d->getAllPageIds().size(), num_pages - num_pages / 4 + (num_pages + 2) / 3);
+    };
+    check_entries(dir);
+
+    // The dumped records are ordered by page id as the same as a directory without shards
+    auto edit = dir->dumpSnapshotToEdit();
+    const auto & records = edit.getRecords();
+    ASSERT_TRUE(std::is_sorted(records.begin(), records.end(), [](const auto & lhs, const auto & rhs) {
+        return lhs.page_id < rhs.page_id;
+    }));
+
+    // The deleted pages which are not being ref are removed
+    dir->gcInMemEntries({});
+    size_t num_removed = 0;
+    for (PageIdU64 i = 0; i < num_pages / 2; i += 2)
+        num_removed += (i % 3 != 0);
+    EXPECT_EQ(dir->numPages(), num_pages + (num_pages + 2) / 3 - num_removed);
+    check_entries(dir);
+
+    // Restore with or without shards
+    EXPECT_TRUE(dir->tryDumpSnapshot(nullptr, true));
+    for (size_t num_shards : {1, 8, 3})
+    {
+        dir = restoreFromDisk(num_shards);
+        ASSERT_EQ(dir->numShards(), num_shards);
+        check_entries(dir);
+    }
+}
+CATCH
+
+TEST_F(PageDirectoryGCTest, ParallelRestore)
+try
+{
+    // Roll the log file frequently to generate many log files
+    WALConfig config;
+    config.roll_size = 16 * 1024;
+    dir = restoreFromDisk(/*num_shards*/ 8, /*restore_threads*/ 1, config);
+
+    constexpr PageIdU64 num_pages = 20000;
+    constexpr PageIdU64 ref_id_offset = 100000;
+    constexpr PageIdU64 external_id_offset = 200000;
+    auto make_entry = [](PageIdU64 page_id, UInt64 round) {
+        return PageEntryV3{
+            .file_id = 1,
+            .size = 10,
+            .padded_size = 0,
+            .tag = round,
+            .offset = page_id * 10,
+            .checksum = 0x4567};
+    };
+    auto write_pages = [&](UInt64 round) {
+        for (PageIdU64 begin = 0; begin < num_pages; begin += 500)
+        {
+            PageEntriesEdit edit;
+            for (PageIdU64 i = begin; i < begin + 500; ++i)
+                edit.put(buildV3Id(TEST_NAMESPACE_ID, i), make_entry(i, round));
+            dir->apply(std::move(edit));
+        }
+    };
+    write_pages(0);
+    {
+        PageEntriesEdit edit;
+        for (PageIdU64 i = 0; i < num_pages; i += 7)
+            edit.ref(buildV3Id(TEST_NAMESPACE_ID, ref_id_offset + i), buildV3Id(TEST_NAMESPACE_ID, i));
+        for (PageIdU64 i = 0; i < 100; ++i)
+            edit.putExternal(buildV3Id(TEST_NAMESPACE_ID, external_id_offset + i));
+        dir->apply(std::move(edit));
+    }
+    // Dump a checkpoint in the middle, the later log files overlap with the checkpoint
+    EXPECT_TRUE(dir->tryDumpSnapshot(nullptr, true));
+    write_pages(1);
+    write_pages(2);
+    {
+        PageEntriesEdit edit;
+        for (PageIdU64 i = 0; i < num_pages; i += 14)
+            edit.ref(buildV3Id(TEST_NAMESPACE_ID, ref_id_offset + i + 1), buildV3Id(TEST_NAMESPACE_ID, i + 1));
+        for (PageIdU64 i = 0; i < num_pages; i += 3)
+            edit.del(buildV3Id(TEST_NAMESPACE_ID, i));
+        for (PageIdU64 i = 0; i < 100; i += 2)
+            edit.del(buildV3Id(TEST_NAMESPACE_ID, external_id_offset + i));
+        dir->apply(std::move(edit));
+    }
+
+    auto dump_directory = [](const u128::PageDirectoryPtr & d) {
+        Strings records;
+        for (const auto & r : d->dumpSnapshotToEdit().getRecords())
+            records.emplace_back(fmt::format("{}", r));
+        return records;
+    };
+    // Take the directory restored in the caller thread as the expected result
+    dir = restoreFromDisk(/*num_shards*/ 8, /*restore_threads*/ 1, config);
+    const auto expected_records = dump_directory(dir);
+    const auto expected_max_id = dir->getMaxIdAfterRestart();
+    const auto expected_external_ids = dir->getAliveExternalIds(TEST_NAMESPACE_ID);
+    ASSERT_TRUE(expected_external_ids.has_value());
+    ASSERT_EQ(expected_external_ids->size(), 50);
+
+    // Restoring with any number of threads gets the same directory
+    for (size_t restore_threads : {2, 4, 8, 16})
+    {
+        Stopwatch watch;
+        dir = restoreFromDisk(/*num_shards*/ 8, restore_threads, config);
+        LOG_INFO(log, "Restore directory, restore_threads={} cost={:.3f}s", restore_threads, watch.elapsedSeconds());
+        ASSERT_EQ(dump_directory(dir), expected_records) << restore_threads;
+        ASSERT_EQ(dir->getMaxIdAfterRestart(), expected_max_id);
+        ASSERT_EQ(dir->getAliveExternalIds(TEST_NAMESPACE_ID), expected_external_ids);
+
+        auto snap = dir->createSnapshot();
+        EXPECT_ENTRY_NOT_EXIST(dir, 3, snap);
+        EXPECT_SAME_ENTRY(make_entry(1, 2), getEntry(dir, 1, snap));
+        EXPECT_SAME_ENTRY(make_entry(21, 2), getEntry(dir, ref_id_offset + 21, snap));
+        EXPECT_SAME_ENTRY(make_entry(15, 2), getEntry(dir, ref_id_offset + 15, snap));
+        EXPECT_EQ(getNormalPageIdU64(dir, ref_id_offset + 21, snap), 21);
+    }
+}
+CATCH
+
 #undef INSERT_ENTRY_TO
 #undef INSERT_ENTRY
 #undef INSERT_ENTRY_ACQ_SNAP
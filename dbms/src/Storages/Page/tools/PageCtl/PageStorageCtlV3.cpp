@@ -550,7 +550,7 @@ private:
 
         FmtBuffer directory_info;
         directory_info.append("  Directory specific info: \n\n");
-        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory)
+        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory.copyAll())
         {
             // Show all page_id
             if (page_id == UINT64_MAX)
@@ -610,7 +610,7 @@ private:
         // region_id -> pair<min_raft_log_index, max_raft_log_index>
         size_t tot_num_raft_log = 0;
         std::unordered_map<RegionID, RegionSummary> regions;
-        for (const auto & [page_id, _] : mvcc_table_directory)
+        for (const auto & [page_id, _] : mvcc_table_directory.copyAll())
         {
             auto maybe_region_id = RaftDataReader::tryParseRegionId(page_id);
             if (!maybe_region_id)
@@ -683,7 +683,7 @@ private:
 
         dir_summary_info.append("  Directory summary info: \n");
 
-        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory)
+        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory.copyAll())
         {
             (void)internal_id;
             longest_version_chaim = std::max(longest_version_chaim, versioned_entries->size());
@@ -733,8 +733,8 @@ private:
         UInt64 page_id)
     {
         auto check = [&](auto & full_page_id) {
-            const auto & it = mvcc_table_directory.find(full_page_id);
-            if (it == mvcc_table_directory.end())
+            const auto versioned_entries = mvcc_table_directory.find(full_page_id);
+            if (versioned_entries == nullptr)
             {
                 return fmt::format("Can't find {}", full_page_id);
             }
@@ -742,9 +742,9 @@ private:
             FmtBuffer error_msg;
             size_t error_count = 0;
             size_t ignore_count = 0;
-            for (const auto & [version, entry_or_del] : it->second->entries)
+            for (const auto & [version, entry_or_del] : versioned_entries->entries)
             {
-                if (entry_or_del.isEntry() && it->second->type == EditRecordType::VAR_ENTRY)
+                if (entry_or_del.isEntry() && versioned_entries->type == EditRecordType::VAR_ENTRY)
                 {
                     const PageEntryV3 & entry = entry_or_del.entry.value();
                     if (entry.checkpoint_info.has_value() && entry.checkpoint_info.is_local_data_reclaimed)
@@ -821,7 +821,7 @@ private:
         fmt::print("Begin to check CRC for all pages. check_fields={}\n", check_fields);
 
         std::list<std::pair<typename Trait::PageId, PageVersion>> error_versioned_pages;
-        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory)
+        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory.copyAll())
         {
             if (index == total_pages / 10 * cut_index)
             {
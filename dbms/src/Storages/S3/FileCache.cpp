@@ -30,6 +30,8 @@
 #include <Storages/S3/FileCachePerf.h>
 #include <Storages/S3/S3Common.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <atomic>
 #include <chrono>
@@ -54,11 +56,15 @@ namespace DB::ErrorCodes
 {
 extern const int S3_ERROR;
 extern const int FILE_DOESNT_EXIST;
+extern const int CANNOT_OPEN_FILE;
+extern const int CANNOT_READ_FROM_FILE_DESCRIPTOR;
+extern const int CANNOT_WRITE_TO_FILE_DESCRIPTOR;
 } // namespace DB::ErrorCodes
 
 namespace DB::FailPoints
 {
 extern const char file_cache_fg_download_fail[];
+extern const char file_cache_put_chunk_fail[];
 } // namespace DB::FailPoints
 
 namespace DB
@@ -107,6 +113,106 @@ FileSegment::Status FileSegment::waitForNotEmpty()
     return status;
 }
 
+FileSegment::FileSegment(
+    const String & local_fname_,
+    FileType file_type_,
+    const String & chunk_fname_,
+    UInt64 file_size_,
+    UInt64 chunk_size_)
+    : local_fname(local_fname_)
+    , status(Status::Empty)
+    , size(0)
+    , file_type(file_type_)
+    , last_access_time(std::chrono::system_clock::now())
+    , file_size(file_size_)
+    , chunk_size(chunk_size_)
+    , chunk_fname(chunk_fname_)
+    , chunk_status((file_size_ + chunk_size_ - 1) / chunk_size_, ChunkStatus::Empty)
+{
+    RUNTIME_CHECK(chunk_size > 0, local_fname, file_size, chunk_size);
+}
+
+void FileSegment::openChunkFile()
+{
+    // The file is not truncated. An evicted FileSegment of the same object may open the file later,
+    // and truncating would drop the chunks cached by this one. The stale data in the file is harmless,
+    // because only the chunks written by this FileSegment are read, and S3 objects are immutable.
+    chunk_fd = ::open(chunk_fname.c_str(), O_RDWR | O_CREAT, 0666);
+    if (chunk_fd < 0)
+        throwFromErrno(fmt::format("Cannot open file {}", chunk_fname), ErrorCodes::CANNOT_OPEN_FILE);
+}
+
+FileSegment::~FileSegment()
+{
+    if (chunk_fd >= 0)
+        ::close(chunk_fd);
+}
+
+FileSegment::ChunkStatus FileSegment::acquireChunk(UInt64 chunk_idx)
+{
+    std::unique_lock lock(mtx);
+    RUNTIME_CHECK(chunk_idx < chunk_status.size(), local_fname, chunk_idx, chunk_status.size());
+    cv_ready.wait(lock, [&] { return chunk_status[chunk_idx] != ChunkStatus::Downloading; });
+    if (chunk_status[chunk_idx] == ChunkStatus::Complete)
+        return ChunkStatus::Complete;
+    if (chunk_fd < 0)
+        openChunkFile();
+    chunk_status[chunk_idx] = ChunkStatus::Downloading;
+    return ChunkStatus::Downloading;
+}
+
+bool FileSegment::finishChunk(UInt64 chunk_idx, bool cached, UInt64 bytes)
+{
+    std::lock_guard lock(mtx);
+    RUNTIME_CHECK(chunk_status[chunk_idx] == ChunkStatus::Downloading, local_fname, chunk_idx);
+    if (cached)
+    {
+        chunk_status[chunk_idx] = ChunkStatus::Complete;
+        size += bytes;
+        ++cached_chunk_count;
+    }
+    else
+    {
+        chunk_status[chunk_idx] = ChunkStatus::Empty;
+    }
+    cv_ready.notify_all();
+    return cached && cached_chunk_count == chunk_status.size();
+}
+
+void FileSegment::readChunk(char * buf, size_t n, UInt64 offset) const
+{
+    while (n > 0)
+    {
+        auto res = ::pread(chunk_fd, buf, n, offset);
+        if (res < 0 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            throwFromErrno(
+                fmt::format("Cannot read from file {}, offset={} size={}", chunk_fname, offset, n),
+                ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR);
+        buf += res;
+        n -= res;
+        offset += res;
+    }
+}
+
+void FileSegment::writeChunk(const char * buf, size_t n, UInt64 offset) const
+{
+    while (n > 0)
+    {
+        auto res = ::pwrite(chunk_fd, buf, n, offset);
+        if (res < 0 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            throwFromErrno(
+                fmt::format("Cannot write to file {}, offset={} size={}", chunk_fname, offset, n),
+                ErrorCodes::CANNOT_WRITE_TO_FILE_DESCRIPTOR);
+        buf += res;
+        n -= res;
+        offset += res;
+    }
+}
+
 FileCache::FileCache(PathCapacityMetricsPtr capacity_metrics_, const StorageRemoteCacheConfig & config_)
     : capacity_metrics(capacity_metrics_)
     , cache_dir(config_.getDTFileCacheDir())
@@ -229,11 +335,18 @@ FileSegmentPtr FileCache::get(const S3::S3FilenameView & s3_fname, const std::op
         }
         else
         {
-            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+            // The hits and misses of a partially cached file are counted by chunks when it is read.
+            if (!f->isChunked())
+                GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
             return nullptr;
         }
     }
 
+    if (canCacheByChunk(file_type, filesize))
+    {
+        // The object will be cached by chunks when it is read, see `getChunked`.
+        return nullptr;
+    }
     GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
     if (!canCache(file_type))
     {
@@ -268,6 +381,92 @@ FileSegmentPtr FileCache::get(const S3::S3FilenameView & s3_fname, const std::op
     return nullptr;
 }
 
+FileSegmentPtr FileCache::getChunked(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize)
+{
+    auto s3_key = s3_fname.toFullKey();
+    auto file_type = getFileType(s3_key);
+    auto & table = tables[static_cast<UInt64>(file_type)];
+
+    std::lock_guard lock(mtx);
+
+    auto f = table.get(s3_key);
+    if (f != nullptr)
+    {
+        f->setLastAccessTime(std::chrono::system_clock::now());
+        // The object is being downloaded as a whole or has been cached completely.
+        return f->isChunked() && !f->isReadyToRead() ? f : nullptr;
+    }
+
+    if (!canCacheByChunk(file_type, filesize))
+        return nullptr;
+
+    auto local_fname = toLocalFilename(s3_key);
+    prepareParentDir(local_fname);
+    // Use the temporary filename, so the partially cached file will be removed by `restore`.
+    auto file_seg = std::make_shared<FileSegment>(
+        local_fname,
+        file_type,
+        toTemporaryFilename(local_fname),
+        *filesize,
+        chunk_size.load(std::memory_order_relaxed));
+    table.set(s3_key, file_seg);
+    return file_seg;
+}
+
+bool FileCache::putChunk(const FileSegmentPtr & file_seg, UInt64 chunk_idx, const char * data, UInt64 size)
+{
+    FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::file_cache_put_chunk_fail);
+    bool cached = false;
+    if (reserveSpace(file_seg->getFileType(), size, EvictMode::TryEvict))
+    {
+        try
+        {
+            file_seg->writeChunk(data, size, chunk_idx * file_seg->getChunkSize());
+            cached = true;
+            GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_download_bytes).Increment(size);
+        }
+        catch (...)
+        {
+            tryLogCurrentException(
+                log,
+                fmt::format("Write chunk failed, local_fname={} chunk_idx={}", file_seg->getLocalFileName(), chunk_idx));
+            releaseSpace(size);
+        }
+    }
+    else
+    {
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
+    }
+    return cached;
+}
+
+void FileCache::finishChunk(const FileSegmentPtr & file_seg, UInt64 chunk_idx, bool cached, UInt64 size)
+{
+    const bool all_cached = file_seg->finishChunk(chunk_idx, cached, size);
+    // The chunks are added to the capacity metrics when they are cached, not when the file is finalized.
+    if (cached)
+        capacity_metrics->addUsedSize(file_seg->getLocalFileName(), size);
+    if (all_cached)
+        finalizeChunkedFile(file_seg);
+}
+
+void FileCache::finalizeChunkedFile(const FileSegmentPtr & file_seg)
+{
+    const auto & local_fname = file_seg->getLocalFileName();
+    try
+    {
+        // The opened fd of the chunk file is still valid after renaming.
+        std::filesystem::rename(toTemporaryFilename(local_fname), local_fname);
+        file_seg->setStatus(FileSegment::Status::Complete);
+        LOG_DEBUG(log, "All chunks are cached, local={} size={}", local_fname, file_seg->getSize());
+    }
+    catch (...)
+    {
+        // The FileSegment is left as partially cached, readers can still read the chunks.
+        tryLogCurrentException(log, fmt::format("Finalize chunked file failed, local_fname={}", local_fname));
+    }
+}
+
 FileSegmentPtr FileCache::getOrWait(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize)
 {
     auto s3_key = s3_fname.toFullKey();
@@ -281,6 +480,9 @@ FileSegmentPtr FileCache::getOrWait(const S3::S3FilenameView & s3_fname, const s
     {
         lock.unlock();
         f->setLastAccessTime(std::chrono::system_clock::now());
+        // A partially cached chunked file won't become ready by waiting.
+        if (f->isChunked() && !f->isReadyToRead())
+            return nullptr;
         auto status = f->waitForNotEmpty();
         if (status == FileSegment::Status::Complete)
         {
@@ -387,10 +589,13 @@ std::pair<Int64, std::list<String>::iterator> FileCache::removeImpl(
     const auto & local_fname = f->getLocalFileName();
     removeDiskFile(local_fname, /*update_fsize_metrics*/ true);
     auto temp_fname = toTemporaryFilename(local_fname);
-    // Not update fsize metrics for temporary files because they are not add to fsize metrics before.
+    // Not update fsize metrics by the size of temporary files. Only the chunks of a partially cached file
+    // are added to fsize metrics by `putChunk`, and the temporary file may be larger than these chunks.
     removeDiskFile(temp_fname, /*update_fsize_metrics*/ false);
 
     auto release_size = f->getSize();
+    if (f->isChunked() && !f->isReadyToRead())
+        capacity_metrics->freeUsedSize(local_fname, release_size);
     GET_METRIC(tiflash_storage_remote_cache, type_dtfile_evict).Increment();
     GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_evict_bytes).Increment(release_size);
     releaseSpaceImpl(release_size);
@@ -624,6 +829,26 @@ bool FileCache::canCache(FileType file_type) const
         < S3FileCachePool::get().getMaxThreads() * max_downloading_count_scale.load(std::memory_order_relaxed);
 }
 
+bool FileCache::canCacheByChunk(FileType file_type, const std::optional<UInt64> & filesize) const
+{
+    auto size = chunk_size.load(std::memory_order_relaxed);
+    if (size == 0 || !filesize.has_value() || *filesize <= size || static_cast<UInt64>(file_type) > cache_level)
+        return false;
+    // Only the data files which are read by ranges. The other files are small or read as a whole.
+    switch (file_type)
+    {
+    case FileType::Merged:
+    case FileType::NullMap:
+    case FileType::DeleteMarkColData:
+    case FileType::VersionColData:
+    case FileType::HandleColData:
+    case FileType::ColData:
+        return true;
+    default:
+        return false;
+    }
+}
+
 FileType FileCache::getFileTypeOfColData(const std::filesystem::path & p)
 {
     if (p.extension() == ".null")
@@ -1013,6 +1238,13 @@ void FileCache::updateConfig(const Settings & settings)
             cache_min_age);
         cache_min_age_seconds.store(cache_min_age, std::memory_order_relaxed);
     }
+
+    UInt64 new_chunk_size = settings.dt_filecache_chunk_size;
+    if (new_chunk_size != chunk_size.load(std::memory_order_relaxed))
+    {
+        LOG_INFO(log, "chunk_size {} => {}", chunk_size.load(std::memory_order_relaxed), new_chunk_size);
+        chunk_size.store(new_chunk_size, std::memory_order_relaxed);
+    }
 }
 
 } // namespace DB
@@ -66,6 +66,14 @@ public:
         ColData,
     };
 
+    // The status of a chunk when the file is cached by chunks.
+    enum class ChunkStatus : UInt8
+    {
+        Empty,
+        Downloading,
+        Complete,
+    };
+
     FileSegment(const String & local_fname_, Status status_, UInt64 size_, FileType file_type_)
         : local_fname(local_fname_)
         , status(status_)
@@ -74,6 +82,21 @@ public:
         , last_access_time(std::chrono::system_clock::now())
     {}
 
+    // Cache the file by chunks of `chunk_size_` bytes. Only the chunks that have been read are
+    // written to `chunk_fname_`, and `size` is the bytes of these chunks. After all chunks are
+    // cached, `chunk_fname_` is renamed to `local_fname_` and the status becomes Complete.
+    // `chunk_fname_` is opened when a chunk is acquired at the first time, not under the lock of FileCache.
+    FileSegment(
+        const String & local_fname_,
+        FileType file_type_,
+        const String & chunk_fname_,
+        UInt64 file_size_,
+        UInt64 chunk_size_);
+
+    ~FileSegment();
+
+    DISALLOW_COPY_AND_MOVE(FileSegment);
+
     bool isReadyToRead() const
     {
         std::lock_guard lock(mtx);
@@ -138,7 +161,35 @@ public:
         return last_access_time;
     }
 
+    bool isChunked() const
+    {
+        // `chunk_size` is read-only, no need for a lock.
+        return chunk_size > 0;
+    }
+
+    UInt64 getChunkSize() const { return chunk_size; }
+
+    // The size of the whole file, only valid when the file is cached by chunks.
+    UInt64 getFileSize() const { return file_size; }
+
+    // Wait until the chunk is not being downloaded by other threads.
+    // Returns Complete if the chunk is cached. Otherwise returns Downloading, which means
+    // the caller is responsible for downloading the chunk and must call `finishChunk` later,
+    // even if the downloading fails.
+    ChunkStatus acquireChunk(UInt64 chunk_idx);
+
+    // Finish downloading the chunk acquired by `acquireChunk`. `cached` is false if the chunk
+    // is not written to the local file, then other readers will try to download it again.
+    // Returns true if all chunks are cached after this call.
+    bool finishChunk(UInt64 chunk_idx, bool cached, UInt64 bytes);
+
+    // Read or write [offset, offset + n) of the chunk file.
+    void readChunk(char * buf, size_t n, UInt64 offset) const;
+    void writeChunk(const char * buf, size_t n, UInt64 offset) const;
+
 private:
+    void openChunkFile();
+
     mutable std::mutex mtx;
     const String local_fname;
     Status status;
@@ -146,6 +197,14 @@ private:
     const FileType file_type;
     std::chrono::time_point<std::chrono::system_clock> last_access_time;
     std::condition_variable cv_ready;
+
+    // Only used when the file is cached by chunks.
+    const UInt64 file_size = 0;
+    const UInt64 chunk_size = 0;
+    const String chunk_fname;
+    int chunk_fd = -1;
+    std::vector<ChunkStatus> chunk_status;
+    size_t cached_chunk_count = 0;
 };
 
 using FileSegmentPtr = std::shared_ptr<FileSegment>;
@@ -251,6 +310,20 @@ public:
         const S3::S3FilenameView & s3_fname,
         const std::optional<UInt64> & filesize);
 
+    /// Returns the FileSegment which caches the object by chunks, or nullptr if the object is
+    /// not suitable to be cached by chunks. `S3RandomAccessFile` reads the object through
+    /// the FileSegment, so only the chunks that are read are downloaded and cached.
+    FileSegmentPtr getChunked(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize);
+
+    /// Cache a chunk acquired and downloaded by the reader. The chunk is not cached if space
+    /// is not enough. Returns whether the chunk is cached.
+    bool putChunk(const FileSegmentPtr & file_seg, UInt64 chunk_idx, const char * data, UInt64 size);
+
+    /// Finish a chunk acquired by the reader, whether it is cached by `putChunk` or not. It must be
+    /// called once for each acquired chunk, even if downloading or caching the chunk throws, otherwise
+    /// other readers of the chunk wait forever. It will finish the FileSegment when all chunks are cached.
+    void finishChunk(const FileSegmentPtr & file_seg, UInt64 chunk_idx, bool cached, UInt64 size);
+
     /// The same as downloadFileForLocalRead, but it supports retry.
     /// Returns the file guard of the local cache file and whether the file is downloaded from S3.
     /// If the file is not downloaded, an exception will be thrown.
@@ -333,6 +406,8 @@ public:
     static FileSegment::FileType getFileType(const String & fname);
     static FileSegment::FileType getFileTypeOfColData(const std::filesystem::path & p);
     bool canCache(FileSegment::FileType file_type) const;
+    bool canCacheByChunk(FileSegment::FileType file_type, const std::optional<UInt64> & filesize) const;
+    void finalizeChunkedFile(const FileSegmentPtr & file_seg);
 
     enum class EvictMode
     {
@@ -362,6 +437,8 @@ public:
     UInt64 cache_used;
     std::atomic<UInt64> cache_min_age_seconds = 1800;
     std::atomic<double> max_downloading_count_scale = 1.0;
+    // 0 means caching the whole file.
+    std::atomic<UInt64> chunk_size = 0;
     std::array<LRUFileTable, magic_enum::enum_count<FileSegment::FileType>()> tables;
 
     // Currently, these variables are just use for testing.
@@ -25,6 +25,7 @@
 #include <aws/s3/model/GetObjectRequest.h>
 #include <common/likely.h>
 
+#include <ext/scope_guard.h>
 #include <optional>
 
 namespace ProfileEvents
@@ -36,6 +37,11 @@ extern const Event S3IORead;
 extern const Event S3IOSeek;
 } // namespace ProfileEvents
 
+namespace DB::ErrorCodes
+{
+extern const int S3_ERROR;
+} // namespace DB::ErrorCodes
+
 namespace DB::S3
 {
 String S3RandomAccessFile::summary() const
@@ -53,6 +59,26 @@ S3RandomAccessFile::S3RandomAccessFile(std::shared_ptr<TiFlashS3Client> client_p
     RUNTIME_CHECK(initialize(), remote_fname);
 }
 
+S3RandomAccessFile::S3RandomAccessFile(
+    std::shared_ptr<TiFlashS3Client> client_ptr_,
+    const String & remote_fname_,
+    FileSegmentPtr file_seg_,
+    FileCache * file_cache_,
+    DM::ScanContextPtr scan_context_)
+    : client_ptr(std::move(client_ptr_))
+    , remote_fname(remote_fname_)
+    , cur_offset(0)
+    , log(Logger::get(remote_fname))
+    , file_seg(std::move(file_seg_))
+    , file_cache(file_cache_)
+    , scan_context(std::move(scan_context_))
+{
+    RUNTIME_CHECK(client_ptr != nullptr);
+    RUNTIME_CHECK(file_seg != nullptr && file_seg->isChunked() && file_cache != nullptr, remote_fname);
+    // The object is downloaded by chunks, no need to open the stream of the whole object.
+    content_length = file_seg->getFileSize();
+}
+
 std::string S3RandomAccessFile::getFileName() const
 {
     return fmt::format("{}/{}", client_ptr->bucket(), remote_fname);
@@ -76,6 +102,9 @@ bool isRetryableError(int ret, int err)
 
 ssize_t S3RandomAccessFile::read(char * buf, size_t size)
 {
+    if (file_seg != nullptr)
+        return readChunked(buf, size);
+
     while (true)
     {
         auto n = readImpl(buf, size);
@@ -137,6 +166,20 @@ ssize_t S3RandomAccessFile::readImpl(char * buf, size_t size)
 
 off_t S3RandomAccessFile::seek(off_t offset_, int whence)
 {
+    if (file_seg != nullptr)
+    {
+        // No stream to skip, just move the offset.
+        RUNTIME_CHECK_MSG(whence == SEEK_SET, "Only SEEK_SET mode is allowed, but {} is received", whence);
+        RUNTIME_CHECK_MSG(
+            offset_ >= cur_offset && offset_ <= content_length,
+            "Seek position is out of bounds: offset={}, cur_offset={}, content_length={}",
+            offset_,
+            cur_offset,
+            content_length);
+        cur_offset = offset_;
+        return cur_offset;
+    }
+
     while (true)
     {
         auto off = seekImpl(offset_, whence);
@@ -197,6 +240,91 @@ off_t S3RandomAccessFile::seekImpl(off_t offset_, int whence)
     cur_offset = offset_;
     return cur_offset;
 }
+ssize_t S3RandomAccessFile::readChunked(char * buf, size_t size)
+{
+    const UInt64 chunk_size = file_seg->getChunkSize();
+    size = std::min<UInt64>(size, content_length - cur_offset);
+    size_t read_bytes = 0;
+    String chunk;
+    while (read_bytes < size)
+    {
+        const UInt64 chunk_idx = cur_offset / chunk_size;
+        const UInt64 chunk_begin = chunk_idx * chunk_size;
+        const UInt64 chunk_len = std::min<UInt64>(chunk_size, content_length - chunk_begin);
+        const UInt64 n = std::min<UInt64>(chunk_begin + chunk_len - cur_offset, size - read_bytes);
+        if (file_seg->acquireChunk(chunk_idx) == FileSegment::ChunkStatus::Complete)
+        {
+            file_seg->readChunk(buf + read_bytes, n, cur_offset);
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
+            if (scan_context != nullptr)
+                scan_context->disagg_read_cache_hit_size += n;
+        }
+        else
+        {
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+            if (scan_context != nullptr)
+                scan_context->disagg_read_cache_miss_size += n;
+            // Finish the chunk even if downloading or caching it throws, otherwise other readers
+            // of the chunk wait for it forever.
+            bool cached = false;
+            SCOPE_EXIT({ file_cache->finishChunk(file_seg, chunk_idx, cached, chunk_len); });
+            downloadChunk(chunk_begin, chunk_len, chunk);
+            cached = file_cache->putChunk(file_seg, chunk_idx, chunk.data(), chunk_len);
+            memcpy(buf + read_bytes, chunk.data() + (cur_offset - chunk_begin), n);
+        }
+        cur_offset += n;
+        read_bytes += n;
+    }
+    return read_bytes;
+}
+
+void S3RandomAccessFile::downloadChunk(UInt64 begin, UInt64 size, String & data)
+{
+    Stopwatch sw;
+    Aws::S3::Model::GetObjectRequest req;
+    req.SetRange(fmt::format("bytes={}-{}", begin, begin + size - 1));
+    client_ptr->setBucketAndKeyWithRoot(req, remote_fname);
+    for (Int32 retry = 1;; ++retry)
+    {
+        ProfileEvents::increment(ProfileEvents::S3GetObject);
+        if (retry > 1)
+            ProfileEvents::increment(ProfileEvents::S3GetObjectRetry);
+        auto outcome = client_ptr->GetObject(req);
+        if (!outcome.IsSuccess())
+        {
+            if (retry >= max_retry)
+                throw S3::fromS3Error(outcome.GetError(), "remote_fname={} range={} ", remote_fname, req.GetRange());
+            LOG_WARNING(
+                log,
+                "S3 GetObject failed: {}, retry={}, range={}",
+                S3::S3ErrorMessage(outcome.GetError()),
+                retry,
+                req.GetRange());
+            continue;
+        }
+
+        data.resize(size);
+        auto & istr = outcome.GetResult().GetBody();
+        istr.read(data.data(), size);
+        auto gcount = static_cast<UInt64>(istr.gcount());
+        if (gcount != size)
+        {
+            if (retry >= max_retry)
+                throw Exception(
+                    ErrorCodes::S3_ERROR,
+                    "Cannot read from istream, remote_fname={} range={} gcount={}",
+                    remote_fname,
+                    req.GetRange(),
+                    gcount);
+            LOG_WARNING(log, "Cannot read from istream, retry={} range={} gcount={}", retry, req.GetRange(), gcount);
+            continue;
+        }
+        ProfileEvents::increment(ProfileEvents::S3ReadBytes, size);
+        GET_METRIC(tiflash_storage_s3_request_seconds, type_get_object).Observe(sw.elapsedSeconds());
+        return;
+    }
+}
+
 String S3RandomAccessFile::readRangeOfObject()
 {
     return fmt::format("bytes={}-", cur_offset);
@@ -272,6 +400,21 @@ inline static RandomAccessFilePtr tryOpenCachedFile(const String & remote_fname,
     }
 }
 
+inline static FileSegmentPtr tryGetChunkedFileSegment(const String & remote_fname, std::optional<UInt64> filesize)
+{
+    try
+    {
+        auto * file_cache = FileCache::instance();
+        return file_cache != nullptr ? file_cache->getChunked(S3::S3FilenameView::fromKey(remote_fname), filesize)
+                                     : nullptr;
+    }
+    catch (...)
+    {
+        tryLogCurrentException("tryGetChunkedFileSegment", remote_fname);
+        return nullptr;
+    }
+}
+
 inline static RandomAccessFilePtr createFromNormalFile(
     const String & remote_fname,
     std::optional<UInt64> filesize,
@@ -284,9 +427,17 @@ inline static RandomAccessFilePtr createFromNormalFile(
             scan_context.value()->disagg_read_cache_hit_size += filesize.value();
         return file;
     }
+    auto & ins = S3::ClientFactory::instance();
+    // The hit and miss bytes of a file cached by chunks are counted by the chunks being read.
+    if (auto file_seg = tryGetChunkedFileSegment(remote_fname, filesize); file_seg != nullptr)
+        return std::make_shared<S3RandomAccessFile>(
+            ins.sharedTiFlashClient(),
+            remote_fname,
+            file_seg,
+            FileCache::instance(),
+            scan_context.value_or(nullptr));
     if (scan_context.has_value())
         scan_context.value()->disagg_read_cache_miss_size += filesize.value();
-    auto & ins = S3::ClientFactory::instance();
     return std::make_shared<S3RandomAccessFile>(ins.sharedTiFlashClient(), remote_fname);
 }
 
@@ -28,6 +28,13 @@
 #undef thread_local
 #endif
 
+namespace DB
+{
+class FileCache;
+class FileSegment;
+using FileSegmentPtr = std::shared_ptr<FileSegment>;
+} // namespace DB
+
 namespace DB::S3
 {
 class TiFlashS3Client;
@@ -47,6 +54,16 @@ public:
 
     S3RandomAccessFile(std::shared_ptr<TiFlashS3Client> client_ptr_, const String & remote_fname_);
 
+    // Read the object through a FileSegment that caches it by chunks. Only the chunks being
+    // read are downloaded from S3 by range and put into `file_cache_`. The bytes read from the
+    // cached chunks and from S3 are added to `scan_context_` if it is not null.
+    S3RandomAccessFile(
+        std::shared_ptr<TiFlashS3Client> client_ptr_,
+        const String & remote_fname_,
+        FileSegmentPtr file_seg_,
+        FileCache * file_cache_,
+        DM::ScanContextPtr scan_context_);
+
     // Can only seek forward.
     off_t seek(off_t offset, int whence) override;
 
@@ -88,6 +105,8 @@ private:
     off_t seekImpl(off_t offset, int whence);
     ssize_t readImpl(char * buf, size_t size);
     String readRangeOfObject();
+    ssize_t readChunked(char * buf, size_t size);
+    void downloadChunk(UInt64 begin, UInt64 size, String & data);
 
     // When reading, it is necessary to pass the extra information of file, such file size, to S3RandomAccessFile::create.
     // It is troublesome to pass parameters layer by layer. So currently, use thread_local global variable to pass parameters.
@@ -106,6 +125,11 @@ private:
 
     Int32 cur_retry = 0;
     static constexpr Int32 max_retry = 3;
+
+    // Not null if the object is read by chunks.
+    FileSegmentPtr file_seg;
+    FileCache * file_cache = nullptr;
+    DM::ScanContextPtr scan_context;
 };
 
 using S3RandomAccessFilePtr = std::shared_ptr<S3RandomAccessFile>;
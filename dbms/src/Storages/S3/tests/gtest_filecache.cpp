@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/FailPoint.h>
 #include <Common/Logger.h>
 #include <Common/Stopwatch.h>
 #include <Debug/TiFlashTestEnv.h>
@@ -19,11 +20,13 @@
 #include <Interpreters/Context.h>
 #include <Server/StorageConfigParser.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/KVStore/Types.h>
 #include <Storages/PathCapacityMetrics.h>
 #include <Storages/S3/FileCache.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/S3/S3Filename.h>
+#include <Storages/S3/S3RandomAccessFile.h>
 #include <Storages/S3/S3WritableFile.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <aws/s3/model/CreateBucketRequest.h>
@@ -32,6 +35,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <ext/scope_guard.h>
 #include <filesystem>
 #include <fstream>
 #include <random>
@@ -44,6 +48,11 @@ using DMFileOID = ::DB::S3::DMFileOID;
 using S3Filename = ::DB::S3::S3Filename;
 using FileType = ::DB::FileSegment::FileType;
 
+namespace DB::FailPoints
+{
+extern const char file_cache_put_chunk_fail[];
+} // namespace DB::FailPoints
+
 namespace DB::ErrorCodes
 {
 extern const int FILE_DOESNT_EXIST;
@@ -842,5 +851,153 @@ try
 }
 CATCH
 
+TEST_F(FileCacheTest, CacheByChunk)
+try
+{
+    auto objects = genObjects(/*store_count*/ 1, /*table_count*/ 1, /*file_count*/ 1, {"1.merged"});
+    ASSERT_EQ(objects.size(), 1);
+    const auto & obj = objects[0];
+    auto s3_fname = S3FilenameView::fromKey(obj.key);
+
+    auto cache_dir = fmt::format("{}/cache_by_chunk", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .dtfile_level = 100};
+    calculateCacheCapacity(cache_config, obj.size);
+    // Use the capacity metrics of the cache dir only, to check the used size of the cached chunks.
+    auto chunk_capacity_metrics = std::make_shared<PathCapacityMetrics>(
+        0,
+        Strings{},
+        std::vector<size_t>{},
+        Strings{},
+        std::vector<size_t>{},
+        Strings{cache_dir},
+        std::vector<size_t>{0});
+    auto used_size = [&]() {
+        return chunk_capacity_metrics->path_infos[chunk_capacity_metrics->locatePath(cache_dir)].used_bytes.load();
+    };
+    FileCache file_cache(chunk_capacity_metrics, cache_config);
+    constexpr UInt64 chunk_size = 1024 * 1024;
+    file_cache.chunk_size = chunk_size;
+
+    // Not downloaded in background, and not cached by chunks if the size is unknown.
+    ASSERT_EQ(file_cache.get(s3_fname, obj.size), nullptr);
+    ASSERT_EQ(file_cache.bg_downloading_count.load(std::memory_order_relaxed), 0);
+    ASSERT_EQ(file_cache.getChunked(s3_fname, std::nullopt), nullptr);
+
+    auto file_seg = file_cache.getChunked(s3_fname, obj.size);
+    ASSERT_NE(file_seg, nullptr);
+    ASSERT_TRUE(file_seg->isChunked());
+    ASSERT_EQ(file_cache.getChunked(s3_fname, obj.size), file_seg);
+
+    auto scan_context = std::make_shared<DM::ScanContext>();
+    auto read_and_check = [&](UInt64 offset, UInt64 size) {
+        S3RandomAccessFile file(s3_client, obj.key, file_seg, &file_cache, scan_context);
+        ASSERT_EQ(file.seek(offset, SEEK_SET), static_cast<off_t>(offset));
+        String buf(size, '\0');
+        ASSERT_EQ(file.read(buf.data(), size), static_cast<ssize_t>(size));
+        ASSERT_EQ(buf, String(size, obj.value));
+    };
+
+    // Read across two chunks, only these two chunks are cached.
+    read_and_check(chunk_size - 10, 20);
+    ASSERT_EQ(file_seg->getSize(), 2 * chunk_size);
+    ASSERT_EQ(file_cache.cache_used, 2 * chunk_size);
+    ASSERT_EQ(used_size(), 2 * chunk_size);
+    ASSERT_FALSE(file_seg->isReadyToRead());
+    ASSERT_EQ(file_cache.get(s3_fname, obj.size), nullptr);
+    ASSERT_EQ(scan_context->disagg_read_cache_hit_size.load(), 0);
+    ASSERT_EQ(scan_context->disagg_read_cache_miss_size.load(), 20);
+
+    // Read the cached chunks again.
+    read_and_check(chunk_size, chunk_size);
+    ASSERT_EQ(file_cache.cache_used, 2 * chunk_size);
+    ASSERT_EQ(used_size(), 2 * chunk_size);
+    ASSERT_EQ(scan_context->disagg_read_cache_hit_size.load(), chunk_size);
+    ASSERT_EQ(scan_context->disagg_read_cache_miss_size.load(), 20);
+
+    // Evict the partially cached file, the size of its chunks is released.
+    file_seg.reset();
+    file_cache.remove(s3_fname.toFullKey(), /*force*/ true);
+    ASSERT_EQ(file_cache.cache_used, 0);
+    ASSERT_EQ(used_size(), 0);
+
+    // After all chunks are cached, the file becomes a normal cached file.
+    file_seg = file_cache.getChunked(s3_fname, obj.size);
+    ASSERT_NE(file_seg, nullptr);
+    read_and_check(chunk_size, chunk_size);
+    read_and_check(0, obj.size);
+    ASSERT_EQ(file_seg->getSize(), obj.size);
+    ASSERT_EQ(file_cache.cache_used, obj.size);
+    ASSERT_EQ(used_size(), obj.size);
+    ASSERT_TRUE(file_seg->isReadyToRead());
+    ASSERT_EQ(file_cache.get(s3_fname, obj.size), file_seg);
+    ASSERT_EQ(std::filesystem::file_size(file_seg->getLocalFileName()), obj.size);
+    ASSERT_EQ(file_cache.getChunked(s3_fname, obj.size), nullptr);
+    ASSERT_EQ(scan_context->disagg_read_cache_hit_size.load(), 2 * chunk_size);
+    ASSERT_EQ(scan_context->disagg_read_cache_miss_size.load(), 20 + obj.size);
+
+    // The finalized file is released by its size on disk.
+    file_seg.reset();
+    file_cache.remove(s3_fname.toFullKey(), /*force*/ true);
+    ASSERT_EQ(used_size(), 0);
+}
+CATCH
+
+TEST_F(FileCacheTest, CacheByChunkFailed)
+try
+{
+    auto objects = genObjects(/*store_count*/ 1, /*table_count*/ 1, /*file_count*/ 1, {"1.merged"});
+    ASSERT_EQ(objects.size(), 1);
+    const auto & obj = objects[0];
+    auto s3_fname = S3FilenameView::fromKey(obj.key);
+
+    auto cache_dir = fmt::format("{}/cache_by_chunk_failed", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .dtfile_level = 100};
+    calculateCacheCapacity(cache_config, obj.size);
+    auto chunk_capacity_metrics = std::make_shared<PathCapacityMetrics>(
+        0,
+        Strings{},
+        std::vector<size_t>{},
+        Strings{},
+        std::vector<size_t>{},
+        Strings{cache_dir},
+        std::vector<size_t>{0});
+    FileCache file_cache(chunk_capacity_metrics, cache_config);
+    constexpr UInt64 chunk_size = 1024 * 1024;
+    file_cache.chunk_size = chunk_size;
+
+    auto file_seg = file_cache.getChunked(s3_fname, obj.size);
+    ASSERT_NE(file_seg, nullptr);
+    // The chunk file is not created until a chunk is acquired.
+    ASSERT_FALSE(std::filesystem::exists(FileCache::toTemporaryFilename(file_seg->getLocalFileName())));
+    auto read_and_check = [&](UInt64 offset, UInt64 size) {
+        S3RandomAccessFile file(s3_client, obj.key, file_seg, &file_cache, nullptr);
+        ASSERT_EQ(file.seek(offset, SEEK_SET), static_cast<off_t>(offset));
+        String buf(size, '\0');
+        ASSERT_EQ(file.read(buf.data(), size), static_cast<ssize_t>(size));
+        ASSERT_EQ(buf, String(size, obj.value));
+    };
+
+    {
+        // Caching the chunk fails after it is downloaded.
+        FailPointHelper::enableFailPoint(FailPoints::file_cache_put_chunk_fail);
+        SCOPE_EXIT({ FailPointHelper::disableFailPoint(FailPoints::file_cache_put_chunk_fail); });
+        S3RandomAccessFile file(s3_client, obj.key, file_seg, &file_cache, nullptr);
+        String buf(10, '\0');
+        ASSERT_THROW(file.read(buf.data(), buf.size()), Exception);
+    }
+    ASSERT_EQ(file_seg->getSize(), 0);
+    ASSERT_EQ(file_cache.cache_used, 0);
+
+    // The failed chunk is not left as downloading, so it can be acquired and cached again.
+    read_and_check(0, 10);
+    ASSERT_EQ(file_seg->getSize(), chunk_size);
+    ASSERT_EQ(file_cache.cache_used, chunk_size);
+    ASSERT_TRUE(std::filesystem::exists(FileCache::toTemporaryFilename(file_seg->getLocalFileName())));
+
+    file_seg.reset();
+    file_cache.remove(s3_fname.toFullKey(), /*force*/ true);
+    ASSERT_EQ(file_cache.cache_used, 0);
+}
+CATCH
 
 } // namespace DB::tests::S3
@@ -53,6 +53,8 @@ struct SelectQueryInfo
     std::string req_id;
     bool keep_order = true;
     bool is_fast_scan = false;
+    /// Whether the String columns can be read as ColumnDictionaryString, see `TiDBTableScan::readStringDictionary`.
+    bool read_string_dictionary = false;
 
     SelectQueryInfo();
     ~SelectQueryInfo();
@@ -887,7 +887,8 @@ BlockInputStreams StorageDeltaMerge::read(
         max_block_size,
         parseSegmentSet(select_query.segment_expression_list),
         extra_table_id_index,
-        scan_context);
+        scan_context,
+        query_info.read_string_dictionary);
 
     /// Ensure start_ts info after read.
     checkStartTs(mvcc_query_info.start_ts, context, query_info.req_id, keyspace_id);
@@ -979,7 +980,8 @@ void StorageDeltaMerge::read(
         max_block_size,
         parseSegmentSet(select_query.segment_expression_list),
         extra_table_id_index,
-        scan_context);
+        scan_context,
+        query_info.read_string_dictionary);
 
     /// Ensure start_ts info after read.
     checkStartTs(mvcc_query_info.start_ts, context, query_info.req_id, keyspace_id);
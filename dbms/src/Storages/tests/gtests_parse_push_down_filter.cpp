@@ -471,10 +471,11 @@ try
             default_timezone_info);
         const auto & rs_operator = filter->rs_operator;
         EXPECT_EQ(rs_operator->name(), "and");
-        EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
-        EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
+        EXPECT_EQ(rs_operator->getColumnIDs().size(), 2);
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+        EXPECT_EQ(rs_operator->getColumnIDs()[1], 2);
         std::regex rx(
-            R"(\{"op":"and","children":\[\{"op":"unsupported",.*\},\{"op":"equal","col":"col_2","value":"666"\}\]\})");
+            R"(\{"op":"and","children":\[\{"op":"equal","col":"col_1","value":"'test1'"\},\{"op":"equal","col":"col_2","value":"666"\}\]\})");
         EXPECT_TRUE(std::regex_search(rs_operator->toDebugString(), rx));
 
         Block before_where_block = Block{
@@ -522,7 +523,7 @@ try
 
     // More complicated
     {
-        // And with "not supported"
+        // And with string column
         auto filter = generatePushDownExecutor(
             *ctx,
             table_info_json,
@@ -530,10 +531,11 @@ try
             default_timezone_info);
         const auto & rs_operator = filter->rs_operator;
         EXPECT_EQ(rs_operator->name(), "and");
-        EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
-        EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
+        EXPECT_EQ(rs_operator->getColumnIDs().size(), 2);
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+        EXPECT_EQ(rs_operator->getColumnIDs()[1], 2);
         std::regex rx(
-            R"(\{"op":"and","children":\[\{"op":"unsupported",.*\},\{"op":"not","children":\[\{"op":"equal","col":"col_2","value":"666"\}\]\}\]\})");
+            R"(\{"op":"and","children":\[\{"op":"equal","col":"col_1","value":"'test1'"\},\{"op":"not","children":\[\{"op":"equal","col":"col_2","value":"666"\}\]\}\]\})");
         EXPECT_TRUE(std::regex_search(rs_operator->toDebugString(), rx));
 
         Block before_where_block = Block{
@@ -612,7 +614,7 @@ try
     }
 
     {
-        // Or with "not supported"
+        // Or with string column
         auto filter = generatePushDownExecutor(
             *ctx,
             table_info_json,
@@ -620,10 +622,11 @@ try
             default_timezone_info);
         const auto & rs_operator = filter->rs_operator;
         EXPECT_EQ(rs_operator->name(), "or");
-        EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
-        EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
+        EXPECT_EQ(rs_operator->getColumnIDs().size(), 2);
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+        EXPECT_EQ(rs_operator->getColumnIDs()[1], 2);
         std::regex rx(
-            R"(\{"op":"or","children":\[\{"op":"unsupported",.*\},\{"op":"equal","col":"col_2","value":"666"\}\]\})");
+            R"(\{"op":"or","children":\[\{"op":"equal","col":"col_1","value":"'test1'"\},\{"op":"equal","col":"col_2","value":"666"\}\]\})");
         EXPECT_TRUE(std::regex_search(rs_operator->toDebugString(), rx));
 
         Block before_where_block = Block{
@@ -648,10 +651,11 @@ try
             default_timezone_info);
         const auto & rs_operator = filter->rs_operator;
         EXPECT_EQ(rs_operator->name(), "or");
-        EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
-        EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
+        EXPECT_EQ(rs_operator->getColumnIDs().size(), 2);
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+        EXPECT_EQ(rs_operator->getColumnIDs()[1], 2);
         std::regex rx(
-            R"(\{"op":"or","children":\[\{"op":"unsupported",.*\},\{"op":"not","children":\[\{"op":"equal","col":"col_2","value":"666"\}\]\}\]\})");
+            R"(\{"op":"or","children":\[\{"op":"equal","col":"col_1","value":"'test1'"\},\{"op":"not","children":\[\{"op":"equal","col":"col_2","value":"666"\}\]\}\]\})");
         EXPECT_TRUE(std::regex_search(rs_operator->toDebugString(), rx));
 
         Block before_where_block = Block{
@@ -24,7 +24,12 @@ namespace TiDB
 struct InvertedIndexDefinition
 {
     bool is_signed;
+    // 0 means the index is built on a string column.
     UInt8 type_size;
+    // Only for string column, values are indexed by their sort keys under this collator.
+    Int32 collator_id = 0;
+
+    bool isString() const { return type_size == 0; }
 };
 
 // As this is constructed from TiDB's table definition, we should not
@@ -40,6 +45,8 @@ struct fmt::formatter<TiDB::InvertedIndexDefinition>
     template <typename FormatContext>
     auto format(const TiDB::InvertedIndexDefinition & index, FormatContext & ctx) const -> decltype(ctx.out())
     {
+        if (index.isString())
+            return fmt::format_to(ctx.out(), "String({})", index.collator_id);
         return fmt::format_to(ctx.out(), "{}{}", index.is_signed ? "" : "U", index.type_size * 8);
     }
 };
@@ -198,21 +198,27 @@ InvertedIndexDefinitionPtr parseInvertedIndexFromJSON(IndexType index_type, cons
     RUNTIME_CHECK(index_type == IndexType::INVERTED);
     bool is_signed = json->getValue<bool>("is_signed");
     auto type_size = json->getValue<UInt8>("type_size");
-    RUNTIME_CHECK(type_size > 0 && type_size <= sizeof(UInt64), type_size); // Just a protection
+    RUNTIME_CHECK(type_size <= sizeof(UInt64), type_size); // Just a protection
+    Int32 collator_id = 0;
+    if (type_size == 0)
+        collator_id = json->getValue<Int32>("collator_id");
     return std::make_shared<const InvertedIndexDefinition>(InvertedIndexDefinition{
         .is_signed = is_signed,
         .type_size = type_size,
+        .collator_id = collator_id,
     });
 }
 
 Poco::JSON::Object::Ptr invertedIndexToJSON(const InvertedIndexDefinitionPtr & inverted_index)
 {
     assert(inverted_index != nullptr);
-    RUNTIME_CHECK(inverted_index->type_size > 0 && inverted_index->type_size <= sizeof(UInt64));
+    RUNTIME_CHECK(inverted_index->type_size <= sizeof(UInt64));
 
     Poco::JSON::Object::Ptr inverted_index_json = new Poco::JSON::Object();
     inverted_index_json->set("is_signed", inverted_index->is_signed);
     inverted_index_json->set("type_size", inverted_index->type_size);
+    if (inverted_index->isString())
+        inverted_index_json->set("collator_id", inverted_index->collator_id);
     return inverted_index_json;
 }
 
@@ -25,6 +25,8 @@ struct WindowBlock
     MutableColumns output_columns;
 
     size_t rows = 0;
+    // The input columns are spilled to disk, they are empty until restored for output.
+    bool spilled = false;
 };
 
 struct RowNumber